@@ -543,6 +543,9 @@ void astChrTrunc_( char *, int * );
 #include <stdio.h>
 #define STATUS_PTR astGetStatusPtr
 #define AST__THREADSAFE 1
+#define AST__UNLOCKED 1
+#define AST__RUNNING 2
+#define AST__OTHER 3
 #define astINVOKE(rettype,function) astERROR_INVOKE(astRet##rettype##_(function))
 
 #define astRetF_(x) (x)
@@ -831,9 +834,10 @@ typedef struct AstMapping {
    char tran_forward;
    char tran_inverse;
 } AstMapping;
+typedef void (* AstTileFun)( void *, int, const int64_t [], const int64_t [], void *, void *, int * );
 astPROTO_CHECK(Mapping)
 astPROTO_ISA(Mapping)
-#define PROTO_GENERIC_ALL(X,Xtype) int astResample##X##_( AstMapping *, int, const int [], const int [], const Xtype [], const Xtype [], int, void (*)( void ), const double [], int, double, int, Xtype, int, const int [], const int [], const int [], const int [], Xtype [], Xtype [], int * );
+#define PROTO_GENERIC_ALL(X,Xtype) int astResample##X##_( AstMapping *, int, const int [], const int [], const Xtype [], const Xtype [], int, void (*)( void ), const double [], int, double, int, Xtype, int, const int [], const int [], const int [], const int [], Xtype [], Xtype [], int * ); int64_t astResample8##X##_( AstMapping *, int, const int64_t [], const int64_t [], const Xtype [], const Xtype [], int, void (*)( void ), const double [], int, double, int, Xtype, int, const int64_t [], const int64_t [], const int64_t [], const int64_t [], Xtype [], Xtype [], int * ); int64_t astResampleTiled##X##_( AstMapping *, int, const int64_t [], const int64_t [], const int [], AstTileFun, void *, int, int, void (*)( void ), const double [], int, double, int, Xtype, int, const int64_t [], const int64_t [], const int64_t [], const int64_t [], Xtype [], Xtype [], int * );
 PROTO_GENERIC_ALL(B,signed char)
 PROTO_GENERIC_ALL(D,double)
 PROTO_GENERIC_ALL(F,float)
@@ -849,7 +853,7 @@ PROTO_GENERIC_ALL(US,unsigned short int)
 
 PROTO_GENERIC_ALL(LD,long double)
 
-#define PROTO_GENERIC_DFI(X,Xtype) void astRebin##X##_( AstMapping *, double, int, const int [], const int [], const Xtype [], const Xtype [], int, const double [], int, double, int, Xtype, int, const int [], const int [], const int [], const int [], Xtype [], Xtype [], int * ); void astRebinSeq##X##_( AstMapping *, double, int, const int [], const int [], const Xtype [], const Xtype [], int, const double [], int, double, int, Xtype, int, const int [], const int [], const int [], const int [], Xtype [], Xtype [], double [], int64_t *, int * );
+#define PROTO_GENERIC_DFI(X,Xtype) void astRebin##X##_( AstMapping *, double, int, const int [], const int [], const Xtype [], const Xtype [], int, const double [], int, double, int, Xtype, int, const int [], const int [], const int [], const int [], Xtype [], Xtype [], int * ); void astRebinSeq##X##_( AstMapping *, double, int, const int [], const int [], const Xtype [], const Xtype [], int, const double [], int, double, int, Xtype, int, const int [], const int [], const int [], const int [], Xtype [], Xtype [], double [], int64_t *, int * ); void astRebin8##X##_( AstMapping *, double, int, const int64_t [], const int64_t [], const Xtype [], const Xtype [], int, const double [], int, double, int, Xtype, int, const int64_t [], const int64_t [], const int64_t [], const int64_t [], Xtype [], Xtype [], int * ); void astRebinSeq8##X##_( AstMapping *, double, int, const int64_t [], const int64_t [], const Xtype [], const Xtype [], int, const double [], int, double, int, Xtype, int, const int64_t [], const int64_t [], const int64_t [], const int64_t [], Xtype [], Xtype [], double [], int64_t *, int * );
 
 PROTO_GENERIC_DFI(D,double)
 PROTO_GENERIC_DFI(F,float)
@@ -867,6 +871,7 @@ int astQuadApprox_( AstMapping *, const double[2], const double[2], int, int, do
 void astTran1_( AstMapping *, int, const double [], int, double [], int * );
 void astTran2_( AstMapping *, int, const double [], const double [], int, double [], double [], int * );
 void astTranGrid_( AstMapping *, int, const int[], const int[], double, int, int, int, int, double *, int * );
+void astTranGrid8_( AstMapping *, int, const int64_t[], const int64_t[], double, int, int, int, int64_t, double *, int * );
 void astTranN_( AstMapping *, int, int, int, const double *, int, int, int, double *, int * );
 void astTranP_( AstMapping *, int, int, const double *[], int, int, double *[], int * );
 
@@ -879,37 +884,74 @@ void astMapSplitId_( AstMapping *, int, const int *, int *, AstMapping **, int *
 
 #define astIsAMapping(this) astINVOKE_ISA(Mapping,this)
 #define astResampleLD(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleLD_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8LD(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8LD_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledLD(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledLD_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 
 #define astInvert(this) astINVOKE(V,astInvert_(astCheckMapping(this),STATUS_PTR))
 #define astLinearApprox(this,lbnd,ubnd,tol,fit) astINVOKE(V,astLinearApprox_(astCheckMapping(this),lbnd,ubnd,tol,fit,STATUS_PTR))
 #define astQuadApprox(this,lbnd,ubnd,nx,ny,fit,rms) astINVOKE(V,astQuadApprox_(astCheckMapping(this),lbnd,ubnd,nx,ny,fit,rms,STATUS_PTR))
 #define astRebinD(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebinD_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astRebin8D(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebin8D_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astRebinF(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebinF_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astRebin8F(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebin8F_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astRebinI(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebinI_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astRebin8I(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebin8I_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astRebinB(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebinB_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astRebin8B(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebin8B_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astRebinUB(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebinUB_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astRebin8UB(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astRebin8UB_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astRebinSeqD(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeqD_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
+#define astRebinSeq8D(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeq8D_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
 #define astRebinSeqF(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeqF_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
+#define astRebinSeq8F(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeq8F_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
 #define astRebinSeqI(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeqI_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
+#define astRebinSeq8I(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeq8I_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
 #define astRebinSeqB(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeqB_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
+#define astRebinSeq8B(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeq8B_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
 #define astRebinSeqUB(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeqUB_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
+#define astRebinSeq8UB(this,wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused) astINVOKE(V,astRebinSeq8UB_(astCheckMapping(this),wlim,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused,STATUS_PTR))
 #define astResampleD(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleD_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8D(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8D_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledD(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledD_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleF(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleF_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8F(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8F_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledF(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledF_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleL(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleL_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8L(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8L_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledL(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledL_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleUL(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleUL_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8UL(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8UL_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledUL(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledUL_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleI(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleI_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8I(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8I_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledI(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledI_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleUI(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleUI_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8UI(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8UI_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledUI(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledUI_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleK(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleK_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8K(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8K_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledK(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledK_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleUK(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleUK_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8UK(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8UK_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledUK(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledUK_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleS(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleS_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8S(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8S_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledS(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledS_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleUS(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleUS_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8US(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8US_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledUS(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledUS_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleB(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleB_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8B(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8B_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledB(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledB_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astResampleUB(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleUB_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResample8UB(this,ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResample8UB_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,in,in_var,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
+#define astResampleTiledUB(this,ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var) astINVOKE(V,astResampleTiledUB_(astCheckMapping(this),ndim_in,lbnd_in,ubnd_in,tile,fetch,data,ncache,interp,finterp,params,flags,tol,maxpix,badval,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,STATUS_PTR))
 #define astRemoveRegions(this) astINVOKE(O,astRemoveRegions_(astCheckMapping(this),STATUS_PTR))
 #define astSimplify(this) astINVOKE(O,astSimplify_(astCheckMapping(this),STATUS_PTR))
 #define astTran1(this,npoint,xin,forward,xout) astINVOKE(V,astTran1_(astCheckMapping(this),npoint,xin,forward,xout,STATUS_PTR))
 #define astTran2(this,npoint,xin,yin,forward,xout,yout) astINVOKE(V,astTran2_(astCheckMapping(this),npoint,xin,yin,forward,xout,yout,STATUS_PTR))
 #define astTranGrid(this,ncoord_in,lbnd,ubnd,tol,maxpix,forward,ncoord_out,outdim,out) astINVOKE(V,astTranGrid_(astCheckMapping(this),ncoord_in,lbnd,ubnd,tol,maxpix,forward,ncoord_out,outdim,out,STATUS_PTR))
+#define astTranGrid8(this,ncoord_in,lbnd,ubnd,tol,maxpix,forward,ncoord_out,outdim,out) astINVOKE(V,astTranGrid8_(astCheckMapping(this),ncoord_in,lbnd,ubnd,tol,maxpix,forward,ncoord_out,outdim,out,STATUS_PTR))
 #define astTranN(this,npoint,ncoord_in,indim,in,forward,ncoord_out,outdim,out) astINVOKE(V,astTranN_(astCheckMapping(this),npoint,ncoord_in,indim,in,forward,ncoord_out,outdim,out,STATUS_PTR))
 #define astTranP(this,npoint,ncoord_in,ptr_in,forward,ncoord_out,ptr_out) astINVOKE(V,astTranP_(astCheckMapping(this),npoint,ncoord_in,ptr_in,forward,ncoord_out,ptr_out,STATUS_PTR))
 
@@ -1261,39 +1303,41 @@ enum { AST__NOCNV = 233934410 };
 
 #define AST__MXKEYLEN 200
 typedef struct AstMapEntry {
-   struct AstMapEntry *next;
    const char *key;
    unsigned long hash;
    int type;
    int nel;
    const char *comment;
    int defined;
-   struct AstMapEntry *snext;
-   struct AstMapEntry *sprev;
    int member;
    int keymember;
    int sortby;
 } AstMapEntry;
 
+typedef struct AstKeyMapShare AstKeyMapShare;
+
 typedef struct AstKeyMap {
 
    AstObject object;
 
    int sizeguess;
-   AstMapEntry **table;
-
-   int *nentry;
+   int *table;
    int mapsize;
+   AstMapEntry **entry;
+   int nentry;
+   int nfree;
+   int ndead;
    int keycase;
    int keyerror;
    int maplocked;
    int sortby;
-   AstMapEntry *first;
+   AstMapEntry **sorted;
    int nsorted;
+   int resort;
    int member_count;
    AstMapEntry *firstA;
    int iter_itab;
-   AstMapEntry *iter_entry;
+   struct AstKeyMapShare *share;
 } AstKeyMap;
 astPROTO_CHECK(KeyMap)
 astPROTO_ISA(KeyMap)
@@ -1360,6 +1404,21 @@ void astMapPutElemS_( AstKeyMap *, const char *, int, short int, int * );
 void astMapPutU_( AstKeyMap *, const char *, const char *, int * );
 void astMapRemove_( AstKeyMap *, const char *, int * );
 void astMapRename_( AstKeyMap *, const char *, const char *, int * );
+AstKeyMapShare *astMapShare_( AstKeyMap *, int * );
+int astMapShareGet0B_( AstKeyMapShare *, const char *, unsigned char *, int * );
+int astMapShareGet0C_( AstKeyMapShare *, const char *, int, char *, int * );
+int astMapShareGet0D_( AstKeyMapShare *, const char *, double *, int * );
+int astMapShareGet0F_( AstKeyMapShare *, const char *, float *, int * );
+int astMapShareGet0I_( AstKeyMapShare *, const char *, int *, int * );
+int astMapShareGet0P_( AstKeyMapShare *, const char *, void **, int * );
+int astMapShareGet0S_( AstKeyMapShare *, const char *, short int *, int * );
+int astMapShareGet1B_( AstKeyMapShare *, const char *, int, int *, unsigned char *, int * );
+int astMapShareGet1D_( AstKeyMapShare *, const char *, int, int *, double *, int * );
+int astMapShareGet1F_( AstKeyMapShare *, const char *, int, int *, float *, int * );
+int astMapShareGet1I_( AstKeyMapShare *, const char *, int, int *, int *, int * );
+int astMapShareGet1P_( AstKeyMapShare *, const char *, int, int *, void **, int * );
+int astMapShareGet1S_( AstKeyMapShare *, const char *, int, int *, short int *, int * );
+int astMapShareHasKey_( AstKeyMapShare *, const char *, int * );
 #define astCheckKeyMap(this) astINVOKE_CHECK(KeyMap,this,0)
 #define astVerifyKeyMap(this) astINVOKE_CHECK(KeyMap,this,1)
 
@@ -1421,6 +1480,21 @@ void astMapRename_( AstKeyMap *, const char *, const char *, int * );
 #define astMapGet0P(this,key,value) astINVOKE(V,astMapGet0P_(astCheckKeyMap(this),key,value,STATUS_PTR))
 #define astMapGet1P(this,key,mxval,nval,value) astINVOKE(V,astMapGet1P_(astCheckKeyMap(this),key,mxval,nval,value,STATUS_PTR))
 #define astMapPut1P(this,key,size,value,comment) astINVOKE(V,astMapPut1P_(astCheckKeyMap(this),key,size,value,comment,STATUS_PTR))
+#define astMapShare(this) astINVOKE(V,astMapShare_(astCheckKeyMap(this),STATUS_PTR))
+#define astMapShareGet0I(share,key,value) astERROR_INVOKE(astMapShareGet0I_(share,key,value,STATUS_PTR))
+#define astMapShareGet0B(share,key,value) astERROR_INVOKE(astMapShareGet0B_(share,key,value,STATUS_PTR))
+#define astMapShareGet0S(share,key,value) astERROR_INVOKE(astMapShareGet0S_(share,key,value,STATUS_PTR))
+#define astMapShareGet0D(share,key,value) astERROR_INVOKE(astMapShareGet0D_(share,key,value,STATUS_PTR))
+#define astMapShareGet0F(share,key,value) astERROR_INVOKE(astMapShareGet0F_(share,key,value,STATUS_PTR))
+#define astMapShareGet0P(share,key,value) astERROR_INVOKE(astMapShareGet0P_(share,key,value,STATUS_PTR))
+#define astMapShareGet0C(share,key,l,value) astERROR_INVOKE(astMapShareGet0C_(share,key,l,value,STATUS_PTR))
+#define astMapShareGet1I(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1I_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1B(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1B_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1S(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1S_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1D(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1D_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1F(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1F_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1P(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1P_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareHasKey(share,key) astERROR_INVOKE(astMapShareHasKey_(share,key,STATUS_PTR))
 #define astMapGet0A(this,key,value) astINVOKE(V,astMapGet0AId_(astCheckKeyMap(this),key,(AstObject **)(value),STATUS_PTR))
 #define astMapGet1A(this,key,mxval,nval,value) astINVOKE(V,astMapGet1AId_(astCheckKeyMap(this),key,mxval,nval,(AstObject **)(value),STATUS_PTR))
 #define astMapPut1A(this,key,size,value,comment) astINVOKE(V,astMapPut1AId_(astCheckKeyMap(this),key,size,value,comment,STATUS_PTR))
@@ -2221,6 +2295,7 @@ typedef struct AstSpecMap {
 
    int *cvttype;
    double **cvtargs;
+   void **cvtextra;
    int ncvt;
 } AstSpecMap;
 astPROTO_CHECK(SpecMap)
@@ -2307,17 +2382,28 @@ int astOverlap_( AstRegion *, AstRegion *, int * );
 void astNegate_( AstRegion *, int * );
 
 int astMaskLD_( AstRegion *, AstMapping *, int, int, const int[], const int[], long double [], long double, int * );
+int64_t astMask8LD_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long double [], long double, int * );
 
 int astMaskB_( AstRegion *, AstMapping *, int, int, const int[], const int[], signed char[], signed char, int * );
+int64_t astMask8B_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], signed char[], signed char, int * );
 int astMaskD_( AstRegion *, AstMapping *, int, int, const int[], const int[], double[], double, int * );
+int64_t astMask8D_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], double[], double, int * );
 int astMaskF_( AstRegion *, AstMapping *, int, int, const int[], const int[], float[], float, int * );
+int64_t astMask8F_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], float[], float, int * );
 int astMaskI_( AstRegion *, AstMapping *, int, int, const int[], const int[], int[], int, int * );
+int64_t astMask8I_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], int[], int, int * );
 int astMaskL_( AstRegion *, AstMapping *, int, int, const int[], const int[], long int[], long int, int * );
+int64_t astMask8L_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long int[], long int, int * );
 int astMaskS_( AstRegion *, AstMapping *, int, int, const int[], const int[], short int[], short int, int * );
+int64_t astMask8S_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], short int[], short int, int * );
 int astMaskUB_( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned char[], unsigned char, int * );
+int64_t astMask8UB_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned char[], unsigned char, int * );
 int astMaskUI_( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned int[], unsigned int, int * );
+int64_t astMask8UI_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned int[], unsigned int, int * );
 int astMaskUL_( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned long int[], unsigned long int, int * );
+int64_t astMask8UL_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned long int[], unsigned long int, int * );
 int astMaskUS_( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned short int[], unsigned short int, int * );
+int64_t astMask8US_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned short int[], unsigned short int, int * );
 void astSetUnc_( AstRegion *, AstRegion *, int * );
 AstRegion *astGetNegation_( AstRegion *, int * );
 AstRegion *astGetUnc_( AstRegion *, int, int * );
@@ -2336,17 +2422,28 @@ AstRegion *astMapRegionId_( AstRegion *, AstMapping *, AstFrame *, int * );
 #define astOverlap(this,that) astINVOKE(V,astOverlap_(astCheckRegion(this),astCheckRegion(that),STATUS_PTR))
 
 #define astMaskLD(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskLD_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8LD(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8LD_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 
 #define astMaskB(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskB_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8B(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8B_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskD(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskD_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8D(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8D_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskF(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskF_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8F(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8F_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskI(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskI_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8I(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8I_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskL(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskL_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8L(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8L_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskS(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskS_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8S(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8S_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskUB(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskUB_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8UB(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8UB_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskUI(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskUI_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8UI(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8UI_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskUL(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskUL_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8UL(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8UL_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskUS(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMaskUS_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8US(this,map,inside,ndim,lbnd,ubnd,in,val) astINVOKE(V,astMask8US_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astSetUnc(this,unc) astINVOKE(V,astSetUnc_(astCheckRegion(this),unc?astCheckRegion(unc):NULL,STATUS_PTR))
 #define astGetUnc(this,def) astINVOKE(O,astGetUnc_(astCheckRegion(this),def,STATUS_PTR))
 #define astGetRegionBounds(this,lbnd,ubnd) astINVOKE(V,astGetRegionBounds_(astCheckRegion(this),lbnd,ubnd,STATUS_PTR))
@@ -2435,6 +2532,65 @@ AstUnitMap *astUnitMapId_( int, const char *, ... )__attribute__((format(printf,
 #define astIsAUnitMap(this) astINVOKE_ISA(UnitMap,this)
 
 #define astUnitMap astINVOKE(F,astUnitMapId_)
+/* resampleplan. */
+/* ============ */
+typedef struct AstResamplePlan {
+
+   AstObject object;
+
+   double *weight;
+   int *centre;
+   int *inpix;
+   int *lbnd_in;
+   int *lbnd_out;
+   int *outpix;
+   int *start;
+   int *ubnd_in;
+   int *ubnd_out;
+   int ndim_in;
+   int ndim_out;
+   int npix;
+} AstResamplePlan;
+astPROTO_CHECK(ResamplePlan)
+astPROTO_ISA(ResamplePlan)
+
+AstResamplePlan *astResamplePlanId_( void *, int, const int [], const int [], int, const double [], double, int, int, const int [], const int [], const int [], const int [], const char *, ... )__attribute__((format(printf,14,15)));
+int astApplyPlanLD_( AstResamplePlan *, const long double[], const long double[], int, long double, long double[], long double[], int * );
+
+int astApplyPlanB_( AstResamplePlan *, const signed char[], const signed char[], int, signed char, signed char[], signed char[], int * );
+int astApplyPlanD_( AstResamplePlan *, const double[], const double[], int, double, double[], double[], int * );
+int astApplyPlanF_( AstResamplePlan *, const float[], const float[], int, float, float[], float[], int * );
+int astApplyPlanI_( AstResamplePlan *, const int[], const int[], int, int, int[], int[], int * );
+int astApplyPlanK_( AstResamplePlan *, const INT_BIG[], const INT_BIG[], int, INT_BIG, INT_BIG[], INT_BIG[], int * );
+int astApplyPlanL_( AstResamplePlan *, const long int[], const long int[], int, long int, long int[], long int[], int * );
+int astApplyPlanS_( AstResamplePlan *, const short int[], const short int[], int, short int, short int[], short int[], int * );
+int astApplyPlanUB_( AstResamplePlan *, const unsigned char[], const unsigned char[], int, unsigned char, unsigned char[], unsigned char[], int * );
+int astApplyPlanUI_( AstResamplePlan *, const unsigned int[], const unsigned int[], int, unsigned int, unsigned int[], unsigned int[], int * );
+int astApplyPlanUK_( AstResamplePlan *, const UINT_BIG[], const UINT_BIG[], int, UINT_BIG, UINT_BIG[], UINT_BIG[], int * );
+int astApplyPlanUL_( AstResamplePlan *, const unsigned long int[], const unsigned long int[], int, unsigned long int, unsigned long int[], unsigned long int[], int * );
+int astApplyPlanUS_( AstResamplePlan *, const unsigned short int[], const unsigned short int[], int, unsigned short int, unsigned short int[], unsigned short int[], int * );
+
+int astPlanBounds_( AstResamplePlan *, int, int [], int [], int * );
+#define astCheckResamplePlan(this) astINVOKE_CHECK(ResamplePlan,this,0)
+#define astVerifyResamplePlan(this) astINVOKE_CHECK(ResamplePlan,this,1)
+
+#define astIsAResamplePlan(this) astINVOKE_ISA(ResamplePlan,this)
+
+#define astResamplePlan astINVOKE(F,astResamplePlanId_)
+#define astApplyPlanLD(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanLD_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanD(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanD_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanF(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanF_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanL(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanL_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUL(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanUL_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanK(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanK_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUK(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanUK_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanI(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanI_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUI(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanUI_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanS(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanS_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUS(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanUS_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanB(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanB_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUB(this,in,in_var,flags,badval,out,out_var) astINVOKE(V,astApplyPlanUB_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astPlanBounds(this,in,lbnd,ubnd) astINVOKE(V,astPlanBounds_(astCheckResamplePlan(this),in,lbnd,ubnd,STATUS_PTR))
 /* wcsmap. */
 /* ======= */
 #define STATUS_PTR astGetStatusPtr
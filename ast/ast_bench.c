@@ -0,0 +1,2138 @@
+/* Header files. */
+/* ============= */
+/* Interface definitions. */
+/* ---------------------- */
+#include "ast.h"                 /* AST C interface definition */
+
+/* C header files. */
+/* --------------- */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#if AST__THREADSAFE
+#include <pthread.h>
+#endif
+
+/* Type Definitions. */
+/* ================= */
+/* Structure describing a single named benchmark. */
+typedef struct Bench {
+   const char *name;             /* Name of the benchmark */
+   const char *purpose;          /* One-line description */
+   int (* function)( void );     /* Function that runs the benchmark */
+} Bench;
+
+#if AST__THREADSAFE
+/* Structure holding the data used by each KeyMapReadWorker thread. */
+typedef struct KeyMapReadData {
+   AstKeyMap *keymap;            /* KeyMap to be read */
+   AstKeyMapShare *share;        /* Published snapshot of the KeyMap */
+   int fails;                    /* Number of look-ups that failed */
+   int nkey;                     /* Number of keys in the KeyMap */
+   int nlookup;                  /* Number of look-ups to perform */
+   int shared;                   /* Read the published snapshot? */
+   unsigned int seed;            /* Random number seed */
+} KeyMapReadData;
+#endif
+
+/* Function Prototypes. */
+/* ==================== */
+static double Now( void );
+static int MathMapBench( void );
+static int TranNBench( void );
+static int TanBench( void );
+static int HandlesBench( void );
+static int FitsHdrBench( void );
+static int AttribBench( void );
+static int GlobalsBench( void );
+static int PolygonBench( void );
+static int CmpRegionBench( void );
+static int MaskBench( void );
+static int ResamplePlanBench( void );
+static int CubeBench( void );
+static int KernelBench( void );
+static int KeyMapReadBench( void );
+#if AST__THREADSAFE
+static void *HandlesWorker( void * );
+static void *KeyMapReadWorker( void * );
+#endif
+
+/* Module Variables. */
+/* ================= */
+/* The list of available benchmarks. */
+static const Bench benches[] = {
+   { "mathmap", "Transform points using a complex MathMap", MathMapBench },
+   { "trann", "Transform a few points at a time using astTranN", TranNBench },
+   { "tan", "Transform pixels to RA/Dec using a FITS TAN header", TanBench },
+   { "handles", "Create and annul Objects in several threads at once", HandlesBench },
+   { "fitshdr", "Read WCS and search for keywords in large FITS headers", FitsHdrBench },
+   { "attrib", "Get numerical attribute values using astGetI and astGetD", AttribBench },
+   { "globals", "Make many cheap calls that access thread-specific data", GlobalsBench },
+   { "polygon", "Test points for inclusion in a Polygon with many vertices", PolygonBench },
+   { "cmpregion", "Test points for inclusion in nested CmpRegions", CmpRegionBench },
+   { "mask", "Mask a large image using a Polygon and a Circle", MaskBench },
+   { "resampleplan", "Resample many images using a stored ResamplePlan", ResamplePlanBench },
+   { "cube", "Resample a spectral cube using a separable Mapping", CubeBench },
+   { "kernel", "Resample and rebin an image using a tabulated kernel", KernelBench },
+   { "keymapread", "Look up KeyMap values in several threads at once", KeyMapReadBench },
+   { NULL, NULL, NULL }
+};
+
+/* Main function. */
+/* ============== */
+int main( int argc, char *argv[] ) {
+/*
+*+
+*  Name:
+*     ast_bench
+
+*  Purpose:
+*     Time selected operations of the AST library.
+
+*  Type:
+*     C program.
+
+*  Description:
+*     This program times a set of operations that are performance
+*     critical for typical users of the AST library, and reports the
+*     elapsed time for each. Where an operation can be performed in
+*     more than one way (for instance, with and without an optimisation
+*     being enabled using astTune), each way is timed and the results
+*     are checked for consistency.
+
+*  Usage:
+*     ast_bench [name ...]
+
+*  Arguments:
+*     name
+*        The names of the benchmarks to run. If no names are given, all
+*        benchmarks are run. The available benchmarks are listed if an
+*        unknown name is given.
+
+*  Exit Status:
+*     Zero if all benchmarks ran successfully and gave consistent
+*     results, and one otherwise.
+
+*  Copyright:
+*     Copyright (C) 2026 East Asian Observatory.
+
+*  Licence:
+*     This program is free software: you can redistribute it and/or
+*     modify it under the terms of the GNU Lesser General Public
+*     License as published by the Free Software Foundation, either
+*     version 3 of the License, or (at your option) any later
+*     version.
+*
+*     This program is distributed in the hope that it will be useful,
+*     but WITHOUT ANY WARRANTY; without even the implied warranty of
+*     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*     GNU Lesser General Public License for more details.
+*
+*     You should have received a copy of the GNU Lesser General
+*     License along with this program.  If not, see
+*     <http://www.gnu.org/licenses/>.
+
+*  Authors:
+*     DSB: David S. Berry (EAO)
+
+*  History:
+*     16-OCT-2026 (DSB):
+*        Original version, with a MathMap benchmark.
+*        Added the astTranN benchmark.
+*        Added the FITS TAN header benchmark.
+*        Added the multi-threaded Object handles benchmark.
+*        Added the large FITS header benchmark.
+*        Added the typed attribute access benchmark.
+*        Added the thread-specific data benchmark.
+*        Added the Polygon benchmark.
+*        Added the CmpRegion benchmark.
+*        Added the Region mask benchmark.
+*        Added the ResamplePlan benchmark.
+*        Added the cube resampling benchmark.
+*        Added the tabulated kernel benchmark.
+*-
+*/
+
+/* Local Variables: */
+   const Bench *bench;           /* Pointer to current benchmark */
+   int iarg;                     /* Loop counter for arguments */
+   int ok;                       /* All benchmarks succeeded? */
+   int run;                      /* Run the current benchmark? */
+
+/* Check all the supplied names are known. */
+   ok = 1;
+   for( iarg = 1; iarg < argc; iarg++ ) {
+      for( bench = benches; bench->name; bench++ ) {
+         if( !strcmp( argv[ iarg ], bench->name ) ) break;
+      }
+      if( !bench->name ) {
+         printf( "ast_bench: unknown benchmark \"%s\". Available "
+                 "benchmarks are:\n", argv[ iarg ] );
+         for( bench = benches; bench->name; bench++ ) {
+            printf( "   %-12s %s\n", bench->name, bench->purpose );
+         }
+         return 1;
+      }
+   }
+
+/* Run each requested benchmark in turn. */
+   for( bench = benches; bench->name; bench++ ) {
+      run = ( argc < 2 );
+      for( iarg = 1; iarg < argc; iarg++ ) {
+         if( !strcmp( argv[ iarg ], bench->name ) ) run = 1;
+      }
+
+      if( run ) {
+         printf( "%s: %s\n", bench->name, bench->purpose );
+         astBegin;
+         if( !( *bench->function )() ) ok = 0;
+         astEnd;
+
+/* Clear any error so that later benchmarks can run. */
+         if( !astOK ) {
+            ok = 0;
+            astClearStatus;
+         }
+      }
+   }
+
+/* Report the outcome. */
+   printf( ok ? "ast_bench: all benchmarks succeeded\n" :
+                "ast_bench: one or more benchmarks failed\n" );
+   return ok ? 0 : 1;
+}
+
+static double Now( void ) {
+/*
+*  Name:
+*     Now
+
+*  Purpose:
+*     Return the current wall-clock time in seconds.
+
+*  Description:
+*     This function returns the time in seconds since an arbitrary
+*     epoch, for use in timing benchmarks.
+*/
+
+/* Local Variables: */
+   struct timeval tv;
+
+   gettimeofday( &tv, NULL );
+   return (double) tv.tv_sec + 1.0E-6 * (double) tv.tv_usec;
+}
+
+static int MathMapBench( void ) {
+/*
+*  Name:
+*     MathMapBench
+
+*  Purpose:
+*     Time the transformation of points using a MathMap.
+
+*  Description:
+*     This function creates a MathMap describing a radial distortion
+*     followed by a rotation (typical of those used to describe
+*     instrument distortions), and times the transformation of a large
+*     number of points using the original interpreter (MathMapBlock set
+*     to zero) and the default block evaluator. The two sets of results
+*     must be identical.
+
+*  Returned Value:
+*     Non-zero if the results are identical, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NPOINT 1000000           /* Number of points to transform */
+#define NREP 5                   /* Number of repeats of each timing */
+
+/* Local Variables: */
+   AstMathMap *map;              /* The MathMap */
+   const char *fwd[ 5 ];         /* Forward expressions */
+   const char *inv[ 2 ];         /* Inverse expressions */
+   double *in;                   /* Input coordinates */
+   double *out_block;            /* Outputs from block evaluator */
+   double *out_interp;           /* Outputs from interpreter */
+   double t0;                    /* Start time */
+   double t_block;               /* Time for block evaluator */
+   double t_interp;              /* Time for interpreter */
+   int block;                    /* Original MathMapBlock value */
+   int i;                        /* Loop counter for points */
+   int irep;                     /* Loop counter for repeats */
+   int ok;                       /* Results identical? */
+
+/* Define the forward transformation. The first three functions produce
+   intermediate results. */
+   fwd[ 0 ] = "r2 = x * x + y * y";
+   fwd[ 1 ] = "f = 1 + 2.5E-4 * r2 + 1.2E-8 * r2 * r2 + 3.0E-13 * r2 ** 3";
+   fwd[ 2 ] = "a = 0.3 * <pi> / 180";
+   fwd[ 3 ] = "xo = 512.5 + x * f * cos( a ) - y * f * sin( a )";
+   fwd[ 4 ] = "yo = 256.5 + x * f * sin( a ) + y * f * cos( a )";
+   inv[ 0 ] = "x";
+   inv[ 1 ] = "y";
+   map = astMathMap( 2, 2, 5, fwd, 2, inv, " " );
+
+/* Create the input positions, including some bad values. */
+   in = malloc( sizeof( double ) * 2 * NPOINT );
+   out_block = malloc( sizeof( double ) * 2 * NPOINT );
+   out_interp = malloc( sizeof( double ) * 2 * NPOINT );
+   if( !in || !out_block || !out_interp ) {
+      printf( "   Cannot allocate memory.\n" );
+      free( in );
+      free( out_block );
+      free( out_interp );
+      return 0;
+   }
+
+   for( i = 0; i < NPOINT; i++ ) {
+      in[ i ] = (double) ( i % 1000 ) - 500.0;
+      in[ i + NPOINT ] = (double) ( i / 1000 ) - 500.0;
+   }
+   in[ NPOINT / 2 ] = AST__BAD;
+
+/* Time the interpreter. */
+   block = astTune( "MathMapBlock", 0 );
+   t0 = Now();
+   for( irep = 0; irep < NREP; irep++ ) {
+      astTranN( map, NPOINT, 2, NPOINT, in, 1, 2, NPOINT, out_interp );
+   }
+   t_interp = ( Now() - t0 ) / NREP;
+
+/* Time the block evaluator. */
+   astTune( "MathMapBlock", block );
+   t0 = Now();
+   for( irep = 0; irep < NREP; irep++ ) {
+      astTranN( map, NPOINT, 2, NPOINT, in, 1, 2, NPOINT, out_block );
+   }
+   t_block = ( Now() - t0 ) / NREP;
+
+/* Compare the results. */
+   ok = astOK;
+   for( i = 0; ok && i < 2 * NPOINT; i++ ) {
+      if( out_block[ i ] != out_interp[ i ] ) {
+         printf( "   Results differ at element %d: %.17g != %.17g\n", i,
+                 out_block[ i ], out_interp[ i ] );
+         ok = 0;
+      }
+   }
+
+   printf( "   %d points: interpreter %.4f s, MathMapBlock=%d %.4f s "
+           "(speed-up %.2f)\n", NPOINT, t_interp, block, t_block,
+           ( t_block > 0.0 ) ? t_interp / t_block : 0.0 );
+
+   free( in );
+   free( out_block );
+   free( out_interp );
+   map = astAnnul( map );
+   return ok;
+
+/* Undefine local macros. */
+#undef NPOINT
+#undef NREP
+}
+
+static int TranNBench( void ) {
+/*
+*  Name:
+*     TranNBench
+
+*  Purpose:
+*     Time the transformation of small numbers of points using astTranN.
+
+*  Description:
+*     This function creates a series CmpMap containing several simple
+*     Mappings, and times a large number of calls to astTranN that each
+*     transform only a few points (as is typical of applications that
+*     transform positions one at a time). This is compared with the
+*     time taken to transform all the same points in a single call, so
+*     that the overhead per call can be seen. The two sets of results
+*     must be identical.
+
+*  Returned Value:
+*     Non-zero if the results are identical, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NPOINT 4                 /* Number of points per call */
+#define NCALL 200000             /* Number of calls */
+#define NTOT ( NPOINT * NCALL )  /* Total number of points */
+
+/* Local Variables: */
+   AstMapping *map;              /* The CmpMap */
+   AstMapping *tmap;             /* Temporary Mapping pointer */
+   double *in;                   /* Input positions */
+   double *out_bulk;             /* Outputs from a single call */
+   double *out_small;            /* Outputs from many small calls */
+   double matrix[ 4 ];           /* Rotation matrix */
+   double shift[ 2 ];            /* Axis shifts */
+   double t0;                    /* Start time */
+   double t_bulk;                /* Time for a single call */
+   double t_small;               /* Time for many small calls */
+   int i;                        /* Loop counter for points */
+   int icall;                    /* Loop counter for calls */
+   int ok;                       /* Results identical? */
+
+/* Create a CmpMap that shifts, rotates and scales 2D positions. */
+   shift[ 0 ] = -512.5;
+   shift[ 1 ] = -256.5;
+   matrix[ 0 ] = cos( 0.3 );
+   matrix[ 1 ] = -sin( 0.3 );
+   matrix[ 2 ] = sin( 0.3 );
+   matrix[ 3 ] = cos( 0.3 );
+   map = (AstMapping *) astShiftMap( 2, shift, " " );
+   tmap = (AstMapping *) astMatrixMap( 2, 2, 0, matrix, " " );
+   map = (AstMapping *) astCmpMap( map, tmap, 1, " " );
+   tmap = (AstMapping *) astZoomMap( 2, 1.0E-4, " " );
+   map = (AstMapping *) astCmpMap( map, tmap, 1, " " );
+
+/* Create the input positions. */
+   in = malloc( sizeof( double ) * 2 * NTOT );
+   out_bulk = malloc( sizeof( double ) * 2 * NTOT );
+   out_small = malloc( sizeof( double ) * 2 * NTOT );
+   if( !in || !out_bulk || !out_small ) {
+      printf( "   Cannot allocate memory.\n" );
+      free( in );
+      free( out_bulk );
+      free( out_small );
+      map = astAnnul( map );
+      return 0;
+   }
+
+   for( i = 0; i < NTOT; i++ ) {
+      in[ i ] = (double) ( i % 1000 );
+      in[ i + NTOT ] = (double) ( i / 1000 );
+   }
+
+/* Time the transformation of all points in a single call. */
+   t0 = Now();
+   astTranN( map, NTOT, 2, NTOT, in, 1, 2, NTOT, out_bulk );
+   t_bulk = Now() - t0;
+
+/* Time the transformation of the same points, a few at a time. */
+   t0 = Now();
+   for( icall = 0; icall < NCALL && astOK; icall++ ) {
+      astTranN( map, NPOINT, 2, NTOT, in + icall * NPOINT, 1, 2, NTOT,
+                out_small + icall * NPOINT );
+   }
+   t_small = Now() - t0;
+
+/* Compare the results. */
+   ok = astOK;
+   for( i = 0; ok && i < 2 * NTOT; i++ ) {
+      if( out_small[ i ] != out_bulk[ i ] ) {
+         printf( "   Results differ at element %d: %.17g != %.17g\n", i,
+                 out_small[ i ], out_bulk[ i ] );
+         ok = 0;
+      }
+   }
+
+   printf( "   %d points: single call %.4f s, %d calls of %d points "
+           "%.4f s (%.3f us per call)\n", NTOT, t_bulk, NCALL, NPOINT,
+           t_small, 1.0E6 * t_small / NCALL );
+
+   free( in );
+   free( out_bulk );
+   free( out_small );
+   map = astAnnul( map );
+   return ok;
+
+/* Undefine local macros. */
+#undef NPOINT
+#undef NCALL
+#undef NTOT
+}
+
+static int TanBench( void ) {
+/*
+*  Name:
+*     TanBench
+
+*  Purpose:
+*     Time the transformation of pixel coordinates using a TAN header.
+
+*  Description:
+*     This function reads a FrameSet from a typical FITS-WCS header
+*     describing a tangent plane projection, and times the
+*     transformation of a large number of pixel positions to (RA,Dec)
+*     using the simplified pixel->sky Mapping (a series CmpMap). This is
+*     done with each component Mapping applied separately (CmpMapBlock
+*     set to zero) and with the default compiled pipeline. The two sets
+*     of results must agree to within rounding error.
+
+*  Returned Value:
+*     Non-zero if the results agree, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NPOINT 1000000           /* Number of points to transform */
+#define NREP 5                   /* Number of repeats of each timing */
+#define TOL 1.0E-12              /* Largest allowed difference (radians) */
+
+/* Local Variables: */
+   AstFitsChan *fc;              /* FitsChan holding the header */
+   AstFrameSet *fs;              /* FrameSet read from the header */
+   AstMapping *map;              /* Simplified pixel->sky Mapping */
+   AstMapping *tmap;             /* Unsimplified pixel->sky Mapping */
+   double *in;                   /* Input pixel coordinates */
+   double *out_pipe;             /* Outputs using pipelines */
+   double *out_sep;              /* Outputs using separate Mappings */
+   double diff;                  /* Difference between outputs */
+   double maxdiff;               /* Largest difference between outputs */
+   double t0;                    /* Start time */
+   double t_pipe;                /* Time using pipelines */
+   double t_sep;                 /* Time using separate Mappings */
+   int block;                    /* Original CmpMapBlock value */
+   int i;                        /* Loop counter for points */
+   int icard;                    /* Loop counter for header cards */
+   int irep;                     /* Loop counter for repeats */
+   int ok;                       /* Results agree? */
+   static const char *cards[] = {
+      "NAXIS   = 2",
+      "NAXIS1  = 1000",
+      "NAXIS2  = 1000",
+      "CTYPE1  = 'RA---TAN'",
+      "CTYPE2  = 'DEC--TAN'",
+      "CRPIX1  = 500.5",
+      "CRPIX2  = 500.5",
+      "CRVAL1  = 202.4842",
+      "CRVAL2  = 47.2306",
+      "CD1_1   = -2.7777E-4",
+      "CD1_2   = 1.2E-6",
+      "CD2_1   = 1.1E-6",
+      "CD2_2   = 2.7777E-4",
+      "RADESYS = 'ICRS'",
+      NULL
+   };
+
+/* Read a FrameSet from the header, and get the simplified Mapping from
+   pixel coordinates to (RA,Dec). */
+   fc = astFitsChan( NULL, NULL, " " );
+   for( icard = 0; cards[ icard ]; icard++ ) {
+      astPutFits( fc, cards[ icard ], 0 );
+   }
+   astClear( fc, "Card" );
+   fs = astRead( fc );
+   if( !fs ) {
+      printf( "   Cannot read a FrameSet from the header.\n" );
+      fc = astAnnul( fc );
+      return 0;
+   }
+   tmap = astGetMapping( fs, AST__BASE, AST__CURRENT );
+   map = astSimplify( tmap );
+   printf( "   Mapping is a %s\n", astGetC( map, "Class" ) );
+
+/* Create the input positions. */
+   in = malloc( sizeof( double ) * 2 * NPOINT );
+   out_pipe = malloc( sizeof( double ) * 2 * NPOINT );
+   out_sep = malloc( sizeof( double ) * 2 * NPOINT );
+   ok = ( in && out_pipe && out_sep );
+   if( !ok ) printf( "   Cannot allocate memory.\n" );
+
+   if( ok ) {
+      for( i = 0; i < NPOINT; i++ ) {
+         in[ i ] = (double) ( i % 1000 ) + 1.0;
+         in[ i + NPOINT ] = (double) ( i / 1000 ) + 1.0;
+      }
+      in[ NPOINT / 2 ] = AST__BAD;
+
+/* Time the transformations with each component Mapping applied
+   separately. */
+      block = astTune( "CmpMapBlock", 0 );
+      t0 = Now();
+      for( irep = 0; irep < NREP; irep++ ) {
+         astTranN( map, NPOINT, 2, NPOINT, in, 1, 2, NPOINT, out_sep );
+      }
+      t_sep = ( Now() - t0 ) / NREP;
+
+/* Time the transformations using compiled pipelines. */
+      astTune( "CmpMapBlock", block );
+      t0 = Now();
+      for( irep = 0; irep < NREP; irep++ ) {
+         astTranN( map, NPOINT, 2, NPOINT, in, 1, 2, NPOINT, out_pipe );
+      }
+      t_pipe = ( Now() - t0 ) / NREP;
+
+/* Compare the results. Bad values must occur at the same positions. */
+      ok = astOK;
+      maxdiff = 0.0;
+      for( i = 0; ok && i < 2 * NPOINT; i++ ) {
+         if( out_pipe[ i ] == AST__BAD || out_sep[ i ] == AST__BAD ) {
+            diff = ( out_pipe[ i ] == out_sep[ i ] ) ? 0.0 : 2.0 * TOL;
+         } else {
+            diff = fabs( out_pipe[ i ] - out_sep[ i ] );
+         }
+         if( diff > maxdiff ) maxdiff = diff;
+         if( diff > TOL ) {
+            printf( "   Results differ at element %d: %.17g != %.17g\n", i,
+                    out_pipe[ i ], out_sep[ i ] );
+            ok = 0;
+         }
+      }
+
+      printf( "   %d points: separate Mappings %.4f s, CmpMapBlock=%d "
+              "%.4f s (speed-up %.2f, max. difference %.3g rad)\n", NPOINT,
+              t_sep, block, t_pipe, ( t_pipe > 0.0 ) ? t_sep / t_pipe : 0.0,
+              maxdiff );
+   }
+
+   free( in );
+   free( out_pipe );
+   free( out_sep );
+   map = astAnnul( map );
+   tmap = astAnnul( tmap );
+   fs = astAnnul( fs );
+   fc = astAnnul( fc );
+   return ok;
+
+/* Undefine local macros. */
+#undef NPOINT
+#undef NREP
+#undef TOL
+}
+
+static int HandlesBench( void ) {
+/*
+*  Name:
+*     HandlesBench
+
+*  Purpose:
+*     Time the creation and annulling of Objects in several threads.
+
+*  Description:
+*     This function starts 1, 2, 4 and 8 threads in turn. Each thread
+*     repeatedly creates a few short-lived Mappings through the public
+*     interface, uses them, and annuls them again, occasionally within
+*     an astBegin/astEnd context. Each thread does the same amount of
+*     work, so if the handling of public Object identifiers scales
+*     linearly with the number of threads, the elapsed time stays
+*     constant as threads are added (so long as there are enough
+*     processors). The elapsed time per operation and the speed-up
+*     relative to one thread are reported.
+
+*  Returned Value:
+*     Non-zero if all threads completed without error, zero otherwise.
+
+*  Notes:
+*     - This benchmark does nothing if AST was built without POSIX
+*     thread support.
+*/
+
+#if AST__THREADSAFE
+
+/* Local Constants: */
+#define MXTHREAD 8               /* Largest number of threads */
+#define NITER 100000             /* Number of iterations per thread */
+
+/* Local Variables: */
+   double rate1;                 /* Operations per second using 1 thread */
+   double rate;                  /* Operations per second */
+   double t0;                    /* Start time */
+   double t;                     /* Elapsed time */
+   int fails[ MXTHREAD ];        /* Number of failures in each thread */
+   int ithread;                  /* Loop counter for threads */
+   int nthread;                  /* Number of threads */
+   int ok;                       /* All threads succeeded? */
+   pthread_t threads[ MXTHREAD ];/* Thread identifiers */
+
+   ok = 1;
+   rate1 = 0.0;
+   for( nthread = 1; ok && nthread <= MXTHREAD; nthread *= 2 ) {
+
+/* Start the threads, and wait for them all to finish. Each thread
+   performs NITER iterations. */
+      t0 = Now();
+      for( ithread = 0; ithread < nthread; ithread++ ) {
+         fails[ ithread ] = NITER;
+         if( pthread_create( threads + ithread, NULL, HandlesWorker,
+                             fails + ithread ) ) {
+            printf( "   Cannot start thread %d.\n", ithread );
+            nthread = ithread;
+            ok = 0;
+         }
+      }
+      for( ithread = 0; ithread < nthread; ithread++ ) {
+         pthread_join( threads[ ithread ], NULL );
+         if( fails[ ithread ] ) {
+            printf( "   Thread %d failed %d times.\n", ithread,
+                    fails[ ithread ] );
+            ok = 0;
+         }
+      }
+      t = Now() - t0;
+
+/* Report the rate at which iterations were performed, in total. */
+      if( ok ) {
+         rate = ( nthread * NITER ) / t;
+         if( nthread == 1 ) rate1 = rate;
+         printf( "   %d thread(s): %.4f s, %.3f us per iteration, "
+                 "speed-up %.2f\n", nthread, t, 1.0E6 / rate,
+                 rate / rate1 );
+      }
+   }
+
+   return ok;
+
+/* Undefine local macros. */
+#undef MXTHREAD
+#undef NITER
+
+#else
+   printf( "   AST was built without POSIX thread support.\n" );
+   return 1;
+#endif
+}
+
+#if AST__THREADSAFE
+static void *HandlesWorker( void *data ) {
+/*
+*  Name:
+*     HandlesWorker
+
+*  Purpose:
+*     Create and annul Objects repeatedly within a single thread.
+
+*  Description:
+*     This function is run in a separate thread by HandlesBench. Each
+*     iteration creates a ZoomMap and a series CmpMap through the public
+*     interface, transforms a single point, and then annuls both
+*     Mappings. Every 16th iteration is enclosed in an astBegin/astEnd
+*     context, and the Mappings are left for astEnd to annul.
+
+*  Parameters:
+*     data
+*        Pointer to an int holding the number of iterations to perform.
+*        On exit, it holds the number of iterations that failed.
+
+*  Returned Value:
+*     NULL.
+*/
+
+/* Local Variables: */
+   AstMapping *cmp;              /* CmpMap */
+   AstMapping *map;              /* ZoomMap */
+   double xin;                   /* Input X value */
+   double xout;                  /* Output X value */
+   double yin;                   /* Input Y value */
+   double yout;                  /* Output Y value */
+   int *fails;                   /* Pointer to iteration/failure count */
+   int iter;                     /* Loop counter for iterations */
+   int niter;                    /* Number of iterations */
+
+   fails = (int *) data;
+   niter = *fails;
+   *fails = 0;
+
+   for( iter = 0; iter < niter; iter++ ) {
+      if( iter % 16 == 0 ) astBegin;
+
+      map = (AstMapping *) astZoomMap( 2, 2.0, " " );
+      cmp = (AstMapping *) astCmpMap( map, map, 1, " " );
+      xin = (double) iter;
+      yin = 1.0;
+      astTran2( cmp, 1, &xin, &yin, 1, &xout, &yout );
+      if( !astOK || xout != 4.0 * xin || yout != 4.0 ) {
+         ( *fails )++;
+         astClearStatus;
+      }
+
+      if( iter % 16 == 0 ) {
+         astEnd;
+      } else {
+         cmp = astAnnul( cmp );
+         map = astAnnul( map );
+      }
+   }
+
+   return NULL;
+}
+#endif
+
+static int FitsHdrBench( void ) {
+/*
+*  Name:
+*     FitsHdrBench
+
+*  Purpose:
+*     Time the reading of WCS from FITS headers of increasing size.
+
+*  Description:
+*     This function creates FITS headers holding 300, 3000 and 30000
+*     cards. Each describes a TPV projection (with 22 PVi_m distortion
+*     coefficients) in its first few cards, followed by many unrelated
+*     keywords and HISTORY cards. For each header, it times the reading
+*     of a FrameSet (using astRead on a fresh copy of the header), and
+*     the searching for keywords using astFindFits, both with fixed
+*     keyword names and with the template "PV%d_%d". If the time taken
+*     to find a keyword does not depend on the number of cards in the
+*     header, the reported times per search stay roughly constant as
+*     the header grows.
+
+*  Returned Value:
+*     Non-zero if all FrameSets were read and all keywords found
+*     correctly, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NREAD 5                  /* Number of times to read each FrameSet */
+#define NSEARCH 2000             /* Number of search loops per header */
+#define TOL 1.0E-10              /* Largest allowed error (radians) */
+
+/* Local Variables: */
+   AstFitsChan *fc;              /* FitsChan holding the header */
+   AstFitsChan *fccopy;          /* Copy of header for astRead */
+   AstFrameSet *fs;              /* FrameSet read from the header */
+   char card[ 81 ];              /* Buffer for a header card */
+   double t0;                    /* Start time */
+   double t_read;                /* Time to read a FrameSet */
+   double t_search;              /* Time to search for keywords */
+   double xin;                   /* Reference pixel X */
+   double xout;                  /* Reference RA */
+   double yin;                   /* Reference pixel Y */
+   double yout;                  /* Reference Dec */
+   int icard;                    /* Loop counter for header cards */
+   int iread;                    /* Loop counter for reads */
+   int isearch;                  /* Loop counter for searches */
+   int ncard;                    /* Number of cards in header */
+   int npv;                      /* Number of PV cards found */
+   int ok;                       /* Results correct? */
+   static const char *wcs[] = {
+      "NAXIS   = 2",
+      "NAXIS1  = 4096",
+      "NAXIS2  = 4096",
+      "CTYPE1  = 'RA---TPV'",
+      "CTYPE2  = 'DEC--TPV'",
+      "CRPIX1  = 2048.5",
+      "CRPIX2  = 2048.5",
+      "CRVAL1  = 150.1",
+      "CRVAL2  = 2.2",
+      "CD1_1   = -7.3E-5",
+      "CD1_2   = 1.0E-7",
+      "CD2_1   = 1.2E-7",
+      "CD2_2   = 7.3E-5",
+      "RADESYS = 'ICRS'",
+      NULL
+   };
+
+   ok = 1;
+   for( ncard = 300; ok && ncard <= 30000; ncard *= 10 ) {
+
+/* Create the header. The WCS cards come first, followed by the PV
+   distortion coefficients, and then unrelated cards. */
+      fc = astFitsChan( NULL, NULL, " " );
+      for( icard = 0; wcs[ icard ]; icard++ ) {
+         astPutFits( fc, wcs[ icard ], 0 );
+      }
+      for( icard = 0; icard <= 10; icard++ ) {
+         sprintf( card, "PV1_%-4d= %g", icard, ( icard == 1 ) ? 1.0 :
+                  1.0E-6 * icard );
+         astPutFits( fc, card, 0 );
+         sprintf( card, "PV2_%-4d= %g", icard, ( icard == 1 ) ? 1.0 :
+                  -1.0E-6 * icard );
+         astPutFits( fc, card, 0 );
+      }
+      for( icard = astGetI( fc, "Ncard" ); icard < ncard; icard++ ) {
+         if( icard % 10 ) {
+            sprintf( card, "K%07d= %d", icard, icard );
+         } else {
+            sprintf( card, "HISTORY Processing step %d", icard );
+         }
+         astPutFits( fc, card, 0 );
+      }
+
+/* Time the reading of a FrameSet from a copy of the header (astRead
+   removes the cards it uses). Check the reference pixel is transformed
+   to the reference position. */
+      t_read = 0.0;
+      for( iread = 0; ok && iread < NREAD; iread++ ) {
+         fccopy = astCopy( fc );
+         astClear( fccopy, "Card" );
+         t0 = Now();
+         fs = astRead( fccopy );
+         t_read += Now() - t0;
+
+         if( fs ) {
+            xin = 2048.5;
+            yin = 2048.5;
+            astTran2( fs, 1, &xin, &yin, 1, &xout, &yout );
+            if( fabs( xout - 150.1*AST__DD2R ) > TOL ||
+                fabs( yout - 2.2*AST__DD2R ) > TOL ) {
+               printf( "   Wrong reference position (%.10g,%.10g).\n",
+                       xout*AST__DR2D, yout*AST__DR2D );
+               ok = 0;
+            }
+            fs = astAnnul( fs );
+         } else {
+            printf( "   Cannot read a FrameSet from the header.\n" );
+            ok = 0;
+         }
+         fccopy = astAnnul( fccopy );
+      }
+      t_read /= NREAD;
+
+/* Time searches for the last card, a missing card and all the PV cards,
+   each starting from the first card (25 calls to astFindFits in all). */
+      t0 = Now();
+      for( isearch = 0; ok && isearch < NSEARCH; isearch++ ) {
+         astClear( fc, "Card" );
+         sprintf( card, "K%07d", ncard - 1 );
+         if( !astFindFits( fc, card, NULL, 0 ) ) ok = 0;
+         astClear( fc, "Card" );
+         if( astFindFits( fc, "NOSUCHKY", NULL, 0 ) ) ok = 0;
+         astClear( fc, "Card" );
+         npv = 0;
+         while( astFindFits( fc, "PV%d_%d", NULL, 1 ) ) npv++;
+         if( npv != 22 ) ok = 0;
+      }
+      t_search = ( Now() - t0 ) / ( 25 * NSEARCH );
+      if( !ok ) printf( "   Keyword searches gave wrong results.\n" );
+
+      printf( "   %5d cards: astRead %.4f s, %.3f us per astFindFits\n",
+              ncard, t_read, 1.0E6 * t_search );
+      fc = astAnnul( fc );
+   }
+
+   return ok && astOK;
+
+/* Undefine local macros. */
+#undef NREAD
+#undef NSEARCH
+#undef TOL
+}
+
+static int AttribBench( void ) {
+/*
+*  Name:
+*     AttribBench
+
+*  Purpose:
+*     Time access to numerical attribute values.
+
+*  Description:
+*     This function times a large number of calls to astGetI and astGetD
+*     for attributes that have typed access functions (Nin and Zoom for a
+*     ZoomMap, Epoch and Equinox for a SkyFrame). This is compared with
+*     the time taken to get the same values as strings using astGetC and
+*     convert them to numbers, which is what astGetI and astGetD used to
+*     do. The two sets of values must be identical.
+
+*  Returned Value:
+*     Non-zero if the values are identical, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NCALL 200000             /* Number of calls for each attribute */
+
+/* Local Variables: */
+   AstSkyFrame *sky;             /* The SkyFrame */
+   AstZoomMap *zoom;             /* The ZoomMap */
+   double sum_string;            /* Sum of values obtained as strings */
+   double sum_typed;             /* Sum of values obtained as numbers */
+   double t0;                    /* Start time */
+   double t_string;              /* Time for string access */
+   double t_typed;               /* Time for typed access */
+   int icall;                    /* Loop counter for calls */
+   int ok;                       /* Values identical? */
+
+/* Create the Objects. */
+   zoom = astZoomMap( 3, 2.5, " " );
+   sky = astSkyFrame( "System=FK4,Equinox=1950,Epoch=J2010.5" );
+
+/* Time typed access. */
+   sum_typed = 0.0;
+   t0 = Now();
+   for( icall = 0; icall < NCALL && astOK; icall++ ) {
+      sum_typed += astGetI( zoom, "Nin" );
+      sum_typed += astGetD( zoom, "Zoom" );
+      sum_typed += astGetD( sky, "Epoch" );
+      sum_typed += astGetD( sky, "Equinox" );
+   }
+   t_typed = Now() - t0;
+
+/* Time access through formatted strings. */
+   sum_string = 0.0;
+   t0 = Now();
+   for( icall = 0; icall < NCALL && astOK; icall++ ) {
+      sum_string += atoi( astGetC( zoom, "Nin" ) );
+      sum_string += atof( astGetC( zoom, "Zoom" ) );
+      sum_string += atof( astGetC( sky, "Epoch" ) );
+      sum_string += atof( astGetC( sky, "Equinox" ) );
+   }
+   t_string = Now() - t0;
+
+/* Compare the results. */
+   ok = astOK;
+   if( ok && sum_typed != sum_string ) {
+      printf( "   Values differ: %.17g != %.17g\n", sum_typed, sum_string );
+      ok = 0;
+   }
+
+   printf( "   %d calls: typed %.4f s (%.3f us per call), strings %.4f s "
+           "(%.3f us per call)\n", 4*NCALL, t_typed, 1.0E6 * t_typed / ( 4*NCALL ),
+           t_string, 1.0E6 * t_string / ( 4*NCALL ) );
+
+   zoom = astAnnul( zoom );
+   sky = astAnnul( sky );
+   return ok;
+
+/* Undefine local macros. */
+#undef NCALL
+}
+
+static int GlobalsBench( void ) {
+/*
+*  Name:
+*     GlobalsBench
+
+*  Purpose:
+*     Time cheap calls that are dominated by access to global data.
+
+*  Description:
+*     This function times a large number of calls to astTran2 that each
+*     transform a single point using a ZoomMap, and a large number of
+*     calls to astGetD. Each of these calls checks the inherited status
+*     and accesses thread-specific global data several times, so in the
+*     thread-safe version of AST the results are sensitive to the way in
+*     which each thread's global data is located. To see the difference,
+*     run this benchmark with AST built normally (which uses compiler
+*     thread-local storage if available) and with AST built with
+*     AST__NO_TLS defined (which uses pthreads thread-specific data
+*     keys).
+
+*  Returned Value:
+*     Non-zero if the results are correct, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NCALL 1000000            /* Number of calls of each function */
+
+/* Local Variables: */
+   AstZoomMap *zoom;             /* The ZoomMap */
+   double sum;                   /* Sum of attribute values */
+   double t0;                    /* Start time */
+   double t_get;                 /* Time for astGetD calls */
+   double t_tran;                /* Time for astTran2 calls */
+   double xin;                   /* Input X value */
+   double xout;                  /* Output X value */
+   double yin;                   /* Input Y value */
+   double yout;                  /* Output Y value */
+   int icall;                    /* Loop counter for calls */
+   int ok;                       /* Results correct? */
+
+/* Create the ZoomMap. */
+   zoom = astZoomMap( 2, 2.0, " " );
+
+/* Time the transformation of single points. */
+   ok = 1;
+   t0 = Now();
+   for( icall = 0; icall < NCALL && astOK; icall++ ) {
+      xin = (double) icall;
+      yin = -xin;
+      astTran2( zoom, 1, &xin, &yin, 1, &xout, &yout );
+      if( xout != 2.0*xin || yout != 2.0*yin ) ok = 0;
+   }
+   t_tran = Now() - t0;
+
+/* Time the getting of an attribute value. */
+   sum = 0.0;
+   t0 = Now();
+   for( icall = 0; icall < NCALL && astOK; icall++ ) {
+      sum += astGetD( zoom, "Zoom" );
+   }
+   t_get = Now() - t0;
+
+/* Check the results. */
+   if( !astOK || !ok || sum != 2.0*NCALL ) {
+      printf( "   Incorrect results\n" );
+      ok = 0;
+   }
+
+   printf( "   %d calls: astTran2 %.4f s (%.3f us per call), astGetD %.4f s "
+           "(%.3f us per call)\n", NCALL, t_tran, 1.0E6 * t_tran / NCALL,
+           t_get, 1.0E6 * t_get / NCALL );
+
+   zoom = astAnnul( zoom );
+   return ok;
+
+/* Undefine local macros. */
+#undef NCALL
+}
+
+static int PolygonBench( void ) {
+/*
+*  Name:
+*     PolygonBench
+
+*  Purpose:
+*     Time the testing of points for inclusion in a large Polygon.
+
+*  Description:
+*     This function creates a star-shaped Polygon with many vertices and
+*     times the use of astTran2 to determine which of a set of random
+*     points are inside it. This is done first with the Polygon defined
+*     in a simple 2-dimensional Frame (for which the Polygon uses a grid
+*     of edges to avoid checking every edge for every point), and then
+*     with the same Polygon defined in a CmpFrame containing two
+*     1-dimensional Frames (which has the same geometry, but for which
+*     every edge is checked). Fewer points are used in the second case.
+*     The two sets of results must agree.
+
+*  Returned Value:
+*     Non-zero if the results agree, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NVERT 10000              /* Number of vertices */
+#define NPOINT 100000            /* Number of points for the grid */
+#define NSLOW 1000               /* Number of points checking every edge */
+
+/* Local Variables: */
+   AstFrame *frm;                /* The simple Frame */
+   AstFrame *cfrm;               /* The CmpFrame */
+   AstPolygon *cpoly;            /* Polygon defined in the CmpFrame */
+   AstPolygon *poly;             /* Polygon defined in the simple Frame */
+   double *px;                   /* X values of test points */
+   double *py;                   /* Y values of test points */
+   double *qx;                   /* Transformed X values (grid) */
+   double *qy;                   /* Transformed Y values (grid) */
+   double *rx;                   /* Transformed X values (all edges) */
+   double *ry;                   /* Transformed Y values (all edges) */
+   double *vert;                 /* Vertex positions */
+   double angle;                 /* Angle to vertex */
+   double radius;                /* Distance to vertex */
+   double t0;                    /* Start time */
+   double t_grid;                /* Time using the grid */
+   double t_slow;                /* Time checking every edge */
+   int i;                        /* Loop counter */
+   int nin;                      /* Number of points inside */
+   int ok;                       /* Results agree? */
+
+/* Allocate memory. */
+   vert = malloc( sizeof( double )*2*NVERT );
+   px = malloc( sizeof( double )*NPOINT );
+   py = malloc( sizeof( double )*NPOINT );
+   qx = malloc( sizeof( double )*NPOINT );
+   qy = malloc( sizeof( double )*NPOINT );
+   rx = malloc( sizeof( double )*NSLOW );
+   ry = malloc( sizeof( double )*NSLOW );
+   if( !vert || !px || !py || !qx || !qy || !rx || !ry ) {
+      printf( "   Cannot allocate memory.\n" );
+      free( vert );
+      free( px );
+      free( py );
+      free( qx );
+      free( qy );
+      free( rx );
+      free( ry );
+      return 0;
+   }
+
+/* Create the vertices of a star-shaped polygon with a ragged edge, and
+   the test positions. */
+   srand( 1 );
+   for( i = 0; i < NVERT; i++ ) {
+      angle = 2.0*M_PI*i/NVERT;
+      radius = 0.5 + 0.5*rand()/(double) RAND_MAX;
+      vert[ i ] = radius*cos( angle );
+      vert[ i + NVERT ] = radius*sin( angle );
+   }
+   for( i = 0; i < NPOINT; i++ ) {
+      px[ i ] = 2.4*rand()/(double) RAND_MAX - 1.2;
+      py[ i ] = 2.4*rand()/(double) RAND_MAX - 1.2;
+   }
+
+/* Create the two Polygons. */
+   frm = astFrame( 1, " " );
+   cfrm = (AstFrame *) astCmpFrame( frm, frm, " " );
+   frm = astAnnul( frm );
+   frm = astFrame( 2, " " );
+   poly = astPolygon( frm, NVERT, NVERT, vert, NULL, " " );
+   cpoly = astPolygon( cfrm, NVERT, NVERT, vert, NULL, " " );
+
+/* Time the tests using each Polygon. */
+   t0 = Now();
+   astTran2( poly, NPOINT, px, py, 1, qx, qy );
+   t_grid = Now() - t0;
+
+   t0 = Now();
+   astTran2( cpoly, NSLOW, px, py, 1, rx, ry );
+   t_slow = Now() - t0;
+
+/* Compare the results. */
+   ok = astOK;
+   nin = 0;
+   for( i = 0; ok && i < NSLOW; i++ ) {
+      if( ( qx[ i ] == AST__BAD ) != ( rx[ i ] == AST__BAD ) ) {
+         printf( "   Results differ for point %d (%g,%g)\n", i, px[ i ], py[ i ] );
+         ok = 0;
+      }
+   }
+   for( i = 0; i < NPOINT; i++ ) {
+      if( qx[ i ] != AST__BAD ) nin++;
+   }
+
+   printf( "   %d vertices, %d points (%d inside): %.4f s (%.3f us per "
+           "point); checking every edge %.3f us per point\n", NVERT, NPOINT,
+           nin, t_grid, 1.0E6*t_grid/NPOINT, 1.0E6*t_slow/NSLOW );
+
+   poly = astAnnul( poly );
+   cpoly = astAnnul( cpoly );
+   frm = astAnnul( frm );
+   cfrm = astAnnul( cfrm );
+   free( vert );
+   free( px );
+   free( py );
+   free( qx );
+   free( qy );
+   free( rx );
+   free( ry );
+   return ok;
+
+/* Undefine local macros. */
+#undef NVERT
+#undef NPOINT
+#undef NSLOW
+}
+
+static int CmpRegionBench( void ) {
+/*
+*  Name:
+*     CmpRegionBench
+
+*  Purpose:
+*     Time the testing of points for inclusion in nested CmpRegions.
+
+*  Description:
+*     This function describes the footprint of a mosaic camera as a
+*     CmpRegion in which a Polygon (the field of view) is ANDed with a
+*     balanced tree of ORed CmpRegions, each leaf of which is a Box (a
+*     single detector). It times the use of astTran2 to determine which
+*     of a set of random points, covering an area four times larger
+*     than the mosaic, are inside the footprint. The results are checked
+*     against those obtained by transforming every point using each
+*     Region individually and combining the results, and the time taken
+*     to do this is also reported.
+
+*  Returned Value:
+*     Non-zero if the results agree, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NCX 8                    /* Number of detectors along X */
+#define NCY 4                    /* Number of detectors along Y */
+#define NVERT 200                /* Number of Polygon vertices */
+#define NPOINT 1000000           /* Number of test points */
+
+/* Local Variables: */
+   AstFrame *frm;                /* The Frame */
+   AstPolygon *poly;             /* The field of view */
+   AstRegion *chip[ NCX*NCY ];   /* Detector Boxes (then CmpRegions) */
+   AstRegion *mosaic;            /* Complete footprint */
+   AstRegion *tmp;               /* Temporary Region */
+   char *inside;                 /* Expected result for each point */
+   double *px;                   /* X values of test points */
+   double *py;                   /* Y values of test points */
+   double *qx;                   /* Transformed X values */
+   double *qy;                   /* Transformed Y values */
+   double lbnd[ 2 ];             /* Lower corner of detector */
+   double ubnd[ 2 ];             /* Upper corner of detector */
+   double vert[ 2*NVERT ];       /* Polygon vertices */
+   double t0;                    /* Start time */
+   double t_cmp;                 /* Time using the CmpRegion */
+   double t_sep;                 /* Time using each Region separately */
+   int i;                        /* Loop counter */
+   int ix;                       /* Detector column */
+   int iy;                       /* Detector row */
+   int n;                        /* Number of Regions at current tree level */
+   int nin;                      /* Number of points inside */
+   int ok;                       /* Results agree? */
+
+/* Allocate memory. */
+   inside = malloc( NPOINT );
+   px = malloc( sizeof( double )*NPOINT );
+   py = malloc( sizeof( double )*NPOINT );
+   qx = malloc( sizeof( double )*NPOINT );
+   qy = malloc( sizeof( double )*NPOINT );
+   if( !inside || !px || !py || !qx || !qy ) {
+      printf( "   Cannot allocate memory.\n" );
+      free( inside );
+      free( px );
+      free( py );
+      free( qx );
+      free( qy );
+      return 0;
+   }
+
+/* Create the detector Boxes. Each detector is 1 unit square, with gaps
+   of 0.05 units between detectors. The mosaic is centred on the origin. */
+   frm = astFrame( 2, " " );
+   for( iy = 0; iy < NCY; iy++ ) {
+      for( ix = 0; ix < NCX; ix++ ) {
+         lbnd[ 0 ] = 1.05*( ix - 0.5*NCX );
+         lbnd[ 1 ] = 1.05*( iy - 0.5*NCY );
+         ubnd[ 0 ] = lbnd[ 0 ] + 1.0;
+         ubnd[ 1 ] = lbnd[ 1 ] + 1.0;
+         chip[ ix + iy*NCX ] = (AstRegion *) astBox( frm, 1, lbnd, ubnd,
+                                                     NULL, " " );
+      }
+   }
+
+/* Create the field of view - an ellipse that clips the corners of the
+   mosaic. */
+   for( i = 0; i < NVERT; i++ ) {
+      vert[ i ] = 0.5*1.05*NCX*cos( 2.0*M_PI*i/NVERT );
+      vert[ i + NVERT ] = 0.6*1.05*NCY*sin( 2.0*M_PI*i/NVERT );
+   }
+   poly = astPolygon( frm, NVERT, NVERT, vert, NULL, " " );
+
+/* Create the test positions. */
+   srand( 2 );
+   for( i = 0; i < NPOINT; i++ ) {
+      px[ i ] = 2.1*NCX*( rand()/(double) RAND_MAX - 0.5 );
+      py[ i ] = 2.1*NCY*( rand()/(double) RAND_MAX - 0.5 );
+   }
+
+/* Find the expected results, using each Region separately. */
+   t0 = Now();
+   astTran2( poly, NPOINT, px, py, 1, qx, qy );
+   for( i = 0; i < NPOINT; i++ ) inside[ i ] = ( qx[ i ] != AST__BAD ) ? 1 : 0;
+   for( ix = 0; ix < NCX*NCY; ix++ ) {
+      astTran2( chip[ ix ], NPOINT, px, py, 1, qx, qy );
+      for( i = 0; i < NPOINT; i++ ) {
+         if( qx[ i ] != AST__BAD ) inside[ i ] |= 2;
+      }
+   }
+   t_sep = Now() - t0;
+
+/* Combine the detectors into a balanced tree of ORed CmpRegions, and
+   then AND the result with the field of view. */
+   for( n = NCX*NCY; n > 1; n = ( n + 1 )/2 ) {
+      for( i = 0; i < n/2; i++ ) {
+         tmp = (AstRegion *) astCmpRegion( chip[ 2*i ], chip[ 2*i + 1 ],
+                                           AST__OR, " " );
+         chip[ 2*i ] = astAnnul( chip[ 2*i ] );
+         chip[ 2*i + 1 ] = astAnnul( chip[ 2*i + 1 ] );
+         chip[ i ] = tmp;
+      }
+      if( n % 2 ) chip[ n/2 ] = chip[ n - 1 ];
+   }
+   mosaic = (AstRegion *) astCmpRegion( poly, chip[ 0 ], AST__AND, " " );
+   chip[ 0 ] = astAnnul( chip[ 0 ] );
+
+/* Time the tests using the CmpRegion. */
+   t0 = Now();
+   astTran2( mosaic, NPOINT, px, py, 1, qx, qy );
+   t_cmp = Now() - t0;
+
+/* Compare the results. */
+   ok = astOK;
+   nin = 0;
+   for( i = 0; ok && i < NPOINT; i++ ) {
+      if( ( qx[ i ] != AST__BAD ) != ( inside[ i ] == 3 ) ) {
+         printf( "   Results differ for point %d (%g,%g)\n", i, px[ i ], py[ i ] );
+         ok = 0;
+      }
+      if( qx[ i ] != AST__BAD ) nin++;
+   }
+
+   printf( "   %d detectors, %d points (%d inside): %.4f s (%.3f us per "
+           "point); each Region separately %.3f us per point\n", NCX*NCY,
+           NPOINT, nin, t_cmp, 1.0E6*t_cmp/NPOINT, 1.0E6*t_sep/NPOINT );
+
+   mosaic = astAnnul( mosaic );
+   poly = astAnnul( poly );
+   frm = astAnnul( frm );
+   free( inside );
+   free( px );
+   free( py );
+   free( qx );
+   free( qy );
+   return ok;
+
+/* Undefine local macros. */
+#undef NCX
+#undef NCY
+#undef NVERT
+#undef NPOINT
+}
+
+static int MaskBench( void ) {
+/*
+*  Name:
+*     MaskBench
+
+*  Purpose:
+*     Time the masking of a large image using a Region.
+
+*  Description:
+*     This function times the use of astMaskI to assign a value to the
+*     pixels of a large image that are inside a flower-shaped Polygon, and
+*     then to the pixels that are outside a Circle. The results are
+*     checked by using astTran2 to test every pixel in a selection of
+*     rows.
+
+*  Returned Value:
+*     Non-zero if the results are correct, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NPIX 4096                /* Number of pixels along each axis */
+#define NVERT 200                /* Number of Polygon vertices */
+#define STEP 97                  /* Interval between checked rows */
+
+/* Local Variables: */
+   AstFrame *frm;                /* Pixel coordinate Frame */
+   AstRegion *reg;               /* Region being used */
+   double *px;                   /* X values of pixels in a row */
+   double *py;                   /* Y values of pixels in a row */
+   double *qx;                   /* Transformed X values */
+   double *qy;                   /* Transformed Y values */
+   double *rx;                   /* Transformed values (not used) */
+   double centre[ 2 ];           /* Circle centre */
+   double radius;                /* Circle radius */
+   double t0;                    /* Start time */
+   double t_circle;              /* Time to mask with the Circle */
+   double t_poly;                /* Time to mask with the Polygon */
+   double vert[ 2*NVERT ];       /* Polygon vertices */
+   int *data;                    /* Image */
+   int i;                        /* Loop counter */
+   int j;                        /* Row index */
+   int lbnd[ 2 ];                /* Lower pixel bounds */
+   int ncircle;                  /* Number of pixels masked by Circle */
+   int npoly;                    /* Number of pixels masked by Polygon */
+   int ok;                       /* Results correct? */
+   int ubnd[ 2 ];                /* Upper pixel bounds */
+
+/* Allocate memory. */
+   data = malloc( sizeof( int )*NPIX*NPIX );
+   px = malloc( sizeof( double )*NPIX );
+   py = malloc( sizeof( double )*NPIX );
+   qx = malloc( sizeof( double )*NPIX );
+   qy = malloc( sizeof( double )*NPIX );
+   rx = malloc( sizeof( double )*NPIX );
+   if( !data || !px || !py || !qx || !qy || !rx ) {
+      printf( "   Cannot allocate memory.\n" );
+      free( data );
+      free( px );
+      free( py );
+      free( qx );
+      free( qy );
+      free( rx );
+      return 0;
+   }
+
+/* Create the Regions' vertices and centre, in pixel coordinates. */
+   frm = astFrame( 2, "Domain=GRID" );
+   for( i = 0; i < NVERT; i++ ) {
+      radius = 0.35*NPIX*( 1.0 + 0.2*sin( 10.0*M_PI*i/NVERT ) );
+      vert[ i ] = 0.5*NPIX + radius*cos( 2.0*M_PI*i/NVERT );
+      vert[ i + NVERT ] = 0.5*NPIX - radius*sin( 2.0*M_PI*i/NVERT );
+   }
+   centre[ 0 ] = 0.45*NPIX;
+   centre[ 1 ] = 0.55*NPIX;
+   radius = 0.4*NPIX;
+   lbnd[ 0 ] = 1;
+   lbnd[ 1 ] = 1;
+   ubnd[ 0 ] = NPIX;
+   ubnd[ 1 ] = NPIX;
+   for( i = 0; i < NPIX*NPIX; i++ ) data[ i ] = 0;
+
+/* Mask the pixels inside the Polygon, and then the pixels outside the
+   Circle. */
+   reg = (AstRegion *) astPolygon( frm, NVERT, NVERT, vert, NULL, " " );
+   t0 = Now();
+   npoly = astMaskI( reg, NULL, 1, 2, lbnd, ubnd, data, 1 );
+   t_poly = Now() - t0;
+   reg = astAnnul( reg );
+
+   reg = (AstRegion *) astCircle( frm, 1, centre, &radius, NULL, " " );
+   for( i = 0; i < NPIX*NPIX; i++ ) data[ i ] *= 2;
+   t0 = Now();
+   ncircle = astMaskI( reg, NULL, 0, 2, lbnd, ubnd, data, 1 );
+   t_circle = Now() - t0;
+   reg = astAnnul( reg );
+
+/* Check a selection of rows. Pixels inside the Polygon and outside the
+   Circle now hold 1, pixels inside the Polygon and the Circle hold 2,
+   pixels outside both hold 1, and other pixels hold 0. */
+   ok = astOK;
+   for( j = 0; ok && j < NPIX; j += STEP ) {
+      for( i = 0; i < NPIX; i++ ) {
+         px[ i ] = i + 1;
+         py[ i ] = j + 1;
+      }
+      reg = (AstRegion *) astPolygon( frm, NVERT, NVERT, vert, NULL, " " );
+      astTran2( reg, NPIX, px, py, 1, qx, rx );
+      reg = astAnnul( reg );
+      reg = (AstRegion *) astCircle( frm, 1, centre, &radius, NULL, " " );
+      astTran2( reg, NPIX, px, py, 1, qy, rx );
+      reg = astAnnul( reg );
+      for( i = 0; ok && i < NPIX; i++ ) {
+         if( data[ i + j*NPIX ] != ( ( qy[ i ] == AST__BAD ) ? 1 :
+                                     ( qx[ i ] != AST__BAD ? 2 : 0 ) ) ) {
+            printf( "   Wrong value at pixel (%d,%d)\n", i + 1, j + 1 );
+            ok = 0;
+         }
+      }
+   }
+
+   printf( "   %dx%d pixels: Polygon %.4f s (%d masked), Circle %.4f s "
+           "(%d masked)\n", NPIX, NPIX, t_poly, npoly, t_circle, ncircle );
+
+   frm = astAnnul( frm );
+   free( data );
+   free( px );
+   free( py );
+   free( qx );
+   free( qy );
+   free( rx );
+   return ok;
+
+/* Undefine local macros. */
+#undef NPIX
+#undef NVERT
+#undef STEP
+}
+
+static int ResamplePlanBench( void ) {
+/*
+*  Name:
+*     ResamplePlanBench
+
+*  Purpose:
+*     Time the resampling of many images using a ResamplePlan.
+
+*  Description:
+*     This function resamples a series of images, all with the same
+*     geometry, through a rotation and a distortion. It is done once
+*     using astResampleF for each image, and once using astApplyPlanF
+*     with a single ResamplePlan. The two sets of results are compared.
+
+*  Returned Value:
+*     Non-zero if the results agree, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NPIX 512                 /* Number of pixels along each axis */
+#define NIMAGE 16                /* Number of images to resample */
+
+/* Local Variables: */
+   AstMapping *map;              /* Mapping from input to output grid */
+   AstResamplePlan *plan;        /* Stored resampling weights */
+   const char *fwd[ 2 ];         /* Forward MathMap expressions */
+   const char *inv[ 2 ];         /* Inverse MathMap expressions */
+   double params[ 2 ];           /* Interpolation kernel parameters */
+   double t0;                    /* Start time */
+   double t_apply;               /* Time to apply the ResamplePlan */
+   double t_plan;                /* Time to create the ResamplePlan */
+   double t_resample;            /* Time to resample every image */
+   float *in;                    /* Input images */
+   float *out1;                  /* Images from astResampleF */
+   float *out2;                  /* Images from astApplyPlanF */
+   int i;                        /* Pixel index */
+   int image;                    /* Image index */
+   int lbnd[ 2 ];                /* Lower pixel bounds */
+   int nbad1;                    /* Bad pixels from astResampleF */
+   int nbad2;                    /* Bad pixels from astApplyPlanF */
+   int ok;                       /* Results agree? */
+   int ubnd[ 2 ];                /* Upper pixel bounds */
+
+/* Allocate memory. */
+   in = malloc( sizeof( float )*NPIX*NPIX*NIMAGE );
+   out1 = malloc( sizeof( float )*NPIX*NPIX*NIMAGE );
+   out2 = malloc( sizeof( float )*NPIX*NPIX*NIMAGE );
+   if( !in || !out1 || !out2 ) {
+      printf( "   Cannot allocate memory.\n" );
+      free( in );
+      free( out1 );
+      free( out2 );
+      return 0;
+   }
+
+/* Create smoothly varying input images. */
+   for( image = 0; image < NIMAGE; image++ ) {
+      for( i = 0; i < NPIX*NPIX; i++ ) {
+         in[ i + image*NPIX*NPIX ] = (float) ( image + sin( 0.01*( i % NPIX ) )*
+                                               cos( 0.02*( i / NPIX ) ) );
+      }
+   }
+
+/* Create a Mapping that rotates the grid about its centre and adds a
+   small radial distortion. */
+   fwd[ 0 ] = "x = 256.5 + 0.8*(xin-256.5) - 0.6*(yin-256.5) + 1.0E-5*(xin-256.5)**2";
+   fwd[ 1 ] = "y = 256.5 + 0.6*(xin-256.5) + 0.8*(yin-256.5)";
+   inv[ 0 ] = "xin";
+   inv[ 1 ] = "yin";
+   map = (AstMapping *) astMathMap( 2, 2, 2, fwd, 2, inv, "SimpFI=1,SimpIF=1" );
+   astInvert( map );
+
+   lbnd[ 0 ] = 1;
+   lbnd[ 1 ] = 1;
+   ubnd[ 0 ] = NPIX;
+   ubnd[ 1 ] = NPIX;
+   params[ 0 ] = 2.0;
+   params[ 1 ] = 2.0;
+
+/* Resample each image separately. */
+   nbad1 = 0;
+   t0 = Now();
+   for( image = 0; image < NIMAGE; image++ ) {
+      nbad1 += astResampleF( map, 2, lbnd, ubnd, in + image*NPIX*NPIX, NULL,
+                             AST__SINCSINC, NULL, params, 0, 0.1, 100,
+                             AST__BAD, 2, lbnd, ubnd, lbnd, ubnd,
+                             out1 + image*NPIX*NPIX, NULL );
+   }
+   t_resample = Now() - t0;
+
+/* Create a ResamplePlan and apply it to each image. */
+   t0 = Now();
+   plan = astResamplePlan( map, 2, lbnd, ubnd, AST__SINCSINC, params, 0.1,
+                           100, 2, lbnd, ubnd, lbnd, ubnd, " " );
+   t_plan = Now() - t0;
+
+   nbad2 = 0;
+   t0 = Now();
+   for( image = 0; image < NIMAGE; image++ ) {
+      nbad2 += astApplyPlanF( plan, in + image*NPIX*NPIX, NULL, 0, AST__BAD,
+                              out2 + image*NPIX*NPIX, NULL );
+   }
+   t_apply = Now() - t0;
+
+/* Compare the results. */
+   ok = astOK && ( nbad1 == nbad2 );
+   for( i = 0; ok && i < NPIX*NPIX*NIMAGE; i++ ) {
+      if( fabs( out1[ i ] - out2[ i ] ) > 1.0E-4*( 1.0 + fabs( out1[ i ] ) ) ) {
+         printf( "   Results differ at element %d (%g != %g)\n", i,
+                 out1[ i ], out2[ i ] );
+         ok = 0;
+      }
+   }
+
+   printf( "   %d images of %dx%d pixels: astResampleF %.4f s, "
+           "astResamplePlan %.4f s + astApplyPlanF %.4f s\n", NIMAGE, NPIX,
+           NPIX, t_resample, t_plan, t_apply );
+
+   plan = astAnnul( plan );
+   map = astAnnul( map );
+   free( in );
+   free( out1 );
+   free( out2 );
+   return ok;
+
+/* Undefine local macros. */
+#undef NPIX
+#undef NIMAGE
+}
+
+static int CubeBench( void ) {
+/*
+*  Name:
+*     CubeBench
+
+*  Purpose:
+*     Time the resampling of a spectral cube.
+
+*  Description:
+*     This function resamples a cube through a rotation and distortion
+*     of the spatial axes and a shift and compression of the spectral
+*     axis. It is done once using a CmpMap that can be split into
+*     separate spatial and spectral Mappings (so that astResampleF can
+*     resample the spatial and spectral axes separately), and once
+*     using an equivalent 3-dimensional MathMap that cannot be split.
+*     The two sets of results are compared.
+
+*  Returned Value:
+*     Non-zero if the results agree, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NPIX 256                 /* Number of pixels along each spatial axis */
+#define NCHAN 64                 /* Number of input spectral channels */
+
+/* Local Variables: */
+   AstMapping *map1;             /* Separable Mapping */
+   AstMapping *map2;             /* Equivalent non-separable Mapping */
+   AstMapping *spatial;          /* Spatial Mapping */
+   AstMapping *spectral;         /* Spectral Mapping */
+   const char *fwd[ 3 ];         /* Forward MathMap expressions */
+   const char *inv[ 3 ];         /* Inverse MathMap expressions */
+   double ina[ 1 ];              /* Spectral WinMap input bounds */
+   double inb[ 1 ];
+   double outa[ 1 ];             /* Spectral WinMap output bounds */
+   double outb[ 1 ];
+   double params[ 2 ];           /* Interpolation kernel parameters */
+   double t0;                    /* Start time */
+   double t_full;                /* Time using the non-separable Mapping */
+   double t_separable;           /* Time using the separable Mapping */
+   float *in;                    /* Input cube */
+   float *out1;                  /* Cube from separable Mapping */
+   float *out2;                  /* Cube from non-separable Mapping */
+   int i;                        /* Pixel index */
+   int lbnd[ 3 ];                /* Lower pixel bounds */
+   int nbad1;                    /* Bad pixels from separable Mapping */
+   int nbad2;                    /* Bad pixels from non-separable Mapping */
+   int nout;                     /* Number of output pixels */
+   int ok;                       /* Results agree? */
+   int ubnd_in[ 3 ];             /* Upper input pixel bounds */
+   int ubnd_out[ 3 ];            /* Upper output pixel bounds */
+
+/* Allocate memory. The output cube has half as many channels as the
+   input cube. */
+   nout = NPIX*NPIX*NCHAN/2;
+   in = malloc( sizeof( float )*NPIX*NPIX*NCHAN );
+   out1 = malloc( sizeof( float )*nout );
+   out2 = malloc( sizeof( float )*nout );
+   if( !in || !out1 || !out2 ) {
+      printf( "   Cannot allocate memory.\n" );
+      free( in );
+      free( out1 );
+      free( out2 );
+      return 0;
+   }
+
+/* Create a smoothly varying input cube. */
+   for( i = 0; i < NPIX*NPIX*NCHAN; i++ ) {
+      in[ i ] = (float) ( sin( 0.01*( i % NPIX ) )*
+                          cos( 0.02*( ( i / NPIX ) % NPIX ) ) +
+                          exp( -0.01*( i/( NPIX*NPIX ) - 30 )*
+                                     ( i/( NPIX*NPIX ) - 30 ) ) );
+   }
+
+/* Create a separable Mapping that rotates the spatial axes about the
+   centre of the grid and adds a small radial distortion, and that
+   compresses the spectral axis by a factor of two. */
+   fwd[ 0 ] = "x = 128.5 + 0.8*(xin-128.5) - 0.6*(yin-128.5) + 1.0E-5*(xin-128.5)**2";
+   fwd[ 1 ] = "y = 128.5 + 0.6*(xin-128.5) + 0.8*(yin-128.5)";
+   inv[ 0 ] = "xin";
+   inv[ 1 ] = "yin";
+   spatial = (AstMapping *) astMathMap( 2, 2, 2, fwd, 2, inv,
+                                        "SimpFI=1,SimpIF=1" );
+   astInvert( spatial );
+   ina[ 0 ] = 0.5;
+   inb[ 0 ] = NCHAN + 0.5;
+   outa[ 0 ] = 0.5;
+   outb[ 0 ] = NCHAN/2 + 0.5;
+   spectral = (AstMapping *) astWinMap( 1, ina, inb, outa, outb, " " );
+   map1 = (AstMapping *) astCmpMap( spatial, spectral, 0, " " );
+
+/* Create an equivalent Mapping that cannot be split. */
+   fwd[ 2 ] = "z = 2*zin - 0.5";
+   inv[ 2 ] = "zin";
+   map2 = (AstMapping *) astMathMap( 3, 3, 3, fwd, 3, inv,
+                                     "SimpFI=1,SimpIF=1" );
+   astInvert( map2 );
+
+   lbnd[ 0 ] = 1;
+   lbnd[ 1 ] = 1;
+   lbnd[ 2 ] = 1;
+   ubnd_in[ 0 ] = NPIX;
+   ubnd_in[ 1 ] = NPIX;
+   ubnd_in[ 2 ] = NCHAN;
+   ubnd_out[ 0 ] = NPIX;
+   ubnd_out[ 1 ] = NPIX;
+   ubnd_out[ 2 ] = NCHAN/2;
+   params[ 0 ] = 2.0;
+   params[ 1 ] = 2.0;
+
+/* Resample the cube using each Mapping. No linear approximation is
+   used, so that both Mappings give the same input positions. */
+   t0 = Now();
+   nbad1 = astResampleF( map1, 3, lbnd, ubnd_in, in, NULL, AST__SINCSINC,
+                         NULL, params, 0, 0.0, 100, AST__BAD, 3, lbnd,
+                         ubnd_out, lbnd, ubnd_out, out1, NULL );
+   t_separable = Now() - t0;
+
+   t0 = Now();
+   nbad2 = astResampleF( map2, 3, lbnd, ubnd_in, in, NULL, AST__SINCSINC,
+                         NULL, params, 0, 0.0, 100, AST__BAD, 3, lbnd,
+                         ubnd_out, lbnd, ubnd_out, out2, NULL );
+   t_full = Now() - t0;
+
+/* Compare the results. */
+   ok = astOK && ( nbad1 == nbad2 );
+   for( i = 0; ok && i < nout; i++ ) {
+      if( fabs( out1[ i ] - out2[ i ] ) > 1.0E-4*( 1.0 + fabs( out2[ i ] ) ) ) {
+         printf( "   Results differ at element %d (%g != %g)\n", i,
+                 out1[ i ], out2[ i ] );
+         ok = 0;
+      }
+   }
+
+   printf( "   %dx%dx%d pixels: separable Mapping %.4f s, "
+           "non-separable Mapping %.4f s\n", NPIX, NPIX, NCHAN/2,
+           t_separable, t_full );
+
+   map1 = astAnnul( map1 );
+   map2 = astAnnul( map2 );
+   spatial = astAnnul( spatial );
+   spectral = astAnnul( spectral );
+   free( in );
+   free( out1 );
+   free( out2 );
+   return ok;
+
+/* Undefine local macros. */
+#undef NPIX
+#undef NCHAN
+}
+
+static int KernelBench( void ) {
+/*
+*  Name:
+*     KernelBench
+
+*  Purpose:
+*     Time resampling and rebinning with a 1-dimensional kernel.
+
+*  Description:
+*     This function resamples and rebins an image through a rotation
+*     using the AST__SINCSINC kernel. It is done once with the kernel
+*     values obtained from a pre-computed table (the default), and once
+*     with the KernelTable tuning parameter set to zero so that the
+*     kernel function is evaluated directly. The two sets of results are
+*     compared.
+
+*  Returned Value:
+*     Non-zero if the results agree, zero otherwise.
+*/
+
+/* Local Constants: */
+#define NPIX 1024                /* Number of pixels along each axis */
+
+/* Local Variables: */
+   AstMapping *map;              /* Rotation Mapping */
+   AstMapping *tmap;             /* Component Mapping */
+   double *in;                   /* Input image */
+   double *out[ 2 ][ 2 ];        /* Resampled and rebinned images */
+   double matrix[ 4 ];           /* Rotation matrix */
+   double params[ 2 ];           /* Interpolation kernel parameters */
+   double shift[ 2 ];            /* Shift to or from the image centre */
+   double t0;                    /* Start time */
+   double t_resample[ 2 ];       /* Times taken by astResampleD */
+   double t_rebin[ 2 ];          /* Times taken by astRebinD */
+   int digits;                   /* Original KernelTable value */
+   int i;                        /* Pixel index */
+   int j;                        /* Result index */
+   int lbnd[ 2 ];                /* Lower pixel bounds */
+   int nbad[ 2 ];                /* Bad pixels from astResampleD */
+   int ok;                       /* Results agree? */
+   int pass;                     /* Tabulated (0) or direct (1) kernels */
+   int ubnd[ 2 ];                /* Upper pixel bounds */
+
+/* Allocate memory. */
+   in = malloc( sizeof( double )*NPIX*NPIX );
+   ok = ( in != NULL );
+   for( pass = 0; pass < 2; pass++ ) {
+      for( j = 0; j < 2; j++ ) {
+         out[ pass ][ j ] = malloc( sizeof( double )*NPIX*NPIX );
+         if( !out[ pass ][ j ] ) ok = 0;
+      }
+   }
+   if( !ok ) {
+      printf( "   Cannot allocate memory.\n" );
+      free( in );
+      for( pass = 0; pass < 2; pass++ ) {
+         for( j = 0; j < 2; j++ ) free( out[ pass ][ j ] );
+      }
+      return 0;
+   }
+
+/* Create a smoothly varying input image. */
+   for( i = 0; i < NPIX*NPIX; i++ ) {
+      in[ i ] = sin( 0.01*( i % NPIX ) )*cos( 0.02*( i / NPIX ) );
+   }
+
+/* Create a Mapping that rotates the image about its centre. */
+   matrix[ 0 ] = 0.8;
+   matrix[ 1 ] = -0.6;
+   matrix[ 2 ] = 0.6;
+   matrix[ 3 ] = 0.8;
+   shift[ 0 ] = -0.5*( NPIX + 1 );
+   shift[ 1 ] = -0.5*( NPIX + 1 );
+   map = (AstMapping *) astShiftMap( 2, shift, " " );
+   tmap = (AstMapping *) astMatrixMap( 2, 2, 0, matrix, " " );
+   map = (AstMapping *) astCmpMap( map, tmap, 1, " " );
+   shift[ 0 ] = -shift[ 0 ];
+   shift[ 1 ] = -shift[ 1 ];
+   tmap = (AstMapping *) astShiftMap( 2, shift, " " );
+   map = (AstMapping *) astCmpMap( map, tmap, 1, " " );
+
+   lbnd[ 0 ] = 1;
+   lbnd[ 1 ] = 1;
+   ubnd[ 0 ] = NPIX;
+   ubnd[ 1 ] = NPIX;
+   params[ 0 ] = 3.0;
+   params[ 1 ] = 3.0;
+
+/* Resample and rebin the image, first using tabulated kernels and then
+   evaluating the kernel directly. */
+   digits = astTune( "KernelTable", AST__TUNULL );
+   for( pass = 0; pass < 2; pass++ ) {
+      if( pass == 1 ) astTune( "KernelTable", 0 );
+
+      t0 = Now();
+      nbad[ pass ] = astResampleD( map, 2, lbnd, ubnd, in, NULL,
+                                   AST__SINCSINC, NULL, params, 0, 0.1, 100,
+                                   AST__BAD, 2, lbnd, ubnd, lbnd, ubnd,
+                                   out[ pass ][ 0 ], NULL );
+      t_resample[ pass ] = Now() - t0;
+
+      t0 = Now();
+      astRebinD( map, 0.0, 2, lbnd, ubnd, in, NULL, AST__SINCSINC, params,
+                 0, 0.1, 100, AST__BAD, 2, lbnd, ubnd, lbnd, ubnd,
+                 out[ pass ][ 1 ], NULL );
+      t_rebin[ pass ] = Now() - t0;
+   }
+   astTune( "KernelTable", digits );
+
+/* Compare the results. */
+   ok = astOK && ( nbad[ 0 ] == nbad[ 1 ] );
+   for( j = 0; ok && j < 2; j++ ) {
+      for( i = 0; ok && i < NPIX*NPIX; i++ ) {
+         if( ( out[ 0 ][ j ][ i ] == AST__BAD ) !=
+             ( out[ 1 ][ j ][ i ] == AST__BAD ) ||
+             ( out[ 1 ][ j ][ i ] != AST__BAD &&
+               fabs( out[ 0 ][ j ][ i ] - out[ 1 ][ j ][ i ] ) > 1.0E-5 ) ) {
+            printf( "   Results differ at element %d (%g != %g)\n", i,
+                    out[ 0 ][ j ][ i ], out[ 1 ][ j ][ i ] );
+            ok = 0;
+         }
+      }
+   }
+
+   printf( "   %dx%d pixels: astResampleD %.4f s (tabulated) %.4f s (direct)\n",
+           NPIX, NPIX, t_resample[ 0 ], t_resample[ 1 ] );
+   printf( "   %dx%d pixels: astRebinD %.4f s (tabulated) %.4f s (direct)\n",
+           NPIX, NPIX, t_rebin[ 0 ], t_rebin[ 1 ] );
+
+   map = astAnnul( map );
+   free( in );
+   for( pass = 0; pass < 2; pass++ ) {
+      for( j = 0; j < 2; j++ ) free( out[ pass ][ j ] );
+   }
+   return ok;
+
+/* Undefine local macros. */
+#undef NPIX
+}
+
+static int KeyMapReadBench( void ) {
+/*
+*  Name:
+*     KeyMapReadBench
+
+*  Purpose:
+*     Time concurrent look-ups in a KeyMap from several threads.
+
+*  Description:
+*     This function creates a KeyMap holding many scalar double values,
+*     and then starts 1, 2, 4 and 8 threads in turn. Each thread looks up
+*     values for randomly chosen keys. This is done in two ways: first
+*     with each thread locking the KeyMap for each look-up using astLock
+*     (waiting until any other thread has unlocked it) and astUnlock, and
+*     then with each thread using astMapShareGet0D to
+*     read the snapshot published by astMapShare without locking the
+*     KeyMap. While the lock-free readers run, the main thread modifies
+*     every value in the KeyMap and publishes a new snapshot several
+*     times. Each stored value identifies both its key and the update
+*     that wrote it, so each reader can check that every value read is
+*     one that was published for the key. The elapsed time per look-up
+*     and the speed-up relative to one thread are reported for each
+*     method.
+
+*  Returned Value:
+*     Non-zero if all look-ups returned valid values, zero otherwise.
+
+*  Notes:
+*     - This benchmark does nothing if AST was built without POSIX
+*     thread support.
+*/
+
+#if AST__THREADSAFE
+
+/* Local Constants: */
+#define MXTHREAD 8               /* Largest number of threads */
+#define NKEY 10000               /* Number of keys in the KeyMap */
+#define NLOOKUP 200000           /* Number of look-ups per thread */
+#define NPUBLISH 20              /* Number of updates published per run */
+
+/* Local Variables: */
+   AstKeyMap *keymap;            /* KeyMap to be read */
+   AstKeyMapShare *share;        /* Published snapshot of the KeyMap */
+   KeyMapReadData data[ MXTHREAD ]; /* Data for each thread */
+   char key[ 20 ];               /* Key string */
+   double rate1;                 /* Look-ups per second using 1 thread */
+   double rate;                  /* Look-ups per second */
+   double t0;                    /* Start time */
+   double t;                     /* Elapsed time */
+   int gen;                      /* Number of updates published */
+   int i;                        /* Key index */
+   int ipub;                     /* Loop counter for updates */
+   int ithread;                  /* Loop counter for threads */
+   int nthread;                  /* Number of threads */
+   int ok;                       /* All threads succeeded? */
+   int shared;                   /* Use the published snapshot? */
+   pthread_t threads[ MXTHREAD ];/* Thread identifiers */
+
+/* Create the KeyMap. The value stored for the key with index "i" after
+   "gen" updates have been made is "i + gen*NKEY". */
+   gen = 0;
+   keymap = astKeyMap( " " );
+   for( i = 0; i < NKEY; i++ ) {
+      sprintf( key, "KEY%d", i );
+      astMapPut0D( keymap, key, (double) i, NULL );
+   }
+   if( !astOK ) return 0;
+
+   ok = 1;
+   for( shared = 0; ok && shared < 2; shared++ ) {
+      printf( shared ? "   Reading a published snapshot while updating:\n" :
+                       "   Locking the KeyMap for each look-up:\n" );
+
+/* Publish the initial snapshot, or unlock the KeyMap so that the reader
+   threads can lock it. */
+      share = NULL;
+      if( shared ) {
+         share = astMapShare( keymap );
+      } else {
+         astUnlock( keymap, 1 );
+      }
+
+      rate1 = 0.0;
+      for( nthread = 1; ok && nthread <= MXTHREAD; nthread *= 2 ) {
+
+/* Start the threads. Each performs the same number of look-ups. */
+         t0 = Now();
+         for( ithread = 0; ithread < nthread; ithread++ ) {
+            data[ ithread ].keymap = keymap;
+            data[ ithread ].share = share;
+            data[ ithread ].nkey = NKEY;
+            data[ ithread ].nlookup = NLOOKUP;
+            data[ ithread ].seed = 12345U + 1000U*(unsigned int) ithread;
+            data[ ithread ].shared = shared;
+            data[ ithread ].fails = 0;
+            if( pthread_create( threads + ithread, NULL, KeyMapReadWorker,
+                                data + ithread ) ) {
+               printf( "   Cannot start thread %d.\n", ithread );
+               nthread = ithread;
+               ok = 0;
+            }
+         }
+
+/* While the lock-free readers run, update every value and publish the
+   modified KeyMap. */
+         if( shared ) {
+            for( ipub = 0; ipub < NPUBLISH; ipub++ ) {
+               gen++;
+               for( i = 0; i < NKEY; i++ ) {
+                  sprintf( key, "KEY%d", i );
+                  astMapPut0D( keymap, key, (double) i + gen*(double) NKEY,
+                               NULL );
+               }
+               (void) astMapShare( keymap );
+            }
+         }
+
+/* Wait for the threads to finish. */
+         for( ithread = 0; ithread < nthread; ithread++ ) {
+            pthread_join( threads[ ithread ], NULL );
+            if( data[ ithread ].fails ) {
+               printf( "   Thread %d failed %d times.\n", ithread,
+                       data[ ithread ].fails );
+               ok = 0;
+            }
+         }
+         t = Now() - t0;
+
+/* Report the rate at which look-ups were performed, in total. */
+         if( ok ) {
+            rate = ( nthread * (double) NLOOKUP ) / t;
+            if( nthread == 1 ) rate1 = rate;
+            printf( "   %d thread(s): %.4f s, %.3f us per look-up, "
+                    "speed-up %.2f\n", nthread, t, 1.0E6 / rate,
+                    rate / rate1 );
+         }
+      }
+
+/* Regain the lock on the KeyMap. */
+      if( !shared ) astLock( keymap, 0 );
+   }
+
+   keymap = astAnnul( keymap );
+   return ok && astOK;
+
+/* Undefine local macros. */
+#undef MXTHREAD
+#undef NKEY
+#undef NLOOKUP
+#undef NPUBLISH
+
+#else
+   printf( "   AST was built without POSIX thread support.\n" );
+   return 1;
+#endif
+}
+
+#if AST__THREADSAFE
+static void *KeyMapReadWorker( void *data ) {
+/*
+*  Name:
+*     KeyMapReadWorker
+
+*  Purpose:
+*     Look up values in a KeyMap repeatedly within a single thread.
+
+*  Description:
+*     This function is run in a separate thread by KeyMapReadBench. Each
+*     iteration chooses a key at random and gets its value, either by
+*     locking the KeyMap (waiting for any other thread to unlock it) and
+*     using astMapGet0D, or by using astMapShareGet0D. The value is checked against the key index.
+
+*  Parameters:
+*     data
+*        Pointer to the KeyMapReadData structure for the thread. On exit,
+*        its "fails" component holds the number of look-ups that failed.
+
+*  Returned Value:
+*     NULL.
+*/
+
+/* Local Variables: */
+   KeyMapReadData *rdata;        /* Pointer to thread data */
+   char key[ 20 ];               /* Key string */
+   double value;                 /* Value read from the KeyMap */
+   int found;                    /* Was the key found? */
+   int i;                        /* Key index */
+   int iter;                     /* Loop counter for look-ups */
+   unsigned int seed;            /* Random number generator state */
+
+   rdata = (KeyMapReadData *) data;
+   seed = rdata->seed;
+
+   for( iter = 0; iter < rdata->nlookup; iter++ ) {
+      seed = seed*1103515245U + 12345U;
+      i = (int) ( ( seed >> 8 ) % (unsigned int) rdata->nkey );
+      sprintf( key, "KEY%d", i );
+
+      value = -1.0;
+      if( rdata->shared ) {
+         found = astMapShareGet0D( rdata->share, key, &value );
+      } else {
+         astLock( rdata->keymap, 1 );
+         found = astMapGet0D( rdata->keymap, key, &value );
+         astUnlock( rdata->keymap, 1 );
+      }
+
+/* The value should be "i" plus a whole number of multiples of the
+   number of keys. */
+      if( !astOK || !found || value < i ||
+          fmod( value - i, (double) rdata->nkey ) != 0.0 ) {
+         rdata->fails++;
+         astClearStatus;
+      }
+   }
+
+   return NULL;
+}
+#endif
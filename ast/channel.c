@@ -6327,9 +6327,13 @@ void astPutNextText_( AstChannel *this, const char *line, int *status ) {
    (**astMEMBER(this,Channel,PutNextText))( this, line, status );
 }
 AstObject *astRead_( AstChannel *this, int *status ) {
+   AstObject *result;
    if ( !astOK ) return NULL;
    astAddWarning( this, 0, NULL, NULL, status );
-   return (**astMEMBER(this,Channel,Read))( this, status );
+   astBeginTempMem;
+   result = (**astMEMBER(this,Channel,Read))( this, status );
+   astEndTempMem;
+   return result;
 }
 void astReadClassData_( AstChannel *this, const char *class, int *status ) {
    if ( !astOK ) return;
@@ -152,6 +152,15 @@ f     The CmpMap class does not define any new routines beyond those
 *     23-APR-2015 (DSB):
 *        In Simplify, prevent mappings that are known to cause infinite
 *        loops from being nominated for simplification.
+*     16-OCT-2026 (DSB):
+*        In Transform, use scratch PointSets (see astScratchPointSet)
+*        for temporary and intermediate results, so that transforming
+*        small numbers of points does not require any memory allocation.
+*     16-OCT-2026 (DSB):
+*        Series CmpMaps are now compiled into a pipeline when first
+*        used to transform points. Adjacent linear components are merged
+*        and the points are passed through all components in blocks (see
+*        the CmpMapBlock tuning parameter).
 *class--
 */
 
@@ -175,6 +184,9 @@ f     The CmpMap class does not define any new routines beyond those
 #include "channel.h"             /* I/O channels */
 #include "permmap.h"             /* Coordinate permutation Mappings */
 #include "unitmap.h"             /* Unit transformations */
+#include "matrixmap.h"           /* Matrix transformations */
+#include "winmap.h"              /* Window transformations */
+#include "shiftmap.h"            /* Shift transformations */
 #include "cmpmap.h"              /* Interface definition for this class */
 #include "frameset.h"            /* Interface definition for FrameSets */
 #include "globals.h"             /* Thread-safe global data access */
@@ -190,6 +202,38 @@ f     The CmpMap class does not define any new routines beyond those
 #include <string.h>
 #include <stdio.h>
 
+/* Module Macros. */
+/* ============== */
+/* The value by which each input axis is displaced when probing a
+   sequence of linear Mappings to find the matrix elements of the
+   equivalent single linear transformation. This is a power of two so
+   that no precision is lost when dividing by it, and is large so that
+   the difference between the displaced and undisplaced outputs is not
+   dominated by rounding in any offset terms. */
+#define PROBE 1099511627776.0
+
+/* Type Definitions. */
+/* ================= */
+/* A single stage within a compiled pipeline. Each stage either applies a
+   component Mapping or applies a linear transformation formed by merging
+   two or more adjacent linear component Mappings. */
+typedef struct PipeStage {
+   AstMapping *map;              /* Component Mapping (NULL if merged) */
+   int invert;                   /* Invert value required for "map" */
+   int nin;                      /* No. of input coordinates */
+   int nout;                     /* No. of output coordinates */
+   double *matrix;               /* Merged matrix (nout rows of nin values) */
+   double *offset;               /* Merged offset for each output */
+} PipeStage;
+
+/* A compiled pipeline, describing the stages needed to apply a series
+   CmpMap in one direction. */
+typedef struct AstCmpMapPipeline {
+   int nstage;                   /* Number of stages */
+   int maxcoord;                 /* Largest no. of coordinates at any stage */
+   PipeStage *stage;             /* Array of stages */
+} AstCmpMapPipeline;
+
 /* Module Variables. */
 /* ================= */
 
@@ -225,6 +269,10 @@ astMAKE_INITGLOBALS(CmpMap)
 #define simplify_depth astGLOBAL(CmpMap,Simplify_Depth)
 #define simplify_stackmaps astGLOBAL(CmpMap,Simplify_Stackmaps)
 
+static pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_MUTEX1 pthread_mutex_lock( &mutex1 );
+#define UNLOCK_MUTEX1 pthread_mutex_unlock( &mutex1 );
+
 
 
 /* If thread safety is not needed, declare and initialise globals at static
@@ -240,8 +288,17 @@ static AstMapping **simplify_stackmaps = NULL;
 static AstCmpMapVtab class_vtab;   /* Virtual function table */
 static int class_init = 0;       /* Virtual function table initialised? */
 
+#define LOCK_MUTEX1
+#define UNLOCK_MUTEX1
+
 #endif
 
+/* The number of points passed through all the component Mappings of a
+   series CmpMap together (see the "CmpMapBlock" tuning parameter). Zero
+   causes each component Mapping to be applied separately to all points.
+   Access is protected by mutex1. */
+static int cmpmap_block = 512;
+
 /* External Interface Function Prototypes. */
 /* ======================================= */
 /* The following functions have public prototypes only (i.e. no
@@ -251,7 +308,13 @@ AstCmpMap *astCmpMapId_( void *, void *, int, const char *, ... );
 
 /* Prototypes for Private Member Functions. */
 /* ======================================== */
+static AstCmpMapPipeline *CompilePipeline( AstCmpMap *, int, int * );
+static AstCmpMapPipeline *FreePipeline( AstCmpMapPipeline *, int * );
 static AstMapping *CombineMaps( AstMapping *, int, AstMapping *, int, int, int * );
+static int PipelineSize( AstCmpMapPipeline *, int * );
+static void ApplyMerged( PipeStage *, int, double **, double **, int * );
+static void MergeLinear( AstMapping **, int *, int, PipeStage *, int * );
+static void RunPipeline( AstCmpMapPipeline *, AstPointSet *, AstPointSet *, int, int * );
 static AstMapping *RemoveRegions( AstMapping *, int * );
 static AstMapping *Simplify( AstMapping *, int * );
 static AstPointSet *Transform( AstMapping *, AstPointSet *, int, AstPointSet *, int * );
@@ -506,6 +569,8 @@ static int GetObjSize( AstObject *this_object, int *status ) {
 
    result += astGetObjSize( this->map1 );
    result += astGetObjSize( this->map2 );
+   result += PipelineSize( this->pipe[ 0 ], status );
+   result += PipelineSize( this->pipe[ 1 ], status );
 
 /* If an error occurred, clear the result value. */
    if ( !astOK ) result = 0;
@@ -780,6 +845,62 @@ static void Decompose( AstMapping *this_mapping, AstMapping **map1,
    }
 }
 
+int astCmpMapBlock_( int newval, int *status ){
+/*
+*+
+*  Name:
+*     astCmpMapBlock
+
+*  Purpose:
+*     Get or set the CmpMapBlock tuning parameter.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "cmpmap.h"
+*     int astCmpMapBlock( int newval )
+
+*  Class Membership:
+*     CmpMap member function.
+
+*  Description:
+*     This function returns the current value of the CmpMapBlock tuning
+*     parameter (see astTune), optionally storing a new value. This is
+*     the number of points that are passed through all the component
+*     Mappings of a series CmpMap together, using a compiled pipeline in
+*     which adjacent linear components are merged. A value of zero causes
+*     each component Mapping to be applied in turn to all points.
+*
+*     All threads share the same value.
+
+*  Parameters:
+*     newval
+*        The new value for the CmpMapBlock tuning parameter. If AST__TUNULL
+*        is supplied, the current value is left unchanged. Negative values
+*        are treated as zero.
+
+*  Returned Value:
+*     astCmpMapBlock()
+*        The original value of the CmpMapBlock tuning parameter.
+
+*  Notes:
+*     - This function attempts to execute even if the AST error status
+*     is set on entry.
+*-
+*/
+
+/* Local Variables: */
+   int result;
+
+   LOCK_MUTEX1
+   result = cmpmap_block;
+   if( newval != AST__TUNULL ) cmpmap_block = ( newval > 0 ) ? newval : 0;
+   UNLOCK_MUTEX1
+
+   return result;
+}
+
 void astInitCmpMapVtab_(  AstCmpMapVtab *vtab, const char *name, int *status ) {
 /*
 *+
@@ -3639,6 +3760,619 @@ static AstMapping *Simplify( AstMapping *this_mapping, int *status ) {
    return result;
 }
 
+static void ApplyMerged( PipeStage *stage, int npoint, double **ptr_in,
+                         double **ptr_out, int *status ) {
+/*
+*  Name:
+*     ApplyMerged
+
+*  Purpose:
+*     Apply a merged linear stage of a compiled pipeline.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "cmpmap.h"
+*     void ApplyMerged( PipeStage *stage, int npoint, double **ptr_in,
+*                       double **ptr_out, int *status )
+
+*  Class Membership:
+*     CmpMap member function.
+
+*  Description:
+*     This function applies the linear transformation described by the
+*     matrix and offsets stored in a merged pipeline stage to a set of
+*     points. Bad values are propagated in the same way as by a
+*     MatrixMap: a bad input value results in a bad output value unless
+*     the corresponding matrix element is zero, and a bad matrix element
+*     or offset results in a bad output value.
+
+*  Parameters:
+*     stage
+*        Pointer to the pipeline stage.
+*     npoint
+*        The number of points to transform.
+*     ptr_in
+*        Array of pointers to the input values for each coordinate.
+*     ptr_out
+*        Array of pointers to the output values for each coordinate.
+*        These must not refer to the same memory as the input values.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   const double *row;            /* Pointer to current matrix row */
+   const double *x;              /* Pointer to input values */
+   double *y;                    /* Pointer to output values */
+   double c;                     /* Offset for current output */
+   double m;                     /* Current matrix element */
+   int bad;                      /* Are all outputs bad? */
+   int in_coord;                 /* Loop counter for inputs */
+   int out_coord;                /* Loop counter for outputs */
+   int point;                    /* Loop counter for points */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Loop round each output coordinate. */
+   for ( out_coord = 0; out_coord < stage->nout; out_coord++ ) {
+      y = ptr_out[ out_coord ];
+      row = stage->matrix + out_coord * stage->nin;
+      c = stage->offset[ out_coord ];
+      bad = ( c == AST__BAD );
+
+/* Sum the products of the input values with the matrix elements in the
+   current row, skipping zero elements so that bad input values on
+   independent axes are ignored. */
+      for ( point = 0; point < npoint; point++ ) y[ point ] = 0.0;
+      for ( in_coord = 0; in_coord < stage->nin && !bad; in_coord++ ) {
+         m = row[ in_coord ];
+         if ( m == AST__BAD ) {
+            bad = 1;
+
+         } else if ( m != 0.0 ) {
+            x = ptr_in[ in_coord ];
+            for ( point = 0; point < npoint; point++ ) {
+               if ( y[ point ] != AST__BAD ) {
+                  if ( x[ point ] == AST__BAD ) {
+                     y[ point ] = AST__BAD;
+                  } else {
+                     y[ point ] += m * x[ point ];
+                  }
+               }
+            }
+         }
+      }
+
+/* Add on the offset, or set all values bad if required. */
+      if ( bad ) {
+         for ( point = 0; point < npoint; point++ ) y[ point ] = AST__BAD;
+      } else {
+         for ( point = 0; point < npoint; point++ ) {
+            if ( y[ point ] != AST__BAD ) y[ point ] += c;
+         }
+      }
+   }
+}
+
+static AstCmpMapPipeline *CompilePipeline( AstCmpMap *this, int forward,
+                                           int *status ) {
+/*
+*  Name:
+*     CompilePipeline
+
+*  Purpose:
+*     Compile a series CmpMap into a pipeline.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "cmpmap.h"
+*     AstCmpMapPipeline *CompilePipeline( AstCmpMap *this, int forward,
+*                                         int *status )
+
+*  Class Membership:
+*     CmpMap member function.
+
+*  Description:
+*     This function decomposes a series CmpMap into the sequence of
+*     simpler Mappings that must be applied to transform points in the
+*     requested direction (using astMapList), and returns a pipeline
+*     describing these Mappings. Each run of two or more adjacent linear
+*     Mappings (MatrixMaps, WinMaps, ShiftMaps and UnitMaps) is
+*     replaced in the pipeline by a single stage that applies the
+*     equivalent matrix and offset vector. Other Mappings form stages
+*     of their own.
+*
+*     Only classes whose transformations cannot be changed after
+*     construction (other than by changing their Invert attribute) are
+*     merged, so that the pipeline remains valid for the life of the
+*     CmpMap. For instance, ZoomMaps are not merged since their Zoom
+*     attribute may be changed.
+
+*  Parameters:
+*     this
+*        Pointer to the CmpMap, which must combine its components in
+*        series.
+*     forward
+*        Non-zero if the pipeline is to apply the forward transformation
+*        of the CmpMap (ignoring its Invert attribute), and zero for the
+*        inverse transformation.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the new pipeline, which should be freed using
+*     FreePipeline when no longer needed.
+
+*  Notes:
+*     - The component CmpMaps are decomposed, rather than the supplied
+*     CmpMap itself, so that a CmpMap that cannot be decomposed because
+*     it has a set Ident value is still split into its two components.
+*     - A NULL pointer is returned if an error occurs.
+*/
+
+/* Local Variables: */
+   AstCmpMapPipeline *result;    /* Returned pipeline */
+   AstMapping **map_list;        /* Decomposed Mappings */
+   PipeStage *stage;             /* Current stage */
+   int *invert_list;             /* Invert values for decomposed Mappings */
+   int imap;                     /* Index of first Mapping in stage */
+   int jmap;                     /* Index of Mapping following stage */
+   int nmap;                     /* Number of decomposed Mappings */
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Decompose the two component Mappings into a list of Mappings to be
+   applied in series. If the inverse transformation is required, the
+   second Mapping is applied first, inverted. */
+   nmap = 0;
+   map_list = NULL;
+   invert_list = NULL;
+   if ( forward ) {
+      (void) astMapList( this->map1, 1, this->invert1, &nmap, &map_list,
+                         &invert_list );
+      (void) astMapList( this->map2, 1, this->invert2, &nmap, &map_list,
+                         &invert_list );
+   } else {
+      (void) astMapList( this->map2, 1, !this->invert2, &nmap, &map_list,
+                         &invert_list );
+      (void) astMapList( this->map1, 1, !this->invert1, &nmap, &map_list,
+                         &invert_list );
+   }
+
+/* Allocate the pipeline, with room for one stage for each Mapping. */
+   result = astMalloc( sizeof( AstCmpMapPipeline ) );
+   if ( result ) {
+      result->nstage = 0;
+      result->maxcoord = 0;
+      result->stage = astMalloc( sizeof( PipeStage ) * (size_t) nmap );
+   }
+
+/* Loop round the Mappings, forming a stage from each run of adjacent
+   mergeable linear Mappings, and from each other Mapping. */
+   imap = 0;
+   while ( astOK && imap < nmap ) {
+      stage = result->stage + result->nstage++;
+      stage->map = NULL;
+      stage->matrix = NULL;
+      stage->offset = NULL;
+
+      for ( jmap = imap; jmap < nmap; jmap++ ) {
+         if ( !astIsAMatrixMap( map_list[ jmap ] ) &&
+              !astIsAWinMap( map_list[ jmap ] ) &&
+              !astIsAShiftMap( map_list[ jmap ] ) &&
+              !astIsAUnitMap( map_list[ jmap ] ) ) break;
+      }
+
+/* Merge runs of two or more linear Mappings. */
+      if ( jmap - imap > 1 ) {
+         MergeLinear( map_list + imap, invert_list + imap, jmap - imap,
+                      stage, status );
+         imap = jmap;
+
+/* Otherwise, the stage applies a single Mapping, taking ownership of the
+   Mapping pointer. Note the numbers of input and output coordinates
+   when the required Invert value is used. */
+      } else {
+         stage->map = map_list[ imap ];
+         stage->invert = invert_list[ imap ];
+         map_list[ imap ] = NULL;
+         if ( astGetInvert( stage->map ) == stage->invert ) {
+            stage->nin = astGetNin( stage->map );
+            stage->nout = astGetNout( stage->map );
+         } else {
+            stage->nin = astGetNout( stage->map );
+            stage->nout = astGetNin( stage->map );
+         }
+         imap++;
+      }
+
+/* Update the largest number of coordinates used by any stage. */
+      if ( stage->nin > result->maxcoord ) result->maxcoord = stage->nin;
+      if ( stage->nout > result->maxcoord ) result->maxcoord = stage->nout;
+   }
+
+/* Free the Mapping list, annulling any Mapping pointers not used by the
+   pipeline. */
+   for ( imap = 0; imap < nmap; imap++ ) {
+      if ( map_list[ imap ] ) map_list[ imap ] = astAnnul( map_list[ imap ] );
+   }
+   map_list = astFree( map_list );
+   invert_list = astFree( invert_list );
+
+/* If an error occurred, free the pipeline. */
+   if ( !astOK ) result = FreePipeline( result, status );
+
+/* Return the pipeline. */
+   return result;
+}
+
+static AstCmpMapPipeline *FreePipeline( AstCmpMapPipeline *pipe,
+                                        int *status ) {
+/*
+*  Name:
+*     FreePipeline
+
+*  Purpose:
+*     Free a compiled pipeline.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "cmpmap.h"
+*     AstCmpMapPipeline *FreePipeline( AstCmpMapPipeline *pipe,
+*                                      int *status )
+
+*  Class Membership:
+*     CmpMap member function.
+
+*  Description:
+*     This function frees the memory used by a compiled pipeline and
+*     annuls the Mapping pointers it contains.
+
+*  Parameters:
+*     pipe
+*        Pointer to the pipeline. May be NULL.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A NULL pointer.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*/
+
+/* Local Variables: */
+   int istage;                   /* Loop counter for stages */
+
+/* Check a pipeline was supplied. */
+   if ( !pipe ) return NULL;
+
+/* Free the resources used by each stage, and then the pipeline itself. */
+   if ( pipe->stage ) {
+      for ( istage = 0; istage < pipe->nstage; istage++ ) {
+         if ( pipe->stage[ istage ].map ) {
+            pipe->stage[ istage ].map = astAnnul( pipe->stage[ istage ].map );
+         }
+         pipe->stage[ istage ].matrix = astFree( pipe->stage[ istage ].matrix );
+         pipe->stage[ istage ].offset = astFree( pipe->stage[ istage ].offset );
+      }
+      pipe->stage = astFree( pipe->stage );
+   }
+   return astFree( pipe );
+}
+
+static void MergeLinear( AstMapping **maps, int *inverts, int nmap,
+                         PipeStage *stage, int *status ) {
+/*
+*  Name:
+*     MergeLinear
+
+*  Purpose:
+*     Merge a sequence of linear Mappings into a single pipeline stage.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "cmpmap.h"
+*     void MergeLinear( AstMapping **maps, int *inverts, int nmap,
+*                       PipeStage *stage, int *status )
+
+*  Class Membership:
+*     CmpMap member function.
+
+*  Description:
+*     This function finds the matrix and offset vector of the single
+*     linear transformation that is equivalent to applying a sequence of
+*     linear Mappings in series, and stores them in the supplied pipeline
+*     stage. They are found by transforming the origin (which gives the
+*     offsets) and a point displaced along each input axis in turn
+*     (which gives one column of the matrix).
+
+*  Parameters:
+*     maps
+*        Array of pointers to the linear Mappings.
+*     inverts
+*        Array holding the Invert value to use with each Mapping.
+*     nmap
+*        The number of Mappings.
+*     stage
+*        Pointer to the pipeline stage to be initialised. Its "matrix" and
+*        "offset" components should be NULL on entry.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstPointSet *pset1;           /* Input probe positions */
+   AstPointSet *pset2;           /* Transformed probe positions */
+   double **ptr;                 /* Pointers to probe position values */
+   double d;                     /* Displaced output value */
+   double o;                     /* Undisplaced output value */
+   int coord;                    /* Loop counter for coordinates */
+   int forward;                  /* Use forward transformation? */
+   int imap;                     /* Loop counter for Mappings */
+   int in_coord;                 /* Loop counter for input coordinates */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Find the number of inputs for the first Mapping when the required
+   Invert value is used. */
+   forward = ( astGetInvert( maps[ 0 ] ) == inverts[ 0 ] );
+   stage->nin = forward ? astGetNin( maps[ 0 ] ) : astGetNout( maps[ 0 ] );
+
+/* Create a PointSet holding the origin followed by a point displaced
+   along each input axis. */
+   pset1 = astPointSet( stage->nin + 1, stage->nin, "", status );
+   ptr = astGetPoints( pset1 );
+   if ( astOK ) {
+      for ( coord = 0; coord < stage->nin; coord++ ) {
+         for ( in_coord = 0; in_coord <= stage->nin; in_coord++ ) {
+            ptr[ coord ][ in_coord ] = ( in_coord == coord + 1 ) ? PROBE : 0.0;
+         }
+      }
+   }
+
+/* Transform these positions through each Mapping in turn. */
+   for ( imap = 0; imap < nmap && astOK; imap++ ) {
+      forward = ( astGetInvert( maps[ imap ] ) == inverts[ imap ] );
+      pset2 = astTransform( maps[ imap ], pset1, forward, NULL );
+      pset1 = astAnnul( pset1 );
+      pset1 = pset2;
+   }
+
+/* Store the resulting matrix elements and offsets. */
+   stage->nout = astGetNcoord( pset1 );
+   ptr = astGetPoints( pset1 );
+   stage->matrix = astMalloc( sizeof( double ) *
+                              (size_t) ( stage->nout * stage->nin ) );
+   stage->offset = astMalloc( sizeof( double ) * (size_t) stage->nout );
+   if ( astOK ) {
+      for ( coord = 0; coord < stage->nout; coord++ ) {
+         o = ptr[ coord ][ 0 ];
+         stage->offset[ coord ] = o;
+         for ( in_coord = 0; in_coord < stage->nin; in_coord++ ) {
+            d = ptr[ coord ][ in_coord + 1 ];
+            if ( o == AST__BAD || d == AST__BAD ) {
+               stage->matrix[ coord * stage->nin + in_coord ] = AST__BAD;
+            } else {
+               stage->matrix[ coord * stage->nin + in_coord ] = ( d - o )/PROBE;
+            }
+         }
+      }
+   }
+
+/* Free resources. */
+   if ( pset1 ) pset1 = astAnnul( pset1 );
+}
+
+static int PipelineSize( AstCmpMapPipeline *pipe, int *status ) {
+/*
+*  Name:
+*     PipelineSize
+
+*  Purpose:
+*     Return the in-memory size of a compiled pipeline.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "cmpmap.h"
+*     int PipelineSize( AstCmpMapPipeline *pipe, int *status )
+
+*  Class Membership:
+*     CmpMap member function.
+
+*  Description:
+*     This function returns the number of bytes of dynamically allocated
+*     memory used by a compiled pipeline, excluding the Mappings it
+*     refers to (which are also referred to by the CmpMap).
+
+*  Parameters:
+*     pipe
+*        Pointer to the pipeline. May be NULL.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The size in bytes.
+*/
+
+/* Local Variables: */
+   int istage;                   /* Loop counter for stages */
+   int result;                   /* Returned value */
+
+/* Check the global error status and the supplied pointer. */
+   if ( !astOK || !pipe ) return 0;
+
+/* Add up the sizes of the pipeline, its stages and the merged matrices and
+   offsets. */
+   result = astTSizeOf( pipe ) + astTSizeOf( pipe->stage );
+   for ( istage = 0; istage < pipe->nstage; istage++ ) {
+      result += astTSizeOf( pipe->stage[ istage ].matrix );
+      result += astTSizeOf( pipe->stage[ istage ].offset );
+   }
+   return result;
+}
+
+static void RunPipeline( AstCmpMapPipeline *pipe, AstPointSet *in,
+                         AstPointSet *out, int block, int *status ) {
+/*
+*  Name:
+*     RunPipeline
+
+*  Purpose:
+*     Transform a set of points using a compiled pipeline.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "cmpmap.h"
+*     void RunPipeline( AstCmpMapPipeline *pipe, AstPointSet *in,
+*                       AstPointSet *out, int block, int *status )
+
+*  Class Membership:
+*     CmpMap member function.
+
+*  Description:
+*     This function passes the points in a PointSet through all the stages
+*     of a compiled pipeline, storing the results in another PointSet.
+*     The points are processed in blocks, each of which is passed
+*     through all stages before the next block is started. This keeps
+*     the intermediate results small enough to remain in the processor
+*     cache.
+
+*  Parameters:
+*     pipe
+*        Pointer to the pipeline.
+*     in
+*        Pointer to the PointSet holding the input positions.
+*     out
+*        Pointer to the PointSet to receive the output positions. This
+*        may be the same as "in".
+*     block
+*        The maximum number of points in each block.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstPointSet *pset_in;         /* PointSet describing stage inputs */
+   AstPointSet *pset_out;        /* PointSet describing stage outputs */
+   PipeStage *stage;             /* Pointer to current stage */
+   double **ptr;                 /* Work space for coordinate pointers */
+   double **ptr_a;               /* Pointers to stage input values */
+   double **ptr_b;               /* Pointers to stage output values */
+   double **ptr_in;              /* Pointers to input values */
+   double **ptr_out;             /* Pointers to output values */
+   double **ptr_t;               /* Temporary pointer array */
+   double *work;                 /* Work space for intermediate values */
+   double *buf;                  /* Buffer for current stage outputs */
+   int coord;                    /* Loop counter for coordinates */
+   int direct;                   /* Write stage outputs to "out"? */
+   int ipoint;                   /* Index of first point in block */
+   int istage;                   /* Loop counter for stages */
+   int np;                       /* Number of points in block */
+   int npoint;                   /* Total number of points */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get the number of points and pointers to the input and output values. */
+   direct = 1;
+   npoint = astGetNpoint( in );
+   ptr_in = astGetPoints( in );
+   ptr_out = astGetPoints( out );
+
+/* Allocate work space for two sets of intermediate values (the inputs and
+   outputs of a stage), and for two arrays of coordinate pointers. */
+   if ( block > npoint ) block = npoint;
+   work = astMalloc( sizeof( double ) *
+                     (size_t) ( 2 * block * pipe->maxcoord ) );
+   ptr = astMalloc( sizeof( double * ) * (size_t) ( 2 * pipe->maxcoord ) );
+   if ( astOK ) {
+
+/* Loop round each block of points. */
+      for ( ipoint = 0; ipoint < npoint && astOK; ipoint += block ) {
+         np = npoint - ipoint;
+         if ( np > block ) np = block;
+
+/* The inputs to the first stage are the supplied input values. */
+         ptr_a = ptr;
+         ptr_b = ptr + pipe->maxcoord;
+         for ( coord = 0; coord < pipe->stage[ 0 ].nin; coord++ ) {
+            ptr_a[ coord ] = ptr_in[ coord ] + ipoint;
+         }
+
+/* Loop round each stage. The outputs from each stage are stored in
+   alternate halves of the work space, except that the final stage
+   writes directly to the output PointSet. The exception to this is a
+   pipeline containing a single merged stage, which cannot write
+   directly to the output PointSet since the input and output PointSets
+   may be the same. */
+         for ( istage = 0; istage < pipe->nstage && astOK; istage++ ) {
+            stage = pipe->stage + istage;
+            direct = ( istage == pipe->nstage - 1 ) &&
+                     ( pipe->nstage > 1 || stage->map );
+            buf = work + ( istage % 2 ) * block * pipe->maxcoord;
+            for ( coord = 0; coord < stage->nout; coord++ ) {
+               ptr_b[ coord ] = direct ? ptr_out[ coord ] + ipoint :
+                                         buf + coord * block;
+            }
+
+/* Apply a merged stage. */
+            if ( !stage->map ) {
+               ApplyMerged( stage, np, ptr_a, ptr_b, status );
+
+/* Apply a Mapping using scratch PointSets that refer to the input and
+   output values. The direction is chosen so that the required Invert
+   value is used, whatever the current Invert value of the Mapping. */
+            } else {
+               pset_in = astScratchPointSet( np, stage->nin, NULL, 0 );
+               pset_out = astScratchPointSet( np, stage->nout, NULL, 0 );
+               astSetPoints( pset_in, ptr_a );
+               astSetPoints( pset_out, ptr_b );
+               (void) astTransform( stage->map, pset_in,
+                                    ( astGetInvert( stage->map ) ==
+                                      stage->invert ), pset_out );
+               pset_in = astRecyclePointSet( pset_in );
+               pset_out = astRecyclePointSet( pset_out );
+            }
+
+/* The outputs from this stage are the inputs to the next. */
+            ptr_t = ptr_a;
+            ptr_a = ptr_b;
+            ptr_b = ptr_t;
+         }
+
+/* If the final stage did not write directly to the output PointSet,
+   copy its outputs. */
+         if ( astOK && !direct ) {
+            for ( coord = 0; coord < pipe->stage[ 0 ].nout; coord++ ) {
+               (void) memcpy( ptr_out[ coord ] + ipoint, ptr_a[ coord ],
+                              sizeof( double ) * (size_t) np );
+            }
+         }
+      }
+   }
+
+/* Free the work space. */
+   work = astFree( work );
+   ptr = astFree( ptr );
+}
+
 static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                                int forward, AstPointSet *out, int *status ) {
 /*
@@ -3701,6 +4435,7 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
    AstPointSet *temp1;           /* Pointer to temporary PointSet */
    AstPointSet *temp2;           /* Pointer to temporary PointSet */
    AstPointSet *temp;            /* Pointer to temporary PointSet */
+   int block;                    /* No. of points in each pipeline block */
    int forward1;                 /* Use forward direction for Mapping 1? */
    int forward2;                 /* Use forward direction for Mapping 2? */
    int ipoint1;                  /* Index of first point in batch */
@@ -3708,6 +4443,7 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
    int nin1;                     /* No. input coordinates for Mapping 1 */
    int nin2;                     /* No. input coordinates for Mapping 2 */
    int nin;                      /* No. input coordinates supplied */
+   int nmid;                     /* No. intermediate coordinates */
    int nout1;                    /* No. output coordinates for Mapping 1 */
    int nout2;                    /* No. output coordinates for Mapping 2 */
    int nout;                     /* No. output coordinates supplied */
@@ -3758,11 +4494,31 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
    excessive when transforming large numbers of points. To overcome this, we
    split the points up into smaller batches. */
    if ( astOK ) {
-      if ( map->series ) {
+      block = map->series ? astCmpMapBlock( AST__TUNULL ) : 0;
+      if ( block > 0 ) {
+
+/* Unless disabled using the "CmpMapBlock" tuning parameter, use a compiled
+   pipeline that applies all the component Mappings to each block of points
+   in turn. Compile the pipeline for the required direction if this has not
+   already been done. */
+         if ( !map->pipe[ forward ? 1 : 0 ] ) {
+            map->pipe[ forward ? 1 : 0 ] = CompilePipeline( map, forward,
+                                                            status );
+         }
+         RunPipeline( map->pipe[ forward ? 1 : 0 ], in, result, block,
+                      status );
+
+/* Otherwise, apply each component Mapping in turn. */
+      } else if ( map->series ) {
 
-/* Obtain the numbers of input and output coordinates. */
+/* Obtain the numbers of input, intermediate and output coordinates. */
          nin = astGetNcoord( in );
          nout = astGetNcoord( result );
+         if ( forward ) {
+            nmid = forward1 ? astGetNout( map->map1 ) : astGetNin( map->map1 );
+         } else {
+            nmid = forward2 ? astGetNout( map->map2 ) : astGetNin( map->map2 );
+         }
 
 /* Loop to process all the points in batches, of maximum size nbatch points. */
          for ( ipoint1 = 0; ipoint1 < npoint; ipoint1 += nbatch ) {
@@ -3773,31 +4529,34 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
             if ( ipoint2 > npoint - 1 ) ipoint2 = npoint - 1;
             np = ipoint2 - ipoint1 + 1;
 
-/* Create temporary PointSets to describe the input and output points for this
-   batch. */
-            temp1 = astPointSet( np, nin, "", status );
-            temp2 = astPointSet( np, nout, "", status );
+/* Obtain scratch PointSets to describe the input and output points for this
+   batch, and to hold the intermediate result. These are re-used from
+   previous batches (or previous invocations) where possible, so that no
+   memory is allocated in the steady state. */
+            temp1 = astScratchPointSet( np, nin, NULL, 0 );
+            temp2 = astScratchPointSet( np, nout, NULL, 0 );
+            temp = astScratchPointSet( np, nmid, NULL, 0 );
 
 /* Associate the required subsets of the input and output coordinates with the
    two PointSets. */
             astSetSubPoints( in, ipoint1, 0, temp1 );
             astSetSubPoints( result, ipoint1, 0, temp2 );
 
-/* Apply the two Mappings in sequence and in the required order and direction.
-   Store the intermediate result in a temporary PointSet (temp) which is
-   created by the first Mapping applied. */
+/* Apply the two Mappings in sequence and in the required order and direction,
+   storing the intermediate result in the temporary PointSet (temp). */
             if ( forward ) {
-               temp = astTransform( map->map1, temp1, forward1, NULL );
+               (void) astTransform( map->map1, temp1, forward1, temp );
                (void) astTransform( map->map2, temp, forward2, temp2 );
             } else {
-               temp = astTransform( map->map2, temp1, forward2, NULL );
+               (void) astTransform( map->map2, temp1, forward2, temp );
                (void) astTransform( map->map1, temp, forward1, temp2 );
             }
 
-/* Delete the temporary PointSets after processing each batch of points. */
-            temp = astDelete( temp );
-            temp1 = astDelete( temp1 );
-            temp2 = astDelete( temp2 );
+/* Return the temporary PointSets to the pool after processing each batch of
+   points. */
+            temp = astRecyclePointSet( temp );
+            temp1 = astRecyclePointSet( temp1 );
+            temp2 = astRecyclePointSet( temp2 );
 
 /* Quit processing batches if an error occurs. */
             if ( !astOK ) break;
@@ -3818,10 +4577,10 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
          nin2 = forward2 ? astGetNin( map->map2 ) : astGetNout( map->map2 );
          nout2 = forward2 ? astGetNout( map->map2 ) : astGetNin( map->map2 );
 
-/* Create temporary PointSets to describe the input and output coordinates for
+/* Obtain scratch PointSets to describe the input and output coordinates for
    the first Mapping. */
-         temp1 = astPointSet( npoint, nin1, "", status );
-         temp2 = astPointSet( npoint, nout1, "", status );
+         temp1 = astScratchPointSet( npoint, nin1, NULL, 0 );
+         temp2 = astScratchPointSet( npoint, nout1, NULL, 0 );
 
 /* Associate the required subsets of the input and output coordinates with
    these PointSets. */
@@ -3832,24 +4591,24 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
    by the first Mapping. */
          (void) astTransform( map->map1, temp1, forward1, temp2 );
 
-/* Delete the temporary PointSets. */
-         temp1 = astDelete( temp1 );
-         temp2 = astDelete( temp2 );
+/* Return the temporary PointSets to the pool. */
+         temp1 = astRecyclePointSet( temp1 );
+         temp2 = astRecyclePointSet( temp2 );
 
-/* Create a new pair of temporary PointSets to describe the input and output
+/* Obtain a new pair of scratch PointSets to describe the input and output
    coordinates for the second Mapping, and associate the required subsets of
    the input and output coordinates with these PointSets. */
-         temp1 = astPointSet( npoint, nin2, "", status );
-         temp2 = astPointSet( npoint, nout2, "", status );
+         temp1 = astScratchPointSet( npoint, nin2, NULL, 0 );
+         temp2 = astScratchPointSet( npoint, nout2, NULL, 0 );
          astSetSubPoints( in, 0, nin1, temp1 );
          astSetSubPoints( result, 0, nout1, temp2 );
 
 /* Apply the coordinate transformation described by the second Mapping. */
          (void) astTransform( map->map2, temp1, forward2, temp2 );
 
-/* Delete the two temporary PointSets. */
-         temp1 = astDelete( temp1 );
-         temp2 = astDelete( temp2 );
+/* Return the two temporary PointSets to the pool. */
+         temp1 = astRecyclePointSet( temp1 );
+         temp2 = astRecyclePointSet( temp2 );
       }
    }
 
@@ -3915,6 +4674,11 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    out->map1 = NULL;
    out->map2 = NULL;
 
+/* Compiled pipelines are not copied. The output CmpMap will compile its
+   own when it is first used. */
+   out->pipe[ 0 ] = NULL;
+   out->pipe[ 1 ] = NULL;
+
 /* Make copies of these Mappings and store pointers to them in the output
    CmpMap structure. */
    out->map1 = astCopy( in->map1 );
@@ -3960,6 +4724,10 @@ static void Delete( AstObject *obj, int *status ) {
 /* Obtain a pointer to the CmpMap structure. */
    this = (AstCmpMap *) obj;
 
+/* Free any compiled pipelines. */
+   this->pipe[ 0 ] = FreePipeline( this->pipe[ 0 ], status );
+   this->pipe[ 1 ] = FreePipeline( this->pipe[ 1 ], status );
+
 /* Annul the pointers to the component Mappings. */
    this->map1 = astAnnul( this->map1 );
    this->map2 = astAnnul( this->map2 );
@@ -4519,6 +5287,10 @@ AstCmpMap *astInitCmpMap_( void *mem, size_t size, int init,
 
 /* Initialise the CmpMap data. */
 /* --------------------------- */
+/* Pipelines are compiled when first needed. */
+         new->pipe[ 0 ] = NULL;
+         new->pipe[ 1 ] = NULL;
+
 /* Store pointers to the component Mappings. Extract Mappings if
    FrameSets are provided. */
          if( astIsAFrameSet( map1 ) ) {
@@ -4685,6 +5457,10 @@ AstCmpMap *astLoadCmpMap_( void *mem, size_t size,
    obtained, we then use the appropriate (private) Set... member
    function to validate and set the value properly. */
 
+/* Pipelines are compiled when first needed. */
+      new->pipe[ 0 ] = NULL;
+      new->pipe[ 1 ] = NULL;
+
 /* Series. */
 /* ------- */
       new->series = astReadInt( channel, "series", 1 );
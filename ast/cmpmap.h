@@ -129,6 +129,9 @@
 *        Over-ride the astSimplify method.
 *     8-JAN-2003 (DSB):
 *        Added protected astInitCmpMapVtab method.
+*     16-OCT-2026 (DSB):
+*        Added compiled pipelines and the protected astCmpMapBlock
+*        function.
 *-
 */
 
@@ -174,6 +177,7 @@ typedef struct AstCmpMap {
    char invert1;                  /* Inversion flag for first Mapping */
    char invert2;                  /* Inversion flag for second Mapping */
    char series;                   /* Connect in series (else in parallel)? */
+   struct AstCmpMapPipeline *pipe[ 2 ]; /* Compiled pipelines (inverse, forward) */
 } AstCmpMap;
 
 /* Virtual function table. */
@@ -244,7 +248,9 @@ void astInitCmpMapGlobals_( AstCmpMapGlobals * );
 
 /* Prototypes for member functions. */
 /* -------------------------------- */
-/* None. */
+#if defined(astCLASS)            /* Protected */
+int astCmpMapBlock_( int, int * );
+#endif
 
 /* Function interfaces. */
 /* ==================== */
@@ -284,6 +290,8 @@ astINVOKE(O,astInitCmpMap_(mem,size,init,vtab,name,astCheckMapping(map1),astChec
 /* Loader. */
 #define astLoadCmpMap(mem,size,vtab,name,channel) \
 astINVOKE(O,astLoadCmpMap_(mem,size,vtab,name,astCheckChannel(channel),STATUS_PTR))
+
+#define astCmpMapBlock(newval) astERROR_INVOKE(astCmpMapBlock_(newval,STATUS_PTR))
 #endif
 
 /* Interfaces to public member functions. */
@@ -116,6 +116,14 @@ f     The CmpRegion class does not define any new routines beyond those
 *     21-NOV-2012 (DSB):
 *        Map the regions returned by RegSplit into the current Frame of the 
 *        CmpRegion.
+*     16-OCT-2026 (DSB):
+*        In Transform, only pass the second component Region the points
+*        that are not decided by the first, and use a cached bounding box
+*        to reject points outside each component without transforming them.
+*     16-OCT-2026 (DSB):
+*        Do not use bounding boxes for Polygons, or for Intervals that
+*        exclude a range of values, since these Regions may include points
+*        outside the box.
 *class--
 */
 
@@ -238,10 +246,12 @@ static int RegTrace( AstRegion *, int, double *, double **, int * );
 static void ClearClosed( AstRegion *, int * );
 static void ClearMeshSize( AstRegion *, int * );
 static void Copy( const AstObject *, AstObject *, int * );
+static double *CullBox( AstRegion *, int * );
 static void Decompose( AstMapping *, AstMapping **, AstMapping **, int *, int *, int *, int * );
 static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void GetRegions( AstCmpRegion *, AstRegion **, AstRegion **, int *, int *, int *, int * );
+static void InRegion( AstRegion *, const double *, AstPointSet *, int, const int *, char *, int * );
 static void RegBaseBox( AstRegion *, double *, double *, int * );
 static void RegBaseBox2( AstRegion *, double *, double *, int * );
 static void RegClearAttrib( AstRegion *, const char *, char **, int * );
@@ -409,6 +419,191 @@ int CmpRegionList( AstCmpRegion *this, int *nreg, AstRegion ***reg_list,
    return result;
 }
 
+static double *CullBox( AstRegion *reg, int *status ){
+/*
+*  Name:
+*     CullBox
+
+*  Purpose:
+*     Find a box that is guaranteed to enclose a Region.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "cmpregion.h"
+*     double *CullBox( AstRegion *reg, int *status )
+
+*  Class Membership:
+*     CmpRegion member function
+
+*  Description:
+*     This function returns a box in the current Frame of the supplied
+*     Region that encloses every point inside the Region, if such a box
+*     can be found reliably. It is used by Transform to reject points
+*     without transforming them.
+*
+*     Boxes are only returned for un-negated Box, Circle and Interval
+*     Regions defined within a simple Frame (for which the bounding box
+*     returned by astRegBaseBox is exact), and for CmpRegions formed from
+*     such Regions. Intervals that exclude a range of values on any axis
+*     are not used. Polygons are not used since a Polygon may enclose
+*     points outside the box spanned by its vertices (for instance if
+*     its edges cross, or its vertices are given in clockwise order). The Region's base to current
+*     Mapping must be a UnitMap. The box is extended by the width of the
+*     Region's uncertainty, since positions within this distance of the
+*     boundary may be considered to be inside the Region.
+
+*  Parameters:
+*     reg
+*        Pointer to the Region.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to a newly allocated array holding the lower bounds of
+*     the box on each axis, followed by the upper bounds on each axis.
+*     It should be freed using astFree when no longer needed. NULL is
+*     returned if no reliable box can be found.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked with
+*     the global error status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstFrame *frm;             /* Base Frame of Region */
+   AstMapping *map;           /* Region's base to current Mapping */
+   AstRegion *reg1;           /* First component Region */
+   AstRegion *reg2;           /* Second component Region */
+   AstRegion *unc;            /* Uncertainty Region */
+   const char *class;         /* Region class */
+   double *box2;              /* Box enclosing second component Region */
+   double *lbnd_unc;          /* Lower bounds of uncertainty Region */
+   double *result;            /* Returned box */
+   double *ubnd_unc;          /* Upper bounds of uncertainty Region */
+   double wid;                /* Amount by which to extend the box */
+   int i;                     /* Axis index */
+   int nax;                   /* Number of axes */
+   int neg1;                  /* Negated value for first component */
+   int neg2;                  /* Negated value for second component */
+   int oper;                  /* Boolean operator */
+   int unit;                  /* Is the Region's Mapping a UnitMap? */
+
+/* Initialise */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* The base and current Frames of the Region must be connected by a
+   UnitMap. */
+   map = astRegMapping( reg );
+   unit = astIsAUnitMap( map );
+   map = astAnnul( map );
+   if( !unit ) return result;
+   nax = astGetNaxes( reg );
+
+/* For a CmpRegion, get the boxes enclosing the two component Regions, in
+   the form used by Transform. */
+   if( astIsACmpRegion( reg ) ) {
+      GetRegions( (AstCmpRegion *) reg, &reg1, &reg2, &oper, &neg1, &neg2,
+                  status );
+      if( neg1 != astGetNegated( reg1 ) ) {
+         AstRegion *tmp = astGetNegation( reg1 );
+         (void) astAnnul( reg1 );
+         reg1 = tmp;
+      }
+      if( neg2 != astGetNegated( reg2 ) ) {
+         AstRegion *tmp = astGetNegation( reg2 );
+         (void) astAnnul( reg2 );
+         reg2 = tmp;
+      }
+      result = CullBox( reg1, status );
+      box2 = CullBox( reg2, status );
+
+/* If the components are ANDed, the CmpRegion is enclosed by the
+   intersection of any available boxes. */
+      if( oper == AST__AND ) {
+         if( !result ) {
+            result = box2;
+            box2 = NULL;
+         } else if( box2 ) {
+            for( i = 0; i < nax; i++ ) {
+               if( box2[ i ] > result[ i ] ) result[ i ] = box2[ i ];
+               if( box2[ i + nax ] < result[ i + nax ] ) {
+                  result[ i + nax ] = box2[ i + nax ];
+               }
+            }
+         }
+
+/* If the components are ORed, the CmpRegion is enclosed by the union of
+   the two boxes, if both are available. */
+      } else if( result && box2 ) {
+         for( i = 0; i < nax; i++ ) {
+            if( box2[ i ] < result[ i ] ) result[ i ] = box2[ i ];
+            if( box2[ i + nax ] > result[ i + nax ] ) {
+               result[ i + nax ] = box2[ i + nax ];
+            }
+         }
+      } else {
+         result = astFree( result );
+      }
+
+      box2 = astFree( box2 );
+      reg1 = astAnnul( reg1 );
+      reg2 = astAnnul( reg2 );
+
+/* For other Regions, check the class and Frame are suitable. */
+   } else if( !astGetNegated( reg ) ) {
+      class = astGetClass( reg );
+      if( class && ( !strcmp( class, "Box" ) || !strcmp( class, "Circle" ) ||
+                     !strcmp( class, "Interval" ) ) ) {
+         frm = astGetFrame( reg->frameset, AST__BASE );
+         class = astGetClass( frm );
+         if( class && !strcmp( class, "Frame" ) ) {
+
+/* Get the bounding box of the Region and of its uncertainty Region. */
+            result = astMalloc( 2*sizeof( double )*(size_t) nax );
+            lbnd_unc = astMalloc( sizeof( double )*(size_t) nax );
+            ubnd_unc = astMalloc( sizeof( double )*(size_t) nax );
+            if( astOK ) {
+               astRegBaseBox( reg, result, result + nax );
+               unc = astGetUncFrm( reg, AST__BASE );
+               astGetRegionBounds( unc, lbnd_unc, ubnd_unc );
+               unc = astAnnul( unc );
+
+/* Extend the box by the width of the uncertainty Region, plus a small
+   fraction of its own width to allow for rounding errors. An Interval
+   with a lower limit above its upper limit excludes the values between
+   them, so no box can be used. */
+               for( i = 0; i < nax && result; i++ ) {
+                  if( result[ i ] == AST__BAD || result[ i + nax ] == AST__BAD ||
+                      lbnd_unc[ i ] == AST__BAD || ubnd_unc[ i ] == AST__BAD ||
+                      result[ i ] > result[ i + nax ] ) {
+                     result = astFree( result );
+                  } else {
+                     wid = ( ubnd_unc[ i ] - lbnd_unc[ i ] ) +
+                           1.0E-6*( result[ i + nax ] - result[ i ] );
+                     result[ i ] -= wid;
+                     result[ i + nax ] += wid;
+                  }
+               }
+            }
+            lbnd_unc = astFree( lbnd_unc );
+            ubnd_unc = astFree( ubnd_unc );
+         }
+         frm = astAnnul( frm );
+      }
+   }
+
+/* Return NULL if anything went wrong. */
+   if( !astOK ) result = astFree( result );
+
+/* Return the box. */
+   return result;
+}
+
 static void Decompose( AstMapping *this_mapping, AstMapping **map1,
                        AstMapping **map2, int *series, int *invert1,
                        int *invert2, int *status ) {
@@ -1166,6 +1361,138 @@ static AstRegion *GetDefUnc( AstRegion *this_region, int *status ) {
    return result;
 }
 
+static void InRegion( AstRegion *reg, const double *box, AstPointSet *pset,
+                      int n, const int *index, char *inside, int *status ){
+/*
+*  Name:
+*     InRegion
+
+*  Purpose:
+*     Determine which of a set of points are inside a component Region.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "cmpregion.h"
+*     void InRegion( AstRegion *reg, const double *box, AstPointSet *pset,
+*                    int n, const int *index, char *inside, int *status )
+
+*  Class Membership:
+*     CmpRegion member function
+
+*  Description:
+*     This function determines which of a selection of the points in a
+*     PointSet are inside a Region. Points with good axis values that are
+*     outside a box enclosing the Region are rejected without further
+*     checks. The remaining points are transformed using the Region. The
+*     whole of the supplied PointSet is transformed if all its points need
+*     to be checked. Otherwise, the points to be checked are copied into
+*     a new PointSet first.
+
+*  Parameters:
+*     reg
+*        Pointer to the Region.
+*     box
+*        A box (as returned by CullBox) that encloses the Region, or NULL
+*        if no box is available.
+*     pset
+*        Pointer to the PointSet holding the positions to be tested, in
+*        the current Frame of "reg".
+*     n
+*        The number of points to be tested.
+*     index
+*        An array holding the indices within "pset" of the "n" points to
+*        be tested. If NULL, the first "n" points in "pset" are tested.
+*     inside
+*        An array in which to return a flag for each of the "n" points,
+*        indicating if the point is inside the Region.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstPointSet *ps;           /* PointSet holding positions to transform */
+   AstPointSet *psout;        /* Transformed positions */
+   double **ptr;              /* Pointers to supplied axis values */
+   double **ptr_out;          /* Pointers to transformed axis values */
+   double **ptr_sub;          /* Pointers to copied axis values */
+   double axval;              /* Axis value */
+   int *list;                 /* Indices of points to transform */
+   int coord;                 /* Axis index */
+   int i;                     /* Index of point within selection */
+   int ncoord;                /* Number of axes */
+   int nlist;                 /* Number of points to transform */
+   int point;                 /* Index of point within "pset" */
+
+/* Check the global error status. */
+   if ( !astOK || n == 0 ) return;
+
+/* Get the number of axes and pointers to the axis values. */
+   ncoord = astGetNcoord( pset );
+   ptr = astGetPoints( pset );
+
+/* Find the points that need to be transformed, and reject any others.
+   Bad axis values are passed on to the Region. */
+   list = astMalloc( sizeof( int )*(size_t) n );
+   nlist = 0;
+   if( astOK ) {
+      for( i = 0; i < n; i++ ) {
+         point = index ? index[ i ] : i;
+         inside[ i ] = 0;
+         if( box ) {
+            for( coord = 0; coord < ncoord; coord++ ) {
+               axval = ptr[ coord ][ point ];
+               if( axval != AST__BAD && ( axval < box[ coord ] ||
+                                          axval > box[ coord + ncoord ] ) ) {
+                  break;
+               }
+            }
+            if( coord < ncoord ) continue;
+         }
+         list[ nlist++ ] = i;
+      }
+   }
+
+/* If any points remain, get a PointSet holding them. */
+   if( nlist > 0 ) {
+      if( nlist == astGetNpoint( pset ) && !index ) {
+         ps = astClone( pset );
+      } else {
+         ps = astPointSet( nlist, ncoord, "", status );
+         ptr_sub = astGetPoints( ps );
+         if( astOK ) {
+            for( coord = 0; coord < ncoord; coord++ ) {
+               for( i = 0; i < nlist; i++ ) {
+                  point = index ? index[ list[ i ] ] : list[ i ];
+                  ptr_sub[ coord ][ i ] = ptr[ coord ][ point ];
+               }
+            }
+         }
+      }
+
+/* Transform them using the Region. A point is inside the Region if any
+   of its transformed axis values are good. */
+      psout = astTransform( reg, ps, 0, NULL );
+      ptr_out = astGetPoints( psout );
+      if( astOK ) {
+         for( i = 0; i < nlist; i++ ) {
+            for( coord = 0; coord < ncoord; coord++ ) {
+               if( ptr_out[ coord ][ i ] != AST__BAD ) {
+                  inside[ list[ i ] ] = 1;
+                  break;
+               }
+            }
+         }
+      }
+
+/* Free resources. */
+      psout = astAnnul( psout );
+      ps = astAnnul( ps );
+   }
+   list = astFree( list );
+}
+
 void astInitCmpRegionVtab_(  AstCmpRegionVtab *vtab, const char *name, int *status ) {
 /*
 *+
@@ -3163,9 +3490,11 @@ static void ResetCache( AstRegion *this_region, int *status ){
          this->nbreak[ i ] = 0;
          this->d0[ i ] = AST__BAD;
          this->dtot[ i ] = AST__BAD;
+         this->cullbox[ i ] = astFree( this->cullbox[ i ] );
       }
 
       this->bounded = -INT_MAX;
+      this->cullneg = -1;
 
 /* Clear information cached in the component regions. */
       if( this->region1 ) astResetCache( this->region1 );
@@ -3850,22 +4179,22 @@ static AstPointSet *Transform( AstMapping *this_mapping, AstPointSet *in,
 
 /* Local Variables: */
    AstCmpRegion *this;           /* Pointer to the CmpRegion structure */
-   AstPointSet *ps1;             /* Pointer to PointSet for first component */
-   AstPointSet *ps2;             /* Pointer to PointSet for second component */
    AstPointSet *pset_tmp;        /* Pointer to PointSet holding base Frame positions*/
    AstPointSet *result;          /* Pointer to output PointSet */
    AstRegion *reg1;              /* Pointer to first component Region */
    AstRegion *reg2;              /* Pointer to second component Region */
-   double **ptr1;                /* Pointer to first component axis values */
-   double **ptr2;                /* Pointer to second component axis values */
+   char *inside1;                /* Is each point inside first component? */
+   char *inside2;                /* Is each undecided point inside second? */
    double **ptr_out;             /* Pointer to output coordinate data */
+   int *index;                   /* Indices of undecided points */
    int coord;                    /* Zero-based index for coordinates */
    int good;                     /* Is the point inside the CmpRegion? */
+   int i;                        /* Index of next undecided point */
    int ncoord_out;               /* No. of coordinates per output point */
-   int ncoord_tmp;               /* No. of coordinates per base Frame point */
    int neg1;                     /* Negated value for first component Region */
    int neg2;                     /* Negated value for second component Region */
    int npoint;                   /* No. of points */
+   int nundec;                   /* No. of undecided points */
    int oper;                     /* Boolean operator to use */
    int point;                    /* Loop counter for points */
 
@@ -3920,56 +4249,63 @@ static AstPointSet *Transform( AstMapping *this_mapping, AstPointSet *in,
    must be carefull not to modify the contents of the returned PointSet. */
    pset_tmp = astRegTransform( this, in, 0, NULL, NULL );
 
-/* Now transform this PointSet using each of the two component Regions in
-   turn. */
-   ps1 = astTransform( reg1, pset_tmp, 0, NULL );
-   ps2 = astTransform( reg2, pset_tmp, 0, NULL );
+/* Get boxes enclosing each of the two component Regions, if not already
+   cached. These are used to reject points without needing to transform
+   them. The boxes depend on the Negated attribute of the CmpRegion, so
+   find new boxes if it has changed since the boxes were found. */
+   if( this->cullneg != astGetNegated( this ) ) {
+      this->cullbox[ 0 ] = astFree( this->cullbox[ 0 ] );
+      this->cullbox[ 1 ] = astFree( this->cullbox[ 1 ] );
+      this->cullbox[ 0 ] = CullBox( reg1, status );
+      this->cullbox[ 1 ] = CullBox( reg2, status );
+      if( astOK ) this->cullneg = astGetNegated( this );
+   }
 
-/* Determine the numbers of points and coordinates per point for these base
-   Frame PointSets and obtain pointers for accessing the base Frame and output
-   coordinate values. */
+/* Determine the numbers of points and coordinates per point, and get
+   pointers for accessing the output coordinate values. */
    npoint = astGetNpoint( pset_tmp );
-   ncoord_tmp = astGetNcoord( pset_tmp );
-   ptr1 = astGetPoints( ps1 );
-   ptr2 = astGetPoints( ps2 );
    ncoord_out = astGetNcoord( result );
    ptr_out = astGetPoints( result );
 
-/* Perform coordinate arithmetic. */
-/* ------------------------------ */
-   if ( astOK ) {
-
-/* First deal with ANDed Regions */
-      if( oper == AST__AND ) {
-         for ( point = 0; point < npoint; point++ ) {
-            good = 0;
+/* Find which points are inside the first component Region. */
+   inside1 = astMalloc( sizeof( char )*(size_t) npoint );
+   inside2 = astMalloc( sizeof( char )*(size_t) npoint );
+   index = astMalloc( sizeof( int )*(size_t) npoint );
+   InRegion( reg1, this->cullbox[ 0 ], pset_tmp, npoint, NULL, inside1,
+             status );
 
-            for ( coord = 0; coord < ncoord_tmp; coord++ ) {
-               if( ptr1[ coord ][ point ] != AST__BAD &&
-                   ptr2[ coord ][ point ] != AST__BAD ) {
-                  good = 1;
-                  break;
-               }
-            }
+/* Report error for any unknown operator. */
+   if( oper != AST__AND && oper != AST__OR && astOK ) {
+      astError( AST__INTER, "astTransform(%s): The %s refers to an unknown "
+                "boolean operator with identifier %d (internal AST "
+                "programming error).", status, astGetClass( this ),
+                 astGetClass( this ), oper );
+   }
 
-            if( !good ) {
-               for ( coord = 0; coord < ncoord_out; coord++ ) {
-                  ptr_out[ coord ][ point ] = AST__BAD;
-               }
-            }
+/* The second component Region only needs to be checked at points that
+   are not decided by the first. For ANDed Regions these are the points
+   that are inside the first Region, and for ORed Regions they are the
+   points that are outside the first Region. */
+   if( astOK ) {
+      nundec = 0;
+      for ( point = 0; point < npoint; point++ ) {
+         if( ( oper == AST__AND ) == ( inside1[ point ] != 0 ) ) {
+            index[ nundec++ ] = point;
          }
+      }
+      InRegion( reg2, this->cullbox[ 1 ], pset_tmp, nundec, index, inside2,
+                status );
 
-/* Now deal with ORed Regions */
-      } else if( oper == AST__OR ) {
+/* Set the output values bad at all points that are not inside the
+   CmpRegion. For undecided points, this is determined by the second
+   Region. Otherwise it is determined by the first Region. */
+      if( astOK ) {
+         i = 0;
          for ( point = 0; point < npoint; point++ ) {
-            good = 0;
-
-            for ( coord = 0; coord < ncoord_tmp; coord++ ) {
-               if( ptr1[ coord ][ point ] != AST__BAD ||
-                   ptr2[ coord ][ point ] != AST__BAD ) {
-                  good = 1;
-                  break;
-               }
+            if( i < nundec && index[ i ] == point ) {
+               good = inside2[ i++ ];
+            } else {
+               good = inside1[ point ];
             }
 
             if( !good ) {
@@ -3978,22 +4314,16 @@ static AstPointSet *Transform( AstMapping *this_mapping, AstPointSet *in,
                }
             }
          }
-
-/* Report error for any unknown operator. */
-      } else if( astOK ) {
-         astError( AST__INTER, "astTransform(%s): The %s refers to an unknown "
-                   "boolean operator with identifier %d (internal AST "
-                   "programming error).", status, astGetClass( this ),
-                    astGetClass( this ), oper );
       }
    }
 
 /* Free resources. */
    reg1 = astAnnul( reg1 );
    reg2 = astAnnul( reg2 );
-   ps1 = astAnnul( ps1 );
-   ps2 = astAnnul( ps2 );
    pset_tmp = astAnnul( pset_tmp );
+   inside1 = astFree( inside1 );
+   inside2 = astFree( inside2 );
+   index = astFree( index );
 
 /* If an error occurred, clean up by deleting the output PointSet (if
    allocated by this function) and setting a NULL result pointer. */
@@ -4162,7 +4492,9 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    for( i = 0; i < 2; i++ ) {
       out->rvals[ i ] = NULL;
       out->offs[ i ] = NULL;
+      out->cullbox[ i ] = NULL;
    }
+   out->cullneg = -1;
 
 /* Make copies of these Regions and store pointers to them in the output
    CmpRegion structure. */
@@ -4222,6 +4554,7 @@ static void Delete( AstObject *obj, int *status ) {
    for( i = 0; i < 2; i++ ) {
       this->rvals[ i ] = astFree( this->rvals[ i ] );
       this->offs[ i ] = astFree( this->offs[ i ] );
+      this->cullbox[ i ] = astFree( this->cullbox[ i ] );
    }
 
 /* Annul the pointers to the component Regions. */
@@ -4851,8 +5184,10 @@ AstCmpRegion *astInitCmpRegion_( void *mem, size_t size, int init,
          new->nbreak[ i ] = 0;
          new->d0[ i ] = AST__BAD;
          new->dtot[ i ] = AST__BAD;
+         new->cullbox[ i ] = NULL;
       }
       new->bounded = -INT_MAX;
+      new->cullneg = -1;
 
 /* If the base->current Mapping in the FrameSet within each component Region
    is a UnitMap, then the FrameSet does not need to be included in the
@@ -5045,8 +5380,10 @@ AstCmpRegion *astLoadCmpRegion_( void *mem, size_t size,
          new->nbreak[ i ] = 0;
          new->d0[ i ] = AST__BAD;
          new->dtot[ i ] = AST__BAD;
+         new->cullbox[ i ] = NULL;
       }
       new->bounded = -INT_MAX;
+      new->cullneg = -1;
 
 /* The CmpRegion class does not implement XOR directly (as it does for
    AND and OR). Instead, when requested to create an XOR CmpRegion, it
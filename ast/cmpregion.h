@@ -59,6 +59,8 @@
 *  History:
 *     11-OCT-2004 (DSB):
 *        Original version.
+*     16-OCT-2026 (DSB):
+*        Added cullbox and cullneg.
 *-
 */
 
@@ -119,6 +121,8 @@ typedef struct AstCmpRegion {
    AstRegion *xor1;              /* First XORed Region */
    AstRegion *xor2;              /* Second XORed Region */
    int bounded;                  /* Is this CmpRegion bounded? */
+   double *cullbox[ 2 ];         /* Bounding box of each component Region */
+   int cullneg;                  /* Negated value used to find cullbox */
 } AstCmpRegion;
 
 /* Virtual function table. */
@@ -121,6 +121,9 @@
 *        Big changes for the thread-safe version of AST.
 *     3-FEB-2009 (DSB):
 *        Added astBacktrace.
+*     16-OCT-2026 (DSB):
+*        Use astSTATUS_BLOCK to locate the thread-specific status value,
+*        so that thread-local storage is used if available.
 */
 
 /* Define the astCLASS macro (even although this is not a class
@@ -764,14 +767,14 @@ int *astGetStatusPtr_(){
 */
 
 /* The thread-safe version of AST stores the status pointer in thread
-   specific data, using the key stored in the global variable
-   "starlink_ast_status_key". */
+   specific data (either a thread-local variable or the pthreads key
+   stored in the global variable "starlink_ast_status_key"). */
 #if defined(THREAD_SAFE)
    astDECLARE_GLOBALS
    AstStatusBlock *sb;
 
    astGET_GLOBALS(NULL);
-   sb = (AstStatusBlock *) pthread_getspecific(starlink_ast_status_key);
+   sb = astSTATUS_BLOCK;
    return sb->status_ptr;
 
 /* The non thread-safe version of AST stores the status pointer in the
@@ -1009,7 +1012,7 @@ c--
    astGET_GLOBALS(NULL);
 
 #if defined(THREAD_SAFE)
-   sb = (AstStatusBlock *) pthread_getspecific( starlink_ast_status_key );
+   sb = astSTATUS_BLOCK;
    result = sb->status_ptr;
    sb->status_ptr = status_ptr ? status_ptr : &(sb->internal_status);
 #else
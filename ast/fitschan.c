@@ -1147,6 +1147,10 @@ f     - AST_WRITEFITS: Write all cards out to the sink function
 *        further distances along the axis. In practice, it meant that SIP 
 *        distortion were being treated as linear because the test did not 
 *        explore a large enough region of pixel space.
+*     16-OCT-2026 (DSB):
+*        Index the cards in a FitsChan by keyword name, and by the first
+*        two characters of the keyword name, so that FindKeyCard does not
+*        need to check every card in the FitsChan.
 *class--
 */
 
@@ -1231,6 +1235,9 @@ f     - AST_WRITEFITS: Write all cards out to the sink function
 #define HEADER_TEXT        "Beginning of AST data for "
 #define FOOTER_TEXT        "End of AST data for "
 #define FITSNAMLEN         8
+#define FITSPREFIXLEN      2
+#define KEYWORD_INDEX      0
+#define PREFIX_INDEX       1
 #define FITSSTCOL          20
 #define FITSRLCOL          30
 #define FITSIMCOL          50
@@ -1378,6 +1385,9 @@ typedef struct FitsCard {
    size_t size;               /* Size of data value */
    struct FitsCard *next;     /* Pointer to next structure in list. */
    struct FitsCard *prev;     /* Pointer to previous structure in list. */
+   struct FitsCard *inext[ 2 ];/* Next card with same keyword/prefix. */
+   struct FitsCard *iprev[ 2 ];/* Previous card with same keyword/prefix. */
+   double order;              /* Increases monotonically along the list. */
 } FitsCard;
 
 /* Structure used to store information derived from the FITS WCS keyword
@@ -1772,6 +1782,7 @@ static int EncodeValue( AstFitsChan *, char *, int, int, const char *, int * );
 static int FindBasisVectors( AstMapping *, int, int, double *, AstPointSet *, AstPointSet *, int * );
 static int FindFits( AstFitsChan *, const char *, char[ AST__FITSCHAN_FITSCARDLEN + 1 ], int, int * );
 static int FindKeyCard( AstFitsChan *, const char *, const char *, const char *, int * );
+static int IndexKey( const char *, int, char *, int * );
 static int FindLonLatSpecAxes( FitsStore *, char, int *, int *, int *, const char *, const char *, int * );
 static int FindString( int, const char *[], const char *, const char *, const char *, const char *, int * );
 static int FitOK( int, double *, double *, double, int * );
@@ -1862,6 +1873,7 @@ static void FreeItemC( char *****, int * );
 static void GetFiducialNSC( AstWcsMap *, double *, double *, int * );
 static void GetFiducialPPC( AstWcsMap *, double *, double *, int * );
 static void GetNextData( AstChannel *, int, char **, char **, int * );
+static void IndexCard( AstFitsChan *, FitsCard *, int, int * );
 static void InsCard( AstFitsChan *, int, const char *, int, void *, const char *, const char *, const char *, int * );
 static void MakeBanner( const char *, const char *, const char *, char [ AST__FITSCHAN_FITSCARDLEN - FITSNAMLEN + 1 ], int * );
 static void MakeIndentedComment( int, char, const char *, const char *, char [ AST__FITSCHAN_FITSCARDLEN - FITSNAMLEN + 1], int * );
@@ -1869,6 +1881,7 @@ static void MakeIntoComment( AstFitsChan *, const char *, const char *, int * );
 static void MakeInvertable( double **, int, double *, int * );
 static void MarkCard( AstFitsChan *, int * );
 static void NewCard( AstFitsChan *, const char *, int, const void *, const char *, int, int * );
+static void OrderCard( AstFitsChan *, FitsCard *, int * );
 static void PreQuote( const char *, char [ AST__FITSCHAN_FITSCARDLEN - FITSNAMLEN - 3 ], int * );
 static void PurgeWCS( AstFitsChan *, int * );
 static void PutCards( AstFitsChan *, const char *, int * );
@@ -7728,6 +7741,7 @@ static void DeleteCard( AstFitsChan *this, const char *method,
 */
 
 /* Local Variables: */
+   AstErrorContext error_context;/* Info about the current error context */
    FitsCard *card;            /* Pointer to the current card */
    FitsCard *next;            /* Pointer to next card in list */
    FitsCard *prev;            /* Pointer to previous card in list */
@@ -7738,8 +7752,12 @@ static void DeleteCard( AstFitsChan *this, const char *method,
 /* Get a pointer to the card to be deleted (the current card). */
    card = (FitsCard *) this->card;
 
-/* Remove it from the KeyMap holding all keywords. */
-   astMapRemove( this->keywords, card->name );
+/* Remove it from the keyword and prefix indices. This is done in a new
+   error reporting context so that the indices are left consistent with
+   the list of cards even if an error has already occurred. */
+   astErrorBegin( &error_context );
+   IndexCard( this, card, 0, status );
+   astErrorEnd( &error_context );
 
 /* Move the current card on to the next card. */
    MoveCard( this, 1, method, class, status );
@@ -8877,8 +8895,9 @@ f     Unlike AST_WRITEFITS,
    used by each of them. */
    if( this->keyseq ) this->keyseq = astAnnul( this->keyseq );
 
-/* Delete the KeyMap holding the keyword names. */
+/* Delete the KeyMaps holding the keyword and prefix indices. */
    if( this->keywords ) this->keywords = astAnnul( this->keywords );
+   if( this->prefixes ) this->prefixes = astAnnul( this->prefixes );
 
 /* Free any memory used to hold the Warnings attribute value. */
    this->warnings = astFree( this->warnings );
@@ -11503,6 +11522,7 @@ static int GetObjSize( AstObject *this_object, int *status ) {
    result += astTSizeOf( this->warnings );
    result += astGetObjSize( this->keyseq );
    result += astGetObjSize( this->keywords );
+   result += astGetObjSize( this->prefixes );
    result += astGetObjSize( this->tables );
    card = (FitsCard *) ( this->head );
    while( card ) {
@@ -13556,11 +13576,17 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
 */
 
 /* Local Variables: */
+   astDECLARE_GLOBALS     /* Declare the thread specific global data */
+   AstKeyMap *km;         /* KeyMap holding the index to use */
+   FitsCard *card;        /* Current card in index entry */
+   FitsCard *head;        /* First card in index entry */
+   char key[ FITSNAMLEN + 1 ]; /* Index key for the filter */
    const char *class;     /* Object class */
    const char *method;    /* Method name */
    int *fields;           /* Pointer to array of field values */
    int i;                 /* Field index */
    int icard;             /* Index of current card on entry */
+   int iindex;            /* Index of index to use */
    int nmatch;            /* No. of matching cards */
    int nf;                /* No. of integer fields in the filter */
    int nfld;              /* No. of integer fields in current keyword name */
@@ -13594,12 +13620,19 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
    each matching keyword. */
    fields = (int *) astMalloc( sizeof( int )*(size_t) nf );
 
-/* Save the current card index, and rewind the FitsChan. */
-   icard = astGetCard( this );
-   astClearCard( this );
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
+
+/* See if the keywords that match the filter all have a known name, or
+   all start with the same known prefix. If so, we can use the
+   corresponding index to check only those cards that could match the
+   filter. */
+   iindex = IndexKey( filter, 1, key, status );
+   km = ( iindex == KEYWORD_INDEX ) ? this->keywords : this->prefixes;
+   if( iindex == -1 ) km = NULL;
 
 /* Check that the FitsChan is not empty and the pointer can be used. */
-   if( !astFitsEof( this ) && astOK ){
+   if( this->head && astOK ){
 
 /* Initialise the returned bounds. Any excess elements in the array are left
    at the previously initialised values. */
@@ -13611,13 +13644,27 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
 /* Initialise the number of matching keywords. */
       nmatch = 0;
 
-/* Loop round all the cards in the FitsChan. */
-      while( !astFitsEof( this ) && astOK ){
+/* If an index can be used, get the first card in the index entry. If
+   not, save the current card index, and rewind the FitsChan. */
+      if( km ) {
+         if( !astMapGet0P( km, key, (void **) &head ) ) head = NULL;
+         card = head;
+         icard = 0;
+      } else {
+         head = NULL;
+         icard = astGetCard( this );
+         astClearCard( this );
+         card = (FitsCard *) this->card;
+      }
+
+/* Loop round all the cards in the index entry or FitsChan, ignoring any
+   cards that have been used. */
+      while( card && astOK ){
 
 /* If the current keyword name matches the filter, update the returned
    bounds and increment the number of matches. */
-         if( Match( CardName( this, status ), filter, nf, fields, &nfld,
-                    method, class, status ) ){
+         if( !CARDUSED( card ) && Match( card->name, filter, nf, fields,
+                                         &nfld, method, class, status ) ){
             for( i = 0; i < nf; i++ ){
                if( fields[ i ] > ubnd[ i ] ) ubnd[ i ] = fields[ i ];
                if( fields[ i ] < lbnd[ i ] ) lbnd[ i ] = fields[ i ];
@@ -13626,7 +13673,13 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
          }
 
 /* Move on to the next card. */
-         MoveCard( this, 1, method, class, status );
+         if( km ) {
+            card = card->inext[ iindex ];
+            if( card == head ) card = NULL;
+         } else {
+            MoveCard( this, 1, method, class, status );
+            card = (FitsCard *) this->card;
+         }
       }
 
 /* If bounds were not found, returned 0 and -1. */
@@ -13636,10 +13689,11 @@ static int KeyFields( AstFitsChan *this, const char *filter, int maxfld,
             ubnd[ i ] = -1;
          }
       }
-   }
 
-/* Reinstate the original current card index. */
-   astSetCard( this, icard );
+/* Reinstate the original current card index if the FitsChan was
+   searched. */
+      if( !km ) astSetCard( this, icard );
+   }
 
 /* Free the memory used to hold the integer field values extracted from
    each matching keyword. */
@@ -13931,27 +13985,89 @@ static int FindKeyCard( AstFitsChan *this, const char *name,
 */
 
 /* Local Variables: */
+   astDECLARE_GLOBALS    /* Declare the thread specific global data */
+   AstKeyMap *km;        /* KeyMap holding the index to use */
+   FitsCard *card;       /* The original current card */
+   FitsCard *head;       /* First card in the index entry */
+   FitsCard *next;       /* Next card to check */
+   char cardkey[ FITSNAMLEN + 1 ]; /* Index key for the current card */
+   char key[ FITSNAMLEN + 1 ]; /* Index key for the supplied template */
+   int iindex;           /* Index of index to use */
    int nfld;             /* Number of fields in keyword template */
    int ret;              /* Was a card found? */
 
 /* Check the global status, and supplied keyword name. */
    if( !astOK || !name ) return 0;
 
+/* Get a pointer to the structure holding thread-specific global data. */
+   astGET_GLOBALS(this);
+
 /* Indicate that no card has been found yet. */
    ret = 0;
 
-/* Search forward through the list until all cards have been checked. */
-   while( !astFitsEof( this ) && astOK ){
+/* See if the keywords that match the template all have a known name, or
+   all start with the same known prefix. If so, use the corresponding index
+   to check only those cards that could match the template. Otherwise, we
+   need to check every remaining card. */
+   iindex = IndexKey( name, 1, key, status );
+   km = ( iindex == KEYWORD_INDEX ) ? this->keywords : this->prefixes;
+   if( iindex != -1 && km && !astFitsEof( this ) ) {
+
+/* The current card is always checked first, even if it has been used. */
+      card = (FitsCard *) this->card;
+      if( Match( card->name, name, 0, NULL, &nfld, method, class, status ) ){
+         ret = 1;
+
+/* Otherwise, get the first card in the index entry. */
+      } else {
+         if( !astMapGet0P( km, key, (void **) &head ) ) head = NULL;
+
+/* If the current card is in the same entry, start checking at the
+   following card in the entry. Otherwise start at the first card. */
+         next = head;
+         if( head && iindex == PREFIX_INDEX ) {
+            (void) IndexKey( card->name, 0, cardkey, status );
+            if( !strcmp( cardkey, key ) ) {
+               next = card->inext[ iindex ];
+               if( next == head ) next = NULL;
+            }
+         }
+
+/* The cards in each index entry are in the same order as in the FitsChan.
+   Find the first card that is beyond the current card, has not been
+   used and matches the template. */
+         while( next && astOK ) {
+            if( next->order > card->order && !CARDUSED( next ) &&
+                ( iindex == KEYWORD_INDEX ||
+                  Match( next->name, name, 0, NULL, &nfld, method, class,
+                         status ) ) ) {
+               ret = 1;
+               break;
+            }
+            next = next->inext[ iindex ];
+            if( next == head ) next = NULL;
+         }
+
+/* Make the card found above the current card. If no card was found,
+   the FitsChan is left at end-of-file. */
+         this->card = (void *) next;
+      }
+
+/* Otherwise, search forward through the list until all cards have been
+   checked. */
+   } else {
+      while( !astFitsEof( this ) && astOK ){
 
 /* Break out of the loop if the keyword name from the current card matches
    the supplied keyword name. */
-      if( Match( CardName( this, status ), name, 0, NULL, &nfld, method, class, status ) ){
-         ret = 1;
-         break;
+         if( Match( CardName( this, status ), name, 0, NULL, &nfld, method, class, status ) ){
+            ret = 1;
+            break;
 
 /* Otherwise, move the current card on to the next card. */
-      } else {
-         MoveCard( this, 1, method, class, status );
+         } else {
+            MoveCard( this, 1, method, class, status );
+         }
       }
    }
 
@@ -17721,6 +17837,214 @@ void astInitFitsChanVtab_(  AstFitsChanVtab *vtab, const char *name, int *status
    }
 }
 
+static void IndexCard( AstFitsChan *this, FitsCard *card, int add,
+                       int *status ){
+/*
+*  Name:
+*     IndexCard
+
+*  Purpose:
+*     Add a card to, or remove a card from, the indices of a FitsChan.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     void IndexCard( AstFitsChan *this, FitsCard *card, int add,
+*                     int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     A FitsChan has two indices which are used to find cards quickly.
+*     The "keywords" KeyMap has an entry for each keyword name, and the
+*     "prefixes" KeyMap has an entry for each distinct set of leading
+*     characters (the first FITSPREFIXLEN characters of the keyword name).
+*     Each entry holds a pointer to the first card in a circular list
+*     of all the cards that share the keyword name or prefix. These lists
+*     are linked using the "inext" and "iprev" components of each card,
+*     and are kept in the same order as the main list of cards.
+*
+*     This function adds the supplied card to the appropriate list in each
+*     index, or removes it.
+
+*  Parameters:
+*     this
+*        Pointer to the FitsChan.
+*     card
+*        Pointer to the card. When adding a card, it should already have
+*        been inserted into the main list of cards, and its "order" value
+*        should have been set (see OrderCard).
+*     add
+*        If non-zero, add the card to the indices. Otherwise, remove it.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstKeyMap *km;             /* KeyMap holding the current index */
+   FitsCard *head;            /* First card in the index entry */
+   FitsCard *prev;            /* Card that will precede the supplied card */
+   char key[ FITSNAMLEN + 1 ];/* Index key */
+   int iindex;                /* Index of current index */
+
+/* Check the global status. */
+   if( !astOK ) return;
+
+/* Loop round the two indices. */
+   for( iindex = 0; iindex < 2; iindex++ ) {
+      if( iindex == KEYWORD_INDEX ) {
+         km = this->keywords;
+         strcpy( key, card->name );
+      } else {
+         km = this->prefixes;
+         (void) IndexKey( card->name, 0, key, status );
+      }
+      if( !km ) continue;
+
+/* Get the first card in the index entry. */
+      if( !astMapGet0P( km, key, (void **) &head ) ) head = NULL;
+
+/* If adding the card to an empty entry, create a new list holding just
+   the supplied card. */
+      if( add ) {
+         if( !head ) {
+            card->inext[ iindex ] = card;
+            card->iprev[ iindex ] = card;
+            astMapPut0P( km, key, card, NULL );
+
+/* Otherwise, search backwards from the last card in the list to find
+   the card that precedes the supplied card in the FitsChan. Cards are
+   usually appended to the end of a FitsChan, so this will normally be
+   the last card. */
+         } else {
+            prev = head->iprev[ iindex ];
+            while( prev->order > card->order && prev != head ) {
+               prev = prev->iprev[ iindex ];
+            }
+
+/* If the supplied card precedes all the cards in the list, it becomes
+   the new first card. */
+            if( prev->order > card->order ) {
+               prev = head->iprev[ iindex ];
+               astMapPut0P( km, key, card, NULL );
+            }
+
+/* Insert the supplied card into the list following "prev". */
+            card->iprev[ iindex ] = prev;
+            card->inext[ iindex ] = prev->inext[ iindex ];
+            prev->inext[ iindex ]->iprev[ iindex ] = card;
+            prev->inext[ iindex ] = card;
+         }
+
+/* If removing the card, remove the index entry if the card is the only
+   card in the list. */
+      } else if( card->inext[ iindex ] == card ) {
+         astMapRemove( km, key );
+
+/* Otherwise, remove the card from the list, and store a new first card if
+   required. */
+      } else {
+         card->iprev[ iindex ]->inext[ iindex ] = card->inext[ iindex ];
+         card->inext[ iindex ]->iprev[ iindex ] = card->iprev[ iindex ];
+         if( head == card ) astMapPut0P( km, key, card->inext[ iindex ], NULL );
+      }
+   }
+}
+
+static int IndexKey( const char *name, int template, char *key,
+                     int *status ){
+/*
+*  Name:
+*     IndexKey
+
+*  Purpose:
+*     Get the key used to find a keyword or template in a FitsChan index.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     int IndexKey( const char *name, int template, char *key,
+*                   int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     If "name" is a keyword name, this function returns the key for the
+*     entry in the "prefixes" index of a FitsChan that includes the keyword
+*     (see IndexCard).
+*
+*     If "name" is a keyword template (see Match), this function determines
+*     which index can be used to find the keywords that match the template.
+*     If the template contains no fields, the "keywords" index is used.
+*     If it contains fields but the first FITSPREFIXLEN characters are
+*     fixed, the "prefixes" index is used. Otherwise, no index can be used.
+
+*  Parameters:
+*     name
+*        Pointer to a string holding the keyword name or template.
+*     template
+*        Non-zero if "name" is a keyword template, and zero if it is
+*        a keyword name.
+*     key
+*        Pointer to a buffer with room for at least FITSNAMLEN + 1
+*        characters, in which to return the upper case key. Unchanged if
+*        no index can be used.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     KEYWORD_INDEX or PREFIX_INDEX, indicating the index to use, or -1
+*     if no index can be used.
+*/
+
+/* Local Variables: */
+   int i;                     /* Character index */
+   int nc;                    /* Number of fixed characters */
+   int result;                /* Returned value */
+
+/* Check the global status. */
+   if( !astOK ) return -1;
+
+/* Find the number of fixed characters at the start of the name. */
+   nc = 0;
+   if( template ) {
+      while( name[ nc ] && name[ nc ] != '%' ) nc++;
+   } else {
+      nc = strlen( name );
+   }
+
+/* A template with no fields uses the keywords index, unless it is blank
+   or too long to match any keyword. */
+   if( template && !name[ nc ] ) {
+      result = ( nc > 0 && nc <= FITSNAMLEN ) ? KEYWORD_INDEX : -1;
+
+/* Keyword names, and templates that start with enough fixed characters,
+   use the prefixes index. */
+   } else if( !template || nc >= FITSPREFIXLEN ) {
+      result = PREFIX_INDEX;
+      if( nc > FITSPREFIXLEN ) nc = FITSPREFIXLEN;
+
+/* Other templates cannot use either index. */
+   } else {
+      result = -1;
+   }
+
+/* Return the key as upper case. */
+   if( result != -1 ) {
+      for( i = 0; i < nc; i++ ) key[ i ] = toupper( (int) name[ i ] );
+      key[ nc ] = 0;
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static void InsCard( AstFitsChan *this, int overwrite, const char *name,
                      int type, void *data, const char *comment,
                      const char *method, const char *class, int *status ){
@@ -21375,6 +21699,7 @@ static int ManageLock( AstObject *this_object, int mode, int extra,
    the supplied Object. */
    if( !result ) result = astManageLock( this->keyseq, mode, extra, fail );
    if( !result ) result = astManageLock( this->keywords, mode, extra, fail );
+   if( !result ) result = astManageLock( this->prefixes, mode, extra, fail );
    return result;
 }
 #endif
@@ -22251,13 +22576,10 @@ static void NewCard( AstFitsChan *this, const char *name, int type,
       while( *a ) *(b++) = (char) toupper( (int) *(a++) );
       *b = 0;
 
-/* Ensure that a KeyMap exists to hold the keywords currently in the
+/* Ensure that KeyMaps exist to index the cards currently in the
    FitsChan. */
       if( !this->keywords ) this->keywords = astKeyMap( " ", status );
-
-/* Add the keyword name to the KeyMap. The value associated with the
-   KeyMap entry is not used and is set arbitrarily to zero. */
-      astMapPut0I( this->keywords, new->name, 0, NULL );
+      if( !this->prefixes ) this->prefixes = astKeyMap( " ", status );
 
 /* Copy the data type. */
       new->type = type;
@@ -22368,6 +22690,10 @@ static void NewCard( AstFitsChan *this, const char *name, int type,
             this->card = NULL;
          }
       }
+
+/* Record the position of the new card, and add it to the indices. */
+      OrderCard( this, new, status );
+      IndexCard( this, new, 1, status );
    }
 
 /* Return. */
@@ -22915,6 +23241,79 @@ static double **OrthVectorSet( int n, int m, double **in, int *status ){
    return ret;
 }
 
+static void OrderCard( AstFitsChan *this, FitsCard *card, int *status ){
+/*
+*  Name:
+*     OrderCard
+
+*  Purpose:
+*     Assign an order value to a newly inserted card.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "fitschan.h"
+*     void OrderCard( AstFitsChan *this, FitsCard *card, int *status )
+
+*  Class Membership:
+*     FitsChan member function.
+
+*  Description:
+*     Each card in a FitsChan holds an "order" value which increases
+*     along the list of cards. This allows the relative positions of two
+*     cards to be compared without searching the list. This function
+*     stores an order value for a card that has just been inserted into
+*     the list, half way between the values of the neighbouring cards.
+*     If there is no room left between the neighbouring values, all the
+*     cards in the list are given new order values.
+
+*  Parameters:
+*     this
+*        Pointer to the FitsChan.
+*     card
+*        Pointer to the card, which should already be in the list.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   FitsCard *head;            /* First card in the list */
+   FitsCard *next;            /* Card being renumbered */
+   double order;              /* Next order value */
+
+/* Check the global status. */
+   if( !astOK ) return;
+
+/* Cards at the start or end of the list are given a value one less than
+   the following card, or one more than the preceding card. */
+   head = (FitsCard *) this->head;
+   if( card->next == card ) {
+      card->order = 0.0;
+
+   } else if( card == head ) {
+      card->order = card->next->order - 1.0;
+
+   } else if( card->next == head ) {
+      card->order = card->prev->order + 1.0;
+
+/* Other cards are given a value mid way between the neighbouring cards.
+   If this is not possible, renumber the whole list. */
+   } else {
+      card->order = 0.5*( card->prev->order + card->next->order );
+      if( card->order <= card->prev->order ||
+          card->order >= card->next->order ) {
+         order = 0.0;
+         next = head;
+         do {
+            next->order = order;
+            order += 1.0;
+            next = next->next;
+         } while( next != head );
+      }
+   }
+}
+
 static AstMapping *OtherAxes( AstFitsChan *this, AstFrameSet *fs, double *dim,
                               int *wperm, char s, FitsStore *store,
                               double *crvals, int *axis_done,
@@ -40848,6 +41247,7 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    out->head = NULL;
    out->keyseq = NULL;
    out->keywords = NULL;
+   out->prefixes = NULL;
    out->source = NULL;
    out->saved_source = NULL;
    out->source_wrap = NULL;
@@ -41907,6 +42307,7 @@ AstFitsChan *astInitFitsChan_( void *mem, size_t size, int init,
       new->card = NULL;
       new->keyseq = NULL;
       new->keywords = NULL;
+      new->prefixes = NULL;
       new->defb1950 = -1;
       new->tabok = -INT_MAX;
       new->cdmatrix = -1;
@@ -42074,6 +42475,7 @@ AstFitsChan *astLoadFitsChan_( void *mem, size_t size,
 
 /* Initialise the KeyMap holding the keywords in the FitsChan. */
       new->keywords = NULL;
+      new->prefixes = NULL;
 
 /* Initialise the list of keyword sequence numbers. */
       new->keyseq = NULL;
@@ -103,6 +103,8 @@
 *        Added Clean attribute.
 *     19-MAR-2004 (DSB):
 *        Added astPutCards function.
+*     16-OCT-2026 (DSB):
+*        Added "prefixes" KeyMap to the FitsChan structure.
 *-
 */
 
@@ -185,7 +187,8 @@ typedef struct AstFitsChan {
    void *card;      /* Pointer to next FitsCard to be read */
    void *head;      /* Pointer to first FitsCard in the circular linked list */
    AstKeyMap *keyseq;   /* List of keyword sequence numbers used */
-   AstKeyMap *keywords; /* A KeyMap holding the keywords in the FitsChan */
+   AstKeyMap *keywords; /* A KeyMap holding the first card for each keyword */
+   AstKeyMap *prefixes; /* A KeyMap holding the first card for each prefix */
    AstKeyMap *tables;   /* A KeyMap holding the binary tables in the FitsChan */
 
    const char *(* source)( void ); /* Pointer to source function */
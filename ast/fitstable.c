@@ -82,6 +82,10 @@ f     - AST_PUTTABLEHEADER: Store FITS headers within a FitsTable
 *        Original version.
 *     2-OCT-2012 (DSB):
 *        Check for Infs as well as NaNs.
+*     16-OCT-2026 (DSB):
+*        Use astGetColumnValues and astPutColumnValues to copy numerical
+*        columns in a single operation. Also, test float columns for NaNs
+*        using float rather than double pointers.
 *class--
 */
 
@@ -1231,6 +1235,7 @@ f     AST_COLUMNNULL functiom.
    int nel;          /* No. of elements per value */
    int nrow;         /* No. of values to copy */
    int nval;         /* Number of values read from KeyMap entry */
+   unsigned char *defined; /* Flags indicating which rows have values */
    int ok;           /* Was the value found in the KeyMap? */
    int type;         /* Data type */
    int wasset;       /* Was the integer null value set explicitly? */
@@ -1308,21 +1313,29 @@ f     AST_COLUMNNULL functiom.
    small to hold all rows. */
    if( mxsize < nbv*nrow ) nrow = mxsize/nbv;
 
-/* Loop round the returned rows rows. */
-   for( irow = 1; irow <= nrow; irow++ ) {
+/* Numerical columns are copied into the returned array in a single
+   operation, together with a flag for each row indicating if the cell
+   has a value. Only the empty cells and NaN values then need to be
+   handled individually. */
+   if( type != AST__STRINGTYPE && nrow > 0 ) {
+      defined = astMalloc( nrow );
+      if( astOK ) (void) astGetColumnValues( this, column, nrow, coldata,
+                                             defined );
+   } else {
+      defined = NULL;
+   }
 
-/* Format the cell name. */
-      (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
-                      status );
+/* Loop round the returned rows rows. */
+   for( irow = 1; irow <= nrow && astOK; irow++ ) {
 
-/* Get the values in the current cell of the column, using its native
-   data type. For floating point, convert any NaNs into the appropriate
-   null value (do not need to do this if the null value is itself NaN). */
+/* See if the current cell has a value. For floating point, convert any
+   NaNs into the appropriate null value (do not need to do this if the
+   null value is itself NaN). */
       if( type == AST__INTTYPE ) {
-         ok = astMapGet1I( this, key, nel, &nval, pout );
+         ok = defined[ irow - 1 ];
 
       } else if(  type == AST__DOUBLETYPE ){
-         ok = astMapGet1D( this, key, nel, &nval, pout );
+         ok = defined[ irow - 1 ];
 
          if( ok && astISFINITE(dnull) ) {
             for( iel = 0; iel < nel; iel++ ) {
@@ -1333,7 +1346,7 @@ f     AST_COLUMNNULL functiom.
          }
 
       } else if(  type == AST__FLOATTYPE ){
-         ok = astMapGet1F( this, key, nel, &nval, pout );
+         ok = defined[ irow - 1 ];
 
          if( ok && astISFINITE(fnull) ) {
             for( iel = 0; iel < nel; iel++ ) {
@@ -1344,12 +1357,15 @@ f     AST_COLUMNNULL functiom.
          }
 
       } else if(  type == AST__SINTTYPE ){
-         ok = astMapGet1S( this, key, nel, &nval, pout );
+         ok = defined[ irow - 1 ];
 
       } else if(  type == AST__BYTETYPE ){
-         ok = astMapGet1B( this, key, nel, &nval, pout );
+         ok = defined[ irow - 1 ];
 
+/* String values are read from each cell in turn. */
       } else if(  type == AST__STRINGTYPE ){
+         (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
+                         status );
          ok = astMapGet1C( this, key, nb + 1, nel, &nval, cbuf );
 
 /* Copy the strings returned by astMapGet1C into the returned array,
@@ -1409,6 +1425,7 @@ f     AST_COLUMNNULL functiom.
 
 /* Free resources. */
    cbuf = astFree( cbuf );
+   defined = astFree( defined );
    pnull = astFree( pnull );
 
 /* Return the number of returned elements. */
@@ -1950,6 +1967,7 @@ f        The global status.
    int type;         /* Data type */
    size_t nb;        /* No. of bytes for a single element of a value */
    size_t nbv;       /* No. of bytes per value */
+   unsigned char *defined; /* Flags indicating which rows have values */
    void *pin;        /* Pointer to next input array element */
 
 /* Check the global error status. */
@@ -2008,59 +2026,62 @@ f        The global status.
                 (int) size, (int) nbv );
    }
 
-/* Loop round the rows to be copied. */
-   for( irow = 1; irow <= nrow; irow++ ) {
-
-/* Format the cell name. */
-      (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
-                      status );
-
-/* Put the next value into the current cell of the column, using its native
-   data type. Skip floating point values that are entirely NaN. */
-      if( type == AST__INTTYPE ) {
-         astMapPut1I( this, key, nel, pin, NULL );
+/* Numerical columns are stored in a single operation. Cells holding
+   floating point values that are entirely NaN are left empty. */
+   if( type != AST__STRINGTYPE ) {
+      defined = astMalloc( nrow );
+      if( astOK ) {
+         for( irow = 0; irow < nrow; irow++ ) {
+            defined[ irow ] = 1;
+
+            if( type == AST__DOUBLETYPE ) {
+               defined[ irow ] = 0;
+               for( iel = 0; iel < nel; iel++ ) {
+                  if( astISFINITE( ((double *)pin)[ iel ] ) ) {
+                     defined[ irow ] = 1;
+                     break;
+                  }
+               }
 
-      } else if(  type == AST__DOUBLETYPE ){
-         for( iel = 0; iel < nel; iel++ ) {
-            if( astISFINITE( ((double *)pin)[ iel ] ) ) {
-               astMapPut1D( this, key, nel, pin, NULL );
-               break;
+            } else if( type == AST__FLOATTYPE ) {
+               defined[ irow ] = 0;
+               for( iel = 0; iel < nel; iel++ ) {
+                  if( astISFINITE( ((float *)pin)[ iel ] ) ) {
+                     defined[ irow ] = 1;
+                     break;
+                  }
+               }
             }
-         }
 
-      } else if(  type == AST__FLOATTYPE ){
-         for( iel = 0; iel < nel; iel++ ) {
-            if( astISFINITE( ((double *)pin)[ iel ] ) ) {
-               astMapPut1F( this, key, nel, pin, NULL );
-               break;
-            }
+            pin += nbv;
          }
 
-      } else if(  type == AST__SINTTYPE ){
-         astMapPut1S( this, key, nel, pin, NULL );
-
-      } else if(  type == AST__BYTETYPE ){
-         astMapPut1B( this, key, nel, pin, NULL );
+/* This also empties any remaining cells already present in the column. */
+         astPutColumnValues( this, column, nrow, coldata, defined );
+      }
+      defined = astFree( defined );
 
-/* If each cell in the column holds an array of strings, we need to
-   convert the fixed length strings in the supplied array into an array
-   of pointers to null terminated strings. */
-      } else if(  type == AST__STRINGTYPE ){
+/* String columns are stored a cell at a time. If each cell in the column
+   holds an array of strings, we need to convert the fixed length strings
+   in the supplied array into an array of pointers to null terminated
+   strings. */
+   } else {
+      for( irow = 1; irow <= nrow; irow++ ) {
+         (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
+                         status );
          carray = astStringArray( pin, nel, clen );
          astMapPut1C( this, key, nel, (const char ** ) carray, NULL );
          carray = astFree( carray );
+         pin += nbv;
       }
 
-/* Increment the pointer to the next input value. */
-      pin += nbv;
-   }
-
 /* Remove any remaining cells already present in this column. */
-   nrow = astGetNrow( this );
-   for( ; irow <= nrow; irow++ ) {
-      (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
-                      status );
-      astMapRemove( this, key );
+      nrow = astGetNrow( this );
+      for( ; irow <= nrow; irow++ ) {
+         (void) MakeKey( column, irow, key, AST__MXCOLKEYLEN + 1,
+                         status );
+         astMapRemove( this, key );
+      }
    }
 }
 
@@ -285,6 +285,9 @@ f     - AST_UNFORMAT: Read a formatted coordinate value for a Frame axis
 *        Added astCentre.
 *     27-APR-2015 (DSB):
 *        Added read-only attribute InternalUnit.
+*     16-OCT-2026 (DSB):
+*        Declare typed access functions for the Naxes, Epoch, System,
+*        ObsAlt and Dut1 attributes.
 *class--
 */
 
@@ -712,6 +715,7 @@ int astTest##attribute##_( AstFrame *this, int axis, int *status ) { \
 #include <math.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* Module Variables. */
@@ -5815,6 +5819,154 @@ static AstFrameSet *GetFrameVariants( AstFrame *this, int *status ){
    return result;
 }
 
+/* Typed access functions for the attributes declared in
+   astInitFrameVtab. */
+astMAKE_ATTRIBGET(Frame,Naxes,int)
+astMAKE_ATTRIBTEST(Frame,Epoch)
+astMAKE_ATTRIBCLEAR(Frame,Epoch)
+astMAKE_ATTRIBTEST(Frame,System)
+astMAKE_ATTRIBCLEAR(Frame,System)
+astMAKE_ATTRIBGET(Frame,ObsAlt,double)
+astMAKE_ATTRIBSET(Frame,ObsAlt,double)
+astMAKE_ATTRIBTEST(Frame,ObsAlt)
+astMAKE_ATTRIBCLEAR(Frame,ObsAlt)
+astMAKE_ATTRIBGET(Frame,Dut1,double)
+astMAKE_ATTRIBSET(Frame,Dut1,double)
+astMAKE_ATTRIBTEST(Frame,Dut1)
+astMAKE_ATTRIBCLEAR(Frame,Dut1)
+
+static double GetEpochAttrib( AstObject *this_object, int *status ) {
+/*
+*  Name:
+*     GetEpochAttrib
+
+*  Purpose:
+*     Get the Epoch attribute of a Frame as a double.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "frame.h"
+*     double GetEpochAttrib( AstObject *this, int *status )
+
+*  Class Membership:
+*     Frame member function.
+
+*  Description:
+*     This function returns the value that astGetD would obtain by
+*     reading the formatted Epoch value returned by astGetAttrib (i.e. a
+*     Besselian or Julian epoch in decimal years), without formatting
+*     all other attributes as strings first.
+
+*  Parameters:
+*     this
+*        Pointer to the Frame.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The Epoch value in decimal years.
+
+*  Notes:
+*     - A value of AST__BAD will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   const char *text;             /* Formatted epoch */
+   double epoch;                 /* Epoch as a Modified Julian Date */
+   double result;                /* Returned value */
+
+/* Initialise. */
+   result = AST__BAD;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get the Epoch and format it in the same way as astGetAttrib, so that
+   both interfaces return the same rounded value. */
+   epoch = astGetEpoch( (AstFrame *) this_object );
+   if ( astOK ) {
+      text = astFmtDecimalYr( ( epoch < palEpj2d( 1984.0 ) ) ?
+                              palEpb( epoch ) : palEpj( epoch ), DBL_DIG );
+      if ( astOK && text ) result = strtod( text, NULL );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static const char *GetSystemAttrib( AstObject *this_object, int *status ) {
+/*
+*  Name:
+*     GetSystemAttrib
+
+*  Purpose:
+*     Get the System attribute of a Frame as a string.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "frame.h"
+*     const char *GetSystemAttrib( AstObject *this, int *status )
+
+*  Class Membership:
+*     Frame member function.
+
+*  Description:
+*     This function returns the System attribute of a Frame as a string,
+*     without going through the chain of attribute name comparisons in
+*     astGetAttrib.
+
+*  Parameters:
+*     this
+*        Pointer to the Frame.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to a constant null-terminated string holding the System
+*     value.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   AstFrame *this;               /* Pointer to the Frame structure */
+   AstSystemType system;         /* System code */
+   const char *result;           /* Returned pointer */
+
+/* Initialise. */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Obtain the System code and convert to a string. */
+   this = (AstFrame *) this_object;
+   system = astGetSystem( this );
+   if ( astOK ) {
+      result = astSystemString( this, system );
+
+/* Report an error if the value was not recognised. */
+      if ( !result ) {
+         astError( AST__SCSIN,
+                  "astGetAttrib(%s): Corrupt %s contains invalid "
+                  "System identification code (%d).", status,
+                  astGetClass( this ), astGetClass( this ), (int) system );
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
 void astInitFrameVtab_(  AstFrameVtab *vtab, const char *name, int *status ) {
 /*
 *+
@@ -6076,6 +6228,18 @@ void astInitFrameVtab_(  AstFrameVtab *vtab, const char *name, int *status ) {
    astSetDelete( vtab, Delete );
    astSetDump( vtab, Dump, "Frame", "Coordinate system description" );
 
+/* Declare typed access functions for attributes that can be used
+   without formatting or parsing a string. */
+   astDeclareAttribI( vtab, "naxes", GetNaxesAttrib, NULL, NULL, NULL );
+   astDeclareAttribD( vtab, "epoch", GetEpochAttrib, NULL, TestEpochAttrib,
+                      ClearEpochAttrib );
+   astDeclareAttribC( vtab, "system", GetSystemAttrib, TestSystemAttrib,
+                      ClearSystemAttrib );
+   astDeclareAttribD( vtab, "obsalt", GetObsAltAttrib, SetObsAltAttrib,
+                      TestObsAltAttrib, ClearObsAltAttrib );
+   astDeclareAttribD( vtab, "dut1", GetDut1Attrib, SetDut1Attrib,
+                      TestDut1Attrib, ClearDut1Attrib );
+
 /* If we have just initialised the vtab for the current class, indicate
    that the vtab is now initialised, and store a pointer to the class
    identifier in the base "object" level of the vtab. */
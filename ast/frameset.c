@@ -264,6 +264,9 @@ f     - AST_REMOVEFRAME: Remove a Frame from a FrameSet
 *        frame, rather than just cloning their pointers. So the modified
 *        FrameSet is now independent of the supplied Mapping and Frame
 *        objects.
+*     16-OCT-2026 (DSB):
+*        Retain only the inherited typed attribute access functions for
+*        attributes that are not forwarded to the current Frame.
 *class--
 */
 
@@ -6008,6 +6011,11 @@ void astInitFrameSetVtab_(  AstFrameSetVtab *vtab, const char *name, int *status
    astSetDump( vtab, Dump, "FrameSet",
                "Set of inter-related coordinate systems" );
 
+/* Most attributes of a FrameSet are obtained from the current Frame
+   rather than from the FrameSet itself, so only retain the inherited typed
+   access functions for attributes that are handled locally. */
+   astForwardAttribs( vtab, "nin,nobject,nout,refcount,tranforward,traninverse" );
+
 /* If we have just initialised the vtab for the current class, indicate
    that the vtab is now initialised, and store a pointer to the class
    identifier in the base "object" level of the vtab. */
@@ -37,9 +37,35 @@
 static int nthread = 0;
 static pthread_mutex_t nthread_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+/* A list of the thread-specific data structures released by threads
+   that have exited, waiting to be re-used by new threads (see
+   ThreadExit). The list is linked through the "next_unused" component
+   and is guarded by nthread_mutex. */
+static AstGlobals *unused_globals = NULL;
+
+#if defined( AST__THREAD_LOCAL )
+
+/* A pthreads key that is used only to arrange for ThreadExit to be
+   invoked when each thread that has used AST exits (thread-local
+   variables have no destructors). Its value for each thread is a pointer
+   to the thread's global data. */
+static pthread_key_t exit_key;
+static pthread_once_t exit_key_created = PTHREAD_ONCE_INIT;
+
+#endif
+
 /* External variables visible throughout AST */
 /* ========================================= */
 
+#if defined( AST__THREAD_LOCAL )
+
+/* Declare the thread-local pointers to the thread-specific data and
+   status value for each thread. */
+AST__THREAD_LOCAL AstGlobals *starlink_ast_globals = NULL;
+AST__THREAD_LOCAL AstStatusBlock *starlink_ast_status_block = NULL;
+
+#else
+
 /* Set a flag indicating that the thread-specific data key has not yet
    been created. */
 pthread_once_t starlink_ast_globals_initialised = PTHREAD_ONCE_INIT;
@@ -52,11 +78,107 @@ pthread_key_t starlink_ast_globals_key;
    status value for each thread. */
 pthread_key_t starlink_ast_status_key;
 
+#endif
 
 /* Function definitions: */
 /* ===================== */
 
+static void ThreadExit( void *data ) {
+/*
+*  Name:
+*     ThreadExit
+
+*  Purpose:
+*     Release resources held by a thread that is exiting.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void ThreadExit( void *data )
+
+*  Description:
+*     This function is registered as the destructor for a pthreads
+*     thread-specific data key whose value is a pointer to the AstGlobals
+*     structure for the thread, and so is invoked when any thread that
+*     has used AST exits. It returns the thread's free object Handles to
+*     the global pool, empties the thread's memory cache and frees the
+*     thread's status value.
+*
+*     The AstGlobals structure itself cannot be freed, since Objects
+*     created by the thread refer to the virtual function tables it
+*     contains and may still be in use by other threads. Instead, it is
+*     detached from the exiting thread and added to a list of unused
+*     structures, from which astGlobalsInit re-uses it for the next new
+*     thread. The virtual function tables are not changed by re-use, so
+*     the memory held by exited threads does not grow beyond that needed
+*     by the largest number of threads that have been active at once.
+
+*  Parameters:
+*     data
+*        Pointer to the AstGlobals structure for the exiting thread.
+
+*/
+
+/* Local Variables: */
+   AstGlobals *globals;
+   AstStatusBlock *status;
+
+   globals = (AstGlobals *) data;
+   if( globals ) {
+      astFreeObjectGlobals_( &( globals->Object ) );
+      astFreeMemoryGlobals_( &( globals->Memory ) );
+
+/* Detach the global data and status value from the exiting thread, so
+   that any later use of AST by the thread (e.g. within another
+   thread-specific data destructor) creates new ones. */
+#if defined( AST__THREAD_LOCAL )
+      status = starlink_ast_status_block;
+      starlink_ast_status_block = NULL;
+      starlink_ast_globals = NULL;
+#else
+      status = pthread_getspecific( starlink_ast_status_key );
+      pthread_setspecific( starlink_ast_status_key, NULL );
+#endif
+      FREE( status );
+
+/* Add the global data to the list of unused structures. */
+      pthread_mutex_lock( &nthread_mutex );
+      globals->next_unused = unused_globals;
+      unused_globals = globals;
+      pthread_mutex_unlock( &nthread_mutex );
+   }
+}
+
+#if defined( AST__THREAD_LOCAL )
+static void CreateExitKey( void ) {
+/*
+*  Name:
+*     CreateExitKey
+
+*  Purpose:
+*     Create the thread specific data key used to detect thread exit.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void CreateExitKey( void )
 
+*  Description:
+*     This function creates the pthreads key that causes ThreadExit to
+*     be invoked when a thread exits. It is called once only by the
+*     pthread_once function.
+
+*/
+
+   if( pthread_key_create( &exit_key, ThreadExit ) ) {
+      fprintf( stderr, "ast: Failed to create Thread-Specific Data key" );
+   }
+}
+#endif
+
+#if !defined( AST__THREAD_LOCAL )
 void astGlobalsCreateKey_( void ) {
 /*
 *+
@@ -85,9 +207,10 @@ void astGlobalsCreateKey_( void ) {
 *-
 */
 
-/* Create the key used to access thread-specific global data values.
-   Report an error if it fails. */
-   if( pthread_key_create( &starlink_ast_globals_key, NULL ) ) {
+/* Create the key used to access thread-specific global data values,
+   registering a destructor that is invoked when each thread exits. Report
+   an error if it fails. */
+   if( pthread_key_create( &starlink_ast_globals_key, ThreadExit ) ) {
       fprintf( stderr, "ast: Failed to create Thread-Specific Data key" );
 
 /* If succesful, create the key used to access the thread-specific status
@@ -98,6 +221,7 @@ void astGlobalsCreateKey_( void ) {
    }
 
 }
+#endif
 
 AstGlobals *astGlobalsInit_( void ) {
 /*
@@ -131,94 +255,143 @@ AstGlobals *astGlobalsInit_( void ) {
    AstGlobals *globals;
    AstStatusBlock *status;
 
-/* Allocate memory to hold the global data values for the currently
-   executing thread. Use malloc rather than astMalloc (the AST memory
-   module uses global data managed by this module and so using astMalloc
-   could put us into an infinite loop). */
-   globals = MALLOC( sizeof( AstGlobals ) );
-
-   if ( !globals ){
-      fprintf( stderr, "ast: Failed to allocate memory to hold AST "
-               "global data values" );
-
-/* Initialise the global data values. */
-   } else {
-
-/* Each thread has a unique integer identifier. */
-      pthread_mutex_lock( &nthread_mutex );
+/* If a thread that has exited has left an unused global data structure
+   (see ThreadExit), re-use it. Each thread has a unique integer
+   identifier, so a new one is always assigned. */
+   pthread_mutex_lock( &nthread_mutex );
+   globals = unused_globals;
+   if( globals ) {
+      unused_globals = globals->next_unused;
       globals->thread_identifier = nthread++;
-      pthread_mutex_unlock( &nthread_mutex );
+   }
+   pthread_mutex_unlock( &nthread_mutex );
 
 #define INIT(class) astInit##class##Globals_( &(globals->class) );
+
+/* The virtual function tables and other class data in a re-used
+   structure are retained, since they may still be referred to by
+   Objects created by the previous owner. Only the error reporting
+   context and memory cache are re-initialised. */
+   if( globals ) {
       INIT( Error );
       INIT( Memory );
-      INIT( Object );
-      INIT( Axis );
-      INIT( Mapping );
-      INIT( Frame );
-      INIT( Channel );
-      INIT( CmpMap );
-      INIT( KeyMap );
-      INIT( FitsChan );
-      INIT( FitsTable );
-      INIT( CmpFrame );
-      INIT( DSBSpecFrame );
-      INIT( FrameSet );
-      INIT( LutMap );
-      INIT( MathMap );
-      INIT( PcdMap );
-      INIT( PointSet );
-      INIT( SkyAxis );
-      INIT( SkyFrame );
-      INIT( SlaMap );
-      INIT( SpecFrame );
-      INIT( SphMap );
-      INIT( TimeFrame );
-      INIT( WcsMap );
-      INIT( ZoomMap );
-      INIT( FluxFrame );
-      INIT( SpecFluxFrame );
-      INIT( GrismMap );
-      INIT( IntraMap );
-      INIT( Plot );
-      INIT( Plot3D );
-      INIT( Region );
-      INIT( Xml );
-      INIT( XmlChan );
-      INIT( Box );
-      INIT( Circle );
-      INIT( CmpRegion );
-      INIT( DssMap );
-      INIT( Ellipse );
-      INIT( Interval );
-      INIT( MatrixMap );
-      INIT( NormMap );
-      INIT( NullRegion );
-      INIT( PermMap );
-      INIT( PointList );
-      INIT( PolyMap );
-      INIT( Polygon );
-      INIT( Prism );
-      INIT( RateMap );
-      INIT( SelectorMap );
-      INIT( ShiftMap );
-      INIT( SpecMap );
-      INIT( Stc );
-      INIT( StcCatalogEntryLocation );
-      INIT( StcObsDataLocation );
-      INIT( SwitchMap );
-      INIT( Table );
-      INIT( TimeMap );
-      INIT( TranMap );
-      INIT( UnitMap );
-      INIT( WinMap );
-      INIT( StcResourceProfile );
-      INIT( StcSearchLocation );
-      INIT( StcsChan );
+
+/* Otherwise, allocate memory to hold the global data values for the
+   currently executing thread. Use malloc rather than astMalloc (the AST
+   memory module uses global data managed by this module and so using
+   astMalloc could put us into an infinite loop). */
+   } else {
+      globals = MALLOC( sizeof( AstGlobals ) );
+
+      if ( !globals ){
+         fprintf( stderr, "ast: Failed to allocate memory to hold AST "
+                  "global data values" );
+
+/* Initialise the global data values. */
+      } else {
+         pthread_mutex_lock( &nthread_mutex );
+         globals->thread_identifier = nthread++;
+         pthread_mutex_unlock( &nthread_mutex );
+
+         INIT( Error );
+         INIT( Memory );
+         INIT( Object );
+         INIT( Axis );
+         INIT( Mapping );
+         INIT( Frame );
+         INIT( Channel );
+         INIT( CmpMap );
+         INIT( KeyMap );
+         INIT( FitsChan );
+         INIT( FitsTable );
+         INIT( CmpFrame );
+         INIT( DSBSpecFrame );
+         INIT( FrameSet );
+         INIT( LutMap );
+         INIT( MathMap );
+         INIT( PcdMap );
+         INIT( PointSet );
+         INIT( SkyAxis );
+         INIT( SkyFrame );
+         INIT( SlaMap );
+         INIT( SpecFrame );
+         INIT( SphMap );
+         INIT( TimeFrame );
+         INIT( WcsMap );
+         INIT( ZoomMap );
+         INIT( FluxFrame );
+         INIT( SpecFluxFrame );
+         INIT( GrismMap );
+         INIT( IntraMap );
+         INIT( Plot );
+         INIT( Plot3D );
+         INIT( Region );
+         INIT( Xml );
+         INIT( XmlChan );
+         INIT( Box );
+         INIT( Circle );
+         INIT( CmpRegion );
+         INIT( DssMap );
+         INIT( Ellipse );
+         INIT( Interval );
+         INIT( MatrixMap );
+         INIT( NormMap );
+         INIT( NullRegion );
+         INIT( PermMap );
+         INIT( PointList );
+         INIT( PolyMap );
+         INIT( Polygon );
+         INIT( Prism );
+         INIT( RateMap );
+         INIT( SelectorMap );
+         INIT( ShiftMap );
+         INIT( SpecMap );
+         INIT( Stc );
+         INIT( StcCatalogEntryLocation );
+         INIT( StcObsDataLocation );
+         INIT( SwitchMap );
+         INIT( Table );
+         INIT( TimeMap );
+         INIT( TranMap );
+         INIT( UnitMap );
+         INIT( ResamplePlan );
+         INIT( WinMap );
+         INIT( StcResourceProfile );
+         INIT( StcSearchLocation );
+         INIT( StcsChan );
+      }
+   }
 #undef INIT
 
+/* Store the global data for the currently executing thread. */
+   if( globals ) {
+
+/* Save the pointer as the value of the thread-local variable. */
+#if defined( AST__THREAD_LOCAL )
+      starlink_ast_globals = globals;
+
+/* Also store it as the value of the key used to detect when the thread
+   exits. */
+      if( pthread_once( &exit_key_created, CreateExitKey ) ||
+          pthread_setspecific( exit_key, globals ) ) {
+         fprintf( stderr, "ast: Failed to store Thread-Specific Data pointer." );
+      }
+
+/* We also take this opportunity to allocate and initialise the
+   thread-specific status value, storing a pointer to it in the
+   thread-local variable. */
+      status = MALLOC( sizeof( AstStatusBlock ) );
+      if( status ) {
+         status->internal_status = 0;
+         status->status_ptr = &( status->internal_status );
+         starlink_ast_status_block = status;
+      } else {
+         fprintf( stderr, "ast: Failed to allocate memory for Thread-Specific Status pointer." );
+      }
+
 /* Save the pointer as the value of the starlink_ast_globals_key
    thread-specific data key. */
+#else
       if( pthread_setspecific( starlink_ast_globals_key, globals ) ) {
          fprintf( stderr, "ast: Failed to store Thread-Specific Data pointer." );
 
@@ -241,6 +414,7 @@ AstGlobals *astGlobalsInit_( void ) {
             fprintf( stderr, "ast: Failed to allocate memory for Thread-Specific Status pointer." );
          }
       }
+#endif
    }
 
 /* Return a pointer to the data structure holding the global data values. */
@@ -68,6 +68,7 @@
 #include "timemap.h"
 #include "tranmap.h"
 #include "unitmap.h"
+#include "resampleplan.h"
 #include "wcsmap.h"
 #include "winmap.h"
 #include "xml.h"
@@ -82,6 +83,20 @@
 /* Macros */
 /* ====== */
 
+/* Select the storage class keyword used to declare thread-local
+   variables. If the compiler supports thread-local storage, the pointers
+   to the structures holding each thread's global data and status value
+   are stored in thread-local variables, which are much faster to access
+   than pthreads thread-specific data. Otherwise (or if AST__NO_TLS is
+   defined), pthreads thread-specific data keys are used. */
+#if !defined( AST__NO_TLS ) && !defined( AST__THREAD_LOCAL )
+#if defined( __GNUC__ ) || defined( __clang__ ) || defined( __INTEL_COMPILER )
+#define AST__THREAD_LOCAL __thread
+#elif defined( __STDC_VERSION__ ) && __STDC_VERSION__ >= 201112L
+#define AST__THREAD_LOCAL _Thread_local
+#endif
+#endif
+
 /* The name of the variable used to access thread-specific global data */
 #define AST__GLOBALS ast_globals
 
@@ -99,6 +114,22 @@
    Object, or NULL. It ensures the thread-specific data key has been
    created. It also allocates and initialises memory to hold the global
    data. */
+#if defined( AST__THREAD_LOCAL )
+#define astGET_GLOBALS(This) \
+\
+/* If the supplied Object pointer contains a pointer to the thread-specific \
+   data structure, return it. */ \
+   if( This && ((AstObject *)This)->globals ) { \
+      AST__GLOBALS = ((AstObject *)This)->globals; \
+\
+/* Otherwise, use the pointer stored in the thread-local variable, creating \
+   and initialising a new structure if the current thread does not yet have \
+   one. */ \
+   } else if( ( AST__GLOBALS = starlink_ast_globals ) == NULL ) { \
+      AST__GLOBALS = astGlobalsInit_(); \
+   }
+
+#else
 #define astGET_GLOBALS(This) \
 \
 /* If the supplied Object pointer contains a pointer to the thread-specific \
@@ -123,6 +154,17 @@
                   "Data pointer." ); \
       } \
    }
+#endif
+
+/* A macro that expands to a pointer to the AstStatusBlock structure
+   holding the status value for the calling thread. It should only be
+   used after astGET_GLOBALS has been invoked. */
+#if defined( AST__THREAD_LOCAL )
+#define astSTATUS_BLOCK starlink_ast_status_block
+#else
+#define astSTATUS_BLOCK \
+   ((AstStatusBlock *) pthread_getspecific( starlink_ast_status_key ))
+#endif
 
 
 /* A macro that expands to the value of a unique integer identifier for
@@ -141,6 +183,7 @@ void astInit##class##Globals_( Ast##class##Globals *globals ){ \
 
 typedef struct AstGlobals {
    int thread_identifier;
+   struct AstGlobals *next_unused;
    AstMemoryGlobals Memory;
    AstErrorGlobals  Error;
    AstObjectGlobals Object;
@@ -202,6 +245,7 @@ typedef struct AstGlobals {
    AstTimeMapGlobals TimeMap;
    AstTranMapGlobals TranMap;
    AstUnitMapGlobals UnitMap;
+   AstResamplePlanGlobals ResamplePlan;
    AstWinMapGlobals WinMap;
    AstStcResourceProfileGlobals	StcResourceProfile;
    AstStcSearchLocationGlobals StcSearchLocation;
@@ -212,6 +256,15 @@ typedef struct AstGlobals {
 /* Externally declared variables */
 /* ============================= */
 
+#if defined( AST__THREAD_LOCAL )
+
+/* Thread-local pointers to the structures holding the global data and
+   status value for the current thread. NULL until the first call to
+   astGlobalsInit_ in each thread. Declared in globals.c. */
+extern AST__THREAD_LOCAL AstGlobals *starlink_ast_globals;
+extern AST__THREAD_LOCAL AstStatusBlock *starlink_ast_status_block;
+
+#else
 
 /* The pthreads key that is associated with the thread-specific data for
    each thread. Declared in global.c. */
@@ -225,10 +278,14 @@ extern pthread_key_t starlink_ast_status_key;
    been created. Declared in globals.c. */
 extern pthread_once_t starlink_ast_globals_initialised;
 
+#endif
+
 /* Function Prototypes: */
 /* ==================== */
 
+#if !defined( AST__THREAD_LOCAL )
 void astGlobalsCreateKey_( void );
+#endif
 AstGlobals *astGlobalsInit_( void );
 
 
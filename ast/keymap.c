@@ -61,6 +61,10 @@ c     - astMapPutElem<X>: Puts a value into a vector entry in a KeyMap
 c     - astMapPutU: Add a new entry to a KeyMap with an undefined value
 c     - astMapRemove: Removed a named entry from a KeyMap
 c     - astMapRename: Rename an existing entry in a KeyMap
+c     - astMapShare: Publish a snapshot of a KeyMap for lock-free reading
+c     - astMapShareGet0<X>: Get a scalar entry from a published snapshot
+c     - astMapShareGet1<X>: Get a vector entry from a published snapshot
+c     - astMapShareHasKey: Does a published snapshot contain a named entry?
 c     - astMapSize: Get the number of entries in a KeyMap
 c     - astMapType: Return the data type of a named entry in a map
 f     - AST_MAPDEFINED: Does a KeyMap contain a defined value for a key?
@@ -186,6 +190,29 @@ f     - AST_MAPTYPE: Return the data type of a named entry in a map
 *         Added astMapDefined.
 *     18-JUL-2013 (DSB):
 *         Added SortBy options "KeyAgeUp" and "KeyAgeDown".
+*     16-OCT-2026 (DSB):
+*         Added protected method astMapSync, which allows sub-classes that
+*         hold some entries outside the hash table (e.g. Table) to move
+*         them into the hash table before it is accessed as a whole.
+*     16-OCT-2026 (DSB):
+*         Replace the chained hash table with an open-addressed table of
+*         indices into an array holding the entries in order of storage.
+*         astMapKey is now O(1) for unsorted KeyMaps, and the sorted list
+*         of keys is created when next needed rather than being updated
+*         as each entry is stored.
+*     16-OCT-2026 (DSB):
+*         Added astMapShare and the astMapShareGet<X> functions, which
+*         allow any number of threads to read a published snapshot of a
+*         KeyMap without locking it.
+*     16-OCT-2026 (DSB):
+*         astMapKey no longer re-builds the hash table when entries have
+*         been removed. Storing a new value for an existing key now leaves
+*         the key at its existing position rather than moving it to the end.
+*     16-OCT-2026 (DSB):
+*         Free each superseded snapshot as soon as the last read using it
+*         has finished, rather than only when astMapShare finds no read in
+*         progress (which could be never for a KeyMap that is read
+*         continuously).
 *class--
 */
 
@@ -199,9 +226,18 @@ f     - AST_MAPTYPE: Return the data type of a named entry in a map
 /* Minimum size for the hash table. */
 #define MIN_TABLE_SIZE 16
 
-/* The maximum number of entries per element of the hash table. If this
-   value is exceeded the hash table will be doubled in size. */
-#define MAX_ENTRIES_PER_TABLE_ENTRY 10
+/* The hash table is re-built at a larger size if fewer than this many
+   table elements are available for each stored entry. */
+#define MAX_TABLE_LOAD 2
+
+/* Default value for the SizeGuess attribute. */
+#define DEFAULT_SIZE_GUESS 160
+
+/* Values stored in hash table elements that do not hold the index of
+   an entry. Elements holding entries that have been removed are marked
+   as deleted rather than empty, so that searches continue past them. */
+#define EMPTY_ENTRY -1
+#define DELETED_ENTRY -2
 
 /* String used to represent the formatetd version of AST__BAD. */
 #define BAD_STRING "<bad>"
@@ -215,6 +251,19 @@ f     - AST_MAPTYPE: Return the data type of a named entry in a map
 #define SORTBY_KEYAGEUP 5
 #define SORTBY_KEYAGEDOWN 6
 
+/* Macros used to access the components of a KeyMapShare that are read by
+   threads holding no lock on the KeyMap (see astMapShare). Without
+   thread support these reduce to plain loads and stores. */
+#if defined(THREAD_SAFE)
+#define SHARE_ADD(ptr,val) __atomic_add_fetch(ptr,val,__ATOMIC_SEQ_CST)
+#define SHARE_LOAD(ptr) __atomic_load_n(ptr,__ATOMIC_SEQ_CST)
+#define SHARE_STORE(ptr,val) __atomic_store_n(ptr,val,__ATOMIC_SEQ_CST)
+#else
+#define SHARE_ADD(ptr,val) ( *(ptr) += (val) )
+#define SHARE_LOAD(ptr) ( *(ptr) )
+#define SHARE_STORE(ptr,val) ( *(ptr) = (val) )
+#endif
+
 
 /* Include files. */
 /* ============== */
@@ -242,6 +291,9 @@ f     - AST_MAPTYPE: Return the data type of a named entry in a map
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#if defined(THREAD_SAFE)
+#include <sched.h>
+#endif
 
 /* Type Definitions */
 /* ================ */
@@ -347,6 +399,30 @@ typedef struct Entry1P {
    void **value;             /* The pointers */
 } Entry1P;
 
+/* This structure holds a read-only snapshot of the entries in a KeyMap,
+   as published by astMapShare. The snapshot has its own open-addressed
+   hash table so that it can be searched without reference to the KeyMap. */
+typedef struct ShareSnap {
+   AstMapEntry **entry;      /* Copies of the KeyMap entries */
+   int *table;               /* Hash table holding indices into "entry" */
+   int keycase;              /* Are keys case sensitive? */
+   int keyerror;             /* Report error if no key? */
+   int mapsize;              /* Length of table */
+   int nentry;               /* Length of entry */
+   int nref;                 /* No. of reads using it, plus 1 if published */
+} ShareSnap;
+
+/* This structure gives threads lock-free read access to the most
+   recently published snapshot of a KeyMap. Reader threads only access
+   the "current", "phase" and "nreader" components, using the SHARE_
+   macros. A reader counts itself in "nreader[phase]" only while it
+   loads "current" and increments the snapshot's reference count. */
+struct AstKeyMapShare {
+   ShareSnap *current;       /* The most recently published snapshot */
+   int nreader[ 2 ];         /* No. of readers loading "current" */
+   int phase;                /* Element of nreader used by new readers */
+};
+
 
 /* Module Variables. */
 /* ================= */
@@ -441,19 +517,27 @@ AstKeyMap *astKeyMapId_( const char *, ... );
 
 /* Prototypes for Private Member Functions. */
 /* ======================================== */
-static AstMapEntry *AddTableEntry( AstKeyMap *, int, AstMapEntry *, int, int * );
+static AstMapEntry *AddTableEntry( AstKeyMap *, AstMapEntry *, int, int * );
 static AstMapEntry *CopyMapEntry( AstMapEntry *, int * );
 static AstMapEntry *FreeMapEntry( AstMapEntry *, int * );
 static AstMapEntry *RemoveTableEntry( AstKeyMap *, int, const char *, int * );
+static AstMapEntry *ReplaceTableEntry( AstKeyMap *, int, AstMapEntry *, int * );
 static AstMapEntry *SearchTableEntry( AstKeyMap *, int, const char *, int * );
+static AstMapEntry *ShareFind( ShareSnap *, const char *, const char *, int * );
+static AstKeyMapShare *MapShare( AstKeyMap *, int * );
+static ShareSnap *FreeShareSnap( ShareSnap *, int * );
+static ShareSnap *NewShareSnap( AstKeyMap *, int * );
+static ShareSnap *ReleaseShareSnap( ShareSnap *, int * );
 static const char *ConvertKey( AstKeyMap *, const char *, char *, int, const char *, int * );
 static const char *GetKey( AstKeyMap *, int index, int * );
 static const char *MapIterate( AstKeyMap *, int, int * );
 static const char *MapKey( AstKeyMap *, int index, int * );
+static void MapSync( AstKeyMap *, int * );
 static const char *SortByString( int, const char *, int * );
 static int CompareEntries( const void *, const void * );
 static int ConvertValue( void *, int, void *, int, int * );
 static int GetObjSize( AstObject *, int * );
+static int FindTableEntry( AstKeyMap *, int, const char *, int * );
 static int HashFun( const char *, int, unsigned long *, int * );
 static int KeyCmp( const char *, const char * );
 static int MapDefined( AstKeyMap *, const char *, int * );
@@ -486,18 +570,17 @@ static int MapLenC( AstKeyMap *, const char *, int * );
 static int MapLength( AstKeyMap *, const char *, int * );
 static int MapSize( AstKeyMap *, int * );
 static int MapType( AstKeyMap *, const char *, int * );
+static int ShareGet( AstKeyMapShare *, const char *, int, int *, int, size_t, void *, const char *, int * );
 static int SortByInt( const char *, const char *, int * );
 static size_t SizeOfEntry( AstMapEntry *, int * );
+static void *ShareValue( AstMapEntry *, size_t *, int * );
 static void AddToObjectList( AstKeyMap *, AstMapEntry *, int * );
-static void AddToSortedList( AstKeyMap *, AstMapEntry *, int * );
 static void CheckCircle( AstKeyMap *, AstObject *, const char *, int * );
 static void Copy( const AstObject *, AstObject *, int * );
-static void CopyTableEntry( AstKeyMap *, AstKeyMap *, int, int * );
 static void Delete( AstObject *, int * );
-static void DoubleTableSize( AstKeyMap *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void DumpEntry( AstMapEntry *, AstChannel *, int, int * );
-static void FreeTableEntry( AstKeyMap *, int itab, int * );
+static void FreeTableEntries( AstKeyMap *, int * );
 static void InitMapEntry( AstMapEntry *, int, int, int * );
 static void MapCopy( AstKeyMap *, AstKeyMap *, int * );
 static void MapPut0A( AstKeyMap *, const char *, AstObject *, const char *, int * );
@@ -528,7 +611,7 @@ static void MapPutU( AstKeyMap *, const char *, const char *, int * );
 static void MapRemove( AstKeyMap *, const char *, int * );
 static void MapRename( AstKeyMap *, const char *, const char *, int * );
 static void NewTable( AstKeyMap *, int, int * );
-static void RemoveFromSortedList( AstKeyMap *, AstMapEntry *, int * );
+static void Rehash( AstKeyMap *, int * );
 static void RemoveFromObjectList( AstKeyMap *, AstMapEntry *, int * );
 static void SortEntries( AstKeyMap *, int * );
 
@@ -568,42 +651,43 @@ static int ManageLock( AstObject *, int, int, AstObject **, int * );
 
 /* Member functions. */
 /* ================= */
-static AstMapEntry *AddTableEntry( AstKeyMap *this, int itab,
-                                   AstMapEntry *entry, int keymember,
-                                   int *status ){
+static AstMapEntry *AddTableEntry( AstKeyMap *this, AstMapEntry *entry,
+                                   int keymember, int *status ){
 /*
 *  Name:
 *     AddTableEntry
 
 *  Purpose:
-*     Add an new entry to a linked-list of KeyMap entries.
+*     Add an new entry to a KeyMap.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "keymap.h"
-*     AstMapEntry *AddTableEntry( AstKeyMap *this, int itab,
-*                                 AstMapEntry *entry, int keymember,
-*                                 int *status ){
+*     AstMapEntry *AddTableEntry( AstKeyMap *this, AstMapEntry *entry,
+*                                 int keymember, int *status ){
 
 *  Class Membership:
 *     KeyMap member function.
 
 *  Description:
-*     This function adds the supplied MapEntry to the head of the linked
-*     list of MapEntries stored at the specified entry of the hash table.
-*     If this results in the linked list having too many entries, then a
-*     new larger hash table is allocated and the entries in the existing
-*     table are moved into the new table.
+*     This function appends the supplied MapEntry to the end of the
+*     array of MapEntries held in the KeyMap, and stores its index within
+*     that array in the first free element of the hash table following
+*     the element selected by the hash value stored in the MapEntry
+*     ("linear probing"). If this would result in the hash table being
+*     more than half full, the hash table is first rebuilt at a larger
+*     size. The caller should ensure that the KeyMap does not already
+*     contain an entry with the same key. The supplied MapEntry is freed
+*     if it cannot be stored.
 
 *  Parameters:
 *     this
 *        Pointer to the KeyMap.
-*     itab
-*        Index of the hash table element to be searched.
 *     entry
-*        Pointer to the MapEntry to be added.
+*        Pointer to the MapEntry to be added. Its "hash" component
+*        should hold the full width hash value for its key.
 *     keymember
 *        A unique integer identifier for the key that increases
 *        monotonically with age of the key. If this is negative,
@@ -616,46 +700,62 @@ static AstMapEntry *AddTableEntry( AstKeyMap *this, int itab,
 
 */
 
+/* Local Variables: */
+   int bitmask;             /* Bit mask for hash table indices */
+   int itab;                /* Index into hash table */
+
 /* Check the global error status. */
    if ( !astOK ) return NULL;
 
-/* Put a pointer to the MapEntry which is currently at the head of the
-   linked list in the "next" component of the supplied MapEntry. */
-   entry->next = this->table[ itab ];
+/* If the hash table would be more than half full once the new entry has
+   been added (counting elements that have been marked as deleted), rebuild
+   it, at a larger size if necessary. */
+   if( MAX_TABLE_LOAD*( this->nentry - this->nfree + this->ndead + 1 ) >
+       this->mapsize ) Rehash( this, status );
+
+/* Ensure the array of entries is large enough to hold the new entry. */
+   this->entry = astGrow( this->entry, this->nentry + 1,
+                          sizeof( AstMapEntry * ) );
+   if( astOK ) {
 
-/* Store the supplied MapEntry pointer in the requested element of the
-   hash table. */
-   this->table[ itab ] = entry;
+/* Find the first free element of the hash table, starting at the
+   element selected by the hash value. Elements marked as deleted may be
+   re-used. */
+      bitmask = this->mapsize - 1;
+      itab = (int) ( entry->hash & bitmask );
+      while( this->table[ itab ] >= 0 ) itab = ( itab + 1 ) & bitmask;
+      if( this->table[ itab ] == DELETED_ENTRY ) (this->ndead)--;
 
-/* Increment the length of linked list. */
-   this->nentry[ itab ]++;
+/* Append the entry to the end of the array of entries, and store its index
+   in the hash table. */
+      this->table[ itab ] = this->nentry;
+      this->entry[ (this->nentry)++ ] = entry;
 
 /* Each new entry added to the KeyMap has a unique member index that is
    never re-used. */
-   entry->member = (this->member_count)++;
+      entry->member = (this->member_count)++;
 
 /* Each key added to the  KeyMap also has a separate unique member index,
    but this index is re-used each time the same key is added into the
    KeyMap. So changing the value associated with a key does not cause the
    keymember value to change. */
-   if( keymember >= 0 ) {
-      entry->keymember = keymember;
-   } else {
-      entry->keymember = (this->member_count)++;
-   }
+      if( keymember >= 0 ) {
+         entry->keymember = keymember;
+      } else {
+         entry->keymember = (this->member_count)++;
+      }
 
-/* Insert the supplied MapEntry into a list sorted by key. */
-   AddToSortedList( this, entry, status );
+/* The sorted list of entries will need to be re-created before it is
+   next used. */
+      this->resort = 1;
 
 /* If the entry is of type AST__OBJECTTYPE, add it to the head of the
    list of AST__OBJECTTYPE entries in the KeyMap. */
-   AddToObjectList( this, entry, status );
+      AddToObjectList( this, entry, status );
 
-/* If the population of this table entry is now too large, double the size
-   of the table, moving the table entries to appropriate places in the
-   new larger table. */
-   if( this->nentry[ itab ] > MAX_ENTRIES_PER_TABLE_ENTRY ) {
-      DoubleTableSize( this, status );
+/* If the entry could not be stored, free it. */
+   } else {
+      (void) FreeMapEntry( entry, status );
    }
 
 /* Return a NULL pointer. */
@@ -748,155 +848,6 @@ static void AddToObjectList( AstKeyMap *this, AstMapEntry *entry, int *status ){
    }
 }
 
-static void AddToSortedList( AstKeyMap *this, AstMapEntry *entry, int *status ){
-/*
-*  Name:
-*     AddToSortedList
-
-*  Purpose:
-*     Add an entry into the linked-list of sorted KeyMap entries.
-
-*  Type:
-*     Private function.
-
-*  Synopsis:
-*     #include "keymap.h"
-*     void AddToSortedList( AstKeyMap *this, AstMapEntry *entry, int *status )
-
-*  Class Membership:
-*     KeyMap member function.
-
-*  Description:
-*     This function adds the supplied MapEntry into the linked list of
-*     sorted MapEntries at a position that maintains the sorted order.
-
-*  Parameters:
-*     this
-*        Pointer to the KeyMap.
-*     entry
-*        Pointer to the MapEntry to be added.
-*     status
-*        Pointer to the inherited status variable.
-
-*/
-
-/* Local Variables: */
-   AstMapEntry *hi;         /* MapEntry at high end of current range */
-   AstMapEntry *lo;         /* MapEntry at low end of current range */
-   AstMapEntry *mid;        /* MapEntry at middle of current range */
-   int cmp;                 /* Result of comparing two entries */
-   int istep;               /* Step counter */
-   int nstep;               /* Number of entries in current range */
-   int sortby;              /* How to sort the keys */
-
-/* Check the global error status. */
-   if ( !astOK ) return;
-
-/* Get the SortBy value. */
-   sortby = astGetSortBy( this );
-
-/* Do nothing if no sorting is required. */
-   if( sortby != SORTBY_NONE ) {
-
-/* Get pointers to the entries at the start and end of the sorted list. */
-      lo = this->first;
-      hi = lo ? lo->sprev : NULL;
-
-/* Store sortby value in the mapentry structures. */
-      if( lo ) lo->sortby = sortby;
-      if( hi ) hi->sortby = sortby;
-      entry->sortby = sortby;
-
-/* If the sorted list is empty, just store the supplied entry at the
-   head, and set the links to point back to itself. */
-      if( !lo ) {
-         this->first = entry;
-         entry->sprev = entry;
-         entry->snext = entry;
-
-/* If the new entry comes before the first entry or is equal to the first
-   entry, record it as the new first entry, and insert it into the linked
-   list before the original first entry. */
-      } else if( CompareEntries( &entry, &lo ) <= 0 ) {
-         this->first = entry;
-         entry->snext = lo;
-         entry->sprev = hi;
-         lo->sprev = entry;
-         hi->snext = entry;
-
-/* If the new entry comes after the last entry or is equal to the last
-   entry, insert it into the linked list after the last entry. */
-      } else if( CompareEntries( &entry, &hi ) >= 0 ) {
-         entry->snext = lo;
-         entry->sprev = hi;
-         lo->sprev = entry;
-         hi->snext = entry;
-
-/* If the list only contains two values, insert the new entry into the linked
-   list between the existing two entries. */
-      } else if( lo->snext == hi ) {
-         entry->snext = hi;
-         entry->sprev = lo;
-         lo->snext = entry;
-         hi->sprev = entry;
-
-/* Otherwise we do a binary chop within the existing sorted list to find the
-   correct position for the new entry. */
-      } else {
-
-/* Get a pointer to the entry mid way between the hi and lo entries. The
-   mid entry will be on the upper side of half way if there are an even
-   number of entries. */
-         nstep = this->nsorted/2;
-         mid = lo;
-         for( istep = 0; istep < nstep; istep++ ) mid = mid->snext;
-
-/* Loop until we have a pointer to the first entry which is equal to or
-   higher than the new entry. */
-         while( lo->snext != hi ) {
-
-/* The next step will be half the length of the previous step. Do not
-   allow the step size to fall to zero. */
-            nstep = ( nstep > 1 ) ? nstep/2 : 1;
-
-/* Compare the new entry with the current mid-way entry. */
-            mid->sortby = sortby;
-            cmp = CompareEntries( &entry, &mid );
-
-/* If the new entry comes before the mid entry, use the mid entry as the
-   next hi entry, and go down the list by the new step size to find the
-   new mid-way entry. */
-            if( cmp < 0 ) {
-               hi = mid;
-               for( istep = 0; istep < nstep; istep++ ) mid = mid->sprev;
-
-/* If the new entry comes after the mid entry, use the mid entry as the
-   next lo entry, and go up the list by the new step size to find the
-   new mid-way entry. */
-            } else if( cmp > 0 ) {
-               lo = mid;
-               for( istep = 0; istep < nstep; istep++ ) mid = mid->snext;
-
-/* If the new entry is equal to the mid entry, use the mid entry as hi
-   and set lo to the previous entry. This causes the loop to quit. */
-            } else {
-               hi = mid;
-               lo = mid->sprev;
-            }
-         }
-
-/* Insert the new entry into the list between lo and hi. */
-         entry->sprev = lo;
-         entry->snext = hi;
-         lo->snext = entry;
-         hi->sprev = entry;
-      }
-
-/* Increment the number of entries in the sorted list. */
-      (this->nsorted)++;
-   }
-}
-
 static void CheckCircle( AstKeyMap *this, AstObject *obj, const char *method, int *status ) {
 /*
 *  Name:
@@ -933,12 +884,12 @@ static void CheckCircle( AstKeyMap *this, AstObject *obj, const char *method, in
 
 /* Local Variables: */
    AstKeyMap *keymap;       /* The KeyMap being added to "this" */
+   AstMapEntry *entry;      /* Pointer to entry within second KeyMap */
    AstObject **vec;         /* Pointer to list of AstObject pointers */
-   const char *key;         /* The i'th key within second KeyMap */
-   int i;                   /* Index of entry within second KeyMap */
+   const char *key;         /* The key of the current entry */
+   int ient;                /* Index into entries of second KeyMap */
    int j;                   /* Index within the vector of values */
    int len;                 /* No. of AST pointers stored in the entry */
-   int nkey;                /* No. of entries in the second KeyMap */
 
 /* Check the global error status. */
    if( !astOK ) return;
@@ -955,46 +906,51 @@ static void CheckCircle( AstKeyMap *this, AstObject *obj, const char *method, in
                    astGetClass( this ), astGetClass( this ),
                    astGetClass( this ), astGetClass( this ) );
 
-/* Otherwise, loop through all the entries in the KeyMap looking for AstObject
-   entries. */
+/* Otherwise, loop through all the entries in the KeyMap looking for
+   AstObject entries. The array of entries is accessed directly (rather than
+   using astMapKey) so that sub-classes which hold some numerical values
+   outside the hash table (e.g. Table) are not forced to move them into
+   it. */
       } else {
-         nkey = astMapSize( keymap );
-         for( i = 0; i < nkey && astOK; i++ ) {
-            key = astMapKey( keymap, i );
-            if( astMapType( keymap, key ) == AST__OBJECTTYPE ) {
+         for( ient = 0; ient < keymap->nentry && astOK; ient++ ) {
+            entry = keymap->entry[ ient ];
+            if( entry ) {
+               key = entry->key;
+               if( entry->type == AST__OBJECTTYPE ) {
 
 /* Find the number of AstObject pointers stored in this entry, and
    allocate memory to store a copy of the every pointer. */
-               len = astMapLength( keymap, key );
-               vec = astMalloc( sizeof( AstObject *) * len );
-               if( vec ) {
+                  len = astMapLength( keymap, key );
+                  vec = astMalloc( sizeof( AstObject *) * len );
+                  if( vec ) {
 
 /* Extract pointers to the AstObjects at this entry, and loop round them. */
-                  astMapGet1A( keymap, key, len, &len, vec );
-                  for( j = 0; j < len; j++ ) {
+                     astMapGet1A( keymap, key, len, &len, vec );
+                     for( j = 0; j < len; j++ ) {
 
 /* If this entry is a KeyMap, we need to check if is the same as "this"
    or contains "this". */
-                     if( astIsAKeyMap( vec[ j ] ) ) {
+                        if( astIsAKeyMap( vec[ j ] ) ) {
 
 /* If it is the same as "this", report an error. */
-                        if( vec[ j ] == (AstObject *) this ) {
-                           astError( AST__KYCIR, "%s(%s): Cannot add a KeyMap "
-                                     "into another KeyMap because the first "
-                                     "KeyMap contains the second KeyMap.", status,
-                                     method, astGetClass( this ) );
-                           break;
+                           if( vec[ j ] == (AstObject *) this ) {
+                              astError( AST__KYCIR, "%s(%s): Cannot add a KeyMap "
+                                        "into another KeyMap because the first "
+                                        "KeyMap contains the second KeyMap.", status,
+                                        method, astGetClass( this ) );
+                              break;
 
 /* Otherwise, see if it contains "this". */
-                        } else {
-                           CheckCircle( this, vec[ j ], method, status );
+                           } else {
+                              CheckCircle( this, vec[ j ], method, status );
+                           }
                         }
-                     }
 
 /* Free resources. */
-                     vec[ j ] = astAnnul( vec[ j ] );
+                        vec[ j ] = astAnnul( vec[ j ] );
+                     }
+                     vec = astFree( vec );
                   }
-                  vec = astFree( vec );
                }
             }
          }
@@ -1111,7 +1067,6 @@ static void ClearKeyCase( AstKeyMap *this, int *status ) {
 
 /* Local Variables: */
    int defval;                /* Default KeyCase value */
-   int itab;                  /* Index into hash table */
    int oldval;                /* Old KeyCase value */
 
 /* Check the global error status. */
@@ -1130,14 +1085,11 @@ static void ClearKeyCase( AstKeyMap *this, int *status ) {
    that the KeyMap is empty. If not, restore the old value and report an
    error. */
    if( defval != oldval ) {
-      for( itab = 0; itab < this->mapsize; itab++ ) {
-         if( this->nentry[ itab ] > 0 ) {
-            this->keycase = oldval;
-            astError( AST__NOWRT, "astClearAttrib(KeyMap): Illegal attempt to "
-                      "clear the KeyCase attribute of a non-empty KeyMap.",
-                      status);
-            break;
-         }
+      if( this->nentry - this->nfree > 0 ) {
+         this->keycase = oldval;
+         astError( AST__NOWRT, "astClearAttrib(KeyMap): Illegal attempt to "
+                   "clear the KeyCase attribute of a non-empty KeyMap.",
+                   status);
       }
    }
 }
@@ -1176,7 +1128,7 @@ static void ClearKeyError( AstKeyMap *this, int *status ) {
 /* Local Variables: */
    AstMapEntry *next;     /* Pointer to next Entry to copy */
    AstObject **obj_list;  /* List of pointers to AST Object entries */
-   int i;                 /* Index into hash table */
+   int i;                 /* Index into array of entries */
    int iel;               /* Index of current vector element */
    int nel;               /* Number of elements in vector */
 
@@ -1186,14 +1138,11 @@ static void ClearKeyError( AstKeyMap *this, int *status ) {
 /* Clear the KeyError value in the supplied KeyMap. */
    this->keyerror = -INT_MAX;
 
-/* Loop round each entry in the hash table. */
-   for( i = 0; i < this->mapsize; i++ ) {
-
-/* Get a pointer to the next KeyMap entry. */
-      next = this->table[ i ];
-
-/* Loop round all entries in this element of the hash table. */
-      while( next && astOK ) {
+/* Loop round each entry in the KeyMap, skipping over any entries that
+   have been removed. */
+   for( i = 0; i < this->nentry && astOK; i++ ) {
+      next = this->entry[ i ];
+      if( next ) {
 
 /* If this entry has an Object data type, see if holds any KeyMaps. */
          if( next->type == AST__OBJECTTYPE ) {
@@ -1216,9 +1165,6 @@ static void ClearKeyError( AstKeyMap *this, int *status ) {
                }
             }
          }
-
-/* Get a pointer to the next entry. */
-         next = next->next;
       }
    }
 }
@@ -1257,7 +1203,7 @@ static void ClearMapLocked( AstKeyMap *this, int *status ) {
 /* Local Variables: */
    AstMapEntry *next;     /* Pointer to next Entry to copy */
    AstObject **obj_list;  /* List of pointers to AST Object entries */
-   int i;                 /* Index into hash table */
+   int i;                 /* Index into array of entries */
    int iel;               /* Index of current vector element */
    int nel;               /* Number of elements in vector */
 
@@ -1267,14 +1213,11 @@ static void ClearMapLocked( AstKeyMap *this, int *status ) {
 /* Clear the MapLocked value in the supplied KeyMap. */
    this->maplocked = -INT_MAX;
 
-/* Loop round each entry in the hash table. */
-   for( i = 0; i < this->mapsize; i++ ) {
-
-/* Get a pointer to the next KeyMap entry. */
-      next = this->table[ i ];
-
-/* Loop round all entries in this element of the hash table. */
-      while( next && astOK ) {
+/* Loop round each entry in the KeyMap, skipping over any entries that
+   have been removed. */
+   for( i = 0; i < this->nentry && astOK; i++ ) {
+      next = this->entry[ i ];
+      if( next ) {
 
 /* If this entry has an Object data type, see if holds any KeyMaps. */
          if( next->type == AST__OBJECTTYPE ) {
@@ -1297,9 +1240,6 @@ static void ClearMapLocked( AstKeyMap *this, int *status ) {
                }
             }
          }
-
-/* Get a pointer to the next entry. */
-         next = next->next;
       }
    }
 }
@@ -1336,19 +1276,12 @@ static void ClearSizeGuess( AstKeyMap *this, int *status ) {
 
 /* Local Variables: */
    int empty;                 /* Is the KeyMap empty? */
-   int itab;                  /* Index into hash table */
 
 /* Check the global error status. */
    if ( !astOK ) return;
 
 /* See if the KeyMap is empty. */
-   empty = 1;
-   for( itab = 0; itab < this->mapsize; itab++ ) {
-      if( this->nentry[ itab ] > 0 ) {
-         empty = 0;
-         break;
-      }
-   }
+   empty = ( this->nentry - this->nfree == 0 );
 
 /* If not report an error. */
    if( !empty ) {
@@ -1405,8 +1338,9 @@ static void ClearSortBy( AstKeyMap *this, int *status ) {
 /* Clear the SortBy value in the supplied KeyMap. */
    this->sortby = -INT_MAX;
 
-/* If the value has changed, re-sort the keys. */
-   if( oldval != astGetSortBy( this ) ) SortEntries( this, status );
+/* If the value has changed, the keys will need to be re-sorted before
+   they are next used. */
+   if( oldval != astGetSortBy( this ) ) this->resort = 1;
 }
 
 static int CompareEntries( const void *first_void, const void *second_void ) {
@@ -2217,9 +2151,6 @@ static AstMapEntry *CopyMapEntry( AstMapEntry *in, int *status ){
    result = astStore( NULL, in, size );
 
 /* Copy or nullify pointers in the AstMapEntry structure. */
-   result->next = NULL;
-   result->snext = NULL;
-   result->sprev = NULL;
    text = in->key;
    result->key = text ? astStore( NULL, text, strlen( text ) + 1 ) : NULL;
    text = in->comment;
@@ -2338,202 +2269,6 @@ static AstMapEntry *CopyMapEntry( AstMapEntry *in, int *status ){
    return result;
 }
 
-static void CopyTableEntry( AstKeyMap *in, AstKeyMap *out, int itab, int *status ){
-/*
-*  Name:
-*     CopyTableEntry
-
-*  Purpose:
-*     Produces a deep copy of a hash table element.
-
-*  Type:
-*     Private function.
-
-*  Synopsis:
-*     #include "keymap.h"
-*     void CopyTableEntry( AstKeyMap *in, AstKeyMap *out, int itab, int *status )
-
-*  Class Membership:
-*     KeyMap member function.
-
-*  Description:
-*     This function creates a deep copy of the linked-list of KeyMap entries
-*     stored in the specified element of the input KeyMaps hash table.
-
-*  Parameters:
-*     in
-*        Pointer to the input KeyMap.
-*     out
-*        Pointer to the output KeyMap.
-*     itab
-*        Index of the hash table element to be copied.
-*     status
-*        Pointer to the inherited status variable.
-
-*/
-
-/* Local Variables: */
-   AstMapEntry **link;    /* Address to store foward link */
-   AstMapEntry *next;     /* Pointer to next Entry to copy */
-
-/* Check the global error status. */
-   if ( !astOK ) return;
-
-/* The "link" variable holds the address of the location at which the
-   pointer to the next copied MapEntry should be stored. Initialise this to
-   be the address of the required element of the output hash table. */
-   link = &( out->table[ itab ] );
-
-/* The "next" variable holds the address of the next MapEntry to be
-   copied. Initialise this to the MapEntry at the head of the linked list
-   associated with the specified index of the input KeyMaps hash table. */
-   next = in->table[ itab ];
-
-/* If the hash table element is empty, store a null pointer and pass on. */
-   if( !next ) {
-      out->table[ itab ] = NULL;
-
-/* Otherwise copy the liked list. */
-   } else {
-
-/* Loop round until we have copied all entries. */
-      while( next && astOK ) {
-
-/* Copy the next entry, storing the resulting pointer at the position
-   indicated by "link". */
-         *link = CopyMapEntry( next, status );
-
-/* If the entry is of type AST__OBJECTTYPE, add it to the head of the
-   list of AST__OBJECTTYPE entries in the output KeyMap. */
-         AddToObjectList( out, *link, status );
-
-/* Update "link" and "next" */
-         next = next->next;
-         link = &( (*link)->next );
-      }
-   }
-
-/* Set the number of entries in the output to be the same as the input. */
-   out->nentry[ itab ] = in->nentry[ itab ];
-
-/* If an error has occurred, attempt to delete the returned MapEntry. */
-   if( !astOK ) FreeTableEntry( out, itab, status );
-}
-
-static void DoubleTableSize( AstKeyMap *this, int *status ) {
-/*
-*  Name:
-*     DoubleTableSize
-
-*  Purpose:
-*     Double the size of the hash table in a KeyMap
-
-*  Type:
-*     Private function.
-
-*  Synopsis:
-*     #include "keymap.h"
-*     void DoubleTableSize( AstKeyMap *this, int *status )
-
-*  Class Membership:
-*     KeyMap member function.
-
-*  Description:
-*     This function creates a new hash table which has twice as many
-*     elements as the current hash table, and moves all the entries out
-*     of the old table into the new table (at their new positions).
-
-*  Parameters:
-*     this
-*        The KeyMap pointer.
-*     status
-*        Pointer to the inherited status variable.
-
-*/
-
-/* Local Variables: */
-   AstMapEntry **newtable;
-   AstMapEntry *next;
-   AstMapEntry *new_next;
-   int *newnentry;
-   int bitmask;
-   int i;
-   int newi;
-   int newmapsize;
-
-/* Check the global error status. */
-   if( !astOK ) return;
-
-/* Determine the new hash table size. Since mapsize starts out as a power
-   of 2 (ensured by the NewTable function), the new mapsize will also be
-   a power of 2. Also, create a bit mask that can be used to zero the
-   upper bits in a full width hash value. */
-   newmapsize = 2*this->mapsize;
-   bitmask = newmapsize - 1;
-
-/* Create the new arrays, leaving the old arrays intact for the moment. */
-   newtable = astMalloc( newmapsize*sizeof( AstMapEntry * ) );
-   newnentry = astMalloc( newmapsize*sizeof( int ) );
-   if( astOK ) {
-
-/* Initialise the new table. */
-      for( i = 0; i < newmapsize; i++ ) {
-         newtable[ i ] = NULL;
-         newnentry[ i ] = 0;
-      }
-
-/* Loop round each of the existing table entries. */
-      for( i = 0; i < this->mapsize; i++ ) {
-
-/* The "next" variable holds the address of the next MapEntry to be
-   moved. Initialise this to the MapEntry at the head of the linked list
-   associated with the specified index of the input KeyMaps hash table. */
-         next = this->table[ i ];
-
-/* Loop round until we have moved all entries. */
-         while( next && astOK ) {
-
-/* Find the index within the new table at which to store this entry. */
-            newi = ( next->hash & bitmask );
-
-/* Save the pointer to the next entry following the current one in the
-   linked list. */
-            new_next = next->next;
-
-/* Put a pointer to the MapEntry which is currently at the head of the
-   linked list in the "next" component of the current MapEntry. */
-            next->next = newtable[ newi ];
-
-/* Store the supplied MapEntry pointer in the requested element of the
-   hash table. */
-            newtable[ newi ] = next;
-
-/* Increment the length of linked list. */
-            newnentry[ newi ]++;
-
-/* Use the pointer to the next map entry to be moved. */
-            next = new_next;
-         }
-      }
-   }
-
-/* If OK, delete the existing table and use the new table */
-   if( astOK ) {
-      this->mapsize = newmapsize;
-
-      (void) astFree( this->table );
-      this->table = newtable;
-
-      (void) astFree( this->nentry );
-      this->nentry = newnentry;
-
-/* If not OK, delete the new table. */
-   } else {
-      newtable = astFree( newtable );
-      newnentry = astFree( newnentry );
-   }
-}
-
 static void DumpEntry( AstMapEntry *entry, AstChannel *channel, int nentry, int *status ) {
 /*
 *  Name:
@@ -2751,6 +2486,83 @@ static void DumpEntry( AstMapEntry *entry, AstChannel *channel, int nentry, int
    }
 }
 
+static int FindTableEntry( AstKeyMap *this, int itab, const char *key,
+                           int *status ){
+/*
+*  Name:
+*     FindTableEntry
+
+*  Purpose:
+*     Find the hash table element that refers to a given key.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     int FindTableEntry( AstKeyMap *this, int itab, const char *key,
+*                         int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function searches the hash table of the supplied KeyMap for an
+*     element that refers to a MapEntry with the specified key. The search
+*     starts at the supplied element and proceeds through subsequent
+*     elements (wrapping round at the end of the table) until either a
+*     matching entry or an empty element is found.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+*     itab
+*        Index of the hash table element at which to start searching.
+*        This should be the value returned by HashFun for the key.
+*     key
+*        The key string to be searched for. Trailing spaces are ignored.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The index of the hash table element that refers to the entry with
+*     the given key, or -1 if the key is not found.
+
+*/
+
+/* Local Variables: */
+   int bitmask;           /* Bit mask for hash table indices */
+   int ient;              /* Index into array of entries */
+   int result;            /* Returned index */
+
+/* Initialise */
+   result = -1;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Check each element of the hash table in turn, starting at the supplied
+   element, until an empty element is found. Elements marked as deleted
+   are skipped over. Since the hash table is never allowed to become
+   more than half full, an empty element will always be found. */
+   bitmask = this->mapsize - 1;
+   while( ( ient = this->table[ itab ] ) != EMPTY_ENTRY ) {
+
+/* If the key for the current entry matches the supplied key, store the
+   hash table index and break. */
+      if( ient >= 0 && !KeyCmp( this->entry[ ient ]->key, key ) ) {
+         result = itab;
+         break;
+      }
+
+/* Move on to the next element of the hash table. */
+      itab = ( itab + 1 ) & bitmask;
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static AstMapEntry *FreeMapEntry( AstMapEntry *in, int *status ){
 /*
 *  Name:
@@ -2880,10 +2692,7 @@ static AstMapEntry *FreeMapEntry( AstMapEntry *in, int *status ){
                 type );
    }
 
-/* Free or nullify pointers in the AstMapEntry structure. */
-   in->next = NULL;
-   in->snext = NULL;
-   in->sprev = NULL;
+/* Free pointers in the AstMapEntry structure. */
    in->key = astFree( (void *) in->key );
    in->comment = astFree( (void *) in->comment );
 
@@ -2894,81 +2703,130 @@ static AstMapEntry *FreeMapEntry( AstMapEntry *in, int *status ){
    return NULL;
 }
 
-static void FreeTableEntry( AstKeyMap *this, int itab, int *status ){
+static ShareSnap *FreeShareSnap( ShareSnap *snap, int *status ){
 /*
 *  Name:
-*     FreeTableEntry
+*     FreeShareSnap
 
 *  Purpose:
-*     Frees the linked list of KeyMap entries stored in a given element of
-*     the hash table.
+*     Free a snapshot published by astMapShare.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "keymap.h"
-*     void FreeTableEntry( AstKeyMap *this, int itab, int *status )
+*     ShareSnap *FreeShareSnap( ShareSnap *snap, int *status )
 
 *  Class Membership:
 *     KeyMap member function.
 
 *  Description:
-*     This function frees resources used by all the MapEntries in the
-*     linked list associated with the specified element of the hash table
-*     of the supplied KeyMap.
+*     This function frees the entries and hash table held in a snapshot,
+*     and then frees the snapshot itself.
 
 *  Parameters:
-*     this
-*        Pointer to the KeyMap
-*     itab
-*        Index of the hash table element to free.
+*     snap
+*        Pointer to the snapshot. NULL may be supplied, in which case
+*        nothing is done.
 *     status
 *        Pointer to the inherited status variable.
 
+*  Returned Value:
+*     A NULL pointer.
+
 *  Notes:
 *     - This function attempts to execute even if it is invoked with the
 *     global error status set.
 */
 
 /* Local Variables: */
-   AstMapEntry *link;     /* Pointer the next but one MapEntry to be freed */
-   AstMapEntry *next;     /* Pointer the next MapEntry to be freed */
-
-/* Check it is safe to proceed. */
-   if( this && itab >= 0 && itab < this->mapsize ) {
-
-/* Store a pointer to the MapEntry which is to be freed next. */
-      next = this->table[ itab ];
-
-/* Loop round freeing all MapEntries in the linked list. */
-      while( next ) {
-
-/* Store a pointer to the MapEntry which will be freed after this one. */
-         link = next->next;
+   int i;                 /* Index of next entry to be freed */
 
-/* Free this MapEntry */
-         (void) FreeMapEntry( next, status );
-
-/* Set up the next MapEntry to be freed. */
-         next = link;
-      }
-
-/* Store a NULL pointer in the table element. */
-      this->table[ itab ] = NULL;
+/* Check the supplied pointer. */
+   if( !snap ) return NULL;
 
-/* Sets the number of entries in this hash table element to zero. */
-      this->nentry[ itab ] = 0;
+/* Free the entries. None of them hold AST Object pointers. */
+   for( i = 0; i < snap->nentry; i++ ) {
+      (void) FreeMapEntry( snap->entry[ i ], status );
    }
+
+/* Free the arrays and the snapshot structure. */
+   snap->entry = astFree( snap->entry );
+   snap->table = astFree( snap->table );
+   return astFree( snap );
 }
 
-static const char *GetAttrib( AstObject *this_object, const char *attrib, int *status ) {
+static void FreeTableEntries( AstKeyMap *this, int *status ){
 /*
 *  Name:
-*     GetAttrib
+*     FreeTableEntries
 
 *  Purpose:
-*     Get the value of a specified attribute for a KeyMap.
+*     Frees all the entries in a KeyMap.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     void FreeTableEntries( AstKeyMap *this, int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function frees resources used by all the MapEntries stored in
+*     the supplied KeyMap, and marks every element of the hash table as
+*     empty. The memory used to hold the hash table itself is retained.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if it is invoked with the
+*     global error status set.
+*/
+
+/* Local Variables: */
+   int i;                 /* Index of next MapEntry to be freed */
+   int itab;              /* Index into hash table */
+
+/* Check it is safe to proceed. */
+   if( this ) {
+
+/* Loop round freeing all MapEntries. */
+      for( i = 0; i < this->nentry; i++ ) {
+         this->entry[ i ] = FreeMapEntry( this->entry[ i ], status );
+      }
+
+/* Mark every element of the hash table as empty. */
+      if( this->table ) {
+         for( itab = 0; itab < this->mapsize; itab++ ) {
+            this->table[ itab ] = EMPTY_ENTRY;
+         }
+      }
+
+/* Indicate the KeyMap is empty. */
+      this->nentry = 0;
+      this->nfree = 0;
+      this->ndead = 0;
+      this->nsorted = 0;
+      this->resort = 1;
+      this->firstA = NULL;
+   }
+}
+
+static const char *GetAttrib( AstObject *this_object, const char *attrib, int *status ) {
+/*
+*  Name:
+*     GetAttrib
+
+*  Purpose:
+*     Get the value of a specified attribute for a KeyMap.
 
 *  Type:
 *     Private function.
@@ -3133,7 +2991,7 @@ static int GetObjSize( AstObject *this_object, int *status ) {
    AstObject *obj;        /* Pointer to AST object */
    const char **slist;    /* Pointer to list of text pointers */
    int i;                 /* Loop count */
-   int itab;              /* Table entry index */
+   int ient;              /* Index into array of entries */
    int nel;               /* No. of values in entry vector (0 => scalar) */
    int result;            /* Result value to return */
    int type;              /* Entry data type */
@@ -3152,9 +3010,14 @@ static int GetObjSize( AstObject *this_object, int *status ) {
    which are stored in dynamically allocated memory. */
    result = (*parent_getobjsize)( this_object, status );
 
-   for( itab = 0; itab < this->mapsize; itab++ ) {
-      next = this->table[ itab ];
-      while( next ) {
+   result += astTSizeOf( this->table );
+   result += astTSizeOf( this->entry );
+   result += astTSizeOf( this->sorted );
+   result += astTSizeOf( this->share );
+
+   for( ient = 0; ient < this->nentry; ient++ ) {
+      next = this->entry[ ient ];
+      if( next ) {
          nel = next->nel;
          type = next->type;
 
@@ -3214,8 +3077,6 @@ static int GetObjSize( AstObject *this_object, int *status ) {
          result += astTSizeOf( (void *) next->key );
          result += astTSizeOf( (void *) next->comment );
          result += astTSizeOf( next );
-
-         next = next->next;
       }
    }
 
@@ -3272,11 +3133,6 @@ static const char *GetKey( AstKeyMap *this, int index, int *status ) {
 /* Local Variables: */
    AstMapEntry *entry;         /* Pointer to the entry */
    const char *result;         /* Pointer value to return */
-   int ifirst;                 /* Index of first entry in this table element */
-   int ilast;                  /* Index of last entry in this table element */
-   int istep;                  /* Entry count */
-   int itab;                   /* Index into hash table */
-   int nstep;                  /* No. of entries to skip */
    int sortby;                 /* The value of the SortBy attribute */
 
 /* Initialise. */
@@ -3288,49 +3144,29 @@ static const char *GetKey( AstKeyMap *this, int index, int *status ) {
 /* Get the SortBy value. */
    sortby = astGetSortBy( this );
 
-/* First deal with unsorted keys. */
-   if( sortby == SORTBY_NONE ) {
-
-/* Loop round each entry in the hash table. */
-      ilast = -1;
-      for( itab = 0; itab < this->mapsize; itab++ ) {
-
-/* Find the index of the first and the last Entry in the linked list associated
-   with this element of the hash table. */
-         ifirst = ilast + 1;
-         ilast += this->nentry[ itab ];
-
-/* Pass on if we have not yet reached the element containing the required
-   key. */
-         if( ilast >= index ) {
-
-/* Find how many steps we need to proceed down the linked list to reach
-   the required index. */
-            nstep = index - ifirst;
-
-/* Make this many steps down the linked list.*/
-            entry = this->table[ itab ];
-            for( istep = 0; entry && istep < nstep; istep++ ) entry = entry->next;
-
-/* Return a pointer to the key string, and break out of the loop. */
-            if( entry ) result = entry->key;
-            break;
-
-         }
+/* Check the index is within the bounds of the KeyMap. */
+   entry = NULL;
+   if( index >= 0 && index < this->nentry - this->nfree ) {
+
+/* First deal with unsorted keys when no entries have been removed from
+   the array of entries. The keys are returned in the order in which they
+   are stored in the array. */
+      if( sortby == SORTBY_NONE && this->nfree == 0 ) {
+         entry = this->entry[ index ];
+
+/* Now deal with sorted keys, and with unsorted keys when the array of
+   entries contains gaps. Re-create the sorted list of entries if it
+   is out of date (for unsorted keys, this just collects the remaining
+   entries in the order in which they are stored, without modifying the
+   array of entries or the hash table). */
+      } else {
+         if( this->resort ) SortEntries( this, status );
+         if( astOK && index < this->nsorted ) entry = this->sorted[ index ];
       }
-
-/* Now deal with sorted keys. */
-   } else {
-
-/* Get a pointer to the first entry in the sorted list. */
-      entry = this->first;
-
-/* Move up the sorted list by the required number of entries. */
-      for( istep = 0; entry && istep < index; istep++ ) entry = entry->snext;
+   }
 
 /* Return a pointer to the key string. */
-      if( entry ) result = entry->key;
-   }
+   if( entry ) result = entry->key;
 
 /* Report an error if the element was not found. */
    if( !result && astOK ) {
@@ -3391,7 +3227,7 @@ static int GetSizeGuess( AstKeyMap *this, int *status ) {
 
 /* Return the attribute value using a default if not set. */
    return ( this->sizeguess == INT_MAX ) ?
-           MIN_TABLE_SIZE*MAX_ENTRIES_PER_TABLE_ENTRY : this->sizeguess;
+           DEFAULT_SIZE_GUESS : this->sizeguess;
 }
 
 static int HashFun( const char *key, int bitmask, unsigned long *hash, int *status ){
@@ -3578,6 +3414,8 @@ void astInitKeyMapVtab_(  AstKeyMapVtab *vtab, const char *name, int *status ) {
    vtab->MapHasKey = MapHasKey;
    vtab->MapKey = MapKey;
    vtab->MapIterate = MapIterate;
+   vtab->MapShare = MapShare;
+   vtab->MapSync = MapSync;
 
    vtab->ClearSizeGuess = ClearSizeGuess;
    vtab->SetSizeGuess = SetSizeGuess;
@@ -3678,15 +3516,12 @@ static void InitMapEntry( AstMapEntry *entry, int type, int nel, int *status ){
    if( !astOK ) return;
 
 /* Initialise all elements with in the MapEntry structure. */
-   entry->next = NULL;
    entry->key = NULL;
    entry->hash = 0;
    entry->type = type;
    entry->nel = nel;
    entry->comment = NULL;
    entry->defined = 0;
-   entry->snext = NULL;
-   entry->sprev = NULL;
    entry->member = 0;
    entry->keymember = 0;
    entry->sortby = SORTBY_NONE;
@@ -3952,23 +3787,25 @@ f        The global status.
    AstObject *in_obj;     /* Pointer for source Object entry */
    AstObject *out_obj;    /* Pointer for destination Object entry */
    const char *key;       /* Key for current entry */
-   int i;                 /* Index into source hash table */
+   int i;                 /* Index into source array of entries */
    int itab;              /* Index of destination hash table element */
-   int keymember;         /* Identifier for key */
    int merged;            /* Were source and destination KeyMaps merged? */
    unsigned long hash;    /* Full width hash value */
 
 /* Check the global error status. */
    if ( !astOK ) return;
 
-/* Loop round all entries in the source hash table. */
-   for( i = 0; i < that->mapsize; i++ ) {
+/* Ensure all entries in both KeyMaps are held in their hash tables. */
+   astMapSync( this );
+   astMapSync( that );
 
-/* Get a pointer to the next source KeyMap entry. */
-      in_entry = that->table[ i ];
+/* Loop round all entries in the source KeyMap. */
+   for( i = 0; i < that->nentry && astOK; i++ ) {
 
-/* Loop round all entries in this element of the source hash table. */
-      while( in_entry && astOK ) {
+/* Get a pointer to the next source KeyMap entry, skipping over any
+   entries that have been removed. */
+      in_entry = that->entry[ i ];
+      if( in_entry ) {
 
 /* Get its key. */
          key = in_entry->key;
@@ -3987,7 +3824,7 @@ f        The global status.
                          astGetClass( this ), key, key );
             } else {
                out_entry = CopyMapEntry( in_entry, status );
-               out_entry = AddTableEntry( this, itab, out_entry, -1, status );
+               out_entry = AddTableEntry( this, out_entry, -1, status );
             }
 
 /* If the destination KeyMap contains an entry with the current key... */
@@ -4027,21 +3864,16 @@ f        The global status.
                }
             }
 
-/* If the source and desination entries are not KeyMaps, then just remove
-   the entry in the desination KeyMap and add a copy of the source entry.
-   But retain the original keymember value since we are just changing the
-   value of an existing key. */
+/* If the source and desination entries are not KeyMaps, then just replace
+   the entry in the desination KeyMap with a copy of the source entry.
+   This retains the position and keymember value of the original entry
+   since we are just changing the value of an existing key. */
             if( ! merged ) {
-               out_entry = RemoveTableEntry( this, itab, key, status );
-               keymember = out_entry->keymember;
-               (void) FreeMapEntry( out_entry, status );
                out_entry = CopyMapEntry( in_entry, status );
-               out_entry = AddTableEntry( this, itab, out_entry, keymember, status );
+               (void) FreeMapEntry( ReplaceTableEntry( this, itab, out_entry,
+                                                       status ), status );
             }
          }
-
-/* Update the address of the next MapEntry in the source. */
-         in_entry = in_entry->next;
       }
    }
 }
@@ -4140,7 +3972,9 @@ f     reason.
       for ( i = 0; i < AST__KEYMAP_MAPKEY_MAX_STRINGS; i++ ) mapkey_strings[ i ] = NULL;
    }
 
-/* Obtain a pointer to the required key value. */
+/* Ensure all entries are held in the hash table, then obtain a pointer
+   to the required key value. */
+   astMapSync( this );
    value = GetKey( this, index, status );
 
 /* If OK, store a copy of the resulting string in dynamically
@@ -4290,7 +4124,6 @@ static void MapPut0##X( AstKeyMap *this, const char *skey, Xtype value, \
    char keybuf[ AST__MXKEYLEN + 1 ]; /* Buffer for upper cas key */ \
    int itab;               /* Index of hash table element to use */ \
    int keylen;             /* Length of supplied key string */ \
-   int keymember;          /* Identifier for existing key */ \
    int there;              /* Did the entry already exist in the KeyMap? */ \
 \
 /* Check the global error status. */ \
@@ -4334,15 +4167,14 @@ static void MapPut0##X( AstKeyMap *this, const char *skey, Xtype value, \
    which to store the new entry. */ \
       itab = HashFun( mapentry->key, this->mapsize - 1, &(mapentry->hash), status ); \
 \
-/* Remove any existing entry with the given key from the table element. \
-   First save the key identifier. */ \
-      oldent = RemoveTableEntry( this, itab, mapentry->key, status ); \
+/* If the KeyMap already contains an entry with the given key, replace \
+   it with the new entry (retaining its position in the KeyMap), and free \
+   it. */ \
+      oldent = ReplaceTableEntry( this, itab, mapentry, status ); \
       if( oldent ) { \
-         keymember = oldent->keymember; \
          oldent = FreeMapEntry( oldent, status ); \
          there = 1; \
       } else { \
-         keymember = -1; \
          there = 0; \
       } \
 \
@@ -4353,14 +4185,15 @@ static void MapPut0##X( AstKeyMap *this, const char *skey, Xtype value, \
                    "\"%s\" is not a known item.", status, astGetClass( this ), key, key ); \
       } \
 \
-/* If all has gone OK, store the new entry at the head of the linked list \
-   associated with the selected table entry. */ \
-      if( astOK ) { \
-         mapentry = AddTableEntry( this, itab, mapentry, keymember, status ); \
+/* If the key is new and all has gone OK, add the new entry to the KeyMap. */ \
+      if( !there ) { \
+         if( astOK ) { \
+            mapentry = AddTableEntry( this, mapentry, -1, status ); \
 \
 /* If anything went wrong, try to delete the new entry. */ \
-      } else { \
-         mapentry = FreeMapEntry( mapentry, status ); \
+         } else { \
+            mapentry = FreeMapEntry( mapentry, status ); \
+         } \
       } \
    } \
 }
@@ -4516,7 +4349,6 @@ static void MapPut1##X( AstKeyMap *this, const char *skey, int size, \
    int itab;               /* Index of hash table element to use */ \
    int i;                  /* Loop count */ \
    int keylen;             /* Length of supplied key string */ \
-   int keymember;          /* Identifier for existing key */ \
    int there;              /* Did the entry already exist in the KeyMap? */ \
 \
 /* Check the global error status. */ \
@@ -4564,15 +4396,14 @@ static void MapPut1##X( AstKeyMap *this, const char *skey, int size, \
    which to store the new entry. */ \
       itab = HashFun( mapentry->key, this->mapsize - 1, &(mapentry->hash), status ); \
 \
-/* Remove any existing entry with the given key from the table element. \
-   First save the key identifier. */ \
-      oldent = RemoveTableEntry( this, itab, mapentry->key, status ); \
+/* If the KeyMap already contains an entry with the given key, replace \
+   it with the new entry (retaining its position in the KeyMap), and free \
+   it. */ \
+      oldent = ReplaceTableEntry( this, itab, mapentry, status ); \
       if( oldent ) { \
-         keymember = oldent->keymember; \
          oldent = FreeMapEntry( oldent, status ); \
          there = 1; \
       } else { \
-         keymember = -1; \
          there = 0; \
       } \
 \
@@ -4583,14 +4414,15 @@ static void MapPut1##X( AstKeyMap *this, const char *skey, int size, \
                    "\"%s\" is not a known item.", status, astGetClass( this ), key, key ); \
       } \
 \
-/* If all has gone OK, store the new entry at the head of the linked list \
-   associated with the selected table entry. */ \
-      if( astOK ) { \
-         mapentry = AddTableEntry( this, itab, mapentry, keymember, status ); \
+/* If the key is new and all has gone OK, add the new entry to the KeyMap. */ \
+      if( !there ) { \
+         if( astOK ) { \
+            mapentry = AddTableEntry( this, mapentry, -1, status ); \
 \
 /* If anything went wrong, try to delete the new entry. */ \
-      } else { \
-         mapentry = FreeMapEntry( mapentry, status ); \
+         } else { \
+            mapentry = FreeMapEntry( mapentry, status ); \
+         } \
       } \
    } \
 }
@@ -4675,7 +4507,6 @@ void astMapPut1AId_( AstKeyMap *this, const char *skey, int size,
    int i;                  /* Loop count */
    int itab;               /* Index of hash table element to use */
    int keylen;             /* Length of supplied key string */
-   int keymember;          /* Identifier for existing key */
    int there;              /* Did the entry already exist in the KeyMap? */
 
 /* Check the global error status. */
@@ -4721,15 +4552,15 @@ void astMapPut1AId_( AstKeyMap *this, const char *skey, int size,
    which to store the new entry. */
       itab = HashFun( mapentry->key, this->mapsize - 1, &(mapentry->hash), status );
 
-/* Remove any existing entry with the given key from the table element. */
-      oldent = RemoveTableEntry( this, itab, mapentry->key, status );
+/* If the KeyMap already contains an entry with the given key, replace
+   it with the new entry (retaining its position in the KeyMap), and free
+   it. */
+      oldent = ReplaceTableEntry( this, itab, mapentry, status );
       if( oldent ) {
-         keymember = oldent->keymember;
          oldent = FreeMapEntry( oldent, status );
          there = 1;
       } else {
          there = 0;
-         keymember = -1;
       }
 
 /* If the KeyMap is locked we report an error if an attempt is made to add a value for
@@ -4739,14 +4570,15 @@ void astMapPut1AId_( AstKeyMap *this, const char *skey, int size,
                    "\"%s\" is not a known item.", status, astGetClass( this ), key, key );
       }
 
-/* If all has gone OK, store the new entry at the head of the linked list
-   associated with the selected table entry. */
-      if( astOK ) {
-         mapentry = AddTableEntry( this, itab, mapentry, keymember, status );
+/* If the key is new and all has gone OK, add the new entry to the KeyMap. */
+      if( !there ) {
+         if( astOK ) {
+            mapentry = AddTableEntry( this, mapentry, -1, status );
 
 /* If anything went wrong, try to delete the new entry. */
-      } else {
-         mapentry = FreeMapEntry( mapentry, status );
+         } else {
+            mapentry = FreeMapEntry( mapentry, status );
+         }
       }
    }
 }
@@ -4819,7 +4651,6 @@ f        The global status.
    char *p;                /* Pointer to next key character */
    int itab;               /* Index of hash table element to use */
    int keylen;             /* Length of supplied key string */
-   int keymember;          /* Identifier for existing key */
    int there;              /* Did the entry already exist in the KeyMap? */
 
 /* Check the global error status. */
@@ -4858,14 +4689,14 @@ f        The global status.
    which to store the new entry. */
       itab = HashFun( mapentry->key, this->mapsize - 1, &(mapentry->hash), status );
 
-/* Remove any existing entry with the given key from the table element. */
-      oldent = RemoveTableEntry( this, itab, mapentry->key, status );
+/* If the KeyMap already contains an entry with the given key, replace
+   it with the new entry (retaining its position in the KeyMap), and free
+   it. */
+      oldent = ReplaceTableEntry( this, itab, mapentry, status );
       if( oldent ) {
-         keymember = oldent->keymember;
          oldent = FreeMapEntry( oldent, status );
          there = 1;
       } else {
-         keymember = -1;
          there = 0;
       }
 
@@ -4876,14 +4707,15 @@ f        The global status.
                    "\"%s\" is not a known item.", status, astGetClass( this ), key, key );
       }
 
-/* If all has gone OK, store the new entry at the head of the linked list
-   associated with the selected table entry. */
-      if( astOK ) {
-         mapentry = AddTableEntry( this, itab, mapentry, keymember, status );
+/* If the key is new and all has gone OK, add the new entry to the KeyMap. */
+      if( !there ) {
+         if( astOK ) {
+            mapentry = AddTableEntry( this, mapentry, -1, status );
 
 /* If anything went wrong, try to delete the new entry. */
-      } else {
-         mapentry = FreeMapEntry( mapentry, status );
+         } else {
+            mapentry = FreeMapEntry( mapentry, status );
+         }
       }
    }
 }
@@ -7030,6 +6862,9 @@ f        The global status.
 /* Check the global error status. */
    if ( !astOK ) return;
 
+/* Ensure all entries are held in the hash table. */
+   astMapSync( this );
+
 /* Convert the supplied keys to upper case if required. */
    oldkey = ConvertKey( this, soldkey, oldkeybuf, AST__MXKEYLEN + 1,
                         "astMapRename", status );
@@ -7090,10 +6925,9 @@ f        The global status.
                       newkey );
          }
 
-/* If all has gone OK, store the renamed entry at the head of the linked list
-   associated with the selected table entry. */
+/* If all has gone OK, store the renamed entry in the KeyMap. */
          if( astOK ) {
-            entry = AddTableEntry( this, itab, entry, keymember, status );
+            entry = AddTableEntry( this, entry, keymember, status );
 
 /* If anything went wrong, try to delete the renamed entry. */
          } else {
@@ -7103,6 +6937,181 @@ f        The global status.
    }
 }
 
+static AstKeyMapShare *MapShare( AstKeyMap *this, int *status ) {
+/*
+*++
+*  Name:
+c     astMapShare
+
+*  Purpose:
+*     Publish a snapshot of a KeyMap for lock-free concurrent reading.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "keymap.h"
+c     AstKeyMapShare *astMapShare( AstKeyMap *this )
+
+*  Class Membership:
+*     KeyMap method.
+
+*  Description:
+*     This function takes a read-only snapshot of the current contents
+*     of a KeyMap and publishes it, replacing any snapshot published by
+*     an earlier call. It returns a pointer to an opaque AstKeyMapShare
+*     structure through which the most recently published snapshot can
+*     be searched by the astMapShareGet0<X>, astMapShareGet1<X> and
+*     astMapShareHasKey functions.
+*
+*     A thread that uses these functions does not need to lock the
+*     KeyMap, so any number of threads may search the snapshot at the
+*     same time as each other and as the thread that owns the KeyMap,
+*     which may continue to modify the KeyMap in the usual way and call
+*     this function again to publish each new version. Readers see
+*     either the old or the new snapshot in its entirety, never a
+*     partially modified KeyMap. This makes a KeyMap suitable for
+*     configuration or look-up tables that are read by many threads
+*     but changed only occasionally.
+
+*  Parameters:
+c     this
+*        Pointer to the KeyMap.
+
+*  Returned Value:
+c     astMapShare()
+*        A pointer to the AstKeyMapShare. The same pointer is returned
+*        by every call for a given KeyMap. It should be passed to the
+*        reader threads by whatever means the application uses, and
+*        remains valid until the KeyMap is deleted.
+
+*  Notes:
+*     - Publishing a snapshot copies every entry in the KeyMap, so this
+*     function should not be called after every change to a KeyMap that
+*     is modified frequently.
+*     - Entries holding AST Object pointers are not included in the
+*     snapshot, since AST Objects may only be used by a thread that has
+*     locked them.
+*     - The memory used by a superseded snapshot is released as soon as
+*     the last read that is using it has finished. Before returning,
+*     this function waits for any reads that started before the new
+*     snapshot was published to note which snapshot they are using.
+*     This takes only a few instructions in each reader, and reads that
+*     start later do not delay it.
+*     - The KeyMap must not be deleted while any thread may still be
+*     using the AstKeyMapShare.
+*     - Subsequent copies of the KeyMap made using astCopy do not share
+*     the AstKeyMapShare.
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*--
+*/
+
+/* Local Variables: */
+   AstKeyMapShare *share;  /* Pointer to the KeyMapShare */
+   ShareSnap *old;         /* Previously published snapshot */
+   ShareSnap *snap;        /* New snapshot */
+   int i;                  /* Pass index */
+   int phase;              /* Element of nreader to wait for */
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Ensure all entries are in the hash table, then copy them into a new
+   snapshot. */
+   astMapSync( this );
+   snap = NewShareSnap( this, status );
+
+/* Create the KeyMapShare if this is the first snapshot to be published. */
+   share = this->share;
+   if( !share && astOK ) {
+      share = astMalloc( sizeof( AstKeyMapShare ) );
+      if( astOK ) {
+         share->current = NULL;
+         share->nreader[ 0 ] = 0;
+         share->nreader[ 1 ] = 0;
+         share->phase = 0;
+         this->share = share;
+      }
+   }
+
+/* Publish the new snapshot. Readers that load the "current" pointer
+   after this point will use the new snapshot. */
+   if( astOK ) {
+      old = SHARE_LOAD( &share->current );
+      SHARE_STORE( &share->current, snap );
+
+/* Any reader that loaded the old pointer may not yet have incremented
+   the old snapshot's reference count. Such readers are counted in one
+   of the two "nreader" elements. Direct new readers to the other element
+   and wait for the first to fall to zero, then do the same again with
+   the elements swapped. Each wait only has to outlast readers that are
+   already counted, since new readers use the other element and will load
+   the new pointer. Yield the processor while waiting, since the reader
+   may have been pre-empted. */
+      if( old ) {
+         for( i = 0; i < 2; i++ ) {
+            phase = SHARE_LOAD( &share->phase );
+            SHARE_STORE( &share->phase, !phase );
+            while( SHARE_LOAD( &share->nreader[ phase ] ) ) {
+#if defined(THREAD_SAFE)
+               (void) sched_yield();
+#endif
+            }
+         }
+
+/* Every reader using the old snapshot now holds a reference to it, so
+   drop the reference held on behalf of the KeyMapShare. The snapshot is
+   freed now if no reads are using it, or otherwise by the last of them
+   to finish. */
+         (void) ReleaseShareSnap( old, status );
+      }
+
+/* If an error occurred, free the new snapshot. */
+   } else {
+      snap = ReleaseShareSnap( snap, status );
+   }
+
+/* Return the KeyMapShare. */
+   return astOK ? share : NULL;
+}
+
+static void MapSync( AstKeyMap *this, int *status ) {
+/*
+*+
+*  Name:
+*     astMapSync
+
+*  Purpose:
+*     Ensure all entries are held in the KeyMap hash table.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     void astMapSync( AstKeyMap *this )
+
+*  Class Membership:
+*     KeyMap method.
+
+*  Description:
+*     This function is invoked before any operation that accesses the
+*     KeyMap hash table as a whole (e.g. counting, listing, copying or
+*     dumping the entries). Sub-classes that store some of their entries
+*     in some other form should over-ride it to move such entries into
+*     the hash table. The KeyMap implementation does nothing, since all
+*     KeyMap entries are always held in the hash table.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+
+*-
+*/
+}
+
 static int MapSize( AstKeyMap *this, int *status ) {
 /*
 *++
@@ -7147,7 +7156,6 @@ f     AST_MAPSIZE = INTEGER
 */
 
 /* Local Variables: */
-   int itab;               /* Index of hash table element to use */
    int result;             /* Returned value */
 
 /* Initialise */
@@ -7156,8 +7164,11 @@ f     AST_MAPSIZE = INTEGER
 /* Check the global error status. */
    if ( !astOK ) return result;
 
-/* Add up the number of entries in all elements of the hash table. */
-   for( itab = 0; itab < this->mapsize; itab++ ) result += this->nentry[ itab ];
+/* Ensure all entries are held in the hash table. */
+   astMapSync( this );
+
+/* Exclude any entries that have been removed from the array of entries. */
+   result = this->nentry - this->nfree;
 
 /* Return the result. */
    return result;
@@ -7968,7 +7979,7 @@ static const char *MapIterate( AstKeyMap *this, int reset, int *status ) {
 /* Local Variables: */
    AstMapEntry *entry;         /* Pointer to the entry */
    const char *key;            /* Pointer value to return */
-   int itab;                   /* Index into hash table */
+   int i;                      /* Index of next entry to check */
    int sortby;                 /* The value of the SortBy attribute */
 
 /* Initialise. */
@@ -7977,61 +7988,43 @@ static const char *MapIterate( AstKeyMap *this, int reset, int *status ) {
 /* Check the global error status. */
    if ( !astOK ) return key;
 
+/* When starting a new pass through the KeyMap, ensure all entries are
+   held in the hash table. */
+   if( reset ) astMapSync( this );
+
 /* Get the SortBy value. */
    sortby = astGetSortBy( this );
 
-/* First deal with unsorted keys. */
-   if( sortby == SORTBY_NONE ) {
-
-/* Get the index of the hash table to check first. Also get a pointer to
-   the entry within the hash table to check next. */
-      if( reset ){
-         itab = 0;
-         entry = this->table[ 0 ];
-      } else {
-         itab = this->iter_itab;
-         entry = this->iter_entry;
-      }
-
-/* Move through elements of the hash table until we have a non-null entry. */
-      while( !entry && ++itab < this->mapsize ) {
-         entry = this->table[ itab ];
-      }
-
-/* Return a pointer to the key. */
-      if( entry ) {
-         key = entry->key;
-
-/* Move on to the next entry in the unsorted linked list, saving the context
-   in the KeyMap structure. */
-         this->iter_itab = itab;
-         this->iter_entry = entry->next;
-      }
+/* Get the index of the next entry to check. */
+   i = reset ? 0 : this->iter_itab;
 
-/* Now deal with sorted keys. */
+/* First deal with unsorted keys. Move through the array of entries,
+   skipping over any entries that have been removed, until we have a
+   non-null entry. */
+   if( sortby == SORTBY_NONE ) {
+      entry = NULL;
+      while( !entry && i < this->nentry ) entry = this->entry[ i++ ];
+
+/* Now deal with sorted keys. If starting from the beginning, first
+   ensure the sorted list of entries is up to date. The list is not
+   re-created part way through a pass, so that the key most recently
+   returned can be removed from the KeyMap without disturbing the order
+   of the remaining keys. */
    } else {
-
-/* If starting from the beginning, use the "first" entry. Otherwise, use
-   the nxt entry. */
-      if( reset ) {
-         entry = this->first;
-      } else {
-         entry = this->iter_entry;
-      }
-
-/* If we have an entry, return a pointer to its key, and then update the
-   context to point to the next entry in the *sorted* list. */
-      if( entry ) {
-         key = entry->key;
-         this->iter_entry = entry->snext;
-      }
+      if( reset && this->resort ) SortEntries( this, status );
+      entry = ( i < this->nsorted ) ? this->sorted[ i++ ] : NULL;
    }
 
+/* If we have an entry, return a pointer to its key, and save the index
+   of the next entry to check in the KeyMap structure. */
+   if( entry ) {
+      key = entry->key;
+      this->iter_itab = i;
+
 /* If no more entries were found, reset the context in the KeyMap
    structure. */
-   if( ! key ) {
+   } else {
       this->iter_itab = 0;
-      this->iter_entry = NULL;
    }
 
 /* Return the result.*/
@@ -8073,7 +8066,7 @@ static void NewTable( AstKeyMap *this, int size, int *status ){
 */
 
 /* Local Variables: */
-   int i;
+   int itab;
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -8086,131 +8079,276 @@ static void NewTable( AstKeyMap *this, int size, int *status ){
    }
 
 /* Remove any existing entries. */
-   for( i = 0; i < this->mapsize; i++ ) FreeTableEntry( this, i, status );
+   FreeTableEntries( this, status );
 
 /* Do nothing more if the table size is not changing. */
    if( size != this->mapsize ) {
 
 /* Modify the size of the existing table. */
-      this->mapsize = size;
-      this->table = astGrow( this->table, size, sizeof( AstMapEntry * ) );
-      this->nentry = astGrow( this->nentry, size, sizeof( int ) );
+      this->table = astFree( this->table );
+      this->table = astMalloc( size*sizeof( int ) );
 
 /* Initialise the new table. */
       if( astOK ) {
-         for( i = 0; i < size; i++ ) {
-            this->table[ i ] = NULL;
-            this->nentry[ i ] = 0;
-         }
+         this->mapsize = size;
+         for( itab = 0; itab < size; itab++ ) this->table[ itab ] = EMPTY_ENTRY;
+      } else {
+         this->mapsize = 0;
       }
    }
 }
 
-static void RemoveFromObjectList( AstKeyMap *this, AstMapEntry *entry,
-                                  int *status ){
+static ShareSnap *NewShareSnap( AstKeyMap *this, int *status ){
 /*
 *  Name:
-*     RemoveFromObjectList
+*     NewShareSnap
 
 *  Purpose:
-*     Remove an entry from the linked-list of AST__OBJECTTYPE entries.
+*     Create a snapshot of a KeyMap for publication by astMapShare.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "keymap.h"
-*     void RemoveFromObjectList( AstKeyMap *this, AstMapEntry *entry,
-*                                int *status )
+*     ShareSnap *NewShareSnap( AstKeyMap *this, int *status )
 
 *  Class Membership:
 *     KeyMap member function.
 
 *  Description:
-*     This function removes the supplied MapEntry from the linked list of
-*     AST__OBJECTTYPE entries.
+*     This function returns a new snapshot holding deep copies of all
+*     the entries in a KeyMap, other than those holding AST Object
+*     pointers, together with a hash table that can be used to search
+*     them. The hash table is at most half full, so that a search for a
+*     missing key always finds an empty element.
 
 *  Parameters:
 *     this
 *        Pointer to the KeyMap.
-*     entry
-*        Pointer to the MapEntry to be removed.
 *     status
 *        Pointer to the inherited status variable.
 
+*  Returned Value:
+*     Pointer to the new snapshot. Its reference count is one. It should
+*     be released using ReleaseShareSnap when no longer needed.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
 */
 
 /* Local Variables: */
-   AstMapEntry *a;          /* Previous entry */
-   AstMapEntry *b;          /* Next entry */
-   Entry0A *scalar;         /* Pointer to a scalar AST__OBJECTTYPE entry */
-   Entry1A *vector;         /* Pointer to a vector AST__OBJECTTYPE entry */
+   AstMapEntry *entry;    /* Pointer to KeyMap entry */
+   ShareSnap *result;     /* Returned snapshot */
+   int bitmask;           /* Bit mask for hash table indices */
+   int i;                 /* Index into array of entries */
+   int itab;              /* Index into hash table */
+   int n;                 /* No. of entries to be copied */
 
 /* Check the global error status. */
-   if ( !astOK ) return;
+   if ( !astOK ) return NULL;
 
-/* Do nothing if the entry does not hold AST Object pointers. */
-   if( entry->type == AST__OBJECTTYPE ) {
+/* Count the entries to be copied. */
+   n = 0;
+   for( i = 0; i < this->nentry; i++ ) {
+      entry = this->entry[ i ];
+      if( entry && entry->type != AST__OBJECTTYPE ) n++;
+   }
 
-/* Get pointers to the MapEntries before and after the entry being
-   removed. At the same time, nullify both pointers in the entry itself. */
-      if( entry->nel == 0 ) {
-         scalar = (Entry0A *) entry;
-         a = scalar->prev;
-         b = scalar->next;
-         scalar->prev = NULL;
-         scalar->next = NULL;
-      } else {
-         vector = (Entry1A *) entry;
-         a = vector->prev;
-         b = vector->next;
-         vector->prev = NULL;
-         vector->next = NULL;
+/* Allocate the snapshot and its arrays. */
+   result = astMalloc( sizeof( ShareSnap ) );
+   if( astOK ) {
+      result->keycase = astGetKeyCase( this );
+      result->keyerror = astGetKeyError( this );
+      result->nentry = 0;
+      result->nref = 1;
+      result->mapsize = MIN_TABLE_SIZE;
+      while( result->mapsize < MAX_TABLE_LOAD*n ) result->mapsize *= 2;
+      result->table = astMalloc( sizeof( int )*result->mapsize );
+      result->entry = astMalloc( sizeof( AstMapEntry * )*( n > 0 ? n : 1 ) );
+
+/* Copy each entry, storing its index in the first free element of the
+   hash table at or after the element given by its hash value. */
+      if( astOK ) {
+         for( itab = 0; itab < result->mapsize; itab++ ) {
+            result->table[ itab ] = EMPTY_ENTRY;
+         }
+         bitmask = result->mapsize - 1;
+         for( i = 0; i < this->nentry && astOK; i++ ) {
+            entry = this->entry[ i ];
+            if( entry && entry->type != AST__OBJECTTYPE ) {
+               entry = CopyMapEntry( entry, status );
+               if( astOK ) {
+                  itab = entry->hash & bitmask;
+                  while( result->table[ itab ] != EMPTY_ENTRY ) {
+                     itab = ( itab + 1 ) & bitmask;
+                  }
+                  result->table[ itab ] = result->nentry;
+                  result->entry[ result->nentry++ ] = entry;
+               }
+            }
+         }
       }
 
-/* Set the forward link in the previous entry. */
-      if( a ) {
-         if( a->nel == 0 ) {
-            scalar = (Entry0A *) a;
-            scalar->next = b;
-         } else {
-            vector = (Entry1A *) a;
-            vector->next = b;
-         }
+/* If an error occurred, free the snapshot. */
+      if( !astOK ) result = FreeShareSnap( result, status );
+   }
 
-/* If we are removing the list head, store the following entry as the new head. */
-      } else {
-         this->firstA = b;
-      }
+/* Return the result. */
+   return result;
+}
 
-/* Set the backward link in the next entry. */
-      if( b ) {
-         if( b->nel == 0 ) {
-            scalar = (Entry0A *) b;
-            scalar->prev = a;
-         } else {
-            vector = (Entry1A *) b;
-            vector->prev = a;
+static void Rehash( AstKeyMap *this, int *status ) {
+/*
+*  Name:
+*     Rehash
+
+*  Purpose:
+*     Re-build the hash table in a KeyMap.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     void Rehash( AstKeyMap *this, int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function removes any unused elements from the array of
+*     MapEntries held in the KeyMap (retaining the order of the remaining
+*     entries), and then creates a new hash table holding the new index of
+*     each entry. The new hash table is made large enough to ensure that
+*     it is no more than one quarter full, and is never smaller than the
+*     existing hash table. Elements of the existing hash table that are
+*     marked as deleted are not transferred to the new table.
+
+*  Parameters:
+*     this
+*        The KeyMap pointer.
+*     status
+*        Pointer to the inherited status variable.
+
+*/
+
+/* Local Variables: */
+   AstMapEntry *entry;         /* Pointer to the next entry */
+   int *newtable;              /* Pointer to the new hash table */
+   int bitmask;                /* Bit mask for hash table indices */
+   int i;                      /* Index into array of entries */
+   int itab;                   /* Index into new hash table */
+   int newmapsize;             /* Size of new hash table */
+   int nlive;                  /* Number of entries in the KeyMap */
+
+/* Check the global error status. */
+   if( !astOK ) return;
+
+/* Determine the new hash table size. Since mapsize starts out as a power
+   of 2 (ensured by the NewTable function), the new mapsize will also be
+   a power of 2. Also, create a bit mask that can be used to zero the
+   upper bits in a full width hash value. */
+   nlive = this->nentry - this->nfree;
+   newmapsize = ( this->mapsize > MIN_TABLE_SIZE ) ? this->mapsize : MIN_TABLE_SIZE;
+   while( 2*MAX_TABLE_LOAD*( nlive + 1 ) > newmapsize ) newmapsize *= 2;
+   bitmask = newmapsize - 1;
+
+/* Create the new hash table, leaving the old table intact for the
+   moment. */
+   newtable = astMalloc( newmapsize*sizeof( int ) );
+   if( astOK ) {
+
+/* Initialise the new table. */
+      for( itab = 0; itab < newmapsize; itab++ ) newtable[ itab ] = EMPTY_ENTRY;
+
+/* Shuffle the remaining entries down to the start of the array of
+   entries, storing the new index of each one in the new hash table. */
+      nlive = 0;
+      for( i = 0; i < this->nentry; i++ ) {
+         entry = this->entry[ i ];
+         if( entry ) {
+            itab = (int) ( entry->hash & bitmask );
+            while( newtable[ itab ] != EMPTY_ENTRY ) itab = ( itab + 1 ) & bitmask;
+            newtable[ itab ] = nlive;
+            this->entry[ nlive++ ] = entry;
          }
       }
+
+/* Delete the existing table and use the new table */
+      (void) astFree( this->table );
+      this->table = newtable;
+      this->mapsize = newmapsize;
+      this->nentry = nlive;
+      this->nfree = 0;
+      this->ndead = 0;
    }
 }
 
-static void RemoveFromSortedList( AstKeyMap *this, AstMapEntry *entry,
+static ShareSnap *ReleaseShareSnap( ShareSnap *snap, int *status ){
+/*
+*  Name:
+*     ReleaseShareSnap
+
+*  Purpose:
+*     Release a reference to a snapshot published by astMapShare.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     ShareSnap *ReleaseShareSnap( ShareSnap *snap, int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function decrements the reference count of a snapshot, and
+*     frees the snapshot if the count falls to zero. A snapshot holds
+*     one reference while it is published, and one for each read that
+*     is using it.
+
+*  Parameters:
+*     snap
+*        Pointer to the snapshot. NULL may be supplied, in which case
+*        nothing is done.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A NULL pointer.
+
+*  Notes:
+*     - This function attempts to execute even if it is invoked with the
+*     global error status set.
+*/
+
+/* Check the supplied pointer. */
+   if( !snap ) return NULL;
+
+/* Free the snapshot when the last reference is released. */
+   if( SHARE_ADD( &snap->nref, -1 ) == 0 ) (void) FreeShareSnap( snap, status );
+   return NULL;
+}
+
+static void RemoveFromObjectList( AstKeyMap *this, AstMapEntry *entry,
                                   int *status ){
 /*
 *  Name:
-*     RemoveFromSortedList
+*     RemoveFromObjectList
 
 *  Purpose:
-*     Remove an entry from the linked-list of sorted KeyMap entries.
+*     Remove an entry from the linked-list of AST__OBJECTTYPE entries.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "keymap.h"
-*     void RemoveFromSortedList( AstKeyMap *this, AstMapEntry *entry,
+*     void RemoveFromObjectList( AstKeyMap *this, AstMapEntry *entry,
 *                                int *status )
 
 *  Class Membership:
@@ -8218,7 +8356,7 @@ static void RemoveFromSortedList( AstKeyMap *this, AstMapEntry *entry,
 
 *  Description:
 *     This function removes the supplied MapEntry from the linked list of
-*     sorted MapEntries.
+*     AST__OBJECTTYPE entries.
 
 *  Parameters:
 *     this
@@ -8231,37 +8369,57 @@ static void RemoveFromSortedList( AstKeyMap *this, AstMapEntry *entry,
 */
 
 /* Local Variables: */
-   AstMapEntry *next;       /* Next higher MapEntry */
-   AstMapEntry *prev;       /* Next lower MapEntry */
+   AstMapEntry *a;          /* Previous entry */
+   AstMapEntry *b;          /* Next entry */
+   Entry0A *scalar;         /* Pointer to a scalar AST__OBJECTTYPE entry */
+   Entry1A *vector;         /* Pointer to a vector AST__OBJECTTYPE entry */
 
 /* Check the global error status. */
    if ( !astOK ) return;
 
-/* Get pointers to the entries on either side of the entry to be removed. */
-   next = entry->snext;
-   prev = entry->sprev;
-
-/* If the entry is not in the sorted list, abort. */
-   if( next && prev ) {
+/* Do nothing if the entry does not hold AST Object pointers. */
+   if( entry->type == AST__OBJECTTYPE ) {
 
-/* Connect the previous to the next, bypassing the entry being removed. */
-      next->sprev = prev;
-      prev->snext = next;
+/* Get pointers to the MapEntries before and after the entry being
+   removed. At the same time, nullify both pointers in the entry itself. */
+      if( entry->nel == 0 ) {
+         scalar = (Entry0A *) entry;
+         a = scalar->prev;
+         b = scalar->next;
+         scalar->prev = NULL;
+         scalar->next = NULL;
+      } else {
+         vector = (Entry1A *) entry;
+         a = vector->prev;
+         b = vector->next;
+         vector->prev = NULL;
+         vector->next = NULL;
+      }
 
-/* NULLify the next and previous entries stored in the entry being
-   removed. */
-      entry->snext = NULL;
-      entry->sprev = NULL;
+/* Set the forward link in the previous entry. */
+      if( a ) {
+         if( a->nel == 0 ) {
+            scalar = (Entry0A *) a;
+            scalar->next = b;
+         } else {
+            vector = (Entry1A *) a;
+            vector->next = b;
+         }
 
-/* Decrement the number of entries in the sorted list. */
-      (this->nsorted)--;
+/* If we are removing the list head, store the following entry as the new head. */
+      } else {
+         this->firstA = b;
+      }
 
-/* If the entry being removed is the first entry, store a pointer to the new
-   first entry. */
-      if( this->nsorted == 0 ) {
-         this->first = NULL;
-      } else if( entry == this->first ) {
-         this->first = next;
+/* Set the backward link in the next entry. */
+      if( b ) {
+         if( b->nel == 0 ) {
+            scalar = (Entry0A *) b;
+            scalar->prev = a;
+         } else {
+            vector = (Entry1A *) b;
+            vector->prev = a;
+         }
       }
    }
 }
@@ -8273,7 +8431,7 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
 *     RemoveTableEntry
 
 *  Purpose:
-*     Remove an entry from a linked-list of KeyMap entries.
+*     Remove an entry from a KeyMap.
 
 *  Type:
 *     Private function.
@@ -8287,16 +8445,18 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
 *     KeyMap member function.
 
 *  Description:
-*     This function removes any entries with the specified key from the
-*     linked-list of entries stored at the specified entry of the hash
-*     table. If the supplied key is found in the list, a pointer to the
-*     first removed entry is returned. Otherwise, a NULL pointer is returned.
+*     This function removes the entry with the specified key from the
+*     KeyMap, searching the hash table from the specified element onwards.
+*     If the supplied key is found, a pointer to the removed entry is
+*     returned (the caller should free it if it is no longer needed).
+*     Otherwise, a NULL pointer is returned.
 
 *  Parameters:
 *     this
 *        Pointer to the KeyMap.
 *     itab
-*        Index of the hash table element to be searched.
+*        Index of the hash table element at which to start searching.
+*        This should be the value returned by HashFun for the key.
 *     key
 *        The key string to be searched for. Trailing spaces are ignored.
 *     status
@@ -8308,9 +8468,8 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
 */
 
 /* Local Variables: */
-   AstMapEntry **link;    /* Address to store foward link */
-   AstMapEntry *next;     /* Pointer to next Entry to copy */
-   AstMapEntry *result;
+   AstMapEntry *result;   /* Returned pointer */
+   int ient;              /* Index into array of entries */
 
 /* Initialise */
    result = NULL;
@@ -8318,57 +8477,120 @@ static AstMapEntry *RemoveTableEntry( AstKeyMap *this, int itab,
 /* Check the global error status. */
    if ( !astOK ) return result;
 
-/* The "next" variable holds the address of the next MapEntry to be
-   checked. Initialise this to the MapEntry at the head of the linked
-   list associated with the supplied element of the hash table. */
-   next = this->table[ itab ];
+/* Find the element of the hash table that refers to the required key. */
+   itab = FindTableEntry( this, itab, key, status );
+   if( itab >= 0 ) {
 
-/* The "link" variable holds the address of the location at which the
-   pointer to the MapEntry following the removed MapEntry should be stored.
-   Initialise this to be the address of the hash table element. */
-   link = &( this->table[ itab ] );
+/* Get a pointer to the MapEntry. */
+      ient = this->table[ itab ];
+      result = this->entry[ ient ];
 
-/* Loop round until we have checked all entries. */
-   while( next && astOK ) {
+/* If the entry is of type AST__OBJECTTYPE, remove it from the
+   list of AST__OBJECTTYPE entries. */
+      RemoveFromObjectList( this, result, status );
+
+/* Mark the hash table element as deleted (rather than empty) so that
+   searches for other keys continue past it, and leave a gap in the
+   array of entries. The gap is removed next time the hash table is
+   re-built. Gaps at the end of the array are removed immediately. */
+      this->table[ itab ] = DELETED_ENTRY;
+      (this->ndead)++;
+
+      this->entry[ ient ] = NULL;
+      (this->nfree)++;
+      while( this->nentry > 0 && !this->entry[ this->nentry - 1 ] ) {
+         (this->nentry)--;
+         (this->nfree)--;
+      }
 
-/* If the key for the current entry macthes the supplied key... */
-      if( !KeyCmp( next->key, key ) ) {
+/* The sorted list of entries will need to be re-created before it is
+   next used. */
+      this->resort = 1;
+   }
 
-/* Remove the MapEntry from the list sorted by key. */
-         RemoveFromSortedList( this, next, status );
+/* Return the result */
+   return result;
+}
 
-/* If the entry is of type AST__OBJECTTYPE, remove it from the
-   list of AST__OBJECTTYPE entries. */
-         RemoveFromObjectList( this, next, status );
+static AstMapEntry *ReplaceTableEntry( AstKeyMap *this, int itab,
+                                       AstMapEntry *entry, int *status ){
+/*
+*  Name:
+*     ReplaceTableEntry
 
-/* Store a pointer to the next MapEntry in the list, replacing the
-   original pointer to the MapEntry which is being deleted. */
-         *link = next->next;
+*  Purpose:
+*     Replace the value of an existing key in a KeyMap.
 
-/* Return a pointer to the first matching MapEntry. Free any subsequent
-   matching MapEntries.  */
-         if( result ) {
-            FreeMapEntry( next, status );
-         } else {
-            result = next;
-         }
+*  Type:
+*     Private function.
 
-/* Decrement the number of entries in the linked list. */
-         this->nentry[ itab ]--;
+*  Synopsis:
+*     #include "keymap.h"
+*     AstMapEntry *ReplaceTableEntry( AstKeyMap *this, int itab,
+*                                     AstMapEntry *entry, int *status )
 
-/* Set up the next MapEntry to be freed. */
-         next = *link;
+*  Class Membership:
+*     KeyMap member function.
 
-/* If the key for the current entry does not match the supplied key... */
-      } else {
+*  Description:
+*     This function searches the KeyMap for an entry with the same key as
+*     the supplied MapEntry, starting at the specified element of the hash
+*     table. If one is found, the supplied MapEntry is stored in its place,
+*     so that the key retains its position in the array of entries (and
+*     so its position in the list of keys when SortBy is "None"), and
+*     a pointer to the replaced MapEntry is returned (the caller should
+*     free it if it is no longer needed). Otherwise, the KeyMap is left
+*     unchanged and a NULL pointer is returned.
+
+*  Parameters:
+*     this
+*        Pointer to the KeyMap.
+*     itab
+*        Index of the hash table element at which to start searching.
+*        This should be the value returned by HashFun for the key.
+*     entry
+*        Pointer to the new MapEntry.
+*     status
+*        Pointer to the inherited status variable.
 
-/* Update the address at which to store the pointer to the next MapEntry
-   in the list. */
-         link = &(next->next);
+*  Returned Value:
+*     Pointer to the replaced MapEntry, or NULL if no matching entry was
+*     found.
 
-/* Update the address of the next MapEntry in the list. */
-         next = next->next;
-      }
+*/
+
+/* Local Variables: */
+   AstMapEntry *result;   /* Returned pointer */
+   int ient;              /* Index into array of entries */
+
+/* Initialise */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Find the element of the hash table that refers to the required key. */
+   itab = FindTableEntry( this, itab, entry->key, status );
+   if( itab >= 0 ) {
+
+/* Get a pointer to the existing MapEntry, and remove it from the list of
+   AST__OBJECTTYPE entries if necessary. */
+      ient = this->table[ itab ];
+      result = this->entry[ ient ];
+      RemoveFromObjectList( this, result, status );
+
+/* Store the new MapEntry in the same element of the array of entries.
+   The hash table needs no change since it holds the index of the element.
+   The new value gets a new member index, but the key retains its
+   existing key member index. */
+      this->entry[ ient ] = entry;
+      entry->member = (this->member_count)++;
+      entry->keymember = result->keymember;
+      AddToObjectList( this, entry, status );
+
+/* The sorted list of entries will need to be re-created before it is
+   next used. */
+      this->resort = 1;
    }
 
 /* Return the result */
@@ -8381,7 +8603,7 @@ static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key
 *     SearchTableEntry
 
 *  Purpose:
-*     Search an element of a has table for a given key.
+*     Search a KeyMap for a given key.
 
 *  Type:
 *     Private function.
@@ -8394,29 +8616,30 @@ static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key
 *     KeyMap member function.
 
 *  Description:
-*     This function searches the specified element of the KeyMaps hash table
-*     until an element is found which has a key matching the supplied key.
-*     The address of this entry is returned. If no suitable entry is found,
-*     then NULL is returned.
+*     This function searches the KeyMaps hash table, starting at the
+*     specified element, until an element is found which refers to an
+*     entry with a key matching the supplied key. The address of this
+*     entry is returned. If no suitable entry is found, then NULL is
+*     returned.
 
 *  Parameters:
 *     this
 *        Pointer to the KeyMap.
 *     itab
-*        The index of the hash table to be searched.
+*        Index of the hash table element at which to start searching.
+*        This should be the value returned by HashFun for the key.
 *     key
 *        The key string to be searched for. Trailing spaces are ignored.
 *     status
 *        Pointer to the inherited status variable.
 
 *  Returned Value:
-*     The address of the first MapEntry in the linked list which refers
-*     to the given key, or NULL if the key is not found.
+*     The address of the MapEntry which refers to the given key, or NULL
+*     if the key is not found.
 
 */
 
 /* Local Variables: */
-   AstMapEntry *next;     /* Pointer to next Entry to check */
    AstMapEntry *result;   /* Returned pointer */
 
 /* Initialise */
@@ -8425,24 +8648,10 @@ static AstMapEntry *SearchTableEntry( AstKeyMap *this, int itab, const char *key
 /* Check the global error status. */
    if ( !astOK ) return result;
 
-/* The "next" variable holds the address of the next MapEntry to be
-   checked. Initialise this to the supplied MapEntry. */
-   next = this->table[ itab ];
-
-/* Loop round until we have checked all entries. */
-   while( next ) {
-
-/* If the key for the current entry matches the supplied key, store the
-   MapEntry pointer and break. */
-      if( !KeyCmp( next->key, key ) ) {
-         result = next;
-         break;
-      }
-
-/* Update the address of the next MapEntry in the list. */
-      next = next->next;
-
-   }
+/* Find the element of the hash table that refers to the required key,
+   and return a pointer to the corresponding MapEntry. */
+   itab = FindTableEntry( this, itab, key, status );
+   if( itab >= 0 ) result = this->entry[ this->table[ itab ] ];
 
 /* Return the result. */
    return result;
@@ -8586,7 +8795,6 @@ static void SetKeyCase( AstKeyMap *this, int keycase, int *status ) {
 
 /* Local Variables: */
    int ok;                    /* Can the KeyCase value be changed? */
-   int itab;                  /* Index into hash table */
    int newval;                /* New KeyCase value */
 
 /* Check the global error status. */
@@ -8597,14 +8805,7 @@ static void SetKeyCase( AstKeyMap *this, int keycase, int *status ) {
 
 /* If the KeyCase value is to be changed, see if the KeyMap is empty. */
    ok = 1;
-   if( astGetKeyCase( this ) != newval ) {
-      for( itab = 0; itab < this->mapsize; itab++ ) {
-         if( this->nentry[ itab ] > 0 ) {
-            ok = 0;
-            break;
-         }
-      }
-   }
+   if( astGetKeyCase( this ) != newval ) ok = ( this->nentry - this->nfree == 0 );
 
 /* If not report an error. */
    if( !ok ) {
@@ -8652,7 +8853,7 @@ static void SetKeyError( AstKeyMap *this, int keyerror, int *status ) {
 /* Local Variables: */
    AstMapEntry *next;     /* Pointer to next Entry to copy */
    AstObject **obj_list;  /* List of pointers to AST Object entries */
-   int i;                 /* Index into hash table */
+   int i;                 /* Index into array of entries */
    int iel;               /* Index of current vector element */
    int nel;               /* Number of elements in vector */
 
@@ -8662,14 +8863,11 @@ static void SetKeyError( AstKeyMap *this, int keyerror, int *status ) {
 /* Set the KeyError value in the supplied KeyMap. */
    this->keyerror = keyerror ? 1 : 0;
 
-/* Loop round each entry in the hash table. */
-   for( i = 0; i < this->mapsize; i++ ) {
-
-/* Get a pointer to the next KeyMap entry. */
-      next = this->table[ i ];
-
-/* Loop round all entries in this element of the hash table. */
-      while( next && astOK ) {
+/* Loop round each entry in the KeyMap, skipping over any entries that
+   have been removed. */
+   for( i = 0; i < this->nentry && astOK; i++ ) {
+      next = this->entry[ i ];
+      if( next ) {
 
 /* If this entry has an Object data type, see if holds any KeyMaps. */
          if( next->type == AST__OBJECTTYPE ) {
@@ -8692,9 +8890,6 @@ static void SetKeyError( AstKeyMap *this, int keyerror, int *status ) {
                }
             }
          }
-
-/* Get a pointer to the next entry. */
-         next = next->next;
       }
    }
 }
@@ -8734,7 +8929,7 @@ static void SetMapLocked( AstKeyMap *this, int maplocked, int *status ) {
 /* Local Variables: */
    AstMapEntry *next;     /* Pointer to next Entry to copy */
    AstObject **obj_list;  /* List of pointers to AST Object entries */
-   int i;                 /* Index into hash table */
+   int i;                 /* Index into array of entries */
    int iel;               /* Index of current vector element */
    int nel;               /* Number of elements in vector */
 
@@ -8744,14 +8939,11 @@ static void SetMapLocked( AstKeyMap *this, int maplocked, int *status ) {
 /* Set the MapLocked value in the supplied KeyMap. */
    this->maplocked = maplocked ? 1 : 0;
 
-/* Loop round each entry in the hash table. */
-   for( i = 0; i < this->mapsize; i++ ) {
-
-/* Get a pointer to the next KeyMap entry. */
-      next = this->table[ i ];
-
-/* Loop round all entries in this element of the hash table. */
-      while( next && astOK ) {
+/* Loop round each entry in the KeyMap, skipping over any entries that
+   have been removed. */
+   for( i = 0; i < this->nentry && astOK; i++ ) {
+      next = this->entry[ i ];
+      if( next ) {
 
 /* If this entry has an Object data type, see if holds any KeyMaps. */
          if( next->type == AST__OBJECTTYPE ) {
@@ -8774,9 +8966,6 @@ static void SetMapLocked( AstKeyMap *this, int maplocked, int *status ) {
                }
             }
          }
-
-/* Get a pointer to the next entry. */
-         next = next->next;
       }
    }
 }
@@ -8815,19 +9004,12 @@ static void SetSizeGuess( AstKeyMap *this, int sizeguess, int *status ) {
 
 /* Local Variables: */
    int empty;                 /* Is the KeyMap empty? */
-   int itab;                  /* Index into hash table */
 
 /* Check the global error status. */
    if ( !astOK ) return;
 
 /* See if the KeyMap is empty. */
-   empty = 1;
-   for( itab = 0; itab < this->mapsize; itab++ ) {
-      if( this->nentry[ itab ] > 0 ) {
-         empty = 0;
-         break;
-      }
-   }
+   empty = ( this->nentry - this->nfree == 0 );
 
 /* If not report an error. */
    if( !empty ) {
@@ -8838,7 +9020,8 @@ static void SetSizeGuess( AstKeyMap *this, int sizeguess, int *status ) {
    table. */
    } else {
       this->sizeguess = sizeguess;
-      NewTable( this, sizeguess/MAX_ENTRIES_PER_TABLE_ENTRY, status );
+      NewTable( this, ( sizeguess < INT_MAX/MAX_TABLE_LOAD ) ?
+                      MAX_TABLE_LOAD*sizeguess : INT_MAX/MAX_TABLE_LOAD, status );
    }
 }
 
@@ -8885,11 +9068,366 @@ static void SetSortBy( AstKeyMap *this, int sortby, int *status ) {
 /* Set the new SortBy value. */
    this->sortby = sortby;
 
-/* If the value has changed, re-sort the keys. */
-   if( oldval != sortby ) SortEntries( this, status );
+/* If the value has changed, the keys will need to be re-sorted before
+   they are next used. */
+   if( oldval != sortby ) this->resort = 1;
 
 }
 
+static AstMapEntry *ShareFind( ShareSnap *snap, const char *skey,
+                               const char *method, int *status ){
+/*
+*  Name:
+*     ShareFind
+
+*  Purpose:
+*     Search a published KeyMap snapshot for a given key.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     AstMapEntry *ShareFind( ShareSnap *snap, const char *skey,
+*                             const char *method, int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function searches the hash table of a snapshot published by
+*     astMapShare for an entry with the given key. The key is first
+*     converted to upper case if the KeyMap from which the snapshot was
+*     taken had a zero value for its KeyCase attribute. The snapshot is
+*     not modified, so this function may be invoked by several threads
+*     at once.
+
+*  Parameters:
+*     snap
+*        Pointer to the snapshot.
+*     skey
+*        The key string to be searched for. Trailing spaces are ignored.
+*     method
+*        Pointer to a string holding the name of the method to include in
+*        any error message.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the entry with the given key, or NULL if the key is not
+*     found.
+
+*  Notes:
+*     - NULL will be returned if this function is invoked with the global
+*     error status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstMapEntry *result;   /* Returned pointer */
+   char keybuf[ AST__MXKEYLEN + 1 ]; /* Buffer for upper case key */
+   const char *key;       /* Pointer to key string to use */
+   int bitmask;           /* Bit mask for hash table indices */
+   int ient;              /* Index into array of entries */
+   int itab;              /* Index into hash table */
+   unsigned long hash;    /* Full width hash value */
+
+/* Initialise */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Convert the supplied key to upper case if required. */
+   key = skey;
+   if( !snap->keycase ) {
+      if( astChrLen( skey ) > AST__MXKEYLEN ) {
+         astError( AST__BIGKEY, "%s(KeyMap): Supplied key '%s' is too long "
+                   "(keys must be no more than %d characters long).",
+                   status, method, skey, AST__MXKEYLEN );
+      } else {
+         astChrCase( skey, keybuf, 1, AST__MXKEYLEN + 1 );
+         key = keybuf;
+      }
+   }
+
+/* Check each element of the hash table in turn, starting at the element
+   given by the hash function, until either the key or an empty element
+   is found. Snapshots contain no deleted elements. */
+   if( astOK ) {
+      bitmask = snap->mapsize - 1;
+      itab = HashFun( key, bitmask, &hash, status );
+      while( ( ient = snap->table[ itab ] ) != EMPTY_ENTRY ) {
+         if( !KeyCmp( snap->entry[ ient ]->key, key ) ) {
+            result = snap->entry[ ient ];
+            break;
+         }
+         itab = ( itab + 1 ) & bitmask;
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static int ShareGet( AstKeyMapShare *share, const char *skey, int mxval,
+                     int *nval, int type, size_t size, void *value,
+                     const char *method, int *status ){
+/*
+*  Name:
+*     ShareGet
+
+*  Purpose:
+*     Get values from the snapshot currently published for a KeyMap.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     int ShareGet( AstKeyMapShare *share, const char *skey, int mxval,
+*                   int *nval, int type, size_t size, void *value,
+*                   const char *method, int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function implements the astMapShareGet0<X>, astMapShareGet1<X>
+*     and astMapShareHasKey functions. It registers the calling thread as
+*     a reader of the AstKeyMapShare, obtains the currently published
+*     snapshot, searches it for the key, and converts any values found to
+*     the requested data type. A reference to the snapshot is held until
+*     the read is complete, so that it is not freed by astMapShare even
+*     if a new snapshot is published in the meantime.
+
+*  Parameters:
+*     share
+*        Pointer to the AstKeyMapShare returned by astMapShare.
+*     skey
+*        The key string to be searched for. Trailing spaces are ignored.
+*     mxval
+*        The maximum number of values to return.
+*     nval
+*        Pointer to a location at which to return the number of values
+*        stored in "value". May be NULL.
+*     type
+*        The data type required for the returned values. If this is
+*        AST__STRINGTYPE, "size" gives the length of the buffer supplied
+*        for each string, including room for a terminating null. If this
+*        is AST__UNDEFTYPE, no values are returned.
+*     size
+*        The size, in bytes, of each element of the "value" array.
+*     value
+*        Pointer to an array in which to return the values.
+*     method
+*        Pointer to a string holding the name of the method to include in
+*        any error message.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the key was found and (unless "type" is AST__UNDEFTYPE)
+*     has a defined value. Zero otherwise.
+
+*  Notes:
+*     - Zero will be returned if this function is invoked with the global
+*     error status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstMapEntry *mapentry; /* Pointer to the entry with the given key */
+   ShareSnap *snap;       /* Pointer to the published snapshot */
+   char *out;             /* Pointer to next returned value */
+   const char *cval;      /* Pointer to string value */
+   int i;                 /* Element index */
+   int nel;               /* Number of values to return */
+   int nc;                /* Number of characters to return */
+   int phase;             /* Element of nreader used by this read */
+   int result;            /* Returned flag */
+   size_t raw_size;       /* Size of a single raw value */
+   void *raw;             /* Pointer to stored value */
+
+/* Initialise */
+   result = 0;
+   if( nval ) *nval = 0;
+
+/* Check the global error status and the supplied pointer. */
+   if ( !astOK ) return result;
+   if( !share ) {
+      astError( AST__PTRIN, "%s(KeyMap): Invalid NULL AstKeyMapShare "
+                "pointer given.", status, method );
+      return result;
+   }
+
+/* Register this thread as a reader before loading the pointer to the
+   published snapshot, and stay registered until a reference to the
+   snapshot has been taken (see astMapShare). */
+   phase = SHARE_LOAD( &share->phase );
+   (void) SHARE_ADD( &share->nreader[ phase ], 1 );
+   snap = SHARE_LOAD( &share->current );
+   (void) SHARE_ADD( &snap->nref, 1 );
+   (void) SHARE_ADD( &share->nreader[ phase ], -1 );
+
+/* Search the snapshot for the key. */
+   mapentry = ShareFind( snap, skey, method, status );
+   if( mapentry ) {
+      result = 1;
+
+/* Get the address of the first raw value, and the size of each raw
+   value. Undefined entries have no raw values. */
+      raw = ShareValue( mapentry, &raw_size, status );
+      if( type != AST__UNDEFTYPE ) {
+         if( !raw ) result = 0;
+
+/* Treat scalars as single-value vectors, and ensure no more than "mxval"
+   values are returned. */
+         nel = mapentry->nel ? mapentry->nel : 1;
+         if( nel > mxval ) nel = mxval;
+         if( nval ) *nval = nel;
+
+/* Convert each value, storing the result in the supplied array. Strings
+   are copied into the supplied buffer (truncating them if necessary)
+   before the snapshot is released. */
+         out = value;
+         for( i = 0; i < nel && raw && astOK; i++ ) {
+            if( type == AST__STRINGTYPE ) {
+               if( ConvertValue( raw, mapentry->type, &cval, type, status ) ) {
+                  nc = cval ? strlen( cval ) : 0;
+                  if( nc > (int) size - 1 ) nc = (int) size - 1;
+                  if( nc > 0 ) memcpy( out, cval, nc );
+                  out[ nc ] = 0;
+               } else if( astOK ) {
+                  result = 0;
+               }
+            } else if( !ConvertValue( raw, mapentry->type, out, type, status ) ) {
+               result = 0;
+            }
+
+            if( !result && astOK ) {
+               astError( AST__MPGER, "%s(KeyMap): The value of element %d of "
+                         "KeyMap key \"%s\" cannot be read using the "
+                         "requested data type.", status, method, i + 1,
+                         mapentry->key );
+            }
+
+/* Increment the pointers to the next raw and returned values. */
+            raw = (char *) raw + raw_size;
+            out += size;
+         }
+      }
+
+/* If the KeyError attribute was non-zero when the snapshot was taken,
+   report an error if the key is not found. */
+   } else if( type != AST__UNDEFTYPE && snap->keyerror && astOK ) {
+      astError( AST__MPKER, "%s(KeyMap): No value was found for %s in the "
+                "supplied KeyMap.", status, method, skey );
+   }
+
+/* Finish the read, freeing the snapshot if it has been superseded and
+   no other reads are using it. */
+   snap = ReleaseShareSnap( snap, status );
+
+/* If an error occurred, return zero. */
+   if( !astOK ) result = 0;
+
+/* Return the result. */
+   return result;
+}
+
+static void *ShareValue( AstMapEntry *entry, size_t *size, int *status ){
+/*
+*  Name:
+*     ShareValue
+
+*  Purpose:
+*     Get the address of the first value stored in a KeyMap entry.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "keymap.h"
+*     void *ShareValue( AstMapEntry *entry, size_t *size, int *status )
+
+*  Class Membership:
+*     KeyMap member function.
+
+*  Description:
+*     This function returns the address of the first (or only) value
+*     stored in an entry, together with the size of each value.
+
+*  Parameters:
+*     entry
+*        Pointer to the entry.
+*     size
+*        Pointer to a location at which to return the size of each value,
+*        in bytes.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the first value, or NULL if the entry has an
+*     undefined value.
+
+*  Notes:
+*     - NULL will be returned if this function is invoked with the global
+*     error status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   int nel;               /* 0 => scalar, >0 => array */
+   void *result;          /* Returned pointer */
+
+/* Initialise */
+   result = NULL;
+   *size = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get the address and size appropriate to the data type. */
+   nel = entry->nel;
+   switch( entry->type ) {
+   case AST__INTTYPE:
+      *size = sizeof( int );
+      result = nel ? (void *) ((Entry1I *)entry)->value : (void *) &((Entry0I *)entry)->value;
+      break;
+   case AST__DOUBLETYPE:
+      *size = sizeof( double );
+      result = nel ? (void *) ((Entry1D *)entry)->value : (void *) &((Entry0D *)entry)->value;
+      break;
+   case AST__SINTTYPE:
+      *size = sizeof( short int );
+      result = nel ? (void *) ((Entry1S *)entry)->value : (void *) &((Entry0S *)entry)->value;
+      break;
+   case AST__BYTETYPE:
+      *size = sizeof( unsigned char );
+      result = nel ? (void *) ((Entry1B *)entry)->value : (void *) &((Entry0B *)entry)->value;
+      break;
+   case AST__FLOATTYPE:
+      *size = sizeof( float );
+      result = nel ? (void *) ((Entry1F *)entry)->value : (void *) &((Entry0F *)entry)->value;
+      break;
+   case AST__POINTERTYPE:
+      *size = sizeof( void * );
+      result = nel ? (void *) ((Entry1P *)entry)->value : (void *) &((Entry0P *)entry)->value;
+      break;
+   case AST__STRINGTYPE:
+      *size = sizeof( const char * );
+      result = nel ? (void *) ((Entry1C *)entry)->value : (void *) &((Entry0C *)entry)->value;
+      break;
+   case AST__UNDEFTYPE:
+      break;
+   default:
+      astError( AST__INTER, "ShareValue(KeyMap): Illegal map entry data "
+                "type %d encountered (internal AST programming error).",
+                status, entry->type );
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static size_t SizeOfEntry( AstMapEntry *entry, int *status ){
 /*
 *  Name:
@@ -9155,12 +9693,17 @@ static void SortEntries( AstKeyMap *this, int *status ){
 *  Description:
 *     This function sorts all the entries in the supplied KeyMap in
 *     the manner indicated by the SortBy attribute value in the KeyMap.
-*     A double linked list is maintained indicating the ordering, with
-*     the first entry in the sorted list being pointed to by "this->first".
-*     Each entry contains "snext" and "sprev" pointers that point to the
-*     next and previous entries in the sorted list. The number of entries
-*     in the sorted list (which should usually equal the total number of
-*     entries currently in the KeyMap), is stored in "this->nsorted".
+*     Pointers to the entries are stored in sorted order in the array
+*     "this->sorted", and the number of entries in the sorted list is
+*     stored in "this->nsorted". If SortBy is "None", the list holds the
+*     entries in the order in which they are stored in the array of
+*     entries, with any gaps left by removed entries skipped, and nothing
+*     is stored if there are no such gaps.
+*
+*     The sorted list is not maintained as entries are added to or
+*     removed from the KeyMap. Instead, "this->resort" is set non-zero
+*     whenever the list becomes out of date, and this function is invoked
+*     to re-create the list when it is next needed.
 
 *  Parameters:
 *     this
@@ -9171,10 +9714,6 @@ static void SortEntries( AstKeyMap *this, int *status ){
 */
 
 /* Local Variables: */
-   AstMapEntry **ents;
-   AstMapEntry **pent;
-   AstMapEntry **a;
-   AstMapEntry **b;
    AstMapEntry *entry;
    int i;
    int nent;
@@ -9185,81 +9724,51 @@ static void SortEntries( AstKeyMap *this, int *status ){
 
 /* Empty the sorted list. */
    this->nsorted = 0;
-   this->first = NULL;
 
 /* Get the SortBy value. */
    sortby = astGetSortBy( this );
 
-/* Do nothing more if no sorting is required. */
-   if( sortby != SORTBY_NONE ) {
+/* Do nothing more if no sorting is required and the array of entries
+   contains no gaps. */
+   if( sortby != SORTBY_NONE || this->nfree > 0 ) {
 
-/* Get the number of entries in the keyMap. */
-      nent = astMapSize( this );
+/* Get the number of entries in the keyMap hash table. The hash table is
+   accessed directly since this function may be invoked from the copy
+   constructor, before any sub-class data has been copied. */
+      nent = this->nentry - this->nfree;
 
 /* Only sort if the KeyMap is not empty. */
       if( nent > 0 ) {
 
-/* Allocate an array with one element for each entry. Each element is a
-   pointer to a MapEntry structure. */
-         ents = astMalloc( sizeof( *ents )*nent );
+/* Ensure the array used to hold the sorted list has one element for each
+   entry. Each element is a pointer to a MapEntry structure. */
+         this->sorted = astGrow( this->sorted, nent, sizeof( AstMapEntry * ) );
          if( astOK ) {
 
-/* Loop round all entries in the hash table. */
-            pent = ents;
-            for( i = 0; i < this->mapsize; i++ ) {
-
-/* Get a pointer to the next KeyMap entry. */
-               entry = this->table[ i ];
-
-/* Loop round all entries in this element of the hash table. */
-               while( entry ) {
+/* Loop round all entries in the KeyMap. */
+            for( i = 0; i < this->nentry; i++ ) {
+               entry = this->entry[ i ];
+               if( entry ) {
 
 /* Store the sorting method in the MapEntry. */
                   entry->sortby = sortby;
 
 /* Put a pointer to the MapEntry into the array. */
-                  *(pent++) = entry;
-
-/* Update the address of the next MapEntry in the source. */
-                  entry = entry->next;
+                  this->sorted[ (this->nsorted)++ ] = entry;
                }
             }
 
-/* No need for sorting if there is only one entry. */
-            if( nent == 1 ) {
-               ents[ 0 ]->snext = ents[ 0 ];
-               ents[ 0 ]->sprev = ents[ 0 ];
-
-/* Sort the array of pointers if there is more than one entry... */
-            } else {
-               qsort( ents, nent, sizeof( *ents ), CompareEntries );
-
-/* Establish the double linked list. */
-               a = ents;
-               b = ents + 1;
-               for( i = 1; i < nent; i++ ) {
-                  (*b)->sprev = *a;
-                  (*a)->snext = *b;
-                  a = b++;
-               }
-
-               b = ents;
-               (*b)->sprev = *a;
-               (*a)->snext = *b;
-
+/* Sort the array of pointers if there is more than one entry. */
+            if( nent > 1 && sortby != SORTBY_NONE ) {
+               qsort( this->sorted, nent, sizeof( AstMapEntry * ),
+                      CompareEntries );
             }
-
-/* Store a pointer to the first entry in the sorted list. */
-            this->first = ents[ 0 ];
-
-/* Store the number of entrie sin the sorted list. */
-            this->nsorted = nent;
          }
-
-/* Free resources. */
-         ents = astFree( ents );
       }
    }
+
+/* Indicate the sorted list is up to date. */
+   if( astOK ) this->resort = 0;
 }
 
 static int TestAttrib( AstObject *this_object, const char *attrib, int *status ) {
@@ -9579,9 +10088,10 @@ c     astMapKey
 f     AST_MAPKEY
 *     function. It may take the following values (the default is "None"):
 *
-*     - "None": The keys are returned in an arbitrary order. This is the
-*     fastest method as it avoids the need for a sorted list of keys to
-*     be maintained and used.
+*     - "None": No sorting is performed. This is the fastest method as it
+*     avoids the need for a sorted list of keys to be created and used.
+*     The keys are currently returned in the same order as for "AgeDown",
+*     but this should not be relied on.
 *
 *     - "AgeDown": The keys are returned in the order in which values were
 *     stored in the KeyMap, with the key for the most recent value being
@@ -9660,7 +10170,7 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
 /* Local Variables: */
    AstKeyMap *in;                  /* Pointer to input KeyMap */
    AstKeyMap *out;                 /* Pointer to output KeyMap */
-   int i;                       /* Index into hash table */
+   int i;                       /* Index into array of entries */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -9672,24 +10182,45 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
 /* For safety, first clear any references to the input memory from
    the output KeyMap. */
    out->table = NULL;
-   out->nentry = NULL;
-   out->first = NULL;
+   out->entry = NULL;
+   out->nentry = 0;
+   out->sorted = NULL;
+   out->nsorted = 0;
+   out->resort = 1;
    out->firstA = NULL;
+   out->iter_itab = 0;
+   out->share = NULL;
 
-/* Make copies of the table entries. */
-   out->table = astMalloc( sizeof( AstMapEntry * )*( out->mapsize ) );
-   out->nentry = astMalloc( sizeof( int )*( out->mapsize ) );
+/* Copy the hash table. The copied entries are stored at the same indices
+   within the array of entries, so the hash table can be copied as it is. */
+   out->table = astStore( NULL, in->table, sizeof( int )*( in->mapsize ) );
 
-   for( i = 0; i < out->mapsize; i++ ) CopyTableEntry( in, out, i, status );
+/* Make copies of the entries, retaining any gaps left by removed entries. */
+   if( in->nentry > 0 ) {
+      out->entry = astMalloc( sizeof( AstMapEntry * )*( in->nentry ) );
+      if( astOK ) {
+         for( i = 0; i < in->nentry; i++ ) {
+            if( in->entry[ i ] && astOK ) {
+               out->entry[ i ] = CopyMapEntry( in->entry[ i ], status );
 
-/* Create the required sorted key list in the new KeyMap. */
-   SortEntries( out, status );
+/* If the entry is of type AST__OBJECTTYPE, add it to the head of the
+   list of AST__OBJECTTYPE entries in the output KeyMap. */
+               AddToObjectList( out, out->entry[ i ], status );
+            } else {
+               out->entry[ i ] = NULL;
+            }
+         }
+         out->nentry = in->nentry;
+      }
+   }
 
-/* If an error occurred, clean up by freeing all memory allocated above. */
+/* If an error occurred, clean up by freeing all memory allocated above.
+   The sorted key list is created when it is first needed. */
    if ( !astOK ) {
-      for( i = 0; i < out->mapsize; i++ ) FreeTableEntry( out, i, status );
+      FreeTableEntries( out, status );
       out->table = astFree( out->table );
-      out->nentry = astFree( out->nentry );
+      out->entry = astFree( out->entry );
+      out->mapsize = 0;
    }
 }
 
@@ -9728,21 +10259,24 @@ static void Delete( AstObject *obj, int *status ) {
 
 /* Local Variables: */
    AstKeyMap *this;             /* Pointer to the KeyMap structure */
-   int i;                    /* Loop count */
 
 /* Obtain a pointer to the KeyMap structure. */
    this = (AstKeyMap *) obj;
 
 /* Free all allocated memory. */
-   for( i = 0; i < this->mapsize; i++ ) FreeTableEntry( this, i, status );
+   FreeTableEntries( this, status );
 
 /* Free memory used to hold tables. */
    this->table = astFree( this->table );
-   this->nentry = astFree( this->nentry );
-
-/* Nullify other pointers. */
-   this->first = NULL;
-   this->firstA = NULL;
+   this->entry = astFree( this->entry );
+   this->sorted = astFree( this->sorted );
+
+/* Release the published snapshot. The caller must ensure that no thread
+   is still starting a read using the KeyMapShare. */
+   if( this->share ) {
+      this->share->current = ReleaseShareSnap( this->share->current, status );
+      this->share = astFree( this->share );
+   }
 }
 
 /* Dump function. */
@@ -9788,6 +10322,9 @@ static void Dump( AstObject *this_object, AstChannel *channel, int *status ) {
 /* Obtain a pointer to the KeyMap structure. */
    this = (AstKeyMap *) this_object;
 
+/* Ensure all entries are held in the hash table. */
+   astMapSync( this );
+
 /* Initialise the number of KeyMap entries dumped so far. */
    nentry = 0;
 
@@ -9830,20 +10367,11 @@ static void Dump( AstObject *this_object, AstChannel *channel, int *status ) {
 /* member count. */
    astWriteInt( channel, "MemCnt", 1, 1, this->member_count, "Total member count" );
 
-/* Loop round each entry in the hash table. */
-   for( i = 0; i < this->mapsize; i++ ) {
-
-/* Get a pointer to the next KeyMap entry to dump. */
-      next = this->table[ i ];
-
-/* Loop round dumping all KeyMap entries in this element of the hash table. */
-      while( next && astOK ) {
-         DumpEntry( next, channel, ++nentry, status );
-
-/* Get a pointer to the next entry to dump. */
-         next = next->next;
-
-      }
+/* Loop round dumping each entry in the KeyMap, skipping over any entries
+   that have been removed. */
+   for( i = 0; i < this->nentry && astOK; i++ ) {
+      next = this->entry[ i ];
+      if( next ) DumpEntry( next, channel, ++nentry, status );
    }
 }
 
@@ -10137,17 +10665,21 @@ AstKeyMap *astInitKeyMap_( void *mem, size_t size, int init, AstKeyMapVtab *vtab
       new->sizeguess = INT_MAX;
       new->mapsize = 0;
       new->table = NULL;
-      new->nentry = NULL;
+      new->entry = NULL;
+      new->nentry = 0;
+      new->nfree = 0;
+      new->ndead = 0;
       new->keycase = -1;
       new->keyerror = -INT_MAX;
       new->maplocked = -INT_MAX;
       new->sortby = -INT_MAX;
-      new->first = NULL;
+      new->sorted = NULL;
       new->nsorted = 0;
+      new->resort = 1;
       new->member_count = 0;
       new->firstA = NULL;
       new->iter_itab = 0;
-      new->iter_entry = NULL;
+      new->share = NULL;
 
       NewTable( new, MIN_TABLE_SIZE, status );
 
@@ -10293,10 +10825,16 @@ AstKeyMap *astLoadKeyMap_( void *mem, size_t size, AstKeyMapVtab *vtab,
 /* Inidicate the KeyMap is empty. */
       new->mapsize = 0;
       new->table = NULL;
-      new->nentry = NULL;
+      new->entry = NULL;
+      new->nentry = 0;
+      new->nfree = 0;
+      new->ndead = 0;
+      new->sorted = NULL;
+      new->nsorted = 0;
+      new->resort = 1;
       new->firstA = NULL;
       new->iter_itab = 0;
-      new->iter_entry = NULL;
+      new->share = NULL;
 
 /* Read input data. */
 /* ================ */
@@ -10713,6 +11251,14 @@ const char *astMapIterate_( AstKeyMap *this, int reset, int *status ){
    if ( !astOK ) return NULL;
    return (**astMEMBER(this,KeyMap,MapIterate))(this,reset,status);
 }
+AstKeyMapShare *astMapShare_( AstKeyMap *this, int *status ){
+   if ( !astOK ) return NULL;
+   return (**astMEMBER(this,KeyMap,MapShare))(this,status);
+}
+void astMapSync_( AstKeyMap *this, int *status ){
+   if ( !astOK ) return;
+   (**astMEMBER(this,KeyMap,MapSync))(this,status);
+}
 int astGetSizeGuess_( AstKeyMap *this, int *status ){
    if( !astOK ) return 0;
    return (**astMEMBER(this,KeyMap,GetSizeGuess))(this,status);
@@ -10766,3 +11312,230 @@ void astSetKeyCase_( AstKeyMap *this, int keycase, int *status ){
    (**astMEMBER(this,KeyMap,SetKeyCase))(this,keycase,status);
 }
 
+/* Lock-free access to published KeyMap snapshots. */
+/* =============================================== */
+/* These functions give access to the snapshot published by astMapShare.
+   They are not KeyMap methods, since they are used by threads that have
+   not locked the KeyMap, and so cannot access it through an Object
+   pointer. */
+
+/*
+*++
+*  Name:
+c     astMapShareGet0<X>
+
+*  Purpose:
+*     Get a scalar value from a published KeyMap snapshot.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+c     #include "keymap.h"
+c     int astMapShareGet0<X>( AstKeyMapShare *share, const char *key, <X>type *value );
+c     int astMapShareGet0C( AstKeyMapShare *share, const char *key, int l,
+c                           char *value );
+
+*  Description:
+*     This is a set of functions for retrieving a scalar value from the
+*     snapshot of a KeyMap most recently published using astMapShare.
+*     They behave in the same way as the corresponding astMapGet0<X>
+*     functions, except that they may be invoked by any thread at any
+*     time without locking the KeyMap, even while another thread is
+*     modifying the KeyMap or publishing a new snapshot. Changes made to
+*     the KeyMap are not visible to these functions until the next call
+*     to astMapShare.
+*
+*     You should replace <X> in the generic function name
+c     astMapShareGet0<X>
+*     by an abbreviation for the data type you wish to retrieve. The
+*     data type codes are as for astMapGet0<X>, except that there is no
+*     "A" (AST Object) variant, and the "C" variant copies the string into
+*     a buffer supplied by the caller, since the snapshot may be released
+*     once the function returns.
+
+*  Parameters:
+c     share
+*        Pointer to the AstKeyMapShare returned by astMapShare.
+c     key
+*        The character string identifying the value to be retrieved.
+*        Trailing spaces are ignored. The supplied string is converted to
+*        upper case if the KeyMap had a zero value for its KeyCase
+*        attribute when the snapshot was published.
+c     l
+*        The length of the "value" buffer (astMapShareGet0C only),
+*        including room for a terminating null character. Longer strings
+*        are truncated.
+c     value
+*        A pointer to a buffer in which to return the requested value.
+*        If the requested key is not found, or if it is found but has an
+*        undefined value, then the contents of the buffer on entry to
+*        this function will be unchanged on exit.
+
+*  Returned Value:
+c     astMapShareGet0<X>()
+*        A non-zero value is returned if the requested key name was found,
+*        and does not have an undefined value. Zero is returned otherwise.
+
+*  Notes:
+*     - An error will be reported if the key is not found and the
+*     KeyError attribute of the KeyMap was non-zero when the snapshot
+*     was published.
+*     - An error will be reported if the stored value cannot be converted
+*     to the requested data type.
+*     - Errors are reported using the error status of the calling thread.
+*     - A value of zero will be returned if this function is invoked with
+*     the AST error status set, or if it should fail for any reason.
+*--
+*/
+/* Define a macro to implement the function for a specific data type. */
+#define MAKE_MAPSHAREGET0(X,Xtype,Itype) \
+int astMapShareGet0##X##_( AstKeyMapShare *share, const char *key, Xtype *value, int *status ) { \
+   return ShareGet( share, key, 1, NULL, Itype, sizeof( Xtype ), value, \
+                    "astMapShareGet0" #X, status ); \
+}
+
+/* Expand the above macro to generate a function for each required
+   data type. */
+MAKE_MAPSHAREGET0(I,int,AST__INTTYPE)
+MAKE_MAPSHAREGET0(D,double,AST__DOUBLETYPE)
+MAKE_MAPSHAREGET0(F,float,AST__FLOATTYPE)
+MAKE_MAPSHAREGET0(P,void *,AST__POINTERTYPE)
+MAKE_MAPSHAREGET0(S,short int,AST__SINTTYPE)
+MAKE_MAPSHAREGET0(B,unsigned char,AST__BYTETYPE)
+
+/* Undefine the macro. */
+#undef MAKE_MAPSHAREGET0
+
+/* The "C" variant needs the extra buffer length parameter. */
+int astMapShareGet0C_( AstKeyMapShare *share, const char *key, int l,
+                       char *value, int *status ) {
+   if ( !astOK ) return 0;
+   if( l < 1 ) {
+      astError( AST__BADIN, "astMapShareGet0C(KeyMap): Invalid buffer "
+                "length (%d) given (must be at least 1).", status, l );
+      return 0;
+   }
+   return ShareGet( share, key, 1, NULL, AST__STRINGTYPE, (size_t) l,
+                    value, "astMapShareGet0C", status );
+}
+
+/*
+*++
+*  Name:
+c     astMapShareGet1<X>
+
+*  Purpose:
+*     Get a vector value from a published KeyMap snapshot.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+c     #include "keymap.h"
+c     int astMapShareGet1<X>( AstKeyMapShare *share, const char *key,
+c                             int mxval, int *nval, <X>type *value );
+
+*  Description:
+*     This is a set of functions for retrieving a vector value from the
+*     snapshot of a KeyMap most recently published using astMapShare.
+*     They behave in the same way as the corresponding astMapGet1<X>
+*     functions, except that they may be invoked by any thread at any
+*     time without locking the KeyMap (see astMapShareGet0<X>). There
+*     are no "A" or "C" variants.
+
+*  Parameters:
+c     share
+*        Pointer to the AstKeyMapShare returned by astMapShare.
+c     key
+*        The character string identifying the value to be retrieved.
+*        Trailing spaces are ignored.
+c     mxval
+*        The number of elements in the
+c        "value" array.
+c     nval
+*        The address of an integer in which to put the number of elements
+*        stored in the
+c        "value" array. Any unused elements of the array are left unchanged.
+c     value
+*        A pointer to an array in which to return the requested values.
+*        If the requested key is not found, or if it is found but has an
+*        undefined value, then the contents of the array on entry to
+*        this function will be unchanged on exit.
+
+*  Returned Value:
+c     astMapShareGet1<X>()
+*        A non-zero value is returned if the requested key name was found,
+*        and does not have an undefined value. Zero is returned otherwise.
+
+*  Notes:
+*     - A scalar entry is returned as a vector of length 1.
+*     - The errors reported are as for astMapShareGet0<X>.
+*     - A value of zero will be returned if this function is invoked with
+*     the AST error status set, or if it should fail for any reason.
+*--
+*/
+/* Define a macro to implement the function for a specific data type. */
+#define MAKE_MAPSHAREGET1(X,Xtype,Itype) \
+int astMapShareGet1##X##_( AstKeyMapShare *share, const char *key, int mxval, int *nval, Xtype *value, int *status ) { \
+   return ShareGet( share, key, mxval, nval, Itype, sizeof( Xtype ), value, \
+                    "astMapShareGet1" #X, status ); \
+}
+
+/* Expand the above macro to generate a function for each required
+   data type. */
+MAKE_MAPSHAREGET1(I,int,AST__INTTYPE)
+MAKE_MAPSHAREGET1(D,double,AST__DOUBLETYPE)
+MAKE_MAPSHAREGET1(F,float,AST__FLOATTYPE)
+MAKE_MAPSHAREGET1(P,void *,AST__POINTERTYPE)
+MAKE_MAPSHAREGET1(S,short int,AST__SINTTYPE)
+MAKE_MAPSHAREGET1(B,unsigned char,AST__BYTETYPE)
+
+/* Undefine the macro. */
+#undef MAKE_MAPSHAREGET1
+
+int astMapShareHasKey_( AstKeyMapShare *share, const char *key, int *status ) {
+/*
+*++
+*  Name:
+c     astMapShareHasKey
+
+*  Purpose:
+*     Check if a published KeyMap snapshot contains a given key.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+c     #include "keymap.h"
+c     int astMapShareHasKey( AstKeyMapShare *share, const char *key )
+
+*  Description:
+*     This function returns a flag indicating if the snapshot of a KeyMap
+*     most recently published using astMapShare contains an entry with
+*     the given key. It may be invoked by any thread at any time without
+*     locking the KeyMap (see astMapShareGet0<X>).
+
+*  Parameters:
+c     share
+*        Pointer to the AstKeyMapShare returned by astMapShare.
+c     key
+*        The character string identifying the entry to be checked.
+*        Trailing spaces are ignored.
+
+*  Returned Value:
+c     astMapShareHasKey()
+*        Non-zero if the snapshot contains an entry (defined or undefined)
+*        with the given key. Entries holding AST Object pointers are not
+*        included in snapshots.
+
+*  Notes:
+*     - No error is reported if the key is not found, whatever the value
+*     of the KeyError attribute.
+*     - A value of zero will be returned if this function is invoked with
+*     the AST error status set, or if it should fail for any reason.
+*--
+*/
+   return ShareGet( share, key, 0, NULL, AST__UNDEFTYPE, 0, NULL,
+                    "astMapShareHasKey", status );
+}
@@ -56,6 +56,8 @@
 *        Added support for single precision entries.
 *     7-MAR-2008 (DSB):
 *        Added support for pointer ("P") entries.
+*     16-OCT-2026 (DSB):
+*        Added protected method astMapSync.
 *-
 */
 
@@ -104,20 +106,24 @@
    specific data types. */
 
 typedef struct AstMapEntry {
-   struct AstMapEntry *next; /* Pointer to next structure in unsorted list. */
    const char *key;          /* The name used to identify the entry */
    unsigned long hash;       /* The full width hash value */
    int type;                 /* Data type. */
    int nel;                  /* 0 => scalar, >0 => array with "nel" elements */
    const char *comment;      /* Pointer to a comment for the entry */
    int defined;              /* Non-zero if the entry value is defined */
-   struct AstMapEntry *snext;/* Pointer to next structure in sorted list. */
-   struct AstMapEntry *sprev;/* Pointer to previous structure in sorted list. */
    int member;               /* No. of values added to KeyMap prior to this one  */
    int keymember;            /* No. of keys added to KeyMap prior to this one  */
    int sortby;               /* Used for comunnication with qsort function */
 } AstMapEntry;
 
+/* KeyMapShare structure. */
+/* ---------------------- */
+/* This opaque structure gives threads lock-free read access to the
+   snapshot most recently published for a KeyMap by astMapShare. Its
+   contents are private to the KeyMap class. */
+typedef struct AstKeyMapShare AstKeyMapShare;
+
 /* KeyMap structure. */
 /* ------------------ */
 /* This structure contains all information that is unique to each object in
@@ -129,20 +135,24 @@ typedef struct AstKeyMap {
 
 /* Attributes specific to objects in this class. */
    int sizeguess;                  /* Guess at KeyMap size */
-   AstMapEntry **table;            /* Hash table containing pointers to
-                                      the KeyMap entries */
-   int *nentry;                    /* No. of Entries in each table element */
+   int *table;                     /* Open-addressed hash table holding
+                                      indices into "entry" */
    int mapsize;                    /* Length of table */
+   AstMapEntry **entry;            /* KeyMap entries in order of storage */
+   int nentry;                     /* Used length of "entry" */
+   int nfree;                      /* No. of removed (NULL) elements in "entry" */
+   int ndead;                      /* No. of deleted elements in "table" */
    int keycase;                    /* Are keys case sensitive? */
    int keyerror;                   /* Report error if no key? */
    int maplocked;                  /* Prevent addition of new entries? */
    int sortby;                     /* How the keys should be sorted */
-   AstMapEntry *first;             /* Pointer to first structure in sorted list. */
+   AstMapEntry **sorted;           /* KeyMap entries in sorted order */
    int nsorted;                    /* Length of sorted list */
+   int resort;                     /* Does the sorted list need re-creating? */
    int member_count;               /* Total no. of values ever added to keyMap */
    AstMapEntry *firstA;            /* Pointer to first "AST object"-type entry */
-   int iter_itab;                  /* Next hash table entry to return */
-   AstMapEntry *iter_entry;        /* Next entry to return */
+   int iter_itab;                  /* Index of next entry to return */
+   struct AstKeyMapShare *share;   /* Published snapshots, if any */
 } AstKeyMap;
 
 /* Virtual function table. */
@@ -219,6 +229,8 @@ typedef struct AstKeyMapVtab {
    int (* MapDefined)( AstKeyMap *, const char *, int * );
    const char *(* MapIterate)( AstKeyMap *, int, int * );
    const char *(* MapKey)( AstKeyMap *, int, int * );
+   AstKeyMapShare *(* MapShare)( AstKeyMap *, int * );
+   void (* MapSync)( AstKeyMap *, int * );
 
    int (* GetSizeGuess)( AstKeyMap *, int * );
    int (* TestSizeGuess)( AstKeyMap *, int * );
@@ -372,9 +384,25 @@ void astMapPutElemS_( AstKeyMap *, const char *, int, short int, int * );
 void astMapPutU_( AstKeyMap *, const char *, const char *, int * );
 void astMapRemove_( AstKeyMap *, const char *, int * );
 void astMapRename_( AstKeyMap *, const char *, const char *, int * );
+AstKeyMapShare *astMapShare_( AstKeyMap *, int * );
+int astMapShareGet0B_( AstKeyMapShare *, const char *, unsigned char *, int * );
+int astMapShareGet0C_( AstKeyMapShare *, const char *, int, char *, int * );
+int astMapShareGet0D_( AstKeyMapShare *, const char *, double *, int * );
+int astMapShareGet0F_( AstKeyMapShare *, const char *, float *, int * );
+int astMapShareGet0I_( AstKeyMapShare *, const char *, int *, int * );
+int astMapShareGet0P_( AstKeyMapShare *, const char *, void **, int * );
+int astMapShareGet0S_( AstKeyMapShare *, const char *, short int *, int * );
+int astMapShareGet1B_( AstKeyMapShare *, const char *, int, int *, unsigned char *, int * );
+int astMapShareGet1D_( AstKeyMapShare *, const char *, int, int *, double *, int * );
+int astMapShareGet1F_( AstKeyMapShare *, const char *, int, int *, float *, int * );
+int astMapShareGet1I_( AstKeyMapShare *, const char *, int, int *, int *, int * );
+int astMapShareGet1P_( AstKeyMapShare *, const char *, int, int *, void **, int * );
+int astMapShareGet1S_( AstKeyMapShare *, const char *, int, int *, short int *, int * );
+int astMapShareHasKey_( AstKeyMapShare *, const char *, int * );
 
 #if defined(astCLASS)            /* Protected */
 const char *astMapIterate_( AstKeyMap *, int, int * );
+void astMapSync_( AstKeyMap *, int * );
 
 int astGetSizeGuess_( AstKeyMap *, int * );
 int astTestSizeGuess_( AstKeyMap *, int * );
@@ -501,6 +529,21 @@ astINVOKE(O,astLoadKeyMap_(mem,size,vtab,name,astCheckChannel(channel),STATUS_PT
 #define astMapGet0P(this,key,value) astINVOKE(V,astMapGet0P_(astCheckKeyMap(this),key,value,STATUS_PTR))
 #define astMapGet1P(this,key,mxval,nval,value) astINVOKE(V,astMapGet1P_(astCheckKeyMap(this),key,mxval,nval,value,STATUS_PTR))
 #define astMapPut1P(this,key,size,value,comment) astINVOKE(V,astMapPut1P_(astCheckKeyMap(this),key,size,value,comment,STATUS_PTR))
+#define astMapShare(this) astINVOKE(V,astMapShare_(astCheckKeyMap(this),STATUS_PTR))
+#define astMapShareGet0I(share,key,value) astERROR_INVOKE(astMapShareGet0I_(share,key,value,STATUS_PTR))
+#define astMapShareGet0B(share,key,value) astERROR_INVOKE(astMapShareGet0B_(share,key,value,STATUS_PTR))
+#define astMapShareGet0S(share,key,value) astERROR_INVOKE(astMapShareGet0S_(share,key,value,STATUS_PTR))
+#define astMapShareGet0D(share,key,value) astERROR_INVOKE(astMapShareGet0D_(share,key,value,STATUS_PTR))
+#define astMapShareGet0F(share,key,value) astERROR_INVOKE(astMapShareGet0F_(share,key,value,STATUS_PTR))
+#define astMapShareGet0P(share,key,value) astERROR_INVOKE(astMapShareGet0P_(share,key,value,STATUS_PTR))
+#define astMapShareGet0C(share,key,l,value) astERROR_INVOKE(astMapShareGet0C_(share,key,l,value,STATUS_PTR))
+#define astMapShareGet1I(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1I_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1B(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1B_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1S(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1S_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1D(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1D_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1F(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1F_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareGet1P(share,key,mxval,nval,value) astERROR_INVOKE(astMapShareGet1P_(share,key,mxval,nval,value,STATUS_PTR))
+#define astMapShareHasKey(share,key) astERROR_INVOKE(astMapShareHasKey_(share,key,STATUS_PTR))
 
 #if defined(astCLASS)            /* Protected */
 #define astMapGet0A(this,key,value) astINVOKE(V,astMapGet0A_(astCheckKeyMap(this),key,(AstObject **)(value),STATUS_PTR))
@@ -508,6 +551,7 @@ astINVOKE(O,astLoadKeyMap_(mem,size,vtab,name,astCheckChannel(channel),STATUS_PT
 #define astMapPut1A(this,key,size,value,comment) astINVOKE(V,astMapPut1A_(astCheckKeyMap(this),key,size,value,comment,STATUS_PTR))
 #define astMapGetElemA(this,key,elem,value) astINVOKE(V,astMapGetElemA_(astCheckKeyMap(this),key,elem,(AstObject **)(value),STATUS_PTR))
 #define astMapIterate(this,reset) astINVOKE(V,astMapIterate_(astCheckKeyMap(this),reset,STATUS_PTR))
+#define astMapSync(this) astINVOKE(V,astMapSync_(astCheckKeyMap(this),STATUS_PTR))
 
 #define astClearSizeGuess(this) \
 astINVOKE(V,astClearSizeGuess_(astCheckKeyMap(this),STATUS_PTR))
@@ -50,6 +50,7 @@
 #include "selectormap.h"
 #include "switchmap.h"
 #include "unitmap.h"
+#include "resampleplan.h"
 #include "wcsmap.h"
 #include "winmap.h"
 #include "xmlchan.h"
@@ -170,6 +171,7 @@ if ( !strcmp( class, #name ) ) return (AstLoaderType *) astLoad##name##_
    LOAD(TimeMap);
    LOAD(TranMap);
    LOAD(UnitMap);
+   LOAD(ResamplePlan);
    LOAD(WcsMap);
    LOAD(WinMap);
    LOAD(XmlChan);
@@ -373,6 +373,41 @@ f     - AST_TRANN: Transform N-dimensional coordinates
 *     23-APR-2015 (DSB):
 *        Use one bit of this->flags to store the "IsSimple" attribute
 *        rather using a whole char (this->issimple).
+*     16-OCT-2026 (DSB):
+*        Use a pool of worker threads (see the NumThreads tuning
+*        parameter) to resample or rebin the blocks of pixels produced by
+*        the adaptive sub-division in astResample<X>, astRebin<X> and
+*        astRebinSeq<X>.
+*        In astTran1, astTran2, astTranN and astTranP, use scratch
+*        PointSets (see astScratchPointSet) rather than creating new
+*        PointSets on each call.
+*     16-OCT-2026 (DSB):
+*        Declare typed access functions for the Invert, IsLinear,
+*        IsSimple, Nin, Nout, Report, TranForward and TranInverse
+*        attributes.
+*     16-OCT-2026 (DSB):
+*        Added protected method astResampleWeights, which returns the
+*        interpolation weights used by astResample<X> as a sparse matrix
+*        (used by the ResamplePlan class). The code that selects a 1-D
+*        interpolation kernel is now shared by astResample<X> and
+*        astRebin<X> (see SetupKernel1).
+*     16-OCT-2026 (DSB):
+*        If the Mapping supplied to astResample<X> can be split into a
+*        Mapping for a single axis and a Mapping for the remaining axes,
+*        resample each group of axes separately (see ResampleSeparable<X>).
+*     16-OCT-2026 (DSB):
+*        Evaluate the internal 1-D interpolation kernels by interpolating
+*        within a pre-computed table (see KernelTable and the KernelTable
+*        tuning parameter).
+*     16-OCT-2026 (DSB):
+*        Added astResample8<X>, astRebin8<X>, astRebinSeq8<X> and
+*        astTranGrid8, which accept 64-bit grid bounds so that grids
+*        containing more than INT_MAX pixels can be processed. Pixel
+*        offsets and counts are now held in 64-bit integers throughout.
+*     16-OCT-2026 (DSB):
+*        Added astResampleTiled<X>, which resamples an input grid that
+*        is obtained one tile at a time from a user-supplied function,
+*        holding a bounded number of tiles in memory.
 *class--
 */
 
@@ -412,6 +447,7 @@ f     - AST_TRANN: Transform N-dimensional coordinates
 #include "permmap.h"             /* Axis permutations */
 #include "winmap.h"              /* Window scalings */
 #include "pal.h"                 /* SLALIB interface */
+#include "threads.h"             /* Pool of worker threads */
 #include "globals.h"             /* Thread-safe global data access */
 
 /* Error code definitions. */
@@ -466,9 +502,138 @@ typedef struct MapData {
    int nout;                     /* Number of output coordinates per point */
 } MapData;
 
+/* Structure used to record the blocks of pixels produced by the adaptive
+   sub-division of a grid (see ResampleAdaptively and RebinAdaptively),
+   so that they can be processed later by a pool of worker threads. */
+typedef struct BlockQueue {
+   int ndim;                     /* Number of grid dimensions in each block */
+   int nfitval;                  /* Number of coefficients in each linear fit */
+   int nblock;                   /* Number of blocks in the queue */
+   int nfit;                     /* Number of linear fits in the queue */
+   int *bounds;                  /* Lower then upper bounds for each block */
+   int *ifit;                    /* Index of each block's fit (-1 if none) */
+   double *factor;               /* Flux conservation factor for each block */
+   double *fits;                 /* Coefficients of each linear fit */
+} BlockQueue;
+
+/* Structure holding the arguments for ResampleSection that are shared by
+   all the blocks in a BlockQueue (see ResampleTask). */
+typedef struct ResampleJob {
+   AstMapping **maps;            /* Mapping to use within each worker */
+   AstMapping *unsimplified;     /* Original Mapping, for error reports */
+   BlockQueue *queue;            /* The blocks of output pixels */
+   const double *params;         /* Interpolation parameters */
+   const int *lbnd_in;           /* Lower bounds of input grid */
+   const int *lbnd_out;          /* Lower bounds of output grid */
+   const int *ubnd_in;           /* Upper bounds of input grid */
+   const int *ubnd_out;          /* Upper bounds of output grid */
+   const void *badval_ptr;       /* Pointer to bad value */
+   const void *in;               /* Input data array */
+   const void *in_var;           /* Input variance array */
+   DataType type;                /* Data type */
+   int *nbad;                    /* Returned no. of bad pixels in each block */
+   int flags;                    /* Resampling flags */
+   int interp;                   /* Interpolation scheme */
+   int ndim_in;                  /* Number of input grid dimensions */
+   int ndim_out;                 /* Number of output grid dimensions */
+   void (* finterp)( void );     /* User-supplied interpolation function */
+   void *out;                    /* Output data array */
+   void *out_var;                /* Output variance array */
+} ResampleJob;
+
+/* Structure holding the arguments for RebinSection that are shared by
+   all the blocks in a BlockQueue (see RebinTask). The blocks are divided
+   into "nchunk" contiguous chunks, each of which is rebinned into its own
+   set of output arrays. */
+typedef struct RebinJob {
+   AstMapping **maps;            /* Mapping to use within each worker */
+   AstMapping *unsimplified;     /* Original Mapping, for error reports */
+   BlockQueue *queue;            /* The blocks of input pixels */
+   const double *params;         /* Spreading parameters */
+   const int *lbnd_in;           /* Lower bounds of input grid */
+   const int *lbnd_out;          /* Lower bounds of output grid */
+   const int *ubnd_in;           /* Upper bounds of input grid */
+   const int *ubnd_out;          /* Upper bounds of output grid */
+   const void *badval_ptr;       /* Pointer to bad value */
+   const void *in;               /* Input data array */
+   const void *in_var;           /* Input variance array */
+   DataType type;                /* Data type */
+   double **work;                /* Weights array for each chunk */
+   int flags;                    /* Rebinning flags */
+   int nchunk;                   /* Number of chunks */
+   int ndim_in;                  /* Number of input grid dimensions */
+   int ndim_out;                 /* Number of output grid dimensions */
+   int spread;                   /* Spreading scheme */
+   int64_t *nused;               /* Number of input pixels used by each chunk */
+   int64_t npix_out;             /* Number of pixels in output grid */
+   void **out;                   /* Output data array for each chunk */
+   void **out_var;               /* Output variance array for each chunk */
+} RebinJob;
+
+/* Structure describing the resampling of a grid using a Mapping that can
+   be split into two independent Mappings, one for a single "channel"
+   axis and one for the remaining "plane" axes (see SeparableWeights and
+   ResampleSeparable<X>). Each output channel is formed from a weighted
+   mean of input planes, and each output pixel within a channel is then
+   formed from a weighted mean of the pixels in that intermediate plane.
+   Offsets are into the full input or output grid unless stated. */
+typedef struct SeparableJob {
+   const void *badval_ptr;       /* Pointer to bad value */
+   const void *in;               /* Input data array */
+   const void *in_var;           /* Input variance array */
+   double *wt_chan;              /* Channel weights */
+   double *wt_plane;             /* Plane weights */
+   int *base;                    /* Input offset of each plane pixel used */
+   int *cen_chan;                /* Input channel offset (-1 if outside) */
+   int *cen_plane;               /* Input plane offset (-1 if outside) */
+   int *in_chan;                 /* Input offset for each channel weight */
+   int *in_plane;                /* Index in "base" for each plane weight */
+   int *nbad;                    /* Returned no. of bad values per channel */
+   int *out_chan;                /* Output offset of each output channel */
+   int *out_plane;               /* Output offset of each pixel in a plane */
+   int *start_chan;              /* First weight for each output channel */
+   int *start_plane;             /* First weight for each plane pixel */
+   int flags;                    /* Resampling flags */
+   int nbase;                    /* Number of input plane pixels used */
+   int nchan;                    /* Number of output channels */
+   int nplane;                   /* Number of output pixels in each plane */
+   void *out;                    /* Output data array */
+   void *out_var;                /* Output variance array */
+   void *work;                   /* Intermediate plane for each worker */
+} SeparableJob;
+
+/* Structure describing a cache holding a limited number of tiles of an
+   input grid, each obtained when first needed from a user-supplied
+   tile-fetching function (see astResampleTiled<X>). When the cache is
+   full, the least recently used tile is discarded. */
+typedef struct TileCache {
+   AstTileFun fetch;             /* Function that obtains a tile */
+   char **buf;                   /* Data values for each cache slot */
+   char **buf_var;               /* Variances for each slot (or NULL) */
+   const int *tile;              /* Tile dimensions */
+   const int64_t *lbnd_in;       /* Lower bounds of input grid */
+   const int64_t *ubnd_in;       /* Upper bounds of input grid */
+   int64_t *key;                 /* Index of tile in each slot (-1 if none) */
+   int64_t *ntile;               /* Number of tiles along each axis */
+   int64_t *used;                /* When each slot was last used */
+   int64_t clock;                /* Number of tile requests so far */
+   int ncache;                   /* Number of cache slots */
+   int ndim;                     /* Number of input grid dimensions */
+   size_t size;                  /* Number of bytes in each value */
+   size_t tsize;                 /* Number of values in a full tile */
+   void *data;                   /* Pointer to pass to "fetch" */
+} TileCache;
+
 /* Convert from floating point to floating point or integer */
 #define CONV(IntType,val) ( ( IntType ) ? (int) ( (val) + (((val)>0)?0.5:-0.5) ) : (val) )
 
+/* Evaluate a kernel function by linear interpolation within a table
+   returned by KernelTable. This requires local variables "table",
+   "tscale", "tpos" and "tidx". */
+#define TABLE_KERNEL(offset,value) \
+   ( tpos = fabs( offset )*tscale, tidx = (int) tpos, \
+     ( value ) = table[ tidx ] + ( tpos - tidx )*( table[ tidx + 1 ] - table[ tidx ] ) )
+
 /* Module Variables. */
 /* ================= */
 
@@ -492,7 +657,13 @@ static int (* parent_equal)( AstObject *, AstObject *, int * );
    globals->Class_Init = 0; \
    globals->GetAttrib_Buff[ 0 ] = 0; \
    globals->Unsimplified_Mapping = NULL; \
-   globals->Rate_Disabled = 0;
+   globals->Rate_Disabled = 0; \
+   globals->Kernel_Table = NULL; \
+   globals->Kernel_Table_Par = 0.0; \
+   globals->Kernel_Table_Scale = 1.0; \
+   globals->Kernel_Table_Digits = 0; \
+   globals->Kernel_Table_Neighb = 0; \
+   globals->Kernel_Table_Fun = NULL;
 
 
 /* Create the function that initialises global data for this module. */
@@ -508,7 +679,16 @@ astMAKE_INITGLOBALS(Mapping)
 #define ratefun_pset2_cache astGLOBAL(Mapping,RateFun_Pset2_Cache)
 #define ratefun_next_slot astGLOBAL(Mapping,RateFun_Next_Slot)
 #define ratefun_pset_size astGLOBAL(Mapping,RateFun_Pset_Size)
+#define kernel_table astGLOBAL(Mapping,Kernel_Table)
+#define kernel_table_par astGLOBAL(Mapping,Kernel_Table_Par)
+#define kernel_table_scale astGLOBAL(Mapping,Kernel_Table_Scale)
+#define kernel_table_digits astGLOBAL(Mapping,Kernel_Table_Digits)
+#define kernel_table_neighb astGLOBAL(Mapping,Kernel_Table_Neighb)
+#define kernel_table_fun astGLOBAL(Mapping,Kernel_Table_Fun)
 
+static pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_MUTEX1 pthread_mutex_lock( &mutex1 );
+#define UNLOCK_MUTEX1 pthread_mutex_unlock( &mutex1 );
 
 
 /* If thread safety is not needed, declare and initialise globals at static
@@ -534,21 +714,39 @@ static AstPointSet *ratefun_pset2_cache[ RATEFUN_MAX_CACHE ];
 static int ratefun_next_slot;
 static int ratefun_pset_size[ RATEFUN_MAX_CACHE ];
 
+/* The tabulated 1-d kernel most recently created by function
+   "KernelTable", together with the details of the kernel it describes. */
+static double *kernel_table = NULL;
+static double kernel_table_par = 0.0;
+static double kernel_table_scale = 1.0;
+static int kernel_table_digits = 0;
+static int kernel_table_neighb = 0;
+static void (* kernel_table_fun)( double, const double [], int, double *, int * ) = NULL;
+
 
 /* Define the class virtual function table and its initialisation flag
    as static variables. */
 static AstMappingVtab class_vtab;   /* Virtual function table */
 static int class_init = 0;       /* Virtual function table initialised? */
 
+#define LOCK_MUTEX1
+#define UNLOCK_MUTEX1
+
 #endif
 
+/* The number of decimal places to which tabulated 1-d interpolation
+   kernels should reproduce the kernel function (see the "KernelTable"
+   tuning parameter). Zero causes kernels to be evaluated directly.
+   Access is protected by mutex1. */
+static int kerntab_digits = 7;
+
 /* Prototypes for private member functions. */
 /* ======================================== */
 
 #define DECLARE_GENERIC(X,Xtype) \
 static int InterpolateKernel1##X( AstMapping *, int, const int *, const int *, \
                                   const Xtype *, const Xtype *, int, \
-                                  const int *, const double *const *, \
+                                  const int64_t *, const double *const *, \
                                   void (*)( double, const double *, int, \
                                             double *, int * ), \
                                   void (*)( double, const double *, int, \
@@ -557,26 +755,44 @@ static int InterpolateKernel1##X( AstMapping *, int, const int *, const int *, \
                                   Xtype *, Xtype *, int * );\
 \
 static int InterpolateLinear##X( int, const int *, const int *, const Xtype *, \
-                                 const Xtype *, int, const int *, \
+                                 const Xtype *, int, const int64_t *, \
                                  const double *const *, int, Xtype, Xtype *, \
                                  Xtype *, int * ); \
 \
 static int InterpolateNearest##X( int, const int *, const int *, const Xtype *, \
-                                  const Xtype *, int, const int *, \
+                                  const Xtype *, int, const int64_t *, \
                                   const double *const *, int, Xtype, Xtype *, \
                                   Xtype *, int * ); \
 \
-static int Resample##X( AstMapping *, int, const int [], const int [], \
-                        const Xtype [], const Xtype [], int, \
-                        void (*)( void ), const double [], int, double, int, \
-                        Xtype, int, const int [], const int [], \
-                        const int [], const int [], Xtype [], Xtype [], int * ); \
-\
-static void ConserveFlux##X( double, int, const int *, Xtype, Xtype *, Xtype *, \
+static int64_t Resample##X( AstMapping *, int, const int [], const int [], \
+                            const Xtype [], const Xtype [], int, \
+                            void (*)( void ), const double [], int, double, \
+                            int, Xtype, int, const int [], const int [], \
+                            const int [], const int [], Xtype [], Xtype [], \
+                            int * ); \
+\
+static int64_t Resample8##X( AstMapping *, int, const int64_t [], \
+                             const int64_t [], const Xtype [], \
+                             const Xtype [], int, void (*)( void ), \
+                             const double [], int, double, int, Xtype, int, \
+                             const int64_t [], const int64_t [], \
+                             const int64_t [], const int64_t [], Xtype [], \
+                             Xtype [], int * ); \
+\
+static int ResampleSeparable##X( AstMapping *, int, const int [], \
+                                 const int [], const Xtype [], \
+                                 const Xtype [], int, const double [], int, \
+                                 double, int, Xtype, int, const int [], \
+                                 const int [], const int [], const int [], \
+                                 Xtype [], Xtype [], int *, int * ); \
+\
+static void ResampleSeparableTask##X( void *, int, int, int * ); \
+\
+static void ConserveFlux##X( double, int, const int64_t *, Xtype, Xtype *, Xtype *, \
                              int * ); \
 \
 static void InterpolateBlockAverage##X( int, const int[], const int[], \
-                             const Xtype [], const Xtype [], int, const int[], \
+                             const Xtype [], const Xtype [], int, const int64_t[], \
                              const double *const[], const double[], int, \
                              Xtype, Xtype *, Xtype *, int * );
 
@@ -611,21 +827,34 @@ static void RebinSeq##X( AstMapping *, double, int, const int [], const int [],
                          const int [], const int [], const int [], Xtype [], \
                          Xtype [], double [], int64_t *, int * ); \
 \
+static void Rebin8##X( AstMapping *, double, int, const int64_t [], \
+                       const int64_t [], const Xtype [], const Xtype [], int, \
+                       const double [], int, double, int, Xtype, int, \
+                       const int64_t [], const int64_t [], const int64_t [], \
+                       const int64_t [], Xtype [], Xtype [], int * ); \
+\
+static void RebinSeq8##X( AstMapping *, double, int, const int64_t [], \
+                          const int64_t [], const Xtype [], const Xtype [], \
+                          int, const double [], int, double, int, Xtype, int, \
+                          const int64_t [], const int64_t [], \
+                          const int64_t [], const int64_t [], Xtype [], \
+                          Xtype [], double [], int64_t *, int * ); \
+\
 static void SpreadKernel1##X( AstMapping *, int, const int *, const int *, \
-                         const Xtype *, const Xtype *, double, int, const int *, \
+                         const Xtype *, const Xtype *, double, int, const int64_t *, \
                          const double *const *, \
                          void (*)( double, const double *, int, double *, int * ), \
-                         int, const double *, int, Xtype, int, Xtype *, \
+                         int, const double *, int, Xtype, int64_t, Xtype *, \
                          Xtype *, double *, int64_t *, int * ); \
 \
 static void SpreadLinear##X( int, const int *, const int *, const Xtype *, \
-                             const Xtype *, double, int, const int *, const double *const *, \
-                             int, Xtype, int, Xtype *, Xtype *, double *, int64_t *, \
+                             const Xtype *, double, int, const int64_t *, const double *const *, \
+                             int, Xtype, int64_t, Xtype *, Xtype *, double *, int64_t *, \
                              int * ); \
 \
 static void SpreadNearest##X( int, const int *, const int *, const Xtype *, \
-                              const Xtype *, double, int, const int *, const double *const *, \
-                              int, Xtype, int, Xtype *, Xtype *, double *, \
+                              const Xtype *, double, int, const int64_t *, const double *const *, \
+                              int, Xtype, int64_t, Xtype *, Xtype *, double *, \
                               int64_t *, int * );
 
 DECLARE_GENERIC(D,double)
@@ -651,6 +880,7 @@ static AstPointSet *Transform( AstMapping *, AstPointSet *, int, AstPointSet *,
 static const char *GetAttrib( AstObject *, const char *, int * );
 static double FindGradient( AstMapping *, double *, int, int, double, double, double *, int * );
 static double J1Bessel( double, int * );
+static const double *KernelTable( void (*)( double, const double [], int, double *, int * ), const double *, int, double *, int * );
 static double LocalMaximum( const MapData *, double, double, double [], int * );
 static double MapFunction( const MapData *, const double [], int *, int * );
 static double MatrixDet( int, int, const double *, int * );
@@ -660,6 +890,7 @@ static double Random( long int *, int * );
 static double Rate( AstMapping *, double *, int, int, int * );
 static double UphillSimplex( const MapData *, double, int, const double [], double [], double *, int *, int * );
 static int *MapSplit( AstMapping *, int, const int *, AstMapping **, int * );
+static int *NarrowBounds( int, const int64_t *, const char *, const char *, int * );
 static int Equal( AstObject *, AstObject *, int * );
 static int GetInvert( AstMapping *, int * );
 static int GetIsLinear( AstMapping *, int * );
@@ -676,15 +907,27 @@ static int MaxI( int, int, int * );
 static int MinI( int, int, int * );
 static int DoNotSimplify( AstMapping *, int * );
 static int QuadApprox( AstMapping *, const double[2], const double[2], int, int, double *, double *, int * );
-static int RebinAdaptively( AstMapping *, int, const int *, const int *, const void *, const void *, DataType, int, const double *, int, double, int, const void *, int, const int *, const int *, const int *, const int *, int, void *, void *, double *, int64_t *, int * );
-static int RebinWithBlocking( AstMapping *, const double *, int, const int *, const int *, const void *, const void *, DataType, int, const double *, int, const void *, int, const int *, const int *, const int *, const int *, int, void *, void *, double *, int64_t *, int * );
-static int ResampleAdaptively( AstMapping *, int, const int *, const int *, const void *, const void *, DataType, int, void (*)( void ), const double *, int, double, int, const void *, int, const int *, const int *, const int *, const int *, void *, void *, int * );
+static AstMapping **FreeWorkerMappings( AstMapping **, int, int * );
+static AstMapping **WorkerMappings( AstMapping *, int, int * );
+static int64_t *WidenBounds( int, const int *, int * );
+static int QueueFit( BlockQueue *, const double *, int * );
+static int RebinAdaptively( AstMapping *, int, const int *, const int *, const void *, const void *, DataType, int, const double *, int, double, int, const void *, int, const int *, const int *, const int *, const int *, int64_t, void *, void *, double *, int64_t *, BlockQueue *, int * );
+static int RebinInParallel( AstMapping *, int, int, const int *, const int *, const void *, const void *, DataType, int, const double *, int, double, int, const void *, int, const int *, const int *, const int *, const int *, int64_t, void *, void *, double *, int64_t *, int * );
+static int RebinWithBlocking( AstMapping *, const double *, int, const int *, const int *, const void *, const void *, DataType, int, const double *, int, const void *, int, const int *, const int *, const int *, const int *, int64_t, void *, void *, double *, int64_t *, BlockQueue *, int * );
+static int64_t ResampleAdaptively( AstMapping *, int, const int *, const int *, const void *, const void *, DataType, int, void (*)( void ), const double *, int, double, int, const void *, int, const int *, const int *, const int *, const int *, void *, void *, BlockQueue *, int * );
+static int64_t ResampleTiled( AstMapping *, int, const int64_t [], const int64_t [], const int [], AstTileFun, void *, int, DataType, int, void (*)( void ), const double [], int, double, int, const void *, int, const int64_t [], const int64_t [], const int64_t [], const int64_t [], void *, void *, int * );
+static int64_t ResampleInParallel( AstMapping *, int, int, const int *, const int *, const void *, const void *, DataType, int, void (*)( void ), const double *, int, double, int, const void *, int, const int *, const int *, const int *, const int *, void *, void *, int * );
 static int ResampleSection( AstMapping *, const double *, int, const int *, const int *, const void *, const void *, DataType, int, void (*)( void ), const double *, double, int, const void *, int, const int *, const int *, const int *, const int *, void *, void *, int * );
-static int ResampleWithBlocking( AstMapping *, const double *, int, const int *, const int *, const void *, const void *, DataType, int, void (*)( void ), const double *, int, const void *, int, const int *, const int *, const int *, const int *, void *, void *, int * );
+static int64_t ResampleWithBlocking( AstMapping *, const double *, int, const int *, const int *, const void *, const void *, DataType, int, void (*)( void ), const double *, int, const void *, int, const int *, const int *, const int *, const int *, void *, void *, BlockQueue *, int * );
+static int SeparableWeights( AstMapping *, int, const int *, const int *, int, const double *, double, int, const int *, const int *, const int *, const int *, SeparableJob *, int * );
 static int SpecialBounds( const MapData *, double *, double *, double [], double [], int * );
 static int TestAttrib( AstObject *, const char *, int * );
 static int TestInvert( AstMapping *, int * );
 static int TestReport( AstMapping *, int * );
+static int TileCacheGet( TileCache *, const int64_t [], int64_t [], int64_t [], int * );
+static TileCache *TileCacheFree( TileCache *, int * );
+static TileCache *TileCacheNew( int, const int64_t [], const int64_t [], const int [], AstTileFun, void *, int, size_t, int, int * );
+static void TileCacheFill( TileCache *, const int64_t [], const int64_t [], void *, void *, int * );
 static void ClearAttrib( AstObject *, const char *, int * );
 static void ClearInvert( AstMapping *, int * );
 static void ClearReport( AstMapping *, int * );
@@ -697,11 +940,19 @@ static void GlobalBounds( MapData *, double *, double *, double [], double [], i
 static void Invert( AstMapping *, int * );
 static void MapBox( AstMapping *, const double [], const double [], int, int, double *, double *, double [], double [], int * );
 static void RateFun( AstMapping *, double *, int, int, int, double *, double *, int * );
-static void RebinSection( AstMapping *, const double *, int, const int *, const int *, const void *, const void *, double, DataType, int, const double *, int, const void *, int, const int *, const int *, const int *, const int *, int, void *, void *, double *, int64_t *, int * );
+static void AddRebinArrays( DataType, int64_t, const void *, void *, int * );
+static void FreeQueue( BlockQueue *, int * );
+static void FreeSeparable( SeparableJob *, int * );
+static void QueueBlock( BlockQueue *, int, double, const int *, const int *, int * );
+static void RebinSection( AstMapping *, const double *, int, const int *, const int *, const void *, const void *, double, DataType, int, const double *, int, const void *, int, const int *, const int *, const int *, const int *, int64_t, void *, void *, double *, int64_t *, int * );
+static void RebinTask( void *, int, int, int * );
+static void ResampleTask( void *, int, int, int * );
+static int ResampleWeights( AstMapping *, int, const int [], const int [], int, const double [], double, int, int, const int [], const int [], const int [], const int [], int **, int **, int **, int **, double **, int * );
 static void ReportPoints( AstMapping *, int, AstPointSet *, AstPointSet *, int * );
 static void SetAttrib( AstObject *, const char *, int * );
 static void SetInvert( AstMapping *, int, int * );
 static void SetReport( AstMapping *, int, int * );
+static void SetupKernel1( int, const double [], void (**)( double, const double [], int, double *, int * ), double [ 1 ], const double **, int *, int * );
 static void Sinc( double, const double [], int, double *, int * );
 static void SincCos( double, const double [], int, double *, int * );
 static void SincGauss( double, const double [], int, double *, int * );
@@ -710,7 +961,8 @@ static void Somb( double, const double [], int, double *, int * );
 static void SombCos( double, const double [], int, double *, int * );
 static void Tran1( AstMapping *, int, const double [], int, double [], int * );
 static void Tran2( AstMapping *, int, const double [], const double [], int, double [], double [], int * );
-static void TranGrid( AstMapping *, int, const int[], const int[], double, int, int, int, int, double *, int * );
+static void TranGrid( AstMapping *, int, const int[], const int[], double, int, int, int, int64_t, double *, int * );
+static void TranGrid8( AstMapping *, int, const int64_t[], const int64_t[], double, int, int, int, int64_t, double *, int * );
 static void TranGridAdaptively( AstMapping *, int, const int[], const int[], const int[], const int[], double, int, int, double *[], int * );
 static void TranGridSection( AstMapping *, const double *, int, const int *, const int *, const int *, const int *, int, double *[], int * );
 static void TranGridWithBlocking( AstMapping *, const double *, int, const int *, const int *, const int *, const int *, int, double *[], int * );
@@ -722,6 +974,87 @@ static void ValidateMapping( AstMapping *, int, int, int, int, const char *, int
 
 /* Member functions. */
 /* ================= */
+static void AddRebinArrays( DataType type, int64_t n, const void *src,
+                            void *dst, int *status ) {
+/*
+*  Name:
+*     AddRebinArrays
+
+*  Purpose:
+*     Add one array of rebinned values onto another.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void AddRebinArrays( DataType type, int64_t n, const void *src,
+*                          void *dst, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function adds each element of one array onto the corresponding
+*     element of another array. It is used by RebinInParallel to combine
+*     the private output arrays used by each worker thread.
+
+*  Parameters:
+*     type
+*        A value taken from the "DataType" enum, which specifies the data
+*        type of the arrays. Only the data types supported by astRebin<X>
+*        are handled (other types are ignored).
+*     n
+*        The number of elements in each array.
+*     src
+*        Pointer to the array holding the values to be added. If NULL,
+*        the function returns without action.
+*     dst
+*        Pointer to the array to be incremented. If NULL, the function
+*        returns without action.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   int64_t i;                    /* Array index */
+
+/* Check the global error status and the supplied pointers. */
+   if ( !astOK || !src || !dst ) return;
+
+/* Define a macro to add the arrays for a given data type. */
+#define CASE_ADD(X,Xtype) \
+      case ( TYPE_##X ): { \
+         const Xtype *ps = (const Xtype *) src; \
+         Xtype *pd = (Xtype *) dst; \
+         for( i = 0; i < n; i++ ) pd[ i ] += ps[ i ]; \
+      } \
+      break;
+
+/* Use the above macro to add the arrays. */
+   switch ( type ) {
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+      CASE_ADD(LD,long double)
+#endif
+      CASE_ADD(D,double)
+      CASE_ADD(F,float)
+      CASE_ADD(I,int)
+      CASE_ADD(B,char)
+      CASE_ADD(UB,unsigned char)
+
+      case ( TYPE_L ): break;
+      case ( TYPE_K ): break;
+      case ( TYPE_S ): break;
+      case ( TYPE_UL ): break;
+      case ( TYPE_UI ): break;
+      case ( TYPE_UK ): break;
+      case ( TYPE_US ): break;
+   }
+
+/* Undefine the macro. */
+#undef CASE_ADD
+}
+
 static void ClearAttrib( AstObject *this_object, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -810,7 +1143,7 @@ static void ClearAttrib( AstObject *this_object, const char *attrib, int *status
 
 *  Synopsis:
 *     #include "mapping.h"
-*     void ConserveFlux<X>( double factor, int npoint, const int *offset,
+*     void ConserveFlux<X>( double factor, int npoint, const int64_t *offset,
 *                           <Xtype> badval, <Xtype> *out,
 *                           <Xtype> *out_var )
 
@@ -862,12 +1195,12 @@ static void ClearAttrib( AstObject *this_object, const char *attrib, int *status
 /* Define a macro to implement the function for a specific data
    type. */
 #define MAKE_CONSERVEFLUX(X,Xtype) \
-static void ConserveFlux##X( double factor, int npoint, const int *offset, \
+static void ConserveFlux##X( double factor, int npoint, const int64_t *offset, \
                              Xtype badval, Xtype *out, Xtype *out_var, int *status ) { \
 \
 /* Local Variables: */ \
-   int off_out;                  /* Pixel offset into output array */ \
    int point;                    /* Loop counter for output points */ \
+   int64_t off_out;              /* Pixel offset into output array */ \
 \
 \
 /* Check the global error status. */ \
@@ -1320,6 +1653,164 @@ static double FindGradient( AstMapping *map, double *at, int ax1, int ax2,
    return ret;
 }
 
+static void FreeQueue( BlockQueue *queue, int *status ) {
+/*
+*  Name:
+*     FreeQueue
+
+*  Purpose:
+*     Free the memory used by a queue of pixel blocks.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void FreeQueue( BlockQueue *queue, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function frees the dynamic memory used by a BlockQueue
+*     structure, and empties the queue. The structure itself is not
+*     freed.
+
+*  Parameters:
+*     queue
+*        Pointer to the queue.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*/
+
+/* Free the arrays and empty the queue. */
+   queue->bounds = astFree( queue->bounds );
+   queue->ifit = astFree( queue->ifit );
+   queue->factor = astFree( queue->factor );
+   queue->fits = astFree( queue->fits );
+   queue->nblock = 0;
+   queue->nfit = 0;
+}
+
+static void FreeSeparable( SeparableJob *job, int *status ) {
+/*
+*  Name:
+*     FreeSeparable
+
+*  Purpose:
+*     Free the memory used by a SeparableJob.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void FreeSeparable( SeparableJob *job, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function frees the dynamic memory used by a SeparableJob
+*     structure (see SeparableWeights). The structure itself is not
+*     freed.
+
+*  Parameters:
+*     job
+*        Pointer to the SeparableJob.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*/
+
+/* Free the arrays. */
+   job->wt_chan = astFree( job->wt_chan );
+   job->wt_plane = astFree( job->wt_plane );
+   job->base = astFree( job->base );
+   job->cen_chan = astFree( job->cen_chan );
+   job->cen_plane = astFree( job->cen_plane );
+   job->in_chan = astFree( job->in_chan );
+   job->in_plane = astFree( job->in_plane );
+   job->nbad = astFree( job->nbad );
+   job->out_chan = astFree( job->out_chan );
+   job->out_plane = astFree( job->out_plane );
+   job->start_chan = astFree( job->start_chan );
+   job->start_plane = astFree( job->start_plane );
+   job->work = astFree( job->work );
+   job->nbase = 0;
+   job->nchan = 0;
+   job->nplane = 0;
+}
+
+static AstMapping **FreeWorkerMappings( AstMapping **maps, int nworker,
+                                        int *status ) {
+/*
+*  Name:
+*     FreeWorkerMappings
+
+*  Purpose:
+*     Free the Mappings created by WorkerMappings.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     AstMapping **FreeWorkerMappings( AstMapping **maps, int nworker,
+*                                      int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function re-locks each of the Mapping copies created by
+*     WorkerMappings for use by the calling thread, annuls them, and
+*     then frees the array holding the Mapping pointers.
+
+*  Parameters:
+*     maps
+*        The array returned by WorkerMappings (may be NULL).
+*     nworker
+*        The number of elements in the "maps" array.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A NULL pointer.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*/
+
+/* Local Variables: */
+   int iworker;                  /* Worker index */
+
+/* Check an array was supplied. */
+   if ( !maps ) return NULL;
+
+/* The first element is a clone of the original Mapping, which is already
+   locked by the calling thread. The others are copies that were left
+   unlocked, so lock them before annulling them. */
+   for( iworker = 0; iworker < nworker; iworker++ ) {
+      if( maps[ iworker ] ) {
+         if( iworker > 0 ) astManageLock( maps[ iworker ], AST__LOCK, 1,
+                                          NULL );
+         maps[ iworker ] = astAnnul( maps[ iworker ] );
+      }
+   }
+
+/* Free the array. */
+   return astFree( maps );
+}
+
 static void Gauss( double offset, const double params[], int flags,
                    double *value, int *status ) {
 /*
@@ -2403,6 +2894,80 @@ static void GlobalBounds( MapData *mapdata, double *lbnd, double *ubnd,
 #undef FILL_POSITION_BUFFER
 }
 
+/* Typed access functions for the attributes declared using
+   astDeclareAttribI in astInitMappingVtab. */
+astMAKE_ATTRIBGET(Mapping,Invert,int)
+astMAKE_ATTRIBSET(Mapping,Invert,int)
+astMAKE_ATTRIBTEST(Mapping,Invert)
+astMAKE_ATTRIBCLEAR(Mapping,Invert)
+astMAKE_ATTRIBGET(Mapping,IsLinear,int)
+astMAKE_ATTRIBGET(Mapping,IsSimple,int)
+astMAKE_ATTRIBGET(Mapping,Nin,int)
+astMAKE_ATTRIBGET(Mapping,Nout,int)
+astMAKE_ATTRIBGET(Mapping,Report,int)
+astMAKE_ATTRIBSET(Mapping,Report,int)
+astMAKE_ATTRIBTEST(Mapping,Report)
+astMAKE_ATTRIBCLEAR(Mapping,Report)
+astMAKE_ATTRIBGET(Mapping,TranForward,int)
+astMAKE_ATTRIBGET(Mapping,TranInverse,int)
+
+int astKernelTable_( int newval, int *status ){
+/*
+*+
+*  Name:
+*     astKernelTable
+
+*  Purpose:
+*     Get or set the KernelTable tuning parameter.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int astKernelTable( int newval )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function returns the current value of the KernelTable tuning
+*     parameter (see astTune), optionally storing a new value. This is
+*     the number of decimal places to which the 1-dimensional kernels
+*     used by astResample<X> and astRebin<X> (e.g. AST__SINCSINC) are
+*     reproduced by interpolating within a table of pre-computed kernel
+*     values. A value of zero causes the kernel functions to be
+*     evaluated directly.
+*
+*     All threads share the same value.
+
+*  Parameters:
+*     newval
+*        The new value for the KernelTable tuning parameter. If AST__TUNULL
+*        is supplied, the current value is left unchanged. Negative values
+*        are treated as zero.
+
+*  Returned Value:
+*     astKernelTable()
+*        The original value of the KernelTable tuning parameter.
+
+*  Notes:
+*     - This function attempts to execute even if the AST error status
+*     is set on entry.
+*-
+*/
+
+/* Local Variables: */
+   int result;
+
+   LOCK_MUTEX1
+   result = kerntab_digits;
+   if( newval != AST__TUNULL ) kerntab_digits = ( newval > 0 ) ? newval : 0;
+   UNLOCK_MUTEX1
+
+   return result;
+}
+
 void astInitMappingVtab_(  AstMappingVtab *vtab, const char *name, int *status ) {
 /*
 *+
@@ -2465,7 +3030,7 @@ void astInitMappingVtab_(  AstMappingVtab *vtab, const char *name, int *status )
 /* Store pointers to the member functions (implemented here) that provide
    virtual methods for this class. */
 #define VTAB_GENERIC(X) \
-   vtab->Resample##X = Resample##X;
+   vtab->Resample8##X = Resample8##X;
 
 VTAB_GENERIC(B)
 VTAB_GENERIC(D)
@@ -2487,8 +3052,8 @@ VTAB_GENERIC(LD)
 #undef VTAB_GENERIC
 
 #define VTAB_GENERIC(X) \
-   vtab->Rebin##X = Rebin##X; \
-   vtab->RebinSeq##X = RebinSeq##X;
+   vtab->Rebin8##X = Rebin8##X; \
+   vtab->RebinSeq8##X = RebinSeq8##X;
 
 VTAB_GENERIC(D)
 VTAB_GENERIC(F)
@@ -2524,6 +3089,7 @@ VTAB_GENERIC(LD)
    vtab->QuadApprox = QuadApprox;
    vtab->Rate = Rate;
    vtab->ReportPoints = ReportPoints;
+   vtab->ResampleWeights = ResampleWeights;
    vtab->RemoveRegions = RemoveRegions;
    vtab->SetInvert = SetInvert;
    vtab->SetReport = SetReport;
@@ -2532,7 +3098,7 @@ VTAB_GENERIC(LD)
    vtab->TestReport = TestReport;
    vtab->Tran1 = Tran1;
    vtab->Tran2 = Tran2;
-   vtab->TranGrid = TranGrid;
+   vtab->TranGrid8 = TranGrid8;
    vtab->TranN = TranN;
    vtab->TranP = TranP;
    vtab->Transform = Transform;
@@ -2557,6 +3123,21 @@ VTAB_GENERIC(LD)
    astSetCopy( vtab, Copy );
    astSetDump( vtab, Dump, "Mapping", "Mapping between coordinate systems" );
 
+/* Declare typed access functions for the attributes that are read most
+   often, so that astGetI, etc., need not format and parse their values. */
+   astDeclareAttribI( vtab, "invert", GetInvertAttrib, SetInvertAttrib,
+                      TestInvertAttrib, ClearInvertAttrib );
+   astDeclareAttribI( vtab, "islinear", GetIsLinearAttrib, NULL, NULL, NULL );
+   astDeclareAttribI( vtab, "issimple", GetIsSimpleAttrib, NULL, NULL, NULL );
+   astDeclareAttribI( vtab, "nin", GetNinAttrib, NULL, NULL, NULL );
+   astDeclareAttribI( vtab, "nout", GetNoutAttrib, NULL, NULL, NULL );
+   astDeclareAttribI( vtab, "report", GetReportAttrib, SetReportAttrib,
+                      TestReportAttrib, ClearReportAttrib );
+   astDeclareAttribI( vtab, "tranforward", GetTranForwardAttrib, NULL, NULL,
+                      NULL );
+   astDeclareAttribI( vtab, "traninverse", GetTranInverseAttrib, NULL, NULL,
+                      NULL );
+
 /* If we have just initialised the vtab for the current class, indicate
    that the vtab is now initialised, and store a pointer to the class
    identifier in the base "object" level of the vtab. */
@@ -2581,7 +3162,7 @@ VTAB_GENERIC(LD)
 *     int InterpolateKernel1<X>( AstMapping *this, int ndim_in,
 *                                const int *lbnd_in, const int *ubnd_in,
 *                                const <Xtype> *in, const <Xtype> *in_var,
-*                                int npoint, const int *offset,
+*                                int npoint, const int64_t *offset,
 *                                const double *const *coords,
 *                                void (* kernel)( double, const double [], int,
 *                                                 double *, int * ),
@@ -2745,7 +3326,7 @@ VTAB_GENERIC(LD)
 static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
                                   const int *lbnd_in, const int *ubnd_in, \
                                   const Xtype *in, const Xtype *in_var, \
-                                  int npoint, const int *offset, \
+                                  int npoint, const int64_t *offset, \
                                   const double *const *coords, \
                                   void (* kernel)( double, const double [], \
                                                    int, double *, int * ), \
@@ -2766,6 +3347,7 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
    Xfloattype wtsum;             /* Sum of weight values */ \
    Xfloattype wtsum_sq;          /* Square of sum of weights */ \
    Xtype var;                    /* Variance value */ \
+   const double *table;          /* Tabulated kernel values */ \
    double **wtptr;               /* Pointer to array of weight pointers */ \
    double **wtptr_last;          /* Array of highest weight pointer values */ \
    double *kval;                 /* Pointer to array of kernel values */ \
@@ -2773,6 +3355,8 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
    double *xn_max;               /* Pointer to upper limits array (n-d) */ \
    double *xn_min;               /* Pointer to lower limits array (n-d) */ \
    double pixwt;                 /* Weight to apply to individual pixel */ \
+   double tpos;                  /* Position within kernel table */ \
+   double tscale;                /* Kernel table elements per unit offset */ \
    double wt_y;                  /* Value of y-dependent pixel weight */ \
    double x;                     /* x coordinate value */ \
    double xmax;                  /* x upper limit */ \
@@ -2783,7 +3367,6 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
    double ymin;                  /* y lower limit */ \
    int *hi;                      /* Pointer to array of upper indices */ \
    int *lo;                      /* Pointer to array of lower indices */ \
-   int *stride;                  /* Pointer to array of dimension strides */ \
    int bad;                      /* Output pixel bad? */ \
    int bad_var;                  /* Output variance bad? */ \
    int done;                     /* All pixel indices done? */ \
@@ -2798,16 +3381,18 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
    int lo_x;                     /* Lower pixel index (x dimension) */ \
    int lo_y;                     /* Lower pixel index (y dimension) */ \
    int nobad;                    /* Was the AST__NOBAD flag set? */ \
-   int off1;                     /* Input pixel offset due to y index */ \
-   int off_in;                   /* Offset to input pixel */ \
-   int off_out;                  /* Offset to output pixel */ \
-   int pixel;                    /* Offset to input pixel containing point */ \
    int point;                    /* Loop counter for output points */ \
    int result;                   /* Result value to return */ \
-   int s;                        /* Temporary variable for strides */ \
+   int tidx;                     /* Index of kernel table element */ \
    int usebad;                   /* Use "bad" input pixel values? */ \
    int usevar;                   /* Process variance array? */ \
-   int ystride;                  /* Stride along input grid y dimension */ \
+   int64_t *stride;              /* Pointer to array of dimension strides */ \
+   int64_t off1;                 /* Input pixel offset due to y index */ \
+   int64_t off_in;               /* Offset to input pixel */ \
+   int64_t off_out;              /* Offset to output pixel */ \
+   int64_t pixel;                /* Offset to input pixel containing point */ \
+   int64_t s;                    /* Temporary variable for strides */ \
+   int64_t ystride;              /* Stride along input grid y dimension */ \
 \
 /* Initialise. */ \
    result = 0; \
@@ -2828,6 +3413,10 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
    bad_var = 0; \
    sum = 0.0; \
 \
+/* If an internal kernel function is being used, obtain a table of kernel \
+   values that allows the kernel to be evaluated by interpolation. */ \
+   table = kernel ? KernelTable( kernel, params, neighb, &tscale, status ) : NULL; \
+\
 /* Determine if we are processing bad pixels or variances. */ \
    nobad = flags & AST__NOBAD; \
    usebad = flags & AST__USEBAD; \
@@ -3009,7 +3598,7 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
 /* Allocate workspace. */ \
       hi = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
       lo = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
-      stride = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
+      stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_in ); \
       xn_max = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
       xn_min = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
       kval = astMalloc( sizeof( double ) * (size_t) \
@@ -3172,7 +3761,9 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
 /* If necessary, test if the input pixel is bad. If not, calculate its \
    weight by evaluating the kernel function. */ \
             if ( !( Usebad ) || ( in[ off_in ] != badval ) ) { \
-               if( kernel ) { \
+               if( table ) { \
+                  TABLE_KERNEL( (double) ix - x, pixwt ); \
+               } else if( kernel ) { \
                   ( *kernel )( (double) ix - x, params, flags, &pixwt, status ); \
                } else { \
                   ( *fkernel )( (double) ix - x, params, flags, &pixwt ); \
@@ -3259,8 +3850,13 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
 /* Loop to evaluate the kernel function along the x dimension, storing \
    the resulting values. The function's argument is the offset of the \
    contributing pixel (along this dimension) from the input \
-   position. */ \
-            for ( ix = lo_x; ix <= hi_x; ix++ ) { \
+   position. If a kernel table is available, use a simple loop with no \
+   error checking, which the compiler may be able to vectorise. */ \
+            if( table ) { \
+               for ( ix = lo_x; ix <= hi_x; ix++ ) { \
+                  TABLE_KERNEL( (double) ix - x, kval[ ix - lo_x ] ); \
+               } \
+            } else for ( ix = lo_x; ix <= hi_x; ix++ ) { \
                if( kernel ) { \
                   ( *kernel )( (double) ix - x, params, flags, \
                                kval + ix - lo_x, status ); \
@@ -3289,7 +3885,9 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
    kernel function for each y index value. */ \
             off1 = lo_x - lbnd_in[ 0 ] + ystride * ( lo_y - lbnd_in[ 1 ] ); \
             for ( iy = lo_y; iy <= hi_y; iy++, off1 += ystride ) { \
-               if( kernel ) { \
+               if( table ) { \
+                  TABLE_KERNEL( (double) iy - y, wt_y ); \
+               } else if( kernel ) { \
                   ( *kernel )( (double) iy - y, params, flags, &wt_y, status ); \
                } else { \
                   ( *fkernel )( (double) iy - y, params, flags, &wt_y ); \
@@ -3411,7 +4009,11 @@ static int InterpolateKernel1##X( AstMapping *this, int ndim_in, \
    contributing pixel (along the relevant dimension) from the input \
    point. */ \
          xn = coords[ idim ][ point ]; \
-         for ( ixn = lo[ idim ]; ixn <= hi[ idim ]; ixn++ ) { \
+         if( table ) { \
+            for ( ixn = lo[ idim ]; ixn <= hi[ idim ]; ixn++ ) { \
+               TABLE_KERNEL( (double) ixn - xn, wtptr[ idim ][ ixn - lo[ idim ] ] ); \
+            } \
+         } else for ( ixn = lo[ idim ]; ixn <= hi[ idim ]; ixn++ ) { \
             if( kernel ) { \
                ( *kernel )( (double) ixn - xn, params, flags, \
                             wtptr[ idim ] + ixn - lo[ idim ], status ); \
@@ -3752,7 +4354,7 @@ MAKE_INTERPOLATE_KERNEL1(UB,unsigned char,0,float,0)
 *     int InterpolateLinear<X>( int ndim_in,
 *                               const int *lbnd_in, const int *ubnd_in,
 *                               const <Xtype> *in, const <Xtype> *in_var,
-*                               int npoint, const int *offset,
+*                               int npoint, const int64_t *offset,
 *                               const double *const *coords,
 *                               int flags, <Xtype> badval,
 *                               <Xtype> *out, <Xtype> *out_var )
@@ -3895,7 +4497,7 @@ MAKE_INTERPOLATE_KERNEL1(UB,unsigned char,0,float,0)
 static int InterpolateLinear##X( int ndim_in, \
                                  const int *lbnd_in, const int *ubnd_in, \
                                  const Xtype *in, const Xtype *in_var, \
-                                 int npoint, const int *offset, \
+                                 int npoint, const int64_t *offset, \
                                  const double *const *coords, \
                                  int flags, Xtype badval, \
                                  Xtype *out, Xtype *out_var, int *status ) { \
@@ -3927,7 +4529,6 @@ static int InterpolateLinear##X( int ndim_in, \
    int *dim;                     /* Pointer to array of pixel indices */ \
    int *hi;                      /* Pointer to array of upper indices */ \
    int *lo;                      /* Pointer to array of lower indices */ \
-   int *stride;                  /* Pointer to array of dimension strides */ \
    int bad;                      /* Output pixel bad? */ \
    int bad_var;                  /* Output variance bad? */ \
    int done;                     /* All pixel indices done? */ \
@@ -3941,16 +4542,17 @@ static int InterpolateLinear##X( int ndim_in, \
    int lo_x;                     /* Lower pixel index (x dimension) */ \
    int lo_y;                     /* Lower pixel index (y dimension) */ \
    int nobad;                    /* Was the AST__NOBAD flag set? */ \
-   int off_in;                   /* Offset to input pixel */ \
-   int off_lo;                   /* Offset to "first" input pixel */ \
-   int off_out;                  /* Offset to output pixel */ \
-   int pixel;                    /* Offset to input pixel containing point */ \
    int point;                    /* Loop counter for output points */ \
    int result;                   /* Result value to return */ \
-   int s;                        /* Temporary variable for strides */ \
    int usebad;                   /* Use "bad" input pixel values? */ \
    int usevar;                   /* Process variance array? */ \
-   int ystride;                  /* Stride along input grid y dimension */ \
+   int64_t *stride;              /* Pointer to array of dimension strides */ \
+   int64_t off_in;               /* Offset to input pixel */ \
+   int64_t off_lo;               /* Offset to "first" input pixel */ \
+   int64_t off_out;              /* Offset to output pixel */ \
+   int64_t pixel;                /* Offset to input pixel containing point */ \
+   int64_t s;                    /* Temporary variable for strides */ \
+   int64_t ystride;              /* Stride along input grid y dimension */ \
 \
 /* Initialise. */ \
    result = 0; \
@@ -4146,7 +4748,7 @@ static int InterpolateLinear##X( int ndim_in, \
       frac_lo = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
       hi = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
       lo = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
-      stride = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
+      stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_in ); \
       wt = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
       wtprod = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
       xn_max = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
@@ -4696,7 +5298,7 @@ MAKE_INTERPOLATE_LINEAR(UB,unsigned char,0,float,0)
 *     int InterpolateNearest<X>( int ndim_in,
 *                                const int *lbnd_in, const int *ubnd_in,
 *                                const <Xtype> *in, const <Xtype> *in_var,
-*                                int npoint, const int *offset,
+*                                int npoint, const int64_t *offset,
 *                                const double *const *coords,
 *                                int flags, <Xtype> badval,
 *                                <Xtype> *out, <Xtype> *out_var )
@@ -4837,7 +5439,7 @@ MAKE_INTERPOLATE_LINEAR(UB,unsigned char,0,float,0)
 static int InterpolateNearest##X( int ndim_in, \
                                   const int *lbnd_in, const int *ubnd_in, \
                                   const Xtype *in, const Xtype *in_var, \
-                                  int npoint, const int *offset, \
+                                  int npoint, const int64_t *offset, \
                                   const double *const *coords, \
                                   int flags, Xtype badval, \
                                   Xtype *out, Xtype *out_var, int *status ) { \
@@ -4853,21 +5455,21 @@ static int InterpolateNearest##X( int ndim_in, \
    double y;                     /* y coordinate value */ \
    double ymax;                  /* y upper limit */ \
    double ymin;                  /* y lower limit */ \
-   int *stride;                  /* Pointer to array of dimension strides */ \
    int bad;                      /* Output pixel bad? */ \
    int idim;                     /* Loop counter for dimensions */ \
    int ix;                       /* Number of pixels offset in x direction */ \
    int ixn;                      /* Number of pixels offset (n-d) */ \
    int iy;                       /* Number of pixels offset in y direction */ \
    int nobad;                    /* Was the AST__NOBAD flag set? */ \
-   int off_in;                   /* Pixel offset into input array */ \
-   int off_out;                  /* Pixel offset into output array */ \
    int point;                    /* Loop counter for output points */ \
    int result;                   /* Returned result value */ \
-   int s;                        /* Temporary variable for strides */ \
    int usebad;                   /* Use "bad" input pixel values? */ \
    int usevar;                   /* Process variance array? */ \
-   int ystride;                  /* Stride along input grid y direction */ \
+   int64_t *stride;              /* Pointer to array of dimension strides */ \
+   int64_t off_in;               /* Pixel offset into input array */ \
+   int64_t off_out;              /* Pixel offset into output array */ \
+   int64_t s;                    /* Temporary variable for strides */ \
+   int64_t ystride;              /* Stride along input grid y direction */ \
 \
 /* Initialise. */ \
    result = 0; \
@@ -5038,7 +5640,7 @@ static int InterpolateNearest##X( int ndim_in, \
    } else { \
 \
 /* Allocate workspace. */ \
-      stride = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
+      stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_in ); \
       xn_max = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
       xn_min = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
       if ( astOK ) { \
@@ -5307,7 +5909,7 @@ MAKE_INTERPOLATE_NEAREST(UB,unsigned char,0)
 *                                      const int ubnd_in[],
 *                                      const <Xtype> in[],
 *                                      const <Xtype> in_var[],
-*                                      int npoint, const int offset[],
+*                                      int npoint, const int64_t offset[],
 *                                      const double *const coords[],
 *                                      const double params[], int flags,
 *                                      <Xtype> badval, <Xtype> *out,
@@ -5466,7 +6068,7 @@ static void InterpolateBlockAverage##X( int ndim_in, \
                                         const int ubnd_in[], \
                                         const Xtype in[], \
                                         const Xtype in_var[], \
-                                        int npoint, const int offset[], \
+                                        int npoint, const int64_t offset[], \
                                         const double *const coords[], \
                                         const double params[], int flags, \
                                         Xtype badval, Xtype *out, \
@@ -5492,7 +6094,6 @@ static void InterpolateBlockAverage##X( int ndim_in, \
    int *ixm;                     /* Pointer to array of current indices */ \
    int *lo;                      /* Pointer to array of lower indices */ \
    int *status;                  /* Pointer to inherited status value */ \
-   int *stride;                  /* Pointer to array of dimension strides */ \
    int bad;                      /* Output pixel bad? */ \
    int bad_var;                  /* Output variance bad? */ \
    int done;                     /* All pixel indices done? */ \
@@ -5506,14 +6107,15 @@ static void InterpolateBlockAverage##X( int ndim_in, \
    int lo_y;                     /* Lower pixel index (y dimension) */ \
    int neighb;                   /* Number of adjacent pixels on each side */ \
    int nobad;                    /* Was the AST__NOBAD flag set? */ \
-   int off1;                     /* Input pixel offset due to y index */ \
-   int off_in;                   /* Offset to input pixel */ \
-   int off_out;                  /* Offset to output pixel */ \
    int point;                    /* Loop counter for output points */ \
-   int s;                        /* Temporary variable for strides */ \
    int usebad;                   /* Use "bad" input pixel values? */ \
    int usevar;                   /* Process variance array? */ \
-   int ystride;                  /* Stride along input grid y dimension */ \
+   int64_t *stride;              /* Pointer to array of dimension strides */ \
+   int64_t off1;                 /* Input pixel offset due to y index */ \
+   int64_t off_in;               /* Offset to input pixel */ \
+   int64_t off_out;              /* Offset to output pixel */ \
+   int64_t s;                    /* Temporary variable for strides */ \
+   int64_t ystride;              /* Stride along input grid y dimension */ \
 \
 /* Initialise. */ \
    *nbad = 0; \
@@ -5690,7 +6292,7 @@ static void InterpolateBlockAverage##X( int ndim_in, \
 /* Allocate workspace. */ \
       hi = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
       lo = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
-      stride = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
+      stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_in ); \
       ixm = astMalloc( sizeof( int ) * (size_t) ndim_in ); \
       xn_max = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
       xn_min = astMalloc( sizeof( double ) * (size_t) ndim_in ); \
@@ -6391,6 +6993,186 @@ static double J1Bessel( double x, int *status ) {
 
 }
 
+static const double *KernelTable( void (* kernel)( double, const double [],
+                                                   int, double *, int * ),
+                                  const double *par, int neighb,
+                                  double *scale, int *status ) {
+/*
+*  Name:
+*     KernelTable
+
+*  Purpose:
+*     Obtain a tabulated copy of a 1-dimensional interpolation kernel.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     const double *KernelTable( void (* kernel)( double, const double [],
+*                                                 int, double *, int * ),
+*                                const double *par, int neighb,
+*                                double *scale, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function returns a table holding the values of one of the
+*     internal 1-dimensional interpolation kernels (see SetupKernel1),
+*     sampled at equal intervals of absolute offset between zero and
+*     "neighb". Linear interpolation within the table reproduces the
+*     kernel to within the accuracy specified by the KernelTable tuning
+*     parameter (see astTune). All the internal kernels are symmetric, so
+*     the table should be indexed using the absolute value of the offset.
+*
+*     The most recently created table is retained in thread-specific
+*     storage and re-used if the same kernel is requested again by the
+*     same thread.
+
+*  Parameters:
+*     kernel
+*        Pointer to the kernel function.
+*     par
+*        Pointer to the array of parameter values required by the kernel
+*        function, as returned by SetupKernel1. May be NULL if the kernel
+*        function requires no parameters.
+*     neighb
+*        The largest absolute offset at which the kernel will be evaluated.
+*     scale
+*        Pointer to a double in which to return the number of table
+*        elements per unit offset.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the table, or NULL if the kernel should instead be
+*     evaluated directly (because the KernelTable tuning parameter is
+*     zero, or because the required accuracy cannot be achieved using a
+*     table of reasonable size). The table should not be freed or
+*     modified by the caller.
+
+*  Notes:
+*     - NULL will be returned if this function is invoked with the
+*     global error status set or if it should fail for any reason.
+*/
+
+/* Local Constants: */
+#define MAX_SAMP 16384           /* Max. number of samples per unit offset */
+#define MAX_TABLE 1048576        /* Max. number of table elements */
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Thread-specific data */
+   double *table;                /* Pointer to the new table */
+   double err;                   /* Largest interpolation error found */
+   double pval;                  /* First kernel parameter value */
+   double samp;                  /* Required number of samples per unit */
+   double tol;                   /* Maximum permitted interpolation error */
+   double val;                   /* Kernel value at a sample mid-point */
+   int digits;                   /* Required number of decimal places */
+   int i;                        /* Index of current table element */
+   int iter;                     /* Number of tables built so far */
+   int n;                        /* Number of elements in the table */
+   int nsamp;                    /* Number of samples per unit offset */
+
+/* Initialise. */
+   *scale = 1.0;
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Get a pointer to the thread-specific global data for the current
+   thread. The table cannot be associated with the Mapping, since the
+   Mapping may be being used by several worker threads at once. */
+   astGET_GLOBALS(NULL);
+
+/* Get the required accuracy. Return NULL if tables are not to be used. */
+   LOCK_MUTEX1
+   digits = kerntab_digits;
+   UNLOCK_MUTEX1
+   if ( digits <= 0 || neighb <= 0 ) return NULL;
+
+/* If the table created most recently by the current thread describes the
+   same kernel, with the same accuracy, re-use it. */
+   pval = par ? par[ 0 ] : 0.0;
+   if ( kernel == kernel_table_fun && pval == kernel_table_par &&
+        neighb == kernel_table_neighb && digits == kernel_table_digits ) {
+      *scale = kernel_table_scale;
+      return kernel_table;
+   }
+
+/* Otherwise, discard the old table and record the details of the new
+   kernel. */
+   kernel_table = astFree( kernel_table );
+   kernel_table_fun = kernel;
+   kernel_table_par = pval;
+   kernel_table_neighb = neighb;
+   kernel_table_digits = digits;
+   kernel_table_scale = 1.0;
+
+/* The error in a linear interpolation between two samples is greatest
+   close to the mid-point between them, and is proportional to the square
+   of the sample spacing. Starting with a coarse table, form the largest
+   error at the mid-points and use it to find the number of samples per
+   unit offset needed to meet the required accuracy. A few iterations
+   may be needed since the initial error estimates are rough. */
+   tol = pow( 10.0, -digits );
+   nsamp = 64;
+   table = NULL;
+   for ( iter = 0; iter < 4 && astOK; iter++ ) {
+
+/* Check the table would not be excessively large. If it would, give up
+   and leave the kernel to be evaluated directly. */
+      if ( nsamp > MAX_SAMP || neighb > ( MAX_TABLE - 2 ) / nsamp ) break;
+
+/* Fill the table. One extra element is included beyond the largest
+   offset so that interpolation is always possible. */
+      n = neighb*nsamp + 2;
+      table = astGrow( table, n, sizeof( double ) );
+      if ( !astOK ) break;
+      for ( i = 0; i < n; i++ ) {
+         ( *kernel )( (double) i / (double) nsamp, par, 0, table + i, status );
+      }
+
+/* Find the largest interpolation error. */
+      err = 0.0;
+      for ( i = 0; i < n - 1; i++ ) {
+         ( *kernel )( ( (double) i + 0.5 ) / (double) nsamp, par, 0, &val,
+                      status );
+         err = MaxD( err, fabs( val - 0.5*( table[ i ] + table[ i + 1 ] ) ),
+                     status );
+      }
+
+/* If the table is accurate enough, retain it. Otherwise, increase the
+   number of samples (with a 10% margin) and try again. */
+      if ( err <= tol ) {
+         kernel_table = table;
+         kernel_table_scale = (double) nsamp;
+         table = NULL;
+         break;
+      }
+      samp = 1.1*nsamp*sqrt( err/tol );
+      nsamp = ( samp < MAX_SAMP ) ? (int) ceil( samp ) : MAX_SAMP + 1;
+   }
+
+/* Free any table that was not retained. */
+   table = astFree( table );
+
+/* If an error occurred, clear the cached table. */
+   if ( !astOK ) {
+      kernel_table = astFree( kernel_table );
+      kernel_table_fun = NULL;
+   }
+
+/* Return the table. */
+   *scale = kernel_table_scale;
+   return kernel_table;
+
+/* Undefine local macros. */
+#undef MAX_SAMP
+#undef MAX_TABLE
+}
+
 static int LinearApprox( AstMapping *this, const double *lbnd,
                          const double *ubnd, double tol, double *fit, int *status ) {
 /*
@@ -8124,55 +8906,129 @@ static int MinI( int a, int b, int *status ) {
    return ( a < b ) ? a : b;
 }
 
-static double NewVertex( const MapData *mapdata, int lo, double scale,
-                         double x[], double f[], int *ncall, double xnew[], int *status ) {
+static int *NarrowBounds( int n, const int64_t *bnd, const char *method,
+                          const char *class, int *status ) {
 /*
 *  Name:
-*     NewVertex
+*     NarrowBounds
 
 *  Purpose:
-*     Locate a new vertex for a simplex.
+*     Copy an array of 64-bit grid bounds into an array of int.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "mapping.h"
-*     double NewVertex( const MapData *mapdata, int lo, double scale,
-*                       double x[], double f[], int *ncall, double xnew[], int *status );
+*     int *NarrowBounds( int n, const int64_t *bnd, const char *method,
+*                        const char *class, int *status )
 
 *  Class Membership:
 *     Mapping member function.
 
 *  Description:
-*     This function is provided for use during optimisation of a
-*     Mapping function using the simplex method. It generates the
-*     coordinates of a new simplex vertex and evaluates the Mapping
-*     function at that point.  If the function's value is better then
-*     (i.e. larger than) the value at the previously worst vertex,
-*     then it is used to replace that vertex.
+*     This function returns a copy of an array of grid bounds supplied
+*     to one of the 64-bit methods (e.g. astResample8<X>), converted to
+*     type int for use by the code that resamples or rebins the grid.
+*     An error is reported if any bound lies outside the range of an
+*     int. Note, only the bounds on each axis are limited in this way,
+*     not the total number of pixels in the grid.
 
 *  Parameters:
-*     mapdata
-*        Pointer to a MapData structure which describes the Mapping
-*        function to be used.
-*     lo
-*        The (zero-based) index of the simplex vertex which initially
-*        has the worst (lowest) value.
-*     scale
-*        The scale factor to be used to generate the new vertex. The
-*        distance of the worst vertex from the centre of the face
-*        opposite it is scaled by this factor to give the new vertex
-*        position. Negative factors result in reflection through this
-*        opposite face.
-*     x
-*        An array of double containing the coordinates of the vertices
-*        of the simplex. The coordinates of the first vertex are
-*        stored first, then those of the second vertex, etc. This
-*        array will be updated by this function if the new vertex is
-*        used to replace an existing one.
-*     f
-*        An array of double containing the Mapping function values at
+*     n
+*        The number of elements in "bnd".
+*     bnd
+*        The bounds to copy.
+*     method
+*        The name of the calling method, for use in error messages.
+*     class
+*        The class of the supplied object, for use in error messages.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the new array, which should be freed using astFree
+*     when no longer needed.
+
+*  Notes:
+*     - A NULL pointer is returned if this function is invoked with the
+*     global error status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   int *result;                  /* Returned array */
+   int i;                        /* Element index */
+
+/* Allocate the returned array. */
+   result = astMalloc( sizeof( int )*(size_t) n );
+
+/* Copy each bound, checking that it can be represented as an int. */
+   for ( i = 0; astOK && i < n; i++ ) {
+      if ( bnd[ i ] < INT_MIN || bnd[ i ] > INT_MAX ) {
+         astError( AST__EXSPIX, "%s(%s): Grid bound (%lld) is outside "
+                   "the range of an int.", status, method, class,
+                   (long long int) bnd[ i ] );
+      } else {
+         result[ i ] = (int) bnd[ i ];
+      }
+   }
+
+/* Free the array if an error occurred. */
+   if ( !astOK ) result = astFree( result );
+
+/* Return the result. */
+   return result;
+}
+
+static double NewVertex( const MapData *mapdata, int lo, double scale,
+                         double x[], double f[], int *ncall, double xnew[], int *status ) {
+/*
+*  Name:
+*     NewVertex
+
+*  Purpose:
+*     Locate a new vertex for a simplex.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     double NewVertex( const MapData *mapdata, int lo, double scale,
+*                       double x[], double f[], int *ncall, double xnew[], int *status );
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function is provided for use during optimisation of a
+*     Mapping function using the simplex method. It generates the
+*     coordinates of a new simplex vertex and evaluates the Mapping
+*     function at that point.  If the function's value is better then
+*     (i.e. larger than) the value at the previously worst vertex,
+*     then it is used to replace that vertex.
+
+*  Parameters:
+*     mapdata
+*        Pointer to a MapData structure which describes the Mapping
+*        function to be used.
+*     lo
+*        The (zero-based) index of the simplex vertex which initially
+*        has the worst (lowest) value.
+*     scale
+*        The scale factor to be used to generate the new vertex. The
+*        distance of the worst vertex from the centre of the face
+*        opposite it is scaled by this factor to give the new vertex
+*        position. Negative factors result in reflection through this
+*        opposite face.
+*     x
+*        An array of double containing the coordinates of the vertices
+*        of the simplex. The coordinates of the first vertex are
+*        stored first, then those of the second vertex, etc. This
+*        array will be updated by this function if the new vertex is
+*        used to replace an existing one.
+*     f
+*        An array of double containing the Mapping function values at
 *        each vertex of the simplex. This array will be updated by
 *        this function if the new vertex is used to replace an
 *        existing one.
@@ -8686,6 +9542,144 @@ f     - A value of .FALSE.
    return result;
 }
 
+static void QueueBlock( BlockQueue *queue, int ifit, double factor,
+                        const int *lbnd, const int *ubnd, int *status ){
+/*
+*  Name:
+*     QueueBlock
+
+*  Purpose:
+*     Append a block of pixels to a queue.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void QueueBlock( BlockQueue *queue, int ifit, double factor,
+*                      const int *lbnd, const int *ubnd, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function appends a description of a block of pixels to the
+*     end of the supplied queue, so that it can be processed later by a
+*     worker thread.
+
+*  Parameters:
+*     queue
+*        Pointer to the queue.
+*     ifit
+*        The index of the linear fit to use with the block, as returned
+*        by QueueFit. A value of -1 indicates that no linear fit is
+*        available.
+*     factor
+*        The flux conservation factor to use with the block.
+*     lbnd
+*        Pointer to an array of integers, with one element for each
+*        dimension of the block, holding the lower pixel index bounds.
+*     ubnd
+*        Pointer to an array of integers, with one element for each
+*        dimension of the block, holding the upper pixel index bounds.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   int *bounds;                  /* Pointer to bounds of new block */
+   int idim;                     /* Dimension index */
+   int nblock;                   /* Number of blocks in extended queue */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Extend the arrays in the queue. */
+   nblock = queue->nblock + 1;
+   queue->bounds = astGrow( queue->bounds, 2*queue->ndim*nblock,
+                            sizeof( int ) );
+   queue->ifit = astGrow( queue->ifit, nblock, sizeof( int ) );
+   queue->factor = astGrow( queue->factor, nblock, sizeof( double ) );
+
+/* Store the details of the new block. */
+   if( astOK ) {
+      bounds = queue->bounds + 2*queue->ndim*queue->nblock;
+      for( idim = 0; idim < queue->ndim; idim++ ) {
+         bounds[ idim ] = lbnd[ idim ];
+         bounds[ idim + queue->ndim ] = ubnd[ idim ];
+      }
+      queue->ifit[ queue->nblock ] = ifit;
+      queue->factor[ queue->nblock ] = factor;
+      queue->nblock = nblock;
+   }
+}
+
+static int QueueFit( BlockQueue *queue, const double *fit, int *status ){
+/*
+*  Name:
+*     QueueFit
+
+*  Purpose:
+*     Store a copy of a linear fit in a queue.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int QueueFit( BlockQueue *queue, const double *fit, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function stores a copy of the coefficients of a linear fit
+*     in the supplied queue, and returns an index that may be used to
+*     associate the fit with subsequent blocks added to the queue (see
+*     QueueBlock).
+
+*  Parameters:
+*     queue
+*        Pointer to the queue.
+*     fit
+*        Pointer to the array of fit coefficients. The number of values
+*        in the array is given by the "nfitval" component of the queue.
+*        May be NULL.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The index of the stored fit, or -1 if "fit" is NULL.
+
+*  Notes:
+*     - A value of -1 will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   int result;                   /* Returned value */
+
+/* Initialise. */
+   result = -1;
+
+/* Check the global error status and the supplied fit. */
+   if ( !astOK || !fit ) return result;
+
+/* Extend the array of fit coefficients, and copy the new fit to the end
+   of it. */
+   queue->fits = astGrow( queue->fits, queue->nfitval*( queue->nfit + 1 ),
+                          sizeof( double ) );
+   if( astOK ) {
+      memcpy( queue->fits + queue->nfitval*queue->nfit, fit,
+              sizeof( double )*(size_t) queue->nfitval );
+      result = queue->nfit++;
+   }
+
+/* Return the index of the fit. */
+   return result;
+}
+
 static double Random( long int *seed, int *status ) {
 /*
 *  Name:
@@ -9613,6 +10607,18 @@ f     AST_RESAMPLE<X>, the AST_REBIN<X>
 *     set of functions does not yet support unsigned integer data types
 *     or integers of different sizes.
 
+*  Handling of Huge Pixel Arrays:
+c     If the input or output grid contains more than 2147483647 pixels
+c     (the largest value that can be stored in an "int"), the 64-bit
+c     version of this function must be used, in which the grid bounds
+c     are of type "int64_t" rather than "int". The 64-bit version is
+c     selected by inserting "8" before the type code in the function
+c     name (e.g. astRebin8D instead of astRebinD). Each individual bound
+c     must still lie within the range of an "int", but the total number
+c     of pixels in each grid is limited only by the available memory.
+f     The Fortran interface does not support grids containing more than
+f     2147483647 pixels.
+
 *  Pixel Spreading Schemes:
 *     The pixel spreading scheme specifies the Point Spread Function (PSF)
 *     applied to each input pixel value as it is copied into the output
@@ -9748,13 +10754,14 @@ static void Rebin##X( AstMapping *this, double wlim, int ndim_in, \
    Xtype *v;                     /* Pointer to next output variance value */ \
    double *w;                    /* Pointer to next weight value */ \
    double *work;                 /* Pointer to weight array */ \
+   int failed;                   /* Could flux not be conserved? */ \
    int idim;                     /* Loop counter for coordinate dimensions */ \
-   int ipix_out;                 /* Index into output array */ \
    int nin;                      /* Number of Mapping input coordinates */ \
    int nout;                     /* Number of Mapping output coordinates */ \
-   int npix;                     /* Number of pixels in input region */ \
-   int npix_out;                 /* Number of pixels in output array */ \
-   int64_t mpix;                 /* Number of pixels for testing */ \
+   int nworker;                  /* Number of worker threads to use */ \
+   int64_t ipix_out;             /* Index into output array */ \
+   int64_t npix;                 /* Number of pixels in input region */ \
+   int64_t npix_out;             /* Number of pixels in output array */ \
 \
 /* Check the global error status. */ \
    if ( !astOK ) return; \
@@ -9795,7 +10802,6 @@ static void Rebin##X( AstMapping *this, double wlim, int ndim_in, \
 \
 /* Check that the lower and upper bounds of the input grid are \
    consistent. Report an error if any pair is not. */ \
-   mpix = 1; \
    if ( astOK ) { \
       for ( idim = 0; idim < ndim_in; idim++ ) { \
          if ( lbnd_in[ idim ] > ubnd_in[ idim ] ) { \
@@ -9806,19 +10812,10 @@ static void Rebin##X( AstMapping *this, double wlim, int ndim_in, \
             astError( AST__GBDIN, "Error in input dimension %d.", status, \
                       idim + 1 ); \
             break; \
-         } else { \
-            mpix *= ubnd_in[ idim ] - lbnd_in[ idim ] + 1; \
          } \
       } \
    } \
 \
-/* Report an error if there are too many pixels in the input. */ \
-   if ( astOK && (int) mpix != mpix ) { \
-      astError( AST__EXSPIX, "astRebin"#X"(%s): Supplied input array " \
-                "contains too many pixels (%zu): must be fewer than %d.", \
-                status, astGetClass( this ), mpix, INT_MAX ); \
-   } \
-\
 /* Check that the positional accuracy tolerance supplied is valid and \
    report an error if necessary. */ \
    if ( astOK && ( tol < 0.0 ) ) { \
@@ -9838,7 +10835,6 @@ static void Rebin##X( AstMapping *this, double wlim, int ndim_in, \
 \
 /* Check that the lower and upper bounds of the output grid are \
    consistent. Report an error if any pair is not. */ \
-   mpix = 1; \
    if ( astOK ) { \
       for ( idim = 0; idim < ndim_out; idim++ ) { \
          if ( lbnd_out[ idim ] > ubnd_out[ idim ] ) { \
@@ -9849,21 +10845,11 @@ static void Rebin##X( AstMapping *this, double wlim, int ndim_in, \
             astError( AST__GBDIN, "Error in output dimension %d.", status, \
                       idim + 1 ); \
             break; \
-         } else { \
-            mpix *= ubnd_out[ idim ] - lbnd_out[ idim ] + 1; \
          } \
       } \
    } \
 \
-/* Report an error if there are too many pixels in the output. */ \
-   if ( astOK && (int) mpix != mpix ) { \
-      astError( AST__EXSPIX, "astRebin"#X"(%s): Supplied output array " \
-                "contains too many pixels (%zu): must be fewer than %d.", \
-                status, astGetClass( this ), mpix, INT_MAX ); \
-   } \
-\
 /* Similarly check the bounds of the input region. */ \
-   mpix = 1; \
    if ( astOK ) { \
       for ( idim = 0; idim < ndim_out; idim++ ) { \
          if ( lbnd[ idim ] > ubnd[ idim ] ) { \
@@ -9884,8 +10870,6 @@ static void Rebin##X( AstMapping *this, double wlim, int ndim_in, \
                       "input region (%d) exceeds corresponding " \
                       "bound of input grid (%d).", status, astGetClass( this ), \
                       ubnd[ idim ], ubnd_in[ idim ] ); \
-         } else { \
-            mpix *= ubnd[ idim ] - lbnd[ idim ] + 1; \
          } \
 \
 /* Say which dimension produced the error. */ \
@@ -9897,13 +10881,6 @@ static void Rebin##X( AstMapping *this, double wlim, int ndim_in, \
       } \
    } \
 \
-/* Report an error if there are too many pixels in the input region. */ \
-   if ( astOK && (int) mpix != mpix ) { \
-      astError( AST__EXSPIX, "astRebin"#X"(%s): Supplied input region " \
-                "contains too many pixels (%zu): must be fewer than %d.", \
-                status, astGetClass( this ), mpix, INT_MAX ); \
-   } \
-\
 /* If OK, loop to determine how many input pixels are to be binned. */ \
    simple = NULL; \
    npix = 1; \
@@ -9997,16 +10974,41 @@ static void Rebin##X( AstMapping *this, double wlim, int ndim_in, \
    types that obscure the underlying data type. This is to avoid \
    having to replicate functions unnecessarily for each data \
    type. However, we also pass an argument that identifies the data \
-   type we have obscured. */ \
-   if( RebinAdaptively( simple, ndim_in, lbnd_in, ubnd_in, \
-                        (const void *) in, (const void *) in_var, \
-                        TYPE_##X, spread, \
-                        params, flags, tol, maxpix, \
-                        (const void *) &badval, \
-                        ndim_out, lbnd_out, ubnd_out, \
-                        lbnd, ubnd, npix_out, \
-                        (void *) out, (void *) out_var, work, \
-                        NULL, status ) && astOK ) { \
+   type we have obscured. \
+\
+   If the input region contains several blocks of pixels (see \
+   RebinWithBlocking), and extra worker threads are available, rebin \
+   the blocks in parallel. Each extra worker needs its own copy of the \
+   output arrays, so this is only done if the input region is at least \
+   as big as the output array. */ \
+   nworker = 1; \
+   if( astOK && npix >= npix_out ) { \
+      nworker = astTaskWorkers( ( npix/( 2*1024 ) < INT_MAX ) ? \
+                                (int) ( npix/( 2*1024 ) ) : INT_MAX ); \
+   } \
+   if( nworker > 1 ) { \
+      failed = RebinInParallel( simple, nworker, ndim_in, lbnd_in, \
+                                ubnd_in, (const void *) in, \
+                                (const void *) in_var, \
+                                TYPE_##X, spread, \
+                                params, flags, tol, maxpix, \
+                                (const void *) &badval, \
+                                ndim_out, lbnd_out, ubnd_out, \
+                                lbnd, ubnd, npix_out, \
+                                (void *) out, (void *) out_var, work, \
+                                NULL, status ); \
+   } else { \
+      failed = RebinAdaptively( simple, ndim_in, lbnd_in, ubnd_in, \
+                                (const void *) in, (const void *) in_var, \
+                                TYPE_##X, spread, \
+                                params, flags, tol, maxpix, \
+                                (const void *) &badval, \
+                                ndim_out, lbnd_out, ubnd_out, \
+                                lbnd, ubnd, npix_out, \
+                                (void *) out, (void *) out_var, work, \
+                                NULL, NULL, status ); \
+   } \
+   if( failed && astOK ) { \
       astError( AST__CNFLX, "astRebin"#X"(%s): Flux conservation was " \
                 "requested but could not be performed because the " \
                 "forward transformation of the supplied Mapping " \
@@ -10055,6 +11057,106 @@ MAKE_REBIN(UB,unsigned char,1)
 /* Undefine the macro. */
 #undef MAKE_REBIN
 
+/*
+*  Name:
+*     Rebin8<X>
+
+*  Purpose:
+*     Rebin a region of a data grid, using 64-bit grid bounds.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void Rebin8<X>( AstMapping *this, double wlim, int ndim_in,
+*                     const int64_t lbnd_in[], const int64_t ubnd_in[],
+*                     const <Xtype> in[], const <Xtype> in_var[],
+*                     int spread, const double params[], int flags,
+*                     double tol, int maxpix, <Xtype> badval,
+*                     int ndim_out, const int64_t lbnd_out[],
+*                     const int64_t ubnd_out[], const int64_t lbnd[],
+*                     const int64_t ubnd[], <Xtype> out[], <Xtype> out_var[] )
+
+*  Class Membership:
+*     Mapping member function (over-rides the astRebin8<X> protected
+*     method inherited from the Mapping class).
+
+*  Description:
+*     This function implements the astRebin8<X> method, which is also
+*     used by astRebin<X>. It checks that the supplied bounds can be
+*     represented as type int, and then uses Rebin<X> to rebin the grid.
+*     See astRebin<X> for a description of the arguments.
+*/
+/* Define a macro to implement the function for a specific data
+   type. */
+#define MAKE_REBIN8(X,Xtype) \
+static void Rebin8##X( AstMapping *this, double wlim, int ndim_in, \
+                       const int64_t lbnd_in[], const int64_t ubnd_in[], \
+                       const Xtype in[], const Xtype in_var[], \
+                       int spread, const double params[], int flags, \
+                       double tol, int maxpix, Xtype badval, \
+                       int ndim_out, const int64_t lbnd_out[], \
+                       const int64_t ubnd_out[], const int64_t lbnd[], \
+                       const int64_t ubnd[], Xtype out[], Xtype out_var[], \
+                       int *status ) { \
+\
+/* Local Variables: */ \
+   const char *class;            /* Object class */ \
+   int *lbnd32;                  /* Input region lower bounds as int */ \
+   int *lbnd_in32;               /* Input grid lower bounds as int */ \
+   int *lbnd_out32;              /* Output grid lower bounds as int */ \
+   int *ubnd32;                  /* Input region upper bounds as int */ \
+   int *ubnd_in32;               /* Input grid upper bounds as int */ \
+   int *ubnd_out32;              /* Output grid upper bounds as int */ \
+\
+/* Check the global error status. */ \
+   if ( !astOK ) return; \
+\
+/* Take int copies of the bounds, checking each can be represented. */ \
+   class = astGetClass( this ); \
+   lbnd_in32 = NarrowBounds( ndim_in, lbnd_in, "astRebin8"#X, class, \
+                             status ); \
+   ubnd_in32 = NarrowBounds( ndim_in, ubnd_in, "astRebin8"#X, class, \
+                             status ); \
+   lbnd_out32 = NarrowBounds( ndim_out, lbnd_out, "astRebin8"#X, class, \
+                              status ); \
+   ubnd_out32 = NarrowBounds( ndim_out, ubnd_out, "astRebin8"#X, class, \
+                              status ); \
+   lbnd32 = NarrowBounds( ndim_in, lbnd, "astRebin8"#X, class, status ); \
+   ubnd32 = NarrowBounds( ndim_in, ubnd, "astRebin8"#X, class, status ); \
+\
+/* Rebin the grid. */ \
+   if ( astOK ) { \
+      Rebin##X( this, wlim, ndim_in, lbnd_in32, ubnd_in32, in, in_var, \
+                spread, params, flags, tol, maxpix, badval, ndim_out, \
+                lbnd_out32, ubnd_out32, lbnd32, ubnd32, out, out_var, \
+                status ); \
+   } \
+\
+/* Free the copies. */ \
+   lbnd_in32 = astFree( lbnd_in32 ); \
+   ubnd_in32 = astFree( ubnd_in32 ); \
+   lbnd_out32 = astFree( lbnd_out32 ); \
+   ubnd_out32 = astFree( ubnd_out32 ); \
+   lbnd32 = astFree( lbnd32 ); \
+   ubnd32 = astFree( ubnd32 ); \
+}
+
+/* Expand the above macro to generate a function for each required
+   data type. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_REBIN8(LD,long double)
+#endif
+MAKE_REBIN8(D,double)
+MAKE_REBIN8(F,float)
+MAKE_REBIN8(I,int)
+MAKE_REBIN8(B,char)
+MAKE_REBIN8(UB,unsigned char)
+
+/* Undefine the macro. */
+#undef MAKE_REBIN8
+
 static int RebinAdaptively( AstMapping *this, int ndim_in,
                             const int *lbnd_in, const int *ubnd_in,
                             const void *in, const void *in_var,
@@ -10063,9 +11165,9 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
                             int maxpix, const void *badval_ptr,
                             int ndim_out, const int *lbnd_out,
                             const int *ubnd_out, const int *lbnd,
-                            const int *ubnd, int npix_out,
+                            const int *ubnd, int64_t npix_out,
                             void *out, void *out_var, double *work,
-                            int64_t *nused, int *status ){
+                            int64_t *nused, BlockQueue *queue, int *status ){
 /*
 *  Name:
 *     RebinAdaptively
@@ -10086,9 +11188,9 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
 *                          int maxpix, const void *badval_ptr,
 *                          int ndim_out, const int *lbnd_out,
 *                          const int *ubnd_out, const int *lbnd,
-*                          const int *ubnd, int npix_out, void *out,
+*                          const int *ubnd, int64_t npix_out, void *out,
 *                          void *out_var, double *work, int64_t *nused,
-*                          int *status )
+*                          BlockQueue *queue, int *status )
 
 *  Class Membership:
 *     Mapping member function.
@@ -10276,6 +11378,10 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
 *     nused
 *        An optional pointer to a int64_t which will be incremented by the
 *        number of input values pasted into the output array. Ignored if NULL.
+*     queue
+*        If not NULL, the blocks of input pixels that would otherwise be
+*        rebinned are instead appended to the supplied queue, so that
+*        they can be rebinned later (see RebinInParallel).
 *     status
 *        Pointer to the inherited status variable.
 
@@ -10302,7 +11408,6 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
    int isLinear;                 /* Is the transformation linear? */
    int mxdim;                    /* Largest output section dimension size */
    int need_fit;                 /* Do we need to perform a linear fit? */
-   int npix;                     /* Number of pixels in output section */
    int npoint;                   /* Number of points for obtaining a fit */
    int nvertex;                  /* Number of vertices of output section */
    int result;                   /* Returned value */
@@ -10310,6 +11415,7 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
    int res2;                     /* Flux conservation error in 2nd section? */
    int toobig;                   /* Section too big (must sub-divide)? */
    int toosmall;                 /* Section too small to sub-divide? */
+   int64_t npix;                 /* Number of pixels in output section */
 
 /* Initialise */
    result = 0;
@@ -10441,7 +11547,8 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
                                      ubnd_in, in, in_var, type, spread,
                                      params, flags, badval_ptr, ndim_out,
                                      lbnd_out, ubnd_out, lbnd, ubnd, npix_out,
-                                     out, out_var, work, nused, status );
+                                     out, out_var, work, nused, queue,
+                                     status );
 
 /* Otherwise, allocate workspace to perform the sub-division. */
       } else {
@@ -10467,7 +11574,7 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
                                     in_var, type, spread, params,
                                     flags, tol, maxpix, badval_ptr, ndim_out,
                                     lbnd_out, ubnd_out, lo, hi, npix_out, out,
-                                    out_var, work, nused, status );
+                                    out_var, work, nused, queue, status );
 
 /* Now set up a second section which covers the remaining half of the
    original input section. */
@@ -10482,7 +11589,7 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
                                        flags, tol, maxpix, badval_ptr,
                                        ndim_out, lbnd_out, ubnd_out,
                                        lo, hi, npix_out, out, out_var, work,
-                                       nused, status );
+                                       nused, queue, status );
             } else {
                res2 = 0;
             }
@@ -10507,64 +11614,294 @@ static int RebinAdaptively( AstMapping *this, int ndim_in,
    return result;
 }
 
-static void RebinSection( AstMapping *this, const double *linear_fit,
-                          int ndim_in, const int *lbnd_in, const int *ubnd_in,
-                          const void *in, const void *in_var, double infac,
-                          DataType type, int spread, const double *params,
-                          int flags, const void *badval_ptr, int ndim_out,
-                          const int *lbnd_out, const int *ubnd_out,
-                          const int *lbnd, const int *ubnd, int npix_out,
-                          void *out, void *out_var, double *work,
-                          int64_t *nused, int *status ) {
+static int RebinInParallel( AstMapping *this, int nworker, int ndim_in,
+                            const int *lbnd_in, const int *ubnd_in,
+                            const void *in, const void *in_var,
+                            DataType type, int spread,
+                            const double *params, int flags, double tol,
+                            int maxpix, const void *badval_ptr,
+                            int ndim_out, const int *lbnd_out,
+                            const int *ubnd_out, const int *lbnd,
+                            const int *ubnd, int64_t npix_out,
+                            void *out, void *out_var, double *work,
+                            int64_t *nused, int *status ){
 /*
 *  Name:
-*     RebinSection
+*     RebinInParallel
 
 *  Purpose:
-*     Rebin a section of a data grid.
+*     Rebin a section of a data grid using several worker threads.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "mapping.h"
-*     void RebinSection( AstMapping *this, const double *linear_fit,
-*                        int ndim_in, const int *lbnd_in, const int *ubnd_in,
-*                        const void *in, const void *in_var, double infac,
-*                        DataType type, int spread, const double *params,
-*                        int flags, const void *badval_ptr, int ndim_out,
-*                        const int *lbnd_out, const int *ubnd_out,
-*                        const int *lbnd, const int *ubnd, int npix_out,
-*                        void *out, void *out_var, double *work,
-*                        int64_t *nused, int *status )
+*     int RebinInParallel( AstMapping *this, int nworker, int ndim_in,
+*                          const int *lbnd_in, const int *ubnd_in,
+*                          const void *in, const void *in_var,
+*                          DataType type, int spread,
+*                          const double *params, int flags, double tol,
+*                          int maxpix, const void *badval_ptr,
+*                          int ndim_out, const int *lbnd_out,
+*                          const int *ubnd_out, const int *lbnd,
+*                          const int *ubnd, int64_t npix_out, void *out,
+*                          void *out_var, double *work, int64_t *nused,
+*                          int *status )
 
 *  Class Membership:
 *     Mapping member function.
 
 *  Description:
-*     This function rebins a specified section of a rectangular grid of
-*     data (with any number of dimensions) into another rectangular grid
-*     (with a possibly different number of dimensions). The coordinate
-*     transformation used to convert input pixel coordinates into positions
-*     in the output grid is given by the forward transformation of the
-*     Mapping which is supplied or, alternatively, by a linear approximation
-*     fitted to a Mapping's forward transformation. Any pixel spreading scheme
-*     may be specified for distributing the flux of an input pixel amongst
-*     the output pixels.
+*     This function has the same effect as RebinAdaptively, but shares
+*     the work between several threads taken from the AST thread pool
+*     (see astRunTasks).
+*
+*     The input section is first divided into blocks by RebinAdaptively,
+*     exactly as it would be if no worker threads were used, so the same
+*     linear approximations are used for each input pixel. The resulting
+*     list of blocks is then divided into contiguous chunks, one for each
+*     worker. Since several input pixels may contribute to the same
+*     output pixel, each chunk (except the first) is rebinned into its
+*     own private output arrays, which are then added onto the supplied
+*     output arrays in chunk order once all workers have finished. The
+*     results are therefore the same on every invocation, but floating
+*     point values may differ from those produced by RebinAdaptively by
+*     a small amount of rounding error because the contributions are
+*     summed in a different order.
 
 *  Parameters:
 *     this
 *        Pointer to a Mapping, whose forward transformation may be
 *        used to transform the coordinates of pixels in the input
 *        grid into associated positions in the output grid.
-*
-*        The number of input coordintes for the Mapping (Nin
-*        attribute) should match the value of "ndim_in" (below), and
-*        the number of output coordinates (Nout attribute) should
-*        match the value of "ndim_out".
-*     linear_fit
-*        Pointer to an optional array of double which contains the
-*        coefficients of a linear fit which approximates the above
+*     nworker
+*        The number of worker threads to use, including the calling
+*        thread. Each worker (other than the first) requires its own
+*        copy of the output arrays.
+*     ndim_in, lbnd_in, ubnd_in, in, in_var, type, spread, params, flags,
+*     tol, maxpix, badval_ptr, ndim_out, lbnd_out, ubnd_out, lbnd, ubnd,
+*     npix_out, out, out_var, work, nused
+*        As for RebinAdaptively.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A non-zero value is returned if "flags" included AST__CONSERVEFLUX (i.e.
+*     flux conservation was requested), but the forward transformation of the
+*     supplied Mapping had zero determinant everywhere within the region
+*     being binned (no error is reported if this happens). Zero is returned
+*     otherwise.
+
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Thread-specific data */
+   BlockQueue queue;             /* The blocks of input pixels */
+   RebinJob job;                 /* Arguments shared by all blocks */
+   int ichunk;                   /* Chunk index */
+   int result;                   /* Returned value */
+   int64_t nwork;                /* Number of elements in each work array */
+   size_t size;                  /* Size of each data value */
+
+/* Initialise. */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(this);
+
+/* Divide the input section into blocks, recording each one in a queue
+   rather than rebinning it. */
+   queue.ndim = ndim_in;
+   queue.nfitval = ndim_out*( ndim_in + 1 );
+   queue.nblock = 0;
+   queue.nfit = 0;
+   queue.bounds = NULL;
+   queue.ifit = NULL;
+   queue.factor = NULL;
+   queue.fits = NULL;
+   result = RebinAdaptively( this, ndim_in, lbnd_in, ubnd_in, in, in_var,
+                             type, spread, params, flags, tol, maxpix,
+                             badval_ptr, ndim_out, lbnd_out, ubnd_out,
+                             lbnd, ubnd, npix_out, out, out_var, work,
+                             nused, &queue, status );
+
+/* Use no more chunks than there are blocks. */
+   job.nchunk = ( nworker < queue.nblock ) ? nworker : queue.nblock;
+   job.maps = NULL;
+   job.out = NULL;
+   job.out_var = NULL;
+   job.work = NULL;
+   job.nused = NULL;
+   if( astOK && job.nchunk > 0 ) {
+
+/* Get the size of each data value. */
+#define CASE_SIZE(X,Xtype) \
+         case ( TYPE_##X ): size = sizeof( Xtype ); break;
+
+      switch ( type ) {
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+         CASE_SIZE(LD,long double)
+#endif
+         CASE_SIZE(D,double)
+         CASE_SIZE(F,float)
+         CASE_SIZE(I,int)
+         CASE_SIZE(B,char)
+         CASE_SIZE(UB,unsigned char)
+         default: size = sizeof( double ); break;
+      }
+#undef CASE_SIZE
+
+/* The work array holds the sums of the squared weights as well as the
+   sums of the weights if output variances are being generated from the
+   spread of input values. */
+      nwork = ( flags & AST__GENVAR ) ? 2*npix_out : npix_out;
+
+/* Allocate arrays holding pointers to the output arrays to use for each
+   chunk. The first chunk uses the supplied arrays. Each subsequent chunk
+   uses its own arrays, which are initialised to zero. */
+      job.out = astCalloc( job.nchunk, sizeof( void * ) );
+      job.out_var = astCalloc( job.nchunk, sizeof( void * ) );
+      job.work = astCalloc( job.nchunk, sizeof( double * ) );
+      if( nused ) job.nused = astCalloc( job.nchunk, sizeof( int64_t ) );
+      if( astOK ) {
+         job.out[ 0 ] = out;
+         job.out_var[ 0 ] = out_var;
+         job.work[ 0 ] = work;
+         for( ichunk = 1; ichunk < job.nchunk; ichunk++ ) {
+            job.out[ ichunk ] = astCalloc( npix_out, size );
+            if( out_var ) job.out_var[ ichunk ] = astCalloc( npix_out, size );
+            if( work ) job.work[ ichunk ] = astCalloc( nwork,
+                                                       sizeof( double ) );
+         }
+      }
+
+/* Create a separate Mapping for each worker, since transforming
+   positions may modify the Mapping. */
+      job.maps = WorkerMappings( this, job.nchunk, status );
+
+/* Rebin the chunks of blocks in parallel. */
+      if( astOK ) {
+         job.unsimplified = unsimplified_mapping;
+         job.queue = &queue;
+         job.params = params;
+         job.lbnd_in = lbnd_in;
+         job.lbnd_out = lbnd_out;
+         job.ubnd_in = ubnd_in;
+         job.ubnd_out = ubnd_out;
+         job.badval_ptr = badval_ptr;
+         job.in = in;
+         job.in_var = in_var;
+         job.type = type;
+         job.flags = flags;
+         job.ndim_in = ndim_in;
+         job.ndim_out = ndim_out;
+         job.npix_out = npix_out;
+         job.spread = spread;
+         astRunTasks( job.nchunk, job.nchunk, RebinTask, &job );
+      }
+
+/* Add the private output arrays for each chunk onto the supplied output
+   arrays, in chunk order so that the result does not depend on the
+   order in which the chunks were completed. */
+      if( astOK ) {
+         for( ichunk = 1; ichunk < job.nchunk; ichunk++ ) {
+            AddRebinArrays( type, npix_out, job.out[ ichunk ], out, status );
+            AddRebinArrays( type, npix_out, job.out_var[ ichunk ], out_var,
+                            status );
+            AddRebinArrays( TYPE_D, nwork, job.work[ ichunk ], work, status );
+         }
+         if( nused ) {
+            for( ichunk = 0; ichunk < job.nchunk; ichunk++ ) {
+               *nused += job.nused[ ichunk ];
+            }
+         }
+      }
+
+/* Free the private output arrays. */
+      if( job.out ) {
+         for( ichunk = 1; ichunk < job.nchunk; ichunk++ ) {
+            job.out[ ichunk ] = astFree( job.out[ ichunk ] );
+            job.out_var[ ichunk ] = astFree( job.out_var[ ichunk ] );
+            job.work[ ichunk ] = astFree( job.work[ ichunk ] );
+         }
+      }
+   }
+
+/* Free remaining resources. */
+   job.maps = FreeWorkerMappings( job.maps, job.nchunk, status );
+   job.out = astFree( job.out );
+   job.out_var = astFree( job.out_var );
+   job.work = astFree( job.work );
+   job.nused = astFree( job.nused );
+   FreeQueue( &queue, status );
+
+/* Return a flag indicating if no part of the array could be binned
+   because of an indeterminate Mapping. */
+   return result;
+}
+
+static void RebinSection( AstMapping *this, const double *linear_fit,
+                          int ndim_in, const int *lbnd_in, const int *ubnd_in,
+                          const void *in, const void *in_var, double infac,
+                          DataType type, int spread, const double *params,
+                          int flags, const void *badval_ptr, int ndim_out,
+                          const int *lbnd_out, const int *ubnd_out,
+                          const int *lbnd, const int *ubnd, int64_t npix_out,
+                          void *out, void *out_var, double *work,
+                          int64_t *nused, int *status ) {
+/*
+*  Name:
+*     RebinSection
+
+*  Purpose:
+*     Rebin a section of a data grid.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void RebinSection( AstMapping *this, const double *linear_fit,
+*                        int ndim_in, const int *lbnd_in, const int *ubnd_in,
+*                        const void *in, const void *in_var, double infac,
+*                        DataType type, int spread, const double *params,
+*                        int flags, const void *badval_ptr, int ndim_out,
+*                        const int *lbnd_out, const int *ubnd_out,
+*                        const int *lbnd, const int *ubnd, int64_t npix_out,
+*                        void *out, void *out_var, double *work,
+*                        int64_t *nused, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function rebins a specified section of a rectangular grid of
+*     data (with any number of dimensions) into another rectangular grid
+*     (with a possibly different number of dimensions). The coordinate
+*     transformation used to convert input pixel coordinates into positions
+*     in the output grid is given by the forward transformation of the
+*     Mapping which is supplied or, alternatively, by a linear approximation
+*     fitted to a Mapping's forward transformation. Any pixel spreading scheme
+*     may be specified for distributing the flux of an input pixel amongst
+*     the output pixels.
+
+*  Parameters:
+*     this
+*        Pointer to a Mapping, whose forward transformation may be
+*        used to transform the coordinates of pixels in the input
+*        grid into associated positions in the output grid.
+*
+*        The number of input coordintes for the Mapping (Nin
+*        attribute) should match the value of "ndim_in" (below), and
+*        the number of output coordinates (Nout attribute) should
+*        match the value of "ndim_out".
+*     linear_fit
+*        Pointer to an optional array of double which contains the
+*        coefficients of a linear fit which approximates the above
 *        Mapping's forward coordinate transformation. If this is
 *        supplied, it will be used in preference to the above Mapping
 *        when transforming coordinates. This may be used to enhance
@@ -10715,8 +12052,6 @@ static void RebinSection( AstMapping *this, const double *linear_fit,
    double y1;                    /* Interim y coordinate value */
    double yy1;                   /* Initial y coordinate value */
    int *dim;                     /* Pointer to array of output pixel indices */
-   int *offset;                  /* Pointer to array of output pixel offsets */
-   int *stride;                  /* Pointer to array of output grid strides */
    int coord_in;                 /* Loop counter for input dimensions */
    int coord_out;                /* Loop counter for output dimensions */
    int done;                     /* All pixel indices done? */
@@ -10727,14 +12062,15 @@ static void RebinSection( AstMapping *this, const double *linear_fit,
    int iy;                       /* Loop counter for output y coordinate */
    int neighb;                   /* Number of neighbouring pixels */
    int npoint;                   /* Number of output points (pixels) */
-   int off1;                     /* Interim pixel offset into output array */
-   int off2;                     /* Interim pixel offset into output array */
-   int off;                      /* Final pixel offset into output array */
    int point;                    /* Counter for output points (pixels ) */
-   int s;                        /* Temporary variable for strides */
    const double *par;            /* Pointer to parameter array */
-   double fwhm;                  /* Full width half max. of gaussian */
    double lpar[ 1 ];             /* Local parameter array */
+   int64_t *offset;              /* Pointer to array of output pixel offsets */
+   int64_t *stride;              /* Pointer to array of output grid strides */
+   int64_t off;                  /* Final pixel offset into output array */
+   int64_t off1;                 /* Interim pixel offset into output array */
+   int64_t off2;                 /* Interim pixel offset into output array */
+   int64_t s;                    /* Temporary variable for strides */
    void (* kernel)( double, const double [], int, double *, int * ); /* Kernel fn. */
 
 /* Check the global error status. */
@@ -10758,8 +12094,8 @@ static void RebinSection( AstMapping *this, const double *linear_fit,
    }
 
 /* Allocate workspace. */
-   offset = astMalloc( sizeof( int ) * (size_t) npoint );
-   stride = astMalloc( sizeof( int ) * (size_t) ndim_in );
+   offset = astMalloc( sizeof( int64_t ) * (size_t) npoint );
+   stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_in );
    if ( astOK ) {
 
 /* Calculate the stride for each input grid dimension. */
@@ -11176,154 +12512,10 @@ static void RebinSection( AstMapping *this, const double *linear_fit,
          case AST__SOMB:
          case AST__SOMBCOS:
 
-/* Obtain a pointer to the appropriate 1-d kernel function (either
-   internal or user-defined) and set up any parameters it may
-   require. */
-            par = NULL;
-            switch ( spread ) {
-
-/* sinc(pi*x) */
-/* ---------- */
-/* Assign the kernel function. */
-               case AST__SINC:
-                  kernel = Sinc;
-
-/* Calculate the number of neighbouring pixels to use. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) {
-                     neighb = 2;
-                  } else {
-                     neighb = MaxI( 1, neighb, status );
-                  }
-                  break;
-
-/* somb(pi*x) */
-/* ---------- */
-/* Assign the kernel function. */
-               case AST__SOMB:
-                  kernel = Somb;
-
-/* Calculate the number of neighbouring pixels to use. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) {
-                     neighb = 2;
-                  } else {
-                     neighb = MaxI( 1, neighb, status );
-                  }
-                  break;
-
-/* sinc(pi*x)*cos(k*pi*x) */
-/* ---------------------- */
-/* Assign the kernel function. */
-               case AST__SINCCOS:
-                  kernel = SincCos;
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, the number will be calculated automatically below. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = INT_MAX;
-
-/* Calculate the maximum number of neighbouring pixels required by the
-   width of the kernel, and use this value if preferable. */
-                  neighb = MinI( neighb,
-                                 (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
-                  break;
-
-/* sinc(pi*x)*exp(-k*x*x) */
-/* ---------------------- */
-/* Assign the kernel function. */
-               case AST__SINCGAUSS:
-                  kernel = SincGauss;
-
-/* Constrain the full width half maximum of the gaussian factor. */
-                  fwhm = MaxD( 0.1, params[ 1 ], status );
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 4.0 * log( 2.0 ) / ( fwhm * fwhm );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, use the number of neighbouring pixels required by the width
-   of the kernel (out to where the gaussian term falls to 1% of its
-   peak value). */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = (int) ceil( sqrt( -log( 0.01 ) /
-                                                                lpar[ 0 ] ) );
-                  break;
-
-/* exp(-k*x*x) */
-/* ----------- */
-/* Assign the kernel function. */
-               case AST__GAUSS:
-                  kernel = Gauss;
-
-/* Constrain the full width half maximum of the gaussian. */
-                  fwhm = MaxD( 0.1, params[ 1 ], status );
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 4.0 * log( 2.0 ) / ( fwhm * fwhm );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, use the number of neighbouring pixels required by the width
-   of the kernel (out to where the gaussian term falls to 1% of its
-   peak value). */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = (int) ceil( sqrt( -log( 0.01 ) /
-                                                                lpar[ 0 ] ) );
-                  break;
-
-/* somb(pi*x)*cos(k*pi*x) */
-/* ---------------------- */
-/* Assign the kernel function. */
-               case AST__SOMBCOS:
-                  kernel = SombCos;
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, the number will be calculated automatically below. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = INT_MAX;
-
-/* Calculate the maximum number of neighbouring pixels required by the
-   width of the kernel, and use this value if preferable. */
-                  neighb = MinI( neighb,
-                                 (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
-                  break;
-
-/* sinc(pi*x)*sinc(k*pi*x) */
-/* ----------------------- */
-/* Assign the kernel function. */
-               case AST__SINCSINC:
-                  kernel = SincSinc;
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, the number will be calculated automatically below. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = INT_MAX;
-
-/* Calculate the maximum number of neighbouring pixels required by the
-   width of the kernel, and use this value if preferable. */
-                  neighb = MinI( neighb,
-                                 (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
-                  break;
-            }
+/* Obtain a pointer to the appropriate 1-d kernel function and set up
+   any parameters it may require. */
+            SetupKernel1( spread, params, &kernel, lpar, &par, &neighb,
+                          status );
 
 /* Define a macro to use a "case" statement to invoke the 1-d kernel
    interpolation function appropriate to a given data type, passing it
@@ -11858,6 +13050,18 @@ f     AST_RESAMPLE<X>, the AST_REBINSEQ<X>
 *     set of functions does not yet support unsigned integer data types
 *     or integers of different sizes.
 
+*  Handling of Huge Pixel Arrays:
+c     If the input or output grid contains more than 2147483647 pixels
+c     (the largest value that can be stored in an "int"), the 64-bit
+c     version of this function must be used, in which the grid bounds
+c     are of type "int64_t" rather than "int". The 64-bit version is
+c     selected by inserting "8" before the type code in the function
+c     name (e.g. astRebinSeq8D instead of astRebinSeqD). Each individual bound
+c     must still lie within the range of an "int", but the total number
+c     of pixels in each grid is limited only by the available memory.
+f     The Fortran interface does not support grids containing more than
+f     2147483647 pixels.
+
 *  Control Flags:
 c     The following flags are defined in the "ast.h" header file and
 f     The following flags are defined in the AST_PAR include file and
@@ -12029,14 +13233,15 @@ static void RebinSeq##X( AstMapping *this, double wlim, int ndim_in, \
    double neff;                  /* Effective number of contributing input pixels */ \
    double sw;                    /* Sum of weights at output pixel */ \
    double wgt;                   /* Output pixel weight */ \
-   int i;                        /* Loop counter for output pixels */ \
+   int failed;                   /* Could flux not be conserved? */ \
    int idim;                     /* Loop counter for coordinate dimensions */ \
-   int ipix_out;                 /* Index into output array */ \
    int nin;                      /* Number of Mapping input coordinates */ \
    int nout;                     /* Number of Mapping output coordinates */ \
-   int npix;                     /* Number of pixels in input region */ \
-   int npix_out;                 /* Number of pixels in output array */ \
-   int64_t mpix;                 /* Number of pixels for testing */ \
+   int nworker;                  /* Number of worker threads to use */ \
+   int64_t i;                    /* Loop counter for output pixels */ \
+   int64_t ipix_out;             /* Index into output array */ \
+   int64_t npix;                 /* Number of pixels in input region */ \
+   int64_t npix_out;             /* Number of pixels in output array */ \
 \
 /* Check the global error status. */ \
    if ( !astOK ) return; \
@@ -12087,7 +13292,6 @@ static void RebinSeq##X( AstMapping *this, double wlim, int ndim_in, \
 \
 /* Check that the lower and upper bounds of the input grid are \
    consistent. Report an error if any pair is not. */ \
-      mpix = 1; \
       if ( astOK ) { \
          for ( idim = 0; idim < ndim_in; idim++ ) { \
             if ( lbnd_in[ idim ] > ubnd_in[ idim ] ) { \
@@ -12098,19 +13302,10 @@ static void RebinSeq##X( AstMapping *this, double wlim, int ndim_in, \
               astError( AST__GBDIN, "Error in input dimension %d.", status, \
                         idim + 1 ); \
               break; \
-            } else { \
-               mpix *= ubnd_in[ idim ] - lbnd_in[ idim ] + 1; \
             } \
          } \
       } \
 \
-/* Report an error if there are too many pixels in the input. */ \
-      if ( astOK && (int) mpix != mpix ) { \
-         astError( AST__EXSPIX, "astRebinSeq"#X"(%s): Supplied input array " \
-                   "contains too many pixels (%zu): must be fewer than %d.", \
-                   status, astGetClass( this ), mpix, INT_MAX ); \
-      } \
-\
 /* Ensure any supplied "in_var" pointer is ignored if no input variances are \
    needed. */ \
       if( !( flags & AST__USEVAR ) && !( flags & AST__VARWGT ) ) { \
@@ -12142,7 +13337,6 @@ static void RebinSeq##X( AstMapping *this, double wlim, int ndim_in, \
 \
 /* Check that the lower and upper bounds of the output grid are \
    consistent. Report an error if any pair is not. */ \
-      mpix = 1; \
       if ( astOK ) { \
          for ( idim = 0; idim < ndim_out; idim++ ) { \
             if ( lbnd_out[ idim ] > ubnd_out[ idim ] ) { \
@@ -12153,21 +13347,11 @@ static void RebinSeq##X( AstMapping *this, double wlim, int ndim_in, \
                astError( AST__GBDIN, "Error in output dimension %d.", status, \
                          idim + 1 ); \
                break; \
-            } else { \
-               mpix *= ubnd_out[ idim ] - lbnd_out[ idim ] + 1; \
             } \
          } \
       } \
 \
-/* Report an error if there are too many pixels in the output. */ \
-   if ( astOK && (int) mpix != mpix ) { \
-      astError( AST__EXSPIX, "astRebinSeq"#X"(%s): Supplied output array " \
-                "contains too many pixels (%zu): must be fewer than %d.", \
-                status, astGetClass( this ), mpix, INT_MAX ); \
-   } \
-\
 /* Similarly check the bounds of the input region. */ \
-      mpix = 1; \
       if ( astOK ) { \
          for ( idim = 0; idim < ndim_in; idim++ ) { \
             if ( lbnd[ idim ] > ubnd[ idim ] ) { \
@@ -12188,8 +13372,6 @@ static void RebinSeq##X( AstMapping *this, double wlim, int ndim_in, \
                          "input region (%d) exceeds corresponding " \
                          "bound of input grid (%d).", status, astGetClass( this ), \
                          ubnd[ idim ], ubnd_in[ idim ] ); \
-            } else { \
-               mpix *= ubnd[ idim ] - lbnd[ idim ] + 1; \
             } \
 \
 /* Say which dimension produced the error. */ \
@@ -12201,13 +13383,6 @@ static void RebinSeq##X( AstMapping *this, double wlim, int ndim_in, \
          } \
       } \
 \
-/* Report an error if there are too many pixels in the input region. */ \
-      if ( astOK && (int) mpix != mpix ) { \
-         astError( AST__EXSPIX, "astRebinSeq"#X"(%s): Supplied input region " \
-                   "contains too many pixels (%zu): must be fewer than %d.", \
-                   status, astGetClass( this ), mpix, INT_MAX ); \
-      } \
-\
 /* Check that only one of AST__USEVAR and ASR__GENVAR has been supplied. */ \
       if( ( flags & AST__USEVAR ) && ( flags & AST__GENVAR ) ) { \
          if( astOK ) { \
@@ -12329,14 +13504,38 @@ static void RebinSeq##X( AstMapping *this, double wlim, int ndim_in, \
          if( nused ) *nused = 0; \
       } \
 \
-/* Paste the input values into the supplied output arrays. */ \
-      if( RebinAdaptively( simple, ndim_in, lbnd_in, ubnd_in, \
-                          (const void *) in, (const void *) in_var, \
-                          TYPE_##X, spread, params, flags, \
-                          tol, maxpix, (const void *) &badval, \
-                          ndim_out, lbnd_out, ubnd_out, lbnd, \
-                          ubnd, npix_out, (void *) out, \
-                          (void *) out_var, weights, nused, status ) ) { \
+/* Paste the input values into the supplied output arrays. If the input \
+   region contains several blocks of pixels (see RebinWithBlocking), and \
+   extra worker threads are available, rebin the blocks in parallel. \
+   Each extra worker needs its own copy of the output arrays, so this is \
+   only done if the input region is at least as big as the output \
+   array. */ \
+      nworker = 1; \
+      if( astOK && npix >= npix_out ) { \
+         nworker = astTaskWorkers( ( npix/( 2*1024 ) < INT_MAX ) ? \
+                                   (int) ( npix/( 2*1024 ) ) : INT_MAX ); \
+      } \
+      if( nworker > 1 ) { \
+         failed = RebinInParallel( simple, nworker, ndim_in, lbnd_in, \
+                                   ubnd_in, (const void *) in, \
+                                   (const void *) in_var, \
+                                   TYPE_##X, spread, params, flags, \
+                                   tol, maxpix, (const void *) &badval, \
+                                   ndim_out, lbnd_out, ubnd_out, lbnd, \
+                                   ubnd, npix_out, (void *) out, \
+                                   (void *) out_var, weights, nused, \
+                                   status ); \
+      } else { \
+         failed = RebinAdaptively( simple, ndim_in, lbnd_in, ubnd_in, \
+                                   (const void *) in, (const void *) in_var, \
+                                   TYPE_##X, spread, params, flags, \
+                                   tol, maxpix, (const void *) &badval, \
+                                   ndim_out, lbnd_out, ubnd_out, lbnd, \
+                                   ubnd, npix_out, (void *) out, \
+                                   (void *) out_var, weights, nused, NULL, \
+                                   status ); \
+      } \
+      if( failed ) { \
          astError( AST__CNFLX, "astRebinSeq"#X"(%s): Flux conservation was " \
                    "requested but could not be performed because the " \
                    "forward transformation of the supplied Mapping " \
@@ -12451,64 +13650,251 @@ MAKE_REBINSEQ(UB,unsigned char,1)
 /* Undefine the macro. */
 #undef MAKE_REBINSEQ
 
-static int RebinWithBlocking( AstMapping *this, const double *linear_fit,
-                               int ndim_in, const int *lbnd_in,
-                               const int *ubnd_in, const void *in,
-                               const void *in_var, DataType type,
-                               int spread, const double *params, int flags,
-                               const void *badval_ptr, int ndim_out,
-                               const int *lbnd_out, const int *ubnd_out,
-                               const int *lbnd, const int *ubnd, int npix_out,
-                               void *out, void *out_var, double *work,
-                               int64_t *nused, int *status ) {
 /*
 *  Name:
-*     RebinWithBlocking
+*     RebinSeq8<X>
 
 *  Purpose:
-*     Rebin a section of a data grid in a memory-efficient way.
+*     Rebin a region of a data grid, using 64-bit grid bounds.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "mapping.h"
-*     int RebinWithBlocking( AstMapping *this, const double *linear_fit,
-*                             int ndim_in, const int *lbnd_in,
-*                             const int *ubnd_in, const void *in,
-*                             const void *in_var, DataType type,
-*                             int spread, const double *params, int flags,
-*                             const void *badval_ptr, int ndim_out,
-*                             const int *lbnd_out, const int *ubnd_out,
-*                             const int *lbnd, const int *ubnd, int npix_out,
-*                             void *out, void *out_var, double *work,
-*                             int64_t *nused, int *status )
+*     void RebinSeq8<X>( AstMapping *this, double wlim, int ndim_in,
+*                        const int64_t lbnd_in[], const int64_t ubnd_in[],
+*                        const <Xtype> in[], const <Xtype> in_var[],
+*                        int spread, const double params[], int flags,
+*                        double tol, int maxpix, <Xtype> badval,
+*                        int ndim_out, const int64_t lbnd_out[],
+*                        const int64_t ubnd_out[], const int64_t lbnd[],
+*                        const int64_t ubnd[], <Xtype> out[],
+*                        <Xtype> out_var[], double weights[],
+*                        int64_t *nused )
 
 *  Class Membership:
-*     Mapping member function.
+*     Mapping member function (over-rides the astRebinSeq8<X> protected
+*     method inherited from the Mapping class).
 
 *  Description:
-*     This function rebins a specified section of a rectangular grid of
-*     data (with any number of dimensions) into another rectangular grid
-*     (with a possibly different number of dimensions). The coordinate
-*     transformation used to convert input pixel coordinates into positions
-*     in the output grid is given by the forward transformation of the
-*     Mapping which is supplied.  Any pixel spreading scheme may be specified
-*     for distributing the flux of an input pixel amongst the output
-*     pixels.
-*
-*     This function is very similar to RebinSection, except that in
-*     order to limit memory usage and to ensure locality of reference,
-*     it divides the input grid up into "blocks" which have a limited
-*     extent along each input dimension. Each block, which will not
-*     contain more than a pre-determined maximum number of pixels, is
-*     then passed to RebinSection for resampling.
-
-*  Parameters:
-*     this
-*        Pointer to a Mapping, whose forward transformation may be
-*        used to transform the coordinates of pixels in the input
-*        grid into associated positions in the output grid.
+*     This function implements the astRebinSeq8<X> method, which is also
+*     used by astRebinSeq<X>. It checks that the supplied bounds can be
+*     represented as type int, and then uses RebinSeq<X> to rebin the grid.
+*     See astRebinSeq<X> for a description of the arguments.
+*/
+/* Define a macro to implement the function for a specific data
+   type. */
+#define MAKE_REBINSEQ8(X,Xtype) \
+static void RebinSeq8##X( AstMapping *this, double wlim, int ndim_in, \
+                          const int64_t lbnd_in[], const int64_t ubnd_in[], \
+                          const Xtype in[], const Xtype in_var[], \
+                          int spread, const double params[], int flags, \
+                          double tol, int maxpix, Xtype badval, \
+                          int ndim_out, const int64_t lbnd_out[], \
+                          const int64_t ubnd_out[], const int64_t lbnd[], \
+                          const int64_t ubnd[], Xtype out[], \
+                          Xtype out_var[], double weights[], \
+                          int64_t *nused, int *status ) { \
+\
+/* Local Variables: */ \
+   const char *class;            /* Object class */ \
+   int *lbnd32;                  /* Input region lower bounds as int */ \
+   int *lbnd_in32;               /* Input grid lower bounds as int */ \
+   int *lbnd_out32;              /* Output grid lower bounds as int */ \
+   int *ubnd32;                  /* Input region upper bounds as int */ \
+   int *ubnd_in32;               /* Input grid upper bounds as int */ \
+   int *ubnd_out32;              /* Output grid upper bounds as int */ \
+\
+/* Check the global error status. */ \
+   if ( !astOK ) return; \
+\
+/* Take int copies of the bounds, checking each can be represented. */ \
+   class = astGetClass( this ); \
+   lbnd_in32 = NarrowBounds( ndim_in, lbnd_in, "astRebinSeq8"#X, class, \
+                             status ); \
+   ubnd_in32 = NarrowBounds( ndim_in, ubnd_in, "astRebinSeq8"#X, class, \
+                             status ); \
+   lbnd_out32 = NarrowBounds( ndim_out, lbnd_out, "astRebinSeq8"#X, class, \
+                              status ); \
+   ubnd_out32 = NarrowBounds( ndim_out, ubnd_out, "astRebinSeq8"#X, class, \
+                              status ); \
+   lbnd32 = NarrowBounds( ndim_in, lbnd, "astRebinSeq8"#X, class, status ); \
+   ubnd32 = NarrowBounds( ndim_in, ubnd, "astRebinSeq8"#X, class, status ); \
+\
+/* Rebin the grid. */ \
+   if ( astOK ) { \
+      RebinSeq##X( this, wlim, ndim_in, lbnd_in32, ubnd_in32, in, \
+                   in_var, spread, params, flags, tol, maxpix, badval, \
+                   ndim_out, lbnd_out32, ubnd_out32, lbnd32, ubnd32, out, \
+                   out_var, weights, nused, status ); \
+   } \
+\
+/* Free the copies. */ \
+   lbnd_in32 = astFree( lbnd_in32 ); \
+   ubnd_in32 = astFree( ubnd_in32 ); \
+   lbnd_out32 = astFree( lbnd_out32 ); \
+   ubnd_out32 = astFree( ubnd_out32 ); \
+   lbnd32 = astFree( lbnd32 ); \
+   ubnd32 = astFree( ubnd32 ); \
+}
+
+/* Expand the above macro to generate a function for each required
+   data type. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_REBINSEQ8(LD,long double)
+#endif
+MAKE_REBINSEQ8(D,double)
+MAKE_REBINSEQ8(F,float)
+MAKE_REBINSEQ8(I,int)
+MAKE_REBINSEQ8(B,char)
+MAKE_REBINSEQ8(UB,unsigned char)
+
+/* Undefine the macro. */
+#undef MAKE_REBINSEQ8
+
+static void RebinTask( void *data, int itask, int iworker, int *status ){
+/*
+*  Name:
+*     RebinTask
+
+*  Purpose:
+*     Rebin one chunk of the blocks of pixels in a RebinJob.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void RebinTask( void *data, int itask, int iworker, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function is invoked by astRunTasks (see RebinInParallel) to
+*     rebin a contiguous chunk of the blocks of input pixels described
+*     by a RebinJob, using the output arrays reserved for the chunk.
+
+*  Parameters:
+*     data
+*        Pointer to the RebinJob structure.
+*     itask
+*        The index of the chunk to rebin.
+*     iworker
+*        The index of the worker thread performing the task. This
+*        determines which Mapping is used.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Thread-specific data */
+   AstMapping *map;              /* Mapping for this worker */
+   BlockQueue *queue;            /* The blocks of input pixels */
+   RebinJob *job;                /* Arguments shared by all blocks */
+   const double *fit;            /* Linear fit for current block */
+   const int *bounds;            /* Bounds of current block */
+   int hi;                       /* Index of first block after chunk */
+   int iblock;                   /* Block index */
+   int lo;                       /* Index of first block in chunk */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Get pointers to the job details. Record the original Mapping for use in
+   error messages issued by this thread. */
+   job = (RebinJob *) data;
+   queue = job->queue;
+   unsimplified_mapping = job->unsimplified;
+
+/* Lock this worker's Mapping for use by the current thread. */
+   map = job->maps[ iworker ];
+   if( iworker > 0 ) astManageLock( map, AST__LOCK, 1, NULL );
+
+/* Rebin each block in the chunk. */
+   lo = (int) ( ( (int64_t) queue->nblock*itask )/job->nchunk );
+   hi = (int) ( ( (int64_t) queue->nblock*( itask + 1 ) )/job->nchunk );
+   for( iblock = lo; iblock < hi && astOK; iblock++ ) {
+      bounds = queue->bounds + 2*queue->ndim*iblock;
+      fit = ( queue->ifit[ iblock ] >= 0 ) ?
+            queue->fits + queue->nfitval*queue->ifit[ iblock ] : NULL;
+      RebinSection( map, fit, job->ndim_in, job->lbnd_in, job->ubnd_in,
+                    job->in, job->in_var, queue->factor[ iblock ], job->type,
+                    job->spread, job->params, job->flags, job->badval_ptr,
+                    job->ndim_out, job->lbnd_out, job->ubnd_out, bounds,
+                    bounds + queue->ndim, job->npix_out, job->out[ itask ],
+                    job->out_var[ itask ], job->work[ itask ],
+                    job->nused ? job->nused + itask : NULL, status );
+   }
+
+/* Unlock the Mapping so that it can be used by other threads. */
+   if( iworker > 0 ) astManageLock( map, AST__UNLOCK, 1, NULL );
+}
+
+static int RebinWithBlocking( AstMapping *this, const double *linear_fit,
+                               int ndim_in, const int *lbnd_in,
+                               const int *ubnd_in, const void *in,
+                               const void *in_var, DataType type,
+                               int spread, const double *params, int flags,
+                               const void *badval_ptr, int ndim_out,
+                               const int *lbnd_out, const int *ubnd_out,
+                               const int *lbnd, const int *ubnd, int64_t npix_out,
+                               void *out, void *out_var, double *work,
+                               int64_t *nused, BlockQueue *queue,
+                               int *status ) {
+/*
+*  Name:
+*     RebinWithBlocking
+
+*  Purpose:
+*     Rebin a section of a data grid in a memory-efficient way.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int RebinWithBlocking( AstMapping *this, const double *linear_fit,
+*                             int ndim_in, const int *lbnd_in,
+*                             const int *ubnd_in, const void *in,
+*                             const void *in_var, DataType type,
+*                             int spread, const double *params, int flags,
+*                             const void *badval_ptr, int ndim_out,
+*                             const int *lbnd_out, const int *ubnd_out,
+*                             const int *lbnd, const int *ubnd, int64_t npix_out,
+*                             void *out, void *out_var, double *work,
+*                             int64_t *nused, BlockQueue *queue,
+*                             int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function rebins a specified section of a rectangular grid of
+*     data (with any number of dimensions) into another rectangular grid
+*     (with a possibly different number of dimensions). The coordinate
+*     transformation used to convert input pixel coordinates into positions
+*     in the output grid is given by the forward transformation of the
+*     Mapping which is supplied.  Any pixel spreading scheme may be specified
+*     for distributing the flux of an input pixel amongst the output
+*     pixels.
+*
+*     This function is very similar to RebinSection, except that in
+*     order to limit memory usage and to ensure locality of reference,
+*     it divides the input grid up into "blocks" which have a limited
+*     extent along each input dimension. Each block, which will not
+*     contain more than a pre-determined maximum number of pixels, is
+*     then passed to RebinSection for resampling.
+
+*  Parameters:
+*     this
+*        Pointer to a Mapping, whose forward transformation may be
+*        used to transform the coordinates of pixels in the input
+*        grid into associated positions in the output grid.
 *
 *        The number of input coordintes for the Mapping (Nin
 *        attribute) should match the value of "ndim_in" (below), and
@@ -12643,6 +14029,10 @@ static int RebinWithBlocking( AstMapping *this, const double *linear_fit,
 *     nused
 *        An optional pointer to a int64_t which will be incremented by the
 *        number of input values pasted into the output array. Ignored if NULL.
+*     queue
+*        If not NULL, each block of input pixels is appended to the
+*        supplied queue (together with the linear fit and flux
+*        conservation factor to use with it) instead of being rebinned.
 
 *  Returned Value:
 *     A non-zero value is returned if "flags" included AST__CONSERVEFLUX (i.e.
@@ -12666,10 +14056,11 @@ static int RebinWithBlocking( AstMapping *this, const double *linear_fit,
    int done;                     /* All blocks rebinned? */
    int hilim;                    /* Upper limit on maximum block dimension */
    int idim;                     /* Loop counter for dimensions */
+   int ifit;                     /* Index of linear fit within queue */
    int lolim;                    /* Lower limit on maximum block dimension */
    int mxdim_block;              /* Maximum block dimension */
-   int npix;                     /* Number of pixels in block */
    int result;                   /* Returned value */
+   int64_t npix;                 /* Number of pixels in block */
 
 /* Initialise */
    result = 0;
@@ -12768,18 +14159,27 @@ static int RebinWithBlocking( AstMapping *this, const double *linear_fit,
          }
       }
 
+/* If the blocks are to be queued, store a copy of the linear fit in the
+   queue. */
+      ifit = ( queue && !result ) ? QueueFit( queue, linear_fit, status ) : -1;
+
 /* Rebin each block of input pixels. */
 /* --------------------------------- */
 /* Loop to generate the extent of each block of input pixels and to
-   rebin them. */
+   rebin them (or queue them for later rebinning). */
       done = result;
       while ( !done && astOK ) {
 
 /* Rebin the current block, accumulating the sum of bad pixels produced. */
-         RebinSection( this, linear_fit, ndim_in, lbnd_in, ubnd_in, in,
-                       in_var, factor, type, spread, params, flags, badval_ptr,
-                       ndim_out, lbnd_out, ubnd_out, lbnd_block, ubnd_block,
-                       npix_out, out, out_var, work, nused, status );
+         if( queue ) {
+            QueueBlock( queue, ifit, factor, lbnd_block, ubnd_block, status );
+         } else {
+            RebinSection( this, linear_fit, ndim_in, lbnd_in, ubnd_in, in,
+                          in_var, factor, type, spread, params, flags,
+                          badval_ptr, ndim_out, lbnd_out, ubnd_out,
+                          lbnd_block, ubnd_block, npix_out, out, out_var,
+                          work, nused, status );
+         }
 
 /* Update the block extent to identify the next block of input pixels. */
          idim = 0;
@@ -13451,6 +14851,9 @@ f        BADVAL and FLAGS arguments.
 *     - A value of zero will be returned if this function is invoked
 *     with the global error status set, or if it should fail for any
 *     reason.
+c     - An error is reported if the number of bad output pixels is too
+c     large to be returned as an "int". Use astResample8<X> in this case
+c     (see the "Handling of Huge Pixel Arrays" section below).
 
 *  Data Type Codes:
 *     To select the appropriate resampling function, you should
@@ -13490,6 +14893,19 @@ f     For compatibility with other Starlink facilities, the codes W
 f     and UW are provided as synonyms for S and US respectively (but
 f     only in the Fortran interface to AST).
 
+*  Handling of Huge Pixel Arrays:
+c     If the input or output grid contains more than 2147483647 pixels
+c     (the largest value that can be stored in an "int"), the 64-bit
+c     version of this function must be used, in which the grid bounds
+c     are of type "int64_t" rather than "int", and the returned value is
+c     also of type "int64_t". The 64-bit version is selected by inserting
+c     "8" before the type code in the function name (e.g. astResample8D
+c     instead of astResampleD). Each individual bound must still lie
+c     within the range of an "int", but the total number of pixels in
+c     each grid is limited only by the available memory.
+f     The Fortran interface does not support grids containing more than
+f     2147483647 pixels.
+
 *  Sub-Pixel Interpolation Schemes:
 *     There is no such thing as a perfect sub-pixel interpolation
 *     scheme and, in practice, all resampling will result in some
@@ -13891,25 +15307,27 @@ f     BADVAL
 /* Define a macro to implement the function for a specific data
    type. */
 #define MAKE_RESAMPLE(X,Xtype) \
-static int Resample##X( AstMapping *this, int ndim_in, \
-                        const int lbnd_in[], const int ubnd_in[], \
-                        const Xtype in[], const Xtype in_var[], \
-                        int interp, void (* finterp)( void ), \
-                        const double params[], int flags, double tol, \
-                        int maxpix, Xtype badval, \
-                        int ndim_out, const int lbnd_out[], \
-                        const int ubnd_out[], const int lbnd[], \
-                        const int ubnd[], Xtype out[], Xtype out_var[], int *status ) { \
+static int64_t Resample##X( AstMapping *this, int ndim_in, \
+                            const int lbnd_in[], const int ubnd_in[], \
+                            const Xtype in[], const Xtype in_var[], \
+                            int interp, void (* finterp)( void ), \
+                            const double params[], int flags, double tol, \
+                            int maxpix, Xtype badval, \
+                            int ndim_out, const int lbnd_out[], \
+                            const int ubnd_out[], const int lbnd[], \
+                            const int ubnd[], Xtype out[], Xtype out_var[], \
+                            int *status ) { \
 \
 /* Local Variables: */ \
    astDECLARE_GLOBALS            /* Thread-specific data */ \
    AstMapping *simple;           /* Pointer to simplified Mapping */ \
+   int done;                     /* Resampled one axis group at a time? */ \
    int idim;                     /* Loop counter for coordinate dimensions */ \
    int nin;                      /* Number of Mapping input coordinates */ \
    int nout;                     /* Number of Mapping output coordinates */ \
-   int npix;                     /* Number of pixels in output region */ \
-   int result;                   /* Result value to return */ \
-   int64_t mpix;                 /* Number of pixels for testing */ \
+   int nworker;                  /* Number of worker threads to use */ \
+   int64_t npix;                 /* Number of pixels in output region */ \
+   int64_t result;               /* Result value to return */ \
 \
 /* Initialise. */ \
    result = 0; \
@@ -13952,9 +15370,7 @@ static int Resample##X( AstMapping *this, int ndim_in, \
    } \
 \
 /* Check that the lower and upper bounds of the input grid are \
-   consistent. Report an error if any pair is not. Also get the number \
-   of pixels in the input grid. */ \
-   mpix = 1; \
+   consistent. Report an error if any pair is not. */ \
    if ( astOK ) { \
       for ( idim = 0; idim < ndim_in; idim++ ) { \
          if ( lbnd_in[ idim ] > ubnd_in[ idim ] ) { \
@@ -13965,19 +15381,10 @@ static int Resample##X( AstMapping *this, int ndim_in, \
             astError( AST__GBDIN, "Error in input dimension %d.", status, \
                       idim + 1 ); \
             break; \
-         } else { \
-            mpix *= ubnd_in[ idim ] - lbnd_in[ idim ] + 1; \
          } \
       } \
    } \
 \
-/* Report an error if there are too many pixels in the input. */ \
-   if ( astOK && (int) mpix != mpix ) { \
-      astError( AST__EXSPIX, "astResample"#X"(%s): Supplied input array " \
-                "contains too many pixels (%zu): must be fewer than %d.", \
-                status, astGetClass( this ), mpix, INT_MAX ); \
-   } \
-\
 /* Check that the positional accuracy tolerance supplied is valid and \
    report an error if necessary. */ \
    if ( astOK && ( tol < 0.0 ) ) { \
@@ -13996,9 +15403,7 @@ static int Resample##X( AstMapping *this, int ndim_in, \
    } \
 \
 /* Check that the lower and upper bounds of the output grid are \
-   consistent. Report an error if any pair is not. Also get the \
-   number of pixels in the output array. */ \
-   mpix = 1; \
+   consistent. Report an error if any pair is not. */ \
    if ( astOK ) { \
       for ( idim = 0; idim < ndim_out; idim++ ) { \
          if ( lbnd_out[ idim ] > ubnd_out[ idim ] ) { \
@@ -14009,21 +15414,11 @@ static int Resample##X( AstMapping *this, int ndim_in, \
             astError( AST__GBDIN, "Error in output dimension %d.", status, \
                       idim + 1 ); \
             break; \
-         } else { \
-            mpix *= ubnd_out[ idim ] - lbnd_out[ idim ] + 1; \
          } \
       } \
    } \
 \
-/* Report an error if there are too many pixels in the output. */ \
-   if ( astOK && (int) mpix != mpix ) { \
-      astError( AST__EXSPIX, "astResample"#X"(%s): Supplied output array " \
-                "contains too many pixels (%zu): must be fewer than %d.", \
-                status, astGetClass( this ), mpix, INT_MAX ); \
-   } \
-\
 /* Similarly check the bounds of the output region. */ \
-   mpix = 1; \
    if ( astOK ) { \
       for ( idim = 0; idim < ndim_out; idim++ ) { \
          if ( lbnd[ idim ] > ubnd[ idim ] ) { \
@@ -14044,8 +15439,6 @@ static int Resample##X( AstMapping *this, int ndim_in, \
                       "output region (%d) exceeds corresponding " \
                       "bound of output grid (%d).", status, astGetClass( this ), \
                       ubnd[ idim ], ubnd_out[ idim ] ); \
-         } else { \
-            mpix *= ubnd[ idim ] - lbnd[ idim ] + 1; \
          } \
 \
 /* Say which dimension produced the error. */ \
@@ -14057,13 +15450,6 @@ static int Resample##X( AstMapping *this, int ndim_in, \
       } \
    } \
 \
-/* Report an error if there are too many pixels in the output region. */ \
-   if ( astOK && (int) mpix != mpix ) { \
-      astError( AST__EXSPIX, "astResample"#X"(%s): Supplied output region " \
-                "contains too many pixels (%zu): must be fewer than %d.", \
-                status, astGetClass( this ), mpix, INT_MAX ); \
-   } \
-\
 /* If we are conserving flux, check "tol" is not zero. */ \
    if( ( flags & AST__CONSERVEFLUX ) && astOK ) { \
       if( tol == 0.0 ) { \
@@ -14082,8 +15468,8 @@ static int Resample##X( AstMapping *this, int ndim_in, \
 \
 /* If OK, loop to determine how many pixels require resampled values. */ \
    simple = NULL; \
+   npix = 1; \
    if ( astOK ) { \
-      npix = 1; \
       for ( idim = 0; idim < ndim_out; idim++ ) { \
          npix *= ubnd[ idim ] - lbnd[ idim ] + 1; \
       } \
@@ -14115,15 +15501,52 @@ static int Resample##X( AstMapping *this, int ndim_in, \
    types that obscure the underlying data type. This is to avoid \
    having to replicate functions unnecessarily for each data \
    type. However, we also pass an argument that identifies the data \
-   type we have obscured. */ \
-   result = ResampleAdaptively( simple, ndim_in, lbnd_in, ubnd_in, \
-                                (const void *) in, (const void *) in_var, \
-                                TYPE_##X, interp, finterp, \
-                                params, flags, tol, maxpix, \
-                                (const void *) &badval, \
-                                ndim_out, lbnd_out, ubnd_out, \
-                                lbnd, ubnd, \
-                                (void *) out, (void *) out_var, status ); \
+   type we have obscured. \
+\
+   If the output region contains several blocks of pixels (see \
+   ResampleWithBlocking), and extra worker threads are available, \
+   resample the blocks in parallel. User-supplied interpolation \
+   functions may not be thread-safe, so are always invoked serially. \
+\
+   If there are sufficient pixels, first attempt to split the Mapping \
+   into independent Mappings for a single axis (e.g. a spectral axis) \
+   and for the remaining axes, so that the interpolation weights for \
+   the remaining axes can be found once and re-used for every pixel \
+   along the single axis (see ResampleSeparable<X>). */ \
+   done = 0; \
+   if ( astOK && npix > 1024 ) { \
+      result = ResampleSeparable##X( simple, ndim_in, lbnd_in, ubnd_in, \
+                                     in, in_var, interp, params, flags, \
+                                     tol, maxpix, badval, ndim_out, \
+                                     lbnd_out, ubnd_out, lbnd, ubnd, \
+                                     out, out_var, &done, status ); \
+   } \
+   nworker = 1; \
+   if ( astOK && interp != AST__UKERN1 && interp != AST__UINTERP ) { \
+      nworker = astTaskWorkers( ( npix/( 2*1024 ) < INT_MAX ) ? \
+                                (int) ( npix/( 2*1024 ) ) : INT_MAX ); \
+   } \
+   if ( !done && nworker > 1 ) { \
+      result = ResampleInParallel( simple, nworker, ndim_in, lbnd_in, \
+                                   ubnd_in, (const void *) in, \
+                                   (const void *) in_var, \
+                                   TYPE_##X, interp, finterp, \
+                                   params, flags, tol, maxpix, \
+                                   (const void *) &badval, \
+                                   ndim_out, lbnd_out, ubnd_out, \
+                                   lbnd, ubnd, \
+                                   (void *) out, (void *) out_var, status ); \
+   } else if ( !done ) { \
+      result = ResampleAdaptively( simple, ndim_in, lbnd_in, ubnd_in, \
+                                   (const void *) in, (const void *) in_var, \
+                                   TYPE_##X, interp, finterp, \
+                                   params, flags, tol, maxpix, \
+                                   (const void *) &badval, \
+                                   ndim_out, lbnd_out, ubnd_out, \
+                                   lbnd, ubnd, \
+                                   (void *) out, (void *) out_var, NULL, \
+                                   status ); \
+   } \
 \
 /* Annul the pointer to the simplified/cloned Mapping. */ \
    simple = astAnnul( simple ); \
@@ -14156,15 +15579,141 @@ MAKE_RESAMPLE(UB,unsigned char)
 /* Undefine the macro. */
 #undef MAKE_RESAMPLE
 
-static int ResampleAdaptively( AstMapping *this, int ndim_in,
-                               const int *lbnd_in, const int *ubnd_in,
-                               const void *in, const void *in_var,
-                               DataType type, int interp, void (* finterp)( void ),
-                               const double *params, int flags, double tol,
-                               int maxpix, const void *badval_ptr,
-                               int ndim_out, const int *lbnd_out,
-                               const int *ubnd_out, const int *lbnd,
-                               const int *ubnd, void *out, void *out_var, int *status ) {
+/*
+*  Name:
+*     Resample8<X>
+
+*  Purpose:
+*     Resample a region of a data grid, using 64-bit grid bounds.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int64_t Resample8<X>( AstMapping *this, int ndim_in,
+*                           const int64_t lbnd_in[], const int64_t ubnd_in[],
+*                           const <Xtype> in[], const <Xtype> in_var[],
+*                           int interp, void (* finterp)( void ),
+*                           const double params[], int flags, double tol,
+*                           int maxpix, <Xtype> badval, int ndim_out,
+*                           const int64_t lbnd_out[],
+*                           const int64_t ubnd_out[],
+*                           const int64_t lbnd[], const int64_t ubnd[],
+*                           <Xtype> out[], <Xtype> out_var[] )
+
+*  Class Membership:
+*     Mapping member function (over-rides the astResample8<X> protected
+*     method inherited from the Mapping class).
+
+*  Description:
+*     This function implements the astResample8<X> method, which is also
+*     used by astResample<X>. It checks that the supplied bounds can be
+*     represented as type int, and then uses Resample<X> to resample the
+*     grid. See astResample<X> for a description of the arguments.
+
+*  Returned Value:
+*     The number of output pixels for which no valid resampled value
+*     could be obtained.
+*/
+/* Define a macro to implement the function for a specific data
+   type. */
+#define MAKE_RESAMPLE8(X,Xtype) \
+static int64_t Resample8##X( AstMapping *this, int ndim_in, \
+                             const int64_t lbnd_in[], \
+                             const int64_t ubnd_in[], \
+                             const Xtype in[], const Xtype in_var[], \
+                             int interp, void (* finterp)( void ), \
+                             const double params[], int flags, double tol, \
+                             int maxpix, Xtype badval, int ndim_out, \
+                             const int64_t lbnd_out[], \
+                             const int64_t ubnd_out[], \
+                             const int64_t lbnd[], const int64_t ubnd[], \
+                             Xtype out[], Xtype out_var[], int *status ) { \
+\
+/* Local Variables: */ \
+   const char *class;            /* Object class */ \
+   int *lbnd32;                  /* Output region lower bounds as int */ \
+   int *lbnd_in32;               /* Input grid lower bounds as int */ \
+   int *lbnd_out32;              /* Output grid lower bounds as int */ \
+   int *ubnd32;                  /* Output region upper bounds as int */ \
+   int *ubnd_in32;               /* Input grid upper bounds as int */ \
+   int *ubnd_out32;              /* Output grid upper bounds as int */ \
+   int64_t result;               /* Result value to return */ \
+\
+/* Initialise. */ \
+   result = 0; \
+\
+/* Check the global error status. */ \
+   if ( !astOK ) return result; \
+\
+/* Take int copies of the bounds, checking each can be represented. */ \
+   class = astGetClass( this ); \
+   lbnd_in32 = NarrowBounds( ndim_in, lbnd_in, "astResample8"#X, class, \
+                             status ); \
+   ubnd_in32 = NarrowBounds( ndim_in, ubnd_in, "astResample8"#X, class, \
+                             status ); \
+   lbnd_out32 = NarrowBounds( ndim_out, lbnd_out, "astResample8"#X, class, \
+                              status ); \
+   ubnd_out32 = NarrowBounds( ndim_out, ubnd_out, "astResample8"#X, class, \
+                              status ); \
+   lbnd32 = NarrowBounds( ndim_out, lbnd, "astResample8"#X, class, status ); \
+   ubnd32 = NarrowBounds( ndim_out, ubnd, "astResample8"#X, class, status ); \
+\
+/* Resample the grid. */ \
+   if ( astOK ) { \
+      result = Resample##X( this, ndim_in, lbnd_in32, ubnd_in32, in, in_var, \
+                            interp, finterp, params, flags, tol, maxpix, \
+                            badval, ndim_out, lbnd_out32, ubnd_out32, \
+                            lbnd32, ubnd32, out, out_var, status ); \
+   } \
+\
+/* Free the copies. */ \
+   lbnd_in32 = astFree( lbnd_in32 ); \
+   ubnd_in32 = astFree( ubnd_in32 ); \
+   lbnd_out32 = astFree( lbnd_out32 ); \
+   ubnd_out32 = astFree( ubnd_out32 ); \
+   lbnd32 = astFree( lbnd32 ); \
+   ubnd32 = astFree( ubnd32 ); \
+\
+/* If an error occurred, clear the returned result. */ \
+   if ( !astOK ) result = 0; \
+\
+/* Return the result. */ \
+   return result; \
+}
+
+/* Expand the above macro to generate a function for each required
+   data type. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_RESAMPLE8(LD,long double)
+#endif
+MAKE_RESAMPLE8(D,double)
+MAKE_RESAMPLE8(F,float)
+MAKE_RESAMPLE8(L,long int)
+MAKE_RESAMPLE8(UL,unsigned long int)
+MAKE_RESAMPLE8(K,INT_BIG)
+MAKE_RESAMPLE8(UK,UINT_BIG)
+MAKE_RESAMPLE8(I,int)
+MAKE_RESAMPLE8(UI,unsigned int)
+MAKE_RESAMPLE8(S,short int)
+MAKE_RESAMPLE8(US,unsigned short int)
+MAKE_RESAMPLE8(B,signed char)
+MAKE_RESAMPLE8(UB,unsigned char)
+
+/* Undefine the macro. */
+#undef MAKE_RESAMPLE8
+
+static int64_t ResampleAdaptively( AstMapping *this, int ndim_in,
+                                   const int *lbnd_in, const int *ubnd_in,
+                                   const void *in, const void *in_var,
+                                   DataType type, int interp, void (* finterp)( void ),
+                                   const double *params, int flags, double tol,
+                                   int maxpix, const void *badval_ptr,
+                                   int ndim_out, const int *lbnd_out,
+                                   const int *ubnd_out, const int *lbnd,
+                                   const int *ubnd, void *out, void *out_var,
+                                   BlockQueue *queue, int *status ) {
 /*
 *  Name:
 *     ResampleAdaptively
@@ -14177,15 +15726,16 @@ static int ResampleAdaptively( AstMapping *this, int ndim_in,
 
 *  Synopsis:
 *     #include "mapping.h"
-*     int ResampleAdaptively( AstMapping *this, int ndim_in,
-*                             const int *lbnd_in, const int *ubnd_in,
-*                             const void *in, const void *in_var,
-*                             DataType type, int interp, void (* finterp)( void ),
-*                             const double *params, int flags, double tol,
-*                             int maxpix, const void *badval_ptr,
-*                             int ndim_out, const int *lbnd_out,
-*                             const int *ubnd_out, const int *lbnd,
-*                             const int *ubnd, void *out, void *out_var )
+*     int64_t ResampleAdaptively( AstMapping *this, int ndim_in,
+*                                 const int *lbnd_in, const int *ubnd_in,
+*                                 const void *in, const void *in_var,
+*                                 DataType type, int interp, void (* finterp)( void ),
+*                                 const double *params, int flags, double tol,
+*                                 int maxpix, const void *badval_ptr,
+*                                 int ndim_out, const int *lbnd_out,
+*                                 const int *ubnd_out, const int *lbnd,
+*                                 const int *ubnd, void *out, void *out_var,
+*                                 BlockQueue *queue )
 
 *  Class Membership:
 *     Mapping member function.
@@ -14374,6 +15924,11 @@ static int ResampleAdaptively( AstMapping *this, int ndim_in,
 *
 *        If no output variance estimates are required, a NULL pointer
 *        should be given.
+*     queue
+*        If not NULL, the blocks of output pixels that would otherwise be
+*        resampled are instead appended to the supplied queue, so that
+*        they can be resampled later (see ResampleInParallel). The
+*        returned value is then always zero.
 
 *  Returned Value:
 *     The number of output grid points for which no valid output value
@@ -14398,12 +15953,12 @@ static int ResampleAdaptively( AstMapping *this, int ndim_in,
    int i;                        /* Loop count */
    int isLinear;                 /* Is the transformation linear? */
    int mxdim;                    /* Largest output section dimension size */
-   int npix;                     /* Number of pixels in output section */
    int npoint;                   /* Number of points for obtaining a fit */
    int nvertex;                  /* Number of vertices of output section */
-   int result;                   /* Result value to return */
    int toobig;                   /* Section too big (must sub-divide)? */
    int toosmall;                 /* Section too small to sub-divide? */
+   int64_t npix;                 /* Number of pixels in output section */
+   int64_t result;               /* Result value to return */
 
 /* Initialise. */
    result = 0;
@@ -14530,7 +16085,8 @@ static int ResampleAdaptively( AstMapping *this, int ndim_in,
                                         in, in_var, type, interp, finterp,
                                         params, flags, badval_ptr,
                                         ndim_out, lbnd_out, ubnd_out,
-                                        lbnd, ubnd, out, out_var, status );
+                                        lbnd, ubnd, out, out_var, queue,
+                                        status );
 
 /* Otherwise, allocate workspace to perform the sub-division. */
       } else {
@@ -14558,7 +16114,8 @@ static int ResampleAdaptively( AstMapping *this, int ndim_in,
                                          params, flags, tol, maxpix,
                                          badval_ptr, ndim_out,
                                          lbnd_out, ubnd_out,
-                                         lo, hi, out, out_var, status );
+                                         lo, hi, out, out_var, queue,
+                                         status );
 
 /* Now set up a second section which covers the remaining half of the
    original output section. */
@@ -14573,7 +16130,8 @@ static int ResampleAdaptively( AstMapping *this, int ndim_in,
                                              params, flags, tol, maxpix,
                                              badval_ptr,  ndim_out,
                                              lbnd_out, ubnd_out,
-                                             lo, hi, out, out_var, status );
+                                             lo, hi, out, out_var, queue,
+                                             status );
             }
          }
 
@@ -14594,6 +16152,159 @@ static int ResampleAdaptively( AstMapping *this, int ndim_in,
    return result;
 }
 
+static int64_t ResampleInParallel( AstMapping *this, int nworker, int ndim_in,
+                                   const int *lbnd_in, const int *ubnd_in,
+                                   const void *in, const void *in_var,
+                                   DataType type, int interp, void (* finterp)( void ),
+                                   const double *params, int flags, double tol,
+                                   int maxpix, const void *badval_ptr,
+                                   int ndim_out, const int *lbnd_out,
+                                   const int *ubnd_out, const int *lbnd,
+                                   const int *ubnd, void *out, void *out_var,
+                                   int *status ) {
+/*
+*  Name:
+*     ResampleInParallel
+
+*  Purpose:
+*     Resample a section of a data grid using several worker threads.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int64_t ResampleInParallel( AstMapping *this, int nworker, int ndim_in,
+*                                 const int *lbnd_in, const int *ubnd_in,
+*                                 const void *in, const void *in_var,
+*                                 DataType type, int interp, void (* finterp)( void ),
+*                                 const double *params, int flags, double tol,
+*                                 int maxpix, const void *badval_ptr,
+*                                 int ndim_out, const int *lbnd_out,
+*                                 const int *ubnd_out, const int *lbnd,
+*                                 const int *ubnd, void *out, void *out_var,
+*                                 int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function has the same effect as ResampleAdaptively, but shares
+*     the work between several threads taken from the AST thread pool
+*     (see astRunTasks).
+*
+*     The output section is first divided into blocks by
+*     ResampleAdaptively, exactly as it would be if no worker threads
+*     were used, so the same linear approximations are used for each
+*     output pixel. The blocks are then resampled in parallel. Since
+*     each output pixel belongs to exactly one block, the results are
+*     identical to those produced by ResampleAdaptively.
+
+*  Parameters:
+*     this
+*        Pointer to a Mapping, whose inverse transformation may be
+*        used to transform the coordinates of pixels in the output
+*        grid into associated positions in the input grid.
+*     nworker
+*        The number of worker threads to use, including the calling
+*        thread.
+*     ndim_in, lbnd_in, ubnd_in, in, in_var, type, interp, finterp, params,
+*     flags, tol, maxpix, badval_ptr, ndim_out, lbnd_out, ubnd_out, lbnd,
+*     ubnd, out, out_var
+*        As for ResampleAdaptively.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of output grid points to which a data value (or a
+*     variance value if relevant) equal to "badval" has been assigned
+*     because no valid output value could be obtained.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Thread-specific data */
+   BlockQueue queue;             /* The blocks of output pixels */
+   ResampleJob job;              /* Arguments shared by all blocks */
+   int iblock;                   /* Block index */
+   int64_t result;               /* Result value to return */
+
+/* Initialise. */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(this);
+
+/* Divide the output section into blocks, recording each one in a queue
+   rather than resampling it. */
+   queue.ndim = ndim_out;
+   queue.nfitval = ndim_in*( ndim_out + 1 );
+   queue.nblock = 0;
+   queue.nfit = 0;
+   queue.bounds = NULL;
+   queue.ifit = NULL;
+   queue.factor = NULL;
+   queue.fits = NULL;
+   (void) ResampleAdaptively( this, ndim_in, lbnd_in, ubnd_in, in, in_var,
+                              type, interp, finterp, params, flags, tol,
+                              maxpix, badval_ptr, ndim_out, lbnd_out,
+                              ubnd_out, lbnd, ubnd, out, out_var, &queue,
+                              status );
+
+/* Allocate an array to hold the number of bad output pixels in each
+   block, and create a separate Mapping for each worker, since
+   transforming positions may modify the Mapping. */
+   if( nworker > queue.nblock ) nworker = queue.nblock;
+   job.nbad = astCalloc( queue.nblock, sizeof( int ) );
+   job.maps = WorkerMappings( this, nworker, status );
+
+/* Resample the blocks in parallel. */
+   if( astOK && queue.nblock > 0 ) {
+      job.unsimplified = unsimplified_mapping;
+      job.queue = &queue;
+      job.params = params;
+      job.lbnd_in = lbnd_in;
+      job.lbnd_out = lbnd_out;
+      job.ubnd_in = ubnd_in;
+      job.ubnd_out = ubnd_out;
+      job.badval_ptr = badval_ptr;
+      job.in = in;
+      job.in_var = in_var;
+      job.type = type;
+      job.flags = flags;
+      job.interp = interp;
+      job.ndim_in = ndim_in;
+      job.ndim_out = ndim_out;
+      job.finterp = finterp;
+      job.out = out;
+      job.out_var = out_var;
+      astRunTasks( queue.nblock, nworker, ResampleTask, &job );
+
+/* Sum the numbers of bad output pixels. */
+      for( iblock = 0; iblock < queue.nblock; iblock++ ) {
+         result += job.nbad[ iblock ];
+      }
+   }
+
+/* Free resources. */
+   job.maps = FreeWorkerMappings( job.maps, nworker, status );
+   job.nbad = astFree( job.nbad );
+   FreeQueue( &queue, status );
+
+/* If an error occurred, clear the returned value. */
+   if ( !astOK ) result = 0;
+
+/* Return the result. */
+   return result;
+}
+
 static int ResampleSection( AstMapping *this, const double *linear_fit,
                             int ndim_in,
                             const int *lbnd_in, const int *ubnd_in,
@@ -14808,13 +16519,11 @@ static int ResampleSection( AstMapping *this, const double *linear_fit,
    double **ptr_in;              /* Pointer to input PointSet coordinates */
    double **ptr_out;             /* Pointer to output PointSet coordinates */
    double *accum;                /* Pointer to array of accumulated sums */
-   double fwhm;                  /* Full width half max. of gaussian */
    double lpar[ 1 ];             /* Local parameter array */
    double x1;                    /* Interim x coordinate value */
    double y1;                    /* Interim y coordinate value */
    int *dim;                     /* Pointer to array of output pixel indices */
-   int *offset;                  /* Pointer to array of output pixel offsets */
-   int *stride;                  /* Pointer to array of output grid strides */
+   int *uoffset;                 /* Pointer to int copy of "offset" array */
    int conserve;                 /* Conserve flux? */
    int coord_in;                 /* Loop counter for input dimensions */
    int coord_out;                /* Loop counter for output dimensions */
@@ -14827,13 +16536,14 @@ static int ResampleSection( AstMapping *this, const double *linear_fit,
    int nbad;                     /* Number of pixels assigned a bad value */
    int neighb;                   /* Number of neighbouring pixels */
    int npoint;                   /* Number of output points (pixels) */
-   int off1;                     /* Interim pixel offset into output array */
-   int off;                      /* Final pixel offset into output array */
    int point;                    /* Counter for output points (pixels ) */
    int result;                   /* Result value to be returned */
-   int s;                        /* Temporary variable for strides */
    int usevar;                   /* Process variance array? */
-   void (* gifunc)( void );      /* General interpolation function */
+   int64_t *offset;              /* Pointer to array of output pixel offsets */
+   int64_t *stride;              /* Pointer to array of output grid strides */
+   int64_t off1;                 /* Interim pixel offset into output array */
+   int64_t off;                  /* Final pixel offset into output array */
+   int64_t s;                    /* Temporary variable for strides */
    void (* kernel)( double, const double [], int, double *, int * ); /* Kernel fn. */
    void (* fkernel)( double, const double [], int, double * ); /* User kernel fn. */
 
@@ -14850,7 +16560,7 @@ static int ResampleSection( AstMapping *this, const double *linear_fit,
    pset_in = NULL;
    ptr_in = NULL;
    neighb = 0;
-   gifunc = NULL;
+   uoffset = NULL;
    kernel = NULL;
    fkernel = NULL;
 
@@ -14873,8 +16583,8 @@ static int ResampleSection( AstMapping *this, const double *linear_fit,
    }
 
 /* Allocate workspace. */
-   offset = astMalloc( sizeof( int ) * (size_t) npoint );
-   stride = astMalloc( sizeof( int ) * (size_t) ndim_out );
+   offset = astMalloc( sizeof( int64_t ) * (size_t) npoint );
+   stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_out );
    if ( astOK ) {
 
 /* Calculate the stride for each output grid dimension. */
@@ -15292,165 +17002,21 @@ static int ResampleSection( AstMapping *this, const double *linear_fit,
 /* Obtain a pointer to the appropriate 1-d kernel function (either
    internal or user-defined) and set up any parameters it may
    require. */
-            par = NULL;
-            switch ( interp ) {
-
-/* sinc(pi*x) interpolation. */
-/* ------------------------- */
-/* Assign the kernel function. */
-               case AST__SINC:
-                  kernel = Sinc;
+            if ( interp == AST__UKERN1 ) {
+               fkernel = (void (*)( double, const double [],
+                                    int, double * )) finterp;
 
 /* Calculate the number of neighbouring pixels to use. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) {
-                     neighb = 2;
-                  } else {
-                     neighb = MaxI( 1, neighb, status );
-                  }
-                  break;
+               neighb = MaxI( 1, (int) floor( params[ 0 ] + 0.5 ), status );
 
-/* sinc(pi*x)*cos(k*pi*x) interpolation. */
-/* ------------------------------------- */
-/* Assign the kernel function. */
-               case AST__SINCCOS:
-                  kernel = SincCos;
+/* Pass a pointer to the "params" array. */
+               par = params;
 
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, the number will be calculated automatically below. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = INT_MAX;
-
-/* Calculate the maximum number of neighbouring pixels required by the
-   width of the kernel, and use this value if preferable. */
-                  neighb = MinI( neighb,
-                                 (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
-                  break;
-
-/* somb(pi*x) interpolation. */
-/* ------------------------- */
-/* Assign the kernel function. */
-               case AST__SOMB:
-                  kernel = Somb;
-
-/* Calculate the number of neighbouring pixels to use. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) {
-                     neighb = 2;
-                  } else {
-                     neighb = MaxI( 1, neighb, status );
-                  }
-                  break;
-
-/* somb(pi*x)*cos(k*pi*x) interpolation. */
-/* ------------------------------------- */
-/* Assign the kernel function. */
-               case AST__SOMBCOS:
-                  kernel = SombCos;
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, the number will be calculated automatically below. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = INT_MAX;
-
-/* Calculate the maximum number of neighbouring pixels required by the
-   width of the kernel, and use this value if preferable. */
-                  neighb = MinI( neighb,
-                                 (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
-                  break;
-
-/* sinc(pi*x)*exp(-k*x*x) interpolation. */
-/* ------------------------------------- */
-/* Assign the kernel function. */
-               case AST__SINCGAUSS:
-                  kernel = SincGauss;
-
-/* Constrain the full width half maximum of the gaussian factor. */
-                  fwhm = MaxD( 0.1, params[ 1 ], status );
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 4.0 * log( 2.0 ) / ( fwhm * fwhm );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, use the number of neighbouring pixels required by the width
-   of the kernel (out to where the gaussian term falls to 1% of its
-   peak value). */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = (int) ceil( sqrt( -log( 0.01 ) /
-                                                                lpar[ 0 ] ) );
-                  break;
-
-/* exp(-k*x*x) interpolation. */
-/* -------------------------- */
-/* Assign the kernel function. */
-               case AST__GAUSS:
-                  kernel = Gauss;
-
-/* Constrain the full width half maximum of the gaussian. */
-                  fwhm = MaxD( 0.1, params[ 1 ], status );
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 4.0 * log( 2.0 ) / ( fwhm * fwhm );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, use the number of neighbouring pixels required by the width
-   of the kernel (out to where the gaussian term falls to 1% of its
-   peak value). */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = (int) ceil( sqrt( -log( 0.01 ) /
-                                                                lpar[ 0 ] ) );
-                  break;
-
-/* sinc(pi*x)*sinc(k*pi*x) interpolation. */
-/* -------------------------------------- */
-/* Assign the kernel function. */
-               case AST__SINCSINC:
-                  kernel = SincSinc;
-
-/* Store the required value of "k" in a local parameter array and pass
-   this array to the kernel function. */
-                  lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
-                  par = lpar;
-
-/* Obtain the number of neighbouring pixels to use. If this is zero or
-   less, the number will be calculated automatically below. */
-                  neighb = (int) floor( params[ 0 ] + 0.5 );
-                  if ( neighb <= 0 ) neighb = INT_MAX;
-
-/* Calculate the maximum number of neighbouring pixels required by the
-   width of the kernel, and use this value if preferable. */
-                  neighb = MinI( neighb,
-                                 (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
-                  break;
-
-/* User-supplied kernel. */
-/* --------------------- */
-/* Assign the kernel function. */
-               case AST__UKERN1:
-                  fkernel = (void (*)( double, const double [],
-                                       int, double * )) finterp;
-
-/* Calculate the number of neighbouring pixels to use. */
-                  neighb = MaxI( 1, (int) floor( params[ 0 ] + 0.5 ), status );
-
-/* Pass a pointer to the "params" array. */
-                  par = params;
-                  break;
-            }
+/* Internal kernels. */
+            } else {
+               SetupKernel1( interp, params, &kernel, lpar, &par, &neighb,
+                             status );
+            }
 
 /* Define a macro to use a "case" statement to invoke the 1-d kernel
    interpolation function appropriate to a given data type, passing it
@@ -15495,46 +17061,34 @@ static int ResampleSection( AstMapping *this, const double *linear_fit,
          case AST__BLOCKAVE:
          case AST__UINTERP:
 
+/* User-supplied sub-pixel interpolation functions accept output pixel
+   offsets of type int, so take a copy of the offsets, checking that
+   each can be represented. */
+            if ( interp == AST__UINTERP ) {
+               uoffset = astMalloc( sizeof( int ) * (size_t) npoint );
+               for ( point = 0; astOK && ( point < npoint ); point++ ) {
+                  if ( offset[ point ] > INT_MAX ) {
+                     astError( AST__EXSPIX, "astResample(%s): The output "
+                               "grid is too large (more than %d pixels) to "
+                               "be resampled using a user-supplied "
+                               "sub-pixel interpolation function.", status,
+                               astGetClass( unsimplified_mapping ), INT_MAX );
+                  } else {
+                     uoffset[ point ] = (int) offset[ point ];
+                  }
+               }
+            }
+
 /* Define a macro to use a "case" statement to invoke the general
    sub-pixel interpolation function appropriate to a given type and
    the selected value of the interp variable. */
 #define CASE_GINTERP(X,Xtype) \
                case ( TYPE_##X ): \
 \
-/* Obtain a pointer to the appropriate general interpolation function \
-   (either internal or user-defined) and set up any parameters it may \
-   require. */ \
-                  switch ( interp ) { \
-\
 /* Block averaging interpolation. */ \
 /* ------------------------------ */ \
-                     case AST__BLOCKAVE: \
-                        gifunc = (void (*)( void )) InterpolateBlockAverage##X; \
-                        break; \
-\
-/* User-supplied sub-pixel interpolation function. */ \
-/* ----------------------------------------------- */ \
-                     case AST__UINTERP: \
-                        gifunc = (void (*)( void )) finterp; \
-                        break; \
-                  } \
-\
-/* Invoke the general interpolation function.  It has to be cast to the \
-   right type (i.e. a function with the correctly typed arguments) \
-   to prevent default promotion (to int or double) of its arguments. \
-   The cast here corresponds to the declaration of
-   ast_resample_uinterp##Xtype. */ \
-                  ( *( (void (*)( int, const int[], const int[], \
-                                  const Xtype[], \
-                                  const Xtype[], \
-                                  int, const int[], \
-                                  const double *const[], \
-                                  const double[], int, \
-                                  Xtype, \
-                                  Xtype *, \
-                                  Xtype *, \
-                                  int * )) \
-                       gifunc ) )( ndim_in, lbnd_in, ubnd_in, \
+                  if ( interp == AST__BLOCKAVE ) { \
+                     InterpolateBlockAverage##X( ndim_in, lbnd_in, ubnd_in, \
                                    (Xtype *) in, \
                                    (Xtype *) ( usevar ? in_var : NULL ), \
                                    npoint, offset, \
@@ -15544,6 +17098,36 @@ static int ResampleSection( AstMapping *this, const double *linear_fit,
                                    (Xtype *) out, \
                                    (Xtype *) ( usevar ? out_var : NULL ), \
                                    &nbad ); \
+\
+/* User-supplied sub-pixel interpolation function. */ \
+/* ----------------------------------------------- */ \
+/* Invoke the function, passing the int copy of the output pixel \
+   offsets. It has to be cast to the right type (i.e. a function with \
+   the correctly typed arguments) to prevent default promotion (to int \
+   or double) of its arguments. The cast here corresponds to the \
+   declaration of ast_resample_uinterp##Xtype. */ \
+                  } else if ( astOK ) { \
+                     ( *( (void (*)( int, const int[], const int[], \
+                                     const Xtype[], \
+                                     const Xtype[], \
+                                     int, const int[], \
+                                     const double *const[], \
+                                     const double[], int, \
+                                     Xtype, \
+                                     Xtype *, \
+                                     Xtype *, \
+                                     int * )) \
+                          finterp ) )( ndim_in, lbnd_in, ubnd_in, \
+                                       (Xtype *) in, \
+                                       (Xtype *) ( usevar ? in_var : NULL ), \
+                                       npoint, uoffset, \
+                                       (const double *const *) ptr_in, \
+                                       params, flags, \
+                                       *( (Xtype *) badval_ptr ), \
+                                       (Xtype *) out, \
+                                       (Xtype *) ( usevar ? out_var : NULL ), \
+                                       &nbad ); \
+                  } \
                   if ( astOK ) { \
                      result += nbad; \
                   } else { \
@@ -15648,34 +17232,1833 @@ static int ResampleSection( AstMapping *this, const double *linear_fit,
          CASE_CONSERVE(UB,unsigned char)
       }
 
-/* Undefine the macro. */
-#undef CASE_CONSERVE
+/* Undefine the macro. */
+#undef CASE_CONSERVE
+   }
+
+/* Annul the PointSet used to hold input coordinates. */
+   pset_in = astAnnul( pset_in );
+
+/* Free the workspace. */
+   offset = astFree( offset );
+   stride = astFree( stride );
+   uoffset = astFree( uoffset );
+
+/* If an error occurred, clear the returned value. */
+   if ( !astOK ) result = 0;
+
+/* Return the result. */
+   return result;
+}
+
+/*
+*  Name:
+*     ResampleSeparable<X>
+
+*  Purpose:
+*     Resample a data grid one axis group at a time, if possible.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int ResampleSeparable<X>( AstMapping *this, int ndim_in,
+*                               const int lbnd_in[], const int ubnd_in[],
+*                               const <Xtype> in[], const <Xtype> in_var[],
+*                               int interp, const double params[],
+*                               int flags, double tol, int maxpix,
+*                               <Xtype> badval, int ndim_out,
+*                               const int lbnd_out[], const int ubnd_out[],
+*                               const int lbnd[], const int ubnd[],
+*                               <Xtype> out[], <Xtype> out_var[], int *done,
+*                               int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This is a set of functions which are used by astResample<X> to
+*     resample a section of a data grid using a Mapping that can be
+*     split into a Mapping for a single "channel" axis and a Mapping
+*     for the remaining "plane" axes (such as the spectral and spatial
+*     axes of a data cube - see SeparableWeights).
+*
+*     Rather than transforming the position of every output pixel and
+*     interpolating in all dimensions at once, each output channel is
+*     formed by first finding the weighted sum of the input planes that
+*     contribute to it, and then interpolating within this intermediate
+*     plane using plane weights that are found only once and re-used
+*     for every channel. The interpolation weights are separable, so the
+*     results are the same as those produced by resampling the whole
+*     grid at once (to within rounding errors and the tolerance used
+*     for approximating the Mappings).
+*
+*     Nothing is done (and "*done" is returned as zero) if the data or
+*     Mapping are not suitable. This happens if the Mapping cannot be
+*     split, if the interpolation scheme or flags are unsuitable, or if
+*     any of the input data or variance values would be rejected as
+*     bad (since the weights would then differ from pixel to pixel).
+
+*  Parameters:
+*     this
+*        Pointer to a Mapping, whose inverse transformation will be
+*        used to transform the coordinates of pixels in the output
+*        grid into the coordinate system of the input grid.
+*     ndim_in, lbnd_in, ubnd_in, in, in_var, interp, params, flags, tol,
+*     maxpix, badval, ndim_out, lbnd_out, ubnd_out, lbnd, ubnd, out,
+*     out_var
+*        As for astResample<X>.
+*     done
+*        Pointer to an int in which to return a flag indicating if the
+*        resampling has been performed.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of output grid points to which a data value (or a
+*     variance value if relevant) equal to "badval" has been assigned
+*     because no valid output value could be obtained.
+
+*  Notes:
+*     - There is a separate function for each numerical type of
+*     gridded data, distinguished by replacing the <X> in the function
+*     name by the appropriate 1- or 2-character suffix.
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+/* Define a macro to implement the function for a specific data
+   type. */
+#define MAKE_RESAMPLE_SEPARABLE(X,Xtype,Xfloating,Xfloattype,Xsigned) \
+static void ResampleSeparableTask##X( void *data, int itask, int iworker, \
+                                      int *status ) { \
+\
+/* Local Variables: */ \
+   SeparableJob *job;            /* Description of the whole job */ \
+   Xfloattype *plane;            /* Intermediate plane data values */ \
+   Xfloattype *plane_var;        /* Intermediate plane variances */ \
+   Xfloattype hi_lim;            /* Upper limit on output values */ \
+   Xfloattype lo_lim;            /* Lower limit on output values */ \
+   Xfloattype sum;               /* Weighted sum of pixel data values */ \
+   Xfloattype sum_var;           /* Weighted sum of pixel variance values */ \
+   Xfloattype val;               /* Data value to be assigned to output */ \
+   Xfloattype val_var;           /* Variance to be assigned to output */ \
+   Xfloattype wt;                /* Weight of current input pixel */ \
+   Xfloattype wtsum;             /* Sum of weight values */ \
+   Xfloattype wtsum_chan;        /* Sum of channel weight values */ \
+   Xfloattype wtsum_sq;          /* Square of sum of weights */ \
+   Xtype *out;                   /* Output data array */ \
+   Xtype *out_var;               /* Output variance array */ \
+   Xtype badval;                 /* Bad value */ \
+   const Xtype *pin;             /* Input data for current input channel */ \
+   const Xtype *pin_var;         /* Input variances for input channel */ \
+   const int *base;              /* Input offsets of plane pixels */ \
+   int bad;                      /* Output pixel bad? */ \
+   int bad_chan;                 /* Whole output channel bad? */ \
+   int bad_var;                  /* Output variance bad? */ \
+   int hi_wt;                    /* Index of last weight for pixel, plus one */ \
+   int ipix;                     /* Index of current output plane pixel */ \
+   int iwt;                      /* Index of current weight */ \
+   int k;                        /* Index of intermediate plane pixel */ \
+   int nbase;                    /* Number of intermediate plane pixels */ \
+   int nobad;                    /* Was the AST__NOBAD flag set? */ \
+   int off_chan;                 /* Offset to output channel */ \
+   int off_out;                  /* Offset to output pixel */ \
+   int result;                   /* Number of bad output values */ \
+   int usevar;                   /* Process variance array? */ \
+\
+/* Check the global error status. */ \
+   if ( !astOK ) return; \
+\
+/* Get a pointer to the job details, and the arrays being processed. */ \
+   job = (SeparableJob *) data; \
+   out = (Xtype *) job->out; \
+   out_var = (Xtype *) job->out_var; \
+   badval = *( (const Xtype *) job->badval_ptr ); \
+   base = job->base; \
+   nbase = job->nbase; \
+\
+/* Determine if we are processing bad pixels or variances. */ \
+   nobad = job->flags & AST__NOBAD; \
+   usevar = job->in_var && out_var; \
+\
+/* Get pointers to this worker's intermediate plane. */ \
+   plane = ( (Xfloattype *) job->work ) + 2*iworker*nbase; \
+   plane_var = plane + nbase; \
+\
+/* Set up limits for checking output values to ensure that they do not \
+   overflow the range of the data type being used. */ \
+   lo_lim = LO_##X; \
+   hi_lim = HI_##X; \
+\
+/* Further initialisation. */ \
+   result = 0; \
+   val = 0; \
+   val_var = 0; \
+   bad_var = 0; \
+   wtsum_chan = (Xfloattype) 0.0; \
+\
+/* The whole output channel is bad if its position does not fall within \
+   the input grid. Otherwise, form the intermediate plane for the \
+   channel as the weighted sum of the input planes that contribute to \
+   it (the normalisation is applied to each output pixel below). Loop \
+   over the weights first, so that each input plane is accessed \
+   sequentially. */ \
+   bad_chan = ( job->cen_chan[ itask ] < 0 ); \
+   if ( !bad_chan ) { \
+      for ( k = 0; k < nbase; k++ ) plane[ k ] = (Xfloattype) 0.0; \
+      if ( usevar ) { \
+         for ( k = 0; k < nbase; k++ ) plane_var[ k ] = (Xfloattype) 0.0; \
+      } \
+      hi_wt = job->start_chan[ itask + 1 ]; \
+      for ( iwt = job->start_chan[ itask ]; iwt < hi_wt; iwt++ ) { \
+         wt = (Xfloattype) job->wt_chan[ iwt ]; \
+         wtsum_chan += wt; \
+         pin = ( (const Xtype *) job->in ) + job->in_chan[ iwt ]; \
+         for ( k = 0; k < nbase; k++ ) { \
+            plane[ k ] += wt * ( (Xfloattype) pin[ base[ k ] ] ); \
+         } \
+         if ( usevar ) { \
+            wt *= wt; \
+            pin_var = ( (const Xtype *) job->in_var ) + job->in_chan[ iwt ]; \
+            for ( k = 0; k < nbase; k++ ) { \
+               plane_var[ k ] += wt * ( (Xfloattype) pin_var[ base[ k ] ] ); \
+            } \
+         } \
+      } \
+   } \
+\
+/* Loop round each output pixel in the channel. */ \
+   off_chan = job->out_chan[ itask ]; \
+   for ( ipix = 0; ipix < job->nplane; ipix++ ) { \
+      off_out = off_chan + job->out_plane[ ipix ]; \
+\
+/* The output pixel is bad if the output position does not fall within \
+   the input grid. Otherwise, form the weighted sums over the pixels in \
+   the intermediate plane that contribute to the output pixel. */ \
+      bad = bad_chan || ( job->cen_plane[ ipix ] < 0 ); \
+      if ( !bad ) { \
+         sum = (Xfloattype) 0.0; \
+         wtsum = (Xfloattype) 0.0; \
+         sum_var = (Xfloattype) 0.0; \
+         hi_wt = job->start_plane[ ipix + 1 ]; \
+         for ( iwt = job->start_plane[ ipix ]; iwt < hi_wt; iwt++ ) { \
+            wt = (Xfloattype) job->wt_plane[ iwt ]; \
+            k = job->in_plane[ iwt ]; \
+            sum += wt * plane[ k ]; \
+            wtsum += wt; \
+            if ( usevar ) sum_var += wt * wt * plane_var[ k ]; \
+         } \
+\
+/* The total weight is the product of the channel and plane weights. \
+   Check that an interpolated value can be produced, and that it does \
+   not overflow the output data type. */ \
+         wtsum *= wtsum_chan; \
+         bad = ( wtsum == (Xfloattype) 0.0 ); \
+         if ( !bad ) { \
+            val = sum / wtsum; \
+            if ( !( Xfloating ) ) { \
+               bad = ( val <= lo_lim ) || ( val >= hi_lim ); \
+            } \
+         } \
+\
+/* Perform similar checks on the output variance value. */ \
+         if ( usevar && !bad ) { \
+            wtsum_sq = wtsum * wtsum; \
+            bad_var = ( wtsum_sq == (Xfloattype) 0.0 ); \
+            if ( !bad_var ) { \
+               val_var = sum_var / wtsum_sq; \
+               if ( !( Xfloating ) ) { \
+                  bad_var = ( val_var <= lo_lim ) || ( val_var >= hi_lim ); \
+               } \
+            } \
+         } \
+      } \
+\
+/* Assign a bad output value (and variance) if required and count it. */ \
+      if ( bad ) { \
+         if ( !nobad ) { \
+            out[ off_out ] = badval; \
+            if ( usevar ) out_var[ off_out ] = badval; \
+         } \
+         result++; \
+\
+/* Otherwise, assign the interpolated value, rounding to the nearest \
+   integer if necessary. */ \
+      } else { \
+         if ( Xfloating ) { \
+            out[ off_out ] = (Xtype) val; \
+         } else { \
+            out[ off_out ] = (Xtype) ( val + ( ( val >= (Xfloattype) 0.0 ) ? \
+                                               ( (Xfloattype) 0.5 ) : \
+                                               ( (Xfloattype) -0.5 ) ) ); \
+         } \
+\
+/* Similarly assign the variance, if required. */ \
+         if ( usevar ) { \
+            if ( bad_var ) { \
+               if ( !nobad ) out_var[ off_out ] = badval; \
+               result++; \
+            } else if ( Xfloating ) { \
+               out_var[ off_out ] = (Xtype) val_var; \
+            } else { \
+               out_var[ off_out ] = (Xtype) ( val_var + \
+                                          ( ( val_var >= (Xfloattype) 0.0 ) ? \
+                                            ( (Xfloattype) 0.5 ) : \
+                                            ( (Xfloattype) -0.5 ) ) ); \
+            } \
+         } \
+      } \
+   } \
+\
+/* Store the number of bad output values in the channel. */ \
+   job->nbad[ itask ] = result; \
+} \
+\
+static int ResampleSeparable##X( AstMapping *this, int ndim_in, \
+                                 const int lbnd_in[], const int ubnd_in[], \
+                                 const Xtype in[], const Xtype in_var[], \
+                                 int interp, const double params[], \
+                                 int flags, double tol, int maxpix, \
+                                 Xtype badval, int ndim_out, \
+                                 const int lbnd_out[], const int ubnd_out[], \
+                                 const int lbnd[], const int ubnd[], \
+                                 Xtype out[], Xtype out_var[], int *done, \
+                                 int *status ) { \
+\
+/* Local Variables: */ \
+   SeparableJob job;             /* Weights and arrays for each channel */ \
+   Xtype var;                    /* Input variance value */ \
+   int bad_var;                  /* Input variance bad? */ \
+   int ichan;                    /* Output channel index */ \
+   int idim;                     /* Loop counter for dimensions */ \
+   int nworker;                  /* Number of workers to use */ \
+   int result;                   /* Result value to return */ \
+   int usebad;                   /* Use "bad" input pixel values? */ \
+   int usevar;                   /* Process variance array? */ \
+   size_t ipix;                  /* Input pixel index */ \
+   size_t npix_in;               /* Number of pixels in input grid */ \
+\
+/* Initialise. */ \
+   *done = 0; \
+   result = 0; \
+\
+/* Check the global error status. Also check that the input and output \
+   grids have the same number of dimensions and that flux conservation \
+   (which requires the Jacobian of the whole Mapping) is not required. */ \
+   if ( !astOK || ndim_in != ndim_out || \
+        ( flags & AST__CONSERVEFLUX ) ) return result; \
+\
+/* The weights used for each output pixel must not depend on the input \
+   data values, so check that no input data value or variance would be \
+   rejected as bad. */ \
+   usebad = flags & AST__USEBAD; \
+   usevar = in_var && out_var; \
+   npix_in = 1; \
+   for ( idim = 0; idim < ndim_in; idim++ ) { \
+      npix_in *= (size_t) ( ubnd_in[ idim ] - lbnd_in[ idim ] + 1 ); \
+   } \
+   if ( usebad ) { \
+      for ( ipix = 0; ipix < npix_in; ipix++ ) { \
+         if ( in[ ipix ] == badval ) return result; \
+      } \
+   } \
+   if ( usevar ) { \
+      bad_var = 0; \
+      for ( ipix = 0; ipix < npix_in && !bad_var; ipix++ ) { \
+         var = in_var[ ipix ]; \
+         if ( usebad ) bad_var = ( var == badval ); \
+         CHECK_FOR_NEGATIVE_VARIANCE(Xtype) \
+      } \
+      if ( bad_var ) return result; \
+   } \
+\
+/* Attempt to split the Mapping and find the weights for each axis \
+   group. Return if this is not possible. */ \
+   if ( !SeparableWeights( this, ndim_in, lbnd_in, ubnd_in, interp, \
+                           params, tol, maxpix, lbnd_out, ubnd_out, lbnd, \
+                           ubnd, &job, status ) ) return result; \
+   *done = 1; \
+\
+/* Allocate an intermediate plane (data and variance) for each worker, \
+   and resample the output channels in parallel. */ \
+   nworker = astTaskWorkers( job.nchan ); \
+   job.work = astMalloc( sizeof( Xfloattype )*(size_t) ( 2*nworker ) \
+                                             *(size_t) job.nbase ); \
+   job.nbad = astCalloc( (size_t) job.nchan, sizeof( int ) ); \
+   if ( astOK && job.nchan > 0 ) { \
+      job.badval_ptr = &badval; \
+      job.in = in; \
+      job.in_var = in_var; \
+      job.flags = flags; \
+      job.out = out; \
+      job.out_var = out_var; \
+      astRunTasks( job.nchan, nworker, ResampleSeparableTask##X, &job ); \
+\
+/* Sum the numbers of bad output values. */ \
+      for ( ichan = 0; ichan < job.nchan; ichan++ ) { \
+         result += job.nbad[ ichan ]; \
+      } \
+   } \
+\
+/* Free resources. */ \
+   FreeSeparable( &job, status ); \
+\
+/* If an error occurred, clear the returned result. */ \
+   if ( !astOK ) result = 0; \
+\
+/* Return the result. */ \
+   return result; \
+}
+
+/* These subsidiary macros define limits for range checking of results
+   before conversion to the final data type (see above). */
+
+/* If <X> is a floating point type, the limits are not actually used,
+   but must be present to permit error-free compilation. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+#define HI_LD ( 0.0L )
+#define LO_LD ( 0.0L )
+#endif
+#define HI_D ( 0.0 )
+#define LO_D ( 0.0 )
+#define HI_F ( 0.0f )
+#define LO_F ( 0.0f )
+
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+#define HI_K   ( 0.5L + (long double) LONG_MAX )
+#define LO_K  ( -0.5L + (long double) LONG_MIN )
+#define HI_UK  ( 0.5L + (long double) ULONG_MAX )
+#define LO_UK ( -0.5L )
+#define HI_L   ( 0.5L + (long double) LONG_MAX )
+#define LO_L  ( -0.5L + (long double) LONG_MIN )
+#define HI_UL  ( 0.5L + (long double) ULONG_MAX )
+#define LO_UL ( -0.5L )
+#else
+#define HI_K   ( 0.5 + (double) LONG_MAX )
+#define LO_K  ( -0.5 + (double) LONG_MIN )
+#define HI_UK  ( 0.5 + (double) ULONG_MAX )
+#define LO_UK ( -0.5 )
+#define HI_L   ( 0.5 + (double) LONG_MAX )
+#define LO_L  ( -0.5 + (double) LONG_MIN )
+#define HI_UL  ( 0.5 + (double) ULONG_MAX )
+#define LO_UL ( -0.5 )
+#endif
+
+#define HI_I   ( 0.5 + (double) INT_MAX )
+#define LO_I  ( -0.5 + (double) INT_MIN )
+#define HI_UI  ( 0.5 + (double) UINT_MAX )
+#define LO_UI ( -0.5 )
+#define HI_S   ( 0.5f + (float) SHRT_MAX )
+#define LO_S  ( -0.5f + (float) SHRT_MIN )
+#define HI_US  ( 0.5f + (float) USHRT_MAX )
+#define LO_US ( -0.5f )
+#define HI_B   ( 0.5f + (float) SCHAR_MAX )
+#define LO_B  ( -0.5f + (float) SCHAR_MIN )
+#define HI_UB  ( 0.5f + (float) UCHAR_MAX )
+#define LO_UB ( -0.5f )
+
+/* This subsidiary macro tests for negative variance values. This
+   check is required only for signed data types. */
+#define CHECK_FOR_NEGATIVE_VARIANCE(Xtype) \
+   bad_var = bad_var || ( var < ( (Xtype) 0 ) );
+
+/* Expand the main macro above to generate a function for each
+   required signed data type, using the same floating point types for
+   intermediate results as the interpolation functions above. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_RESAMPLE_SEPARABLE(LD,long double,1,long double,1)
+MAKE_RESAMPLE_SEPARABLE(L,long int,0,long double,1)
+MAKE_RESAMPLE_SEPARABLE(K,INT_BIG,0,long double,1)
+#else
+MAKE_RESAMPLE_SEPARABLE(L,long int,0,double,1)
+MAKE_RESAMPLE_SEPARABLE(K,INT_BIG,0,double,1)
+#endif
+MAKE_RESAMPLE_SEPARABLE(D,double,1,double,1)
+MAKE_RESAMPLE_SEPARABLE(F,float,1,float,1)
+MAKE_RESAMPLE_SEPARABLE(I,int,0,double,1)
+MAKE_RESAMPLE_SEPARABLE(S,short int,0,float,1)
+MAKE_RESAMPLE_SEPARABLE(B,signed char,0,float,1)
+
+/* Re-define the macro for testing for negative variances to do
+   nothing. */
+#undef CHECK_FOR_NEGATIVE_VARIANCE
+#define CHECK_FOR_NEGATIVE_VARIANCE(Xtype)
+
+/* Expand the main macro above to generate a function for each
+   required unsigned data type. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_RESAMPLE_SEPARABLE(UL,unsigned long int,0,long double,0)
+MAKE_RESAMPLE_SEPARABLE(UK,UINT_BIG,0,long double,0)
+#else
+MAKE_RESAMPLE_SEPARABLE(UL,unsigned long int,0,double,0)
+MAKE_RESAMPLE_SEPARABLE(UK,UINT_BIG,0,double,0)
+#endif
+MAKE_RESAMPLE_SEPARABLE(UI,unsigned int,0,double,0)
+MAKE_RESAMPLE_SEPARABLE(US,unsigned short int,0,float,0)
+MAKE_RESAMPLE_SEPARABLE(UB,unsigned char,0,float,0)
+
+/* Undefine the macros used above. */
+#undef CHECK_FOR_NEGATIVE_VARIANCE
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+#undef HI_LD
+#undef LO_LD
+#endif
+#undef HI_D
+#undef LO_D
+#undef HI_F
+#undef LO_F
+#undef HI_L
+#undef LO_L
+#undef HI_UL
+#undef LO_UL
+#undef HI_K
+#undef LO_K
+#undef HI_UK
+#undef LO_UK
+#undef HI_I
+#undef LO_I
+#undef HI_UI
+#undef LO_UI
+#undef HI_S
+#undef LO_S
+#undef HI_US
+#undef LO_US
+#undef HI_B
+#undef LO_B
+#undef HI_UB
+#undef LO_UB
+#undef MAKE_RESAMPLE_SEPARABLE
+
+static void ResampleTask( void *data, int itask, int iworker, int *status ){
+/*
+*  Name:
+*     ResampleTask
+
+*  Purpose:
+*     Resample one of the blocks of pixels in a ResampleJob.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void ResampleTask( void *data, int itask, int iworker, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function is invoked by astRunTasks (see ResampleInParallel)
+*     to resample a single block of output pixels described by a
+*     ResampleJob. The number of bad output pixels in the block is
+*     stored in the job.
+
+*  Parameters:
+*     data
+*        Pointer to the ResampleJob structure.
+*     itask
+*        The index of the block to resample.
+*     iworker
+*        The index of the worker thread performing the task. This
+*        determines which Mapping is used.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Thread-specific data */
+   AstMapping *map;              /* Mapping for this worker */
+   BlockQueue *queue;            /* The blocks of output pixels */
+   ResampleJob *job;             /* Arguments shared by all blocks */
+   const double *fit;            /* Linear fit for the block */
+   const int *bounds;            /* Bounds of the block */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Get pointers to the job details. Record the original Mapping for use in
+   error messages issued by this thread. */
+   job = (ResampleJob *) data;
+   queue = job->queue;
+   unsimplified_mapping = job->unsimplified;
+
+/* Lock this worker's Mapping for use by the current thread. */
+   map = job->maps[ iworker ];
+   if( iworker > 0 ) astManageLock( map, AST__LOCK, 1, NULL );
+
+/* Resample the block, recording the number of bad pixels produced. */
+   bounds = queue->bounds + 2*queue->ndim*itask;
+   fit = ( queue->ifit[ itask ] >= 0 ) ?
+         queue->fits + queue->nfitval*queue->ifit[ itask ] : NULL;
+   job->nbad[ itask ] = ResampleSection( map, fit, job->ndim_in,
+                                         job->lbnd_in, job->ubnd_in,
+                                         job->in, job->in_var, job->type,
+                                         job->interp, job->finterp,
+                                         job->params, queue->factor[ itask ],
+                                         job->flags, job->badval_ptr,
+                                         job->ndim_out, job->lbnd_out,
+                                         job->ubnd_out, bounds,
+                                         bounds + queue->ndim, job->out,
+                                         job->out_var, status );
+
+/* Unlock the Mapping so that it can be used by other threads. */
+   if( iworker > 0 ) astManageLock( map, AST__UNLOCK, 1, NULL );
+}
+
+/*
+*++
+*  Name:
+c     astResampleTiled<X>
+f     AST_RESAMPLETILED<X>
+
+*  Purpose:
+*     Resample a region of a tiled data grid.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+c     #include "mapping.h"
+c     int64_t astResampleTiled<X>( AstMapping *this, int ndim_in,
+c                                  const int64_t lbnd_in[],
+c                                  const int64_t ubnd_in[],
+c                                  const int tile[], AstTileFun fetch,
+c                                  void *data, int ncache, int interp,
+c                                  void (* finterp)( void ),
+c                                  const double params[], int flags,
+c                                  double tol, int maxpix, <Xtype> badval,
+c                                  int ndim_out, const int64_t lbnd_out[],
+c                                  const int64_t ubnd_out[],
+c                                  const int64_t lbnd[],
+c                                  const int64_t ubnd[], <Xtype> out[],
+c                                  <Xtype> out_var[] );
+f     There is no Fortran interface to this function.
+
+*  Class Membership:
+*     Mapping function.
+
+*  Description:
+*     This is a set of functions that behave like astResample8<X>, except
+*     that the input grid is not supplied as an array held in memory.
+*     Instead, the input grid is divided into rectangular tiles of a
+*     given size, and a user-supplied function is called to obtain the
+*     values in each tile when they are needed. This allows grids that
+*     are too big to be held in memory (for instance, grids stored in a
+*     tiled file format or behind a network service) to be resampled.
+*
+*     The output region is divided into blocks that are small enough for
+*     the section of the input grid that feeds each block to be held in
+*     "ncache" tiles. The section needed by a block is estimated from a
+*     linear approximation to the inverse transformation where one is
+*     available (see astLinearApprox), or by mapping the block's
+*     bounding box otherwise, and is extended to allow for the width of
+*     the interpolation kernel. At most "ncache" tiles are held in
+*     memory at once, the least recently used tile being discarded when
+*     another is needed. Neighbouring blocks are processed in turn, so
+*     that tiles are usually re-used rather than fetched again.
+*
+*     The resampled values are the same as those that astResample8<X>
+*     would produce from the complete input grid, to within the
+*     positional accuracy given by "tol" (they are identical if "tol" is
+*     zero).
+
+*  Parameters:
+*     this
+*        Pointer to a Mapping, whose forward transformation will be
+*        used to transform the coordinates of pixels in the input grid
+*        into the coordinate system of the output grid. The inverse
+*        transformation must also be defined, since it is used to find
+*        the input tiles needed by each output block.
+*     ndim_in
+*        The number of dimensions in the input grid.
+*     lbnd_in
+*        Pointer to an array of integers, with "ndim_in" elements,
+*        containing the coordinates of the centre of the first pixel
+*        in the input grid along each dimension.
+*     ubnd_in
+*        Pointer to an array of integers, with "ndim_in" elements,
+*        containing the coordinates of the centre of the last pixel in
+*        the input grid along each dimension.
+*     tile
+*        Pointer to an array of integers, with "ndim_in" elements,
+*        giving the number of pixels along each edge of a tile. Tiles
+*        are anchored at the first pixel of the input grid. Tiles at the
+*        upper edges of the grid are truncated so that they do not
+*        extend beyond it.
+*     fetch
+*        Pointer to a function that will be called to obtain the values
+*        in a tile. It should have the following interface:
+*
+*           void fetch( void *data, int ndim, const int64_t tlbnd[],
+*                       const int64_t tubnd[], void *buf, void *buf_var,
+*                       int *status )
+*
+*        where "data" is the pointer given below, "ndim" equals
+*        "ndim_in", and "tlbnd" and "tubnd" hold the grid indices of the
+*        first and last pixels in the tile. The function should store
+*        the data values in the tile in the "buf" array, which has the
+*        same data type as the "out" array and should be filled in the
+*        usual "Fortran" order. If the AST__USEVAR flag is set, it should
+*        also store the corresponding variances in "buf_var" (which is
+*        NULL otherwise). Missing values should be flagged using
+*        "badval" if the AST__USEBAD flag is set. If the tile cannot be
+*        obtained, the function should report an error using astError
+*        and set "*status" to an error value, in which case no further
+*        tiles will be requested.
+*     data
+*        An arbitrary pointer that is passed unchanged to "fetch".
+*     ncache
+*        The maximum number of tiles to hold in memory at once. This
+*        must be at least one. Larger values allow larger output blocks
+*        and so fewer tile fetches. In addition to the cached tiles, a
+*        work array holding about "ncache" tiles' worth of input pixels
+*        is used while resampling each block.
+*     interp
+*        The sub-pixel interpolation scheme, as for astResample8<X>. The
+*        AST__UINTERP scheme cannot be used.
+*     finterp
+*        As for astResample8<X>.
+*     params
+*        As for astResample8<X>.
+*     flags
+*        As for astResample8<X>.
+*     tol
+*        As for astResample8<X>.
+*     maxpix
+*        As for astResample8<X>.
+*     badval
+*        As for astResample8<X>.
+*     ndim_out
+*        As for astResample8<X>.
+*     lbnd_out
+*        As for astResample8<X>.
+*     ubnd_out
+*        As for astResample8<X>.
+*     lbnd
+*        As for astResample8<X>.
+*     ubnd
+*        As for astResample8<X>.
+*     out
+*        As for astResample8<X>.
+*     out_var
+*        As for astResample8<X>.
+
+*  Returned Value:
+*     astResampleTiled<X>()
+*        The number of output pixels for which no valid resampled value
+*        could be obtained.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*     - An input grid held in a contiguous memory-mapped file does not
+*     need to be tiled, since the mapped array can be passed directly to
+*     astResample8<X>, which only reads the pixels it needs.
+
+*  Data Type Codes:
+*     To select the appropriate resampling function, you should
+*     replace <X> in the generic function name astResampleTiled<X> with
+*     a 1- or 2-character data type code, as for astResample8<X>.
+*--
+*/
+static int64_t ResampleTiled( AstMapping *this, int ndim_in,
+                              const int64_t lbnd_in[],
+                              const int64_t ubnd_in[], const int tile[],
+                              AstTileFun fetch, void *data, int ncache,
+                              DataType type, int interp,
+                              void (* finterp)( void ),
+                              const double params[], int flags, double tol,
+                              int maxpix, const void *badval_ptr,
+                              int ndim_out, const int64_t lbnd_out[],
+                              const int64_t ubnd_out[], const int64_t lbnd[],
+                              const int64_t ubnd[], void *out, void *out_var,
+                              int *status ) {
+/*
+*  Name:
+*     ResampleTiled
+
+*  Purpose:
+*     Resample a region of a tiled input grid.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int64_t ResampleTiled( AstMapping *this, int ndim_in,
+*                            const int64_t lbnd_in[],
+*                            const int64_t ubnd_in[], const int tile[],
+*                            AstTileFun fetch, void *data, int ncache,
+*                            DataType type, int interp,
+*                            void (* finterp)( void ),
+*                            const double params[], int flags, double tol,
+*                            int maxpix, const void *badval_ptr,
+*                            int ndim_out, const int64_t lbnd_out[],
+*                            const int64_t ubnd_out[], const int64_t lbnd[],
+*                            const int64_t ubnd[], void *out, void *out_var,
+*                            int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function implements astResampleTiled<X> for all data types.
+*     The output region is divided recursively into blocks, each of
+*     which is small enough for the section of the input grid that
+*     feeds it to be held in "ncache" tiles. The input tiles covering
+*     each such section are obtained through a bounded tile cache and
+*     copied into a contiguous work array, which is then resampled into
+*     the block using astResample8<X>. Blocks are processed depth-first,
+*     so neighbouring blocks tend to re-use the tiles already in the
+*     cache.
+
+*  Parameters:
+*     this
+*        Pointer to a Mapping.
+*     ndim_in
+*        The number of dimensions in the input grid.
+*     lbnd_in
+*        Pointer to an array of integers, with "ndim_in" elements,
+*        containing the coordinates of the centre of the first pixel
+*        in the input grid along each dimension.
+*     ubnd_in
+*        Pointer to an array of integers, with "ndim_in" elements,
+*        containing the coordinates of the centre of the last pixel in
+*        the input grid along each dimension.
+*     tile
+*        Pointer to an array of integers, with "ndim_in" elements,
+*        giving the number of pixels along each edge of a tile.
+*     fetch
+*        Pointer to the function used to obtain the values in a tile.
+*     data
+*        The pointer to pass to "fetch".
+*     ncache
+*        The maximum number of tiles to hold in memory at once.
+*     type
+*        A value taken from the "DataType" enum, which specifies the
+*        data type of the input and output arrays.
+*     interp
+*        A value selected from a set of pre-defined macros to identify
+*        which sub-pixel interpolation algorithm should be used. The
+*        AST__UINTERP scheme is not supported.
+*     finterp
+*        A pointer to a user-supplied 1-d kernel function, used if
+*        "interp" is AST__UKERN1.
+*     params
+*        Pointer to an optional array of parameters that may be passed
+*        to the interpolation algorithm, if required.
+*     flags
+*        The bitwise OR of a set of flag values which provide
+*        additional control over the resampling operation.
+*     tol
+*        The maximum permitted positional error in transforming output
+*        pixel positions into the input grid in order to resample
+*        it.
+*     maxpix
+*        A value which specifies the largest scale size on which to
+*        search for non-linearities in the Mapping supplied.
+*     badval_ptr
+*        Pointer to a value which has been used to flag missing data in
+*        the tiles and which is used to flag output pixels that cannot
+*        be assigned a value. The data type of this value should match
+*        "type".
+*     ndim_out
+*        The number of dimensions in the output grid.
+*     lbnd_out
+*        Pointer to an array of integers, with "ndim_out" elements,
+*        containing the coordinates of the centre of the first pixel
+*        in the output grid along each dimension.
+*     ubnd_out
+*        Pointer to an array of integers, with "ndim_out" elements,
+*        containing the coordinates of the centre of the last pixel in
+*        the output grid along each dimension.
+*     lbnd
+*        Pointer to an array of integers, with "ndim_out" elements,
+*        containing the coordinates of the first pixel in the section
+*        of the output data grid for which a value is required.
+*     ubnd
+*        Pointer to an array of integers, with "ndim_out" elements,
+*        containing the coordinates of the last pixel in the section
+*        of the output data grid for which a value is required.
+*     out
+*        Pointer to an array with the same data type as the
+*        "badval_ptr" value, into which the resampled data will be
+*        returned.
+*     out_var
+*        An optional pointer to an array with the same data type and
+*        size as the "out" array, into which variance estimates for
+*        the resampled values may be returned.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of output pixels for which no valid resampled value
+*     could be obtained.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   AstMapping *inv;              /* Inverse of the supplied Mapping */
+   TileCache *cache;             /* Cache of input tiles */
+   char *work;                   /* Contiguous input values for a block */
+   char *work_var;               /* Contiguous input variances for a block */
+   const double *kpar;           /* Interpolation parameters */
+   const double *par;            /* Kernel parameters (not used) */
+   double *dlbnd;                /* Lower bounds of block in output grid */
+   double *dubnd;                /* Upper bounds of block in output grid */
+   double *fit;                  /* Linear approximation to "inv" */
+   double lpar[ 1 ];             /* Local kernel parameter (not used) */
+   double nopar[ 2 ];            /* Parameters used if none supplied */
+   double budget;                /* Max number of input pixels per block */
+   double grad;                  /* Gradient of linear approximation */
+   double hi;                    /* Upper input bound on current axis */
+   double lo;                    /* Lower input bound on current axis */
+   double nin;                   /* Number of input pixels for block */
+   double tsize;                 /* Number of pixels in a tile */
+   int64_t *blbnd;               /* Lower bounds of current block */
+   int64_t *bubnd;               /* Upper bounds of current block */
+   int64_t *ilbnd;               /* Lower bounds of input box */
+   int64_t *iubnd;               /* Upper bounds of input box */
+   int64_t *stack;               /* Stack of blocks still to be done */
+   int64_t mid;                  /* Last pixel in first half of block */
+   int64_t nbig;                 /* Largest block dimension */
+   int64_t result;               /* Result value to return */
+   int64_t size;                 /* Block dimension */
+   int idim;                     /* Loop counter for input dimensions */
+   int isplit;                   /* Index of block dimension to split */
+   int jdim;                     /* Loop counter for output dimensions */
+   int linear;                   /* Was a linear approximation found? */
+   int margin;                   /* Extra input pixels on each edge */
+   int nstack;                   /* Number of blocks on the stack */
+   int usevar;                   /* Process variances? */
+   size_t elsize;                /* Size of one data value */
+   size_t nwork;                 /* Number of values in work arrays */
+   void (* kernel)( double, const double [], int, double *, int * );
+
+/* Initialise. */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Check that the Mapping has an inverse transformation (used to find
+   the input pixels needed by each block of output pixels) and that
+   the grid dimensionalities match. */
+   ValidateMapping( this, 0, 1, ndim_out, ndim_in, "astResampleTiled",
+                    status );
+
+/* Check the bounds of the input grid and output region, since these
+   are used below before astResample8<X> gets a chance to check them. */
+   for ( idim = 0; astOK && idim < ndim_in; idim++ ) {
+      if ( lbnd_in[ idim ] > ubnd_in[ idim ] ) {
+         astError( AST__GBDIN, "astResampleTiled(%s): Lower bound of "
+                   "input grid (%lld) exceeds corresponding upper bound "
+                   "(%lld).", status, astGetClass( this ),
+                   (long long int) lbnd_in[ idim ],
+                   (long long int) ubnd_in[ idim ] );
+         astError( AST__GBDIN, "Error in input dimension %d.", status,
+                   idim + 1 );
+      } else if ( tile[ idim ] < 1 ) {
+         astError( AST__BDPAR, "astResampleTiled(%s): Invalid tile size "
+                   "(%d) for input dimension %d.", status,
+                   astGetClass( this ), tile[ idim ], idim + 1 );
+      }
+   }
+   for ( jdim = 0; astOK && jdim < ndim_out; jdim++ ) {
+      if ( lbnd[ jdim ] > ubnd[ jdim ] ) {
+         astError( AST__GBDIN, "astResampleTiled(%s): Lower bound of "
+                   "output region (%lld) exceeds corresponding upper "
+                   "bound (%lld).", status, astGetClass( this ),
+                   (long long int) lbnd[ jdim ],
+                   (long long int) ubnd[ jdim ] );
+         astError( AST__GBDIN, "Error in output dimension %d.", status,
+                   jdim + 1 );
+      }
+   }
+   if ( astOK && ncache < 1 ) {
+      astError( AST__BDPAR, "astResampleTiled(%s): Invalid number of "
+                "cached tiles (%d).", status, astGetClass( this ), ncache );
+      astError( AST__BDPAR, "This value should be at least one.", status );
+   }
+
+/* Find how many pixels beyond the transformed edges of a block the
+   interpolation scheme may reach. One extra pixel is added to cover
+   rounding to the nearest pixel centre. If no parameters were supplied,
+   astResample8<X> will report any error, so just use zeros here. */
+   nopar[ 0 ] = 0.0;
+   nopar[ 1 ] = 0.0;
+   kpar = params ? params : nopar;
+   margin = 0;
+   if ( astOK ) {
+      switch ( interp ) {
+         case AST__NEAREST:
+         case AST__LINEAR:
+            margin = 2;
+            break;
+
+         case AST__GAUSS:
+         case AST__SINC:
+         case AST__SINCCOS:
+         case AST__SINCGAUSS:
+         case AST__SINCSINC:
+         case AST__SOMB:
+         case AST__SOMBCOS:
+            SetupKernel1( interp, kpar, &kernel, lpar, &par, &margin,
+                          status );
+            margin++;
+            break;
+
+         case AST__UKERN1:
+         case AST__BLOCKAVE:
+            margin = MaxI( 1, (int) floor( kpar[ 0 ] + 0.5 ), status ) + 1;
+            break;
+
+         default:
+            astError( AST__SISIN, "astResampleTiled(%s): Invalid "
+                      "sub-pixel interpolation scheme (%d) specified.",
+                      status, astGetClass( this ), interp );
+            if ( interp == AST__UINTERP ) {
+               astError( AST__SISIN, "The AST__UINTERP scheme cannot be "
+                         "used with a tiled input grid.", status );
+            }
+      }
+   }
+
+/* Find the size of each data value. */
+   elsize = 0;
+   switch ( type ) {
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+      case ( TYPE_LD ): elsize = sizeof( long double ); break;
+#endif
+      case ( TYPE_D ): elsize = sizeof( double ); break;
+      case ( TYPE_F ): elsize = sizeof( float ); break;
+      case ( TYPE_L ): elsize = sizeof( long int ); break;
+      case ( TYPE_UL ): elsize = sizeof( unsigned long int ); break;
+      case ( TYPE_K ): elsize = sizeof( INT_BIG ); break;
+      case ( TYPE_UK ): elsize = sizeof( UINT_BIG ); break;
+      case ( TYPE_I ): elsize = sizeof( int ); break;
+      case ( TYPE_UI ): elsize = sizeof( unsigned int ); break;
+      case ( TYPE_S ): elsize = sizeof( short int ); break;
+      case ( TYPE_US ): elsize = sizeof( unsigned short int ); break;
+      case ( TYPE_B ): elsize = sizeof( signed char ); break;
+      case ( TYPE_UB ): elsize = sizeof( unsigned char ); break;
+   }
+
+/* The section of the input grid needed by a block is limited to the
+   number of pixels held in "ncache" tiles. */
+   tsize = 1.0;
+   for ( idim = 0; astOK && idim < ndim_in; idim++ ) tsize *= tile[ idim ];
+   budget = tsize*ncache;
+
+/* Create the tile cache, and a copy of the Mapping that transforms
+   output grid positions into the input grid. */
+   usevar = ( flags & AST__USEVAR ) && out_var;
+   cache = TileCacheNew( ndim_in, lbnd_in, ubnd_in, tile, fetch, data,
+                         ncache, elsize, usevar, status );
+   inv = astCopy( this );
+   astInvert( inv );
+
+/* Allocate work arrays. The stack can hold the bounds of up to 64
+   blocks per output dimension, which is more than can be generated by
+   repeatedly halving a grid with 64-bit bounds. */
+   dlbnd = astMalloc( sizeof( double )*(size_t) ndim_out );
+   dubnd = astMalloc( sizeof( double )*(size_t) ndim_out );
+   fit = astMalloc( sizeof( double )*(size_t) ( ( ndim_out + 1 )*ndim_in ) );
+   ilbnd = astMalloc( sizeof( int64_t )*(size_t) ndim_in );
+   iubnd = astMalloc( sizeof( int64_t )*(size_t) ndim_in );
+   stack = astMalloc( sizeof( int64_t )*(size_t) ( 2*ndim_out*( 64*ndim_out + 1 ) ) );
+   work = NULL;
+   work_var = NULL;
+   nwork = 0;
+
+/* Put the whole output region on the stack. */
+   nstack = 0;
+   if ( astOK ) {
+      for ( jdim = 0; jdim < ndim_out; jdim++ ) {
+         stack[ jdim ] = lbnd[ jdim ];
+         stack[ ndim_out + jdim ] = ubnd[ jdim ];
+      }
+      nstack = 1;
+   }
+
+/* Loop until all blocks have been resampled. */
+   while ( astOK && nstack > 0 ) {
+      nstack--;
+      blbnd = stack + 2*ndim_out*nstack;
+      bubnd = blbnd + ndim_out;
+
+/* Find the box in output grid coordinates covered by the block, and
+   attempt to fit a linear approximation to the transformation from
+   this box into the input grid. */
+      for ( jdim = 0; jdim < ndim_out; jdim++ ) {
+         dlbnd[ jdim ] = (double) blbnd[ jdim ] - 0.5;
+         dubnd[ jdim ] = (double) bubnd[ jdim ] + 0.5;
+      }
+      linear = astLinearApprox( inv, dlbnd, dubnd, 1.0, fit );
+
+/* Find the bounds of the block's footprint on each input axis. If a
+   linear fit was found, use the extreme values of the fit over the
+   box, allowing for the fit tolerance. Otherwise, map the box. */
+      for ( idim = 0; astOK && idim < ndim_in; idim++ ) {
+         if ( linear ) {
+            lo = hi = fit[ idim ];
+            for ( jdim = 0; jdim < ndim_out; jdim++ ) {
+               grad = fit[ ndim_in + idim*ndim_out + jdim ];
+               if ( grad > 0.0 ) {
+                  lo += grad*dlbnd[ jdim ];
+                  hi += grad*dubnd[ jdim ];
+               } else {
+                  lo += grad*dubnd[ jdim ];
+                  hi += grad*dlbnd[ jdim ];
+               }
+            }
+            lo -= 1.0;
+            hi += 1.0;
+         } else {
+            astMapBox( inv, dlbnd, dubnd, 1, idim, &lo, &hi, NULL, NULL );
+         }
+
+/* Convert to the range of input pixels that may be needed, allowing
+   for the resampling tolerance and the interpolation kernel, and clip
+   it to the input grid. If the footprint is undefined, use the whole
+   axis. The box is always given at least one pixel so that output
+   pixels that fall outside the input grid can still be flagged as bad
+   by astResample8<X>. */
+         if ( lo == AST__BAD || hi == AST__BAD || !astISFINITE( lo ) ||
+              !astISFINITE( hi ) ) {
+            ilbnd[ idim ] = lbnd_in[ idim ];
+            iubnd[ idim ] = ubnd_in[ idim ];
+         } else {
+            lo = floor( lo + 0.5 - tol ) - margin;
+            hi = floor( hi + 0.5 + tol ) + margin;
+            if ( lo < (double) lbnd_in[ idim ] ) lo = lbnd_in[ idim ];
+            if ( lo > (double) ubnd_in[ idim ] ) lo = ubnd_in[ idim ];
+            if ( hi > (double) ubnd_in[ idim ] ) hi = ubnd_in[ idim ];
+            if ( hi < lo ) hi = lo;
+            ilbnd[ idim ] = (int64_t) lo;
+            iubnd[ idim ] = (int64_t) hi;
+         }
+      }
+
+/* Find the number of input pixels needed, and the largest dimension
+   of the block. */
+      nin = 1.0;
+      for ( idim = 0; idim < ndim_in; idim++ ) {
+         nin *= (double) ( iubnd[ idim ] - ilbnd[ idim ] + 1 );
+      }
+      nbig = 1;
+      isplit = 0;
+      for ( jdim = 0; jdim < ndim_out; jdim++ ) {
+         size = bubnd[ jdim ] - blbnd[ jdim ] + 1;
+         if ( size > nbig ) {
+            nbig = size;
+            isplit = jdim;
+         }
+      }
+
+/* If too many input pixels are needed, split the block in half along
+   its largest dimension, and push both halves onto the stack so that
+   the first half is processed next. */
+      if ( astOK && nin > budget && nbig > 1 ) {
+         mid = blbnd[ isplit ] + nbig/2 - 1;
+         for ( jdim = 0; jdim < 2*ndim_out; jdim++ ) {
+            blbnd[ 2*ndim_out + jdim ] = blbnd[ jdim ];
+         }
+         blbnd[ isplit ] = mid + 1;
+         blbnd[ 2*ndim_out + ndim_out + isplit ] = mid;
+         nstack += 2;
+
+/* Otherwise, copy the required input pixels into the work arrays,
+   extending them if necessary. */
+      } else if ( astOK ) {
+         if ( (size_t) nin > nwork ) {
+            nwork = (size_t) nin;
+            work = astGrow( work, nwork, elsize );
+            if ( usevar ) work_var = astGrow( work_var, nwork, elsize );
+         }
+         TileCacheFill( cache, ilbnd, iubnd, work, work_var, status );
+
+/* Resample the work arrays into the block, using the data type of
+   the supplied arrays. */
+#define CASE_TILED(X,Xtype) \
+            case ( TYPE_##X ): \
+               result += \
+               astResample8##X( this, ndim_in, ilbnd, iubnd, \
+                                (Xtype *) work, (Xtype *) work_var, \
+                                interp, finterp, params, flags, tol, \
+                                maxpix, *( (Xtype *) badval_ptr ), \
+                                ndim_out, lbnd_out, ubnd_out, blbnd, \
+                                bubnd, (Xtype *) out, (Xtype *) out_var ); \
+               break;
+
+         switch ( type ) {
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+            CASE_TILED(LD,long double)
+#endif
+            CASE_TILED(D,double)
+            CASE_TILED(F,float)
+            CASE_TILED(L,long int)
+            CASE_TILED(UL,unsigned long int)
+            CASE_TILED(K,INT_BIG)
+            CASE_TILED(UK,UINT_BIG)
+            CASE_TILED(I,int)
+            CASE_TILED(UI,unsigned int)
+            CASE_TILED(S,short int)
+            CASE_TILED(US,unsigned short int)
+            CASE_TILED(B,signed char)
+            CASE_TILED(UB,unsigned char)
+         }
+#undef CASE_TILED
+      }
+   }
+
+/* Free resources. */
+   cache = TileCacheFree( cache, status );
+   inv = astAnnul( inv );
+   dlbnd = astFree( dlbnd );
+   dubnd = astFree( dubnd );
+   fit = astFree( fit );
+   ilbnd = astFree( ilbnd );
+   iubnd = astFree( iubnd );
+   stack = astFree( stack );
+   work = astFree( work );
+   work_var = astFree( work_var );
+
+/* If an error occurred, clear the returned result. */
+   if ( !astOK ) result = 0;
+
+/* Return the result. */
+   return result;
+}
+
+static int ResampleWeights( AstMapping *this, int ndim_in,
+                            const int lbnd_in[], const int ubnd_in[],
+                            int interp, const double params[], double tol,
+                            int maxpix, int ndim_out, const int lbnd_out[],
+                            const int ubnd_out[], const int lbnd[],
+                            const int ubnd[], int **outpix, int **centre,
+                            int **start, int **inpix, double **weight,
+                            int *status ) {
+/*
+*+
+*  Name:
+*     astResampleWeights
+
+*  Purpose:
+*     Find the interpolation weights used to resample a data grid.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int astResampleWeights( AstMapping *this, int ndim_in,
+*                             const int lbnd_in[], const int ubnd_in[],
+*                             int interp, const double params[], double tol,
+*                             int maxpix, int ndim_out, const int lbnd_out[],
+*                             const int ubnd_out[], const int lbnd[],
+*                             const int ubnd[], int **outpix, int **centre,
+*                             int **start, int **inpix, double **weight )
+
+*  Class Membership:
+*     Mapping method.
+
+*  Description:
+*     This function finds the weights that astResample<X> would apply to
+*     the input pixels when forming each output pixel value in a given
+*     section of an output grid, using a given Mapping and sub-pixel
+*     interpolation scheme. The weights depend only on the geometry and
+*     not on the data values, so they may be stored (e.g. within a
+*     ResamplePlan) and used to resample any number of data arrays
+*     without needing to transform any further coordinates or evaluate
+*     any further interpolation kernels.
+*
+*     The weights are returned as a sparse matrix in "compressed row"
+*     form, with one row for each pixel in the output section (taken in
+*     the usual order, with the first output dimension varying most
+*     rapidly).
+
+*  Parameters:
+*     this
+*        Pointer to a Mapping, whose inverse transformation will be
+*        used to transform the coordinates of pixels in the output
+*        grid into the coordinate system of the input grid.
+*     ndim_in
+*        The number of dimensions in the input grid. This should be at
+*        least one and should match the Nin attribute of the Mapping.
+*     lbnd_in
+*        Pointer to an array of integers, with "ndim_in" elements,
+*        containing the coordinates of the centre of the first pixel
+*        in the input grid along each dimension.
+*     ubnd_in
+*        Pointer to an array of integers, with "ndim_in" elements,
+*        containing the coordinates of the centre of the last pixel in
+*        the input grid along each dimension.
+*     interp
+*        The sub-pixel interpolation scheme to use. This may be any of
+*        the schemes supported by astResample<X> except for AST__UKERN1,
+*        AST__UINTERP and AST__BLOCKAVE.
+*     params
+*        Pointer to an optional array of parameters that may be passed
+*        to the interpolation algorithm, as for astResample<X>.
+*     tol
+*        The maximum tolerable geometrical distortion which may be
+*        introduced as a result of approximating non-linear Mappings
+*        by a set of piece-wise linear transformations (in input grid
+*        pixels), as for astResample<X>.
+*     maxpix
+*        A value which specifies an initial scale size (in pixels) for
+*        the adaptive algorithm which approximates non-linear Mappings
+*        with piece-wise linear transformations, as for astResample<X>.
+*     ndim_out
+*        The number of dimensions in the output grid. This should be
+*        at least one and should match the Nout attribute of the
+*        Mapping.
+*     lbnd_out
+*        Pointer to an array of integers, with "ndim_out" elements,
+*        containing the coordinates of the centre of the first pixel
+*        in the output grid along each dimension.
+*     ubnd_out
+*        Pointer to an array of integers, with "ndim_out" elements,
+*        containing the coordinates of the centre of the last pixel in
+*        the output grid along each dimension.
+*     lbnd
+*        Pointer to an array of integers, with "ndim_out" elements,
+*        containing the coordinates of the first pixel in the section
+*        of the output grid for which weights are required.
+*     ubnd
+*        Pointer to an array of integers, with "ndim_out" elements,
+*        containing the coordinates of the last pixel in the section
+*        of the output grid for which weights are required.
+*     outpix
+*        Address at which to return a pointer to a newly allocated
+*        array holding the offset (in pixels) of each pixel in the
+*        output section from the start of the output grid.
+*     centre
+*        Address at which to return a pointer to a newly allocated
+*        array holding the offset of the input pixel that contains
+*        each output position, from the start of the input grid. A
+*        value of -1 indicates that the output position falls outside
+*        the input grid (or could not be transformed), in which case
+*        the output pixel will always be bad.
+*     start
+*        Address at which to return a pointer to a newly allocated
+*        array holding the index of the first weight for each output
+*        pixel within the "inpix" and "weight" arrays. This array has
+*        one more element than the number of output pixels, the final
+*        element holding the total number of weights.
+*     inpix
+*        Address at which to return a pointer to a newly allocated
+*        array holding the offset of the input pixel to which each
+*        weight applies, from the start of the input grid.
+*     weight
+*        Address at which to return a pointer to a newly allocated
+*        array holding the weights.
+
+*  Returned Value:
+*     The number of pixels in the output section (i.e. the number of
+*     elements in the "outpix" and "centre" arrays).
+
+*  Notes:
+*     - The weights returned for each output pixel are those evaluated
+*     by astResample<X> before normalisation. Each output pixel value
+*     is formed by astResample<X> as the weighted mean of the values of
+*     the good input pixels to which it refers.
+*     - The returned arrays should be freed using astFree when no
+*     longer needed.
+*     - A value of zero will be returned, and NULL pointers will be
+*     returned for all the arrays, if this function is invoked with the
+*     global error status set, or if it should fail for any reason.
+*-
+*/
+
+/* Local Constants: */
+   const int mxpoint = 256 * 1024; /* Maximum number of points to transform
+                                      at once */
+
+/* Local Variables: */
+   const double *par;            /* Pointer to kernel parameter array */
+   const double *table;          /* Tabulated kernel values */
+   double *coords;               /* Input grid coordinates of output points */
+   double *kval;                 /* Contributing weights on each axis */
+   double *wtprod;               /* Accumulated weight products */
+   double frac;                  /* Fractional weight for linear scheme */
+   double lpar[ 1 ];             /* Local kernel parameter array */
+   double tpos;                  /* Position within kernel table */
+   double tscale;                /* Kernel table elements per unit offset */
+   double x;                     /* Input grid coordinate value */
+   int *dim;                     /* Output pixel indices */
+   int *kidx;                    /* Current contributing pixel on each axis */
+   int *knum;                    /* Number of contributing pixels on each axis */
+   int *koff;                    /* Contributing pixel offsets on each axis */
+   int *offprod;                 /* Accumulated input pixel offsets */
+   int *slab_lbnd;               /* Lower bounds of slab of output section */
+   int *slab_ubnd;               /* Upper bounds of slab of output section */
+   int *stride_in;               /* Input grid strides */
+   int *stride_out;              /* Output grid strides */
+   int cen;                      /* Offset of input pixel containing point */
+   int hi;                       /* Highest contributing pixel index */
+   int i;                        /* Contributing pixel index */
+   int idim;                     /* Loop counter for dimensions */
+   int ipix;                     /* Index of current output pixel */
+   int ix;                       /* Pixel index on input axis */
+   int lo;                       /* Lowest contributing pixel index */
+   int mxdim;                    /* Largest input grid dimension */
+   int nax;                      /* Max. contributing pixels on one axis */
+   int nbad;                     /* Output position unusable? */
+   int nentry;                   /* Number of weights for current point */
+   int neighb;                   /* Number of neighbouring pixels */
+   int nin;                      /* Number of Mapping input coordinates */
+   int nout;                     /* Number of Mapping output coordinates */
+   int npix;                     /* Number of pixels in output section */
+   int nplane;                   /* Number of pixels in one slab row */
+   int npoint;                   /* Number of points in the current slab */
+   int nrow;                     /* Number of rows in each slab */
+   int nwt;                      /* Number of weights stored so far */
+   int off_out;                  /* Offset of current output pixel */
+   int point;                    /* Index of current point within slab */
+   int row;                      /* Index of first row in current slab */
+   int s;                        /* Temporary variable for strides */
+   int tidx;                     /* Index of kernel table element */
+   int64_t mpix;                 /* Number of pixels for testing */
+   void (* kernel)( double, const double [], int, double *, int * );
+
+/* Initialise. */
+   *outpix = NULL;
+   *centre = NULL;
+   *start = NULL;
+   *inpix = NULL;
+   *weight = NULL;
+   npix = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return npix;
+
+/* Obtain values for the Nin and Nout attributes of the Mapping. */
+   nin = astGetNin( this );
+   nout = astGetNout( this );
+
+/* If OK, check that the numbers of input and output grid dimensions
+   match the Mapping and are at least 1. */
+   if ( astOK && ( ( ndim_in != nin ) || ( ndim_in < 1 ) ) ) {
+      astError( AST__NGDIN, "astResampleWeights(%s): Bad number of input "
+                "grid dimensions (%d).", status, astGetClass( this ),
+                ndim_in );
+      if ( ndim_in != nin ) {
+         astError( AST__NGDIN, "The %s given requires %d coordinate value%s "
+                   "to specify an input position.", status,
+                   astGetClass( this ), nin, ( nin == 1 ) ? "" : "s" );
+      }
+   }
+   if ( astOK && ( ( ndim_out != nout ) || ( ndim_out < 1 ) ) ) {
+      astError( AST__NGDIN, "astResampleWeights(%s): Bad number of output "
+                "grid dimensions (%d).", status, astGetClass( this ),
+                ndim_out );
+      if ( ndim_out != nout ) {
+         astError( AST__NGDIN, "The %s given generates %s%d coordinate "
+                   "value%s for each output position.", status,
+                   astGetClass( this ), ( nout < ndim_out ) ? "only " : "",
+                   nout, ( nout == 1 ) ? "" : "s" );
+      }
+   }
+
+/* Check that the bounds of the input grid are consistent, and find the
+   largest input dimension. */
+   mpix = 1;
+   mxdim = 1;
+   if ( astOK ) {
+      for ( idim = 0; idim < ndim_in; idim++ ) {
+         if ( lbnd_in[ idim ] > ubnd_in[ idim ] ) {
+            astError( AST__GBDIN, "astResampleWeights(%s): Lower bound of "
+                      "input grid (%d) exceeds corresponding upper bound "
+                      "(%d).", status, astGetClass( this ),
+                      lbnd_in[ idim ], ubnd_in[ idim ] );
+            astError( AST__GBDIN, "Error in input dimension %d.", status,
+                      idim + 1 );
+            break;
+         } else {
+            mpix *= ubnd_in[ idim ] - lbnd_in[ idim ] + 1;
+            mxdim = MaxI( mxdim, ubnd_in[ idim ] - lbnd_in[ idim ] + 1,
+                          status );
+         }
+      }
+   }
+   if ( astOK && (int) mpix != mpix ) {
+      astError( AST__EXSPIX, "astResampleWeights(%s): Supplied input grid "
+                "contains too many pixels (%zu): must be fewer than %d.",
+                status, astGetClass( this ), mpix, INT_MAX );
+   }
+
+/* Check the positional accuracy tolerance and initial scale size. */
+   if ( astOK && ( tol < 0.0 ) ) {
+      astError( AST__PATIN, "astResampleWeights(%s): Invalid positional "
+                "accuracy tolerance (%.*g pixel).", status,
+                astGetClass( this ), DBL_DIG, tol );
+      astError( AST__PATIN, "This value should not be less than zero." , status);
+   }
+   if ( astOK && ( maxpix < 0 ) ) {
+      astError( AST__SSPIN, "astResampleWeights(%s): Invalid initial scale "
+                "size in pixels (%d).", status, astGetClass( this ), maxpix );
+      astError( AST__SSPIN, "This value should not be less than zero." , status);
+   }
+
+/* Check the bounds of the output grid. */
+   mpix = 1;
+   if ( astOK ) {
+      for ( idim = 0; idim < ndim_out; idim++ ) {
+         if ( lbnd_out[ idim ] > ubnd_out[ idim ] ) {
+            astError( AST__GBDIN, "astResampleWeights(%s): Lower bound of "
+                      "output grid (%d) exceeds corresponding upper bound "
+                      "(%d).", status, astGetClass( this ),
+                      lbnd_out[ idim ], ubnd_out[ idim ] );
+            astError( AST__GBDIN, "Error in output dimension %d.", status,
+                      idim + 1 );
+            break;
+         } else {
+            mpix *= ubnd_out[ idim ] - lbnd_out[ idim ] + 1;
+         }
+      }
+   }
+   if ( astOK && (int) mpix != mpix ) {
+      astError( AST__EXSPIX, "astResampleWeights(%s): Supplied output grid "
+                "contains too many pixels (%zu): must be fewer than %d.",
+                status, astGetClass( this ), mpix, INT_MAX );
+   }
+
+/* Check the bounds of the output section, and that it lies wholly
+   within the output grid. */
+   mpix = 1;
+   if ( astOK ) {
+      for ( idim = 0; idim < ndim_out; idim++ ) {
+         if ( lbnd[ idim ] > ubnd[ idim ] ) {
+            astError( AST__GBDIN, "astResampleWeights(%s): Lower bound of "
+                      "output region (%d) exceeds corresponding upper "
+                      "bound (%d).", status, astGetClass( this ),
+                      lbnd[ idim ], ubnd[ idim ] );
+         } else if ( lbnd[ idim ] < lbnd_out[ idim ] ) {
+            astError( AST__GBDIN, "astResampleWeights(%s): Lower bound of "
+                      "output region (%d) is less than corresponding "
+                      "bound of output grid (%d).", status,
+                      astGetClass( this ), lbnd[ idim ], lbnd_out[ idim ] );
+         } else if ( ubnd[ idim ] > ubnd_out[ idim ] ) {
+            astError( AST__GBDIN, "astResampleWeights(%s): Upper bound of "
+                      "output region (%d) exceeds corresponding "
+                      "bound of output grid (%d).", status,
+                      astGetClass( this ), ubnd[ idim ], ubnd_out[ idim ] );
+         } else {
+            mpix *= ubnd[ idim ] - lbnd[ idim ] + 1;
+         }
+         if ( !astOK ) {
+            astError( AST__GBDIN, "Error in output dimension %d.", status,
+                      idim + 1 );
+            break;
+         }
+      }
+   }
+   if ( astOK && (int) mpix != mpix ) {
+      astError( AST__EXSPIX, "astResampleWeights(%s): Supplied output "
+                "region contains too many pixels (%zu): must be fewer "
+                "than %d.", status, astGetClass( this ), mpix, INT_MAX );
+   }
+
+/* Report an error if the inverse transformation of the Mapping is not
+   defined. */
+   if ( astOK && !astGetTranInverse( this ) ) {
+      astError( AST__TRNND, "astResampleWeights(%s): An inverse coordinate "
+                "transformation is not defined by the %s supplied.", status,
+                astGetClass( this ), astGetClass( this ) );
+   }
+
+/* Find the maximum number of input pixels that can contribute to an
+   output pixel along each input axis, and get a pointer to the kernel
+   function if required. Only schemes that use fixed weights (i.e.
+   that do not depend on user-supplied functions, and that form each
+   output value as a weighted mean of the input pixel values) can be
+   used. */
+   kernel = NULL;
+   table = NULL;
+   par = NULL;
+   neighb = 0;
+   nax = 0;
+   if ( astOK ) {
+      switch ( interp ) {
+         case AST__NEAREST:
+            nax = 1;
+            break;
+
+         case AST__LINEAR:
+         case 0:
+            nax = 2;
+            break;
+
+         case AST__GAUSS:
+         case AST__SINC:
+         case AST__SINCCOS:
+         case AST__SINCGAUSS:
+         case AST__SINCSINC:
+         case AST__SOMB:
+         case AST__SOMBCOS:
+            SetupKernel1( interp, params, &kernel, lpar, &par, &neighb,
+                          status );
+            table = KernelTable( kernel, par, neighb, &tscale, status );
+            nax = MinI( 2*neighb, mxdim, status );
+            break;
+
+         default:
+            astError( AST__SISIN, "astResampleWeights(%s): Invalid "
+                      "sub-pixel interpolation scheme (%d) specified. "
+                      "Only schemes that use a fixed set of weights may "
+                      "be used (not AST__BLOCKAVE, AST__UINTERP or "
+                      "AST__UKERN1).", status, astGetClass( this ), interp );
+      }
+   }
+
+/* Get the number of pixels in the output section, and the number of
+   rows (along the last output axis) that are transformed together in
+   each slab. */
+   if ( astOK ) {
+      npix = (int) mpix;
+      nplane = npix/( ubnd[ ndim_out - 1 ] - lbnd[ ndim_out - 1 ] + 1 );
+      nrow = MaxI( 1, mxpoint/nplane, status );
+   } else {
+      nplane = 0;
+      nrow = 0;
+   }
+
+/* Allocate the returned arrays, and the workspace. */
+   *outpix = astMalloc( sizeof( int )*(size_t) npix );
+   *centre = astMalloc( sizeof( int )*(size_t) npix );
+   *start = astMalloc( sizeof( int )*(size_t) ( npix + 1 ) );
+   coords = astMalloc( sizeof( double )*(size_t) ( ndim_in*nplane*nrow ) );
+   dim = astMalloc( sizeof( int )*(size_t) ndim_out );
+   slab_lbnd = astStore( NULL, lbnd, sizeof( int )*(size_t) ndim_out );
+   slab_ubnd = astStore( NULL, ubnd, sizeof( int )*(size_t) ndim_out );
+   stride_in = astMalloc( sizeof( int )*(size_t) ndim_in );
+   stride_out = astMalloc( sizeof( int )*(size_t) ndim_out );
+   kval = astMalloc( sizeof( double )*(size_t) ( ndim_in*nax ) );
+   koff = astMalloc( sizeof( int )*(size_t) ( ndim_in*nax ) );
+   knum = astMalloc( sizeof( int )*(size_t) ndim_in );
+   kidx = astMalloc( sizeof( int )*(size_t) ndim_in );
+   wtprod = astMalloc( sizeof( double )*(size_t) ndim_in );
+   offprod = astMalloc( sizeof( int )*(size_t) ndim_in );
+   nwt = 0;
+
+   if ( astOK ) {
+
+/* Calculate the stride along each dimension of the input and output
+   grids. */
+      for ( s = 1, idim = 0; idim < ndim_in; idim++ ) {
+         stride_in[ idim ] = s;
+         s *= ubnd_in[ idim ] - lbnd_in[ idim ] + 1;
+      }
+      for ( s = 1, idim = 0; idim < ndim_out; idim++ ) {
+         stride_out[ idim ] = s;
+         s *= ubnd_out[ idim ] - lbnd_out[ idim ] + 1;
+      }
+
+/* Loop round each slab of the output section. */
+      ipix = 0;
+      for ( row = lbnd[ ndim_out - 1 ]; row <= ubnd[ ndim_out - 1 ] && astOK;
+            row += nrow ) {
+         slab_lbnd[ ndim_out - 1 ] = row;
+         slab_ubnd[ ndim_out - 1 ] = MinI( row + nrow - 1,
+                                           ubnd[ ndim_out - 1 ], status );
+         npoint = nplane*( slab_ubnd[ ndim_out - 1 ] - row + 1 );
+
+/* Transform the centre of every output pixel in the slab into the
+   input grid, using the inverse transformation. */
+         astTranGrid( this, ndim_out, slab_lbnd, slab_ubnd, tol, maxpix, 0,
+                      ndim_in, npoint, coords );
+
+/* Initialise the indices and offset of the first output pixel. */
+         off_out = 0;
+         for ( idim = 0; idim < ndim_out; idim++ ) {
+            dim[ idim ] = slab_lbnd[ idim ];
+            off_out += ( dim[ idim ] - lbnd_out[ idim ] )*stride_out[ idim ];
+         }
+
+/* Loop round every point in the slab. */
+         for ( point = 0; point < npoint && astOK; point++, ipix++ ) {
+            ( *outpix )[ ipix ] = off_out;
+            ( *start )[ ipix ] = nwt;
+
+/* Find the input pixels that contribute to the current output pixel
+   along each input axis, with their weights. */
+            cen = 0;
+            nbad = 0;
+            nentry = 1;
+            for ( idim = 0; idim < ndim_in; idim++ ) {
+               x = coords[ idim*npoint + point ];
+
+/* The output pixel will be bad if the position lies outside the
+   input grid, or is bad. */
+               if ( x == AST__BAD ||
+                    x < (double) lbnd_in[ idim ] - 0.5 ||
+                    x >= (double) ubnd_in[ idim ] + 0.5 ) {
+                  nbad = 1;
+                  break;
+               }
+
+/* Accumulate the offset of the input pixel that contains the position. */
+               cen += stride_in[ idim ]*
+                      ( (int) floor( x + 0.5 ) - lbnd_in[ idim ] );
+
+/* Nearest pixel: a single pixel with unit weight. */
+               knum[ idim ] = 0;
+               if ( interp == AST__NEAREST ) {
+                  koff[ idim*nax ] = stride_in[ idim ]*
+                                     ( (int) floor( x + 0.5 ) - lbnd_in[ idim ] );
+                  kval[ idim*nax ] = 1.0;
+                  knum[ idim ] = 1;
+
+/* Kernel: all pixels within "neighb" pixels of the position, weighted
+   by the kernel function. */
+               } else if ( kernel ) {
+                  ix = (int) floor( x );
+                  lo = MaxI( ix - neighb + 1, lbnd_in[ idim ], status );
+                  hi = MinI( ix + neighb, ubnd_in[ idim ], status );
+                  for ( i = lo; i <= hi; i++ ) {
+                     koff[ idim*nax + knum[ idim ] ] =
+                                    stride_in[ idim ]*( i - lbnd_in[ idim ] );
+                     if ( table ) {
+                        TABLE_KERNEL( (double) i - x,
+                                      kval[ idim*nax + knum[ idim ] ] );
+                     } else {
+                        ( *kernel )( (double) i - x, par, 0,
+                                     kval + idim*nax + knum[ idim ], status );
+                     }
+                     knum[ idim ]++;
+                  }
+
+/* Linear: the two adjacent pixels, if they lie within the grid. */
+               } else {
+                  lo = (int) floor( x );
+                  frac = (double) ( lo + 1 ) - x;
+                  if ( lo >= lbnd_in[ idim ] ) {
+                     koff[ idim*nax ] = stride_in[ idim ]*( lo - lbnd_in[ idim ] );
+                     kval[ idim*nax ] = frac;
+                     knum[ idim ] = 1;
+                  }
+                  if ( lo + 1 <= ubnd_in[ idim ] ) {
+                     koff[ idim*nax + knum[ idim ] ] =
+                               stride_in[ idim ]*( lo + 1 - lbnd_in[ idim ] );
+                     kval[ idim*nax + knum[ idim ] ] = 1.0 - frac;
+                     knum[ idim ]++;
+                  }
+               }
+               nentry *= knum[ idim ];
+            }
+
+/* If the output pixel can be formed, store the offset of the input
+   pixel containing it, and extend the weight arrays to hold its
+   weights. */
+            if ( nbad ) {
+               ( *centre )[ ipix ] = -1;
+               nentry = 0;
+
+            } else {
+               ( *centre )[ ipix ] = cen;
+               if ( nentry > INT_MAX - nwt ) {
+                  astError( AST__EXSPIX, "astResampleWeights(%s): Too many "
+                            "interpolation weights are required (must be "
+                            "fewer than %d).", status, astGetClass( this ),
+                            INT_MAX );
+                  break;
+               }
+               *inpix = astGrow( *inpix, nwt + nentry, sizeof( int ) );
+               *weight = astGrow( *weight, nwt + nentry, sizeof( double ) );
+               if ( !astOK ) break;
+
+/* Form the weight of every combination of contributing pixels as the
+   product of the weights on each axis, with the first input axis
+   varying most rapidly. */
+               for ( idim = 0; idim < ndim_in; idim++ ) kidx[ idim ] = 0;
+               for ( i = 0; i < nentry; i++ ) {
+                  for ( idim = ndim_in - 1; idim >= 0; idim-- ) {
+                     wtprod[ idim ] = kval[ idim*nax + kidx[ idim ] ];
+                     offprod[ idim ] = koff[ idim*nax + kidx[ idim ] ];
+                     if ( idim < ndim_in - 1 ) {
+                        wtprod[ idim ] *= wtprod[ idim + 1 ];
+                        offprod[ idim ] += offprod[ idim + 1 ];
+                     }
+                  }
+                  ( *inpix )[ nwt ] = offprod[ 0 ];
+                  ( *weight )[ nwt++ ] = wtprod[ 0 ];
+
+/* Move on to the next combination. */
+                  for ( idim = 0; idim < ndim_in; idim++ ) {
+                     if ( ++kidx[ idim ] < knum[ idim ] ) break;
+                     kidx[ idim ] = 0;
+                  }
+               }
+            }
+
+/* Move on to the next output pixel, updating its indices and offset. */
+            for ( idim = 0; idim < ndim_out; idim++ ) {
+               if ( dim[ idim ] < slab_ubnd[ idim ] ) {
+                  dim[ idim ]++;
+                  off_out += stride_out[ idim ];
+                  break;
+               }
+               off_out -= ( dim[ idim ] - slab_lbnd[ idim ] )*stride_out[ idim ];
+               dim[ idim ] = slab_lbnd[ idim ];
+            }
+         }
+      }
+
+/* Store the total number of weights. */
+      if ( astOK ) ( *start )[ npix ] = nwt;
    }
 
-/* Annul the PointSet used to hold input coordinates. */
-   pset_in = astAnnul( pset_in );
-
 /* Free the workspace. */
-   offset = astFree( offset );
-   stride = astFree( stride );
-
-/* If an error occurred, clear the returned value. */
-   if ( !astOK ) result = 0;
+   coords = astFree( coords );
+   dim = astFree( dim );
+   slab_lbnd = astFree( slab_lbnd );
+   slab_ubnd = astFree( slab_ubnd );
+   stride_in = astFree( stride_in );
+   stride_out = astFree( stride_out );
+   kval = astFree( kval );
+   koff = astFree( koff );
+   knum = astFree( knum );
+   kidx = astFree( kidx );
+   wtprod = astFree( wtprod );
+   offprod = astFree( offprod );
+
+/* If an error occurred, free the returned arrays. */
+   if ( !astOK ) {
+      *outpix = astFree( *outpix );
+      *centre = astFree( *centre );
+      *start = astFree( *start );
+      *inpix = astFree( *inpix );
+      *weight = astFree( *weight );
+      npix = 0;
+   }
 
-/* Return the result. */
-   return result;
+/* Return the number of output pixels. */
+   return npix;
 }
 
-static int ResampleWithBlocking( AstMapping *this, const double *linear_fit,
-                                 int ndim_in,
-                                 const int *lbnd_in, const int *ubnd_in,
-                                 const void *in, const void *in_var,
-                                 DataType type, int interp, void (* finterp)( void ),
-                                 const double *params, int flags,
-                                 const void *badval_ptr, int ndim_out,
-                                 const int *lbnd_out, const int *ubnd_out,
-                                 const int *lbnd, const int *ubnd,
-                                 void *out, void *out_var, int *status ) {
+static int64_t ResampleWithBlocking( AstMapping *this, const double *linear_fit,
+                                     int ndim_in,
+                                     const int *lbnd_in, const int *ubnd_in,
+                                     const void *in, const void *in_var,
+                                     DataType type, int interp, void (* finterp)( void ),
+                                     const double *params, int flags,
+                                     const void *badval_ptr, int ndim_out,
+                                     const int *lbnd_out, const int *ubnd_out,
+                                     const int *lbnd, const int *ubnd,
+                                     void *out, void *out_var, BlockQueue *queue,
+                                     int *status ) {
 /*
 *  Name:
 *     ResampleWithBlocking
@@ -15688,16 +19071,17 @@ static int ResampleWithBlocking( AstMapping *this, const double *linear_fit,
 
 *  Synopsis:
 *     #include "mapping.h"
-*     int ResampleWithBlocking( AstMapping *this, const double *linear_fit,
-*                               int ndim_in,
-*                               const int *lbnd_in, const int *ubnd_in,
-*                               const void *in, const void *in_var,
-*                               DataType type, int interp, void (* finterp)( void ),
-*                               const double *params, int flags,
-*                               const void *badval_ptr, int ndim_out,
-*                               const int *lbnd_out, const int *ubnd_out,
-*                               const int *lbnd, const int *ubnd,
-*                               void *out, void *out_var, int *status )
+*     int64_t ResampleWithBlocking( AstMapping *this, const double *linear_fit,
+*                                   int ndim_in,
+*                                   const int *lbnd_in, const int *ubnd_in,
+*                                   const void *in, const void *in_var,
+*                                   DataType type, int interp, void (* finterp)( void ),
+*                                   const double *params, int flags,
+*                                   const void *badval_ptr, int ndim_out,
+*                                   const int *lbnd_out, const int *ubnd_out,
+*                                   const int *lbnd, const int *ubnd,
+*                                   void *out, void *out_var, BlockQueue *queue,
+*                                   int *status )
 
 *  Class Membership:
 *     Mapping member function.
@@ -15858,6 +19242,11 @@ static int ResampleWithBlocking( AstMapping *this, const double *linear_fit,
 *
 *        If no output variance estimates are required, a NULL pointer
 *        should be given.
+*     queue
+*        If not NULL, each block of output pixels is appended to the
+*        supplied queue (together with the linear fit and flux
+*        conservation factor to use with it) instead of being resampled.
+*        The returned value is then always zero.
 *     status
 *        Pointer to the inherited status variable.
 
@@ -15885,10 +19274,11 @@ static int ResampleWithBlocking( AstMapping *this, const double *linear_fit,
    int done;                     /* All blocks resampled? */
    int hilim;                    /* Upper limit on maximum block dimension */
    int idim;                     /* Loop counter for dimensions */
+   int ifit;                     /* Index of linear fit within queue */
    int lolim;                    /* Lower limit on maximum block dimension */
    int mxdim_block;              /* Maximum block dimension */
-   int npix;                     /* Number of pixels in block */
-   int result;                   /* Result value to return */
+   int64_t npix;                 /* Number of pixels in block */
+   int64_t result;               /* Result value to return */
 
 /* Initialise. */
    result = 0;
@@ -15978,21 +19368,30 @@ static int ResampleWithBlocking( AstMapping *this, const double *linear_fit,
       factor = 1.0;
    }
 
+/* If the blocks are to be queued, store a copy of the linear fit in the
+   queue. */
+   ifit = queue ? QueueFit( queue, linear_fit, status ) : -1;
+
 /* Resample each block of output pixels. */
 /* ------------------------------------- */
 /* Loop to generate the extent of each block of output pixels and to
-   resample them. */
+   resample them (or queue them for later resampling). */
       done = 0;
       while ( !done && astOK ) {
 
 /* Resample the current block, accumulating the sum of bad pixels
    produced. */
-         result += ResampleSection( this, linear_fit,
-                                    ndim_in, lbnd_in, ubnd_in,
-                                    in, in_var, type, interp, finterp, params,
-                                    factor, flags, badval_ptr,
-                                    ndim_out, lbnd_out, ubnd_out,
-                                    lbnd_block, ubnd_block, out, out_var, status );
+         if( queue ) {
+            QueueBlock( queue, ifit, factor, lbnd_block, ubnd_block, status );
+         } else {
+            result += ResampleSection( this, linear_fit,
+                                       ndim_in, lbnd_in, ubnd_in,
+                                       in, in_var, type, interp, finterp,
+                                       params, factor, flags, badval_ptr,
+                                       ndim_out, lbnd_out, ubnd_out,
+                                       lbnd_block, ubnd_block, out, out_var,
+                                       status );
+         }
 
 /* Update the block extent to identify the next block of output
    pixels. */
@@ -16041,6 +19440,370 @@ static int ResampleWithBlocking( AstMapping *this, const double *linear_fit,
    return result;
 }
 
+static int SeparableWeights( AstMapping *this, int ndim,
+                             const int *lbnd_in, const int *ubnd_in,
+                             int interp, const double *params, double tol,
+                             int maxpix, const int *lbnd_out,
+                             const int *ubnd_out, const int *lbnd,
+                             const int *ubnd, SeparableJob *job,
+                             int *status ) {
+/*
+*  Name:
+*     SeparableWeights
+
+*  Purpose:
+*     Find the weights needed to resample a grid one axis group at a time.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int SeparableWeights( AstMapping *this, int ndim,
+*                           const int *lbnd_in, const int *ubnd_in,
+*                           int interp, const double *params, double tol,
+*                           int maxpix, const int *lbnd_out,
+*                           const int *ubnd_out, const int *lbnd,
+*                           const int *ubnd, SeparableJob *job,
+*                           int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function determines if a Mapping can be split (using
+*     astMapSplit) into two independent Mappings, one transforming a
+*     single "channel" axis (such as the spectral axis of a data cube)
+*     and one transforming all the remaining "plane" axes (such as the
+*     spatial axes of a data cube). If so, and if the chosen
+*     interpolation scheme forms each output value as a weighted mean
+*     of the input values using weights that are the product of the
+*     weights on each axis, a section of an output grid can be formed
+*     by resampling the channel axis and the plane axes separately (see
+*     ResampleSeparable<X>).
+*
+*     In this case, the weights for each Mapping are found using
+*     astResampleWeights, and are stored in the supplied SeparableJob
+*     together with the corresponding offsets into the full input and
+*     output grids. The plane weights are found only once and are
+*     re-used for every channel, which is much faster than resampling
+*     the whole grid at once if there are many output channels.
+
+*  Parameters:
+*     this
+*        Pointer to a Mapping, whose inverse transformation will be
+*        used to transform the coordinates of pixels in the output
+*        grid into the coordinate system of the input grid. The number
+*        of inputs should equal the number of outputs.
+*     ndim
+*        The number of dimensions in the input and output grids.
+*     lbnd_in, ubnd_in, interp, params, tol, maxpix, lbnd_out,
+*     ubnd_out, lbnd, ubnd
+*        As for astResampleWeights.
+*     job
+*        Pointer to a SeparableJob structure in which to return the
+*        weights. The memory used should be freed using FreeSeparable
+*        when no longer needed.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the Mapping is separable and the weights have been
+*     found. Zero is returned if the Mapping cannot be split, or if the
+*     interpolation scheme is unsuitable, or if the plane weights would
+*     use too much memory compared with the output grid section (in
+*     which case the grid should be resampled as a whole).
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   AstMapping *map_chan;         /* Mapping for the channel axis */
+   AstMapping *map_plane;        /* Mapping for the plane axes */
+   const double *par;            /* Pointer to kernel parameter array */
+   double lpar[ 1 ];             /* Local kernel parameter array */
+   double nest;                  /* Estimated number of plane weights */
+   double npix_in;               /* Number of pixels in input grid */
+   double npix_out;              /* Number of pixels in output grid */
+   int *axes_in;                 /* Input plane axes */
+   int *dim_in;                  /* Dimensions of input plane */
+   int *dim_out;                 /* Dimensions of output plane */
+   int *index;                   /* Index in "base" of each input plane pixel */
+   int *lbnd_plane;              /* Plane bounds, lower then upper */
+   int *out_chan;                /* Output axis fed by the channel axis */
+   int *out_plane;               /* Output axes fed by the plane axes */
+   int *outpix;                  /* Output plane offsets */
+   int *stride_in;               /* Input grid strides */
+   int *stride_out;              /* Output grid strides */
+   int i;                        /* Loop counter for plane axes */
+   int iax;                      /* Index of channel axis being tested */
+   int ichan;                    /* Index of input channel axis */
+   int idim;                     /* Loop counter for dimensions */
+   int iwt;                      /* Weight index */
+   int k;                        /* Input plane pixel index */
+   int nax;                      /* Max. contributing pixels on one axis */
+   int neighb;                   /* Number of neighbouring pixels */
+   int nsub;                     /* Number of pixels in input plane */
+   int ochan;                    /* Index of output channel axis */
+   int off;                      /* Offset into full grid */
+   int r;                        /* Remaining plane offset */
+   int result;                   /* Returned flag */
+   int s;                        /* Temporary variable for strides */
+   void (* kernel)( double, const double [], int, double *, int * );
+
+/* Initialise. */
+   job->wt_chan = NULL;
+   job->wt_plane = NULL;
+   job->base = NULL;
+   job->cen_chan = NULL;
+   job->cen_plane = NULL;
+   job->in_chan = NULL;
+   job->in_plane = NULL;
+   job->nbad = NULL;
+   job->out_chan = NULL;
+   job->out_plane = NULL;
+   job->start_chan = NULL;
+   job->start_plane = NULL;
+   job->work = NULL;
+   job->nbase = 0;
+   job->nchan = 0;
+   job->nplane = 0;
+   result = 0;
+
+/* Check the global error status, and that there are at least two
+   dimensions. */
+   if ( !astOK || ndim < 2 ) return result;
+
+/* Only schemes that use a fixed set of weights formed from the product
+   of the weights on each axis can be used. Find the maximum number of
+   input pixels that can contribute to an output pixel along each axis. */
+   switch ( interp ) {
+      case AST__NEAREST:
+         nax = 1;
+         break;
+
+      case AST__LINEAR:
+      case 0:
+         nax = 2;
+         break;
+
+      case AST__GAUSS:
+      case AST__SINC:
+      case AST__SINCCOS:
+      case AST__SINCGAUSS:
+      case AST__SINCSINC:
+      case AST__SOMB:
+      case AST__SOMBCOS:
+         SetupKernel1( interp, params, &kernel, lpar, &par, &neighb, status );
+         nax = 2*neighb;
+         break;
+
+      default:
+         return result;
+   }
+
+/* The weights hold pixel offsets as type int, so grids containing more
+   pixels than an int can count are left to the general resampling code. */
+   npix_in = 1.0;
+   npix_out = 1.0;
+   for ( idim = 0; idim < ndim; idim++ ) {
+      npix_in *= (double) ( ubnd_in[ idim ] - lbnd_in[ idim ] + 1 );
+      npix_out *= (double) ( ubnd_out[ idim ] - lbnd_out[ idim ] + 1 );
+   }
+   if ( npix_in > (double) INT_MAX || npix_out > (double) INT_MAX ) {
+      return result;
+   }
+
+/* Look for an input axis (starting with the last, which is usually the
+   spectral axis of a data cube) which feeds a single output axis, and
+   for which the remaining input axes feed all the remaining output
+   axes. */
+   map_chan = NULL;
+   map_plane = NULL;
+   out_plane = NULL;
+   ichan = -1;
+   ochan = -1;
+   axes_in = astMalloc( sizeof( int )*(size_t) ndim );
+   for ( iax = ndim - 1; iax >= 0 && ichan < 0 && astOK; iax-- ) {
+      out_chan = astMapSplit( this, 1, &iax, &map_chan );
+      if ( out_chan && astGetNout( map_chan ) == 1 &&
+           astGetTranInverse( map_chan ) ) {
+         for ( i = 0, idim = 0; idim < ndim; idim++ ) {
+            if ( idim != iax ) axes_in[ i++ ] = idim;
+         }
+         out_plane = astMapSplit( this, ndim - 1, axes_in, &map_plane );
+         if ( out_plane && astGetNout( map_plane ) == ndim - 1 &&
+              astGetTranInverse( map_plane ) ) {
+            ichan = iax;
+            ochan = out_chan[ 0 ];
+            for ( i = 0; i < ndim - 1; i++ ) {
+               if ( out_plane[ i ] == ochan ) ichan = -1;
+            }
+         }
+         if ( ichan < 0 ) {
+            out_plane = astFree( out_plane );
+            if ( map_plane ) map_plane = astAnnul( map_plane );
+         }
+      }
+      out_chan = astFree( out_chan );
+      if ( ichan < 0 && map_chan ) map_chan = astAnnul( map_chan );
+   }
+
+/* Estimate the number of plane weights that will be needed, and check
+   that it is not too large compared with the number of pixels in the
+   output section. Otherwise the memory needed to hold the weights could
+   greatly exceed that used by the data themselves. */
+   if ( ichan >= 0 && astOK ) {
+      nest = (double) ( ubnd[ ochan ] - lbnd[ ochan ] + 1 );
+      nest = 1.0/( 2.0*nest );
+      for ( i = 0; i < ndim - 1; i++ ) {
+         nest *= (double) MinI( nax, ubnd_in[ axes_in[ i ] ] -
+                                     lbnd_in[ axes_in[ i ] ] + 1, status );
+      }
+      result = ( nest <= 1.0 );
+   }
+
+/* Find the bounds of the input and output planes (lower bounds of the
+   input plane, upper bounds of the input plane, and so on for the output
+   grid and the output section), and the weights for the plane and
+   channel Mappings. */
+   if ( result ) {
+      lbnd_plane = astMalloc( sizeof( int )*(size_t) ( 6*( ndim - 1 ) ) );
+      if ( astOK ) {
+         for ( i = 0; i < ndim - 1; i++ ) {
+            lbnd_plane[ i ] = lbnd_in[ axes_in[ i ] ];
+            lbnd_plane[ i + ndim - 1 ] = ubnd_in[ axes_in[ i ] ];
+            lbnd_plane[ i + 2*( ndim - 1 ) ] = lbnd_out[ out_plane[ i ] ];
+            lbnd_plane[ i + 3*( ndim - 1 ) ] = ubnd_out[ out_plane[ i ] ];
+            lbnd_plane[ i + 4*( ndim - 1 ) ] = lbnd[ out_plane[ i ] ];
+            lbnd_plane[ i + 5*( ndim - 1 ) ] = ubnd[ out_plane[ i ] ];
+         }
+         job->nplane = astResampleWeights( map_plane, ndim - 1, lbnd_plane,
+                                           lbnd_plane + ndim - 1, interp,
+                                           params, tol, maxpix, ndim - 1,
+                                           lbnd_plane + 2*( ndim - 1 ),
+                                           lbnd_plane + 3*( ndim - 1 ),
+                                           lbnd_plane + 4*( ndim - 1 ),
+                                           lbnd_plane + 5*( ndim - 1 ),
+                                           &job->out_plane, &job->cen_plane,
+                                           &job->start_plane,
+                                           &job->in_plane, &job->wt_plane );
+      }
+      lbnd_plane = astFree( lbnd_plane );
+
+      job->nchan = astResampleWeights( map_chan, 1, lbnd_in + ichan,
+                                       ubnd_in + ichan, interp, params, tol,
+                                       maxpix, 1, lbnd_out + ochan,
+                                       ubnd_out + ochan, lbnd + ochan,
+                                       ubnd + ochan, &job->out_chan,
+                                       &job->cen_chan, &job->start_chan,
+                                       &job->in_chan, &job->wt_chan );
+
+/* Calculate the stride along each dimension of the input and output
+   grids. */
+      stride_in = astMalloc( sizeof( int )*(size_t) ndim );
+      stride_out = astMalloc( sizeof( int )*(size_t) ndim );
+      dim_in = astMalloc( sizeof( int )*(size_t) ndim );
+      dim_out = astMalloc( sizeof( int )*(size_t) ndim );
+      if ( astOK ) {
+         for ( s = 1, idim = 0; idim < ndim; idim++ ) {
+            stride_in[ idim ] = s;
+            s *= ubnd_in[ idim ] - lbnd_in[ idim ] + 1;
+         }
+         for ( s = 1, idim = 0; idim < ndim; idim++ ) {
+            stride_out[ idim ] = s;
+            s *= ubnd_out[ idim ] - lbnd_out[ idim ] + 1;
+         }
+
+/* Convert the channel offsets returned by astResampleWeights into
+   offsets within the full input and output grids. */
+         for ( i = 0; i < job->nchan; i++ ) {
+            job->out_chan[ i ] *= stride_out[ ochan ];
+         }
+         for ( iwt = 0; iwt < job->start_chan[ job->nchan ]; iwt++ ) {
+            job->in_chan[ iwt ] *= stride_in[ ichan ];
+         }
+
+/* Convert the output plane offsets into offsets within the full output
+   grid. */
+         nsub = 1;
+         for ( i = 0; i < ndim - 1; i++ ) {
+            dim_in[ i ] = ubnd_in[ axes_in[ i ] ] - lbnd_in[ axes_in[ i ] ] + 1;
+            dim_out[ i ] = ubnd_out[ out_plane[ i ] ] -
+                           lbnd_out[ out_plane[ i ] ] + 1;
+            nsub *= dim_in[ i ];
+         }
+         outpix = job->out_plane;
+         for ( k = 0; k < job->nplane; k++ ) {
+            r = outpix[ k ];
+            off = 0;
+            for ( i = 0; i < ndim - 1; i++ ) {
+               off += ( r % dim_out[ i ] )*stride_out[ out_plane[ i ] ];
+               r /= dim_out[ i ];
+            }
+            outpix[ k ] = off;
+         }
+
+/* Identify the pixels in the input plane that are used by any of the
+   plane weights, and number them in order of increasing offset. Each
+   intermediate plane formed by ResampleSeparable<X> then holds just
+   these pixels. */
+         index = astCalloc( (size_t) nsub, sizeof( int ) );
+         if ( astOK ) {
+            for ( iwt = 0; iwt < job->start_plane[ job->nplane ]; iwt++ ) {
+               index[ job->in_plane[ iwt ] ] = 1;
+            }
+            for ( k = 0; k < nsub; k++ ) {
+               index[ k ] = index[ k ] ? job->nbase++ : -1;
+            }
+
+/* Store the offset of each such pixel within the full input grid, and
+   replace the plane offset of each weight by the index of its pixel. */
+            job->base = astMalloc( sizeof( int )*(size_t) job->nbase );
+            if ( astOK ) {
+               for ( k = 0; k < nsub; k++ ) {
+                  if ( index[ k ] >= 0 ) {
+                     r = k;
+                     off = 0;
+                     for ( i = 0; i < ndim - 1; i++ ) {
+                        off += ( r % dim_in[ i ] )*stride_in[ axes_in[ i ] ];
+                        r /= dim_in[ i ];
+                     }
+                     job->base[ index[ k ] ] = off;
+                  }
+               }
+               for ( iwt = 0; iwt < job->start_plane[ job->nplane ]; iwt++ ) {
+                  job->in_plane[ iwt ] = index[ job->in_plane[ iwt ] ];
+               }
+            }
+         }
+         index = astFree( index );
+      }
+
+/* Free workspace. */
+      stride_in = astFree( stride_in );
+      stride_out = astFree( stride_out );
+      dim_in = astFree( dim_in );
+      dim_out = astFree( dim_out );
+   }
+
+/* Free the split Mappings. */
+   axes_in = astFree( axes_in );
+   out_plane = astFree( out_plane );
+   if ( map_chan ) map_chan = astAnnul( map_chan );
+   if ( map_plane ) map_plane = astAnnul( map_plane );
+
+/* If an error occurred, free the weights and clear the returned value. */
+   if ( !astOK ) result = 0;
+   if ( !result ) FreeSeparable( job, status );
+
+/* Return the result. */
+   return result;
+}
+
 static void SetAttrib( AstObject *this_object, const char *setting, int *status ) {
 /*
 *  Name:
@@ -16124,26 +19887,239 @@ static void SetAttrib( AstObject *this_object, const char *setting, int *status
         ( nc = 0, ( 0 == astSscanf( setting, attrib "=%*[^\n]%n", &nc ) ) && \
                   ( nc >= len ) )
 
-/* If the attribute was not recognised, use this macro to report an error
-   if a read-only attribute has been specified. */
-   } else if ( MATCH( "nin" ) ||
-        MATCH( "nout" ) ||
-        MATCH( "islinear" ) ||
-        MATCH( "issimple" ) ||
-        MATCH( "tranforward" ) ||
-        MATCH( "traninverse" ) ) {
-      astError( AST__NOWRT, "astSet: The setting \"%s\" is invalid for a %s.", status,
-                setting, astGetClass( this ) );
-      astError( AST__NOWRT, "This is a read-only attribute." , status);
+/* If the attribute was not recognised, use this macro to report an error
+   if a read-only attribute has been specified. */
+   } else if ( MATCH( "nin" ) ||
+        MATCH( "nout" ) ||
+        MATCH( "islinear" ) ||
+        MATCH( "issimple" ) ||
+        MATCH( "tranforward" ) ||
+        MATCH( "traninverse" ) ) {
+      astError( AST__NOWRT, "astSet: The setting \"%s\" is invalid for a %s.", status,
+                setting, astGetClass( this ) );
+      astError( AST__NOWRT, "This is a read-only attribute." , status);
+
+/* If the attribute is still not recognised, pass it on to the parent
+   method for further interpretation. */
+   } else {
+      (*parent_setattrib)( this_object, setting, status );
+   }
+
+/* Undefine macros local to this function. */
+#undef MATCH
+}
+
+static void SetupKernel1( int interp, const double params[],
+                          void (** kernel)( double, const double [], int,
+                                            double *, int * ),
+                          double lpar[ 1 ], const double **par, int *neighb,
+                          int *status ) {
+/*
+*  Name:
+*     SetupKernel1
+
+*  Purpose:
+*     Select an internal 1-dimensional kernel function and its parameters.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void SetupKernel1( int interp, const double params[],
+*                        void (** kernel)( double, const double [], int,
+*                                          double *, int * ),
+*                        double lpar[ 1 ], const double **par, int *neighb,
+*                        int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function returns a pointer to the internal 1-dimensional
+*     kernel function (Sinc, Gauss, etc.) identified by an interpolation
+*     or spreading scheme such as AST__SINC, together with the parameter
+*     array to be passed to it and the number of neighbouring pixels
+*     that it should be applied to on each side of a position. It is
+*     used by astResample<X>, astRebin<X> and astResampleWeights.
+
+*  Parameters:
+*     interp
+*        The scheme (AST__SINC, AST__SINCCOS, AST__SINCGAUSS, AST__GAUSS,
+*        AST__SINCSINC, AST__SOMB or AST__SOMBCOS).
+*     params
+*        The "params" array supplied by the caller of astResample<X>
+*        or astRebin<X>.
+*     kernel
+*        Address at which to return a pointer to the kernel function.
+*        A NULL pointer is returned if "interp" does not identify an
+*        internal 1-dimensional kernel.
+*     lpar
+*        A local array in which to store any parameter value required
+*        by the kernel function.
+*     par
+*        Address at which to return a pointer to the parameter array
+*        to be passed to the kernel function. This will be either
+*        "lpar" or NULL.
+*     neighb
+*        Address at which to return the number of neighbouring pixels
+*        to use.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Initialise. */
+   *kernel = NULL;
+   *par = NULL;
+   *neighb = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Obtain a pointer to the appropriate kernel function and set up any
+   parameters it may require. */
+   switch ( interp ) {
+
+/* sinc(pi*x) */
+/* ---------- */
+/* Assign the kernel function. */
+      case AST__SINC:
+         *kernel = Sinc;
+
+/* Calculate the number of neighbouring pixels to use. */
+         *neighb = (int) floor( params[ 0 ] + 0.5 );
+         if ( *neighb <= 0 ) {
+            *neighb = 2;
+         } else {
+            *neighb = MaxI( 1, *neighb, status );
+         }
+         break;
+
+/* somb(pi*x) */
+/* ---------- */
+/* Assign the kernel function. */
+      case AST__SOMB:
+         *kernel = Somb;
+
+/* Calculate the number of neighbouring pixels to use. */
+         *neighb = (int) floor( params[ 0 ] + 0.5 );
+         if ( *neighb <= 0 ) {
+            *neighb = 2;
+         } else {
+            *neighb = MaxI( 1, *neighb, status );
+         }
+         break;
+
+/* sinc(pi*x)*cos(k*pi*x) */
+/* ---------------------- */
+/* Assign the kernel function. */
+      case AST__SINCCOS:
+         *kernel = SincCos;
+
+/* Store the required value of "k" in a local parameter array and pass
+   this array to the kernel function. */
+         lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
+         *par = lpar;
+
+/* Obtain the number of neighbouring pixels to use. If this is zero or
+   less, the number will be calculated automatically below. */
+         *neighb = (int) floor( params[ 0 ] + 0.5 );
+         if ( *neighb <= 0 ) *neighb = INT_MAX;
+
+/* Calculate the maximum number of neighbouring pixels required by the
+   width of the kernel, and use this value if preferable. */
+         *neighb = MinI( *neighb,
+                         (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
+         break;
+
+/* somb(pi*x)*cos(k*pi*x) */
+/* ---------------------- */
+/* Assign the kernel function. */
+      case AST__SOMBCOS:
+         *kernel = SombCos;
+
+/* Store the required value of "k" in a local parameter array and pass
+   this array to the kernel function. */
+         lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
+         *par = lpar;
+
+/* Obtain the number of neighbouring pixels to use. If this is zero or
+   less, the number will be calculated automatically below. */
+         *neighb = (int) floor( params[ 0 ] + 0.5 );
+         if ( *neighb <= 0 ) *neighb = INT_MAX;
+
+/* Calculate the maximum number of neighbouring pixels required by the
+   width of the kernel, and use this value if preferable. */
+         *neighb = MinI( *neighb,
+                         (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
+         break;
+
+/* sinc(pi*x)*exp(-k*x*x) */
+/* ---------------------- */
+/* Assign the kernel function. */
+      case AST__SINCGAUSS:
+         *kernel = SincGauss;
+
+/* Store the required value of "k" in a local parameter array and pass
+   this array to the kernel function. The full width half maximum of the
+   gaussian factor is constrained. */
+         lpar[ 0 ] = MaxD( 0.1, params[ 1 ], status );
+         lpar[ 0 ] = 4.0 * log( 2.0 ) / ( lpar[ 0 ] * lpar[ 0 ] );
+         *par = lpar;
+
+/* Obtain the number of neighbouring pixels to use. If this is zero or
+   less, use the number of neighbouring pixels required by the width
+   of the kernel (out to where the gaussian term falls to 1% of its
+   peak value). */
+         *neighb = (int) floor( params[ 0 ] + 0.5 );
+         if ( *neighb <= 0 ) *neighb = (int) ceil( sqrt( -log( 0.01 ) /
+                                                         lpar[ 0 ] ) );
+         break;
+
+/* exp(-k*x*x) */
+/* ----------- */
+/* Assign the kernel function. */
+      case AST__GAUSS:
+         *kernel = Gauss;
+
+/* Store the required value of "k" in a local parameter array and pass
+   this array to the kernel function. The full width half maximum of the
+   gaussian is constrained. */
+         lpar[ 0 ] = MaxD( 0.1, params[ 1 ], status );
+         lpar[ 0 ] = 4.0 * log( 2.0 ) / ( lpar[ 0 ] * lpar[ 0 ] );
+         *par = lpar;
+
+/* Obtain the number of neighbouring pixels to use. If this is zero or
+   less, use the number of neighbouring pixels required by the width
+   of the kernel (out to where the gaussian term falls to 1% of its
+   peak value). */
+         *neighb = (int) floor( params[ 0 ] + 0.5 );
+         if ( *neighb <= 0 ) *neighb = (int) ceil( sqrt( -log( 0.01 ) /
+                                                         lpar[ 0 ] ) );
+         break;
+
+/* sinc(pi*x)*sinc(k*pi*x) */
+/* ----------------------- */
+/* Assign the kernel function. */
+      case AST__SINCSINC:
+         *kernel = SincSinc;
+
+/* Store the required value of "k" in a local parameter array and pass
+   this array to the kernel function. */
+         lpar[ 0 ] = 0.5 / MaxD( 1.0, params[ 1 ], status );
+         *par = lpar;
 
-/* If the attribute is still not recognised, pass it on to the parent
-   method for further interpretation. */
-   } else {
-      (*parent_setattrib)( this_object, setting, status );
-   }
+/* Obtain the number of neighbouring pixels to use. If this is zero or
+   less, the number will be calculated automatically below. */
+         *neighb = (int) floor( params[ 0 ] + 0.5 );
+         if ( *neighb <= 0 ) *neighb = INT_MAX;
 
-/* Undefine macros local to this function. */
-#undef MATCH
+/* Calculate the maximum number of neighbouring pixels required by the
+   width of the kernel, and use this value if preferable. */
+         *neighb = MinI( *neighb,
+                         (int) ceil( MaxD( 1.0, params[ 1 ], status ) ), status );
+         break;
+   }
 }
 
 static void Sinc( double offset, const double params[], int flags,
@@ -17065,12 +21041,12 @@ static int SpecialBounds( const MapData *mapdata, double *lbnd, double *ubnd,
 *     void SpreadKernel1<X>( AstMapping *this, int ndim_out,
 *                           const int *lbnd_out, const int *ubnd_out,
 *                           const <Xtype> *in, const <Xtype> *in_var,
-*                           double infac, int npoint, const int *offset,
+*                           double infac, int npoint, const int64_t *offset,
 *                           const double *const *coords,
 *                           void (* kernel)( double, const double [], int,
 *                                            double *, int * ),
 *                           int neighb, const double *params, int flags,
-*                           <Xtype> badval, int npix_out, <Xtype> *out,
+*                           <Xtype> badval, int64_t npix_out, <Xtype> *out,
 *                           <Xtype> *out_var, double *work, int64_t *nused,
 *                           int *status )
 
@@ -17236,12 +21212,12 @@ static int SpecialBounds( const MapData *mapdata, double *lbnd, double *ubnd,
 static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
                               const int *lbnd_out, const int *ubnd_out, \
                               const Xtype *in, const Xtype *in_var, \
-                              double infac, int npoint, const int *offset, \
+                              double infac, int npoint, const int64_t *offset, \
                               const double *const *coords, \
                               void (* kernel)( double, const double [], \
                                                int, double *, int * ), \
                               int neighb, const double *params, \
-                              int flags, Xtype badval, int npix_out, \
+                              int flags, Xtype badval, int64_t npix_out, \
                               Xtype *out, Xtype *out_var, double *work, \
                               int64_t *nused, int *status ) { \
 \
@@ -17249,6 +21225,7 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
    astDECLARE_GLOBALS            /* Thread-specific data */ \
    Xtype c; \
    Xtype in_val;                 /* Input pixel value */ \
+   const double *table;          /* Tabulated kernel values */ \
    double **wtptr;               /* Pointer to array of weight pointers */ \
    double **wtptr_last;          /* Array of highest weight pointer values */ \
    double *filter;               /* Pointer to Nd array of filter values */ \
@@ -17261,6 +21238,8 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
    double pfac;                  /* Input weight with extra supplied factor */ \
    double pixwt;                 /* Weight to apply to individual pixel */ \
    double sum;                   /* Sum of all filter values */ \
+   double tpos;                  /* Position within kernel table */ \
+   double tscale;                /* Kernel table elements per unit offset */ \
    double wgt;                   /* Weight for input value */ \
    double x;                     /* x coordinate value */ \
    double xn;                    /* Coordinate value (n-d) */ \
@@ -17274,7 +21253,6 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
    int *jhi;                     /* Pointer to array of filter upper indices */ \
    int *jlo;                     /* Pointer to array of filter lower indices */ \
    int *lo;                      /* Pointer to array of lower indices */ \
-   int *stride;                  /* Pointer to array of dimension strides */ \
    int bad;                      /* Output pixel bad? */ \
    int done;                     /* All pixel indices done? */ \
    int genvar;                   /* Generate output variances? */ \
@@ -17300,17 +21278,19 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
    int nf;                       /* Number of pixels in filter array */ \
    int nwx;                      /* Used X width of kernel function (*2) */ \
    int nwy;                      /* Used Y width of kernel function (*2) */ \
-   int off1;                     /* Input pixel offset due to y index */ \
-   int off_in;                   /* Offset to input pixel */ \
-   int off_out;                  /* Offset to output pixel */ \
    int off_xedge;                /* Does filter box overlap array edge on the X axis? */ \
    int off_yedge;                /* Does filter box overlap array edge on the Y axis? */ \
    int point;                    /* Loop counter for output points */ \
-   int s;                        /* Temporary variable for strides */ \
+   int tidx;                     /* Index of kernel table element */ \
    int usebad;                   /* Use "bad" input pixel values? */ \
    int usevar;                   /* Process variance array? */ \
    int varwgt;                   /* Use input variances as weights? */ \
-   int ystride;                  /* Stride along input grid y dimension */ \
+   int64_t *stride;              /* Pointer to array of dimension strides */ \
+   int64_t off1;                 /* Input pixel offset due to y index */ \
+   int64_t off_in;               /* Offset to input pixel */ \
+   int64_t off_out;              /* Offset to output pixel */ \
+   int64_t s;                    /* Temporary variable for strides */ \
+   int64_t ystride;              /* Stride along input grid y dimension */ \
 \
 /* Check the global error status. */ \
    if ( !astOK ) return; \
@@ -17323,6 +21303,10 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
    sum = 0.0; \
    bad = 0; \
 \
+/* Obtain a table of kernel values that allows the kernel to be evaluated \
+   by interpolation. */ \
+   table = KernelTable( kernel, params, neighb, &tscale, status ); \
+\
 /* Find the total number of pixels in the filter used to spread a single \
    input pixel into the output image. */ \
    nb2 = 2*neighb; \
@@ -17462,7 +21446,7 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
          lo = astMalloc( sizeof( int ) * (size_t) ndim_out ); \
          jhi = astMalloc( sizeof( int ) * (size_t) ndim_out ); \
          jlo = astMalloc( sizeof( int ) * (size_t) ndim_out ); \
-         stride = astMalloc( sizeof( int ) * (size_t) ndim_out ); \
+         stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_out ); \
          xnl = astMalloc( sizeof( double ) * (size_t) ndim_out ); \
          kval = astMalloc( sizeof( double ) * (size_t) \
                                            ( nb2 * ndim_out ) ); \
@@ -17637,7 +21621,11 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
                   for( jx = 0; jx < nb2; jx++ ) filter[ jx ] = 0.0; \
 \
                   for ( jx = 0; jx < nb2; jx++ ) { \
-                     ( *kernel )( xx, params, flags, &pixwt, status ); \
+                     if( table ) { \
+                        TABLE_KERNEL( xx, pixwt ); \
+                     } else { \
+                        ( *kernel )( xx, params, flags, &pixwt, status ); \
+                     } \
                      if ( !astOK ) { \
                         kerror = 1; \
                         goto Kernel_SError_1d; \
@@ -17658,7 +21646,11 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
                   xxl = xx; \
 \
                   for ( jx = 0; jx < nb2; jx++ ) { \
-                     ( *kernel )( xx, params, flags, &pixwt, status ); \
+                     if( table ) { \
+                        TABLE_KERNEL( xx, pixwt ); \
+                     } else { \
+                        ( *kernel )( xx, params, flags, &pixwt, status ); \
+                     } \
 \
 /* Check for errors arising in the kernel function. */ \
                      if ( !astOK ) { \
@@ -17829,7 +21821,11 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
                      for( jy = 0; jy < nb2*nb2; jy++ ) filter[ jy ] = 0.0; \
 \
                      for ( jy = 0; jy < nb2; jy++ ) { \
-                        ( *kernel )( yy, params, flags, &pixwt, status ); \
+                        if( table ) { \
+                           TABLE_KERNEL( yy, pixwt ); \
+                        } else { \
+                           ( *kernel )( yy, params, flags, &pixwt, status ); \
+                        } \
                         if ( !astOK ) { \
                            kerror = 1; \
                            goto Kernel_SError_2d; \
@@ -17851,7 +21847,11 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
                      yyl = yy; \
                      kp = filter; \
                      for ( jy = 0; jy < nb2; jy++ ) { \
-                        ( *kernel )( yy, params, flags, &pixwt, status ); \
+                        if( table ) { \
+                           TABLE_KERNEL( yy, pixwt ); \
+                        } else { \
+                           ( *kernel )( yy, params, flags, &pixwt, status ); \
+                        } \
 \
 /* Check for errors arising in the kernel function. */ \
                         if ( !astOK ) { \
@@ -17884,7 +21884,11 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
                      for( jx = 0; jx < nb2; jx++ ) xfilter[ jx ] = 0.0; \
 \
                      for ( jx = 0; jx < nb2; jx++ ) { \
-                        ( *kernel )( xx, params, flags, &pixwt, status ); \
+                        if( table ) { \
+                           TABLE_KERNEL( xx, pixwt ); \
+                        } else { \
+                           ( *kernel )( xx, params, flags, &pixwt, status ); \
+                        } \
                         if ( !astOK ) { \
                            kerror = 1; \
                            goto Kernel_SError_2d; \
@@ -17911,7 +21915,11 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
                   } else { \
 \
                      for ( jx = 0; jx < nb2; jx++ ) { \
-                        ( *kernel )( xx, params, flags, &pixwt, status ); \
+                        if( table ) { \
+                           TABLE_KERNEL( xx, pixwt ); \
+                        } else { \
+                           ( *kernel )( xx, params, flags, &pixwt, status ); \
+                        } \
 \
 /* Check for errors arising in the kernel function. */ \
                         if ( !astOK ) { \
@@ -18091,7 +22099,11 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
 \
                   kp = wtptr[ idim ]; \
                   for ( jx = 0; jx < nb2; jx++ ) { \
-                     ( *kernel )( xxn, params, flags, &pixwt, status ); \
+                     if( table ) { \
+                        TABLE_KERNEL( xxn, pixwt ); \
+                     } else { \
+                        ( *kernel )( xxn, params, flags, &pixwt, status ); \
+                     } \
                      if ( !astOK ) { \
                         kerror = 1; \
                         goto Kernel_SError_1d; \
@@ -18110,7 +22122,11 @@ static void SpreadKernel1##X( AstMapping *this, int ndim_out, \
                } else { \
                   xnl[ idim ] = xxn; \
                   for ( jxn = 0; jxn < nb2; jxn++ ) { \
-                     ( *kernel )( xxn, params, flags, wtptr[ idim ] + jxn, status ); \
+                     if( table ) { \
+                        TABLE_KERNEL( xxn, wtptr[ idim ][ jxn ] ); \
+                     } else { \
+                        ( *kernel )( xxn, params, flags, wtptr[ idim ] + jxn, status ); \
+                     } \
 \
 /* Check for errors arising in the kernel function. */ \
                      if ( !astOK ) { \
@@ -18314,9 +22330,9 @@ MAKE_SPREAD_KERNEL1(UB,unsigned char,1)
 *     void SpreadLinear<X>( int ndim_out,
 *                           const int *lbnd_out, const int *ubnd_out,
 *                           const <Xtype> *in, const <Xtype> *in_var,
-*                           double infac, int npoint, const int *offset,
+*                           double infac, int npoint, const int64_t *offset,
 *                           const double *const *coords, int flags,
-*                           <Xtype> badval, int npix_out, <Xtype> *out,
+*                           <Xtype> badval, int64_t npix_out, <Xtype> *out,
 *                           <Xtype> *out_var, double *work, int64_t *nused  )
 
 *  Class Membership:
@@ -18459,9 +22475,9 @@ MAKE_SPREAD_KERNEL1(UB,unsigned char,1)
 static void SpreadLinear##X( int ndim_out, \
                             const int *lbnd_out, const int *ubnd_out, \
                             const Xtype *in, const Xtype *in_var, \
-                            double infac, int npoint, const int *offset, \
+                            double infac, int npoint, const int64_t *offset, \
                             const double *const *coords, int flags, \
-                            Xtype badval, int npix_out, Xtype *out, \
+                            Xtype badval, int64_t npix_out, Xtype *out, \
                             Xtype *out_var, double *work, int64_t *nused, \
                             int *status ) { \
 \
@@ -18491,7 +22507,6 @@ static void SpreadLinear##X( int ndim_out, \
    int *dim;                     /* Pointer to array of pixel indices */ \
    int *hi;                      /* Pointer to array of upper indices */ \
    int *lo;                      /* Pointer to array of lower indices */ \
-   int *stride;                  /* Pointer to array of dimension strides */ \
    int bad;                      /* Output pixel bad? */ \
    int done;                     /* All pixel indices done? */ \
    int genvar;                   /* Generate output variances? */ \
@@ -18502,16 +22517,17 @@ static void SpreadLinear##X( int ndim_out, \
    int ixn;                      /* Pixel index (n-d) */ \
    int lo_x;                     /* Lower pixel index (x dimension) */ \
    int lo_y;                     /* Lower pixel index (y dimension) */ \
-   int off;                      /* Total offset to input pixel */ \
-   int off_in;                   /* Offset to input pixel */ \
-   int off_lo;                   /* Offset to "first" input pixel */ \
-   int off_out;                  /* Offset to output pixel */ \
    int point;                    /* Loop counter for output points */ \
-   int s;                        /* Temporary variable for strides */ \
    int usebad;                   /* Use "bad" input pixel values? */ \
    int usevar;                   /* Process variance array? */ \
    int varwgt;                   /* Use input variances as weights? */ \
-   int ystride;                  /* Stride along input grid y dimension */ \
+   int64_t *stride;              /* Pointer to array of dimension strides */ \
+   int64_t off;                  /* Total offset to input pixel */ \
+   int64_t off_in;               /* Offset to input pixel */ \
+   int64_t off_lo;               /* Offset to "first" input pixel */ \
+   int64_t off_out;              /* Offset to output pixel */ \
+   int64_t s;                    /* Temporary variable for strides */ \
+   int64_t ystride;              /* Stride along input grid y dimension */ \
 \
 /* Check the global error status. */ \
    if ( !astOK ) return; \
@@ -18649,7 +22665,7 @@ static void SpreadLinear##X( int ndim_out, \
       frac_lo = astMalloc( sizeof( double ) * (size_t) ndim_out ); \
       hi = astMalloc( sizeof( int ) * (size_t) ndim_out ); \
       lo = astMalloc( sizeof( int ) * (size_t) ndim_out ); \
-      stride = astMalloc( sizeof( int ) * (size_t) ndim_out ); \
+      stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_out ); \
       wt = astMalloc( sizeof( double ) * (size_t) ndim_out ); \
       wtprod = astMalloc( sizeof( double ) * (size_t) ndim_out ); \
       xn_max = astMalloc( sizeof( double ) * (size_t) ndim_out ); \
@@ -19153,8 +23169,8 @@ MAKE_SPREAD_LINEAR(UB,unsigned char,1)
 *     void SpreadNearest<X>( int ndim_out, const int *lbnd_out,
 *                            const int *ubnd_out, const <Xtype> *in,
 *                            const <Xtype> *in_var, double infac, int npoint,
-*                            const int *offset, const double *const *coords,
-*                            int flags, <Xtype> badval, int npix_out, <Xtype> *out,
+*                            const int64_t *offset, const double *const *coords,
+*                            int flags, <Xtype> badval, int64_t npix_out, <Xtype> *out,
 *                            <Xtype> *out_var, double *work, int64_t *nused,
 *                            int *status )
 
@@ -19300,9 +23316,9 @@ MAKE_SPREAD_LINEAR(UB,unsigned char,1)
 static void SpreadNearest##X( int ndim_out, \
                              const int *lbnd_out, const int *ubnd_out, \
                              const Xtype *in, const Xtype *in_var, \
-                             double infac, int npoint, const int *offset, \
+                             double infac, int npoint, const int64_t *offset, \
                              const double *const *coords, int flags, \
-                             Xtype badval, int npix_out, Xtype *out, \
+                             Xtype badval, int64_t npix_out, Xtype *out, \
                              Xtype *out_var, double *work, int64_t *nused, \
                              int *status ) { \
 \
@@ -19320,21 +23336,21 @@ static void SpreadNearest##X( int ndim_out, \
    double y;                     /* y coordinate value */ \
    double ymax;                  /* y upper limit */ \
    double ymin;                  /* y lower limit */ \
-   int *stride;                  /* Pointer to array of dimension strides */ \
    int bad;                      /* Output pixel bad? */ \
    int genvar;                   /* Generate output variances? */ \
    int idim;                     /* Loop counter for dimensions */ \
    int ix;                       /* Number of pixels offset in x direction */ \
    int ixn;                      /* Number of pixels offset (n-d) */ \
    int iy;                       /* Number of pixels offset in y direction */ \
-   int off_in;                   /* Pixel offset into input array */ \
-   int off_out;                  /* Pixel offset into output array */ \
    int point;                    /* Loop counter for output points */ \
-   int s;                        /* Temporary variable for strides */ \
    int usebad;                   /* Use "bad" input pixel values? */ \
    int usevar;                   /* Process variance array? */ \
    int varwgt;                   /* Use input variances as weights? */ \
-   int ystride;                  /* Stride along input grid y direction */ \
+   int64_t *stride;              /* Pointer to array of dimension strides */ \
+   int64_t off_in;               /* Pixel offset into input array */ \
+   int64_t off_out;              /* Pixel offset into output array */ \
+   int64_t s;                    /* Temporary variable for strides */ \
+   int64_t ystride;              /* Stride along input grid y direction */ \
 \
 /* Check the global error status. */ \
    if ( !astOK ) return; \
@@ -19463,7 +23479,7 @@ static void SpreadNearest##X( int ndim_out, \
    } else { \
 \
 /* Allocate workspace. */ \
-      stride = astMalloc( sizeof( int ) * (size_t) ndim_out ); \
+      stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_out ); \
       xn_max = astMalloc( sizeof( double ) * (size_t) ndim_out ); \
       xn_min = astMalloc( sizeof( double ) * (size_t) ndim_out ); \
       if ( astOK ) { \
@@ -19816,101 +23832,552 @@ MAKE_SPREAD_NEAREST(I,int,1)
 MAKE_SPREAD_NEAREST(B,char,1)
 MAKE_SPREAD_NEAREST(UB,unsigned char,1)
 
-/* Undefine the macros used above. */
-#undef NEAR_ND
-#undef NEAR_2D
-#undef NEAR_1D
-#undef MAKE_SPREAD_NEAREST
+/* Undefine the macros used above. */
+#undef NEAR_ND
+#undef NEAR_2D
+#undef NEAR_1D
+#undef MAKE_SPREAD_NEAREST
+
+
+
+
+
+
+static int TestAttrib( AstObject *this_object, const char *attrib, int *status ) {
+/*
+*  Name:
+*     TestAttrib
+
+*  Purpose:
+*     Test if a specified attribute value is set for a Mapping.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int TestAttrib( AstObject *this, const char *attrib, int *status )
+
+*  Class Membership:
+*     Mapping member function (over-rides the astTestAttrib protected
+*     method inherited from the Object class).
+
+*  Description:
+*     This function returns a boolean result (0 or 1) to indicate whether
+*     a value has been set for one of a Mapping's attributes.
+
+*  Parameters:
+*     this
+*        Pointer to the Mapping.
+*     attrib
+*        Pointer to a null terminated string specifying the attribute
+*        name.  This should be in lower case with no surrounding white
+*        space.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     One if a value has been set, otherwise zero.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstMapping *this;             /* Pointer to the Mapping structure */
+   int result;                   /* Result value to return */
+
+/* Initialise. */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Obtain a pointer to the Mapping structure. */
+   this = (AstMapping *) this_object;
+
+/* Check the attribute name and test the appropriate attribute. */
+
+/* Invert. */
+/* ------- */
+   if ( !strcmp( attrib, "invert" ) ) {
+      result = astTestInvert( this );
+
+/* Report. */
+/* ------- */
+   } else if ( !strcmp( attrib, "report" ) ) {
+      result = astTestReport( this );
+
+/* If the name is not recognised, test if it matches any of the
+   read-only attributes of this class. If it does, then return
+   zero. */
+   } else if ( !strcmp( attrib, "nin" ) ||
+        !strcmp( attrib, "islinear" ) ||
+        !strcmp( attrib, "issimple" ) ||
+        !strcmp( attrib, "nout" ) ||
+        !strcmp( attrib, "tranforward" ) ||
+        !strcmp( attrib, "traninverse" ) ) {
+      result = 0;
+
+/* If the attribute is still not recognised, pass it on to the parent
+   method for further interpretation. */
+   } else {
+      result = (*parent_testattrib)( this_object, attrib, status );
+   }
+
+/* Return the result, */
+   return result;
+}
+
+static void TileCacheFill( TileCache *cache, const int64_t lbnd[],
+                           const int64_t ubnd[], void *out, void *out_var,
+                           int *status ) {
+/*
+*  Name:
+*     TileCacheFill
+
+*  Purpose:
+*     Copy a box of input grid values from a tile cache.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void TileCacheFill( TileCache *cache, const int64_t lbnd[],
+*                         const int64_t ubnd[], void *out, void *out_var,
+*                         int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function copies the values in a box within the input grid
+*     into a contiguous array, obtaining each tile that overlaps the box
+*     from the supplied tile cache (see TileCacheGet). The tiles are
+*     visited in order, and each is copied as soon as it has been
+*     obtained, so the box may overlap more tiles than the cache can
+*     hold.
+
+*  Parameters:
+*     cache
+*        Pointer to the tile cache.
+*     lbnd
+*        The grid indices of the first pixel in the box. The box must
+*        lie within the input grid.
+*     ubnd
+*        The grid indices of the last pixel in the box.
+*     out
+*        An array in which to return the data values within the box,
+*        stored in the usual "Fortran" order.
+*     out_var
+*        An array in which to return the variances within the box. Only
+*        used if the cache holds variances.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   char *from;                   /* First tile value to copy */
+   char *to;                     /* First box value to copy to */
+   int64_t *hi;                  /* Upper bounds of tile/box overlap */
+   int64_t *itile;               /* Indices of current tile */
+   int64_t *lo;                  /* Lower bounds of tile/box overlap */
+   int64_t *pos;                 /* Position of current row */
+   int64_t *tlbnd;               /* Lower bounds of current tile */
+   int64_t *tubnd;               /* Upper bounds of current tile */
+   int64_t off_box;              /* Offset of row within box */
+   int64_t off_tile;             /* Offset of row within tile */
+   int64_t stride_box;           /* Stride of current axis within box */
+   int64_t stride_tile;          /* Stride of current axis within tile */
+   int done;                     /* All tiles visited? */
+   int idim;                     /* Axis index */
+   int islot;                    /* Cache slot holding current tile */
+   int ndim;                     /* Number of grid dimensions */
+   int nextrow;                  /* Found the next row? */
+   size_t nbyte;                 /* Number of bytes in each row */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Allocate work arrays. */
+   ndim = cache->ndim;
+   hi = astMalloc( sizeof( int64_t )*(size_t) ndim );
+   itile = astMalloc( sizeof( int64_t )*(size_t) ndim );
+   lo = astMalloc( sizeof( int64_t )*(size_t) ndim );
+   pos = astMalloc( sizeof( int64_t )*(size_t) ndim );
+   tlbnd = astMalloc( sizeof( int64_t )*(size_t) ndim );
+   tubnd = astMalloc( sizeof( int64_t )*(size_t) ndim );
+
+/* Start with the tile containing the first pixel of the box. */
+   if ( astOK ) {
+      for ( idim = 0; idim < ndim; idim++ ) {
+         itile[ idim ] = ( lbnd[ idim ] - cache->lbnd_in[ idim ] )/
+                         cache->tile[ idim ];
+      }
+   }
+
+/* Loop round every tile that overlaps the box. */
+   done = !astOK;
+   while ( !done ) {
+
+/* Obtain the tile, and find its overlap with the box. */
+      islot = TileCacheGet( cache, itile, tlbnd, tubnd, status );
+      if ( !astOK ) break;
+      for ( idim = 0; idim < ndim; idim++ ) {
+         lo[ idim ] = ( tlbnd[ idim ] > lbnd[ idim ] ) ? tlbnd[ idim ] :
+                                                         lbnd[ idim ];
+         hi[ idim ] = ( tubnd[ idim ] < ubnd[ idim ] ) ? tubnd[ idim ] :
+                                                         ubnd[ idim ];
+         pos[ idim ] = lo[ idim ];
+      }
+
+/* Copy each row of the overlap along the first axis from the tile to
+   the box. */
+      nbyte = cache->size*(size_t) ( hi[ 0 ] - lo[ 0 ] + 1 );
+      nextrow = 1;
+      while ( nextrow ) {
+         off_tile = 0;
+         off_box = 0;
+         stride_tile = 1;
+         stride_box = 1;
+         for ( idim = 0; idim < ndim; idim++ ) {
+            off_tile += ( pos[ idim ] - tlbnd[ idim ] )*stride_tile;
+            off_box += ( pos[ idim ] - lbnd[ idim ] )*stride_box;
+            stride_tile *= tubnd[ idim ] - tlbnd[ idim ] + 1;
+            stride_box *= ubnd[ idim ] - lbnd[ idim ] + 1;
+         }
+         from = cache->buf[ islot ] + cache->size*(size_t) off_tile;
+         to = (char *) out + cache->size*(size_t) off_box;
+         memcpy( to, from, nbyte );
+         if ( cache->buf_var ) {
+            from = cache->buf_var[ islot ] + cache->size*(size_t) off_tile;
+            to = (char *) out_var + cache->size*(size_t) off_box;
+            memcpy( to, from, nbyte );
+         }
+
+/* Move on to the next row. */
+         nextrow = 0;
+         for ( idim = 1; idim < ndim; idim++ ) {
+            if ( pos[ idim ] < hi[ idim ] ) {
+               pos[ idim ]++;
+               nextrow = 1;
+               break;
+            }
+            pos[ idim ] = lo[ idim ];
+         }
+      }
+
+/* Move on to the next tile that overlaps the box. */
+      done = 1;
+      for ( idim = 0; idim < ndim; idim++ ) {
+         if ( tubnd[ idim ] < ubnd[ idim ] ) {
+            itile[ idim ]++;
+            done = 0;
+            break;
+         }
+         itile[ idim ] = ( lbnd[ idim ] - cache->lbnd_in[ idim ] )/
+                         cache->tile[ idim ];
+      }
+   }
+
+/* Free the work arrays. */
+   hi = astFree( hi );
+   itile = astFree( itile );
+   lo = astFree( lo );
+   pos = astFree( pos );
+   tlbnd = astFree( tlbnd );
+   tubnd = astFree( tubnd );
+}
+
+static TileCache *TileCacheFree( TileCache *cache, int *status ) {
+/*
+*  Name:
+*     TileCacheFree
+
+*  Purpose:
+*     Free a tile cache.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     TileCache *TileCacheFree( TileCache *cache, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function frees all resources used by a tile cache created by
+*     TileCacheNew.
+
+*  Parameters:
+*     cache
+*        Pointer to the tile cache. May be NULL.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A NULL pointer.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*/
+
+/* Local Variables: */
+   int islot;                    /* Cache slot index */
+
+/* Check a cache was supplied. */
+   if ( !cache ) return NULL;
+
+/* Free the tile buffers. */
+   for ( islot = 0; islot < cache->ncache; islot++ ) {
+      if ( cache->buf ) cache->buf[ islot ] = astFree( cache->buf[ islot ] );
+      if ( cache->buf_var ) {
+         cache->buf_var[ islot ] = astFree( cache->buf_var[ islot ] );
+      }
+   }
+
+/* Free the arrays and the cache structure itself. */
+   cache->buf = astFree( cache->buf );
+   cache->buf_var = astFree( cache->buf_var );
+   cache->key = astFree( cache->key );
+   cache->ntile = astFree( cache->ntile );
+   cache->used = astFree( cache->used );
+   return astFree( cache );
+}
+
+static int TileCacheGet( TileCache *cache, const int64_t itile[],
+                         int64_t tlbnd[], int64_t tubnd[], int *status ) {
+/*
+*  Name:
+*     TileCacheGet
+
+*  Purpose:
+*     Ensure a tile is held in a tile cache.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int TileCacheGet( TileCache *cache, const int64_t itile[],
+*                       int64_t tlbnd[], int64_t tubnd[], int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function returns the index of the cache slot holding a
+*     given tile of the input grid. If the tile is not already in the
+*     cache, the user-supplied tile-fetching function is invoked to
+*     read it into the slot holding the least recently used tile.
+
+*  Parameters:
+*     cache
+*        Pointer to the tile cache.
+*     itile
+*        The zero-based index of the tile along each input axis.
+*     tlbnd
+*        Returned holding the grid indices of the first pixel in the
+*        tile.
+*     tubnd
+*        Returned holding the grid indices of the last pixel in the
+*        tile. Tiles at the upper edges of the input grid are clipped
+*        to the grid, and so may be smaller than other tiles.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The index of the cache slot holding the tile.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   int64_t key;                  /* Index of tile within whole grid */
+   int64_t stride;               /* Tile index stride for current axis */
+   int idim;                     /* Axis index */
+   int islot;                    /* Cache slot index */
+   int result;                   /* Returned slot index */
 
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Find the bounds of the tile, and its index within the grid of
+   tiles. */
+   key = 0;
+   stride = 1;
+   for ( idim = 0; idim < cache->ndim; idim++ ) {
+      tlbnd[ idim ] = cache->lbnd_in[ idim ] + itile[ idim ]*cache->tile[ idim ];
+      tubnd[ idim ] = tlbnd[ idim ] + cache->tile[ idim ] - 1;
+      if ( tubnd[ idim ] > cache->ubnd_in[ idim ] ) {
+         tubnd[ idim ] = cache->ubnd_in[ idim ];
+      }
+      key += itile[ idim ]*stride;
+      stride *= cache->ntile[ idim ];
+   }
 
+/* Search the cache for the tile, noting the least recently used slot
+   in case the tile is not found. */
+   result = 0;
+   for ( islot = 0; islot < cache->ncache; islot++ ) {
+      if ( cache->key[ islot ] == key ) break;
+      if ( cache->used[ islot ] < cache->used[ result ] ) result = islot;
+   }
 
+/* If the tile was found, use its slot. Otherwise, read the tile into
+   the least recently used slot, creating the slot's buffers if this
+   is the first time it has been used. The slot is left empty if the
+   tile cannot be read. */
+   if ( islot < cache->ncache ) {
+      result = islot;
+   } else {
+      if ( !cache->buf[ result ] ) {
+         cache->buf[ result ] = astMalloc( cache->size*cache->tsize );
+         if ( cache->buf_var ) {
+            cache->buf_var[ result ] = astMalloc( cache->size*cache->tsize );
+         }
+      }
+      cache->key[ result ] = -1;
+      if ( astOK ) {
+         ( *cache->fetch )( cache->data, cache->ndim, tlbnd, tubnd,
+                            cache->buf[ result ],
+                            cache->buf_var ? cache->buf_var[ result ] : NULL,
+                            status );
+      }
+      if ( astOK ) cache->key[ result ] = key;
+   }
 
+/* Record when the slot was last used. */
+   cache->used[ result ] = ++( cache->clock );
 
+/* Return the result. */
+   return astOK ? result : 0;
+}
 
-static int TestAttrib( AstObject *this_object, const char *attrib, int *status ) {
+static TileCache *TileCacheNew( int ndim, const int64_t lbnd_in[],
+                                const int64_t ubnd_in[], const int tile[],
+                                AstTileFun fetch, void *data, int ncache,
+                                size_t size, int usevar, int *status ) {
 /*
 *  Name:
-*     TestAttrib
+*     TileCacheNew
 
 *  Purpose:
-*     Test if a specified attribute value is set for a Mapping.
+*     Create an empty tile cache.
 
 *  Type:
 *     Private function.
 
 *  Synopsis:
 *     #include "mapping.h"
-*     int TestAttrib( AstObject *this, const char *attrib, int *status )
+*     TileCache *TileCacheNew( int ndim, const int64_t lbnd_in[],
+*                              const int64_t ubnd_in[], const int tile[],
+*                              AstTileFun fetch, void *data, int ncache,
+*                              size_t size, int usevar, int *status )
 
 *  Class Membership:
-*     Mapping member function (over-rides the astTestAttrib protected
-*     method inherited from the Object class).
+*     Mapping member function.
 
 *  Description:
-*     This function returns a boolean result (0 or 1) to indicate whether
-*     a value has been set for one of a Mapping's attributes.
+*     This function creates a cache that holds up to "ncache" tiles of
+*     an input grid, obtaining each tile when it is first needed from a
+*     user-supplied tile-fetching function (see astResampleTiled<X>).
+*     The memory for each tile is allocated when the tile is first
+*     read.
 
 *  Parameters:
-*     this
-*        Pointer to the Mapping.
-*     attrib
-*        Pointer to a null terminated string specifying the attribute
-*        name.  This should be in lower case with no surrounding white
-*        space.
+*     ndim
+*        The number of dimensions in the input grid.
+*     lbnd_in
+*        The grid indices of the first pixel in the input grid. A
+*        pointer to this array is stored in the cache, so it must not
+*        be freed until the cache is freed.
+*     ubnd_in
+*        The grid indices of the last pixel in the input grid. A
+*        pointer to this array is stored in the cache.
+*     tile
+*        The number of pixels along each edge of a tile. A pointer to
+*        this array is stored in the cache.
+*     fetch
+*        Pointer to the function that obtains the values in a tile.
+*     data
+*        The pointer to pass to "fetch".
+*     ncache
+*        The maximum number of tiles to hold in the cache.
+*     size
+*        The number of bytes in each data value.
+*     usevar
+*        Should variances be obtained as well as data values?
 *     status
 *        Pointer to the inherited status variable.
 
 *  Returned Value:
-*     One if a value has been set, otherwise zero.
+*     A pointer to the new cache, which should be freed using
+*     TileCacheFree when no longer needed.
 
 *  Notes:
-*     - A value of zero will be returned if this function is invoked
-*     with the global status set, or if it should fail for any reason.
+*     - A NULL pointer is returned if this function is invoked with the
+*     global error status set, or if it should fail for any reason.
 */
 
 /* Local Variables: */
-   AstMapping *this;             /* Pointer to the Mapping structure */
-   int result;                   /* Result value to return */
-
-/* Initialise. */
-   result = 0;
+   TileCache *result;            /* Returned cache */
+   int idim;                     /* Axis index */
+   int islot;                    /* Cache slot index */
 
 /* Check the global error status. */
-   if ( !astOK ) return result;
-
-/* Obtain a pointer to the Mapping structure. */
-   this = (AstMapping *) this_object;
-
-/* Check the attribute name and test the appropriate attribute. */
-
-/* Invert. */
-/* ------- */
-   if ( !strcmp( attrib, "invert" ) ) {
-      result = astTestInvert( this );
+   if ( !astOK ) return NULL;
 
-/* Report. */
-/* ------- */
-   } else if ( !strcmp( attrib, "report" ) ) {
-      result = astTestReport( this );
+/* Allocate the cache structure and store the supplied values. */
+   result = astMalloc( sizeof( TileCache ) );
+   if ( astOK ) {
+      result->fetch = fetch;
+      result->data = data;
+      result->lbnd_in = lbnd_in;
+      result->ubnd_in = ubnd_in;
+      result->tile = tile;
+      result->ncache = ncache;
+      result->ndim = ndim;
+      result->size = size;
+      result->clock = 0;
+
+/* Find the number of tiles along each axis, and the number of pixels
+   in a tile. */
+      result->ntile = astMalloc( sizeof( int64_t )*(size_t) ndim );
+      result->tsize = 1;
+      if ( astOK ) {
+         for ( idim = 0; idim < ndim; idim++ ) {
+            result->ntile[ idim ] = ( ubnd_in[ idim ] - lbnd_in[ idim ] )/
+                                    tile[ idim ] + 1;
+            result->tsize *= (size_t) tile[ idim ];
+         }
+      }
 
-/* If the name is not recognised, test if it matches any of the
-   read-only attributes of this class. If it does, then return
-   zero. */
-   } else if ( !strcmp( attrib, "nin" ) ||
-        !strcmp( attrib, "islinear" ) ||
-        !strcmp( attrib, "issimple" ) ||
-        !strcmp( attrib, "nout" ) ||
-        !strcmp( attrib, "tranforward" ) ||
-        !strcmp( attrib, "traninverse" ) ) {
-      result = 0;
+/* Create the cache slots, all initially empty. */
+      result->buf = astCalloc( ncache, sizeof( char * ) );
+      result->buf_var = usevar ? astCalloc( ncache, sizeof( char * ) ) : NULL;
+      result->key = astMalloc( sizeof( int64_t )*(size_t) ncache );
+      result->used = astMalloc( sizeof( int64_t )*(size_t) ncache );
+      if ( astOK ) {
+         for ( islot = 0; islot < ncache; islot++ ) {
+            result->key[ islot ] = -1;
+            result->used[ islot ] = 0;
+         }
+      }
 
-/* If the attribute is still not recognised, pass it on to the parent
-   method for further interpretation. */
-   } else {
-      result = (*parent_testattrib)( this_object, attrib, status );
+/* Free the cache if anything went wrong. */
+      if ( !astOK ) result = TileCacheFree( result, status );
    }
 
-/* Return the result, */
+/* Return the result. */
    return result;
 }
 
@@ -19995,9 +24462,12 @@ f        The global status.
       in_ptr[ 0 ] = xin;
       out_ptr[ 0 ] = xout;
 
-/* Create PointSets to describe the input and output points. */
-      in_points = astPointSet( npoint, 1, "", status );
-      out_points = astPointSet( npoint, 1, "", status );
+/* Obtain scratch PointSets to describe the input and output points.
+   These are re-used from previous calls where possible, to avoid the
+   cost of creating new PointSets when transforming small numbers of
+   points. */
+      in_points = astScratchPointSet( npoint, 1, NULL, 0 );
+      out_points = astScratchPointSet( npoint, 1, NULL, 0 );
 
 /* Associate the data pointers with the PointSets (note we must
    explicitly remove the "const" qualifier from the input data here,
@@ -20013,9 +24483,9 @@ f        The global status.
       if ( astGetReport( this ) ) astReportPoints( this, forward,
                                                    in_points, out_points );
 
-/* Delete the two PointSets. */
-      in_points = astDelete( in_points );
-      out_points = astDelete( out_points );
+/* Return the two PointSets to the pool for re-use. */
+      in_points = astRecyclePointSet( in_points );
+      out_points = astRecyclePointSet( out_points );
    }
 }
 
@@ -20114,9 +24584,12 @@ f        The global status.
       out_ptr[ 0 ] = xout;
       out_ptr[ 1 ] = yout;
 
-/* Create PointSets to describe the input and output points. */
-      in_points = astPointSet( npoint, 2, "", status );
-      out_points = astPointSet( npoint, 2, "", status );
+/* Obtain scratch PointSets to describe the input and output points.
+   These are re-used from previous calls where possible, to avoid the
+   cost of creating new PointSets when transforming small numbers of
+   points. */
+      in_points = astScratchPointSet( npoint, 2, NULL, 0 );
+      out_points = astScratchPointSet( npoint, 2, NULL, 0 );
 
 /* Associate the data pointers with the PointSets (note we must
    explicitly remove the "const" qualifier from the input data here,
@@ -20132,15 +24605,16 @@ f        The global status.
       if ( astGetReport( this ) ) astReportPoints( this, forward,
                                                    in_points, out_points );
 
-/* Delete the two PointSets. */
-      in_points = astDelete( in_points );
-      out_points = astDelete( out_points );
+/* Return the two PointSets to the pool for re-use. */
+      in_points = astRecyclePointSet( in_points );
+      out_points = astRecyclePointSet( out_points );
    }
 }
 
 static void TranGrid( AstMapping *this, int ncoord_in, const int lbnd[],
                       const int ubnd[], double tol, int maxpix, int forward,
-                      int ncoord_out, int outdim, double *out, int *status ) {
+                      int ncoord_out, int64_t outdim, double *out,
+                      int *status ) {
 /*
 *++
 *  Name:
@@ -20307,6 +24781,11 @@ f     Mapping supplied must have the value of NCOORD_IN for its Nin
 f     attribute and the value of NCOORD_OUT for its Nout attribute. If
 f     the inverse transformation is being applied, these values should
 f     be reversed.
+c     - If the grid contains more than 2147483647 points (the largest
+c     value that can be stored in an "int"), astTranGrid8 should be used
+c     instead. This has the same arguments, except that "lbnd" and "ubnd"
+c     are of type "const int64_t[]" and "outdim" is of type "int64_t".
+c     Each individual bound must still lie within the range of an "int".
 *--
 */
 
@@ -20316,8 +24795,7 @@ f     be reversed.
    double **out_ptr;             /* Pointer to array of output data pointers */
    int coord;                    /* Loop counter for coordinates */
    int idim;                     /* Loop counter for coordinate dimensions */
-   int npoint;                   /* Number of points in the grid */
-   int64_t mpix;                 /* Number of points for testing */
+   int64_t npoint;               /* Number of points in the grid */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -20328,7 +24806,7 @@ f     be reversed.
 /* Calculate the number of points in the grid, and check that the lower and
    upper bounds of the input grid are consistent. Report an error if any
    pair is not. */
-   mpix = 1;
+   npoint = 1;
    for ( idim = 0; idim < ncoord_in; idim++ ) {
       if ( lbnd[ idim ] > ubnd[ idim ] ) {
          astError( AST__GBDIN, "astTranGrid(%s): Lower bound of "
@@ -20339,29 +24817,15 @@ f     be reversed.
                    idim + 1 );
          break;
       } else {
-         mpix *= ubnd[ idim ] - lbnd[ idim ] + 1;
+         npoint *= ubnd[ idim ] - lbnd[ idim ] + 1;
       }
    }
 
-/* Report an error if there are too many pixels in the input. */
-   npoint = mpix;
-   if ( astOK && npoint != mpix ) {
-      astError( AST__EXSPIX, "astTranGrid(%s): Supplied grid "
-                "contains too many points (%zu): must be fewer than %d.",
-                status, astGetClass( this ), mpix, INT_MAX/ncoord_out );
-   }
-
-   mpix = outdim*ncoord_out;
-   if ( astOK && (int) mpix != mpix ) {
-      astError( AST__EXSPIX, "astTranGrid(%s): Supplied output array "
-                "contains too many pixels (%zu): must be fewer than %d.",
-                status, astGetClass( this ), mpix, INT_MAX );
-   }
-
-
-/* Validate the mapping and numbers of points/coordinates. */
-   ValidateMapping( this, forward, npoint, ncoord_in, ncoord_out,
-                    "astTranGrid", status );
+/* Validate the mapping and numbers of points/coordinates. The grid is
+   transformed in blocks, so the total number of points may exceed the
+   range of an int. */
+   ValidateMapping( this, forward, ( npoint < INT_MAX ) ? (int) npoint :
+                    INT_MAX, ncoord_in, ncoord_out, "astTranGrid", status );
 
 /* Check that the positional accuracy tolerance supplied is valid and
    report an error if necessary. */
@@ -20383,9 +24847,11 @@ f     be reversed.
 /* Validate the output array dimension argument. */
    if ( astOK && ( outdim < npoint ) ) {
       astError( AST__DIMIN, "astTranGrid(%s): The output array dimension value "
-                "(%d) is invalid.", status, astGetClass( this ), outdim );
+                "(%lld) is invalid.", status, astGetClass( this ),
+                (long long int) outdim );
       astError( AST__DIMIN, "This should not be less than the number of "
-                "grid points being transformed (%d).", status, npoint );
+                "grid points being transformed (%lld).", status,
+                (long long int) npoint );
    }
 
 /* If there are sufficient pixels to make it worthwhile, simplify the
@@ -20447,6 +24913,62 @@ f     be reversed.
    }
 }
 
+static void TranGrid8( AstMapping *this, int ncoord_in, const int64_t lbnd[],
+                       const int64_t ubnd[], double tol, int maxpix,
+                       int forward, int ncoord_out, int64_t outdim,
+                       double *out, int *status ) {
+/*
+*  Name:
+*     TranGrid8
+
+*  Purpose:
+*     Transform a grid of positions, using 64-bit grid bounds.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     void TranGrid8( AstMapping *this, int ncoord_in,
+*                     const int64_t lbnd[], const int64_t ubnd[],
+*                     double tol, int maxpix, int forward,
+*                     int ncoord_out, int64_t outdim, double *out )
+
+*  Class Membership:
+*     Mapping member function (over-rides the astTranGrid8 protected
+*     method inherited from the Mapping class).
+
+*  Description:
+*     This function implements the astTranGrid8 method, which is also
+*     used by astTranGrid. It checks that the supplied bounds can be
+*     represented as type int, and then uses TranGrid to transform the
+*     grid. See astTranGrid for a description of the arguments.
+*/
+
+/* Local Variables: */
+   int *lbnd32;                  /* Lower grid bounds as int */
+   int *ubnd32;                  /* Upper grid bounds as int */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Take int copies of the bounds, checking each can be represented. */
+   lbnd32 = NarrowBounds( ncoord_in, lbnd, "astTranGrid8",
+                          astGetClass( this ), status );
+   ubnd32 = NarrowBounds( ncoord_in, ubnd, "astTranGrid8",
+                          astGetClass( this ), status );
+
+/* Transform the grid. */
+   if ( astOK ) {
+      TranGrid( this, ncoord_in, lbnd32, ubnd32, tol, maxpix, forward,
+                ncoord_out, outdim, out, status );
+   }
+
+/* Free the copies. */
+   lbnd32 = astFree( lbnd32 );
+   ubnd32 = astFree( ubnd32 );
+}
+
 static void TranGridAdaptively( AstMapping *this, int ncoord_in,
                                 const int *lbnd_in, const int *ubnd_in,
                                 const int lbnd[], const int ubnd[],
@@ -20593,11 +25115,11 @@ static void TranGridAdaptively( AstMapping *this, int ncoord_in,
    int i;                        /* Loop count */
    int isLinear;                 /* Is the transformation linear? */
    int mxdim;                    /* Largest output section dimension size */
-   int npix;                     /* Number of pixels in output section */
    int npoint;                   /* Number of points for obtaining a fit */
    int nvertex;                  /* Number of vertices of output section */
    int toobig;                   /* Section too big (must sub-divide)? */
    int toosmall;                 /* Section too small to sub-divide? */
+   int64_t npix;                 /* Number of pixels in output section */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -20876,8 +25398,6 @@ static void TranGridSection( AstMapping *this, const double *linear_fit,
    double y1;                    /* Interim y coordinate value */
    double yy1;                   /* Initial y coordinate value */
    int *dim;                     /* Pointer to array of output pixel indices */
-   int *offset;                  /* Pointer to array of output pixel offsets */
-   int *stride;                  /* Pointer to array of output grid strides */
    int coord_in;                 /* Loop counter for input dimensions */
    int coord_out;                /* Loop counter for output dimensions */
    int done;                     /* All pixel indices done? */
@@ -20887,11 +25407,13 @@ static void TranGridSection( AstMapping *this, const double *linear_fit,
    int ix;                       /* Loop counter for output x coordinate */
    int iy;                       /* Loop counter for output y coordinate */
    int npoint;                   /* Number of output points (pixels) */
-   int off1;                     /* Interim pixel offset into output array */
-   int off2;                     /* Interim pixel offset into output array */
-   int off;                      /* Final pixel offset into output array */
    int point;                    /* Counter for output points (pixels ) */
-   int s;                        /* Temporary variable for strides */
+   int64_t *offset;              /* Pointer to array of output pixel offsets */
+   int64_t *stride;              /* Pointer to array of output grid strides */
+   int64_t off;                  /* Final pixel offset into output array */
+   int64_t off1;                 /* Interim pixel offset into output array */
+   int64_t off2;                 /* Interim pixel offset into output array */
+   int64_t s;                    /* Temporary variable for strides */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -20909,8 +25431,8 @@ static void TranGridSection( AstMapping *this, const double *linear_fit,
    }
 
 /* Allocate workspace. */
-   offset = astMalloc( sizeof( int ) * (size_t) npoint );
-   stride = astMalloc( sizeof( int ) * (size_t) ndim_in );
+   offset = astMalloc( sizeof( int64_t ) * (size_t) npoint );
+   stride = astMalloc( sizeof( int64_t ) * (size_t) ndim_in );
    if ( astOK ) {
 
 /* Calculate the stride for each input grid dimension. */
@@ -21356,7 +25878,7 @@ static void TranGridWithBlocking( AstMapping *this, const double *linear_fit,
    int idim;                     /* Loop counter for dimensions */
    int lolim;                    /* Lower limit on maximum block dimension */
    int mxdim_block;              /* Maximum block dimension */
-   int npix;                     /* Number of pixels in block */
+   int64_t npix;                 /* Number of pixels in block */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -21616,9 +26138,6 @@ f     be reversed.
 /* Local Variables: */
    AstPointSet *in_points;       /* Pointer to input PointSet */
    AstPointSet *out_points;      /* Pointer to output PointSet */
-   const double **in_ptr;        /* Pointer to array of input data pointers */
-   double **out_ptr;             /* Pointer to array of output data pointers */
-   int coord;                    /* Loop counter for coordinates */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -21642,13 +26161,13 @@ f     be reversed.
                 "points being transformed (%d).", status, npoint );
    }
 
-/* Allocate memory to hold the arrays of input and output data
-   pointers. */
+/* Obtain scratch PointSets to describe the input and output points,
+   with their coordinate pointers locating the data in the "in" and "out"
+   arrays. These are re-used from previous calls where possible, so that
+   no memory need be allocated when transforming small numbers of points
+   (note we must explicitly remove the "const" qualifier from the input
+   data here, although they will not be modified). */
    if ( astOK ) {
-      in_ptr = (const double **) astMalloc( sizeof( const double * ) *
-                                            (size_t) ncoord_in );
-      out_ptr = astMalloc( sizeof( double * ) * (size_t) ncoord_out );
-
 
 #ifdef DEBUG
       { int i, ns;
@@ -21657,46 +26176,21 @@ f     be reversed.
       }
 #endif
 
-
-/* Initialise the input data pointers to locate the coordinate data in
-   the "in" array. */
-      if ( astOK ) {
-         for ( coord = 0; coord < ncoord_in; coord++ ) {
-            in_ptr[ coord ] = in + coord * indim;
-         }
-
-/* Similarly initialise the output data pointers to point into the
-   "out" array. */
-         for ( coord = 0; coord < ncoord_out; coord++ ) {
-            out_ptr[ coord ] = out + coord * outdim;
-         }
-
-/* Create PointSets to describe the input and output points. */
-         in_points = astPointSet( npoint, ncoord_in, "", status );
-         out_points = astPointSet( npoint, ncoord_out, "", status );
-
-/* Associate the data pointers with the PointSets (note we must
-   explicitly remove the "const" qualifier from the input data here,
-   although they will not be modified).  */
-         astSetPoints( in_points, (double **) in_ptr );
-         astSetPoints( out_points, out_ptr );
+      in_points = astScratchPointSet( npoint, ncoord_in, (double *) in,
+                                      indim );
+      out_points = astScratchPointSet( npoint, ncoord_out, out, outdim );
 
 /* Apply the required transformation to the coordinates. */
-         (void) astTransform( this, in_points, forward, out_points );
+      (void) astTransform( this, in_points, forward, out_points );
 
 /* If the Mapping's Report attribute is set, report the effect the
    Mapping has had on the coordinates. */
-         if ( astGetReport( this ) ) astReportPoints( this, forward,
-                                                      in_points, out_points );
-
-/* Delete the two PointSets. */
-         in_points = astDelete( in_points );
-         out_points = astDelete( out_points );
-      }
+      if ( astGetReport( this ) ) astReportPoints( this, forward,
+                                                   in_points, out_points );
 
-/* Free the memory used for the data pointers. */
-      in_ptr = (const double **) astFree( (void *) in_ptr );
-      out_ptr = astFree( out_ptr );
+/* Return the two PointSets to the pool for re-use. */
+      in_points = astRecyclePointSet( in_points );
+      out_points = astRecyclePointSet( out_points );
    }
 }
 
@@ -21792,10 +26286,13 @@ c--
 /* Validate the Mapping and number of points/coordinates. */
    ValidateMapping( this, forward, npoint, ncoord_in, ncoord_out, "astTranP", status );
 
-/* Create PointSets to describe the input and output points. */
+/* Obtain scratch PointSets to describe the input and output points.
+   These are re-used from previous calls where possible, to avoid the
+   cost of creating new PointSets when transforming small numbers of
+   points. */
    if ( astOK ) {
-      in_points = astPointSet( npoint, ncoord_in, "", status );
-      out_points = astPointSet( npoint, ncoord_out, "", status );
+      in_points = astScratchPointSet( npoint, ncoord_in, NULL, 0 );
+      out_points = astScratchPointSet( npoint, ncoord_out, NULL, 0 );
 
 /* Associate the data pointers with the PointSets (note we must
    explicitly remove the "const" qualifier from the input data here,
@@ -21811,9 +26308,9 @@ c--
       if ( astGetReport( this ) ) astReportPoints( this, forward,
                                                    in_points, out_points );
 
-/* Delete the two PointSets. */
-      in_points = astDelete( in_points );
-      out_points = astDelete( out_points );
+/* Return the two PointSets to the pool for re-use. */
+      in_points = astRecyclePointSet( in_points );
+      out_points = astRecyclePointSet( out_points );
    }
 }
 
@@ -22784,6 +27281,138 @@ static void ValidateMapping( AstMapping *this, int forward,
    }
 }
 
+static int64_t *WidenBounds( int n, const int *bnd, int *status ) {
+/*
+*  Name:
+*     WidenBounds
+
+*  Purpose:
+*     Copy an array of int grid bounds into an array of int64_t.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     int64_t *WidenBounds( int n, const int *bnd, int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function returns a copy of an array of grid bounds supplied
+*     to one of the int methods (e.g. astResample<X>), converted to type
+*     int64_t so that it can be passed on to the corresponding 64-bit
+*     method (e.g. astResample8<X>).
+
+*  Parameters:
+*     n
+*        The number of elements in "bnd".
+*     bnd
+*        The bounds to copy.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the new array, which should be freed using astFree
+*     when no longer needed.
+
+*  Notes:
+*     - A NULL pointer is returned if this function is invoked with the
+*     global error status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   int64_t *result;              /* Returned array */
+   int i;                        /* Element index */
+
+/* Allocate the returned array and copy the bounds into it. */
+   result = astMalloc( sizeof( int64_t )*(size_t) n );
+   if ( astOK ) {
+      for ( i = 0; i < n; i++ ) result[ i ] = bnd[ i ];
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static AstMapping **WorkerMappings( AstMapping *this, int nworker,
+                                    int *status ) {
+/*
+*  Name:
+*     WorkerMappings
+
+*  Purpose:
+*     Create a separate Mapping for each worker thread.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mapping.h"
+*     AstMapping **WorkerMappings( AstMapping *this, int nworker,
+*                                  int *status )
+
+*  Class Membership:
+*     Mapping member function.
+
+*  Description:
+*     This function returns an array holding a pointer to a Mapping for
+*     each of the worker threads used by astRunTasks. Transforming
+*     positions may modify a Mapping (for instance, by temporarily
+*     inverting it, or by caching intermediate values), so each worker
+*     needs its own Mapping.
+*
+*     The first element is a clone of the supplied Mapping, for use by
+*     the calling thread (worker zero). The other elements are deep
+*     copies that have been unlocked so that they can be locked by the
+*     worker threads that use them (see astManageLock).
+
+*  Parameters:
+*     this
+*        Pointer to the Mapping.
+*     nworker
+*        The number of workers.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to a dynamically allocated array of "nworker" Mapping
+*     pointers. It should be freed using FreeWorkerMappings when no longer
+*     needed.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   AstMapping **result;          /* Returned array */
+   int iworker;                  /* Worker index */
+
+/* Check the global error status. */
+   if ( !astOK || nworker < 1 ) return NULL;
+
+/* Allocate the returned array, initialised to hold NULL pointers. */
+   result = astCalloc( nworker, sizeof( AstMapping * ) );
+   if( astOK ) {
+
+/* Store the Mapping for each worker. */
+      result[ 0 ] = astClone( this );
+      for( iworker = 1; iworker < nworker && astOK; iworker++ ) {
+         result[ iworker ] = astCopy( this );
+         if( astOK ) astManageLock( result[ iworker ], AST__UNLOCK, 1, NULL );
+      }
+   }
+
+/* Free the array if anything went wrong. */
+   if( !astOK ) result = FreeWorkerMappings( result, nworker, status );
+
+/* Return the result. */
+   return result;
+}
+
 /* Functions which access class attributes. */
 /* ---------------------------------------- */
 /* Implement member functions to access the attributes associated with
@@ -23764,6 +28393,21 @@ int astMapList_( AstMapping *this, int series, int invert, int *nmap,
    return (**astMEMBER(this,Mapping,MapList))( this, series, invert,
                                         nmap, map_list, invert_list, status );
 }
+int astResampleWeights_( AstMapping *this, int ndim_in, const int lbnd_in[],
+                         const int ubnd_in[], int interp,
+                         const double params[], double tol, int maxpix,
+                         int ndim_out, const int lbnd_out[],
+                         const int ubnd_out[], const int lbnd[],
+                         const int ubnd[], int **outpix, int **centre,
+                         int **start, int **inpix, double **weight,
+                         int *status ) {
+   if ( !astOK ) return 0;
+   return (**astMEMBER(this,Mapping,ResampleWeights))( this, ndim_in,
+                                        lbnd_in, ubnd_in, interp, params,
+                                        tol, maxpix, ndim_out, lbnd_out,
+                                        ubnd_out, lbnd, ubnd, outpix, centre,
+                                        start, inpix, weight, status );
+}
 int *astMapSplit_( AstMapping *this, int nin, const int *in, AstMapping **map,
                    int *status ){
    int *result = NULL;
@@ -23807,15 +28451,65 @@ int astResample##X##_( AstMapping *this, int ndim_in, const int *lbnd_in, \
                        const int *lbnd_out, const int *ubnd_out, \
                        const int *lbnd, const int *ubnd, Xtype *out, \
                        Xtype *out_var, int *status ) { \
+   int64_t *lbnd8; \
+   int64_t *lbnd_in8; \
+   int64_t *lbnd_out8; \
+   int64_t *ubnd8; \
+   int64_t *ubnd_in8; \
+   int64_t *ubnd_out8; \
+   int64_t result; \
    if ( !astOK ) return 0; \
-   return (**astMEMBER(this,Mapping,Resample##X))( this, ndim_in, lbnd_in, \
-                                                   ubnd_in, in, in_var, \
+   lbnd_in8 = WidenBounds( ndim_in, lbnd_in, status ); \
+   ubnd_in8 = WidenBounds( ndim_in, ubnd_in, status ); \
+   lbnd_out8 = WidenBounds( ndim_out, lbnd_out, status ); \
+   ubnd_out8 = WidenBounds( ndim_out, ubnd_out, status ); \
+   lbnd8 = WidenBounds( ndim_out, lbnd, status ); \
+   ubnd8 = WidenBounds( ndim_out, ubnd, status ); \
+   result = 0; \
+   if ( astOK ) { \
+      result = (**astMEMBER(this,Mapping,Resample8##X))( this, ndim_in, \
+                                                   lbnd_in8, ubnd_in8, \
+                                                   in, in_var, \
                                                    interp, finterp, params, \
                                                    flags, tol, maxpix, \
                                                    badval, ndim_out, \
-                                                   lbnd_out, ubnd_out, \
-                                                   lbnd, ubnd, \
+                                                   lbnd_out8, ubnd_out8, \
+                                                   lbnd8, ubnd8, \
                                                    out, out_var, status ); \
+   } \
+   lbnd_in8 = astFree( lbnd_in8 ); \
+   ubnd_in8 = astFree( ubnd_in8 ); \
+   lbnd_out8 = astFree( lbnd_out8 ); \
+   ubnd_out8 = astFree( ubnd_out8 ); \
+   lbnd8 = astFree( lbnd8 ); \
+   ubnd8 = astFree( ubnd8 ); \
+   if ( astOK && result > INT_MAX ) { \
+      astError( AST__EXSPIX, "astResample"#X"(%s): The number of bad " \
+                "output pixels (%lld) is too large to be returned as an " \
+                "int - use astResample8"#X" instead.", status, \
+                astGetClass( this ), (long long int) result ); \
+   } \
+   return astOK ? (int) result : 0; \
+} \
+int64_t astResample8##X##_( AstMapping *this, int ndim_in, \
+                            const int64_t *lbnd_in, const int64_t *ubnd_in, \
+                            const Xtype *in, const Xtype *in_var, \
+                            int interp, void (* finterp)( void ), \
+                            const double *params, int flags, double tol, \
+                            int maxpix, Xtype badval, int ndim_out, \
+                            const int64_t *lbnd_out, \
+                            const int64_t *ubnd_out, \
+                            const int64_t *lbnd, const int64_t *ubnd, \
+                            Xtype *out, Xtype *out_var, int *status ) { \
+   if ( !astOK ) return 0; \
+   return (**astMEMBER(this,Mapping,Resample8##X))( this, ndim_in, lbnd_in, \
+                                                    ubnd_in, in, in_var, \
+                                                    interp, finterp, params, \
+                                                    flags, tol, maxpix, \
+                                                    badval, ndim_out, \
+                                                    lbnd_out, ubnd_out, \
+                                                    lbnd, ubnd, \
+                                                    out, out_var, status ); \
 }
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
 MAKE_RESAMPLE_(LD,long double)
@@ -23834,6 +28528,41 @@ MAKE_RESAMPLE_(B,signed char)
 MAKE_RESAMPLE_(UB,unsigned char)
 #undef MAKE_RESAMPLE_
 
+#define MAKE_RESAMPLETILED_(X,Xtype) \
+int64_t astResampleTiled##X##_( AstMapping *this, int ndim_in, \
+                                const int64_t *lbnd_in, \
+                                const int64_t *ubnd_in, const int *tile, \
+                                AstTileFun fetch, void *data, int ncache, \
+                                int interp, void (* finterp)( void ), \
+                                const double *params, int flags, \
+                                double tol, int maxpix, Xtype badval, \
+                                int ndim_out, const int64_t *lbnd_out, \
+                                const int64_t *ubnd_out, \
+                                const int64_t *lbnd, const int64_t *ubnd, \
+                                Xtype *out, Xtype *out_var, int *status ) { \
+   if ( !astOK ) return 0; \
+   return ResampleTiled( this, ndim_in, lbnd_in, ubnd_in, tile, fetch, \
+                         data, ncache, TYPE_##X, interp, finterp, params, \
+                         flags, tol, maxpix, &badval, ndim_out, lbnd_out, \
+                         ubnd_out, lbnd, ubnd, out, out_var, status ); \
+}
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_RESAMPLETILED_(LD,long double)
+#endif
+MAKE_RESAMPLETILED_(D,double)
+MAKE_RESAMPLETILED_(F,float)
+MAKE_RESAMPLETILED_(L,long int)
+MAKE_RESAMPLETILED_(UL,unsigned long int)
+MAKE_RESAMPLETILED_(I,int)
+MAKE_RESAMPLETILED_(UI,unsigned int)
+MAKE_RESAMPLETILED_(K,INT_BIG)
+MAKE_RESAMPLETILED_(UK,UINT_BIG)
+MAKE_RESAMPLETILED_(S,short int)
+MAKE_RESAMPLETILED_(US,unsigned short int)
+MAKE_RESAMPLETILED_(B,signed char)
+MAKE_RESAMPLETILED_(UB,unsigned char)
+#undef MAKE_RESAMPLETILED_
+
 #define MAKE_REBIN_(X,Xtype) \
 void astRebin##X##_( AstMapping *this, double wlim, int ndim_in, const int *lbnd_in, \
                     const int *ubnd_in, const Xtype *in, \
@@ -23844,15 +28573,53 @@ void astRebin##X##_( AstMapping *this, double wlim, int ndim_in, const int *lbnd
                     const int *lbnd_out, const int *ubnd_out, \
                     const int *lbnd, const int *ubnd, Xtype *out, \
                     Xtype *out_var, int *status ) { \
+   int64_t *lbnd8; \
+   int64_t *lbnd_in8; \
+   int64_t *lbnd_out8; \
+   int64_t *ubnd8; \
+   int64_t *ubnd_in8; \
+   int64_t *ubnd_out8; \
    if ( !astOK ) return; \
-   (**astMEMBER(this,Mapping,Rebin##X))( this, wlim, ndim_in, lbnd_in, \
-                                         ubnd_in, in, in_var, \
+   lbnd_in8 = WidenBounds( ndim_in, lbnd_in, status ); \
+   ubnd_in8 = WidenBounds( ndim_in, ubnd_in, status ); \
+   lbnd_out8 = WidenBounds( ndim_out, lbnd_out, status ); \
+   ubnd_out8 = WidenBounds( ndim_out, ubnd_out, status ); \
+   lbnd8 = WidenBounds( ndim_in, lbnd, status ); \
+   ubnd8 = WidenBounds( ndim_in, ubnd, status ); \
+   if ( astOK ) { \
+      (**astMEMBER(this,Mapping,Rebin8##X))( this, wlim, ndim_in, lbnd_in8, \
+                                         ubnd_in8, in, in_var, \
                                          interp, params, \
                                          flags, tol, maxpix, \
                                          badval, ndim_out, \
-                                         lbnd_out, ubnd_out, \
-                                         lbnd, ubnd, \
+                                         lbnd_out8, ubnd_out8, \
+                                         lbnd8, ubnd8, \
                                          out, out_var, status ); \
+   } \
+   lbnd_in8 = astFree( lbnd_in8 ); \
+   ubnd_in8 = astFree( ubnd_in8 ); \
+   lbnd_out8 = astFree( lbnd_out8 ); \
+   ubnd_out8 = astFree( ubnd_out8 ); \
+   lbnd8 = astFree( lbnd8 ); \
+   ubnd8 = astFree( ubnd8 ); \
+} \
+void astRebin8##X##_( AstMapping *this, double wlim, int ndim_in, \
+                      const int64_t *lbnd_in, const int64_t *ubnd_in, \
+                      const Xtype *in, const Xtype *in_var, int interp, \
+                      const double *params, int flags, double tol, \
+                      int maxpix, Xtype badval, int ndim_out, \
+                      const int64_t *lbnd_out, const int64_t *ubnd_out, \
+                      const int64_t *lbnd, const int64_t *ubnd, Xtype *out, \
+                      Xtype *out_var, int *status ) { \
+   if ( !astOK ) return; \
+   (**astMEMBER(this,Mapping,Rebin8##X))( this, wlim, ndim_in, lbnd_in, \
+                                          ubnd_in, in, in_var, \
+                                          interp, params, \
+                                          flags, tol, maxpix, \
+                                          badval, ndim_out, \
+                                          lbnd_out, ubnd_out, \
+                                          lbnd, ubnd, \
+                                          out, out_var, status ); \
 }
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
 MAKE_REBIN_(LD,long double)
@@ -23876,15 +28643,54 @@ void astRebinSeq##X##_( AstMapping *this, double wlim, int ndim_in, const int *l
                         const int *lbnd, const int *ubnd, Xtype *out, \
                         Xtype *out_var, double *weights, int64_t *nused, \
                         int *status ) { \
+   int64_t *lbnd8; \
+   int64_t *lbnd_in8; \
+   int64_t *lbnd_out8; \
+   int64_t *ubnd8; \
+   int64_t *ubnd_in8; \
+   int64_t *ubnd_out8; \
    if ( !astOK ) return; \
-   (**astMEMBER(this,Mapping,RebinSeq##X))( this, wlim, ndim_in, lbnd_in, \
-                                         ubnd_in, in, in_var, \
+   lbnd_in8 = WidenBounds( ndim_in, lbnd_in, status ); \
+   ubnd_in8 = WidenBounds( ndim_in, ubnd_in, status ); \
+   lbnd_out8 = WidenBounds( ndim_out, lbnd_out, status ); \
+   ubnd_out8 = WidenBounds( ndim_out, ubnd_out, status ); \
+   lbnd8 = WidenBounds( ndim_in, lbnd, status ); \
+   ubnd8 = WidenBounds( ndim_in, ubnd, status ); \
+   if ( astOK ) { \
+      (**astMEMBER(this,Mapping,RebinSeq8##X))( this, wlim, ndim_in, \
+                                         lbnd_in8, ubnd_in8, in, in_var, \
                                          interp, params, \
                                          flags, tol, maxpix, \
                                          badval, ndim_out, \
-                                         lbnd_out, ubnd_out, \
-                                         lbnd, ubnd, out, out_var, \
+                                         lbnd_out8, ubnd_out8, \
+                                         lbnd8, ubnd8, out, out_var, \
                                          weights, nused, status ); \
+   } \
+   lbnd_in8 = astFree( lbnd_in8 ); \
+   ubnd_in8 = astFree( ubnd_in8 ); \
+   lbnd_out8 = astFree( lbnd_out8 ); \
+   ubnd_out8 = astFree( ubnd_out8 ); \
+   lbnd8 = astFree( lbnd8 ); \
+   ubnd8 = astFree( ubnd8 ); \
+} \
+void astRebinSeq8##X##_( AstMapping *this, double wlim, int ndim_in, \
+                         const int64_t *lbnd_in, const int64_t *ubnd_in, \
+                         const Xtype *in, const Xtype *in_var, int interp, \
+                         const double *params, int flags, double tol, \
+                         int maxpix, Xtype badval, int ndim_out, \
+                         const int64_t *lbnd_out, const int64_t *ubnd_out, \
+                         const int64_t *lbnd, const int64_t *ubnd, \
+                         Xtype *out, Xtype *out_var, double *weights, \
+                         int64_t *nused, int *status ) { \
+   if ( !astOK ) return; \
+   (**astMEMBER(this,Mapping,RebinSeq8##X))( this, wlim, ndim_in, lbnd_in, \
+                                             ubnd_in, in, in_var, \
+                                             interp, params, \
+                                             flags, tol, maxpix, \
+                                             badval, ndim_out, \
+                                             lbnd_out, ubnd_out, \
+                                             lbnd, ubnd, out, out_var, \
+                                             weights, nused, status ); \
 }
 
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
@@ -23930,7 +28736,9 @@ AstMapping *astSimplify_( AstMapping *this, int *status ) {
    AstMapping *result;
    if ( !astOK ) return NULL;
    if( !astGetIsSimple( this ) && !astDoNotSimplify( this ) ) {
+      astBeginTempMem;
       result = (**astMEMBER(this,Mapping,Simplify))( this, status );
+      astEndTempMem;
       if( result ) result->flags |= AST__ISSIMPLE_FLAG; /* Indicate simplification has been done */
    } else {
       result = astClone( this );
@@ -23960,10 +28768,28 @@ void astTran2_( AstMapping *this,
 void astTranGrid_( AstMapping *this, int ncoord_in, const int lbnd[],
                    const int ubnd[], double tol, int maxpix, int forward,
                    int ncoord_out, int outdim, double *out, int *status ) {
+   int64_t *lbnd8;
+   int64_t *ubnd8;
+   if ( !astOK ) return;
+   lbnd8 = WidenBounds( ncoord_in, lbnd, status );
+   ubnd8 = WidenBounds( ncoord_in, ubnd, status );
+   if ( astOK ) {
+      (**astMEMBER(this,Mapping,TranGrid8))( this, ncoord_in, lbnd8, ubnd8,
+                                             tol, maxpix, forward,
+                                             ncoord_out, outdim, out,
+                                             status );
+   }
+   lbnd8 = astFree( lbnd8 );
+   ubnd8 = astFree( ubnd8 );
+}
+void astTranGrid8_( AstMapping *this, int ncoord_in, const int64_t lbnd[],
+                    const int64_t ubnd[], double tol, int maxpix, int forward,
+                    int ncoord_out, int64_t outdim, double *out,
+                    int *status ) {
    if ( !astOK ) return;
-   (**astMEMBER(this,Mapping,TranGrid))( this, ncoord_in, lbnd, ubnd, tol,
-                                         maxpix, forward, ncoord_out, outdim,
-                                         out, status );
+   (**astMEMBER(this,Mapping,TranGrid8))( this, ncoord_in, lbnd, ubnd, tol,
+                                          maxpix, forward, ncoord_out,
+                                          outdim, out, status );
 }
 void astTranN_( AstMapping *this, int npoint,
                 int ncoord_in, int indim, const double *in,
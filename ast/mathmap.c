@@ -85,6 +85,11 @@ f     The MathMap class does not define any new routines beyond those
 *        Re-implement the Equal method to avoid use of astSimplify.
 *     30-AUG-2012 (DSB):
 *        Fix bug in undocumented Gaussian noise function.
+*     16-OCT-2026 (DSB):
+*        - Evaluate constant sub-expressions when compiling each function.
+*        - Add a block evaluator (EvaluateFused) that applies all
+*        functions to cache-sized blocks of points, controlled by the
+*        new "MathMapBlock" tuning parameter.
 *class--
 */
 
@@ -506,6 +511,11 @@ static const Symbol symbol[] = {
 static const int symbol_ldcon = 0; /* Load a constant */
 static const int symbol_ldvar = 1; /* Load a variable */
 
+/* The number of points evaluated together by the block evaluator (see
+   the "MathMapBlock" tuning parameter). Zero selects the original
+   point-at-a-time interpreter. Access is protected by mutex8. */
+static int mathmap_block = 256;
+
 /* Define macros for accessing each item of thread specific global data. */
 #ifdef THREAD_SAFE
 
@@ -548,6 +558,10 @@ static pthread_mutex_t mutex7 = PTHREAD_MUTEX_INITIALIZER;
 #define LOCK_MUTEX7 pthread_mutex_lock( &mutex7 );
 #define UNLOCK_MUTEX7 pthread_mutex_unlock( &mutex7 );
 
+static pthread_mutex_t mutex8 = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_MUTEX8 pthread_mutex_lock( &mutex8 );
+#define UNLOCK_MUTEX8 pthread_mutex_unlock( &mutex8 );
+
 /* If thread safety is not needed, declare and initialise globals at static
    variables. */
 #else
@@ -578,6 +592,9 @@ static int class_init = 0;       /* Virtual function table initialised? */
 #define LOCK_MUTEX7
 #define UNLOCK_MUTEX7
 
+#define LOCK_MUTEX8
+#define UNLOCK_MUTEX8
+
 #endif
 
 
@@ -618,9 +635,11 @@ static void Copy( const AstObject *, AstObject *, int * );
 static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void EvaluateFunction( Rcontext *, int, const double **, const int *, const double *, int, double *, int * );
+static void EvaluateFused( Rcontext *, int, int, double **, int, double **, int, int **, double **, int, int, int * );
 static void EvaluationSort( const double [], int, int [], int **, int *, int * );
 static void ExtractExpressions( const char *, const char *, int, const char *[], int, char ***, int * );
 static void ExtractVariables( const char *, const char *, int, const char *[], int, int, int, int, int, char ***, int * );
+static void FoldConstants( int, int **, double **, int * );
 static void ParseConstant( const char *, const char *, const char *, int, int *, double *, int * );
 static void ParseName( const char *, int, int *, int * );
 static void ParseVariable( const char *, const char *, const char *, int, int, const char *[], int *, int *, int * );
@@ -1123,6 +1142,10 @@ static void CompileExpression( const char *method, const char *class,
       *con = astRealloc( *con, sizeof( double ) * (size_t) ncon );
    }
 
+/* Replace any constant sub-expressions with their values so that they
+   need not be re-evaluated at every point. */
+   FoldConstants( *stacksize, code, con, status );
+
 /* If an error occurred, free any allocated memory and reset the
    output values. */
    if ( !astOK ) {
@@ -2516,6 +2539,191 @@ static void EvaluateFunction( Rcontext *rcontext, int npoint,
    overflow. */ \
    } while ( result == AST__BAD );
 
+/* Define operations. */
+/* ================== */
+/* This macro expands to a "case" block for each operation other than
+   the loading of user-supplied constants and variables. It is shared by
+   the EvaluateFunction and EvaluateFused functions, each of which
+   defines its own ARG_0, ARG_1, ARG_1B, DO_ARG_2, ARG_2, ARG_2B and ARG_3B
+   macros to specify how the operations are applied to its stack. */
+#define OPERATIONS \
+\
+/* System constants. */ \
+/* ----------------- */ \
+/* Loading a "bad" value simply means assigning AST__BAD to the top of \
+   stack element. */ \
+   ARG_0( OP_LDBAD,    ;, *y = AST__BAD ) \
+\
+/* The following load constants associated with the (double) floating \
+   point representation into the top of stack element. */ \
+   ARG_0( OP_LDDIG,    ;, *y = (double) DBL_DIG ) \
+   ARG_0( OP_LDEPS,    ;, *y = DBL_EPSILON ) \
+   ARG_0( OP_LDMAX,    ;, *y = DBL_MAX ) \
+   ARG_0( OP_LDMAX10E, ;, *y = (double) DBL_MAX_10_EXP ) \
+   ARG_0( OP_LDMAXE,   ;, *y = (double) DBL_MAX_EXP ) \
+   ARG_0( OP_LDMDIG,   ;, *y = (double) DBL_MANT_DIG ) \
+   ARG_0( OP_LDMIN,    ;, *y = DBL_MIN ) \
+   ARG_0( OP_LDMIN10E, ;, *y = (double) DBL_MIN_10_EXP ) \
+   ARG_0( OP_LDMINE,   ;, *y = (double) DBL_MIN_EXP ) \
+   ARG_0( OP_LDRAD,    ;, *y = (double) FLT_RADIX ) \
+   ARG_0( OP_LDRND,    ;, *y = (double) FLT_ROUNDS ) \
+\
+/* Mathematical constants. */ \
+/* ----------------------- */ \
+/* The following load mathematical constants into the top of stack \
+   element. */ \
+   ARG_0( OP_LDE,      value = exp( 1.0 ), *y = value ) \
+   ARG_0( OP_LDPI,     ;, *y = pi ) \
+\
+/* Functions with one argument. */ \
+/* ---------------------------- */ \
+/* The following simply evaluate a function of the top of stack \
+   element and assign the result to the same element. */ \
+   ARG_1( OP_ABS,      *y = ABS( x ) ) \
+   ARG_1( OP_ACOS,     *y = ( ABS( x ) <= 1.0 ) ? \
+                            acos( x ) : AST__BAD ) \
+   ARG_1( OP_ACOSD,    *y = ( ABS( x ) <= 1.0 ) ? \
+                            acos( x ) * r2d : AST__BAD ) \
+   ARG_1( OP_ACOSH,    *y = ( x < 1.0 ) ? AST__BAD : \
+                            ( ( x > safe_sq ) ? log( x ) + log2 : \
+                              log( x + sqrt( x * x - 1.0 ) ) ) ) \
+   ARG_1( OP_ACOTH,    *y = ( ABS( x ) <= 1.0 ) ? AST__BAD : \
+                            0.5 * ( log( ( x + 1.0 ) / \
+                                         ( x - 1.0 ) ) ) ) \
+   ARG_1( OP_ACSCH,    *y = ( ( x == 0.0 ) ? AST__BAD : \
+                              ( sign = ( x >= 0.0 ), x = ABS( x ), \
+                              ( sign ? 1.0 : -1.0 ) * \
+                              ( ( x < rsafe_sq ) ? log2 - log( x ) : \
+                                ( x = 1.0 / x, \
+                              log( x + sqrt( x * x + 1.0 ) ) ) ) ) ) ) \
+   ARG_1( OP_ASECH,    *y = ( ( x <= 0 ) || ( x > 1.0 ) ) ? AST__BAD : \
+                              ( ( x < rsafe_sq ) ? log2 - log( x ) : \
+                                ( x = 1.0 / x, \
+                                  log( x + sqrt( x * x - 1.0 ) ) ) ) ) \
+   ARG_1( OP_ASIN,     *y = ( ABS( x ) <= 1.0 ) ? \
+                            asin( x ) : AST__BAD ) \
+   ARG_1( OP_ASIND,    *y = ( ABS( x ) <= 1.0 ) ? \
+                            asin( x ) * r2d : AST__BAD ) \
+   ARG_1( OP_ASINH,    *y = ( sign = ( x >= 0.0 ), x = ABS( x ), \
+                              ( sign ? 1.0 : -1.0 ) * \
+                              ( ( x > safe_sq ) ? log( x ) + log2 : \
+                                log( x + sqrt( x * x + 1.0 ) ) ) ) ) \
+   ARG_1( OP_ATAN,     *y = atan( x ) ) \
+   ARG_1( OP_ATAND,    *y = atan( x ) * r2d ) \
+   ARG_1( OP_ATANH,    *y = ( ABS( x ) >= 1.0 ) ? AST__BAD : \
+                            0.5 * ( log( ( 1.0 + x ) / \
+                                         ( 1.0 - x ) ) ) ) \
+   ARG_1( OP_CEIL,     *y = ceil( x ) ) \
+   ARG_1( OP_COS,      *y = cos( x ) ) \
+   ARG_1( OP_COSD,     *y = cos( x * d2r ) ) \
+   ARG_1( OP_COSH,     *y = CATCH_MATHS_OVERFLOW( cosh( x ) ) ) \
+   ARG_1( OP_COTH,     *y = ( x = tanh( x ), SAFE_DIV( 1.0, x ) ) ) \
+   ARG_1( OP_CSCH,     *y = ( x = CATCH_MATHS_OVERFLOW( sinh( x ) ), \
+                              ( x == AST__BAD ) ? \
+                              0.0 : SAFE_DIV( 1.0, x ) ) ) \
+   ARG_1( OP_EXP,      *y = CATCH_MATHS_OVERFLOW( exp( x ) ) ) \
+   ARG_1( OP_FLOOR,    *y = floor( x ) ) \
+   ARG_1( OP_INT,      *y = INT( x ) ) \
+   ARG_1B( OP_ISBAD,   *y = ( x == AST__BAD ) ) \
+   ARG_1( OP_LOG,      *y = ( x > 0.0 ) ? log( x ) : AST__BAD ) \
+   ARG_1( OP_LOG10,    *y = ( x > 0.0 ) ? log10( x ) : AST__BAD ) \
+   ARG_1( OP_NINT,     *y = ( x >= 0 ) ? \
+                            floor( x + 0.5 ) : ceil( x - 0.5 ) ) \
+   ARG_1( OP_POISS,    *y = Poisson( rcontext, x, status ) ) \
+   ARG_1( OP_SECH,     *y = ( x = CATCH_MATHS_OVERFLOW( cosh( x ) ), \
+                              ( x == AST__BAD ) ? 0.0 : 1.0 / x ) ) \
+   ARG_1( OP_SIN,      *y = sin( x ) ) \
+   ARG_1( OP_SINC,     *y = ( x == 0.0 ) ? 1.0 : sin( x ) / x ) \
+   ARG_1( OP_SIND,     *y = sin( x * d2r ) ) \
+   ARG_1( OP_SINH,     *y = CATCH_MATHS_OVERFLOW( sinh( x ) ) ) \
+   ARG_1( OP_SQR,      *y = SAFE_MUL( x, x ) ) \
+   ARG_1( OP_SQRT,     *y = ( x >= 0.0 ) ? sqrt( x ) : AST__BAD ) \
+   ARG_1( OP_TAN,      *y = CATCH_MATHS_OVERFLOW( tan( x ) ) ) \
+   ARG_1( OP_TAND,     *y = tan( x * d2r ) ) \
+   ARG_1( OP_TANH,     *y = tanh( x ) ) \
+\
+/* Functions with two arguments. */ \
+/* ----------------------------- */ \
+/* These evaluate a function of the top two entries on the stack. */ \
+   ARG_2( OP_ATAN2,    *y = atan2( x1, x2 ) ) \
+   ARG_2( OP_ATAN2D,   *y = atan2( x1, x2 ) * r2d ) \
+   ARG_2( OP_DIM,      *y = ( x1 > x2 ) ? x1 - x2 : 0.0 ) \
+   ARG_2( OP_GAUSS,    GAUSS( x1, x2 ); *y = result ) \
+   ARG_2( OP_MOD,      *y = ( x2 != 0.0 ) ? \
+                            fmod( x1, x2 ) : AST__BAD ) \
+   ARG_2( OP_POW,      *y = CATCH_MATHS_ERROR( pow( x1, x2 ) ) ) \
+   ARG_2( OP_RAND,     ran = Rand( rcontext, status ); \
+                       *y = x1 * ran + x2 * ( 1.0 - ran ); ) \
+   ARG_2( OP_SIGN,     *y = ( ( x1 >= 0.0 ) == ( x2 >= 0.0 ) ) ? \
+                            x1 : -x1 ) \
+\
+/* Functions with three arguments. */ \
+/* ------------------------------- */ \
+/* These evaluate a function of the top three entries on the stack. */ \
+   ARG_3B( OP_QIF,     *y = ( ( x1 ) ? ( x2 ) : ( x3 ) ) ) \
+\
+\
+/* Functions with variable numbers of arguments. */ \
+/* --------------------------------------------- */ \
+/* These operations take a variable number of arguments, the actual \
+   number being determined by consuming a constant. We then loop to \
+   perform a 2-argument operation on the stack (as above) the required \
+   number of times. */ \
+   case OP_MAX: \
+      narg = (int) ( con[ icon++ ] + 0.5 ); \
+      for ( iarg = 0; iarg < ( narg - 1 ); iarg++ ) { \
+         DO_ARG_2( *y = ( x1 >= x2 ) ? x1 : x2 ) \
+      } \
+      break; \
+   case OP_MIN: \
+      narg = (int) ( con[ icon++ ] + 0.5 ); \
+      for ( iarg = 0; iarg < ( narg - 1 ); iarg++ ) { \
+         DO_ARG_2( *y = ( x1 <= x2 ) ? x1 : x2 ) \
+      } \
+      break; \
+\
+/* Unary arithmetic operators. */ \
+/* --------------------------- */ \
+   ARG_1( OP_NEG,      *y = -x ) \
+\
+/* Unary boolean operators. */ \
+/* ------------------------ */ \
+   ARG_1( OP_NOT,      *y = ( x == 0.0 ) ) \
+\
+/* Binary arithmetic operators. */ \
+/* ---------------------------- */ \
+   ARG_2( OP_ADD,      *y = SAFE_ADD( x1, x2 ) ) \
+   ARG_2( OP_SUB,      *y = SAFE_SUB( x1, x2 ) ) \
+   ARG_2( OP_MUL,      *y = SAFE_MUL( x1, x2 ) ) \
+   ARG_2( OP_DIV ,     *y = SAFE_DIV( x1, x2 ) ) \
+\
+/* Bit-shift operators. */ \
+/* -------------------- */ \
+   ARG_2( OP_SHFTL,    *y = SHIFT_BITS( x1, x2 ) ) \
+   ARG_2( OP_SHFTR,    *y = SHIFT_BITS( x1, -x2 ) ) \
+\
+/* Relational operators. */ \
+/* --------------------- */ \
+   ARG_2( OP_EQ,       *y = ( x1 == x2 ) ) \
+   ARG_2( OP_GE,       *y = ( x1 >= x2 ) ) \
+   ARG_2( OP_GT,       *y = ( x1 > x2 ) ) \
+   ARG_2( OP_LE,       *y = ( x1 <= x2 ) ) \
+   ARG_2( OP_LT,       *y = ( x1 < x2 ) ) \
+   ARG_2( OP_NE,       *y = ( x1 != x2 ) ) \
+\
+/* Bit-wise operators. */ \
+/* ------------------- */ \
+   ARG_2( OP_BITOR,    BIT_OPER( |, x1, x2 ); *y = result ) \
+   ARG_2( OP_BITXOR,   BIT_OPER( ^, x1, x2 ); *y = result ) \
+   ARG_2( OP_BITAND,   BIT_OPER( &, x1, x2 ); *y = result ) \
+\
+/* Binary boolean operators. */ \
+/* ------------------------- */ \
+   ARG_2B( OP_AND,     *y = TRISTATE_AND( x1, x2 ) ) \
+   ARG_2( OP_EQV,      *y = ( ( x1 != 0.0 ) == ( x2 != 0.0 ) ) ) \
+   ARG_2B( OP_OR,      *y = TRISTATE_OR( x1, x2 ) ) \
+   ARG_2( OP_XOR,      *y = ( ( x1 != 0.0 ) != ( x2 != 0.0 ) ) )
+
 /* Implement the stack-based arithmetic. */
 /* ===================================== */
 /* Initialise the top of stack index and constant counter. */
@@ -2545,200 +2753,466 @@ static void EvaluateFunction( Rcontext *rcontext, int npoint,
             ARG_0( OP_LDVAR,    ivar = (int) ( con[ icon++ ] + 0.5 ),
                                 *y = ptr_in[ ivar ][ point ] )
 
-/* System constants. */
-/* ----------------- */
-/* Loading a "bad" value simply means assigning AST__BAD to the top of
-   stack element. */
-            ARG_0( OP_LDBAD,    ;, *y = AST__BAD )
-
-/* The following load constants associated with the (double) floating
-   point representation into the top of stack element. */
-            ARG_0( OP_LDDIG,    ;, *y = (double) DBL_DIG )
-            ARG_0( OP_LDEPS,    ;, *y = DBL_EPSILON )
-            ARG_0( OP_LDMAX,    ;, *y = DBL_MAX )
-            ARG_0( OP_LDMAX10E, ;, *y = (double) DBL_MAX_10_EXP )
-            ARG_0( OP_LDMAXE,   ;, *y = (double) DBL_MAX_EXP )
-            ARG_0( OP_LDMDIG,   ;, *y = (double) DBL_MANT_DIG )
-            ARG_0( OP_LDMIN,    ;, *y = DBL_MIN )
-            ARG_0( OP_LDMIN10E, ;, *y = (double) DBL_MIN_10_EXP )
-            ARG_0( OP_LDMINE,   ;, *y = (double) DBL_MIN_EXP )
-            ARG_0( OP_LDRAD,    ;, *y = (double) FLT_RADIX )
-            ARG_0( OP_LDRND,    ;, *y = (double) FLT_ROUNDS )
+/* All other operations. */
+            OPERATIONS
+         }
+      }
+   }
 
-/* Mathematical constants. */
-/* ----------------------- */
-/* The following load mathematical constants into the top of stack
-   element. */
-            ARG_0( OP_LDE,      value = exp( 1.0 ), *y = value )
-            ARG_0( OP_LDPI,     ;, *y = pi )
+/* When all opcodes have been processed, the result of the function
+   evaluation will reside in the lowest stack entry - i.e. the output
+   array. */
 
-/* Functions with one argument. */
-/* ---------------------------- */
-/* The following simply evaluate a function of the top of stack
-   element and assign the result to the same element. */
-            ARG_1( OP_ABS,      *y = ABS( x ) )
-            ARG_1( OP_ACOS,     *y = ( ABS( x ) <= 1.0 ) ?
-                                     acos( x ) : AST__BAD )
-            ARG_1( OP_ACOSD,    *y = ( ABS( x ) <= 1.0 ) ?
-                                     acos( x ) * r2d : AST__BAD )
-            ARG_1( OP_ACOSH,    *y = ( x < 1.0 ) ? AST__BAD :
-                                     ( ( x > safe_sq ) ? log( x ) + log2 :
-                                       log( x + sqrt( x * x - 1.0 ) ) ) )
-            ARG_1( OP_ACOTH,    *y = ( ABS( x ) <= 1.0 ) ? AST__BAD :
-                                     0.5 * ( log( ( x + 1.0 ) /
-                                                  ( x - 1.0 ) ) ) )
-            ARG_1( OP_ACSCH,    *y = ( ( x == 0.0 ) ? AST__BAD :
-                                       ( sign = ( x >= 0.0 ), x = ABS( x ),
-                                       ( sign ? 1.0 : -1.0 ) *
-                                       ( ( x < rsafe_sq ) ? log2 - log( x ) :
-                                         ( x = 1.0 / x,
-                                       log( x + sqrt( x * x + 1.0 ) ) ) ) ) ) )
-            ARG_1( OP_ASECH,    *y = ( ( x <= 0 ) || ( x > 1.0 ) ) ? AST__BAD :
-                                       ( ( x < rsafe_sq ) ? log2 - log( x ) :
-                                         ( x = 1.0 / x,
-                                           log( x + sqrt( x * x - 1.0 ) ) ) ) )
-            ARG_1( OP_ASIN,     *y = ( ABS( x ) <= 1.0 ) ?
-                                     asin( x ) : AST__BAD )
-            ARG_1( OP_ASIND,    *y = ( ABS( x ) <= 1.0 ) ?
-                                     asin( x ) * r2d : AST__BAD )
-            ARG_1( OP_ASINH,    *y = ( sign = ( x >= 0.0 ), x = ABS( x ),
-                                       ( sign ? 1.0 : -1.0 ) *
-                                       ( ( x > safe_sq ) ? log( x ) + log2 :
-                                         log( x + sqrt( x * x + 1.0 ) ) ) ) )
-            ARG_1( OP_ATAN,     *y = atan( x ) )
-            ARG_1( OP_ATAND,    *y = atan( x ) * r2d )
-            ARG_1( OP_ATANH,    *y = ( ABS( x ) >= 1.0 ) ? AST__BAD :
-                                     0.5 * ( log( ( 1.0 + x ) /
-                                                  ( 1.0 - x ) ) ) )
-            ARG_1( OP_CEIL,     *y = ceil( x ) )
-            ARG_1( OP_COS,      *y = cos( x ) )
-            ARG_1( OP_COSD,     *y = cos( x * d2r ) )
-            ARG_1( OP_COSH,     *y = CATCH_MATHS_OVERFLOW( cosh( x ) ) )
-            ARG_1( OP_COTH,     *y = ( x = tanh( x ), SAFE_DIV( 1.0, x ) ) )
-            ARG_1( OP_CSCH,     *y = ( x = CATCH_MATHS_OVERFLOW( sinh( x ) ),
-                                       ( x == AST__BAD ) ?
-                                       0.0 : SAFE_DIV( 1.0, x ) ) )
-            ARG_1( OP_EXP,      *y = CATCH_MATHS_OVERFLOW( exp( x ) ) )
-            ARG_1( OP_FLOOR,    *y = floor( x ) )
-            ARG_1( OP_INT,      *y = INT( x ) )
-            ARG_1B( OP_ISBAD,   *y = ( x == AST__BAD ) )
-            ARG_1( OP_LOG,      *y = ( x > 0.0 ) ? log( x ) : AST__BAD )
-            ARG_1( OP_LOG10,    *y = ( x > 0.0 ) ? log10( x ) : AST__BAD )
-            ARG_1( OP_NINT,     *y = ( x >= 0 ) ?
-                                     floor( x + 0.5 ) : ceil( x - 0.5 ) )
-            ARG_1( OP_POISS,    *y = Poisson( rcontext, x, status ) )
-            ARG_1( OP_SECH,     *y = ( x = CATCH_MATHS_OVERFLOW( cosh( x ) ),
-                                       ( x == AST__BAD ) ? 0.0 : 1.0 / x ) )
-            ARG_1( OP_SIN,      *y = sin( x ) )
-            ARG_1( OP_SINC,     *y = ( x == 0.0 ) ? 1.0 : sin( x ) / x )
-            ARG_1( OP_SIND,     *y = sin( x * d2r ) )
-            ARG_1( OP_SINH,     *y = CATCH_MATHS_OVERFLOW( sinh( x ) ) )
-            ARG_1( OP_SQR,      *y = SAFE_MUL( x, x ) )
-            ARG_1( OP_SQRT,     *y = ( x >= 0.0 ) ? sqrt( x ) : AST__BAD )
-            ARG_1( OP_TAN,      *y = CATCH_MATHS_OVERFLOW( tan( x ) ) )
-            ARG_1( OP_TAND,     *y = tan( x * d2r ) )
-            ARG_1( OP_TANH,     *y = tanh( x ) )
+/* Free the workspace arrays. */
+   work = astFree( work );
+   stack = astFree( stack );
 
-/* Functions with two arguments. */
-/* ----------------------------- */
-/* These evaluate a function of the top two entries on the stack. */
-            ARG_2( OP_ATAN2,    *y = atan2( x1, x2 ) )
-            ARG_2( OP_ATAN2D,   *y = atan2( x1, x2 ) * r2d )
-            ARG_2( OP_DIM,      *y = ( x1 > x2 ) ? x1 - x2 : 0.0 )
-            ARG_2( OP_GAUSS,    GAUSS( x1, x2 ); *y = result )
-            ARG_2( OP_MOD,      *y = ( x2 != 0.0 ) ?
-                                     fmod( x1, x2 ) : AST__BAD )
-            ARG_2( OP_POW,      *y = CATCH_MATHS_ERROR( pow( x1, x2 ) ) )
-            ARG_2( OP_RAND,     ran = Rand( rcontext, status );
-                                *y = x1 * ran + x2 * ( 1.0 - ran ); )
-            ARG_2( OP_SIGN,     *y = ( ( x1 >= 0.0 ) == ( x2 >= 0.0 ) ) ?
-                                     x1 : -x1 )
+/* Undefine macros local to this function. The remaining macros are
+   also used by EvaluateFused, and are undefined there. */
+#undef ARG_0
+#undef ARG_1
+#undef ARG_1B
+#undef DO_ARG_2
+#undef ARG_2
+#undef ARG_2B
+#undef ARG_3B
+}
 
-/* Functions with three arguments. */
-/* ------------------------------- */
-/* These evaluate a function of the top three entries on the stack. */
-            ARG_3B( OP_QIF,     *y = ( ( x1 ) ? ( x2 ) : ( x3 ) ) )
+static void EvaluateFused( Rcontext *rcontext, int npoint, int ncoord_in,
+                           double **ptr_in, int ncoord_out, double **ptr_out,
+                           int nfun, int **codes, double **consts,
+                           int stacksize, int blocksize, int *status ) {
+/*
+*  Name:
+*     EvaluateFused
 
+*  Purpose:
+*     Evaluate a set of compiled functions in blocks of points.
 
-/* Functions with variable numbers of arguments. */
-/* --------------------------------------------- */
-/* These operations take a variable number of arguments, the actual
-   number being determined by consuming a constant. We then loop to
-   perform a 2-argument operation on the stack (as above) the required
-   number of times. */
-            case OP_MAX:
-               narg = (int) ( con[ icon++ ] + 0.5 );
-               for ( iarg = 0; iarg < ( narg - 1 ); iarg++ ) {
-                  DO_ARG_2( *y = ( x1 >= x2 ) ? x1 : x2 )
-               }
-               break;
-            case OP_MIN:
-               narg = (int) ( con[ icon++ ] + 0.5 );
-               for ( iarg = 0; iarg < ( narg - 1 ); iarg++ ) {
-                  DO_ARG_2( *y = ( x1 <= x2 ) ? x1 : x2 )
-               }
-               break;
+*  Type:
+*     Private function.
 
-/* Unary arithmetic operators. */
-/* --------------------------- */
-            ARG_1( OP_NEG,      *y = -x )
+*  Synopsis:
+*     #include "mathmap.h"
+*     void EvaluateFused( Rcontext *rcontext, int npoint, int ncoord_in,
+*                         double **ptr_in, int ncoord_out, double **ptr_out,
+*                         int nfun, int **codes, double **consts,
+*                         int stacksize, int blocksize, int *status )
 
-/* Unary boolean operators. */
-/* ------------------------ */
-            ARG_1( OP_NOT,      *y = ( x == 0.0 ) )
+*  Class Membership:
+*     MathMap member function.
 
-/* Binary arithmetic operators. */
-/* ---------------------------- */
-            ARG_2( OP_ADD,      *y = SAFE_ADD( x1, x2 ) )
-            ARG_2( OP_SUB,      *y = SAFE_SUB( x1, x2 ) )
-            ARG_2( OP_MUL,      *y = SAFE_MUL( x1, x2 ) )
-            ARG_2( OP_DIV ,     *y = SAFE_DIV( x1, x2 ) )
+*  Description:
+*     This function evaluates all the compiled functions that implement
+*     one direction of a MathMap transformation, giving the same results
+*     as invoking EvaluateFunction for each function in turn. However,
+*     instead of applying each operation to the full vector of points
+*     before moving on to the next operation, the points are divided into
+*     blocks that are small enough for the evaluation stack (and any
+*     intermediate function results) to remain in the processor cache,
+*     and all the operations of all the functions are applied to one
+*     block before moving on to the next.
+*
+*     In addition:
+*
+*     - Input variables are used in place rather than being copied on to
+*     the stack.
+*     - Each stack entry carries a flag indicating if it is known to
+*     contain no bad values. Operations on such entries use simple loops
+*     that do not test each argument value, and which the compiler may
+*     vectorise.
+*
+*     This function should not be used if any of the functions generates
+*     random numbers, since the random numbers would be drawn in a
+*     different order to that used by EvaluateFunction.
 
-/* Bit-shift operators. */
-/* -------------------- */
-            ARG_2( OP_SHFTL,    *y = SHIFT_BITS( x1, x2 ) )
-            ARG_2( OP_SHFTR,    *y = SHIFT_BITS( x1, -x2 ) )
+*  Parameters:
+*     rcontext
+*        Pointer to the random number generator context.
+*     npoint
+*        The number of points to be transformed.
+*     ncoord_in
+*        The number of input coordinates.
+*     ptr_in
+*        Pointer to an array of "ncoord_in" pointers, each of which
+*        points to an array of "npoint" input coordinate values.
+*     ncoord_out
+*        The number of output coordinates. This should be no more than
+*        "nfun". The last "ncoord_out" functions produce the output
+*        coordinate values, and any earlier functions produce
+*        intermediate results.
+*     ptr_out
+*        Pointer to an array of "ncoord_out" pointers, each of which
+*        points to an array of "npoint" elements in which to return the
+*        output coordinate values.
+*     nfun
+*        The number of functions to evaluate.
+*     codes
+*        Pointer to an array of "nfun" pointers, each of which points to
+*        the opcodes for a function (as for EvaluateFunction).
+*     consts
+*        Pointer to an array of "nfun" pointers, each of which points to
+*        the constants for a function (as for EvaluateFunction).
+*     stacksize
+*        The largest stack size required to evaluate any of the functions.
+*     blocksize
+*        The number of points to process in each block.
+*     status
+*        Pointer to the inherited status variable.
+*/
 
-/* Relational operators. */
-/* --------------------- */
-            ARG_2( OP_EQ,       *y = ( x1 == x2 ) )
-            ARG_2( OP_GE,       *y = ( x1 >= x2 ) )
-            ARG_2( OP_GT,       *y = ( x1 > x2 ) )
-            ARG_2( OP_LE,       *y = ( x1 <= x2 ) )
-            ARG_2( OP_LT,       *y = ( x1 < x2 ) )
-            ARG_2( OP_NE,       *y = ( x1 != x2 ) )
+/* Local Constants: */
+   const int bits =              /* Number of bits in an unsigned long */
+      sizeof( unsigned long ) * CHAR_BIT;
+   const double eps =            /* Smallest number subtractable from 2.0 */
+      2.0 * DBL_EPSILON;
+   const double scale =          /* 2.0 raised to the power "bits" */
+      ldexp( 1.0, bits );
+   const double scale1 =         /* 2.0 raised to the power "bits-1" */
+      scale * 0.5;
+   const double rscale =         /* Reciprocal scale factor */
+      1.0 / scale;
+   const double rscale1 =        /* Reciprocal initial scale factor */
+      1.0 / scale1;
+   const int nblock =            /* Number of blocks of bits to process */
+      ( sizeof( double ) + sizeof( unsigned long ) - 1 ) /
+      sizeof( unsigned long );
+   const unsigned long signbit = /* Mask for extracting sign bit */
+      1UL << ( bits - 1 );
 
-/* Bit-wise operators. */
-/* ------------------- */
-            ARG_2( OP_BITOR,    BIT_OPER( |, x1, x2 ); *y = result )
-            ARG_2( OP_BITXOR,   BIT_OPER( ^, x1, x2 ); *y = result )
-            ARG_2( OP_BITAND,   BIT_OPER( &, x1, x2 ); *y = result )
+/* Local Variables: */
+   const double **stack;         /* Array of pointers to stack elements */
+   const double *xv1;            /* Pointer to first argument vector */
+   const double *xv2;            /* Pointer to second argument vector */
+   const double *xv3;            /* Pointer to third argument vector */
+   const double *xv;             /* Pointer to sole argument vector */
+   const double *con;            /* Constants for current function */
+   const int *code;              /* Opcodes for current function */
+   double **data_ptr;            /* Pointers to data for current block */
+   double *out;                  /* Pointer to output for current function */
+   double *work;                 /* Pointer to stack workspace */
+   double *y;                    /* Pointer to result */
+   double *yv;                   /* Pointer to result vector */
+   double abs1;                  /* Absolute value (temporary variable) */
+   double abs2;                  /* Absolute value (temporary variable) */
+   double frac1;                 /* First (maybe normalised) fraction */
+   double frac2;                 /* Second (maybe normalised) fraction */
+   double frac;                  /* Sole normalised fraction */
+   double newexp;                /* New power of 2 exponent value */
+   double ran;                   /* Random number */
+   double result;                /* Function result value */
+   double unscale;               /* Factor for removing scaling */
+   double value;                 /* Value to be assigned to stack vector */
+   double x1;                    /* First argument value */
+   double x2;                    /* Second argument value */
+   double x3;                    /* Third argument value */
+   double x;                     /* Sole argument value */
+   int *good;                    /* Stack elements contain no bad values? */
+   int *vgood;                   /* Variables contain no bad values? */
+   int base;                     /* Index of first point in block */
+   int expon1;                   /* First power of 2 exponent */
+   int expon2;                   /* Second power of 2 exponent */
+   int expon;                    /* Sole power of 2 exponent */
+   int iarg;                     /* Loop counter for arguments */
+   int iblock;                   /* Loop counter for blocks of bits */
+   int icode;                    /* Opcode value */
+   int icon;                     /* Counter for number of constants used */
+   int idata;                    /* Loop counter for data pointer elements */
+   int ifun;                     /* Loop counter for functions */
+   int ivar;                     /* Input variable number */
+   int narg;                     /* Number of function arguments */
+   int nbad;                     /* Number of bad results */
+   int ncode;                    /* Number of opcodes to process */
+   int ndata;                    /* Number of data pointer elements */
+   int npt;                      /* Number of points in current block */
+   int point;                    /* Loop counter for stack vector elements */
+   int sign;                     /* Argument is non-negative? */
+   int tos;                      /* Top of stack index */
+   static double d2r;            /* Degrees to radians conversion factor */
+   static double log2;           /* Natural logarithm of 2.0 */
+   static double pi;             /* Value of PI */
+   static double r2d;            /* Radians to degrees conversion factor */
+   static double rsafe_sq;       /* Reciprocal of "safe_sq" */
+   static double safe_sq;        /* Huge value that can safely be squared */
+   static int init = 0;          /* Initialisation performed? */
+   unsigned long b1;             /* Block of bits from first argument */
+   unsigned long b2;             /* Block of bits from second argument */
+   unsigned long b;              /* Block of bits for result */
+   unsigned long neg;            /* Result is negative? (sign bit) */
 
-/* Binary boolean operators. */
-/* ------------------------- */
-            ARG_2B( OP_AND,     *y = TRISTATE_AND( x1, x2 ) )
-            ARG_2( OP_EQV,      *y = ( ( x1 != 0.0 ) == ( x2 != 0.0 ) ) )
-            ARG_2B( OP_OR,      *y = TRISTATE_OR( x1, x2 ) )
-            ARG_2( OP_XOR,      *y = ( ( x1 != 0.0 ) != ( x2 != 0.0 ) ) )
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* If this is the first invocation of this function, then initialise
+   constant values (see EvaluateFunction). */
+   LOCK_MUTEX2
+   if ( !init ) {
+      pi = acos( -1.0 );
+      r2d = 180.0 / pi;
+      d2r = pi / 180.0;
+      log2 = log( 2.0 );
+      safe_sq = 0.9 * sqrt( DBL_MAX );
+      rsafe_sq = 1.0 / safe_sq;
+      init = 1;
+   }
+   UNLOCK_MUTEX2
+
+/* Do not use blocks larger than the number of points. */
+   if ( blocksize > npoint ) blocksize = npoint;
+   if ( blocksize < 1 ) blocksize = 1;
+
+/* Allocate workspace. The "work" array holds one vector of "blocksize"
+   values for each stack element above the lowest (which is always the
+   output array for the function being evaluated), followed by one
+   vector for each intermediate function result. */
+   ndata = ncoord_in + nfun;
+   stack = astMalloc( sizeof( const double * ) * (size_t) stacksize );
+   good = astMalloc( sizeof( int ) * (size_t) stacksize );
+   work = astMalloc( sizeof( double ) * (size_t) blocksize *
+                     (size_t) ( stacksize - 1 + nfun - ncoord_out ) );
+   data_ptr = astMalloc( sizeof( double * ) * (size_t) ndata );
+   vgood = astMalloc( sizeof( int ) * (size_t) ndata );
+
+/* Stack operations. */
+/* ================= */
+/* We now define macros for performing vector operations on elements of
+   the stack, equivalent to those in EvaluateFunction. A stack element
+   may point at an input variable or at a vector within the "work" array.
+   The result of an operation is stored in the vector reserved for its
+   stack position, which for the lowest position is the function's output
+   array. Note, STACK_VECTOR evaluates its argument more than once. */
+#define STACK_VECTOR(pos) \
+   ( (pos) ? work + ( (pos) - 1 ) * blocksize : out )
+
+/* Zero-argument operation. */
+#define ARG_0(oper,setup,function) \
+   case oper: \
+      {setup;} \
+      yv = STACK_VECTOR( tos + 1 ); \
+      tos++; \
+      nbad = 0; \
+      for ( point = 0; point < npt; point++ ) { \
+         y = yv + point; \
+         {function;} \
+         nbad += ( *y == AST__BAD ); \
+      } \
+      stack[ tos ] = yv; \
+      good[ tos ] = !nbad; \
+      break;
+
+/* One-argument operation. If the argument is known to contain no bad
+   values, use a loop that does not check for them, counting any bad
+   results instead. */
+#define ARG_1(oper,function) \
+   case oper: \
+      xv = stack[ tos ]; \
+      yv = STACK_VECTOR( tos ); \
+      if ( good[ tos ] ) { \
+         nbad = 0; \
+         for ( point = 0; point < npt; point++ ) { \
+            x = xv[ point ]; \
+            y = yv + point; \
+            {function;} \
+            nbad += ( *y == AST__BAD ); \
+         } \
+         good[ tos ] = !nbad; \
+      } else { \
+         for ( point = 0; point < npt; point++ ) { \
+            if ( ( x = xv[ point ] ) != AST__BAD ) { \
+               y = yv + point; \
+               {function;} \
+            } else { \
+               yv[ point ] = AST__BAD; \
+            } \
+         } \
+      } \
+      stack[ tos ] = yv; \
+      break;
+
+/* One-argument boolean operation (no checks for bad argument values). */
+#define ARG_1B(oper,function) \
+   case oper: \
+      xv = stack[ tos ]; \
+      yv = STACK_VECTOR( tos ); \
+      nbad = 0; \
+      for ( point = 0; point < npt; point++ ) { \
+         x = xv[ point ]; \
+         y = yv + point; \
+         {function;} \
+         nbad += ( *y == AST__BAD ); \
+      } \
+      stack[ tos ] = yv; \
+      good[ tos ] = !nbad; \
+      break;
+
+/* Two-argument operation. */
+#define DO_ARG_2(function) \
+      xv2 = stack[ tos-- ]; \
+      xv1 = stack[ tos ]; \
+      yv = STACK_VECTOR( tos ); \
+      if ( good[ tos ] && good[ tos + 1 ] ) { \
+         nbad = 0; \
+         for ( point = 0; point < npt; point++ ) { \
+            x1 = xv1[ point ]; \
+            x2 = xv2[ point ]; \
+            y = yv + point; \
+            {function;} \
+            nbad += ( *y == AST__BAD ); \
+         } \
+         good[ tos ] = !nbad; \
+      } else { \
+         for ( point = 0; point < npt; point++ ) { \
+            if ( ( ( x1 = xv1[ point ] ) != AST__BAD ) && \
+                 ( ( x2 = xv2[ point ] ) != AST__BAD ) ) { \
+               y = yv + point; \
+               {function;} \
+            } else { \
+               yv[ point ] = AST__BAD; \
+            } \
+         } \
+         good[ tos ] = 0; \
+      } \
+      stack[ tos ] = yv;
+
+#define ARG_2(oper,function) \
+   case oper: \
+      DO_ARG_2(function) \
+      break;
+
+/* Two-argument boolean operation (no checks for bad argument values). */
+#define ARG_2B(oper,function) \
+   case oper: \
+      xv2 = stack[ tos-- ]; \
+      xv1 = stack[ tos ]; \
+      yv = STACK_VECTOR( tos ); \
+      nbad = 0; \
+      for ( point = 0; point < npt; point++ ) { \
+         x1 = xv1[ point ]; \
+         x2 = xv2[ point ]; \
+         y = yv + point; \
+         {function;} \
+         nbad += ( *y == AST__BAD ); \
+      } \
+      stack[ tos ] = yv; \
+      good[ tos ] = !nbad; \
+      break;
+
+/* Three-argument boolean operation (no checks for bad argument values). */
+#define ARG_3B(oper,function) \
+   case oper: \
+      xv3 = stack[ tos-- ]; \
+      xv2 = stack[ tos-- ]; \
+      xv1 = stack[ tos ]; \
+      yv = STACK_VECTOR( tos ); \
+      nbad = 0; \
+      for ( point = 0; point < npt; point++ ) { \
+         x1 = xv1[ point ]; \
+         x2 = xv2[ point ]; \
+         x3 = xv3[ point ]; \
+         y = yv + point; \
+         {function;} \
+         nbad += ( *y == AST__BAD ); \
+      } \
+      stack[ tos ] = yv; \
+      good[ tos ] = !nbad; \
+      break;
+
+/* Process blocks of points. */
+/* ========================= */
+   if ( astOK ) {
+      for ( base = 0; base < npoint; base += blocksize ) {
+         npt = ( npoint - base < blocksize ) ? npoint - base : blocksize;
+
+/* Set up pointers to the input data, intermediate results and output
+   data for this block (in the same order as used by Transform). Note
+   that nothing is yet known about the presence of bad values in any
+   of them. */
+         for ( idata = 0; idata < ncoord_in; idata++ ) {
+            data_ptr[ idata ] = ptr_in[ idata ] + base;
+         }
+         for ( idata = 0; idata < nfun - ncoord_out; idata++ ) {
+            data_ptr[ ncoord_in + idata ] = work + ( stacksize - 1 + idata ) *
+                                                   blocksize;
+         }
+         for ( idata = 0; idata < ncoord_out; idata++ ) {
+            data_ptr[ ncoord_in + nfun - ncoord_out + idata ] =
+                                                     ptr_out[ idata ] + base;
+         }
+         for ( idata = 0; idata < ndata; idata++ ) vgood[ idata ] = -1;
+
+/* Evaluate each function in turn for this block. */
+         for ( ifun = 0; ifun < nfun; ifun++ ) {
+            code = codes[ ifun ];
+            con = consts[ ifun ];
+            out = data_ptr[ ncoord_in + ifun ];
+            tos = -1;
+            icon = 0;
+            ncode = code[ 0 ];
+            for ( icode = 1; icode <= ncode; icode++ ) {
+               switch ( (Oper) code[ icode ] ) {
+                  case OP_NULL: break;
+
+/* Loading a constant fills the vector for the new top of stack
+   element. */
+                  case OP_LDCON:
+                     value = con[ icon++ ];
+                     yv = STACK_VECTOR( tos + 1 );
+                     tos++;
+                     for ( point = 0; point < npt; point++ ) yv[ point ] = value;
+                     stack[ tos ] = yv;
+                     good[ tos ] = ( value != AST__BAD );
+                     break;
+
+/* Loading a variable simply makes the new top of stack element point at
+   the variable's values. The first time each variable is used within a
+   block, check it for bad values. */
+                  case OP_LDVAR:
+                     ivar = (int) ( con[ icon++ ] + 0.5 );
+                     xv = data_ptr[ ivar ];
+                     if ( vgood[ ivar ] == -1 ) {
+                        nbad = 0;
+                        for ( point = 0; point < npt; point++ ) {
+                           nbad += ( xv[ point ] == AST__BAD );
+                        }
+                        vgood[ ivar ] = !nbad;
+                     }
+                     stack[ ++tos ] = xv;
+                     good[ tos ] = vgood[ ivar ];
+                     break;
+
+/* All other operations. */
+                  OPERATIONS
+               }
+            }
+
+/* If the result was not produced in the output array (e.g. because the
+   function simply returns the value of a variable), copy it there. */
+            if ( tos == 0 && stack[ 0 ] != out ) {
+               xv = stack[ 0 ];
+               for ( point = 0; point < npt; point++ ) out[ point ] = xv[ point ];
+            }
          }
       }
    }
 
-/* When all opcodes have been processed, the result of the function
-   evaluation will reside in the lowest stack entry - i.e. the output
-   array. */
-
 /* Free the workspace arrays. */
-   work = astFree( work );
+   data_ptr = astFree( data_ptr );
+   good = astFree( good );
    stack = astFree( stack );
+   vgood = astFree( vgood );
+   work = astFree( work );
 
-/* Undefine macros local to this function. */
+/* Undefine macros local to this function, together with those shared
+   with EvaluateFunction. */
+#undef STACK_VECTOR
 #undef ARG_0
 #undef ARG_1
 #undef ARG_1B
 #undef DO_ARG_2
 #undef ARG_2
 #undef ARG_2B
+#undef ARG_3B
+#undef OPERATIONS
 #undef ABS
 #undef INT
 #undef CATCH_MATHS_OVERFLOW
@@ -3360,6 +3834,224 @@ static void ExtractVariables( const char *method, const char *class,
    }
 }
 
+static void FoldConstants( int stacksize, int **code, double **con,
+                           int *status ) {
+/*
+*  Name:
+*     FoldConstants
+
+*  Purpose:
+*     Evaluate constant sub-expressions in a compiled function.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "mathmap.h"
+*     void FoldConstants( int stacksize, int **code, double **con,
+*                         int *status )
+
+*  Class Membership:
+*     MathMap member function.
+
+*  Description:
+*     This function examines the opcodes and constants produced by
+*     compiling an expression, and replaces each operation whose
+*     arguments are all constants (together with the operations that
+*     load those arguments) with a single operation that loads the
+*     result. System and mathematical constants (such as "<pi>") are
+*     replaced in the same way. The folded values are found using
+*     EvaluateFunction, so the results of evaluating the function are
+*     unchanged. Operations that generate random numbers are never
+*     folded.
+
+*  Parameters:
+*     stacksize
+*        The stack size required to evaluate the original function. This
+*        is also sufficient for the folded function.
+*     code
+*        Address of a pointer to an array of int holding the opcodes for
+*        the function, as produced by EvaluationSort. On exit, the
+*        pointer may have been changed to point at a new array.
+*     con
+*        Address of a pointer to an array of double holding the constants
+*        for the function. On exit, the pointer may have been changed to
+*        point at a new array.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   Oper oper;                    /* Opcode */
+   double *argcon;               /* Constants for folded operation */
+   double *newcon;               /* Constants for folded function */
+   double *stkval;               /* Value of each constant stack entry */
+   double value;                 /* Value to load */
+   int *argcode;                 /* Opcodes for folded operation */
+   int *newcode;                 /* Opcodes for folded function */
+   int *stkcode;                 /* Index of first opcode for stack entry */
+   int *stkcon;                  /* Index of first constant for stack entry */
+   int *stkfix;                  /* Is stack entry a constant? */
+   int fold;                     /* Can the operation be folded? */
+   int iarg;                     /* Loop counter for arguments */
+   int icode;                    /* Loop counter for opcodes */
+   int icon;                     /* Counter for constants used */
+   int isym;                     /* Loop counter for symbols */
+   int narg;                     /* Number of operation arguments */
+   int ncode;                    /* Number of opcodes */
+   int ncon;                     /* Number of constants in folded function */
+   int nnew;                     /* Number of opcodes in folded function */
+   int tos;                      /* Top of stack index */
+
+/* Check the global error status. */
+   if ( !astOK || !*code ) return;
+
+/* Allocate workspace. The folded function never has more opcodes than
+   the original. */
+   ncode = ( *code )[ 0 ];
+   newcode = astMalloc( sizeof( int ) * (size_t) ( ncode + 1 ) );
+   stkval = astMalloc( sizeof( double ) * (size_t) ( stacksize + 1 ) );
+   stkcode = astMalloc( sizeof( int ) * (size_t) ( stacksize + 1 ) );
+   stkcon = astMalloc( sizeof( int ) * (size_t) ( stacksize + 1 ) );
+   stkfix = astMalloc( sizeof( int ) * (size_t) ( stacksize + 1 ) );
+   argcode = astMalloc( sizeof( int ) * (size_t) ( stacksize + 2 ) );
+   argcon = astMalloc( sizeof( double ) * (size_t) ( stacksize + 1 ) );
+   newcon = NULL;
+   ncon = 0;
+   nnew = 0;
+
+/* Simulate the evaluation of the function on a stack, noting for each
+   stack entry whether it holds a constant value and, if so, the index
+   of the first opcode and constant used to produce it. */
+   tos = -1;
+   icon = 0;
+   for ( icode = 1; astOK && ( icode <= ncode ); icode++ ) {
+      oper = (Oper) ( *code )[ icode ];
+
+/* Null operations have no effect, so omit them. */
+      if ( oper == OP_NULL ) {
+         continue;
+
+/* Variables are never constant. Copy the opcode and its constant to
+   the folded function. */
+      } else if ( oper == OP_LDVAR ) {
+         newcon = astGrow( newcon, ncon + 1, sizeof( double ) );
+         if ( astOK ) {
+            stkfix[ ++tos ] = 0;
+            stkcode[ tos ] = nnew + 1;
+            stkcon[ tos ] = ncon;
+            newcode[ ++nnew ] = (int) oper;
+            newcon[ ncon++ ] = ( *con )[ icon++ ];
+         }
+         continue;
+
+/* User-supplied constants are always constant. */
+      } else if ( oper == OP_LDCON ) {
+         value = ( *con )[ icon++ ];
+         narg = 0;
+         fold = 1;
+
+/* Otherwise, find the number of arguments used by the operation. For
+   functions with a variable number of arguments, this is given by the
+   next constant. Otherwise, it is determined by the change in stack
+   size recorded for the corresponding symbol. */
+      } else {
+         if ( oper == OP_MAX || oper == OP_MIN ) {
+            narg = (int) ( ( *con )[ icon ] + 0.5 );
+         } else {
+            narg = 0;
+            for ( isym = 0; symbol[ isym ].text; isym++ ) {
+               if ( symbol[ isym ].opcode == oper ) {
+                  narg = 1 - symbol[ isym ].stackincrement;
+                  break;
+               }
+            }
+         }
+
+/* The operation can be folded if all its arguments are constant,
+   unless it generates random numbers. */
+         fold = ( oper != OP_GAUSS && oper != OP_POISS && oper != OP_RAND );
+         for ( iarg = 0; iarg < narg; iarg++ ) {
+            if ( !stkfix[ tos - iarg ] ) fold = 0;
+         }
+
+/* If so, use EvaluateFunction to apply the operation to the constant
+   argument values. */
+         if ( fold ) {
+            argcode[ 0 ] = narg + 1;
+            for ( iarg = 0; iarg < narg; iarg++ ) {
+               argcode[ iarg + 1 ] = (int) OP_LDCON;
+               argcon[ iarg ] = stkval[ tos - narg + 1 + iarg ];
+            }
+            argcode[ narg + 1 ] = (int) oper;
+            if ( oper == OP_MAX || oper == OP_MIN ) {
+               argcon[ narg ] = ( *con )[ icon++ ];
+            }
+            EvaluateFunction( NULL, 1, NULL, argcode, argcon,
+                              ( narg > 0 ) ? narg : 1, &value, status );
+
+/* Remove the opcodes and constants that load the arguments. */
+            if ( narg > 0 ) {
+               tos -= narg;
+               nnew = stkcode[ tos + 1 ] - 1;
+               ncon = stkcon[ tos + 1 ];
+            }
+
+/* If the operation cannot be folded, copy it (and any constant it uses)
+   to the folded function. Its result is not constant. */
+         } else {
+            if ( oper == OP_MAX || oper == OP_MIN ) {
+               newcon = astGrow( newcon, ncon + 1, sizeof( double ) );
+               if ( astOK ) newcon[ ncon++ ] = ( *con )[ icon++ ];
+            }
+            if ( astOK ) {
+               tos -= narg;
+               stkfix[ ++tos ] = 0;
+               if ( narg == 0 ) {
+                  stkcode[ tos ] = nnew + 1;
+                  stkcon[ tos ] = ncon;
+               }
+               newcode[ ++nnew ] = (int) oper;
+            }
+         }
+      }
+
+/* If the result is constant, append an operation to load it. */
+      if ( fold ) {
+         newcon = astGrow( newcon, ncon + 1, sizeof( double ) );
+         if ( astOK ) {
+            stkfix[ ++tos ] = 1;
+            stkval[ tos ] = value;
+            stkcode[ tos ] = nnew + 1;
+            stkcon[ tos ] = ncon;
+            newcode[ ++nnew ] = (int) OP_LDCON;
+            newcon[ ncon++ ] = value;
+         }
+      }
+   }
+
+/* If OK, replace the original opcodes and constants. */
+   if ( astOK ) {
+      newcode[ 0 ] = nnew;
+      ( *code ) = astFree( *code );
+      ( *code ) = astRealloc( newcode, sizeof( int ) * (size_t) ( nnew + 1 ) );
+      newcode = NULL;
+      ( *con ) = astFree( *con );
+      ( *con ) = newcon;
+      newcon = NULL;
+   }
+
+/* Free the workspace. */
+   argcode = astFree( argcode );
+   argcon = astFree( argcon );
+   newcode = astFree( newcode );
+   newcon = astFree( newcon );
+   stkcode = astFree( stkcode );
+   stkcon = astFree( stkcon );
+   stkfix = astFree( stkfix );
+   stkval = astFree( stkval );
+}
+
 static double Gauss( Rcontext *context, int *status ) {
 /*
 *  Name:
@@ -4164,6 +4856,66 @@ static int MapMerge( AstMapping *this, int where, int series, int *nmap,
    return result;
 }
 
+int astMathMapBlock_( int newval, int *status ){
+/*
+*+
+*  Name:
+*     astMathMapBlock
+
+*  Purpose:
+*     Get or set the MathMapBlock tuning parameter.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "mathmap.h"
+*     int astMathMapBlock( int newval )
+
+*  Class Membership:
+*     MathMap member function.
+
+*  Description:
+*     This function returns the current value of the MathMapBlock tuning
+*     parameter (see astTune), optionally storing a new value. This is
+*     the number of points that are passed through all the functions of
+*     a MathMap together when the MathMap is used to transform a set of
+*     points. A value of zero causes each function to be evaluated in
+*     turn for all points, using the original interpreter.
+*
+*     All threads share the same value.
+
+*  Parameters:
+*     newval
+*        The new value for the MathMapBlock tuning parameter. If AST__TUNULL
+*        is supplied, the current value is left unchanged. Negative values
+*        are treated as zero.
+
+*  Returned Value:
+*     astMathMapBlock()
+*        The original value of the MathMapBlock tuning parameter.
+
+*  Notes:
+*     - The choice of evaluator does not affect the transformed
+*     coordinate values, only the speed with which they are found.
+*     - MathMaps that use random number functions are always evaluated
+*     using the original interpreter.
+*     - This function attempts to execute even if the AST error status
+*     is set on entry.
+*-
+*/
+
+/* Local Variables: */
+   int result;
+
+   LOCK_MUTEX8
+   result = mathmap_block;
+   if( newval != AST__TUNULL ) mathmap_block = ( newval > 0 ) ? newval : 0;
+   UNLOCK_MUTEX8
+
+   return result;
+}
+
 static void ParseConstant( const char *method, const char *class,
                            const char *exprs, int istart, int *iend,
                            double *con, int *status ) {
@@ -5187,10 +5939,14 @@ static AstPointSet *Transform( AstMapping *map, AstPointSet *in,
 /* Local Variables: */
    AstMathMap *this;             /* Pointer to MathMap to be applied */
    AstPointSet *result;          /* Pointer to output PointSet */
+   Oper oper;                    /* Opcode */
    double **data_ptr;            /* Array of pointers to coordinate data */
    double **ptr_in;              /* Pointer to input coordinate data */
    double **ptr_out;             /* Pointer to output coordinate data */
    double *work;                 /* Workspace for intermediate results */
+   int **codes;                  /* Opcodes for each function */
+   int block;                    /* No. of points evaluated together */
+   int icode;                    /* Loop counter for opcodes */
    int idata;                    /* Loop counter for data pointer elements */
    int ifun;                     /* Loop counter for functions */
    int ncoord_in;                /* Number of coordinates per input point */
@@ -5237,47 +5993,74 @@ static AstPointSet *Transform( AstMapping *map, AstPointSet *in,
    calculated. */
    nfun = forward ? this->nfwd : this->ninv;
 
+/* Unless it has been disabled using the "MathMapBlock" tuning parameter,
+   evaluate all the functions together for successive blocks of points.
+   This is not done if any function uses random numbers, since the
+   sequence of random values generated would then differ from that
+   produced by the original interpreter. */
+   block = astMathMapBlock( AST__TUNULL );
+   codes = forward ? this->fwdcode : this->invcode;
+   for ( ifun = 0; astOK && ( ifun < nfun ) && ( block > 0 ); ifun++ ) {
+      for ( icode = 1; icode <= codes[ ifun ][ 0 ]; icode++ ) {
+         oper = (Oper) codes[ ifun ][ icode ];
+         if ( oper == OP_GAUSS || oper == OP_POISS || oper == OP_RAND ) {
+            block = 0;
+            break;
+         }
+      }
+   }
+
+   if ( astOK && ( block > 0 ) ) {
+      EvaluateFused( &this->rcontext, npoint, ncoord_in, ptr_in, ncoord_out,
+                     ptr_out, nfun, codes,
+                     forward ? this->fwdcon : this->invcon,
+                     forward ? this->fwdstack : this->invstack, block,
+                     status );
+
+/* Otherwise, evaluate each function in turn for all points. */
+   } else {
+
 /* If intermediate results are to be calculated, then allocate
    workspace to hold them (each intermediate result being a vector of
    "npoint" double values). */
-   if ( nfun > ncoord_out ) {
-      work = astMalloc( sizeof( double) *
-                        (size_t) ( npoint * ( nfun - ncoord_out ) ) );
-   }
+      if ( nfun > ncoord_out ) {
+         work = astMalloc( sizeof( double) *
+                           (size_t) ( npoint * ( nfun - ncoord_out ) ) );
+      }
 
 /* Also allocate space for an array to hold pointers to the input
    data, intermediate results and output data. */
-   data_ptr = astMalloc( sizeof( double * ) * (size_t) ( ncoord_in + nfun ) );
+      data_ptr = astMalloc( sizeof( double * ) * (size_t) ( ncoord_in + nfun ) );
 
 /* We now set up the "data_ptr" array to locate the data to be
    processed. */
-   if ( astOK ) {
+      if ( astOK ) {
 
 /* The first elements of this array point at the input data
    vectors. */
-      ndata = 0;
-      for ( idata = 0; idata < ncoord_in; idata++ ) {
-         data_ptr[ ndata++ ] = ptr_in[ idata ];
-      }
+         ndata = 0;
+         for ( idata = 0; idata < ncoord_in; idata++ ) {
+            data_ptr[ ndata++ ] = ptr_in[ idata ];
+         }
 
 /* The following elements point at successive vectors within the
    workspace array (if allocated). These vectors will act first as output
    arrays for intermediate results, and then as input arrays for
    subsequent calculations which use these results. */
-      for ( idata = 0; idata < ( nfun - ncoord_out ); idata++ ) {
-         data_ptr[ ndata++ ] = work + ( idata * npoint );
-      }
+         for ( idata = 0; idata < ( nfun - ncoord_out ); idata++ ) {
+            data_ptr[ ndata++ ] = work + ( idata * npoint );
+         }
 
 /* The final elements point at the output coordinate data arrays into
    which the final results will be written. */
-      for ( idata = 0; idata < ncoord_out; idata++ ) {
-         data_ptr[ ndata++ ] = ptr_out[ idata ];
-      }
+         for ( idata = 0; idata < ncoord_out; idata++ ) {
+            data_ptr[ ndata++ ] = ptr_out[ idata ];
+         }
 
 /* Perform coordinate transformation. */
 /* ---------------------------------- */
 /* Loop to evaluate each transformation function in turn. */
-      for ( ifun = 0; ifun < nfun; ifun++ ) {
+         for ( ifun = 0; ifun < nfun; ifun++ ) {
 
 /* Invoke the function that evaluates compiled expressions. Pass the
    appropriate code and constants arrays, depending on the direction of
@@ -5286,20 +6069,21 @@ static AstPointSet *Transform( AstMapping *map, AstPointSet *in,
    "data_ptr" array (skipping the input data elements), while the
    function has access to all previous elements of the "data_ptr" array
    to locate the required input data. */
-         EvaluateFunction( &this->rcontext, npoint, (const double **) data_ptr,
-                           forward ? this->fwdcode[ ifun ] :
-                                     this->invcode[ ifun ],
-                           forward ? this->fwdcon[ ifun ] :
-                                     this->invcon[ ifun ],
-                           forward ? this->fwdstack : this->invstack,
-                           data_ptr[ ifun + ncoord_in ], status );
+            EvaluateFunction( &this->rcontext, npoint, (const double **) data_ptr,
+                              forward ? this->fwdcode[ ifun ] :
+                                        this->invcode[ ifun ],
+                              forward ? this->fwdcon[ ifun ] :
+                                        this->invcon[ ifun ],
+                              forward ? this->fwdstack : this->invstack,
+                              data_ptr[ ifun + ncoord_in ], status );
+         }
       }
-   }
 
 /* Free the array of data pointers and any workspace allocated for
    intermediate results. */
-   data_ptr = astFree( data_ptr );
-   if ( nfun > ncoord_out ) work = astFree( work );
+      data_ptr = astFree( data_ptr );
+      if ( nfun > ncoord_out ) work = astFree( work );
+   }
 
 /* If an error occurred, then return a NULL pointer. If no output
    PointSet was supplied, also delete any new one that may have been
@@ -153,6 +153,8 @@
 *        Original version.
 *     8-JAN-2003 (DSB):
 *        Added protected astInitMathMapVtab method.
+*     16-OCT-2026 (DSB):
+*        Added protected astMathMapBlock function.
 *-
 */
 
@@ -329,6 +331,7 @@ void astClearSimpIF_( AstMathMap *, int * );
 void astSetSeed_( AstMathMap *, int, int * );
 void astSetSimpFI_( AstMathMap *, int, int * );
 void astSetSimpIF_( AstMathMap *, int, int * );
+int astMathMapBlock_( int, int * );
 #endif
 
 /* Function interfaces. */
@@ -401,6 +404,7 @@ astINVOKE(V,astTestSeed_(astCheckMathMap(this),STATUS_PTR))
 astINVOKE(V,astTestSimpFI_(astCheckMathMap(this),STATUS_PTR))
 #define astTestSimpIF(this) \
 astINVOKE(V,astTestSimpIF_(astCheckMathMap(this),STATUS_PTR))
+#define astMathMapBlock(newval) astERROR_INVOKE(astMathMapBlock_(newval,STATUS_PTR))
 #endif
 #endif
 
@@ -160,6 +160,17 @@
 *        insecure. Instead add new function astAppendStringf.
 *     26-MAR-2015 (DSB):
 *        Added astChrTrunc.
+*     16-OCT-2026 (DSB):
+*        Cache freed memory blocks by size class rather than by exact
+*        size, and raise the largest cached size to MXCSIZE bytes. Caching
+*        is now on by default, with the number of bytes held in each
+*        thread's cache limited to MXCBYTES except within an
+*        astBeginTempMem/astEndTempMem context. Also added
+*        astMemoryCacheStats, and allow astRealloc to resize a block in
+*        place if the new size is in the same size class.
+*     16-OCT-2026 (DSB):
+*        Added astFreeMemoryGlobals, which empties the cache of a thread
+*        when the thread exits.
 */
 
 /* Configuration results. */
@@ -181,6 +192,12 @@
 /* The maximum number of nested astBeginPM/astEndPM contexts. */
 #define PM_STACK_MAXSIZE 20
 
+/* The maximum number of bytes that may be held in the memory cache of
+   a single thread, except within an astBeginTempMem/astEndTempMem
+   context. Blocks freed when the cache is full are returned to the
+   system. */
+#define MXCBYTES 262144
+
 /* Select the appropriate memory management functions. These will be the
    system's malloc, calloc, free and realloc unless AST was configured with
    the "--with-starmem" option, in which case they will be the starmem
@@ -481,12 +498,24 @@ static pthread_mutex_t mutex2 = PTHREAD_MUTEX_INITIALIZER;
 #define cache astGLOBAL(Memory,Cache)
 #define cache_init astGLOBAL(Memory,Cache_Init)
 #define use_cache astGLOBAL(Memory,Use_Cache)
+#define cache_bytes astGLOBAL(Memory,Cache_Bytes)
+#define cache_nalloc astGLOBAL(Memory,Cache_Nalloc)
+#define cache_nhit astGLOBAL(Memory,Cache_Nhit)
+#define temp_level astGLOBAL(Memory,Temp_Level)
 
 /* Define the initial values for the global data for this module. */
 #define GLOBAL_inits \
    globals->Sizeof_Memory = 0; \
-   globals->Cache_Init = 0; \
-   globals->Use_Cache = 0; \
+   { \
+      int i; \
+      for( i = 0; i < MXCCLASS; i++ ) globals->Cache[ i ] = NULL; \
+   } \
+   globals->Cache_Init = 1; \
+   globals->Use_Cache = 1; \
+   globals->Cache_Bytes = 0; \
+   globals->Cache_Nalloc = 0; \
+   globals->Cache_Nhit = 0; \
+   globals->Temp_Level = 0; \
 
 /* Create the global initialisation function. */
 astMAKE_INITGLOBALS(Memory)
@@ -505,24 +534,39 @@ static size_t sizeof_memory = 0;
    allocate small blocks of memory. The vast majority of memory blocks
    allocated by AST are under 200 bytes in size. Each element in this array
    stores a pointer to the header for a free (i.e. allocated but currently
-   unused) memory block. The size of the memory block (not including the
-   Memory header) will equal the index at which the pointer is stored within
-   "cache". Each free memory block contains (in its Memory header) a pointer
-   to the header for another free memory block of the same size (or a NULL
-   pointer if there are no other free memory blocks of the same size). */
-static Memory *cache[ MXCSIZE + 1 ];
+   unused) memory block. All memory blocks of MXCSIZE bytes or less are
+   allocated with the capacity of their size class (see SizeClass), and
+   the index at which the pointer is stored within "cache" is the size
+   class. Each free memory block contains (in its Memory header) a pointer
+   to the header for another free memory block of the same size class (or
+   a NULL pointer if there are no other free memory blocks of the same
+   size class). */
+static Memory *cache[ MXCCLASS ];
 
 /* Has the "cache" array been initialised? */
-static int cache_init = 0;
+static int cache_init = 1;
 
 /* Should the cache be used? */
-static int use_cache = 0;
+static int use_cache = 1;
+
+/* The total capacity of the memory blocks currently in the cache. */
+static size_t cache_bytes = 0;
+
+/* The number of cacheable memory blocks requested, and the number of
+   those that were satisfied from the cache. */
+static size_t cache_nalloc = 0;
+static size_t cache_nhit = 0;
+
+/* The current astBeginTempMem/astEndTempMem nesting level. */
+static int temp_level = 0;
 
 #endif
 
 /* Prototypes for Private Functions. */
 /* ================================= */
+static int SizeClass( size_t, size_t * );
 static size_t SizeOfMemory( int * );
+static void TrimCache( size_t, int * );
 static char *CheckTempStart( const char *, const char *, const char *, char *, int *, int *, int *, int *, int *, int *, int *, int * );
 static char *ChrMatcher( const char *, const char *, const char *, const char *, const char *[], int, int, int, char ***, int *, const char **, int * );
 static char *ChrSuber( const char *, const char *, const char *[], int, int, char ***, int *, const char **, int * );
@@ -2119,7 +2163,9 @@ void *astFree_( void *ptr, int *status ) {
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
    Memory *mem;                  /* Pointer to memory header */
+   int iclass;                   /* Size class of the memory block */
    int isdynamic;                /* Is the memory dynamically allocated? */
+   size_t cap;                   /* Capacity of the memory block */
    size_t size;                  /* The usable size of the memory block */
 
 /* If needed, get a pointer to the thread specific global data structure. */
@@ -2143,11 +2189,16 @@ void *astFree_( void *ptr, int *status ) {
 #endif
 
 /* If the memory block is small enough, and the cache is being used, put it
-   into the cache rather than freeing it, so that it can be reused. */
+   into the cache rather than freeing it, so that it can be reused. The
+   number of bytes held in the cache is limited, except within an
+   astBeginTempMem/astEndTempMem context (the cache is trimmed when the
+   outermost context ends). */
       size = mem->size;
-      if( use_cache && size <= MXCSIZE ) {
-         mem->next = cache[ size ];
-         cache[ size ] = mem;
+      iclass = ( use_cache && size <= MXCSIZE ) ? SizeClass( size, &cap ) : -1;
+      if( iclass >= 0 && ( temp_level > 0 || cache_bytes + cap <= MXCBYTES ) ) {
+         mem->next = cache[ iclass ];
+         cache[ iclass ] = mem;
+         cache_bytes += cap;
 
 /* Set the size to zero to indicate that the memory block has been freed.
    The size of the block is implied by the Cache element it is stored in. */
@@ -2470,6 +2521,8 @@ void *astMalloc_( size_t size, int init, int *status ) {
    char errbuf[ ERRBUF_LEN ];    /* Buffer for system error message */
    char *errstat;                /* Pointer to system error message */
    Memory *mem;                  /* Pointer to space allocated by malloc */
+   int iclass;                   /* Size class of the memory block */
+   size_t cap;                   /* Capacity of the memory block */
    void *result;                 /* Returned pointer */
 
 /* Initialise. */
@@ -2493,12 +2546,30 @@ void *astMalloc_( size_t size, int init, int *status ) {
    to allocate the memory, including space for the header structure. */
    } else if ( size != (size_t ) 0 ) {
 
+/* Small memory blocks are always allocated with the full capacity of
+   their size class, so that any block in the class can later be re-used
+   for any size in the class. */
+      if( size <= MXCSIZE ) {
+         iclass = SizeClass( size, &cap );
+      } else {
+         iclass = -1;
+         cap = size;
+      }
+
 /* If the cache is being used and a cached memory block of the required size
-   is available, remove it from the cache array and use it. */
-      mem = ( use_cache && size <= MXCSIZE ) ? cache[ size ] : NULL;
+   class is available, remove it from the cache array and use it. The
+   "magic number" depends on the size, so reset it. */
+      mem = NULL;
+      if( use_cache && iclass >= 0 ) {
+         cache_nalloc++;
+         mem = cache[ iclass ];
+      }
       if( mem ) {
-         cache[ size ] = mem->next;
+         cache[ iclass ] = mem->next;
+         cache_bytes -= cap;
+         cache_nhit++;
          mem->next = NULL;
+         mem->magic = MAGIC( mem, size );
          mem->size = (size_t) size;
 
 /* Initialise the memory (but not the header) if required. */
@@ -2507,9 +2578,9 @@ void *astMalloc_( size_t size, int init, int *status ) {
 /* Otherwise, allocate a new memory block using "malloc" or "calloc". */
       } else {
          if( init ) {
-            mem = CALLOC( 1, SIZEOF_MEMORY + size );
+            mem = CALLOC( 1, SIZEOF_MEMORY + cap );
          } else {
-            mem = MALLOC( SIZEOF_MEMORY + size );
+            mem = MALLOC( SIZEOF_MEMORY + cap );
          }
 
 /* Report an error if malloc failed. */
@@ -3066,6 +3137,10 @@ int astMemCaching_( int newval, int *status ){
 *     If caching is switched on or off as a result of this call, then the
 *     current contents of the cache are discarded.
 *
+*     Caching is switched on by default. Freed memory blocks of up to
+*     4096 bytes are cached, grouped into size classes, until the cache
+*     holds 256 KiB (any further blocks are returned to the system).
+*
 *     Note, each thread has a separate cache. Calling this function
 *     affects only the currently executing thread.
 
@@ -3116,7 +3191,7 @@ int astMemCaching_( int newval, int *status ){
             Memory *next;
 
             id_list_size = 0;
-            for( i = 0; i <= MXCSIZE; i++ ) {
+            for( i = 0; i < MXCCLASS; i++ ) {
                next = cache[ i ];
                while( next ) {
                   id_list_size++;
@@ -3137,11 +3212,10 @@ int astMemCaching_( int newval, int *status ){
          }
 #endif
 
-         for( i = 0; i <= MXCSIZE; i++ ) {
+         for( i = 0; i < MXCCLASS; i++ ) {
             while( cache[ i ] ) {
                mem = cache[ i ];
                cache[ i ] = mem->next;
-               mem->size = (size_t) i;
 
 #ifdef MEM_DEBUG
                if( id_list ) {
@@ -3152,6 +3226,7 @@ int astMemCaching_( int newval, int *status ){
                FREE( mem );
             }
          }
+         cache_bytes = 0;
 
 /* If we are displaying the IDs of memory blocks still in the cache, sort
    them using a bubblesort algorithm, then display them. */
@@ -3190,7 +3265,7 @@ int astMemCaching_( int newval, int *status ){
 /* Otherwise, initialise the cache array to hold a NULL pointer at every
    element. */
       } else {
-         for( i = 0; i <= MXCSIZE; i++ ) cache[ i ] = NULL;
+         for( i = 0; i < MXCCLASS; i++ ) cache[ i ] = NULL;
          cache_init = 1;
       }
 
@@ -3203,6 +3278,219 @@ int astMemCaching_( int newval, int *status ){
    return result;
 }
 
+#if defined( THREAD_SAFE )
+void astFreeMemoryGlobals_( AstMemoryGlobals *globals ) {
+/*
+*+
+*  Name:
+*     astFreeMemoryGlobals
+
+*  Purpose:
+*     Empty the memory cache of a thread that is exiting.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     void astFreeMemoryGlobals( AstMemoryGlobals *globals )
+
+*  Description:
+*     This function returns all the memory blocks held in the cache
+*     within the supplied thread-specific global data to the system. It
+*     is invoked (via a pthreads thread-specific data destructor) when a
+*     thread that has used AST exits, so that the cached blocks are not
+*     lost. The cache remains usable, but caching is switched off.
+
+*  Parameters:
+*     globals
+*        Pointer to the Memory module's global data for the exiting
+*        thread. This is accessed directly, rather than via astGET_GLOBALS,
+*        since the thread-specific data for the thread may already have
+*        been detached from the thread.
+
+*  Notes:
+*     - This function does not use the inherited status.
+*-
+*/
+
+/* Local Variables: */
+   Memory *mem;
+   int i;
+
+/* Return each cached block to the system. */
+   if( globals && globals->Cache_Init ) {
+      for( i = 0; i < MXCCLASS; i++ ) {
+         while( globals->Cache[ i ] ) {
+            mem = globals->Cache[ i ];
+            globals->Cache[ i ] = mem->next;
+            FREE( mem );
+         }
+      }
+      globals->Cache_Bytes = 0;
+      globals->Use_Cache = 0;
+   }
+}
+#endif
+
+void astBeginTempMem_( int *status ) {
+/*
+*+
+*  Name:
+*     astBeginTempMem
+
+*  Purpose:
+*     Start a block of temporary memory allocations.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     astBeginTempMem
+
+*  Description:
+*     This function indicates that the code up to the matching
+*     astEndTempMem call is expected to allocate and free a large number
+*     of short-lived memory blocks (for instance, the temporary Objects
+*     and PointSets created while simplifying a Mapping). Within such a
+*     context, the usual limit on the number of bytes held in the memory
+*     cache of the current thread is suspended, so that every freed block
+*     of MXCSIZE bytes or less is retained for re-use rather than being
+*     returned to the system. When the outermost context ends, the cache
+*     is trimmed back to its normal limit, releasing the surplus blocks
+*     in bulk.
+*
+*     Matching pairs of astBeginTempMem/astEndTempMem calls may be
+*     nested. Each thread has its own nesting level.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+
+/* If needed, get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Increment the nesting level. */
+   temp_level++;
+}
+
+void astEndTempMem_( int *status ) {
+/*
+*+
+*  Name:
+*     astEndTempMem
+
+*  Purpose:
+*     End a block of temporary memory allocations.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     astEndTempMem
+
+*  Description:
+*     This function marks the end of a block of temporary memory
+*     allocations started by a matching call to astBeginTempMem. If this
+*     ends the outermost such block, the memory cache of the current
+*     thread is trimmed back to its normal limit.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+
+/* If needed, get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Report an error if there is no matching astBeginTempMem. */
+   if( temp_level <= 0 ) {
+      if( astOK ) {
+         astError( AST__INTER, "astEndTempMem: No matching astBeginTempMem "
+                   "call (internal AST programming error)." , status );
+      }
+
+/* Otherwise, decrement the nesting level and trim the cache if the
+   outermost context has ended. */
+   } else if( --temp_level == 0 ) {
+      TrimCache( MXCBYTES, status );
+   }
+}
+
+void astMemoryCacheStats_( int reset, size_t *nalloc, size_t *nhit,
+                           size_t *cached, int *status ) {
+/*
+*+
+*  Name:
+*     astMemoryCacheStats
+
+*  Purpose:
+*     Return statistics describing the use of the memory cache.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "memory.h"
+*     void astMemoryCacheStats( int reset, size_t *nalloc, size_t *nhit,
+*                               size_t *cached )
+
+*  Description:
+*     This function returns statistics describing the use of the memory
+*     cache by the current thread. Unlike astMemoryStats, it is available
+*     whether or not AST was built with memory debugging enabled.
+
+*  Parameters:
+*     reset
+*        If non-zero, the allocation counters are reset to zero after
+*        their current values have been returned.
+*     nalloc
+*        Address of a location at which to return the number of memory
+*        blocks small enough to be cached that have been requested
+*        whilst caching was switched on. May be NULL.
+*     nhit
+*        Address of a location at which to return the number of those
+*        requests that were satisfied from the cache, rather than by
+*        calling the system malloc. May be NULL.
+*     cached
+*        Address of a location at which to return the number of bytes
+*        currently held in the cache. May be NULL.
+
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* If needed, get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Return the statistics. */
+   if( nalloc ) *nalloc = cache_nalloc;
+   if( nhit ) *nhit = cache_nhit;
+   if( cached ) *cached = cache_bytes;
+
+/* Reset the counters if required. */
+   if( reset ) {
+      cache_nalloc = 0;
+      cache_nhit = 0;
+   }
+}
+
 void *astRealloc_( void *ptr, size_t size, int *status ) {
 /*
 *++
@@ -3263,7 +3551,10 @@ void *astRealloc_( void *ptr, size_t size, int *status ) {
    astDECLARE_GLOBALS
    char errbuf[ ERRBUF_LEN ];    /* Buffer for system error message */
    char *errstat;                /* Pointer to system error message */
+   int iclass;                   /* Size class of the new size */
    int isdynamic;                /* Was memory allocated dynamically? */
+   size_t cap;                   /* Capacity needed for the new size */
+   size_t oldcap;                /* Capacity of the existing block */
    void *result;                 /* Returned pointer */
    Memory *mem;                  /* Pointer to memory header */
 
@@ -3305,15 +3596,39 @@ void *astRealloc_( void *ptr, size_t size, int *status ) {
                astFree( ptr );
                result = NULL;
 
-/* Otherwise, reallocate the memory. */
+/* Otherwise, reallocate the memory. Small memory blocks are always
+   allocated with the capacity of their size class, so find the size
+   class for both the new and old sizes. */
             } else {
+               if( size <= MXCSIZE ) {
+                  iclass = SizeClass( size, &cap );
+               } else {
+                  iclass = -1;
+                  cap = size;
+               }
+               if( mem->size <= MXCSIZE ) {
+                  if( SizeClass( mem->size, &oldcap ) != iclass ) oldcap = 0;
+               } else {
+                  oldcap = 0;
+               }
+
+/* If the new size is in the same size class as the old size, the
+   existing block is already big enough, so just update its header.
+   This is not done when debugging memory use, since a new ID is then
+   needed for the reallocated block. */
+#ifdef MEM_DEBUG
+               oldcap = 0;
+#endif
+               if( oldcap ) {
+                  mem->magic = MAGIC( mem, size );
+                  mem->size = size;
 
 /* If the cache is being used, for small memory blocks, do the equivalent of
                mem = REALLOC( mem, SIZEOF_MEMORY + size );
 
    using astMalloc, astFree and memcpy explicitly in order to ensure
    that the memory blocks are cached. */
-               if( use_cache && ( mem->size <= MXCSIZE || size <= MXCSIZE ) ) {
+               } else if( use_cache && ( mem->size <= MXCSIZE || size <= MXCSIZE ) ) {
                   result = astMalloc( size );
                   if( result ) {
                      if( mem->size < size ) {
@@ -3334,7 +3649,7 @@ void *astRealloc_( void *ptr, size_t size, int *status ) {
                   DeIssue( mem, status );
 #endif
 
-                  mem = REALLOC( mem, SIZEOF_MEMORY + size );
+                  mem = REALLOC( mem, SIZEOF_MEMORY + cap );
 
 /* If this failed, report an error and return the original pointer
    value. */
@@ -3487,6 +3802,70 @@ size_t astSizeOf_( const void *ptr, int *status ) {
    return size;
 }
 
+static int SizeClass( size_t size, size_t *cap ){
+/*
+*  Name:
+*     SizeClass
+
+*  Purpose:
+*     Returns the cache size class for a memory block.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     int SizeClass( size_t size, size_t *cap )
+
+*  Description:
+*     This function returns the index of the size class to which a
+*     memory block of a given size belongs, together with the capacity
+*     with which all memory blocks in that class are allocated. Sizes up
+*     to 256 bytes are grouped into classes 16 bytes wide. Larger sizes,
+*     up to MXCSIZE, are split into 8 classes for each doubling in size,
+*     so that no more than about 12% of a block is unused.
+
+*  Parameters:
+*     size
+*        The size of the memory block, in bytes, excluding the Memory
+*        header. Must be in the range 1 to MXCSIZE.
+*     cap
+*        Pointer to a location at which to return the capacity of the
+*        size class, in bytes.
+
+*  Returned Value:
+*     The index of the size class, in the range 0 to MXCCLASS-1.
+
+*  Notes:
+*     - This function does not perform error checking.
+*/
+
+/* Local Variables: */
+   size_t base;                  /* Lower bound of the current doubling */
+   size_t step;                  /* Width of each class in the doubling */
+   int result;                   /* Returned class index */
+
+/* Small sizes use 16 linearly spaced classes. */
+   if( size <= 256 ) {
+      result = (int) ( ( size - 1 ) >> 4 );
+      *cap = (size_t) ( ( result + 1 ) << 4 );
+
+/* Larger sizes use 8 classes per doubling. Find the doubling that
+   contains the size, then the class within it. */
+   } else {
+      result = 16;
+      base = 256;
+      while( size > 2*base ) {
+         base *= 2;
+         result += 8;
+      }
+      step = base/8;
+      result += (int) ( ( size - 1 - base )/step );
+      *cap = base + ( ( size - 1 - base )/step + 1 )*step;
+   }
+
+   return result;
+}
+
 static size_t SizeOfMemory( int *status ){
 /*
 *  Name:
@@ -3543,6 +3922,70 @@ static size_t SizeOfMemory( int *status ){
 
 }
 
+static void TrimCache( size_t limit, int *status ){
+/*
+*  Name:
+*     TrimCache
+
+*  Purpose:
+*     Reduce the number of bytes held in the memory cache.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void TrimCache( size_t limit, int *status )
+
+*  Description:
+*     This function frees memory blocks held in the memory cache of the
+*     current thread until the cache holds no more than "limit" bytes.
+*     The largest blocks are freed first, since the small blocks are the
+*     ones most frequently re-used.
+
+*  Parameters:
+*     limit
+*        The maximum number of bytes to leave in the cache.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   Memory *mem;                  /* Pointer to memory header */
+   int iclass;                   /* Size class index */
+   size_t cap;                   /* Capacity of blocks in the size class */
+
+/* If needed, get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Free blocks, starting with the largest size class, until the cache is
+   small enough. */
+   for( iclass = MXCCLASS - 1; iclass >= 0 && cache_bytes > limit; iclass-- ) {
+
+/* Get the capacity of the blocks in the size class (the inverse of the
+   calculation in SizeClass). */
+      if( iclass < 16 ) {
+         cap = (size_t) ( ( iclass + 1 ) << 4 );
+      } else {
+         cap = (size_t) 256 << ( ( iclass - 16 )/8 );
+         cap += ( ( iclass - 16 )%8 + 1 )*( cap/8 );
+      }
+
+/* Free the blocks in the class. */
+      while( cache[ iclass ] && cache_bytes > limit ) {
+         mem = cache[ iclass ];
+         cache[ iclass ] = mem->next;
+         cache_bytes -= cap;
+         mem->magic = (unsigned long) 0;
+         FREE( mem );
+      }
+   }
+}
+
 size_t astTSizeOf_( const void *ptr, int *status ) {
 /*
 *+
@@ -117,6 +117,9 @@
 *        Added astStringCase.
 *     26-MAR-2015 (DSB):
 *        Added astChrTrunc.
+*     16-OCT-2026 (DSB):
+*        Added astBeginTempMem, astEndTempMem and astMemoryCacheStats,
+*        and cache memory blocks by size class.
 
 *-
 */
@@ -171,10 +174,16 @@ typedef struct Memory {
 } Memory;
 
 /* Define the largest size of a cached memory block in bytes. This does
-   not include the size of the Memory header. This does not need to be
-   too big because the vast majority of memory blocks allocated by AST are
-   less than a few hundred bytes. */
-#define MXCSIZE 300
+   not include the size of the Memory header. The vast majority of memory
+   blocks allocated by AST are less than a few hundred bytes, but the
+   limit is large enough to include the coordinate arrays of the small
+   PointSets used when transforming a few points at a time. */
+#define MXCSIZE 4096
+
+/* Cached memory blocks are grouped into size classes (see SizeClass in
+   memory.c). Define the number of size classes needed to cover all sizes
+   up to MXCSIZE. */
+#define MXCCLASS 48
 
 #endif
 
@@ -187,7 +196,11 @@ typedef struct AstMemoryGlobals {
    size_t Sizeof_Memory;
    int Cache_Init;
    int Use_Cache;
-   Memory *Cache[ MXCSIZE + 1 ];
+   Memory *Cache[ MXCCLASS ];
+   size_t Cache_Bytes;
+   size_t Cache_Nalloc;
+   size_t Cache_Nhit;
+   int Temp_Level;
 
 } AstMemoryGlobals;
 
@@ -198,6 +211,7 @@ typedef struct AstMemoryGlobals {
 
 #if defined(THREAD_SAFE) && defined(astCLASS)
 void astInitMemoryGlobals_( AstMemoryGlobals * );
+void astFreeMemoryGlobals_( AstMemoryGlobals * );
 #endif
 
 #if defined(astCLASS) || 1       /* Nominally protected, but available for */
@@ -239,6 +253,12 @@ void astEnableTimers_( int, int * );
 #endif
 
 
+#if defined(astCLASS)            /* Protected */
+void astBeginTempMem_( int * );
+void astEndTempMem_( int * );
+void astMemoryCacheStats_( int, size_t *, size_t *, size_t *, int * );
+#endif
+
 #ifdef MEM_DEBUG
 void astActiveMemory_( const char * );
 void astWatchMemory_( int );
@@ -288,6 +308,9 @@ void astEndPM_( int * );
 
 #if defined(astCLASS) /* Protected */
 #define astMallocInit(size) astMalloc_(size,1,STATUS_PTR)
+#define astBeginTempMem astERROR_INVOKE(astBeginTempMem_(STATUS_PTR))
+#define astEndTempMem astERROR_INVOKE(astEndTempMem_(STATUS_PTR))
+#define astMemoryCacheStats(reset,nalloc,nhit,cached) astERROR_INVOKE(astMemoryCacheStats_(reset,nalloc,nhit,cached,STATUS_PTR))
 #endif
 
 #ifdef HAVE_NONANSI_SSCANF
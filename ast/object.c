@@ -228,6 +228,47 @@ f     - AST_VERSION: Return the verson of the AST library being used.
 *        list of settings is provided as a single variable argument).
 *        This is needed because supplying the while settings string in
 *        place of "%s" is considered a security issue by many compilers.
+*     16-OCT-2026 (DSB):
+*        Added the NumThreads tuning parameter.
+*     16-OCT-2026 (DSB):
+*        Added the MathMapBlock tuning parameter.
+*     16-OCT-2026 (DSB):
+*        Added the CmpMapBlock tuning parameter.
+*     16-OCT-2026 (DSB):
+*        Store object Handles in fixed-size chunks that never move, and
+*        give each thread its own free Handle list and mutex so that
+*        creating, using and annulling identifiers no longer serialises
+*        all threads on a single global mutex.
+*     16-OCT-2026 (DSB):
+*        Added typed attribute access functions. Each class may declare
+*        functions that get, set, test and clear selected attributes in
+*        their native data type, held in a hash table within its virtual
+*        function table. astGetX, astSetX, astTest and astClear use these
+*        in preference to formatting and parsing attribute strings.
+*     16-OCT-2026 (DSB):
+*        Added the KernelTable tuning parameter.
+*     16-OCT-2026 (DSB):
+*        Added the LeapSeconds tuning parameter.
+*     16-OCT-2026 (DSB):
+*        Fix a deadlock in ManageLock that could occur if one thread
+*        tried to lock an unlocked Object just as another thread that was
+*        waiting for it obtained its primary mutex.
+*     16-OCT-2026 (DSB):
+*        Lock a thread's HandleHeap in TrimHeap before testing its number
+*        of free Handles, since other threads may be changing it.
+*     16-OCT-2026 (DSB):
+*        Move an Object between the active Object counts of the old and
+*        new vtabs in ChangeThreadVtab, so that Nobject is not left in
+*        error when an Object is deleted by a different thread to the
+*        one that created it.
+*     16-OCT-2026 (DSB):
+*        Added astFreeObjectGlobals, which returns the free Handles of an
+*        exiting thread to the global HandleHeap.
+*     16-OCT-2026 (DSB):
+*        Publish new Handle chunks and the new value of nhandles using
+*        release stores, and read them using acquire loads, since they
+*        are read by threads that do not hold the global HandleHeap
+*        locked.
 *class--
 */
 
@@ -261,6 +302,11 @@ f     - AST_VERSION: Return the verson of the AST library being used.
 #include "channel.h"             /* I/O channels */
 #include "object.h"              /* Interface definition for this class */
 #include "plot.h"                /* Plot class (for astStripEscapes) */
+#include "threads.h"             /* Thread pool (for astTune) */
+#include "mathmap.h"             /* MathMap evaluation (for astTune) */
+#include "cmpmap.h"              /* CmpMap pipelines (for astTune) */
+#include "mapping.h"             /* Kernel tables (for astTune) */
+#include "timemap.h"             /* Leap second tables (for astTuneC) */
 #include "globals.h"             /* Thread-safe global data access */
 
 /* Error code definitions. */
@@ -305,6 +351,7 @@ static char dgdel[ MAXLEN_TUNEC ] = "%-%^53+%s60+o%+";
 static char amdel[ MAXLEN_TUNEC ] = "%-%^20+%s85+'%+";
 static char asdel[ MAXLEN_TUNEC ] = "%-%^20+%s85+\"%+";
 static char exdel[ MAXLEN_TUNEC ] = "10%-%^50+%s70+";
+static char leapseconds[ MAXLEN_TUNEC ] = "";
 
 /* A pointer full of zeros. */
 static AstObject *zero_ptr;
@@ -332,6 +379,7 @@ static int object_caching = 0;
    globals->AstGetC_Init = 0; \
    globals->AstGetC_Istr = 0; \
    globals->Active_Handles = NULL; \
+   globals->Handle_Heap = NULL; \
    globals->Class_Init = 0; \
    globals->Nvtab = 0; \
    globals->Known_Vtabs = NULL;
@@ -343,6 +391,7 @@ astMAKE_INITGLOBALS(Object)
 #define retain_esc  astGLOBAL(Object,Retain_Esc)
 #define context_level  astGLOBAL(Object,Context_Level)
 #define active_handles  astGLOBAL(Object,Active_Handles)
+#define handle_heap  astGLOBAL(Object,Handle_Heap)
 #define getattrib_buff  astGLOBAL(Object,GetAttrib_Buff)
 #define astgetc_strings  astGLOBAL(Object,AstGetC_Strings)
 #define astgetc_istr  astGLOBAL(Object,AstGetC_Istr)
@@ -358,11 +407,11 @@ static pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER;
 #define LOCK_MUTEX1 pthread_mutex_lock( &mutex1 );
 #define UNLOCK_MUTEX1 pthread_mutex_unlock( &mutex1 );
 
-/* mutex2 is used to prevent the global lists of object handles being
-   accessed by more than one thread at any one time.  */
-static pthread_mutex_t mutex2 = PTHREAD_MUTEX_INITIALIZER;
-#define LOCK_MUTEX2 pthread_mutex_lock( &mutex2 );
-#define UNLOCK_MUTEX2 pthread_mutex_unlock( &mutex2 );
+/* Each list of object handles is guarded by the mutex in the HandleHeap
+   structure that owns it (see the "External Interface" section below).
+   Define macros for locking and unlocking a HandleHeap. */
+#define LOCK_HEAP(heap) pthread_mutex_lock( &((heap)->mutex) );
+#define UNLOCK_HEAP(heap) pthread_mutex_unlock( &((heap)->mutex) );
 
 /* Each Object contains two mutexes. The primary mutex (mutex1) is used
    to guard access to all aspects of the Object except for the "locker"
@@ -372,10 +421,17 @@ static pthread_mutex_t mutex2 = PTHREAD_MUTEX_INITIALIZER;
    a thread even if that thread has not locked the Object using astLock.
    Define macros for accessing these two mutexes. */
 #define LOCK_PMUTEX(this) (pthread_mutex_lock(&((this)->mutex1)))
+#define TRYLOCK_PMUTEX(this) (pthread_mutex_trylock(&((this)->mutex1)))
 #define UNLOCK_PMUTEX(this) (pthread_mutex_unlock(&((this)->mutex1)))
 #define LOCK_SMUTEX(this) (pthread_mutex_lock(&((this)->mutex2)))
 #define UNLOCK_SMUTEX(this) (pthread_mutex_unlock(&((this)->mutex2)))
 
+/* The count of active Objects in a vtab may be changed by threads other
+   than the one that created the vtab (see ChangeThreadVtab), so access it
+   atomically. NOBJECT_ADD returns the count before the change. */
+#define NOBJECT_ADD(vtab,val) __atomic_fetch_add(&((vtab)->nobject),val,__ATOMIC_SEQ_CST)
+#define NOBJECT_LOAD(vtab) __atomic_load_n(&((vtab)->nobject),__ATOMIC_SEQ_CST)
+
 
 
 
@@ -420,18 +476,24 @@ static int astgetc_init = 0;
 /* Null macros for mutex locking and unlocking */
 #define LOCK_MUTEX1
 #define UNLOCK_MUTEX1
-#define LOCK_MUTEX2
-#define UNLOCK_MUTEX2
+#define LOCK_HEAP(heap)
+#define UNLOCK_HEAP(heap)
 #define LOCK_PMUTEX(this)
 #define LOCK_SMUTEX(this)
 #define UNLOCK_PMUTEX(this)
 #define UNLOCK_SMUTEX(this)
 
+/* Plain access to the count of active Objects in a vtab. */
+#define NOBJECT_ADD(vtab,val) ( ( (vtab)->nobject += (val) ) - (val) )
+#define NOBJECT_LOAD(vtab) ( (vtab)->nobject )
+
 #endif
 
 
 /* Prototypes for Private Member Functions. */
 /* ======================================== */
+static AstAttribFns *DeclareAttrib( AstObjectVtab *, const char *, int * );
+static AstAttribFns *FindAttribFns( AstObject *, const char *, int * );
 static AstObject *Cast( AstObject *, AstObject *, int * );
 static const char *GetID( AstObject *, int * );
 static const char *GetAttrib( AstObject *, const char *, int * );
@@ -440,11 +502,14 @@ static const char *Get( AstObject *, const char *, int * );
 static const char *FromStringSource( void );
 static int Equal( AstObject *, AstObject *, int * );
 static int GetObjSize( AstObject *, int * );
+static int GetTyped( AstObject *, const char *, int, double *, int * );
 static int HasAttribute( AstObject *, const char *, int * );
 static int Same( AstObject *, AstObject *, int * );
+static int SetTyped( AstObject *, const char *, int, double, int * );
 static int TestAttrib( AstObject *, const char *, int * );
 static int TestID( AstObject *, int * );
 static int TestIdent( AstObject *, int * );
+static unsigned int AttribHash( const char *, int * );
 static unsigned long Magic( const AstObject *, size_t, int * );
 static void CleanAttribs( AstObject *, int * );
 static void Clear( AstObject *, const char *, int * );
@@ -466,6 +531,8 @@ static int TestUseDefs( AstObject *, int * );
 static void ClearUseDefs( AstObject *, int * );
 static void SetUseDefs( AstObject *, int, int * );
 
+static int GetNobjectAttrib( AstObject *, int * );
+
 #if defined(THREAD_SAFE)
 static void ChangeThreadVtab( AstObject *, int * );
 static int ManageLock( AstObject *, int, int, AstObject **, int * );
@@ -570,6 +637,60 @@ f     error value
    return NULL;
 }
 
+static unsigned int AttribHash( const char *attrib, int *status ) {
+/*
+*  Name:
+*     AttribHash
+
+*  Purpose:
+*     Find the hash bucket for an attribute name.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     unsigned int AttribHash( const char *attrib, int *status )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     This function returns the index of the bucket within the table of
+*     typed attribute functions (see astDeclareAttribI) that holds any
+*     functions for the named attribute. White space within the name is
+*     ignored, and upper and lower case are equivalent, as for the string
+*     interface.
+
+*  Parameters:
+*     attrib
+*        Pointer to a null-terminated string holding the attribute name.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The bucket index, in the range zero to (AST__NATTRIBFNS - 1).
+
+*  Notes:
+*     - This function does not check the inherited status.
+*/
+
+/* Local Variables: */
+   unsigned int result;          /* Hash value */
+
+/* Form an FNV-1a hash of the lower case, non-blank characters. */
+   result = 2166136261U;
+   for( ; *attrib; attrib++ ) {
+      if( !isspace( (unsigned char) *attrib ) ) {
+         result ^= (unsigned int) tolower( (unsigned char) *attrib );
+         result *= 16777619U;
+      }
+   }
+
+/* Return the bucket index. */
+   return result & ( AST__NATTRIBFNS - 1 );
+}
+
 static AstObject *Cast( AstObject *this, AstObject *obj, int *status ) {
 /*
 *+
@@ -775,7 +896,11 @@ static void ChangeThreadVtab( AstObject *this, int *status ){
 *     data. Each time an Object is locked by the currently executing
 *     thread, this function should be called to change the vtab pointer
 *     in the Object to refer to the vtab relevant to the currently
-*     executing thread.
+*     executing thread. The Object is also moved from the count of
+*     active Objects in the old vtab to the count in the new vtab, so
+*     that an Object deleted by a different thread to the one that
+*     created it does not leave the counts (and so the Nobject
+*     attribute) in error.
 
 *  Parameters:
 *     this
@@ -787,6 +912,7 @@ static void ChangeThreadVtab( AstObject *this, int *status ){
 
 /* Local Variables: */
    astDECLARE_GLOBALS
+   AstObjectVtab *vtab;
    const char *class;
    int i;
 
@@ -813,7 +939,12 @@ static void ChangeThreadVtab( AstObject *this, int *status ){
    supplied Object, then store a pointer to the vtab in the Object
    structure, and exit. */
          if( !strcmp( class, known_vtabs[ i ]->class ) ) {
-            this->vtab = known_vtabs[ i ];
+            vtab = known_vtabs[ i ];
+            if( this->vtab != vtab ) {
+               (void) NOBJECT_ADD( this->vtab, -1 );
+               (void) NOBJECT_ADD( vtab, 1 );
+               this->vtab = vtab;
+            }
             break;
          }
       }
@@ -1092,6 +1223,7 @@ f        This routine applies to all Objects.
 */
 
 /* Local Variables: */
+   AstAttribFns *fns;            /* Pointer to typed access functions */
    char *buff;                   /* Pointer to character buffer */
    char *name;                   /* Pointer to individual attribute name */
    char *name_end;               /* Pointer to null at end of name */
@@ -1126,9 +1258,17 @@ f        This routine applies to all Objects.
 
 /* Terminate the attribute name and pass it to astClearAttrib to clear
    the attribute (unless it is all blank, in which case we ignore
-   it). */
+   it). Use any typed function declared by the class for clearing the
+   attribute instead, if available. */
             name[ j ] = '\0';
-            if ( j ) astClearAttrib( this, name );
+            if ( j ) {
+               fns = FindAttribFns( this, name, status );
+               if( fns && fns->Clear ) {
+                  (*fns->Clear)( this, status );
+               } else {
+                  astClearAttrib( this, name );
+               }
+            }
 
 /* Check for errors and abort if any clear operation fails. Otherwise,
    process the next attribute. */
@@ -1448,12 +1588,258 @@ f     function is invoked with STATUS set to an error value, or if it
    }
 
 /* If OK, increment the count of active objects. */
-   if ( astOK ) vtab->nobject++;
+   if ( astOK ) (void) NOBJECT_ADD( vtab, 1 );
 
 /* Return a pointer to the new Object. */
    return new;
 }
 
+static AstAttribFns *DeclareAttrib( AstObjectVtab *vtab, const char *name,
+                                    int *status ) {
+/*
+*  Name:
+*     DeclareAttrib
+
+*  Purpose:
+*     Create or re-use the entry for an attribute in a table of typed
+*     attribute functions.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     AstAttribFns *DeclareAttrib( AstObjectVtab *vtab, const char *name,
+*                                  int *status )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     This function returns a pointer to the entry for the named
+*     attribute in the table of typed attribute functions held in the
+*     supplied virtual function table, creating a new entry if none
+*     exists. All the function pointers in the returned entry are
+*     NULL, so any functions declared previously for the same attribute
+*     (e.g. by a parent class) are discarded.
+
+*  Parameters:
+*     vtab
+*        Pointer to the virtual function table.
+*     name
+*        Pointer to a constant null-terminated string holding the
+*        attribute name in lower case, with no white space. The pointer
+*        is stored in the table, so the string should not be modified
+*        or freed.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the table entry, or NULL if an error occurs.
+*/
+
+/* Local Variables: */
+   AstAttribFns **head;          /* Pointer to head of hash bucket */
+   AstAttribFns *result;         /* Pointer to returned entry */
+
+/* Check the global status. */
+   if ( !astOK ) return NULL;
+
+/* Search the bucket for an existing entry with the same name. */
+   head = vtab->attrib_fns + AttribHash( name, status );
+   for( result = *head; result; result = result->next ) {
+      if( !strcmp( result->name, name ) ) break;
+   }
+
+/* If not found, create a new entry and add it to the head of the
+   bucket. This memory is never freed, like the rest of the virtual
+   function table. */
+   if( !result ) {
+      astBeginPM;
+      result = astMalloc( sizeof( AstAttribFns ) );
+      astEndPM;
+      if( astOK ) {
+         result->name = name;
+         result->next = *head;
+         *head = result;
+      }
+   }
+
+/* Nullify all the function pointers. */
+   if( result ) {
+      result->GetI = NULL;
+      result->GetD = NULL;
+      result->GetC = NULL;
+      result->SetI = NULL;
+      result->SetD = NULL;
+      result->Test = NULL;
+      result->Clear = NULL;
+   }
+
+/* Return the entry. */
+   return result;
+}
+
+void astDeclareAttribI_( AstObjectVtab *vtab, const char *name,
+                         int (* get)( AstObject *, int * ),
+                         void (* set)( AstObject *, int, int * ),
+                         int (* test)( AstObject *, int * ),
+                         void (* clear)( AstObject *, int * ), int *status ) {
+/*
+*+
+*  Name:
+*     astDeclareAttribC/D/I
+
+*  Purpose:
+*     Declare typed access functions for an attribute.
+
+*  Type:
+*     Protected functions.
+
+*  Synopsis:
+*     #include "object.h"
+*     void astDeclareAttribI( AstObjectVtab *vtab, const char *name,
+*                             int (* get)( AstObject *, int * ),
+*                             void (* set)( AstObject *, int, int * ),
+*                             int (* test)( AstObject *, int * ),
+*                             void (* clear)( AstObject *, int * ) )
+*     void astDeclareAttribD( AstObjectVtab *vtab, const char *name,
+*                             double (* get)( AstObject *, int * ),
+*                             void (* set)( AstObject *, double, int * ),
+*                             int (* test)( AstObject *, int * ),
+*                             void (* clear)( AstObject *, int * ) )
+*     void astDeclareAttribC( AstObjectVtab *vtab, const char *name,
+*                             const char *(* get)( AstObject *, int * ),
+*                             int (* test)( AstObject *, int * ),
+*                             void (* clear)( AstObject *, int * ) )
+
+*  Class Membership:
+*     Object method.
+
+*  Description:
+*     These functions are provided so that class definitions can declare
+*     functions that access an integer, floating point or string
+*     attribute directly, in its native data type. They are used by
+*     astGet<X>, astSet<X>, astTest and astClear in preference to the
+*     astGetAttrib, astSetAttrib, astTestAttrib and astClearAttrib methods,
+*     avoiding the cost of formatting, parsing and comparing attribute
+*     names with each name known to the class. The attribute name is
+*     resolved using a hash table held in the virtual function table.
+*
+*     Integer values are used by astGet<X> for any data type, and are
+*     used by astSetI and astSetL. Floating point values are used by
+*     astGetD and astGetF, and by astSetD, astSetI and astSetL. String
+*     values are used by astGetC. In all other cases, and for any
+*     function that is supplied as NULL, the string interface is used.
+
+*  Parameters:
+*     vtab
+*        Pointer to the virtual function table of the class. The
+*        functions are inherited by the virtual function tables of all
+*        derived classes.
+*     name
+*        Pointer to a constant null-terminated string holding the
+*        attribute name in lower case, with no white space.
+*     get
+*        Pointer to a function that returns the attribute value.
+*     set
+*        Pointer to a function that sets the attribute value, or NULL
+*        for a read-only attribute.
+*     test
+*        Pointer to a function that tests if the attribute is set, or
+*        NULL for a read-only attribute.
+*     clear
+*        Pointer to a function that clears the attribute, or NULL for a
+*        read-only attribute.
+
+*  Notes:
+*     - Each function must produce the same result as the corresponding
+*     string interface method of the class (other than rounding
+*     introduced by formatting floating point values), and should
+*     normally just invoke the attribute's virtual accessor methods (see
+*     astMAKE_ATTRIBGET, etc.). A later declaration for the same
+*     attribute, for instance by a derived class, replaces all the
+*     functions declared previously.
+*     - A derived class that over-rides astGetAttrib, etc., so that an
+*     attribute is interpreted differently (for instance, by forwarding
+*     it to another Object) should use astForwardAttribs to remove the
+*     functions inherited for it.
+*-
+*/
+
+/* Local Variables: */
+   AstAttribFns *fns;            /* Pointer to table entry */
+
+/* Create or re-use the table entry, and store the function pointers. */
+   fns = DeclareAttrib( vtab, name, status );
+   if( fns ) {
+      fns->GetI = get;
+      fns->SetI = set;
+      fns->Test = test;
+      fns->Clear = clear;
+   }
+}
+
+void astDeclareAttribD_( AstObjectVtab *vtab, const char *name,
+                         double (* get)( AstObject *, int * ),
+                         void (* set)( AstObject *, double, int * ),
+                         int (* test)( AstObject *, int * ),
+                         void (* clear)( AstObject *, int * ), int *status ) {
+/*
+*+
+*  Name:
+*     astDeclareAttribD
+
+*  Purpose:
+*     Declare typed access functions for a floating point attribute.
+
+*  Description:
+*     This function implements astDeclareAttribD. See astDeclareAttribI.
+*-
+*/
+
+/* Local Variables: */
+   AstAttribFns *fns;            /* Pointer to table entry */
+
+/* Create or re-use the table entry, and store the function pointers. */
+   fns = DeclareAttrib( vtab, name, status );
+   if( fns ) {
+      fns->GetD = get;
+      fns->SetD = set;
+      fns->Test = test;
+      fns->Clear = clear;
+   }
+}
+
+void astDeclareAttribC_( AstObjectVtab *vtab, const char *name,
+                         const char *(* get)( AstObject *, int * ),
+                         int (* test)( AstObject *, int * ),
+                         void (* clear)( AstObject *, int * ), int *status ) {
+/*
+*+
+*  Name:
+*     astDeclareAttribC
+
+*  Purpose:
+*     Declare typed access functions for a string attribute.
+
+*  Description:
+*     This function implements astDeclareAttribC. See astDeclareAttribI.
+*-
+*/
+
+/* Local Variables: */
+   AstAttribFns *fns;            /* Pointer to table entry */
+
+/* Create or re-use the table entry, and store the function pointers. */
+   fns = DeclareAttrib( vtab, name, status );
+   if( fns ) {
+      fns->GetC = get;
+      fns->Test = test;
+      fns->Clear = clear;
+   }
+}
+
 AstObject *astDelete_( AstObject *this, int *status ) {
 /*
 *++
@@ -1582,7 +1968,7 @@ f     value
    }
 
 /* Decrement the count of active Objects. */
-   vtab->nobject--;
+   (void) NOBJECT_ADD( vtab, -1 );
 
 /* Always return NULL. */
    return NULL;
@@ -1936,6 +2322,159 @@ static int Equal( AstObject *this, AstObject *that, int *status ){
    return result;
 }
 
+static AstAttribFns *FindAttribFns( AstObject *this, const char *attrib,
+                                    int *status ) {
+/*
+*  Name:
+*     FindAttribFns
+
+*  Purpose:
+*     Find the typed access functions for an attribute.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     AstAttribFns *FindAttribFns( AstObject *this, const char *attrib,
+*                                  int *status )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     This function searches the table of typed attribute functions
+*     declared by the class of the supplied Object (see astDeclareAttribI)
+*     for an entry describing the named attribute.
+
+*  Parameters:
+*     this
+*        Pointer to the Object.
+*     attrib
+*        Pointer to a null-terminated string containing the attribute
+*        name. This may contain mixed case and white space.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the table entry, or NULL if the class has not declared
+*     any typed functions for the attribute.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set.
+*/
+
+/* Local Variables: */
+   AstAttribFns *result;         /* Pointer to returned entry */
+   const char *a;                /* Pointer to next character in attrib */
+   const char *n;                /* Pointer to next character in name */
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Loop round the entries in the bucket selected by the hashed name. */
+   for( result = this->vtab->attrib_fns[ AttribHash( attrib, status ) ];
+        result; result = result->next ) {
+
+/* Compare the lower case entry name with the supplied name, ignoring
+   white space and case in the supplied name. Leave the loop if they
+   match. */
+      a = attrib;
+      n = result->name;
+      while( 1 ) {
+         while( isspace( (unsigned char) *a ) ) a++;
+         if( !*a || !*n || tolower( (unsigned char) *a ) != *n ) break;
+         a++;
+         n++;
+      }
+      if( !*a && !*n ) break;
+   }
+
+/* Return the entry. */
+   return result;
+}
+
+void astForwardAttribs_( AstObjectVtab *vtab, const char *keep,
+                         int *status ) {
+/*
+*+
+*  Name:
+*     astForwardAttribs
+
+*  Purpose:
+*     Remove inherited typed access functions for forwarded attributes.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "object.h"
+*     void astForwardAttribs( AstObjectVtab *vtab, const char *keep )
+
+*  Class Membership:
+*     Object method.
+
+*  Description:
+*     This function should be invoked when initialising the virtual
+*     function table of a class that over-rides astGetAttrib, etc., to
+*     forward the attributes of its parent classes to another Object
+*     (as a FrameSet does with its current Frame, for instance). It
+*     removes all the typed attribute access functions declared so far
+*     (see astDeclareAttribI), except those for a specified list of
+*     attributes which the class continues to handle in the same way as
+*     its parent. The string interface is then used for all other
+*     attributes.
+
+*  Parameters:
+*     vtab
+*        Pointer to the virtual function table of the class.
+*     keep
+*        Pointer to a null-terminated string holding a comma-separated
+*        list of the lower case names of the attributes to retain, with
+*        no white space. May be NULL, in which case all functions are
+*        removed.
+*-
+*/
+
+/* Local Variables: */
+   AstAttribFns **prev;          /* Address of pointer to next entry */
+   AstAttribFns *fns;            /* Pointer to next entry */
+   const char *p;                /* Pointer to name within "keep" */
+   int ibucket;                  /* Index of hash bucket */
+   int found;                    /* Is the attribute in the "keep" list? */
+   size_t nc;                    /* Length of attribute name */
+
+/* Check the global status. */
+   if ( !astOK ) return;
+
+/* Loop round every entry in every bucket. */
+   for( ibucket = 0; ibucket < AST__NATTRIBFNS; ibucket++ ) {
+      prev = vtab->attrib_fns + ibucket;
+      while( ( fns = *prev ) ) {
+
+/* See if the attribute name is a complete element of the "keep" list. */
+         found = 0;
+         if( keep ) {
+            nc = strlen( fns->name );
+            for( p = strstr( keep, fns->name ); p && !found;
+                 p = strstr( p + 1, fns->name ) ) {
+               found = ( p == keep || p[ -1 ] == ',' ) &&
+                       ( p[ nc ] == ',' || !p[ nc ] );
+            }
+         }
+
+/* Retain the entry, or remove it from the bucket and free it. */
+         if( found ) {
+            prev = &fns->next;
+         } else {
+            *prev = fns->next;
+            fns = astFree( fns );
+         }
+      }
+   }
+}
+
 static const char *Get( AstObject *this, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -1991,6 +2530,7 @@ static const char *Get( AstObject *this, const char *attrib, int *status ) {
 */
 
 /* Local Variables: */
+   AstAttribFns *fns;            /* Pointer to typed access functions */
    char *buff;                   /* Pointer to local string buffer */
    const char *result;           /* Pointer value to return */
    int i;                        /* Loop counter for characters */
@@ -2002,6 +2542,16 @@ static const char *Get( AstObject *this, const char *attrib, int *status ) {
 /* Check the global error status. */
    if ( !astOK ) return result;
 
+/* If the class has declared a function that returns the attribute value
+   as a string, use it in preference to astGetAttrib. */
+   fns = FindAttribFns( this, attrib, status );
+   if( fns && fns->GetC ) {
+      result = (*fns->GetC)( this, status );
+      if( !astEscapes( -1 ) ) result = astStripEscapes( result );
+      if ( !astOK ) result = NULL;
+      return result;
+   }
+
 /* Allocate a local buffer long enough to hold the attribute name
    string. */
    buff = astMalloc( strlen( attrib ) + (size_t) 1 );
@@ -2279,7 +2829,22 @@ int astGetNobject_( const AstObject *this, int *status ) {
    if ( !astOK ) return 0;
 
 /* Return the active object count. */
-   return this->vtab->nobject;
+   return NOBJECT_LOAD( this->vtab );
+}
+
+static int GetNobjectAttrib( AstObject *this, int *status ) {
+/*
+*  Name:
+*     GetNobjectAttrib
+
+*  Purpose:
+*     Typed access function for the Nobject attribute.
+
+*  Description:
+*     This function invokes astGetNobject. It is declared as the typed
+*     access function for the Nobject attribute (see astDeclareAttribI).
+*/
+   return astGetNobject_( this, status );
 }
 
 static int GetObjSize( AstObject *this, int *status ) {
@@ -2325,48 +2890,122 @@ static int GetObjSize( AstObject *this, int *status ) {
    return this->size;
 }
 
-void *astGetProxy_( AstObject *this, int *status ) {
+static int GetTyped( AstObject *this, const char *attrib, int integer,
+                     double *value, int *status ) {
 /*
-*+
 *  Name:
-*     astGetProxy
+*     GetTyped
 
 *  Purpose:
-*     Get a pointer to the foreign language proxy used to represent a
-*     given AST Object.
+*     Get an attribute value using a typed access function, if possible.
 
 *  Type:
-*     Undocumented public function.
+*     Private function.
 
 *  Synopsis:
 *     #include "object.h"
-*     void *astGetProxy( AstObject *this )
+*     int GetTyped( AstObject *this, const char *attrib, int integer,
+*                   double *value, int *status )
 
 *  Class Membership:
-*     Object method.
+*     Object member function.
 
 *  Description:
-*     This function returns any pointer stored previously in the AST
-*     Object using astSetProxy. If no such pointer has been stored, a
-*     NULL pointer is returned.
+*     This function gets the value of an attribute using a typed access
+*     function declared by the Object's class (see astDeclareAttribI),
+*     if a suitable function has been declared.
 
 *  Parameters:
 *     this
 *        Pointer to the Object.
+*     attrib
+*        Pointer to a null-terminated string containing the attribute
+*        name. This may contain mixed case and white space.
+*     integer
+*        Non-zero if an integer value is required. Only a function that
+*        returns an integer value is used in this case. Otherwise, a
+*        function returning either an integer or a floating point value
+*        is used.
+*     value
+*        Pointer to a location at which to return the attribute value.
+*     status
+*        Pointer to the inherited status variable.
 
 *  Returned Value:
-*     Pointer to the proxy object, or NULL.
+*     Non-zero if a typed access function was used, and zero otherwise
+*     (in which case the string interface should be used instead).
 
 *  Notes:
-*     - This function is public, but is currently undocumented since it
-*     is only of interest to people writing AST interfaces for other
-*     languages.
-*     - This function attempts to execute even if the AST error status
-*     is set on entry, although no further error report will be made
-*     if it subsequently fails under these circumstances.
-*-
+*     - Zero will be returned if this function is invoked with the
+*     global error status set.
 */
-   return this ? this->proxy : NULL;
+
+/* Local Variables: */
+   AstAttribFns *fns;            /* Pointer to typed access functions */
+   int result;                   /* Returned flag */
+
+/* Initialise. */
+   result = 0;
+
+/* Look for typed access functions for the attribute, and use the
+   appropriate one, if any. */
+   fns = FindAttribFns( this, attrib, status );
+   if( fns ) {
+      if( fns->GetI ) {
+         *value = (double) (*fns->GetI)( this, status );
+         result = 1;
+      } else if( fns->GetD && !integer ) {
+         *value = (*fns->GetD)( this, status );
+         result = 1;
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
+void *astGetProxy_( AstObject *this, int *status ) {
+/*
+*+
+*  Name:
+*     astGetProxy
+
+*  Purpose:
+*     Get a pointer to the foreign language proxy used to represent a
+*     given AST Object.
+
+*  Type:
+*     Undocumented public function.
+
+*  Synopsis:
+*     #include "object.h"
+*     void *astGetProxy( AstObject *this )
+
+*  Class Membership:
+*     Object method.
+
+*  Description:
+*     This function returns any pointer stored previously in the AST
+*     Object using astSetProxy. If no such pointer has been stored, a
+*     NULL pointer is returned.
+
+*  Parameters:
+*     this
+*        Pointer to the Object.
+
+*  Returned Value:
+*     Pointer to the proxy object, or NULL.
+
+*  Notes:
+*     - This function is public, but is currently undocumented since it
+*     is only of interest to people writing AST interfaces for other
+*     languages.
+*     - This function attempts to execute even if the AST error status
+*     is set on entry, although no further error report will be made
+*     if it subsequently fails under these circumstances.
+*-
+*/
+   return this ? this->proxy : NULL;
 }
 
 int astGetRefCount_( AstObject *this, int *status ) {
@@ -2530,12 +3169,15 @@ c     the string should be made if it is needed for longer than this.
          A quoted string containing a astSscanf format specifier that
          will read the attribute value into a variable of the required
          data type. This format should transfer 1 astSscanf value.
+      integer
+         Non-zero if the data type is an integer type.
 */
-#define MAKE_GETX(code,type,format) \
+#define MAKE_GETX(code,type,format,integer) \
 type astGet##code##_( AstObject *this, const char *attrib, int *status ) { \
 \
 /* Local Variables: */ \
    const char *str;              /* Pointer to string attribute value */ \
+   double dval;                  /* Value from typed access function */ \
    int nc;                       /* Number of characters read from string */ \
    int nval;                     /* Number of values read from string */ \
    type result;                  /* Value to return */ \
@@ -2547,7 +3189,14 @@ type astGet##code##_( AstObject *this, const char *attrib, int *status ) { \
 /* Check the global error status. */ \
    if ( !astOK ) return result; \
 \
-/* Obtain the attribute value as a string. */ \
+/* If the class has declared a suitable typed access function for the \
+   attribute, use it to get the value directly. */ \
+   if ( GetTyped( this, attrib, integer, &dval, status ) ) { \
+      if ( astOK ) result = (type) dval; \
+      return result; \
+   } \
+\
+/* Otherwise, obtain the attribute value as a string. */ \
    str = Get( this, attrib, status ); \
    if ( astOK ) { \
 \
@@ -2575,10 +3224,10 @@ type astGet##code##_( AstObject *this, const char *attrib, int *status ) { \
 
 /* Use this macro to create all the GetX_ private member functions,
    except SetC (which is handled separately). */
-MAKE_GETX(D,double,"%lf")
-MAKE_GETX(F,float,"%f")
-MAKE_GETX(I,int,"%d")
-MAKE_GETX(L,long,"%ld")
+MAKE_GETX(D,double,"%lf",0)
+MAKE_GETX(F,float,"%f",0)
+MAKE_GETX(I,int,"%d",1)
+MAKE_GETX(L,long,"%ld",1)
 
 /* Handle GetC separately because memory must be allocated to hold the
    returned character values. */
@@ -2868,9 +3517,12 @@ static int ManageLock( AstObject *this, int mode, int extra,
    } else if( mode == AST__LOCK ) {
 
 /* If the Object is not currently locked, lock the Object primary mutex
-   and record the identity of the calling thread in the Object. */
-      if( this->locker == -1 ) {
-         if( LOCK_PMUTEX(this) ) result = 2;
+   and record the identity of the calling thread in the Object. A thread
+   that was waiting for the Object may already have obtained the primary
+   mutex but not yet the secondary mutex (which we hold). So do not block
+   waiting for the primary mutex here, since that would deadlock. Instead,
+   treat the Object as locked by the other thread. */
+      if( this->locker == -1 && !TRYLOCK_PMUTEX(this) ) {
          this->locker = AST__THREAD_ID;
          this->globals = AST__GLOBALS;
          ChangeThreadVtab( this, status );
@@ -3709,6 +4361,82 @@ f     with STATUS set to an error value, or if it should fail for any reason.
    return ( this == that ) ? 1 : 0;
 }
 
+static int SetTyped( AstObject *this, const char *attrib, int integer,
+                     double value, int *status ) {
+/*
+*  Name:
+*     SetTyped
+
+*  Purpose:
+*     Set an attribute value using a typed access function, if possible.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     int SetTyped( AstObject *this, const char *attrib, int integer,
+*                   double value, int *status )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     This function sets the value of an attribute using a typed access
+*     function declared by the Object's class (see astDeclareAttribI),
+*     if a suitable function has been declared.
+
+*  Parameters:
+*     this
+*        Pointer to the Object.
+*     attrib
+*        Pointer to a null-terminated string containing the attribute
+*        name. This may contain mixed case and white space.
+*     integer
+*        Non-zero if the supplied value is an integer. Either an integer
+*        or a floating point function is used in this case. Otherwise,
+*        only a floating point function is used.
+*     value
+*        The new attribute value.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if a typed access function was used, and zero otherwise
+*     (in which case the string interface should be used instead).
+
+*  Notes:
+*     - Zero will be returned if this function is invoked with the
+*     global error status set.
+*/
+
+/* Local Variables: */
+   AstAttribFns *fns;            /* Pointer to typed access functions */
+   int result;                   /* Returned flag */
+
+/* Initialise. */
+   result = 0;
+
+/* Look for typed access functions for the attribute. */
+   fns = FindAttribFns( this, attrib, status );
+   if( fns ) {
+
+/* Integer values too large for an int are left for the string interface
+   to reject. */
+      if( integer && value >= INT_MIN && value <= INT_MAX && fns->SetI ) {
+         (*fns->SetI)( this, (int) value, status );
+         result = 1;
+
+      } else if( fns->SetD ) {
+         (*fns->SetD)( this, value, status );
+         result = 1;
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
 /*
 *++
 *  Name:
@@ -3807,8 +4535,13 @@ f     value of zero and logical .TRUE. will translate to one.
          The number of characters in the format specifier (above).
       fieldsz
          The value of the field width to be used by the format specifier.
+      typed
+         Indicates if a typed access function may be used: 1 for an
+         integer type, 0 for a floating point type, or -1 if the value
+         should always be formatted (so that the same rounding is applied
+         whatever the attribute).
 */
-#define MAKE_SETX(code,type,format,fmtlen,fieldsz) \
+#define MAKE_SETX(code,type,format,fmtlen,fieldsz,typed) \
 void astSet##code##_( AstObject *this, const char *attrib, type value, int *status ) { \
 \
 /* Local Variables: */ \
@@ -3818,6 +4551,11 @@ void astSet##code##_( AstObject *this, const char *attrib, type value, int *stat
 /* Check the global status. */ \
    if ( !astOK ) return; \
 \
+/* If the class has declared a suitable typed access function for the \
+   attribute, use it to set the value directly. */ \
+   if ( typed >= 0 && SetTyped( this, attrib, typed, (double) value, \
+                                status ) ) return; \
+\
 /* Obtain the length of the attribute name and allocate memory to hold \
    this name plus the format specifier to be appended to it. */ \
    len = (int) astChrLen( attrib ); \
@@ -3841,10 +4579,10 @@ void astSet##code##_( AstObject *this, const char *attrib, type value, int *stat
 }
 
 /* Use this macro to create all the SetX_ private member functions. */
-MAKE_SETX(D,double,"%.*g",4,DBL_DIG)
-MAKE_SETX(F,float,"%.*g",4,FLT_DIG)
-MAKE_SETX(I,int,"%.*d",4,1)
-MAKE_SETX(L,long,"%.*ld",5,1)
+MAKE_SETX(D,double,"%.*g",4,DBL_DIG,0)
+MAKE_SETX(F,float,"%.*g",4,FLT_DIG,-1)
+MAKE_SETX(I,int,"%.*d",4,1,1)
+MAKE_SETX(L,long,"%.*ld",5,1,1)
 
 
 /* The astSetC_ function is implemented separately so that commas can be
@@ -4032,6 +4770,7 @@ f     - A value of .FALSE. will also be returned if this function is used
 */
 
 /* Local Variables: */
+   AstAttribFns *fns;            /* Pointer to typed access functions */
    char *buff;                   /* Pointer to character buffer */
    int i;                        /* Loop counter for characters */
    int j;                        /* Non-blank character count */
@@ -4044,6 +4783,15 @@ f     - A value of .FALSE. will also be returned if this function is used
 /* Check the global error status. */
    if ( !astOK ) return result;
 
+/* If the class has declared a typed function for testing the attribute,
+   use it in preference to astTestAttrib. */
+   fns = FindAttribFns( this, attrib, status );
+   if( fns && fns->Test ) {
+      result = (*fns->Test)( this, status );
+      if ( !astOK ) result = 0;
+      return result;
+   }
+
 /* Obtain the length of the attrib string. */
    len = (int) strlen( attrib );
 
@@ -4222,9 +4970,57 @@ f        AST_DELETE).
 *        cache other memory blocks allocated by AST, use MemoryCaching.
 *     MemoryCaching
 *        A boolean flag similar to ObjectCaching except
-*        that it controls caching of all memory blocks of less than 300 bytes
+*        that it controls caching of all memory blocks of up to 4096 bytes
 *        allocated by AST (whether for internal or external use), not just
-*        memory used to store AST Objects.
+*        memory used to store AST Objects. Cached blocks are grouped into
+*        size classes, so that a freed block can be re-used for any request
+*        of a similar size. Each thread has its own cache, holding at most
+*        256 KiB of unused memory. The default value for this parameter is
+*        one (caching is switched on).
+*     NumThreads
+*        The largest number of threads (including the calling thread)
+*        that may be used to perform computationally intensive operations
+*        such as
+c        astResample<X> and astRebin<X>.
+f        AST_RESAMPLE<X> and AST_REBIN<X>.
+*        The default value is taken from the AST_THREADS environment
+*        variable, or is one if that variable is not defined (in which
+*        case no extra threads are used). Results are the same whatever
+*        value is used, except that the order in which values are summed
+*        when rebinning floating point data may differ, causing small
+*        rounding differences. This parameter is ignored unless AST was
+*        built with thread-safety enabled.
+*     MathMapBlock
+*        The number of points that are passed through all the
+*        functions of a MathMap together when the MathMap is used to
+*        transform a set of points. Processing points in blocks small
+*        enough to remain in the processor cache usually makes
+*        complex MathMaps much faster. The default value is 256. A value
+*        of zero causes each function to be evaluated for all points
+*        before moving on to the next function, as was done by earlier
+*        versions of AST. The transformed values are the same whatever
+*        value is used.
+*     CmpMapBlock
+*        The number of points that are passed through all the component
+*        Mappings of a series CmpMap together when the CmpMap is used to
+*        transform a set of points. Each such CmpMap is "compiled" into
+*        a pipeline when first used, in which adjacent linear
+*        components (MatrixMaps, WinMaps, ShiftMaps and UnitMaps) are
+*        merged into a single matrix and offset vector. The default value
+*        is 512. A value of zero causes each component Mapping to be
+*        applied separately, as was done by earlier versions of AST.
+*        Merging linear components may cause the transformed values to
+*        change by amounts comparable to the rounding error.
+*     KernelTable
+*        The number of decimal places of accuracy required when the
+*        1-dimensional kernels used by the astResample<X> and astRebin<X>
+*        functions (AST__SINC, AST__SINCSINC, AST__GAUSS, etc) are
+*        evaluated by linear interpolation within a finely sampled table
+*        of pre-computed kernel values, rather than directly. Each
+*        interpolated kernel value differs from the true kernel value by
+*        no more than 10 to the power of minus KernelTable. The default
+*        value is 7. A value of zero causes the kernel functions to be
+*        evaluated directly, as was done by earlier versions of AST.
 
 *  Notes:
 c     - This function attempts to execute even if the AST error
@@ -4254,6 +5050,18 @@ f     error value
       } else if( astChrMatch( name, "MemoryCaching" ) ) {
          result = astMemCaching( value );
 
+      } else if( astChrMatch( name, "NumThreads" ) ) {
+         result = astNumThreads( value );
+
+      } else if( astChrMatch( name, "MathMapBlock" ) ) {
+         result = astMathMapBlock( value );
+
+      } else if( astChrMatch( name, "CmpMapBlock" ) ) {
+         result = astCmpMapBlock( value );
+
+      } else if( astChrMatch( name, "KernelTable" ) ) {
+         result = astKernelTable( value );
+
       } else if( astOK ) {
          astError( AST__TUNAM, "astTune: Unknown AST tuning parameter "
                    "specified \"%s\".", status, name );
@@ -4349,6 +5157,16 @@ f        The global status.
 *        A string to be drawn to introduce the exponent in a value when "g"
 *        format is in use. The default value is "10%-%^50+%s70+" which
 *        produces "10" followed by the exponent as a super-script.
+*     LeapSeconds
+*        The path to a text file containing a list of leap seconds, to be
+*        used in place of the list built into AST when converting between
+*        UTC and TAI. This allows leap seconds announced after AST was
+*        built to be used. The file may be in the format of either the
+*        "leap-seconds.list" file distributed by the IETF and NIST, or
+*        the "Leap_Second.dat" file distributed by the IERS. The file is
+*        read as soon as this parameter is set, and the new value is
+*        rejected if the file cannot be read. The default value is
+*        blank, which causes the built-in list to be used.
 
 *  Notes:
 c     - This function attempts to execute even if the AST error
@@ -4389,6 +5207,8 @@ f     error value
          p = asdel;
       } else if( astChrMatch( name, "exdel" ) ) {
          p = exdel;
+      } else if( astChrMatch( name, "leapseconds" ) ) {
+         p = leapseconds;
 
 /* Report an error if an the tuning parameter name is unknown. */
       } else if( astOK ) {
@@ -4425,9 +5245,13 @@ f     error value
                          "(%s) is too long - must not be longer than %d "
                          "characters.", status, name, value, MAXLEN_TUNEC );
 
-/* Otherwise, copy the new value into the static buffer. */
-            } else {
+/* Otherwise, copy the new value into the static buffer. A new leap
+   second file is only stored if it is read successfully. */
+            } else if( p != leapseconds ) {
                strcpy( p, value );
+            } else {
+               (void) astLeapSeconds( value );
+               if( astOK ) strcpy( p, value );
             }
          }
       }
@@ -5408,6 +6232,7 @@ void astInitObjectVtab_(  AstObjectVtab *vtab, const char *name, int *status ) {
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Thread-specific global data */
+   int i;                        /* Loop count */
    int ivtab;                    /* Index of next entry in known_vtabs */
 
 /* Check the local error status. */
@@ -5486,6 +6311,16 @@ void astInitObjectVtab_(  AstObjectVtab *vtab, const char *name, int *status ) {
    vtab->nfree = 0;
    vtab->free_list = NULL;
 
+/* Initialise the table of typed attribute access functions, and declare
+   those for the attributes of this class. Derived classes inherit these
+   since their vtab initialisers invoke this function first. */
+   for( i = 0; i < AST__NATTRIBFNS; i++ ) vtab->attrib_fns[ i ] = NULL;
+   astDeclareAttribI( vtab, "nobject", GetNobjectAttrib, NULL, NULL, NULL );
+   astDeclareAttribI( vtab, "objsize", astGetObjSize_, NULL, NULL, NULL );
+   astDeclareAttribI( vtab, "refcount", astGetRefCount_, NULL, NULL, NULL );
+   astDeclareAttribI( vtab, "usedefs", astGetUseDefs_, astSetUseDefs_,
+                      astTestUseDefs_, astClearUseDefs_ );
+
 /* Add the supplied virtual function table pointer to the end of the list
    of known vtabs. */
    ivtab = nvtab++;
@@ -5655,7 +6490,7 @@ AstObject *astInitObject_( void *mem, size_t size, int init,
 /* Increment the count of active Objects in the virtual function table.
    Use the count as a unique identifier (unique within the class) for
    the Object. */
-         new->iref = vtab->nobject++;
+         new->iref = NOBJECT_ADD( vtab, 1 );
 
 /* Initialise the pointer to an external object that acts as a proxy for
    the AST Object within foreign language interfaces. */
@@ -5935,6 +6770,7 @@ typedef struct Handle {
 #if defined(THREAD_SAFE)
    int thread;                   /* Identifier for owning thread */
 #endif
+   struct AstHandleHeap *heap;   /* HandleHeap that guards this Handle */
 
 #if defined(MEM_DEBUG)
    int id;                       /* The id associated with the memory block
@@ -5968,20 +6804,86 @@ typedef union MixedInts {
    unsigned u;
 } MixedInts;
 
+/* Define the HandleHeap structure. Every Handle belongs to exactly one
+   HandleHeap (identified by the Handle's "heap" component), and may only
+   be read or modified by a thread that has locked the mutex in that
+   HandleHeap. Each thread has its own HandleHeap, which owns the free
+   Handles reserved for use by the thread and all the Handles in the
+   thread's "active_handles" lists. Since no other thread normally needs
+   these Handles, the mutex is almost never contended. A single global
+   HandleHeap owns the Handles that are not owned by any thread (i.e.
+   unowned Handles and the pool of spare free Handles). Moving a Handle
+   between a thread's HandleHeap and the global HandleHeap requires both
+   mutexes, and these must always be locked in the order "global heap
+   first". */
+typedef struct AstHandleHeap {
+#if defined(THREAD_SAFE)
+   pthread_mutex_t mutex;        /* Mutex guarding the owned Handles */
+#endif
+   int free;                     /* Offset to head of free Handle list */
+   int nfree;                    /* Number of Handles in free list */
+   int **active;                 /* Address of owning thread's
+                                    "active_handles" pointer */
+   unsigned nids;                /* Number of IDs issued by owning thread */
+} HandleHeap;
+
+/* Handles are allocated in chunks of HANDLE_CHUNK structures. Once
+   allocated, a chunk is never moved or freed, so a pointer to a Handle
+   remains valid even while another thread allocates more Handles. The
+   maximum number of chunks is set by the largest Handle offset that can
+   be encoded into an identifier value by AssocId. */
+#define HANDLE_CHUNK_SHIFT 10
+#define HANDLE_CHUNK ( 1 << HANDLE_CHUNK_SHIFT )
+#define HANDLE_MXCHUNK ( ( INT_MAX >> 8 ) / HANDLE_CHUNK + 1 )
+
+/* Access the Handle with a given offset. */
+#define HANDLE(ihandle) \
+   HANDLE_CHUNK_PTR( (ihandle) >> HANDLE_CHUNK_SHIFT )[ (ihandle) & ( HANDLE_CHUNK - 1 ) ]
+
+/* Handle offsets are checked against "nhandles", and Handles accessed,
+   by threads that do not hold the global HandleHeap locked, while
+   RefillHeap may be adding a new chunk. So in a multi-threaded
+   environment, a new chunk pointer and the new value of "nhandles" are
+   published with release stores, and read with acquire loads, so that a
+   thread that sees an offset as valid also sees the initialised chunk
+   holding it. */
+#if defined(THREAD_SAFE)
+#define HANDLE_CHUNK_PTR(ichunk) \
+   __atomic_load_n( &handle_chunks[ ichunk ], __ATOMIC_ACQUIRE )
+#define SET_HANDLE_CHUNK_PTR(ichunk,chunk) \
+   __atomic_store_n( &handle_chunks[ ichunk ], chunk, __ATOMIC_RELEASE )
+#define NHANDLES __atomic_load_n( &nhandles, __ATOMIC_ACQUIRE )
+#define SET_NHANDLES(n) __atomic_store_n( &nhandles, n, __ATOMIC_RELEASE )
+#else
+#define HANDLE_CHUNK_PTR(ichunk) handle_chunks[ ichunk ]
+#define SET_HANDLE_CHUNK_PTR(ichunk,chunk) ( handle_chunks[ ichunk ] = (chunk) )
+#define NHANDLES nhandles
+#define SET_NHANDLES(n) ( nhandles = (n) )
+#endif
+
+/* The number of free Handles moved between a thread's HandleHeap and the
+   global HandleHeap at once. A thread returns free Handles to the global
+   HandleHeap when it holds more than twice this number. */
+#define HANDLE_BATCH 64
+
 /* Static Variables. */
 /* ----------------- */
-/* The array of Handle structures is a pool of resources available to all
-   threads. Each thread has its own conext level and its own "active_handles"
-   array to identify the first Handle at each context level. */
-static Handle *handles = NULL; /* Pointer to allocated array of Handles */
-static int free_handles = -1; /* Offset to head of free Handle list */
-static int nhandles = 0; /* Number of Handles in "handles" array */
-static unsigned nids = 0; /* Number of IDs issued to external users */
+/* The chunks of Handle structures are a pool of resources available to
+   all threads. Each thread has its own context level and its own
+   "active_handles" array to identify the first Handle at each context
+   level. */
+static Handle *handle_chunks[ HANDLE_MXCHUNK ]; /* Allocated Handle chunks */
+static int nhandles = 0; /* Number of Handles in all chunks */
 
+/* The global HandleHeap. In a single threaded environment this is also
+   the HandleHeap used by the one and only thread. */
 #if defined(THREAD_SAFE)
+static HandleHeap global_heap = { PTHREAD_MUTEX_INITIALIZER, -1, 0, NULL, 0U };
 static int unowned_handles = -1; /* Offset to head of unowned Handle
                                     list. In a single threaded environment,
                                     all handles must be owned by a thread. */
+#else
+static HandleHeap global_heap = { -1, 0, &active_handles, 0U };
 #endif
 
 #ifdef MEM_DEBUG
@@ -6000,12 +6902,16 @@ static int Watched_Handle = -1; /* A handle index to be watched. Activity
 #define MYSTATIC
 
 /* Private functions associated with the external interface. */
-MYSTATIC AstObject *AssocId( int, int * );
-MYSTATIC int CheckId( AstObject *, int, int * );
-MYSTATIC void AnnulHandle( int, int * );
+MYSTATIC AstObject *AssocId( int, HandleHeap *, int * );
+MYSTATIC HandleHeap *GetHeap( int * );
+MYSTATIC HandleHeap *LockHandle( int );
+MYSTATIC int CheckId( AstObject *, int, HandleHeap **, int * );
+MYSTATIC void AnnulHandle( int, HandleHeap *, int * );
 MYSTATIC void InitContext( int * );
 MYSTATIC void InsertHandle( int, int *, int * );
+MYSTATIC void RefillHeap( HandleHeap *, int * );
 MYSTATIC void RemoveHandle( int, int *, int * );
+MYSTATIC void TrimHeap( HandleHeap *, int * );
 
 #if defined(MEM_DEBUG)
 MYSTATIC void CheckList( int *, int * );
@@ -6031,7 +6937,7 @@ void astUnlockId_( AstObject *, int, int * );
 
 /* External Interface Functions. */
 /* ----------------------------- */
-MYSTATIC void AnnulHandle( int ihandle, int *status ) {
+MYSTATIC void AnnulHandle( int ihandle, HandleHeap *heap, int *status ) {
 /*
 *  Name:
 *     AnnulHandle
@@ -6044,7 +6950,7 @@ MYSTATIC void AnnulHandle( int ihandle, int *status ) {
 
 *  Synopsis:
 *     #include "object.h"
-*     void AnnulHandle( int ihandle, int *status )
+*     void AnnulHandle( int ihandle, HandleHeap *heap, int *status )
 
 *  Class Membership:
 *     Object member function.
@@ -6060,8 +6966,12 @@ MYSTATIC void AnnulHandle( int ihandle, int *status ) {
 
 *  Parameters:
 *     ihandle
-*        Array offset that identifies the Handle to be annulled in the
-*        "handles" array. This is fully validated by this function.
+*        Offset that identifies the Handle to be annulled. This is
+*        fully validated by this function.
+*     heap
+*        Pointer to the HandleHeap that owns the Handle. This should be
+*        locked by the caller, and is still locked on exit. It is
+*        unlocked temporarily while the Object pointer is annulled.
 *     status
 *        Pointer to the inherited status variable.
 
@@ -6072,17 +6982,13 @@ MYSTATIC void AnnulHandle( int ihandle, int *status ) {
 */
 
 /* Local Variables: */
-   astDECLARE_GLOBALS            /* Thread-specific global data */
    AstObject *ptr;               /* Object pointer */
    int context;                  /* Context level where Handle was issued */
 
-/* Get a pointer to Thread-specific global data. */
-   astGET_GLOBALS(NULL);
-
 /* Check that the handle offset supplied is valid and report an error
    if it is not (but only if the global error status has not already
    been set). */
-   if ( ( ihandle < 0 ) || ( ihandle >= nhandles ) ) {
+   if ( ( ihandle < 0 ) || ( ihandle >= NHANDLES ) ) {
       if ( astOK ) {
          astError( AST__INHAN, "astAnnulHandle: Invalid attempt to annul an "
                    "Object Handle (no. %u).", status, ihandle );
@@ -6092,7 +6998,7 @@ MYSTATIC void AnnulHandle( int ihandle, int *status ) {
 
 /* If OK, obtain the Handle's context level. */
    } else {
-      context = handles[ ihandle ].context;
+      context = HANDLE( ihandle ).context;
 
 /* If this indicates that the Handle isn't active, then report an
    error (but only if the global error status has not already been
@@ -6109,20 +7015,20 @@ MYSTATIC void AnnulHandle( int ihandle, int *status ) {
 /* If the Handle is active, annul its Object pointer. The astAnnul
    function may call Delete functions supplied by any class, and these
    Delete functions may involve annulling external Object IDs, which in
-   turn requires access to the handles array. For this reason, we release
-   the mutex that protects access to the handles arrays so that it can
+   turn requires access to the Handles. For this reason, we release
+   the mutex that protects access to the Handle so that it can
    potentially be re-aquired within astAnnul without causing deadlock. */
       } else {
 
 #ifdef MEM_DEBUG
          astHandleUse( ihandle, "annulled using check value %d ",
-                       handles[ ihandle ].check  );
+                       HANDLE( ihandle ).check  );
 #endif
 
-         ptr = handles[ ihandle ].ptr;
-         UNLOCK_MUTEX2;
+         ptr = HANDLE( ihandle ).ptr;
+         UNLOCK_HEAP( heap );
          ptr = astAnnul( ptr );
-         LOCK_MUTEX2;
+         LOCK_HEAP( heap );
 
 /* Remove the Handle from the active list for its context level. */
          if( context == UNOWNED_CONTEXT ) {
@@ -6135,8 +7041,8 @@ MYSTATIC void AnnulHandle( int ihandle, int *status ) {
                          "(internal AST programming error).", status );
 #endif
 
-         } else if( active_handles ) {
-            RemoveHandle( ihandle, &active_handles[ context ], status );
+         } else if( heap->active && *(heap->active) ) {
+            RemoveHandle( ihandle, &( *(heap->active) )[ context ], status );
 
          } else if( astOK ){
             astError( AST__INTER, "AnnulHandle: active_handles array has "
@@ -6146,15 +7052,17 @@ MYSTATIC void AnnulHandle( int ihandle, int *status ) {
 
 /* Reset the Handle's "context" value (making it inactive) and its "check"
    value (so it is no longer associated with an identifier value). */
-         handles[ ihandle ].ptr = NULL;
-         handles[ ihandle ].context = INVALID_CONTEXT;
-         handles[ ihandle ].check = 0;
+         HANDLE( ihandle ).ptr = NULL;
+         HANDLE( ihandle ).context = INVALID_CONTEXT;
+         HANDLE( ihandle ).check = 0;
 #if defined(THREAD_SAFE)
-         handles[ ihandle ].thread = -1;
+         HANDLE( ihandle ).thread = -1;
 #endif
 
-/* Place the modified Handle on the free Handles list ready for re-use. */
-         InsertHandle( ihandle, &free_handles, status );
+/* Place the modified Handle on the free Handles list of its HandleHeap,
+   ready for re-use. */
+         InsertHandle( ihandle, &heap->free, status );
+         heap->nfree++;
 
       }
    }
@@ -6208,6 +7116,10 @@ AstObject *astAnnulId_( AstObject *this_id, int *status ) {
 *-
 */
 
+/* Local Variables: */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
+   int ihandle;                  /* Object Handle offset */
+
 /* Obtain the Object pointer from the ID supplied and validate the
    pointer to ensure it identifies a valid Object (this generates an
    error if it doesn't). Note, we use "astMakePointer_NoLockCheck",
@@ -6224,16 +7136,21 @@ AstObject *astAnnulId_( AstObject *this_id, int *status ) {
    currently owned by a different thread. That is, the *Object* need
    not be locked by the current thread (as indicated by the use of
    astMakePointer above), but the *handle* must be owned by the current
-   thread. */
-   LOCK_MUTEX2;
-   AnnulHandle( CheckId( this_id, 1, status ), status );
-   UNLOCK_MUTEX2;
+   thread. CheckId leaves the HandleHeap that owns the Handle locked. */
+   ihandle = CheckId( this_id, 1, &heap, status );
+   if( ihandle != -1 ) {
+      AnnulHandle( ihandle, heap, status );
+      UNLOCK_HEAP( heap );
+
+/* Return any surplus free Handles to the global HandleHeap. */
+      TrimHeap( heap, status );
+   }
 
 /* Always return a NULL pointer value. */
    return NULL;
 }
 
-MYSTATIC AstObject *AssocId( int ihandle, int *status ) {
+MYSTATIC AstObject *AssocId( int ihandle, HandleHeap *heap, int *status ) {
 /*
 *  Name:
 *     AssocId
@@ -6246,24 +7163,27 @@ MYSTATIC AstObject *AssocId( int ihandle, int *status ) {
 
 *  Synopsis:
 *     #include "object.h"
-*     AstObject *AssocId( int ihandle )
+*     AstObject *AssocId( int ihandle, HandleHeap *heap )
 
 *  Class Membership:
 *     Object member function.
 
 *  Description:
-*     This function takes a zero-based offset into the "handles" array
-*     that identifies a Handle associated with an active Object. It
+*     This function takes a zero-based Handle offset that identifies a
+*     Handle associated with an active Object. It
 *     encodes this into an identifier value to be issued to an
 *     external user to identify that Handle and its Object, and then
 *     associates this identifier value with the Handle.
 
 *  Parameters:
 *     ihandle
-*        Offset in the "handles" array that identifies the Handle,
-*        which should be active (i.e. associated with an active
-*        Object). This function will modify the "check" field in this
-*        Handle to associate it with the identifier value it returns.
+*        Offset that identifies the Handle, which should be active
+*        (i.e. associated with an active Object). This function will
+*        modify the "check" field in this Handle to associate it with
+*        the identifier value it returns.
+*     heap
+*        Pointer to the locked HandleHeap that owns the Handle. Its
+*        count of issued identifiers is incremented.
 
 *  Returned Value:
 *     The resulting identifier value.
@@ -6309,7 +7229,7 @@ MYSTATIC AstObject *AssocId( int ihandle, int *status ) {
    test.u = work.u >> 8U;
    if ( test.i != ihandle ) {
       astError( AST__XSOBJ, "AssocId(%s): There are too many AST Objects in "
-                "use at once.", status, astGetClass( handles[ ihandle ].ptr ) );
+                "use at once.", status, astGetClass( HANDLE( ihandle ).ptr ) );
 
 /* If OK, scramble the value by exclusive-ORing with the bit pattern
    in AST__FAC (a value unique to this library), also shifted left by
@@ -6319,20 +7239,22 @@ MYSTATIC AstObject *AssocId( int ihandle, int *status ) {
       work.u ^= ( ( (unsigned) AST__FAC ) << 8U );
 
 /* Fill the lowest 8 bits with a count of the total number of IDs
-   issued so far (which we increment here). This makes each ID unique,
-   so that an old one that identifies a Handle that has been annulled
-   and re-used (i.e. associated with a new ID) can be spotted.  We
+   issued so far by the owning thread (which we increment here). This
+   makes each ID unique, so that an old one that identifies a Handle
+   that has been annulled and re-used (i.e. associated with a new ID)
+   can be spotted. Each thread keeps its own count so that no lock is
+   needed to update it. We
    only use the lowest 8 bits of this count because this provides
    adequate error detection to reveal programming errors and we do not
    need higher security than this. We also prevent a count of zero
    being used, as this could result in a zero identifier value (this
    being reserved as the "null" value). */
-      if ( ++nids > 255U ) nids = 1U;
-      work.u |= nids;
+      if ( ++heap->nids > 255U ) heap->nids = 1U;
+      work.u |= heap->nids;
 
 /* Store the value as a check count in the Handle. This will be used
    to validate the ID in future. */
-      handles[ ihandle ].check = work.i;
+      HANDLE( ihandle ).check = work.i;
 
 /* Pack the value into the pointer to be returned. */
       result = astI2P( work.i );
@@ -6401,6 +7323,7 @@ f     depth.
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Thread-specific global data */
+   HandleHeap *heap;             /* The thread's HandleHeap */
    int stat;                     /* Copy of global status */
    int *status;                  /* Pointer to inherited status value */
 
@@ -6416,27 +7339,36 @@ f     depth.
    stat = astStatus;
    astClearStatus;
 
-/* Ensure that the active_handles array has been initialised. */
+/* Ensure that the active_handles array has been initialised, and get
+   the thread's HandleHeap. */
    if ( !active_handles ) InitContext( status );
+   heap = GetHeap( status );
 
 /* Extend the "active handles" array to accommodate a new context
-   level. This array contains integer offsets into the "handles" array
-   to identify the handle which is at the head of the list of active
-   handles for each context level. */
-   astBeginPM;
-   active_handles = astGrow( active_handles, context_level + 2,
-                             sizeof( int ) );
-   astEndPM;
+   level. This array contains Handle offsets to identify the handle
+   which is at the head of the list of active handles for each context
+   level. The array may be accessed by other threads via the HandleHeap
+   (e.g. within astDelete), so lock the HandleHeap while the array is
+   re-allocated. */
+   if ( heap ) {
+      LOCK_HEAP( heap );
+      astBeginPM;
+      active_handles = astGrow( active_handles, context_level + 2,
+                                sizeof( int ) );
+      astEndPM;
 
 /* Initialise the array element for the new context level to indicate
    an empty Handle list. */
-   if ( astOK ) active_handles[ ++context_level ] = -1;
+      if ( astOK ) active_handles[ ++context_level ] = -1;
+      UNLOCK_HEAP( heap );
+   }
 
 /* Restore the original global status value. */
    astSetStatus( stat );
 }
 
-MYSTATIC int CheckId( AstObject *this_id, int lock_check, int *status ) {
+MYSTATIC int CheckId( AstObject *this_id, int lock_check, HandleHeap **heap,
+                      int *status ) {
 /*
 *  Name:
 *     CheckId
@@ -6449,7 +7381,8 @@ MYSTATIC int CheckId( AstObject *this_id, int lock_check, int *status ) {
 
 *  Synopsis:
 *     #include "object.h"
-*     int CheckId( AstObject *this, int lock_check, int *status )
+*     int CheckId( AstObject *this, int lock_check, HandleHeap **heap,
+*                  int *status )
 
 *  Class Membership:
 *     Object member function.
@@ -6458,8 +7391,9 @@ MYSTATIC int CheckId( AstObject *this_id, int lock_check, int *status ) {
 *     This function takes an identifier value encoded by AssocId and
 *     validates it to ensure it is associated with an active
 *     Handle. If valid, it converts it back into a zero-based offset
-*     which may be used to access the Handle in the "handles"
-*     array. Otherwise, an error is reported.
+*     which may be used to access the Handle, and returns with the
+*     HandleHeap that owns the Handle locked. Otherwise, an error is
+*     reported.
 
 *  Parameters:
 *     this
@@ -6467,6 +7401,12 @@ MYSTATIC int CheckId( AstObject *this_id, int lock_check, int *status ) {
 *     lock_check
 *        Should an error be reported if the handle is in an Object
 *        context for a different thread?
+*     heap
+*        Address of a location at which to return a pointer to the
+*        HandleHeap that owns the Handle. If a valid Handle offset is
+*        returned, this HandleHeap will have been locked and the caller
+*        should unlock it when it has finished with the Handle. NULL is
+*        returned if the identifier is not valid.
 *     status
 *        Pointer to the inherited status variable.
 
@@ -6478,6 +7418,8 @@ MYSTATIC int CheckId( AstObject *this_id, int lock_check, int *status ) {
 *     - This function attempts to execute even if the global error
 *     status is set, but no further error report will be made if it
 *     fails under these circumstances.
+*     - The caller should not have any HandleHeap locked when this
+*     function is invoked.
 */
 
 /* Local Variables: */
@@ -6492,6 +7434,7 @@ MYSTATIC int CheckId( AstObject *this_id, int lock_check, int *status ) {
 
 /* Initialise. */
    ihandle = -1;
+   *heap = NULL;
 
 /* Get a pointer to thread-specific global data. */
    astGET_GLOBALS(NULL);
@@ -6515,43 +7458,53 @@ MYSTATIC int CheckId( AstObject *this_id, int lock_check, int *status ) {
       work.u = ( work.u ^ ( ( (unsigned) AST__FAC ) << 8U ) ) >> 8U;
 
 /* Check that the offset obtained doesn't extend beyond the limits of
-   the "handles" array. Report an error if it does. */
-      if ( ( work.i < 0 ) || ( work.i >= nhandles ) ) {
+   the allocated Handles. Report an error if it does. */
+      if ( ( work.i < 0 ) || ( work.i >= NHANDLES ) ) {
          if ( astOK ) {
             astError( AST__OBJIN, "Invalid Object pointer given (value is "
                       "%d).", status, id );
          }
 
+/* Otherwise, lock the HandleHeap that owns the Handle so that the
+   Handle cannot be changed by any other thread while we examine it. */
+      } else {
+         *heap = LockHandle( work.i );
+
 /* See if the "check" field matches the ID value and the Handle is
    valid (i.e. is associated with an active Object). If not, the
    Handle has been annulled and possibly re-used, so report an
    error. */
-      } else if ( ( handles[ work.i ].check != id ) ||
-                  ( handles[ work.i ].context == INVALID_CONTEXT ) ) {
-         if ( astOK ) {
-            astError( AST__OBJIN, "Invalid Object pointer given (value is "
-                      "%d).", status, id  );
-            astError( AST__OBJIN, "This pointer has been annulled, or the "
-                      "associated Object deleted." , status);
-         }
+         if ( ( HANDLE( work.i ).check != id ) ||
+              ( HANDLE( work.i ).context == INVALID_CONTEXT ) ) {
+            UNLOCK_HEAP( *heap );
+            *heap = NULL;
+            if ( astOK ) {
+               astError( AST__OBJIN, "Invalid Object pointer given (value is "
+                         "%d).", status, id  );
+               astError( AST__OBJIN, "This pointer has been annulled, or the "
+                         "associated Object deleted." , status);
+            }
 #if defined(THREAD_SAFE)
-      } else if(  lock_check && handles[ work.i ].context != UNOWNED_CONTEXT &&
-                                handles[ work.i ].thread != AST__THREAD_ID ) {
-         if ( astOK ) {
-            astError( AST__OBJIN, "Invalid Object pointer given (value is "
-                      "%d).", status, id  );
-            astError( AST__OBJIN, "This pointer is currently owned by "
-                      "another thread (possible programming error)." , status);
-         }
+         } else if(  lock_check && HANDLE( work.i ).context != UNOWNED_CONTEXT &&
+                                   HANDLE( work.i ).thread != AST__THREAD_ID ) {
+            UNLOCK_HEAP( *heap );
+            *heap = NULL;
+            if ( astOK ) {
+               astError( AST__OBJIN, "Invalid Object pointer given (value is "
+                         "%d).", status, id  );
+               astError( AST__OBJIN, "This pointer is currently owned by "
+                         "another thread (possible programming error)." , status);
+            }
 #endif
 
 /* If OK, set the Handle offset to be returned. */
-      } else {
-         ihandle = work.i;
+         } else {
+            ihandle = work.i;
+         }
       }
 
 #ifdef MEM_DEBUG
-      if ( oldok && !astOK && ( work.i >= 0 ) && ( work.i < nhandles ) ) {
+      if ( oldok && !astOK && ( work.i >= 0 ) && ( work.i < NHANDLES ) ) {
          char buf[200];
          astError( astStatus, "Handle properties: %s ", status,
                    HandleString( work.i, buf ) );
@@ -6615,50 +7568,57 @@ AstObject *astDeleteId_( AstObject *this_id, int *status ) {
 
 /* Local Variables: */
    AstObject *this;              /* Pointer to Object */
+   HandleHeap *heap;             /* HandleHeap that owns a Handle */
    int i;                        /* Loop counter for Handles */
    int ihandle;                  /* Object Handle offset */
+   int nh;                       /* Number of Handles to inspect */
 
 /* Obtain the Object pointer from the ID supplied and validate the
    pointer to ensure it identifies a valid Object (this generates an
    error if it doesn't). */
    if ( !astIsAObject( this = astMakePointer( this_id ) ) ) return NULL;
 
-/* Gain exclusive access to the handles array. */
-   LOCK_MUTEX2;
-
 /* Obtain the Handle offset for this Object. */
-   ihandle = CheckId( this_id, 1, status );
+   ihandle = CheckId( this_id, 1, &heap, status );
    if ( ihandle != -1 ) {
+      UNLOCK_HEAP( heap );
 
 /* Since the Object is to be deleted, we must annul all identifiers
-   that refer to it.  Loop to inspect each currently allocated Handle
-   in the "handles" array. */
-      for ( i = 0; i < nhandles; i++ ) {
+   that refer to it.  Loop to inspect each currently allocated Handle.
+   Since the Object is locked by the current thread, no new identifiers
+   can be issued for it by other threads while we do this. Each Handle
+   is examined with its HandleHeap locked, since it may be owned by
+   another thread. */
+      nh = NHANDLES;
+      for ( i = 0; i < nh; i++ ) {
+         heap = LockHandle( i );
 
 /* Select active handles and test if their Object pointer refers to
    the Object to be deleted. */
-         if ( ( handles[ i ].context != INVALID_CONTEXT ) &&
-              ( handles[ i ].ptr == this ) ) {
+         if ( ( HANDLE( i ).context != INVALID_CONTEXT ) &&
+              ( HANDLE( i ).ptr == this ) ) {
 
 /* If so, explicitly set the reference count for the Object to 2 so
    that it will not be deleted (yet) when we annul the pointer
    associated with the Handle. */
-            handles[ i ].ptr->ref_count = 2;
+            HANDLE( i ).ptr->ref_count = 2;
 
 /* Annul the Handle, which frees its resources, decrements the Object
    reference count and makes any ID associated with the Handle become
    invalid. */
-            AnnulHandle( i, status );
+            AnnulHandle( i, heap, status );
          }
+         UNLOCK_HEAP( heap );
       }
 
 /* If required, tell the user that the handle's object has been deleted. */
 #ifdef MEM_DEBUG
       astHandleUse( ihandle, "object-deleted" );
 #endif
-   }
 
-   UNLOCK_MUTEX2;
+/* Return any surplus free Handles to the global HandleHeap. */
+      TrimHeap( GetHeap( status ), status );
+   }
 
 /* When all Handles associated with the Object have been annulled,
    delete the object itself. This over-rides the reference count and
@@ -6728,6 +7688,7 @@ f     depth.
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Thread-specific global data */
+   HandleHeap *heap;             /* The thread's HandleHeap */
    int ihandle;                  /* Offset of Handle to be annulled */
 
 /* Get a pointer to Thread-specific global data. */
@@ -6743,14 +7704,14 @@ f     depth.
       }
 
 /* If OK, loop while there are still active Handles associated with
-   the current context level. First gain exclusive access to the handles
-   array. */
-   } else if ( active_handles ) {
-      LOCK_MUTEX2;
+   the current context level. First gain exclusive access to the Handles
+   owned by the current thread. */
+   } else if ( active_handles && ( heap = GetHeap( status ) ) ) {
+      LOCK_HEAP( heap );
       while ( ( ihandle = active_handles[ context_level ] ) != -1 ) {
 
 /* Annul the Handle at the head of the active Handles list. */
-         AnnulHandle( ihandle, status );
+         AnnulHandle( ihandle, heap, status );
 
 /* It is just posible that under error conditions inactive Handles
    might get left in the active_handles list and AnnulHandle would
@@ -6759,7 +7720,8 @@ f     depth.
    so, transfer it to the free Handles list for re-use. */
          if ( ihandle == active_handles[ context_level ] ) {
             RemoveHandle( ihandle, &active_handles[ context_level ], status );
-            InsertHandle( ihandle, &free_handles, status );
+            InsertHandle( ihandle, &heap->free, status );
+            heap->nfree++;
          }
       }
 
@@ -6767,8 +7729,10 @@ f     depth.
    with. */
       context_level--;
 
-/* Relinquish access to the handles array. */
-      UNLOCK_MUTEX2;
+/* Relinquish access to the Handles, and return any surplus free Handles
+   to the global HandleHeap. */
+      UNLOCK_HEAP( heap );
+      TrimHeap( heap, status );
    }
 
 }
@@ -6834,8 +7798,10 @@ f        This routine applies to all Objects.
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Thread-specific global data */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
+   HandleHeap *myheap;           /* The thread's HandleHeap */
    int context;                  /* Handle context level */
-   int ihandle;                  /* Offset of Handle in "handles" array */
+   int ihandle;                  /* Offset of Handle */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -6844,47 +7810,53 @@ f        This routine applies to all Objects.
    astGET_GLOBALS(NULL);
 
 /* Obtain the Object pointer from the ID supplied and validate the
-   pointer to ensure it identifies a valid Object. */
+   pointer to ensure it identifies a valid Object. Also get the thread's
+   HandleHeap. */
    (void) astCheckObject( astMakePointer( this_id ) );
+   myheap = GetHeap( status );
    if ( astOK ) {
 
-/* Gain exclusive access to the handles array. */
-      LOCK_MUTEX2;
-
-/* Obtain the Handle offset for this Object. */
-      ihandle = CheckId( this_id, 1, status );
+/* Obtain the Handle offset for this Object. This also gives us exclusive
+   access to the Handle. */
+      ihandle = CheckId( this_id, 1, &heap, status );
       if ( ihandle != -1 ) {
 
 /* Extract the context level at which the Object was created. */
-         context = handles[ ihandle ].context;
+         context = HANDLE( ihandle ).context;
 
 /* Set the new context level to zero, where it cannot be affected by
    ending any context. */
-         handles[ ihandle ].context = 0;
+         HANDLE( ihandle ).context = 0;
 
 /* Remove the object's Handle from its original active Handles list
    and insert it into the list appropriate to its new context
-   level. */
+   level. An unowned Handle is transferred from the global HandleHeap
+   to the thread's HandleHeap (the global HandleHeap is already locked,
+   so the required locking order is retained). */
 
 #if defined(THREAD_SAFE)
          if( context == UNOWNED_CONTEXT ) {
+            LOCK_HEAP( myheap );
             RemoveHandle( ihandle, &unowned_handles, status );
+            HANDLE( ihandle ).heap = myheap;
+            InsertHandle( ihandle, &active_handles[ 0 ], status );
+            UNLOCK_HEAP( myheap );
          } else {
             RemoveHandle( ihandle, &active_handles[ context ], status );
+            InsertHandle( ihandle, &active_handles[ 0 ], status );
          }
 #else
+         (void) myheap;
          RemoveHandle( ihandle, &active_handles[ context ], status );
-#endif
-
          InsertHandle( ihandle, &active_handles[ 0 ], status );
+#endif
 
 /* If required, tell the user that the handle has been exempted. */
 #ifdef MEM_DEBUG
          astHandleUse( ihandle, "exempted" );
 #endif
+         UNLOCK_HEAP( heap );
       }
-
-      UNLOCK_MUTEX2;
    }
 }
 
@@ -6947,8 +7919,9 @@ f     and have not been rendered exempt using AST_EXEMPT.
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Thread-specific global data */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
    int context;                  /* Handle context level */
-   int ihandle;                  /* Offset of Handle in "handles" array */
+   int ihandle;                  /* Offset of Handle */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -6961,11 +7934,9 @@ f     and have not been rendered exempt using AST_EXEMPT.
    (void) astCheckObject( astMakePointer( this_id ) );
    if ( astOK ) {
 
-/* Gain exclusive access to the handles array. */
-      LOCK_MUTEX2;
-
-/* Obtain the Handle offset for this Object. */
-      ihandle = CheckId( this_id, 1, status );
+/* Obtain the Handle offset for this Object. This also gives us exclusive
+   access to the Handle. */
+      ihandle = CheckId( this_id, 1, &heap, status );
       if ( ihandle != -1 ) {
 
 /* Check that the current context level is at least 1 and report an
@@ -6973,11 +7944,11 @@ f     and have not been rendered exempt using AST_EXEMPT.
          if ( context_level < 1 ) {
             if( astOK ) astError( AST__EXPIN, "astExport(%s): Attempt to export an Object "
                                   "from context level zero.", status,
-                                  astGetClass( handles[ ihandle ].ptr ) );
+                                  astGetClass( HANDLE( ihandle ).ptr ) );
 
 /* Extract the context level at which the Object was created. */
          } else {
-            context = handles[ ihandle ].context;
+            context = HANDLE( ihandle ).context;
 
 /* Check that the Object's existing context level is high enough to be
    affected by being exported to the next outer context level. If not,
@@ -6985,7 +7956,7 @@ f     and have not been rendered exempt using AST_EXEMPT.
             if ( context > ( context_level - 1 ) ) {
 
 /* Set the new context level. */
-               handles[ ihandle ].context = context_level - 1;
+               HANDLE( ihandle ).context = context_level - 1;
 
 /* Remove the object's Handle from its original active Handles list
    and insert it into the list appropriate to its new context
@@ -7001,11 +7972,97 @@ f     and have not been rendered exempt using AST_EXEMPT.
 #endif
             }
          }
+         UNLOCK_HEAP( heap );
       }
-      UNLOCK_MUTEX2;
    }
 }
 
+MYSTATIC HandleHeap *GetHeap( int *status ) {
+/*
+*  Name:
+*     GetHeap
+
+*  Purpose:
+*     Get a pointer to the HandleHeap for the running thread.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     HandleHeap *GetHeap( int *status )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     This function returns a pointer to the HandleHeap that holds the
+*     Handles owned by the running thread, creating it if this is the
+*     first time it has been needed by the thread. In a single threaded
+*     environment, the global HandleHeap is returned.
+
+*  Parameters:
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Pointer to the HandleHeap, or NULL if it could not be created.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*     - The returned HandleHeap is not locked.
+*/
+
+#if defined(THREAD_SAFE)
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Thread-specific global data */
+   int stat;                     /* Copy of global status */
+
+/* Get a pointer to Thread-specific global data. */
+   astGET_GLOBALS(NULL);
+
+/* If the thread does not yet have a HandleHeap, create one. Save and
+   clear the global status so that memory allocation can be performed
+   even under error conditions. The HandleHeap is never freed, since
+   Handles owned by the thread may remain in use (e.g. in the
+   "active_handles" lists) for as long as the process runs. */
+   if ( !handle_heap ) {
+      stat = astStatus;
+      astClearStatus;
+
+/* Ensure the "active_handles" array exists before the HandleHeap that
+   refers to it. */
+      if ( !active_handles ) InitContext( status );
+
+      astBeginPM;
+      handle_heap = astMalloc( sizeof( HandleHeap ) );
+      astEndPM;
+
+      if ( handle_heap ) {
+         pthread_mutex_init( &handle_heap->mutex, NULL );
+         handle_heap->free = -1;
+         handle_heap->nfree = 0;
+         handle_heap->active = &active_handles;
+         handle_heap->nids = 0U;
+      }
+
+/* Re-instate any original error status (otherwise retain any error
+   reported above). */
+      if ( stat ) astSetStatus( stat );
+   }
+
+/* Return the HandleHeap. */
+   return handle_heap;
+
+/* In a single threaded environment, there is only the global
+   HandleHeap. */
+#else
+   return &global_heap;
+#endif
+}
+
 void astImportId_( AstObject *this_id, int *status ) {
 /*
 *++
@@ -7058,8 +8115,10 @@ f        This routine applies to all Objects.
 
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Thread-specific global data */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
+   HandleHeap *myheap;           /* The thread's HandleHeap */
    int context;                  /* Handle context level */
-   int ihandle;                  /* Offset of Handle in "handles" array */
+   int ihandle;                  /* Offset of Handle */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -7068,31 +8127,46 @@ f        This routine applies to all Objects.
    astGET_GLOBALS(NULL);
 
 /* Obtain the Object pointer from the ID supplied and validate the
-   pointer to ensure it identifies a valid Object. */
+   pointer to ensure it identifies a valid Object. Also get the thread's
+   HandleHeap. */
    (void) astCheckObject( astMakePointer( this_id ) );
+   myheap = GetHeap( status );
    if ( astOK ) {
 
-/* Gain exclusive access to the handles array. */
-      LOCK_MUTEX2;
-
-/* Obtain the Handle offset for this Object. */
-      ihandle = CheckId( this_id, 1, status );
+/* Obtain the Handle offset for this Object. This also gives us exclusive
+   access to the Handle. */
+      ihandle = CheckId( this_id, 1, &heap, status );
       if ( ihandle != -1 ) {
 
 /* Extract the context level at which the Object was created. */
-         context = handles[ ihandle ].context;
+         context = HANDLE( ihandle ).context;
 
 /* Do nothing if the Identifier already belongs to the current context. */
          if( context != context_level ) {
 
 /* Set the new context level. */
-            handles[ ihandle ].context = context_level;
+            HANDLE( ihandle ).context = context_level;
 
 /* Remove the object's Handle from its original active Handles list
    and insert it into the list appropriate to its new context
-   level. */
+   level. An unowned Handle is transferred from the global HandleHeap
+   (which is already locked) to the thread's HandleHeap. */
+#if defined(THREAD_SAFE)
+            if( context == UNOWNED_CONTEXT ) {
+               LOCK_HEAP( myheap );
+               RemoveHandle( ihandle, &unowned_handles, status );
+               HANDLE( ihandle ).heap = myheap;
+               InsertHandle( ihandle, &active_handles[ context_level ], status );
+               UNLOCK_HEAP( myheap );
+            } else {
+               RemoveHandle( ihandle, &active_handles[ context ], status );
+               InsertHandle( ihandle, &active_handles[ context_level ], status );
+            }
+#else
+            (void) myheap;
             RemoveHandle( ihandle, &active_handles[ context ], status );
             InsertHandle( ihandle, &active_handles[ context_level ], status );
+#endif
 
 /* If required, tell the user that the handle has been imported. */
 #ifdef MEM_DEBUG
@@ -7100,8 +8174,8 @@ f        This routine applies to all Objects.
                            context_level );
 #endif
          }
+         UNLOCK_HEAP( heap );
       }
-      UNLOCK_MUTEX2;
    }
 }
 
@@ -7179,6 +8253,8 @@ c--
    astDECLARE_GLOBALS            /* Thread-specific global data */
    AstObject *fail;              /* Pointer to Object that failed to lock */
    AstObject *this;              /* Pointer to Object */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
+   HandleHeap *myheap;           /* The thread's HandleHeap */
    int ihandle;                  /* Index of supplied objetc handle */
    int lstat;                    /* Local status value */
 
@@ -7194,20 +8270,18 @@ c--
    another thread and so we would pick up the wrong globals. */
    astGET_GLOBALS(NULL);
 
-/* Ensure the running thread has sole access to the static handles arrays. */
-   LOCK_MUTEX2;
-
-/* Ensure the Handles arrays have been initialised. */
+/* Ensure the Handles arrays have been initialised, and get the thread's
+   HandleHeap. */
    if ( !active_handles ) InitContext( status );
+   myheap = GetHeap( status );
 
 /* Get the Handle index for the supplied object identifier. No error is
    reported if the handle is not curently associated with a thread.
    However, an error is reported if the Handle is associated with any
-   thread other than the running thread. */
-   ihandle = CheckId( this_id, 0, status );
-
-/* We've finished with the handles arrays, for the moment. */
-   UNLOCK_MUTEX2;
+   thread other than the running thread. We've finished with the Handle
+   for the moment, so unlock it again. */
+   ihandle = CheckId( this_id, 0, &heap, status );
+   if( ihandle != -1 ) UNLOCK_HEAP( heap );
 
 /* Check the object pointer was valid. */
    if( ihandle != -1 ){
@@ -7238,33 +8312,101 @@ c--
 /* If the Object is now locked for the running thread... */
          } else {
 
-/* We need access to the handles arrays again. */
-            LOCK_MUTEX2;
+/* We need access to the global HandleHeap and the thread's HandleHeap
+   (in that order). */
+            LOCK_HEAP( &global_heap );
+            LOCK_HEAP( myheap );
 
 /* If the supplied handle is not currently assigned to any thread, assign
-   it to the running thread. */
-            if( handles[ ihandle ].context == UNOWNED_CONTEXT ) {
+   it to the running thread. A Handle can only be transferred out of the
+   global HandleHeap by a thread that has it locked, so the "heap"
+   component can be tested safely here. */
+            if( HANDLE( ihandle ).heap == &global_heap &&
+                HANDLE( ihandle ).context == UNOWNED_CONTEXT ) {
                RemoveHandle( ihandle, &unowned_handles, status );
 
 #if defined(MEM_DEBUG)
                astHandleUse( ihandle, "locked by thread %d at context level %d",
-                             handles[ ihandle ].thread, context_level );
+                             HANDLE( ihandle ).thread, context_level );
 #endif
 
-               handles[ ihandle ].thread = AST__THREAD_ID;
-               handles[ ihandle ].context = context_level;
+               HANDLE( ihandle ).thread = AST__THREAD_ID;
+               HANDLE( ihandle ).context = context_level;
+               HANDLE( ihandle ).heap = myheap;
                InsertHandle( ihandle, &active_handles[ context_level ],
                                 status );
             }
 
-/* Finished with the handles arrays again. */
-            UNLOCK_MUTEX2;
+/* Finished with the Handles again. */
+            UNLOCK_HEAP( myheap );
+            UNLOCK_HEAP( &global_heap );
          }
       }
    }
 #endif
 }
 
+MYSTATIC HandleHeap *LockHandle( int ihandle ) {
+/*
+*  Name:
+*     LockHandle
+
+*  Purpose:
+*     Lock the HandleHeap that owns a Handle.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     HandleHeap *LockHandle( int ihandle )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     This function locks the mutex in the HandleHeap that owns a
+*     specified Handle, and returns a pointer to the HandleHeap. The
+*     caller may then access the Handle safely until the HandleHeap is
+*     unlocked.
+
+*  Parameters:
+*     ihandle
+*        Offset that identifies the Handle. This must be less than
+*        "nhandles". No checks are performed.
+
+*  Returned Value:
+*     Pointer to the locked HandleHeap.
+
+*  Notes:
+*     - The caller should not have any HandleHeap locked when this
+*     function is invoked.
+*/
+
+/* Local Variables: */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
+
+/* Get the HandleHeap that currently owns the Handle, and lock it. The
+   owner can only be changed by a thread that holds the owning
+   HandleHeap locked, so if the Handle is still owned by the same
+   HandleHeap once it has been locked, it cannot change until the
+   HandleHeap is unlocked. Otherwise, the Handle was transferred to
+   another HandleHeap before we obtained the lock, so try again. */
+   heap = HANDLE( ihandle ).heap;
+   LOCK_HEAP( heap );
+
+#if defined(THREAD_SAFE)
+   while( HANDLE( ihandle ).heap != heap ) {
+      UNLOCK_HEAP( heap );
+      heap = HANDLE( ihandle ).heap;
+      LOCK_HEAP( heap );
+   }
+#endif
+
+/* Return the locked HandleHeap. */
+   return heap;
+}
+
 void astUnlockId_( AstObject *this_id, int report, int *status ) {
 /*
 c++
@@ -7326,6 +8468,9 @@ c--
    AstErrorContext error_context;/* Info about the current error context */
    AstObject *fail;              /* Pointer to Object that failed */
    AstObject *this;              /* Pointer to Object */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
+   HandleHeap *myheap;           /* The thread's HandleHeap */
+   int context;                  /* Handle context level */
    int ihandle;                  /* Index of supplied objetc handle */
    int lstat;                    /* Local status value */
 
@@ -7343,36 +8488,48 @@ c--
    and then clear the status value. It also defer further error reporting. */
    astErrorBegin( &error_context );
 
-/* Ensure the running thread has sole access to the static handles arrays. */
-   LOCK_MUTEX2;
-
-/* Ensure the Handles arrays have been initialised. */
+/* Ensure the Handles arrays have been initialised, and get the thread's
+   HandleHeap. */
    if ( !active_handles ) InitContext( status );
+   myheap = GetHeap( status );
 
 /* Get the Handle index for the supplied object identifier. Report an error
    if the handle is not curently associated with the running thread. */
-   ihandle = CheckId( this_id, 1, status );
+   ihandle = CheckId( this_id, 1, &heap, status );
 
 /* Break the associated of the handle with the current thread so that the
    handle is not assigned to any thread. We do this before unlocking the
    Object structure (using astManageLock) since as soon as astManageLock
    returns, another thread that is waiting for the object to be unlocked
-   may start up and modify the handle properties. */
-   if( ihandle >= 0 && handles[ ihandle ].context >= 0 ) {
-      RemoveHandle( ihandle, &active_handles[ handles[ ihandle ].context ],
-                    status );
+   may start up and modify the handle properties. The Handle is moved
+   from the thread's HandleHeap to the global HandleHeap, which requires
+   both to be locked (global HandleHeap first). So unlock the Handle and
+   then lock both HandleHeaps. The Handle's HandleHeap cannot change
+   while it is unlocked since only the current thread can unlock it. */
+   if( ihandle >= 0 ) {
+      UNLOCK_HEAP( heap );
+      if( heap == myheap ) {
+         LOCK_HEAP( &global_heap );
+         LOCK_HEAP( myheap );
+
+         context = HANDLE( ihandle ).context;
+         if( HANDLE( ihandle ).heap == myheap && context >= 0 ) {
+            RemoveHandle( ihandle, &( *(myheap->active) )[ context ], status );
 #if defined(MEM_DEBUG)
-      astHandleUse( ihandle, "unlocked from thread %d at context "
-                    "level %d", handles[ ihandle ].thread,
-                    handles[ ihandle ].context );
+            astHandleUse( ihandle, "unlocked from thread %d at context "
+                          "level %d", HANDLE( ihandle ).thread, context );
 #endif
-      handles[ ihandle ].thread = -1;
-      handles[ ihandle ].context = UNOWNED_CONTEXT;
-      InsertHandle( ihandle, &unowned_handles, status );
-   }
+            HANDLE( ihandle ).thread = -1;
+            HANDLE( ihandle ).context = UNOWNED_CONTEXT;
+            HANDLE( ihandle ).heap = &global_heap;
+            InsertHandle( ihandle, &unowned_handles, status );
+         }
 
-/* We've finished with the handles arrays, for the moment. */
-   UNLOCK_MUTEX2;
+/* We've finished with the Handles, for the moment. */
+         UNLOCK_HEAP( myheap );
+         UNLOCK_HEAP( &global_heap );
+      }
+   }
 
 /* Check the supplied object pointer was valid. */
    if( ihandle != -1 ){
@@ -7570,14 +8727,12 @@ MYSTATIC void InsertHandle( int ihandle, int *head, int *status ) {
 *  Notes:
 *     - This function does not perform error chacking and does not
 *     generate errors.
-*     - The lists generated by this function use integer offsets into
-*     the "handles" array for their links, rather than pointers. This
-*     is because the array may be re-located in memory when it needs
-*     to be extended, so pointers to its element would not remain
-*     valid.
-*     - The list elements are drawn from the "handles" array in the
-*     first place so that they can be addressed by small integers (the
-*     offset in the array). This allows references to Handles to be
+*     - The lists generated by this function use integer Handle
+*     offsets for their links, rather than pointers, and the offsets are
+*     converted into Handle structures using the HANDLE macro.
+*     - The list elements are identified by offsets in the first place
+*     so that they can be addressed by small integers. This allows
+*     references to Handles to be
 *     encoded along with security information into an integer that is
 *     sufficiently short to be exported to other languages
 *     (e.g. Fortran) which might not be able to accommodate
@@ -7599,16 +8754,16 @@ MYSTATIC void InsertHandle( int ihandle, int *head, int *status ) {
 
 /* If the list is empty, the sole new element points at itself. */
    if ( *head == -1 ) {
-      handles[ ihandle ].flink = ihandle;
-      handles[ ihandle ].blink = ihandle;
+      HANDLE( ihandle ).flink = ihandle;
+      HANDLE( ihandle ).blink = ihandle;
 
 /* Otherwise, insert the new element in front of the element at the
    head of the list. */
    } else {
-      handles[ ihandle ].flink = *head;
-      handles[ ihandle ].blink = handles[ *head ].blink;
-      handles[ ( handles[ *head ].blink) ].flink = ihandle;
-      handles[ *head ].blink = ihandle;
+      HANDLE( ihandle ).flink = *head;
+      HANDLE( ihandle ).blink = HANDLE( *head ).blink;
+      HANDLE( ( HANDLE( *head ).blink) ).flink = ihandle;
+      HANDLE( *head ).blink = ihandle;
    }
 
 /* Update the list head to identify the new element. */
@@ -7668,6 +8823,7 @@ AstObject *astMakeId_( AstObject *this, int *status ) {
 /* Local Variables: */
    astDECLARE_GLOBALS            /* Thread-specific global data */
    AstObject *id;                /* ID value to return */
+   HandleHeap *heap;             /* The thread's HandleHeap */
    int ihandle;                  /* Handle offset */
 
 /* Initialise. */
@@ -7677,94 +8833,72 @@ AstObject *astMakeId_( AstObject *this, int *status ) {
 /* Check the global error status. */
    if ( astOK ) {
 
-/* Get a pointer to Thread-specific global data. */
-      astGET_GLOBALS(this);
-
-/* Gain exclusive access to the handles array. */
-      LOCK_MUTEX2;
+/* Get a pointer to Thread-specific global data. The new Handle is owned
+   by the running thread, so use the running thread's global data
+   rather than any stored in the Object. */
+      astGET_GLOBALS(NULL);
 
 /* If a non-NULL Object pointer was given, we must obtain a Handle
    structure to associate with it (otherwise a zero identifier value
    is returned without error). */
       if ( this ) {
 
-/* If the free Handles list is not empty, obtain a Handle from it. */
-         if ( free_handles != -1 ) {
-            ihandle = free_handles;
-            RemoveHandle( ihandle, &free_handles, status );
-
-/* Otherwise, allocate a new Handle by extending the "handles" array
-   and using the offset of the new element. */
-         } else {
-
-            astBeginPM;
-            handles = astGrow( handles, nhandles + 1, sizeof( Handle ) );
-            astEndPM;
-
-            if ( astOK ) {
-               ihandle = nhandles++;
-
-               handles[ ihandle ].ptr = NULL;
-               handles[ ihandle ].context = INVALID_CONTEXT;
-               handles[ ihandle ].check = 0;
-               handles[ ihandle ].flink = -1;
-               handles[ ihandle ].blink = -1;
-#if defined(THREAD_SAFE)
-               handles[ ihandle ].thread = 0;
-#endif
-
-#if defined(MEM_DEBUG)
-               handles[ ihandle ].id = 0;
-               handles[ ihandle ].vtab = NULL;
-#endif
-            }
-         }
-
 /* If the first AST context level has not yet been initialised, invoke
    InitContext to initialise it and allocate memory for the
-   "active_handles" array which stores context information. */
+   "active_handles" array which stores context information. Then get
+   the thread's HandleHeap. */
+         if ( !active_handles ) InitContext( status );
+         heap = GetHeap( status );
+
+/* If the thread has no free Handles, obtain some more from the global
+   HandleHeap. This is done before the thread's HandleHeap is locked
+   since the global HandleHeap must be locked first. Free Handles are
+   only removed from the thread's HandleHeap by the thread itself, so
+   the free list will not be emptied by another thread before we lock
+   it. */
+         if ( heap && heap->free == -1 ) RefillHeap( heap, status );
+
          if ( astOK ) {
-            if ( !active_handles ) InitContext( status );
+
+/* Gain exclusive access to the Handles owned by the thread, and obtain
+   a Handle from its free Handles list. */
+            LOCK_HEAP( heap );
+            ihandle = heap->free;
+            RemoveHandle( ihandle, &heap->free, status );
+            heap->nfree--;
 
 /* Store the Object pointer and current context level in the Handle. */
-            if ( astOK ) {
-               handles[ ihandle ].ptr = this;
-               handles[ ihandle ].context = context_level;
+            HANDLE( ihandle ).ptr = this;
+            HANDLE( ihandle ).context = context_level;
 #if defined(THREAD_SAFE)
-               handles[ ihandle ].thread = AST__THREAD_ID;
+            HANDLE( ihandle ).thread = AST__THREAD_ID;
 #endif
 
 /* Store extra debugging information in the handle if enabled */
 #if defined(MEM_DEBUG)
-               handles[ ihandle ].id = astMemoryId( this );
-               handles[ ihandle ].vtab = this->vtab;
-               astHandleUse( ihandle, "associated with a %s (id %d)",
-                              astGetClass( this ), astMemoryId( this ));
+            HANDLE( ihandle ).id = astMemoryId( this );
+            HANDLE( ihandle ).vtab = this->vtab;
+            astHandleUse( ihandle, "associated with a %s (id %d)",
+                           astGetClass( this ), astMemoryId( this ));
 #endif
 
 /* Insert the Handle into the active Handles list for the current
    context level. */
-               InsertHandle( ihandle, &active_handles[ context_level ], status );
+            InsertHandle( ihandle, &active_handles[ context_level ], status );
 
 /* Associate an identifier value with the Handle. */
-               id = AssocId( ihandle, status );
+            id = AssocId( ihandle, heap, status );
 
 /* If an error occurred, clean up by annulling the Handle. This
    ensures that the Object pointer is annulled and returns the unused
    Handle to the Free Handle list. */
-               if ( !astOK ) {
-                  AnnulHandle( ihandle, status );
-                  this = NULL;
-               }
-
-/* If the Handle wasn't used (because of an earlier error), return it
-   to the free Handles list. */
-            } else {
-               InsertHandle( ihandle, &free_handles, status );
+            if ( !astOK ) {
+               AnnulHandle( ihandle, heap, status );
+               this = NULL;
             }
+            UNLOCK_HEAP( heap );
          }
       }
-      UNLOCK_MUTEX2;
    }
 
 /* If a bad status value was either supplied or generated within this
@@ -7832,22 +8966,22 @@ AstObject *astMakePointer_( AstObject *this_id, int *status ) {
 
 /* Local Variables: */
    AstObject *ptr;               /* Pointer value to return */
-   int ihandle;                  /* Handle offset in "handles" array */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
+   int ihandle;                  /* Handle offset */
 
 /* Initialise. */
    ptr = NULL;
 
-/* Gain exclusive access to the handles array. */
-   LOCK_MUTEX2;
-
-/* Validate the identifier supplied and derive the Handle offset. */
-   ihandle = CheckId( this_id, 1, status );
+/* Validate the identifier supplied and derive the Handle offset. This
+   locks the HandleHeap that owns the Handle. */
+   ihandle = CheckId( this_id, 1, &heap, status );
 
 /* If the identifier was valid, extract the Object pointer from the
    Handle. */
-   if ( ihandle != -1 ) ptr = handles[ ihandle ].ptr;
-
-   UNLOCK_MUTEX2;
+   if ( ihandle != -1 ) {
+      ptr = HANDLE( ihandle ).ptr;
+      UNLOCK_HEAP( heap );
+   }
 
 /* Return the result. */
    return ptr;
@@ -7910,22 +9044,22 @@ AstObject *astMakePointer_NoLockCheck_( AstObject *this_id, int *status ) {
 
 /* Local Variables: */
    AstObject *ptr;               /* Pointer value to return */
-   int ihandle;                  /* Handle offset in "handles" array */
+   HandleHeap *heap;             /* HandleHeap that owns the Handle */
+   int ihandle;                  /* Handle offset */
 
 /* Initialise. */
    ptr = NULL;
 
-/* Gain exclusive access to the handles array. */
-   LOCK_MUTEX2;
-
-/* Validate the identifier supplied and derive the Handle offset. */
-   ihandle = CheckId( this_id, 0, status );
+/* Validate the identifier supplied and derive the Handle offset. This
+   locks the HandleHeap that owns the Handle. */
+   ihandle = CheckId( this_id, 0, &heap, status );
 
 /* If the identifier was valid, extract the Object pointer from the
    Handle. */
-   if ( ihandle != -1 ) ptr = handles[ ihandle ].ptr;
-
-   UNLOCK_MUTEX2;
+   if ( ihandle != -1 ) {
+      ptr = HANDLE( ihandle ).ptr;
+      UNLOCK_HEAP( heap );
+   }
 
 /* Return the result. */
    return ptr;
@@ -7988,6 +9122,116 @@ int astP2I_( AstObject *pointer, int *status ) {
    return temp.integer;
 }
 
+MYSTATIC void RefillHeap( HandleHeap *heap, int *status ) {
+/*
+*  Name:
+*     RefillHeap
+
+*  Purpose:
+*     Transfer free Handles from the global HandleHeap to a thread.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     void RefillHeap( HandleHeap *heap, int *status )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     This function moves a batch of free Handles from the global
+*     HandleHeap to the supplied HandleHeap. If the global HandleHeap
+*     has no free Handles, a new chunk of Handles is allocated first.
+
+*  Parameters:
+*     heap
+*        Pointer to the HandleHeap to receive the free Handles. It
+*        should not be locked by the caller.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   Handle *chunk;                /* Pointer to new chunk of Handles */
+   int i;                        /* Loop count */
+   int ihandle;                  /* Offset of Handle */
+   int ichunk;                   /* Index of new chunk */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Gain exclusive access to the global HandleHeap. */
+   LOCK_HEAP( &global_heap );
+
+/* If there are no free Handles in the global HandleHeap, allocate a new
+   chunk of Handles. Report an error if the maximum number of Handles
+   that can be encoded into an identifier has been reached. */
+   if ( global_heap.free == -1 ) {
+      ichunk = nhandles / HANDLE_CHUNK;
+      if ( ichunk >= HANDLE_MXCHUNK ) {
+         astError( AST__XSOBJ, "There are too many AST Objects in use at "
+                   "once.", status );
+
+      } else {
+         astBeginPM;
+         chunk = astMalloc( HANDLE_CHUNK*sizeof( Handle ) );
+         astEndPM;
+
+/* Initialise each new Handle and put it into the global free Handles
+   list (in reverse order so that the lowest offsets are used first).
+   The chunk is stored before "nhandles" is incremented so that any
+   Handle offset below "nhandles" can always be converted into a Handle
+   using the HANDLE macro. */
+         if ( astOK ) {
+            SET_HANDLE_CHUNK_PTR( ichunk, chunk );
+            for ( i = HANDLE_CHUNK - 1; i >= 0; i-- ) {
+               ihandle = ichunk*HANDLE_CHUNK + i;
+               HANDLE( ihandle ).ptr = NULL;
+               HANDLE( ihandle ).context = INVALID_CONTEXT;
+               HANDLE( ihandle ).check = 0;
+               HANDLE( ihandle ).flink = -1;
+               HANDLE( ihandle ).blink = -1;
+               HANDLE( ihandle ).heap = &global_heap;
+#if defined(THREAD_SAFE)
+               HANDLE( ihandle ).thread = -1;
+#endif
+
+#if defined(MEM_DEBUG)
+               HANDLE( ihandle ).id = 0;
+               HANDLE( ihandle ).vtab = NULL;
+#endif
+               InsertHandle( ihandle, &global_heap.free, status );
+            }
+            global_heap.nfree += HANDLE_CHUNK;
+            SET_NHANDLES( nhandles + HANDLE_CHUNK );
+         }
+      }
+   }
+
+/* In a multi-threaded environment, move a batch of free Handles from
+   the global HandleHeap to the supplied HandleHeap (the global
+   HandleHeap is locked first). In a single threaded environment the
+   supplied HandleHeap is the global HandleHeap, so nothing more needs
+   to be done. */
+   if ( heap != &global_heap ) {
+      LOCK_HEAP( heap );
+      for ( i = 0; i < HANDLE_BATCH && global_heap.free != -1; i++ ) {
+         ihandle = global_heap.free;
+         RemoveHandle( ihandle, &global_heap.free, status );
+         global_heap.nfree--;
+         HANDLE( ihandle ).heap = heap;
+         InsertHandle( ihandle, &heap->free, status );
+         heap->nfree++;
+      }
+      UNLOCK_HEAP( heap );
+   }
+
+/* Relinquish access to the global HandleHeap. */
+   UNLOCK_HEAP( &global_heap );
+}
+
 MYSTATIC void RemoveHandle( int ihandle, int *head, int *status ) {
 /*
 *  Name:
@@ -8045,13 +9289,13 @@ MYSTATIC void RemoveHandle( int ihandle, int *head, int *status ) {
 
 /* Remove the Handle from the list by re-establishing links between
    the elements on either side of it. */
-   handles[ ( handles[ ihandle ].blink ) ].flink = handles[ ihandle ].flink;
-   handles[ ( handles[ ihandle ].flink ) ].blink = handles[ ihandle ].blink;
+   HANDLE( ( HANDLE( ihandle ).blink ) ).flink = HANDLE( ihandle ).flink;
+   HANDLE( ( HANDLE( ihandle ).flink ) ).blink = HANDLE( ihandle ).blink;
 
 /* If the element removed was at the head of the list, update the head
    of list offset to identify the following element. */
    if ( ihandle == *head ) {
-      *head = handles[ ihandle ].flink;
+      *head = HANDLE( ihandle ).flink;
 
 /* If the head of list still identifies the removed element, then note
    that the list is now empty. */
@@ -8059,8 +9303,8 @@ MYSTATIC void RemoveHandle( int ihandle, int *head, int *status ) {
    }
 
 /* Make the removed element point at itself. */
-   handles[ ihandle ].flink = ihandle;
-   handles[ ihandle ].blink = ihandle;
+   HANDLE( ihandle ).flink = ihandle;
+   HANDLE( ihandle ).blink = ihandle;
 
 #if defined(MEM_DEBUG)
    astHandleUse( ihandle, "has been removed from %s", buf );
@@ -8230,6 +9474,7 @@ c--
 
 /* More local Variables: */
    AstObject *this;
+   HandleHeap *heap;
    int ihandle;
    int check;
 
@@ -8246,25 +9491,23 @@ c--
 /* If the ownership of the handle is being queried... */
    if( ptr ) {
 
-/* Lock the mutex that guards access to the handles array */
-      LOCK_MUTEX2;
-
 /* Check the supplied object identifier is valid and get the
-   corresponding index into the handles array. */
-      ihandle = CheckId( this_id, 1, status );
+   corresponding Handle offset. This locks the HandleHeap that owns the
+   Handle. */
+      ihandle = CheckId( this_id, 1, &heap, status );
       if( ihandle != -1 ) {
 
 /* Set the returned value on the basis of the threa didentifier stored in
    the handle structure. */
-         if( handles[ ihandle ].thread == -1 ) {
+         if( HANDLE( ihandle ).thread == -1 ) {
             result = AST__UNLOCKED;
-         } else if( handles[ ihandle ].thread != AST__THREAD_ID ) {
+         } else if( HANDLE( ihandle ).thread != AST__THREAD_ID ) {
             result = AST__OTHER;
          }
-      }
 
-/* Unlock the mutex that guards access to the handles array */
-      UNLOCK_MUTEX2;
+/* Unlock the HandleHeap. */
+         UNLOCK_HEAP( heap );
+      }
 
 /* Otherwise, the ownership of the Object is being queried. Obtain the
    Object pointer from the ID supplied and validate the pointer to ensure
@@ -8291,6 +9534,150 @@ c--
    return result;
 }
 
+MYSTATIC void TrimHeap( HandleHeap *heap, int *status ) {
+/*
+*  Name:
+*     TrimHeap
+
+*  Purpose:
+*     Return surplus free Handles from a thread to the global HandleHeap.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "object.h"
+*     void TrimHeap( HandleHeap *heap, int *status )
+
+*  Class Membership:
+*     Object member function.
+
+*  Description:
+*     If the supplied HandleHeap holds more than twice HANDLE_BATCH free
+*     Handles, this function moves free Handles to the global HandleHeap
+*     until only HANDLE_BATCH remain. This prevents a thread that
+*     annuls many identifiers from retaining Handles that other threads
+*     could use.
+
+*  Parameters:
+*     heap
+*        Pointer to the HandleHeap, which should be owned by the running
+*        thread. It should not be locked by the caller. No action is
+*        taken if it is NULL or is the global HandleHeap.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - This function attempts to execute even if the global error
+*     status is set.
+*/
+
+/* Local Variables: */
+   int ihandle;                  /* Offset of Handle */
+   int trim;                     /* Are there surplus free Handles? */
+
+/* Check a thread's HandleHeap was supplied. */
+   if ( heap && heap != &global_heap ) {
+
+/* Other threads may add Handles to the free list (by annulling Handles
+   issued by this thread), so lock the HandleHeap before testing the
+   number of free Handles. Only this HandleHeap is locked, so that the
+   global HandleHeap is not locked unless some Handles need moving. */
+      LOCK_HEAP( heap );
+      trim = ( heap->nfree > 2*HANDLE_BATCH );
+      UNLOCK_HEAP( heap );
+   } else {
+      trim = 0;
+   }
+
+/* If required, gain exclusive access to both HandleHeaps (global first,
+   as elsewhere). */
+   if ( trim ) {
+      LOCK_HEAP( &global_heap );
+      LOCK_HEAP( heap );
+
+/* Move the surplus free Handles. The number of free Handles is tested
+   again, since it may have changed while the HandleHeap was unlocked. */
+      while ( heap->nfree > HANDLE_BATCH ) {
+         ihandle = heap->free;
+         RemoveHandle( ihandle, &heap->free, status );
+         heap->nfree--;
+         HANDLE( ihandle ).heap = &global_heap;
+         InsertHandle( ihandle, &global_heap.free, status );
+         global_heap.nfree++;
+      }
+
+      UNLOCK_HEAP( heap );
+      UNLOCK_HEAP( &global_heap );
+   }
+}
+
+#if defined(THREAD_SAFE)
+void astFreeObjectGlobals_( AstObjectGlobals *globals ) {
+/*
+*+
+*  Name:
+*     astFreeObjectGlobals
+
+*  Purpose:
+*     Return the free Handles of a thread that is exiting.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "object.h"
+*     void astFreeObjectGlobals( AstObjectGlobals *globals )
+
+*  Description:
+*     This function moves all the free Handles in the HandleHeap within
+*     the supplied thread-specific global data to the global HandleHeap,
+*     in the same way as TrimHeap. It is invoked (via a pthreads
+*     thread-specific data destructor) when a thread that has used AST
+*     exits, so that its free Handles can be used by other threads. The
+*     HandleHeap itself is retained, since Handles issued by the thread
+*     may still be annulled by other threads.
+
+*  Parameters:
+*     globals
+*        Pointer to the Object module's global data for the exiting
+*        thread. This is accessed directly, rather than via astGET_GLOBALS,
+*        since the thread-specific data for the thread may already have
+*        been detached from the thread.
+
+*  Notes:
+*     - This function does not use the inherited status.
+*-
+*/
+
+/* Local Variables: */
+   HandleHeap *heap;             /* The exiting thread's HandleHeap */
+   int ihandle;                  /* Offset of Handle */
+   int lstatus = 0;              /* Local status value */
+   int *status = &lstatus;       /* Pointer to local status value */
+
+/* Move every free Handle, locking both HandleHeaps (global first, as
+   elsewhere). */
+   heap = globals ? globals->Handle_Heap : NULL;
+   if ( heap ) {
+      LOCK_HEAP( &global_heap );
+      LOCK_HEAP( heap );
+
+      while ( heap->free != -1 ) {
+         ihandle = heap->free;
+         RemoveHandle( ihandle, &heap->free, status );
+         HANDLE( ihandle ).heap = &global_heap;
+         InsertHandle( ihandle, &global_heap.free, status );
+         global_heap.nfree++;
+      }
+      heap->nfree = 0;
+
+      UNLOCK_HEAP( heap );
+      UNLOCK_HEAP( &global_heap );
+   }
+}
+#endif
+
 int astVersion_( int *status ) {
 /*
 *++
@@ -8449,21 +9836,21 @@ void CheckList( int *head, int *status ) {
    ok = 1;
    if ( *head != -1 ) {
       ihandle = *head;
-      if( handles[ handles[ ihandle ].blink ].flink != ihandle ||
-          handles[ handles[ ihandle ].flink ].blink != ihandle ) {
+      if( HANDLE( HANDLE( ihandle ).blink ).flink != ihandle ||
+          HANDLE( HANDLE( ihandle ).flink ).blink != ihandle ) {
          ok = 0;
 
       } else {
          if( CheckThread( ihandle, head, status ) ) {
-            ihandle= handles[ *head ].blink;
+            ihandle= HANDLE( *head ).blink;
             while( ihandle != *head ) {
-               if( handles[ handles[ ihandle ].blink ].flink != ihandle ||
-                   handles[ handles[ ihandle ].flink ].blink != ihandle ||
+               if( HANDLE( HANDLE( ihandle ).blink ).flink != ihandle ||
+                   HANDLE( HANDLE( ihandle ).flink ).blink != ihandle ||
                    CheckThread( ihandle, head, status ) == 0 ) {
                   ok = 0;
                   break;
                }
-               ihandle= handles[ ihandle ].blink;
+               ihandle= HANDLE( ihandle ).blink;
             }
          }
       }
@@ -8473,18 +9860,18 @@ void CheckList( int *head, int *status ) {
       printf("CheckList error in %s\n", HeadString( head, buf ) );
       printf("   Central handle: %s\n", HandleString( ihandle, buf ) );
 
-      if( handles[ handles[ ihandle ].blink ].flink != ihandle ) {
+      if( HANDLE( HANDLE( ihandle ).blink ).flink != ihandle ) {
          printf("   Central handle->blink: %s\n",
-                 HandleString( handles[ ihandle ].blink, buf ) );
+                 HandleString( HANDLE( ihandle ).blink, buf ) );
          printf("   Central handle->blink->flink: %s\n",
-                 HandleString( handles[ handles[ ihandle ].blink ].flink, buf ) );
+                 HandleString( HANDLE( HANDLE( ihandle ).blink ).flink, buf ) );
       }
 
-      if( handles[ handles[ ihandle ].flink ].blink != ihandle ) {
+      if( HANDLE( HANDLE( ihandle ).flink ).blink != ihandle ) {
          printf("   Central handle->flink: %s\n",
-                 HandleString( handles[ ihandle ].flink, buf ) );
+                 HandleString( HANDLE( ihandle ).flink, buf ) );
          printf("   Central handle->flink->blink: %s\n",
-                 HandleString( handles[ handles[ ihandle ].flink ].blink, buf ) );
+                 HandleString( HANDLE( HANDLE( ihandle ).flink ).blink, buf ) );
       }
    }
 
@@ -8503,13 +9890,13 @@ void CheckInList( int ihandle, int *head, int in, int *status ){
          found = 1;
       } else {
          if( CheckThread( ihandle, head, status ) ) {
-            int jhandle= handles[ *head ].blink;
+            int jhandle= HANDLE( *head ).blink;
             while( jhandle != *head ) {
                if( ihandle == jhandle ) {
                   found = 1;
                   break;
                }
-               jhandle= handles[ jhandle ].blink;
+               jhandle= HANDLE( jhandle ).blink;
             }
          }
       }
@@ -8539,26 +9926,27 @@ int CheckThread( int ihandle, int *head, int *status ) {
    astGET_GLOBALS(NULL);
 
    if( *head == unowned_handles  ) {
-      if(  handles[ ihandle ].thread != -1 ) {
+      if(  HANDLE( ihandle ).thread != -1 ) {
          printf("Handle %s has wrong thread: is %d, should "
              "be -1 (i.e. unowned)\n", HandleString( ihandle, buf ),
-              handles[ ihandle ].thread );
+              HANDLE( ihandle ).thread );
 
          result = 0;
       }
 
-   } else if( *head == free_handles ) {
-      if(  handles[ ihandle ].thread != -1 ) {
+   } else if( head == &global_heap.free ||
+              ( handle_heap && head == &handle_heap->free ) ) {
+      if(  HANDLE( ihandle ).thread != -1 ) {
          printf("Handle %s has wrong thread: is %d, should "
              "be -1 (i.e. free)\n", HandleString( ihandle, buf ),
-              handles[ ihandle ].thread );
+              HANDLE( ihandle ).thread );
          result = 0;
       }
 
-   } else if( handles[ ihandle ].thread != AST__THREAD_ID ) {
+   } else if( HANDLE( ihandle ).thread != AST__THREAD_ID ) {
       printf("Handle %s has wrong thread: is %d, should "
              "be %d\n", HandleString( ihandle, buf ),
-              handles[ ihandle ].thread, AST__THREAD_ID );
+              HANDLE( ihandle ).thread, AST__THREAD_ID );
       result = 0;
    }
 
@@ -8604,10 +9992,10 @@ MYSTATIC const char *HandleString( int ihandle, char *buf ){
    if( ihandle >= 0 ) {
       sprintf( buf, "(index:%d v:%d c:%d t:%d i:%d cl:%s) [cur. thread: %d]",
                ihandle,
-               handles[ ihandle ].check,
-               handles[ ihandle ].context, handles[ ihandle ].thread,
-               handles[ ihandle ].id,
-               handles[ ihandle ].vtab ? handles[ ihandle ].vtab->class : "<none>",
+               HANDLE( ihandle ).check,
+               HANDLE( ihandle ).context, HANDLE( ihandle ).thread,
+               HANDLE( ihandle ).id,
+               HANDLE( ihandle ).vtab ? HANDLE( ihandle ).vtab->class : "<none>",
                AST__THREAD_ID );
    } else {
       sprintf( buf, "(index:%d <invalid>) [cur. thread: %d]", ihandle,
@@ -8617,9 +10005,9 @@ MYSTATIC const char *HandleString( int ihandle, char *buf ){
 #else
    if( ihandle >= 0 ) {
       sprintf( buf, "(index:%d v:%d c:%d i:%d cl:%s)", ihandle,
-               handles[ ihandle ].check,
-               handles[ ihandle ].context, handles[ ihandle ].id,
-               handles[ ihandle ].vtab ? handles[ ihandle ].vtab->class : "<none>" );
+               HANDLE( ihandle ).check,
+               HANDLE( ihandle ).context, HANDLE( ihandle ).id,
+               HANDLE( ihandle ).vtab ? HANDLE( ihandle ).vtab->class : "<none>" );
    } else {
       sprintf( buf, "(index:%d <invalid>)", ihandle );
    }
@@ -8632,9 +10020,14 @@ MYSTATIC const char *HeadString( int *head, char *list ){
    astDECLARE_GLOBALS
    astGET_GLOBALS(NULL);
 
-   if( head == &free_handles ) {
+   if( head == &global_heap.free ) {
       strcpy( list, "free_handles" );
 
+#if defined(THREAD_SAFE)
+   } else if( handle_heap && head == &handle_heap->free ) {
+      strcpy( list, "thread free_handles" );
+#endif
+
 #if defined(THREAD_SAFE)
    } else if( head == &unowned_handles ) {
       strcpy( list, "unowned_handles" );
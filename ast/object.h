@@ -115,10 +115,14 @@
 *        astCast
 *           Return a deep copy of an object, cast into an instance of a
 *           parent class.
+*        astDeclareAttribC/D/I
+*           Declare typed access functions for an attribute.
 *        astDump
 *           Write an Object to a Channel.
 *        astEqual
 *           Are two Objects equivalent?
+*        astForwardAttribs
+*           Remove typed access functions for forwarded attributes.
 *        astGetAttrib
 *           Get the value of a specified attribute for an Object.
 *        astGetClass (deprecated synonym astClass)
@@ -139,6 +143,8 @@
 *           Declare a destructor for an Object.
 *        astSetDump
 *           Declare a dump function for an Object.
+*        astForwardAttribs
+*           Indicate which attributes a class does not forward.
 *        astSetVtab
 *           Chaneg the virtual function table associated with an Object.
 *        astSetID
@@ -325,6 +331,15 @@
 *        Added astSame.
 *     7-APR-2010 (DSB):
 *        Added astHasAttribute.
+*     16-OCT-2026 (DSB):
+*        Make the values returned by astThread public.
+*     16-OCT-2026 (DSB):
+*        Added Handle_Heap to the Object globals.
+*     16-OCT-2026 (DSB):
+*        Added astFreeObjectGlobals.
+*     16-OCT-2026 (DSB):
+*        Added typed attribute access functions (astDeclareAttribI/D/C
+*        and astForwardAttribs).
 *--
 */
 
@@ -372,19 +387,20 @@
 #if defined(astCLASS )
 #define AST__GETATTRIB_BUFF_LEN 50 /* Length of string returned by GetAttrib. */
 #define AST__ASTGETC_MAX_STRINGS 50 /* Number of string values to buffer within astGetC */
+#define AST__NATTRIBFNS 32 /* Number of hash buckets for typed attribute functions (a power of 2) */
 
 /* Values supplied to astManageLock */
 #define AST__LOCK 1      /* Lock the object */
 #define AST__UNLOCK 2    /* Unlock the object */
 #define AST__CHECKLOCK 3 /* Check if the object is locked */
 
+#endif
+
 /* Values returned by astThread */
 #define AST__UNLOCKED 1  /* Object is unlocked */
 #define AST__RUNNING 2   /* Object is locked by the running thread */
 #define AST__OTHER 3     /* Object is locked by another thread */
 
-#endif
-
 /* Value that indicates that two classes are not in direct line from each
    other. */
 #if defined(astCLASS )
@@ -1092,6 +1108,79 @@ int astTest##attribute##_( Ast##class *this, int *status ) { \
 }
 #endif
 
+#if defined(astCLASS)            /* Protected */
+/*
+*+
+*  Name:
+*     astMAKE_ATTRIBGET/SET/TEST/CLEAR
+
+*  Purpose:
+*     Implement typed access functions for an attribute.
+
+*  Type:
+*     Protected macros.
+
+*  Synopsis:
+*     #include "object.h"
+*     astMAKE_ATTRIBGET(class,attribute,type)
+*     astMAKE_ATTRIBSET(class,attribute,type)
+*     astMAKE_ATTRIBTEST(class,attribute)
+*     astMAKE_ATTRIBCLEAR(class,attribute)
+
+*  Class Membership:
+*     Defined by the Object class.
+
+*  Description:
+*     These macros expand to private functions of the form:
+*
+*        static <type> Get<Attribute>Attrib( AstObject *this, int *status )
+*        static void Set<Attribute>Attrib( AstObject *this, <type> value, int *status )
+*        static int Test<Attribute>Attrib( AstObject *this, int *status )
+*        static void Clear<Attribute>Attrib( AstObject *this, int *status )
+*
+*     which invoke the astGet<Attribute>, astSet<Attribute>,
+*     astTest<Attribute> and astClear<Attribute> methods of a class. They
+*     are suitable for passing to astDeclareAttribI/D/C, and should only
+*     be used for attributes for which the string interface (astGetAttrib,
+*     etc.) invokes the same methods with no further conversion.
+
+*  Parameters:
+*      class
+*         The name (not the type) of the class that defines the methods.
+*      attribute
+*         The name of the attribute, as it appears in the method names
+*         (e.g. Nin in "astGetNin").
+*      type
+*         The C type of the attribute value (int or double).
+
+*  Notes:
+*     -  To avoid problems with some compilers, you should not leave any white
+*     space around the macro arguments.
+*-
+*/
+
+/* Define the macros. */
+#define astMAKE_ATTRIBGET(class,attribute,type) \
+static type Get##attribute##Attrib( AstObject *this, int *status ) { \
+   return astGet##attribute##_( (Ast##class *) this, status ); \
+}
+
+#define astMAKE_ATTRIBSET(class,attribute,type) \
+static void Set##attribute##Attrib( AstObject *this, type value, int *status ) { \
+   astSet##attribute##_( (Ast##class *) this, value, status ); \
+}
+
+#define astMAKE_ATTRIBTEST(class,attribute) \
+static int Test##attribute##Attrib( AstObject *this, int *status ) { \
+   return astTest##attribute##_( (Ast##class *) this, status ); \
+}
+
+#define astMAKE_ATTRIBCLEAR(class,attribute) \
+static void Clear##attribute##Attrib( AstObject *this, int *status ) { \
+   astClear##attribute##_( (Ast##class *) this, status ); \
+}
+#endif
+
 #if defined(astCLASS)            /* Protected */
 /*
 *+
@@ -1315,6 +1404,28 @@ typedef struct AstClassIdentifier {
    now. */
 struct AstChannel;
 
+/* Typed attribute access functions. */
+/* ---------------------------------- */
+/* This structure describes the functions that give direct access to
+   the value of a single attribute in its native data type, avoiding the
+   formatting and parsing performed by the astGetAttrib and astSetAttrib
+   methods. Each class declares these functions for selected attributes
+   using astDeclareAttribI/D/C. Any function may be NULL, in which case
+   the string interface is used instead. */
+#if defined(astCLASS)            /* Protected */
+typedef struct AstAttribFns {
+   const char *name;             /* Lower case attribute name */
+   int (* GetI)( AstObject *, int * );
+   double (* GetD)( AstObject *, int * );
+   const char *(* GetC)( AstObject *, int * );
+   void (* SetI)( AstObject *, int, int * );
+   void (* SetD)( AstObject *, double, int * );
+   int (* Test)( AstObject *, int * );
+   void (* Clear)( AstObject *, int * );
+   struct AstAttribFns *next;    /* Next entry in the same hash bucket */
+} AstAttribFns;
+#endif
+
 /* This table contains all information that is the same for all
    objects in the class (e.g. pointers to its virtual functions). */
 #if defined(astCLASS)            /* Protected */
@@ -1379,6 +1490,7 @@ typedef struct AstObjectVtab {
    int nobject;                  /* Number of active objects in the class */
    int nfree;                    /* No. of entries in "free_list" */
    AstObject **free_list;        /* List of pointers for freed Objects */
+   AstAttribFns *attrib_fns[ AST__NATTRIBFNS ]; /* Typed attribute functions */
 
 #if defined(THREAD_SAFE)
    int (* ManageLock)( AstObject *, int, int, AstObject **, int * );
@@ -1398,6 +1510,7 @@ typedef struct AstObjectGlobals {
    int Retain_Esc;
    int Context_Level;
    int *Active_Handles;
+   struct AstHandleHeap *Handle_Heap;
    char GetAttrib_Buff[ AST__GETATTRIB_BUFF_LEN + 1 ];
    char *AstGetC_Strings[ AST__ASTGETC_MAX_STRINGS ];
    int AstGetC_Istr;
@@ -1444,6 +1557,7 @@ AstObject *astLoadObject_( void *, size_t, AstObjectVtab *,
 
 #if defined(THREAD_SAFE)
 void astInitObjectGlobals_( AstObjectGlobals * );
+void astFreeObjectGlobals_( AstObjectGlobals * );
 #endif
 
 #endif
@@ -1543,6 +1657,10 @@ void astSetAttrib_( AstObject *, const char *, int * );
 void astSetCopy_( AstObjectVtab *, void (*)( const AstObject *, AstObject *, int * ), int * );
 void astSetDelete_( AstObjectVtab *, void (*)( AstObject *, int * ), int * );
 void astSetDump_( AstObjectVtab *, void (*)( AstObject *, AstChannel *, int * ), const char *, const char *, int * );
+void astDeclareAttribI_( AstObjectVtab *, const char *, int (*)( AstObject *, int * ), void (*)( AstObject *, int, int * ), int (*)( AstObject *, int * ), void (*)( AstObject *, int * ), int * );
+void astDeclareAttribD_( AstObjectVtab *, const char *, double (*)( AstObject *, int * ), void (*)( AstObject *, double, int * ), int (*)( AstObject *, int * ), void (*)( AstObject *, int * ), int * );
+void astDeclareAttribC_( AstObjectVtab *, const char *, const char *(*)( AstObject *, int * ), int (*)( AstObject *, int * ), void (*)( AstObject *, int * ), int * );
+void astForwardAttribs_( AstObjectVtab *, const char *, int * );
 void astSetVtab_( AstObject *, AstObjectVtab *, int * );
 void astSetID_( AstObject *, const char *, int * );
 void astSetIdent_( AstObject *, const char *, int * );
@@ -1715,6 +1833,14 @@ astINVOKE(V,astSetCopy_((AstObjectVtab *)(vtab),copy,STATUS_PTR))
 astINVOKE(V,astSetDelete_((AstObjectVtab *)(vtab),delete,STATUS_PTR))
 #define astSetDump(vtab,dump,class,comment) \
 astINVOKE(V,astSetDump_((AstObjectVtab *)(vtab),dump,class,comment,STATUS_PTR))
+#define astDeclareAttribI(vtab,name,get,set,test,clear) \
+astINVOKE(V,astDeclareAttribI_((AstObjectVtab *)(vtab),name,get,set,test,clear,STATUS_PTR))
+#define astDeclareAttribD(vtab,name,get,set,test,clear) \
+astINVOKE(V,astDeclareAttribD_((AstObjectVtab *)(vtab),name,get,set,test,clear,STATUS_PTR))
+#define astDeclareAttribC(vtab,name,get,test,clear) \
+astINVOKE(V,astDeclareAttribC_((AstObjectVtab *)(vtab),name,get,test,clear,STATUS_PTR))
+#define astForwardAttribs(vtab,keep) \
+astINVOKE(V,astForwardAttribs_((AstObjectVtab *)(vtab),keep,STATUS_PTR))
 #define astSetVtab(object,vtab) \
 astINVOKE(V,astSetVtab_((AstObject *)object,(AstObjectVtab *)(vtab),STATUS_PTR))
 #define astSetID(this,id) astINVOKE(V,astSetID_(astCheckObject(this),id,STATUS_PTR))
@@ -72,6 +72,10 @@ f     The PointList class does not define any new routines beyond those
 *        Move methods astGetEnclosure and astSetEnclosure to Region class.
 *     8-JUL-2009 (DSB):
 *        In Transform, use "ptr2", not "ptr", if we are creating a mask.
+*     16-OCT-2026 (DSB):
+*        Over-ride astMask8<X> instead of astMask<X>. Also fix the
+*        calculation of the vectorised pixel index for multi-dimensional
+*        grids.
 *class--
 
 *  Implementation Deficiencies:
@@ -180,18 +184,18 @@ AstPointList *astPointListId_( void *, int, int, int, const double *, void *, co
 /* Prototypes for Private Member Functions. */
 /* ======================================== */
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
-static int MaskLD( AstRegion *, AstMapping *, int, int, const int[], const int ubnd[], long double [], long double, int * );
+static int64_t Mask8LD( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long double [], long double, int * );
 #endif
-static int MaskB( AstRegion *, AstMapping *, int, int, const int[], const int[], signed char[], signed char, int * );
-static int MaskD( AstRegion *, AstMapping *, int, int, const int[], const int[], double[], double, int * );
-static int MaskF( AstRegion *, AstMapping *, int, int, const int[], const int[], float[], float, int * );
-static int MaskI( AstRegion *, AstMapping *, int, int, const int[], const int[], int[], int, int * );
-static int MaskL( AstRegion *, AstMapping *, int, int, const int[], const int[], long int[], long int, int * );
-static int MaskS( AstRegion *, AstMapping *, int, int, const int[], const int[], short int[], short int, int * );
-static int MaskUB( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned char[], unsigned char, int * );
-static int MaskUI( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned int[], unsigned int, int * );
-static int MaskUL( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned long int[], unsigned long int, int * );
-static int MaskUS( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned short int[], unsigned short int, int * );
+static int64_t Mask8B( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], signed char[], signed char, int * );
+static int64_t Mask8D( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], double[], double, int * );
+static int64_t Mask8F( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], float[], float, int * );
+static int64_t Mask8I( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], int[], int, int * );
+static int64_t Mask8L( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long int[], long int, int * );
+static int64_t Mask8S( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], short int[], short int, int * );
+static int64_t Mask8UB( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned char[], unsigned char, int * );
+static int64_t Mask8UI( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned int[], unsigned int, int * );
+static int64_t Mask8UL( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned long int[], unsigned long int, int * );
+static int64_t Mask8US( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned short int[], unsigned short int, int * );
 
 static AstMapping *Simplify( AstMapping *, int * );
 static AstPointSet *RegBaseMesh( AstRegion *, int * );
@@ -631,18 +635,18 @@ void astInitPointListVtab_(  AstPointListVtab *vtab, const char *name,
    region->RegBasePick = RegBasePick;
    region->RegPins = RegPins;
    region->GetClosed = GetClosed;
-   region->MaskB = MaskB;
-   region->MaskD = MaskD;
-   region->MaskF = MaskF;
-   region->MaskI = MaskI;
-   region->MaskL = MaskL;
-   region->MaskS = MaskS;
-   region->MaskUB = MaskUB;
-   region->MaskUI = MaskUI;
-   region->MaskUL = MaskUL;
-   region->MaskUS = MaskUS;
+   region->Mask8B = Mask8B;
+   region->Mask8D = Mask8D;
+   region->Mask8F = Mask8F;
+   region->Mask8I = Mask8I;
+   region->Mask8L = Mask8L;
+   region->Mask8S = Mask8S;
+   region->Mask8UB = Mask8UB;
+   region->Mask8UI = Mask8UI;
+   region->Mask8UL = Mask8UL;
+   region->Mask8US = Mask8US;
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
-   region->MaskLD = MaskLD;
+   region->Mask8LD = Mask8LD;
 #endif
 
 /* Declare the class dump function. There is no copy constructor or
@@ -662,7 +666,7 @@ void astInitPointListVtab_(  AstPointListVtab *vtab, const char *name,
 
 /*
 *  Name:
-*     Mask<X>
+*     Mask8<X>
 
 *  Purpose:
 *     Mask a region of a data grid.
@@ -672,13 +676,14 @@ void astInitPointListVtab_(  AstPointListVtab *vtab, const char *name,
 
 *  Synopsis:
 *     #include "pointlist.h"
-*     int Mask<X>( AstRegion *this, AstMapping *map, int inside, int ndim,
-*                  const int lbnd[], const int ubnd[], <Xtype> in[],
-*                  <Xtype> val )
+*     int64_t Mask8<X>( AstRegion *this, AstMapping *map, int inside,
+*                       int ndim, const int64_t lbnd[],
+*                       const int64_t ubnd[], <Xtype> in[], <Xtype> val )
 
 *  Class Membership:
-*     PointList function method (replaces the astMask<X> methods
+*     PointList function method (replaces the astMask8<X> methods
 *     inherited from the parent Region class).
+*     These methods are also used by astMask<X>.
 
 *  Description:
 *     This is a set of functions for masking out regions within gridded data
@@ -790,10 +795,11 @@ void astInitPointListVtab_(  AstPointListVtab *vtab, const char *name,
 */
 /* Define a macro to implement the function for a specific data
    type. */
-#define MAKE_MASK(X,Xtype) \
-static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
-                    const int lbnd[], const int ubnd[], \
-                    Xtype in[], Xtype val, int *status ) { \
+#define MAKE_MASK8(X,Xtype) \
+static int64_t Mask8##X( AstRegion *this, AstMapping *map, int inside, \
+                         int ndim, const int64_t lbnd[], \
+                         const int64_t ubnd[], Xtype in[], Xtype val, \
+                         int *status ) { \
 \
 /* Local Variables: */ \
    AstFrame *grid_frame;         /* Pointer to Frame describing grid coords */ \
@@ -802,18 +808,19 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
    AstRegion *used_region;       /* Pointer to Region to be used by astResample */ \
    Xtype *temp;                  /* Pointer to temp storage for retained points */ \
    double **ptr2;                /* Pointer to pset2 data values */ \
-   int *iv;                      /* Pointer to index array */ \
    int i;                        /* Point index */ \
    int idim;                     /* Loop counter for coordinate dimensions */ \
-   int ii;                       /* Vectorised point index */ \
    int j;                        /* Axis index */ \
    int nax;                      /* Number of Region axes */ \
    int negated;                  /* Has Region been negated? */ \
    int nin;                      /* Number of Mapping input coordinates */ \
    int nout;                     /* Number of Mapping output coordinates */ \
    int npnt;                     /* Number of points in PointList */ \
-   int result;                   /* Result value to return */ \
-   int vlen;                     /* Length of vectorised array */ \
+   int64_t *iv;                  /* Pointer to index array */ \
+   int64_t ii;                   /* Vectorised point index */ \
+   int64_t ipix;                 /* Pixel index */ \
+   int64_t result;               /* Result value to return */ \
+   int64_t vlen;                 /* Length of vectorised array */ \
 \
 /* Initialise. */ \
    result = 0; \
@@ -879,9 +886,10 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
       for ( idim = 0; idim < ndim; idim++ ) { \
          if ( lbnd[ idim ] > ubnd[ idim ] ) { \
             astError( AST__GBDIN, "astMask"#X"(%s): Lower bound of " \
-                      "input grid (%d) exceeds corresponding upper bound " \
-                      "(%d).", status, astGetClass( this ), \
-                      lbnd[ idim ], ubnd[ idim ] ); \
+                      "input grid (%lld) exceeds corresponding upper bound " \
+                      "(%lld).", status, astGetClass( this ), \
+                      (long long int) lbnd[ idim ], \
+                      (long long int) ubnd[ idim ] ); \
             astError( AST__GBDIN, "Error in input dimension %d.", status, \
                       idim + 1 ); \
             break; \
@@ -897,7 +905,7 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
 \
 /* Allocate memory to hold the corresponding vector indices. */ \
    npnt = astGetNpoint( pset2 ); \
-   iv = astMalloc( sizeof(int)*(size_t) npnt ); \
+   iv = astMalloc( sizeof(int64_t)*(size_t) npnt ); \
    if( astOK ) { \
 \
 /* Convert the transformed GRID positions into integer indices into the \
@@ -907,8 +915,8 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
          vlen = 1; \
          ii = 0; \
          for( j = 0; j < ndim; j++ ) { \
-            ii += vlen*( (int)( ptr2[ j ][ i ] + 0.5 ) - lbnd[ j ] ); \
-            vlen *= ubnd[ i ] - lbnd[ i ] + 1; \
+            ii += vlen*( (int64_t)( ptr2[ j ][ i ] + 0.5 ) - lbnd[ j ] ); \
+            vlen *= ubnd[ j ] - lbnd[ j ] + 1; \
          }  \
          iv[ i ] = ii; \
       } \
@@ -927,7 +935,7 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
          temp = astMalloc( sizeof( Xtype )*(size_t)npnt ); \
          if( astOK ) { \
             for( i = 0; i < npnt; i++ ) temp[ i ] = in[ iv[ i ] ]; \
-            for( i = 0; i < vlen; i++ ) in[ i ] = val; \
+            for( ipix = 0; ipix < vlen; ipix++ ) in[ ipix ] = val; \
             for( i = 0; i < npnt; i++ ) in[ iv[ i ] ] = temp[ i ]; \
             result = vlen - npnt; \
          } \
@@ -950,21 +958,21 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
 /* Expand the above macro to generate a function for each required
    data type. */
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
-MAKE_MASK(LD,long double)
+MAKE_MASK8(LD,long double)
 #endif
-MAKE_MASK(D,double)
-MAKE_MASK(F,float)
-MAKE_MASK(L,long int)
-MAKE_MASK(UL,unsigned long int)
-MAKE_MASK(I,int)
-MAKE_MASK(UI,unsigned int)
-MAKE_MASK(S,short int)
-MAKE_MASK(US,unsigned short int)
-MAKE_MASK(B,signed char)
-MAKE_MASK(UB,unsigned char)
+MAKE_MASK8(D,double)
+MAKE_MASK8(F,float)
+MAKE_MASK8(L,long int)
+MAKE_MASK8(UL,unsigned long int)
+MAKE_MASK8(I,int)
+MAKE_MASK8(UI,unsigned int)
+MAKE_MASK8(S,short int)
+MAKE_MASK8(US,unsigned short int)
+MAKE_MASK8(B,signed char)
+MAKE_MASK8(UB,unsigned char)
 
 /* Undefine the macro. */
-#undef MAKE_MASK
+#undef MAKE_MASK8
 
 static int MapMerge( AstMapping *this, int where, int series, int *nmap,
                      AstMapping ***map_list, int **invert_list, int *status ) {
@@ -66,6 +66,11 @@
 *        Added astReplaceNan.
 *     2-OCT-2012 (DSB):
 *        Check for Infs as well as NaNs.
+*     16-OCT-2026 (DSB):
+*        Added astScratchPointSet and astRecyclePointSet, which allow
+*        temporary PointSets to be re-used without further memory
+*        allocation. astSetPoints and astSetSubPoints now re-use any
+*        existing array of pointers.
 */
 
 /* Module Macros. */
@@ -80,6 +85,10 @@
 #define REPLACE_NANS 1
 #define REPORT_NANS  2
 
+/* The largest values array (in bytes) that astRecyclePointSet retains
+   for re-use. */
+#define MXSPARE 1048576
+
 /*
 *
 *  Name:
@@ -501,7 +510,8 @@ static int (* parent_getobjsize)( AstObject *, int * );
 /* Define how to initialise thread-specific globals. */
 #define GLOBAL_inits \
    globals->Class_Init = 0; \
-   globals->GetAttrib_Buff[ 0 ] = 0;
+   globals->GetAttrib_Buff[ 0 ] = 0; \
+   globals->Nscratch = 0;
 
 /* Create the function that initialises global data for this module. */
 astMAKE_INITGLOBALS(PointSet)
@@ -510,6 +520,8 @@ astMAKE_INITGLOBALS(PointSet)
 #define class_init astGLOBAL(PointSet,Class_Init)
 #define class_vtab astGLOBAL(PointSet,Class_Vtab)
 #define getattrib_buff astGLOBAL(PointSet,GetAttrib_Buff)
+#define scratch astGLOBAL(PointSet,Scratch)
+#define nscratch astGLOBAL(PointSet,Nscratch)
 
 static pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER;
 #define LOCK_MUTEX1 pthread_mutex_lock( &mutex1 );
@@ -521,6 +533,10 @@ static pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER;
 
 static char getattrib_buff[ 101 ];
 
+/* The pool of scratch PointSets available for re-use. */
+static AstPointSet *scratch[ AST__MXSCRATCH ];
+static int nscratch = 0;
+
 
 /* Define the class virtual function table and its initialisation flag
    as static variables. */
@@ -543,6 +559,7 @@ AstPointSet *astPointSetId_( int, int, const char *, int *, ...);
 /* ======================================== */
 static const char *GetAttrib( AstObject *, const char *, int * );
 static double **GetPoints( AstPointSet *, int * );
+static double **PointerArray( AstPointSet *, int * );
 static int Equal( AstObject *, AstObject *, int * );
 static int GetNcoord( const AstPointSet *, int * );
 static int GetNpoint( const AstPointSet *, int * );
@@ -1288,6 +1305,8 @@ static int GetObjSize( AstObject *this_object, int *status ) {
    result += astTSizeOf( this->ptr );
    result += astTSizeOf( this->values );
    result += astTSizeOf( this->acc );
+   result += astTSizeOf( this->spare_ptr );
+   result += astTSizeOf( this->spare_values );
 
 /* If an error occurred, clear the result value. */
    if ( !astOK ) result = 0;
@@ -1450,9 +1469,16 @@ static double **GetPoints( AstPointSet *this, int *status ) {
 
 /* Determine the number of coordinate values to be stored and allocate memory
    to hold them, storing the pointer to this values array in the PointSet
-   structure. */
+   structure. Use any sufficiently large spare values array retained by
+   astRecyclePointSet instead, if available. */
       nval = this->npoint * this->ncoord;
-      this->values = (double *) astMalloc( sizeof( double ) * (size_t) nval );
+      if( this->spare_values && astSizeOf( this->spare_values ) >=
+                                sizeof( double ) * (size_t) nval ) {
+         this->values = this->spare_values;
+         this->spare_values = NULL;
+      } else {
+         this->values = (double *) astMalloc( sizeof( double ) * (size_t) nval );
+      }
 
 #ifdef DEBUG
       for( i = 0; i < nval; i++ ) this->values[ i ] = 0.0;
@@ -1461,8 +1487,7 @@ static double **GetPoints( AstPointSet *this, int *status ) {
 /* If OK, also allocate memory for the array of pointers into this values
    array, storing a pointer to this pointer array in the PointSet structure. */
       if ( astOK ) {
-         this->ptr = (double **) astMalloc( sizeof( double * )
-                                            * (size_t) this->ncoord );
+         (void) PointerArray( this, status );
 
 /* If OK, initialise the pointer array to point into the values array. */
          if ( astOK ) {
@@ -1803,6 +1828,168 @@ static void PermPoints( AstPointSet *this, int forward, const int perm[], int *s
    old = astFree( old );
 }
 
+static double **PointerArray( AstPointSet *this, int *status ) {
+/*
+*  Name:
+*     PointerArray
+
+*  Purpose:
+*     Ensure a PointSet has a pointer array of the required size.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "pointset.h"
+*     double **PointerArray( AstPointSet *this, int *status )
+
+*  Class Membership:
+*     PointSet member function.
+
+*  Description:
+*     This function returns a pointer to the array of coordinate pointers
+*     stored in the PointSet, first ensuring that it has room for "ncoord"
+*     elements. An existing array (or any spare array retained by
+*     astRecyclePointSet) is re-used if it is large enough. Otherwise a new
+*     array is allocated. The contents of the returned array are undefined.
+
+*  Parameters:
+*     this
+*        Pointer to the PointSet.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the array, or NULL if an error occurs.
+*/
+
+/* Local Variables: */
+   size_t size;                  /* Required size of array, in bytes */
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Find the required size. */
+   size = sizeof( double * ) * (size_t) this->ncoord;
+
+/* If there is no existing array, use any sufficiently large spare
+   array. */
+   if ( !this->ptr && this->spare_ptr &&
+        astSizeOf( this->spare_ptr ) >= size ) {
+      this->ptr = this->spare_ptr;
+      this->spare_ptr = NULL;
+   }
+
+/* If there is still no sufficiently large array, allocate a new one. */
+   if ( !this->ptr || astSizeOf( this->ptr ) < size ) {
+      this->ptr = (double **) astFree( (void *) this->ptr );
+      this->ptr = (double **) astMalloc( size );
+   }
+
+/* Return the array. */
+   return this->ptr;
+}
+
+AstPointSet *astRecyclePointSet_( AstPointSet *this, int *status ) {
+/*
+*+
+*  Name:
+*     astRecyclePointSet
+
+*  Purpose:
+*     Return a scratch PointSet to the pool of PointSets for re-use.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "pointset.h"
+*     AstPointSet *astRecyclePointSet( AstPointSet *this )
+
+*  Class Membership:
+*     PointSet method.
+
+*  Description:
+*     This function should be used in place of astAnnul to release a
+*     PointSet obtained using astScratchPointSet. If the PointSet is not
+*     otherwise in use, it is added to a pool maintained by the calling
+*     thread (together with its memory for coordinate values and
+*     pointers), so that a later call to astScratchPointSet can return it
+*     without allocating any memory. Otherwise, it is simply annulled.
+
+*  Parameters:
+*     this
+*        Pointer to the PointSet. May be NULL.
+
+*  Returned Value:
+*     A NULL pointer.
+
+*  Notes:
+*     - Any axis accuracies are cleared.
+*     - This function attempts to execute even if the global error status
+*     is set, in which case the PointSet is annulled rather than pooled.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+
+/* Check a PointSet was supplied. */
+   if ( !this ) return NULL;
+
+/* Get a pointer to the global data for the calling thread. */
+   astGET_GLOBALS(NULL);
+
+/* The PointSet can only be pooled if no other pointers to it exist and
+   the pool is not full. Pooling is disabled when memory debugging is
+   enabled, so that pooled PointSets are not reported as leaks by
+   astFlushMemory. */
+#ifdef MEM_DEBUG
+   if ( 0 ) {
+#else
+   if ( astOK && ( astGetRefCount( this ) == 1 ) &&
+        ( nscratch < AST__MXSCRATCH ) ) {
+#endif
+
+/* Keep the larger of the current and spare pointer arrays. */
+      if ( this->ptr ) {
+         if ( !this->spare_ptr ||
+              astSizeOf( this->ptr ) > astSizeOf( this->spare_ptr ) ) {
+            (void) astFree( (void *) this->spare_ptr );
+            this->spare_ptr = this->ptr;
+         } else {
+            (void) astFree( (void *) this->ptr );
+         }
+         this->ptr = NULL;
+      }
+
+/* Do the same for the values arrays, except that very large arrays are
+   not retained. */
+      if ( this->values ) {
+         if ( astSizeOf( this->values ) <= MXSPARE &&
+              ( !this->spare_values ||
+                astSizeOf( this->values ) > astSizeOf( this->spare_values ) ) ) {
+            (void) astFree( (void *) this->spare_values );
+            this->spare_values = this->values;
+         } else {
+            (void) astFree( (void *) this->values );
+         }
+         this->values = NULL;
+      }
+
+/* Clear any axis accuracies and add the PointSet to the pool. */
+      this->acc = astFree( this->acc );
+      scratch[ nscratch++ ] = this;
+
+/* Otherwise, annul the PointSet. */
+   } else {
+      (void) astAnnul( this );
+   }
+
+/* Return a NULL pointer. */
+   return NULL;
+}
+
 static int ReplaceNaN( AstPointSet *this, int *status ) {
 /*
 *+
@@ -1895,6 +2082,110 @@ static int ReplaceNaN( AstPointSet *this, int *status ) {
    return result;
 }
 
+AstPointSet *astScratchPointSet_( int npoint, int ncoord, double *data,
+                                  int dim, int *status ) {
+/*
+*+
+*  Name:
+*     astScratchPointSet
+
+*  Purpose:
+*     Obtain a temporary PointSet, re-using memory where possible.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "pointset.h"
+*     AstPointSet *astScratchPointSet( int npoint, int ncoord, double *data,
+*                                      int dim )
+
+*  Class Membership:
+*     PointSet method.
+
+*  Description:
+*     This function returns a PointSet with the requested numbers of
+*     points and coordinates, for temporary use within the calling
+*     function. If the calling thread has a PointSet in its pool of
+*     recycled PointSets (see astRecyclePointSet), it is re-used.
+*     Otherwise a new PointSet is created. Re-used PointSets also re-use
+*     their previous memory for coordinate values and pointers, if large
+*     enough. This means that a function that repeatedly obtains and then
+*     recycles scratch PointSets makes no heap allocations in the steady
+*     state.
+*
+*     Optionally, the returned PointSet may refer to coordinate values
+*     held in an external array (as if astSetPoints had been used). Such
+*     a PointSet provides a view of the caller's array, without copying
+*     it.
+
+*  Parameters:
+*     npoint
+*        The number of points in the PointSet (must be at least 1).
+*     ncoord
+*        The number of coordinate values associated with each point (must
+*        be at least 1).
+*     data
+*        If not NULL, a pointer to an external array holding the
+*        coordinate values. The values for coordinate "i" start at
+*        element "i*dim" of this array. If NULL, the PointSet is not
+*        associated with any coordinate values, and memory will be
+*        provided for them when astGetPoints is invoked (exactly as for a
+*        newly created PointSet).
+*     dim
+*        The number of array elements between the first values of
+*        successive coordinates in "data". Ignored if "data" is NULL.
+
+*  Returned Value:
+*     A pointer to the PointSet. It should be released using
+*     astRecyclePointSet when no longer needed.
+
+*  Notes:
+*     - A null pointer will be returned if this function is invoked with
+*     the global error status set, or if it should fail for any reason.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   AstPointSet *result;          /* Pointer to returned PointSet */
+   double **ptr;                 /* Pointer array */
+   int i;                        /* Loop counter for coordinates */
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Get a pointer to the global data for the calling thread. */
+   astGET_GLOBALS(NULL);
+
+/* If possible, take a PointSet from the pool and set its size, after
+   checking the size is valid. */
+   if ( nscratch > 0 && npoint > 0 && ncoord > 0 ) {
+      result = scratch[ --nscratch ];
+      scratch[ nscratch ] = NULL;
+      result->npoint = npoint;
+      result->ncoord = ncoord;
+
+/* Otherwise, create a new PointSet (this also validates the size). */
+   } else {
+      result = astPointSet( npoint, ncoord, "", status );
+   }
+
+/* If required, set up the pointers to the supplied data. */
+   if ( data && astOK ) {
+      ptr = PointerArray( result, status );
+      if ( astOK ) {
+         for ( i = 0; i < ncoord; i++ ) ptr[ i ] = data + i * dim;
+      }
+   }
+
+/* If an error occurred, annul the PointSet. */
+   if ( !astOK ) result = astAnnul( result );
+
+/* Return the result. */
+   return result;
+}
+
 static void SetAttrib( AstObject *this_object, const char *setting, int *status ) {
 /*
 *  Name:
@@ -2120,14 +2411,14 @@ static void SetPoints( AstPointSet *this, double **ptr, int *status ) {
 /* Free any memory previously allocated to store coordinate values. */
       this->values = (double *) astFree( (void *) this->values );
 
-/* If a new array of pointers has been provided, (re)allocate memory and store
-   a copy of the array in it, saving a pointer to this copy in the PointSet
-   structure. */
+/* If a new array of pointers has been provided, store a copy of the array
+   in the PointSet's own pointer array (re-using any existing array if it
+   is large enough). */
       if ( ptr ) {
-         this->ptr = (double **) astStore( (void *) this->ptr,
-                                           (const void *) ptr,
-                                           sizeof( double * )
-                                           * (size_t) this->ncoord );
+         if ( ptr != this->ptr && PointerArray( this, status ) ) {
+            (void) memcpy( (void *) this->ptr, (const void *) ptr,
+                           sizeof( double * ) * (size_t) this->ncoord );
+         }
 
 /* If no pointer array was provided, free the previous one (if any). */
       } else {
@@ -2234,11 +2525,15 @@ static void SetSubPoints( AstPointSet *point1, int point, int coord,
 /* Obtain a pointer for the coordinate values associated with the first
    PointSet (this will cause internal memory to be allocated if it is not
    yet associated with coordinate values). */
-      } else {
+      } else if ( point1 != point2 ) {
          ptr1 = astGetPoints( point1 );
 
-/* Allocate a temporary array to hold new pointer values. */
-         ptr2 = (double **) astMalloc( sizeof( double * ) * (size_t) ncoord2 );
+/* Free any internally allocated memory holding coordinate values for the
+   second PointSet (as astSetPoints would do), and obtain its array of
+   pointers, which can then be set directly without using a temporary
+   array. */
+         point2->values = (double *) astFree( (void *) point2->values );
+         ptr2 = PointerArray( point2, status );
 
 /* Initialise this pointer array to point at the required subset of coordinate
    values. */
@@ -2246,15 +2541,7 @@ static void SetSubPoints( AstPointSet *point1, int point, int coord,
             for ( i = 0; i < ncoord2; i++ ) {
                ptr2[ i ] = ptr1[ i + coord ] + point;
             }
-
-/* Associate the second PointSet with this new pointer array. This will free
-   any internally allocated memory and replace any existing coordinate value
-   association. */
-            astSetPoints( point2, ptr2 );
 	 }
-
-/* Free the temporary pointer arry. */
-         ptr2 = (double **) astFree( (void * ) ptr2 );
       }
    }
 }
@@ -2419,6 +2706,8 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    out->ptr = NULL;
    out->values = NULL;
    out->acc = NULL;
+   out->spare_ptr = NULL;
+   out->spare_values = NULL;
 
 /* Copy axis accuracies. */
    if( in->acc ){
@@ -2511,6 +2800,10 @@ static void Delete( AstObject *obj, int *status ) {
    this->ptr = (double **) astFree( (void *) this->ptr );
    this->values = (double *) astFree( (void *) this->values );
 
+/* Free any spare arrays retained by astRecyclePointSet. */
+   this->spare_ptr = (double **) astFree( (void *) this->spare_ptr );
+   this->spare_values = (double *) astFree( (void *) this->spare_values );
+
 /* Clear the remaining PointSet variables. */
    this->npoint = 0;
    this->ncoord = 0;
@@ -2926,6 +3219,8 @@ AstPointSet *astInitPointSet_( void *mem, size_t size, int init,
       new->ptr = NULL;
       new->values = NULL;
       new->acc = NULL;
+      new->spare_ptr = NULL;
+      new->spare_values = NULL;
 
 /* If an error occurred, clean up by deleting the new object. */
       if ( !astOK ) new = astDelete( new );
@@ -3055,6 +3350,8 @@ AstPointSet *astLoadPointSet_( void *mem, size_t size,
 /* Initialise the PointSet's data pointers. */
       new->ptr = NULL;
       new->values = NULL;
+      new->spare_ptr = NULL;
+      new->spare_values = NULL;
 
 /* Read input data. */
 /* ================ */
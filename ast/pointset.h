@@ -168,6 +168,8 @@
 *        Added protected astInitPointSetVtab method.
 *     2-NOV-2004 (DSB):
 *        Added PointAccuracy attribute.
+*     16-OCT-2026 (DSB):
+*        Added astScratchPointSet and astRecyclePointSet.
 *-
 */
 
@@ -485,6 +487,10 @@
 
 #define astISBAD(value) ( (value) == AST__BAD || !astISFINITE(value))
 
+/* The maximum number of scratch PointSets (see astScratchPointSet) that
+   each thread retains for re-use. */
+#define AST__MXSCRATCH 16
+
 #endif
 
 /* Define a dummy __attribute__ macro for use on non-GNU compilers. */
@@ -509,6 +515,8 @@ typedef struct AstPointSet {
    int ncoord;                   /* Number of coordinate values per point */
    int npoint;                   /* Number of points */
    double *acc;                  /* Axis accuracies */
+   double **spare_ptr;           /* Unused pointer array kept for re-use */
+   double *spare_values;         /* Unused values array kept for re-use */
 } AstPointSet;
 
 /* Virtual function table. */
@@ -551,6 +559,8 @@ typedef struct AstPointSetGlobals {
    AstPointSetVtab Class_Vtab;
    int Class_Init;
    char GetAttrib_Buff[ 101 ];
+   AstPointSet *Scratch[ AST__MXSCRATCH ];
+   int Nscratch;
 } AstPointSetGlobals;
 
 #endif
@@ -614,6 +624,9 @@ void astSetPointAccuracy_( AstPointSet *, int, double, int * );
 double astCheckNaN_( double );
 float astCheckNaNF_( float );
 
+AstPointSet *astScratchPointSet_( int, int, double *, int, int * );
+AstPointSet *astRecyclePointSet_( AstPointSet *, int * );
+
 #endif
 
 /* Function interfaces. */
@@ -697,6 +710,11 @@ astINVOKE(V,astTestPointAccuracy_(astCheckPointSet(this),axis,STATUS_PTR))
 #define astCheckNaNF(value) astCheckNaNF_(value)
 #define astCheckNaN(value) astCheckNaN_(value)
 
+#define astScratchPointSet(npoint,ncoord,data,dim) \
+astScratchPointSet_(npoint,ncoord,data,dim,STATUS_PTR)
+#define astRecyclePointSet(this) \
+astRecyclePointSet_(astCheckPointSet(this),STATUS_PTR)
+
 
 #endif
 #endif
@@ -106,6 +106,10 @@ f     - AST_OUTLINE<X>: Create a Polygon outlining values in a pixel array
 *        Added astConvex<X>.
 *     25-FEB-2014 (DSB):
 *        Added attribute SimpVertices.
+*     16-OCT-2026 (DSB):
+*        Cache a grid of edges for Polygons with many vertices defined
+*        in a simple Frame, so that Transform only needs to check the
+*        edges near the line joining each test point to the inside point.
 *class--
 */
 
@@ -149,6 +153,10 @@ f     - AST_OUTLINE<X>: Create a Polygon outlining values in a pixel array
 #define OUT     2
 #define ON      3
 
+/* The minimum number of vertices for which an edge grid is created.
+   Smaller Polygons are quicker to test by checking every edge. */
+#define GRID_MINV 32
+
 /* Include files. */
 /* ============== */
 /* Interface definitions. */
@@ -435,11 +443,14 @@ static int IntCmp( const void *, const void * );
 static int RegPins( AstRegion *, AstPointSet *, AstRegion *, int **, int * );
 static int RegTrace( AstRegion *, int, double *, double **, int * );
 static void Cache( AstPolygon *, int * );
+static void CacheGrid( AstPolygon *, AstFrame *, int * );
 static void Copy( const AstObject *, AstObject *, int * );
 static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void EnsureInside( AstPolygon *, int * );
 static void FindMax( Segment *, AstFrame *, double *, double *, int, int, int * );
+static void GridRange( double, double, double, double, int, int *, int * );
+static void GridRows( AstPolygon *, const double[ 2 ], const double[ 2 ], int, int *, int * );
 static void RegBaseBox( AstRegion *this, double *, double *, int * );
 static void ResetCache( AstRegion *this, int * );
 static void SetPointSet( AstPolygon *, AstPointSet *, int * );
@@ -674,6 +685,10 @@ static void Cache( AstPolygon *this, int *status ){
          } else {
             this->acw = 1;
          }
+
+/* Create a grid that records the edges passing close to each cell, if
+   appropriate. */
+         CacheGrid( this, frm, status );
       }
 
 /* Free resources */
@@ -684,6 +699,182 @@ static void Cache( AstPolygon *this, int *status ){
    }
 }
 
+static void CacheGrid( AstPolygon *this, AstFrame *frm, int *status ){
+/*
+*  Name:
+*     CacheGrid
+
+*  Purpose:
+*     Create a grid recording the edges that pass through each grid cell.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "polygon.h"
+*     void CacheGrid( AstPolygon *this, AstFrame *frm, int *status )
+
+*  Class Membership:
+*     Polygon member function
+
+*  Description:
+*     This function divides the bounding box of the Polygon in its base
+*     Frame into a regular grid of roughly square cells, about one cell
+*     per vertex, and records the indices of the edges that pass through,
+*     or close to, each cell. It is used by the Transform function to
+*     avoid checking every edge for each test point. The test is
+*     conservative - an edge is recorded in every cell that contains any
+*     point within a small margin of the edge.
+*
+*     No grid is created if the Polygon has too few vertices for the grid
+*     to be worthwhile, or if the base Frame is not a simple Frame (in
+*     which case edges may not be straight lines in the base Frame
+*     coordinates, e.g. the geodesics in a SkyFrame).
+
+*  Parameters:
+*     this
+*        Pointer to the Polygon. The edge information must already have
+*        been cached.
+*     frm
+*        Pointer to the base Frame of the Polygon.
+*     status
+*        Pointer to the inherited status variable.
+
+*/
+
+/* Local Variables: */
+   AstLineDef *edge;    /* Pointer to current edge */
+   double height;       /* Height of bounding box */
+   double hi[ 2 ];      /* Upper bounds of bounding box */
+   double lo[ 2 ];      /* Lower bounds of bounding box */
+   double width;        /* Width of bounding box */
+   int *next;           /* Index in grid at which to store next edge */
+   int i;               /* Edge index */
+   int icell;           /* Cell index */
+   int ix;              /* Grid column index */
+   int ixhi;            /* Highest column touched by edge */
+   int ixlo;            /* Lowest column touched by edge */
+   int iy;              /* Grid row index */
+   int iyhi;            /* Highest row touched by edge */
+   int iylo;            /* Lowest row touched by edge */
+   int ncell;           /* Number of grid cells */
+   int nv;              /* Number of vertices in Polygon */
+   size_t total;        /* Total number of edge references in grid */
+
+/* Free any existing grid. */
+   this->grid = astFree( this->grid );
+   this->gridstart = astFree( this->gridstart );
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Check a grid is worthwhile and can be used. */
+   nv = astGetNpoint( ((AstRegion *) this)->points );
+   if( nv < GRID_MINV || strcmp( astGetClass( frm ), "Frame" ) ) return;
+
+/* Find the bounding box of the vertices. Do not create a grid if any
+   vertices are bad. */
+   lo[ 0 ] = lo[ 1 ] = DBL_MAX;
+   hi[ 0 ] = hi[ 1 ] = -DBL_MAX;
+   for( i = 0; i < nv; i++ ) {
+      edge = this->edges[ i ];
+      if( !edge ) return;
+      lo[ 0 ] = MIN( lo[ 0 ], edge->start[ 0 ] );
+      lo[ 1 ] = MIN( lo[ 1 ], edge->start[ 1 ] );
+      hi[ 0 ] = MAX( hi[ 0 ], edge->start[ 0 ] );
+      hi[ 1 ] = MAX( hi[ 1 ], edge->start[ 1 ] );
+   }
+   width = hi[ 0 ] - lo[ 0 ];
+   height = hi[ 1 ] - lo[ 1 ];
+   if( !( width > 0.0 && height > 0.0 && width < DBL_MAX &&
+          height < DBL_MAX ) ) return;
+
+/* Edges are recorded in all cells that are within "gridtol" of the edge.
+   This allows for the tolerance used by astLineContains (1.0E-7 of the
+   edge length) and for rounding errors. The grid covers the bounding
+   box plus twice this margin on each side, so that every point close
+   to an edge falls within the grid. */
+   this->gridtol = 1.0E-6*( width + height );
+   width += 4.0*this->gridtol;
+   height += 4.0*this->gridtol;
+   this->gridorg[ 0 ] = lo[ 0 ] - 2.0*this->gridtol;
+   this->gridorg[ 1 ] = lo[ 1 ] - 2.0*this->gridtol;
+
+/* Choose the number of columns and rows so that there are about as many
+   cells as vertices, with each cell roughly square. */
+   this->gridnx = (int)( sqrt( nv*width/height ) + 0.5 );
+   if( this->gridnx < 1 ) this->gridnx = 1;
+   if( this->gridnx > nv ) this->gridnx = nv;
+   this->gridny = (int)( ( (double) nv )/this->gridnx + 0.5 );
+   if( this->gridny < 1 ) this->gridny = 1;
+   this->gridcell[ 0 ] = width/this->gridnx;
+   this->gridcell[ 1 ] = height/this->gridny;
+   ncell = this->gridnx*this->gridny;
+
+/* Count the number of edges touching each cell. The count for cell "i" is
+   stored in element "i+1" of the "gridstart" array. */
+   this->gridstart = astCalloc( ncell + 1, sizeof( int ) );
+   next = astMalloc( sizeof( int )*(size_t) ncell );
+   if( astOK ) {
+      total = 0;
+      for( i = 0; i < nv && total <= INT_MAX; i++ ) {
+         edge = this->edges[ i ];
+         GridRange( MIN( edge->start[ 0 ], edge->end[ 0 ] ) - this->gridtol,
+                    MAX( edge->start[ 0 ], edge->end[ 0 ] ) + this->gridtol,
+                    this->gridorg[ 0 ], this->gridcell[ 0 ], this->gridnx,
+                    &ixlo, &ixhi );
+         for( ix = ixlo; ix <= ixhi; ix++ ) {
+            GridRows( this, edge->start, edge->end, ix, &iylo, &iyhi );
+            for( iy = iylo; iy <= iyhi; iy++ ) {
+               this->gridstart[ iy*this->gridnx + ix + 1 ]++;
+               total++;
+            }
+         }
+      }
+
+/* Give up if the grid would be too big. */
+      if( total > INT_MAX ) {
+         this->gridstart = astFree( this->gridstart );
+
+/* Otherwise, convert the counts into the index of the first edge for each
+   cell, and allocate the array holding the edge indices. */
+      } else {
+         for( icell = 0; icell < ncell; icell++ ) {
+            next[ icell ] = this->gridstart[ icell ];
+            this->gridstart[ icell + 1 ] += this->gridstart[ icell ];
+         }
+         this->grid = astMalloc( sizeof( int )*total );
+
+/* Store the index of each edge in each cell that it touches. */
+         if( astOK ) {
+            for( i = 0; i < nv; i++ ) {
+               edge = this->edges[ i ];
+               GridRange( MIN( edge->start[ 0 ], edge->end[ 0 ] ) - this->gridtol,
+                          MAX( edge->start[ 0 ], edge->end[ 0 ] ) + this->gridtol,
+                          this->gridorg[ 0 ], this->gridcell[ 0 ], this->gridnx,
+                          &ixlo, &ixhi );
+               for( ix = ixlo; ix <= ixhi; ix++ ) {
+                  GridRows( this, edge->start, edge->end, ix, &iylo, &iyhi );
+                  for( iy = iylo; iy <= iyhi; iy++ ) {
+                     icell = iy*this->gridnx + ix;
+                     this->grid[ next[ icell ]++ ] = i;
+                  }
+               }
+            }
+         }
+      }
+   }
+
+/* Free resources. */
+   next = astFree( next );
+
+/* Do not use the grid if anything went wrong. */
+   if( !astOK || !this->grid ) {
+      this->grid = astFree( this->grid );
+      this->gridstart = astFree( this->gridstart );
+   }
+}
+
 static void ClearAttrib( AstObject *this_object, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -2714,6 +2905,143 @@ static int GetBounded( AstRegion *this, int *status ) {
    return result;
 }
 
+static void GridRange( double lo, double hi, double org, double cell,
+                       int n, int *ilo, int *ihi ){
+/*
+*  Name:
+*     GridRange
+
+*  Purpose:
+*     Find the range of grid cells spanned by a range of axis values.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "polygon.h"
+*     void GridRange( double lo, double hi, double org, double cell,
+*                     int n, int *ilo, int *ihi )
+
+*  Class Membership:
+*     Polygon member function
+
+*  Description:
+*     This function returns the indices of the first and last cells on
+*     one axis of the edge grid that overlap a given range of axis values.
+*     Non-finite limits are treated as extending to the edge of the grid.
+
+*  Parameters:
+*     lo
+*        The lower limit of the axis range.
+*     hi
+*        The upper limit of the axis range.
+*     org
+*        The axis value at the lower edge of the first cell.
+*     cell
+*        The width of each cell on the axis.
+*     n
+*        The number of cells on the axis.
+*     ilo
+*        Returned holding the index of the first cell overlapping the
+*        range.
+*     ihi
+*        Returned holding the index of the last cell overlapping the
+*        range. This will be less than "*ilo" if the range does not
+*        overlap the grid.
+
+*/
+
+/* Convert the limits to (fractional) cell indices. */
+   lo = ( lo - org )/cell;
+   hi = ( hi - org )/cell;
+
+/* Truncate them to integer indices, taking care not to convert values
+   that are out of range (including NaNs). */
+   *ilo = ( lo > 0.0 ) ? ( ( lo < n ) ? (int) lo : n ) : 0;
+   *ihi = ( hi < n ) ? ( ( hi >= 0.0 ) ? (int) hi : -1 ) : n - 1;
+}
+
+static void GridRows( AstPolygon *this, const double start[ 2 ],
+                      const double end[ 2 ], int ix, int *iylo, int *iyhi ){
+/*
+*  Name:
+*     GridRows
+
+*  Purpose:
+*     Find the range of rows in a column of the edge grid touched by a line.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "polygon.h"
+*     void GridRows( AstPolygon *this, const double start[ 2 ],
+*                    const double end[ 2 ], int ix, int *iylo, int *iyhi )
+
+*  Class Membership:
+*     Polygon member function
+
+*  Description:
+*     This function returns the indices of the first and last rows of
+*     cells within a given column of the Polygon's edge grid that contain
+*     any point within the grid margin of a straight line segment.
+
+*  Parameters:
+*     this
+*        Pointer to the Polygon.
+*     start
+*        The base Frame coordinates at the start of the line.
+*     end
+*        The base Frame coordinates at the end of the line.
+*     ix
+*        The index of the grid column.
+*     iylo
+*        Returned holding the index of the first row touched by the line.
+*     iyhi
+*        Returned holding the index of the last row touched by the line.
+*        This will be less than "*iylo" if the line does not touch any
+*        cells in the column.
+
+*/
+
+/* Local Variables: */
+   double xa;           /* Lower X limit of column */
+   double xb;           /* Upper X limit of column */
+   double xmax;         /* Upper X limit of line */
+   double xmin;         /* Lower X limit of line */
+   double ya;           /* Y value on line at "xa" */
+   double yb;           /* Y value on line at "xb" */
+
+/* Find the X range covered by the column, extended by the margin, and
+   restrict it to the X range covered by the line. */
+   xa = this->gridorg[ 0 ] + ix*this->gridcell[ 0 ] - this->gridtol;
+   xb = xa + this->gridcell[ 0 ] + 2.0*this->gridtol;
+   xmin = MIN( start[ 0 ], end[ 0 ] );
+   xmax = MAX( start[ 0 ], end[ 0 ] );
+   if( xa < xmin ) xa = xmin;
+   if( xa > xmax ) xa = xmax;
+   if( xb < xmin ) xb = xmin;
+   if( xb > xmax ) xb = xmax;
+
+/* Find the Y values on the line at these two X values. Interpolate from
+   the start of the line, which is always within the grid when testing a
+   point. */
+   if( end[ 0 ] != start[ 0 ] ) {
+      ya = start[ 1 ] + ( xa - start[ 0 ] )*( end[ 1 ] - start[ 1 ] )/
+                                            ( end[ 0 ] - start[ 0 ] );
+      yb = start[ 1 ] + ( xb - start[ 0 ] )*( end[ 1 ] - start[ 1 ] )/
+                                            ( end[ 0 ] - start[ 0 ] );
+   } else {
+      ya = start[ 1 ];
+      yb = end[ 1 ];
+   }
+
+/* Return the rows covering this Y range, extended by the margin. */
+   GridRange( MIN( ya, yb ) - this->gridtol, MAX( ya, yb ) + this->gridtol,
+              this->gridorg[ 1 ], this->gridcell[ 1 ], this->gridny,
+              iylo, iyhi );
+}
+
 void astInitPolygonVtab_(  AstPolygonVtab *vtab, const char *name, int *status ) {
 /*
 *+
@@ -4935,8 +5263,13 @@ static void ResetCache( AstRegion *this_region, int *status ){
             this->edges[ i ] = astFree( this->edges[ i ] );
          }
          this->edges = astFree( this->edges );
+         this->startsat = astFree( this->startsat );
       }
 
+/* Free the edge grid. */
+      this->grid = astFree( this->grid );
+      this->gridstart = astFree( this->gridstart );
+
 /* Clear the cache of the parent class. */
       (*parent_resetcache)( this_region, status );
    }
@@ -6004,10 +6337,19 @@ static AstPointSet *Transform( AstMapping *this_mapping, AstPointSet *in,
    double *px;                   /* Pointer to array of first axis values */
    double *py;                   /* Pointer to array of second axis values */
    double p[ 2 ];                /* Current test position */
+   int *visited;                 /* Last point tested against each edge */
    int closed;                   /* Is the boundary part of the Region? */
    int i;                        /* Edge index */
+   int icell;                    /* Index of edge grid cell */
    int icoord;                   /* Coordinate index */
    int in_region;                /* Is the point inside the Region? */
+   int ix;                       /* Edge grid column index */
+   int ixhi;                     /* Last edge grid column to check */
+   int ixlo;                     /* First edge grid column to check */
+   int iy;                       /* Edge grid row index */
+   int iyhi;                     /* Last edge grid row to check */
+   int iylo;                     /* First edge grid row to check */
+   int j;                        /* Index into list of edges in a cell */
    int ncoord_out;               /* No. of current Frame axes */
    int ncross;                   /* Number of crossings */
    int neg;                      /* Has the Region been negated? */
@@ -6062,6 +6404,7 @@ static AstPointSet *Transform( AstMapping *this_mapping, AstPointSet *in,
 
 /* Perform coordinate arithmetic. */
 /* ------------------------------ */
+   visited = NULL;
    if ( astOK ) {
       px = ptr_in[ 0 ];
       py = ptr_in[ 1 ];
@@ -6078,8 +6421,17 @@ static AstPointSet *Transform( AstMapping *this_mapping, AstPointSet *in,
    the Polygon boundary. Initialially it is unknown. */
          } else {
 
-/* Ensure cached information is available.*/
+/* Ensure cached information is available. If the Polygon has an edge
+   grid, also ensure we have an array in which to record the last point
+   tested against each edge, so that edges that touch several grid cells
+   are only tested once for each point. */
             Cache( this, status );
+            if( this->grid && !visited ) {
+               visited = astMalloc( sizeof( int )*(size_t) nv );
+               if( visited ) {
+                  for( i = 0; i < nv; i++ ) visited[ i ] = -1;
+               }
+            }
 
 /* Create a definition of the line from a point which is inside the
    polygon to the supplied point. This is a structure which includes
@@ -6094,21 +6446,54 @@ static AstPointSet *Transform( AstMapping *this_mapping, AstPointSet *in,
             ncross = 0;
             pos = UNKNOWN;
 
-/* Loop rouind all edges of the polygon. */
-            for( i = 0; i < nv; i++ ) {
-               b = this->edges[ i ];
+/* If the polygon has an edge grid, the only edges that can contain the
+   test point or cross the line are those that touch the grid cells
+   touched by the line. So loop round these cells, checking each edge in
+   them that has not already been checked for the current point. The
+   checks are the same as those used below when there is no grid. */
+            if( this->grid && visited ) {
+               GridRange( MIN( this->in[ 0 ], p[ 0 ] ) - this->gridtol,
+                          MAX( this->in[ 0 ], p[ 0 ] ) + this->gridtol,
+                          this->gridorg[ 0 ], this->gridcell[ 0 ],
+                          this->gridnx, &ixlo, &ixhi );
+               for( ix = ixlo; ix <= ixhi && pos == UNKNOWN; ix++ ) {
+                  GridRows( this, this->in, p, ix, &iylo, &iyhi );
+                  for( iy = iylo; iy <= iyhi && pos == UNKNOWN; iy++ ) {
+                     icell = iy*this->gridnx + ix;
+                     for( j = this->gridstart[ icell ];
+                          j < this->gridstart[ icell + 1 ]; j++ ) {
+                        i = this->grid[ j ];
+                        if( visited[ i ] != point ) {
+                           visited[ i ] = point;
+                           b = this->edges[ i ];
+                           if( astLineContains( frm, b, 0, p ) ) {
+                              pos = ON;
+                              break;
+                           } else if( astLineCrossing( frm, b, a, NULL ) ) {
+                              ncross++;
+                           }
+                        }
+                     }
+                  }
+               }
+
+/* Otherwise, loop round all edges of the polygon. */
+            } else {
+               for( i = 0; i < nv; i++ ) {
+                  b = this->edges[ i ];
 
 /* If this point is on the current edge, then we need do no more checks
    since we know it is either inside or outside the polygon (depending on
    whether the polygon is closed or not). */
-               if( astLineContains( frm, b, 0, p ) ) {
-                  pos = ON;
-                  break;
+                  if( astLineContains( frm, b, 0, p ) ) {
+                     pos = ON;
+                     break;
 
 /* Otherwise, see if the two lines cross within their extent. If so,
    increment the number of crossings. */
-               } else if( astLineCrossing( frm, b, a, NULL ) ) {
-                  ncross++;
+                  } else if( astLineCrossing( frm, b, a, NULL ) ) {
+                     ncross++;
+                  }
                }
             }
 
@@ -6156,6 +6541,7 @@ static AstPointSet *Transform( AstMapping *this_mapping, AstPointSet *in,
    }
 
 /* Free resources */
+   visited = astFree( visited );
    in_base = astAnnul( in_base );
    frm = astAnnul( frm );
 
@@ -6259,6 +6645,8 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    the output Polygon. */
    out->edges = NULL;
    out->startsat = NULL;
+   out->grid = NULL;
+   out->gridstart = NULL;
 
 /* Indicate cached information needs nre-calculating. */
    astResetCache( (AstPolygon *) out );
@@ -6328,6 +6716,8 @@ static void Delete( AstObject *obj, int *status ) {
       this->startsat = astFree( this->startsat );
 
    }
+   this->grid = astFree( this->grid );
+   this->gridstart = astFree( this->gridstart );
 }
 
 /* Dump function. */
@@ -6853,6 +7243,8 @@ AstPolygon *astInitPolygon_( void *mem, size_t size, int init, AstPolygonVtab *v
          new->simp_vertices = -INT_MAX;
          new->edges = NULL;
          new->startsat = NULL;
+         new->grid = NULL;
+         new->gridstart = NULL;
          new->totlen = 0.0;
          new->acw = 1;
          new->stale = 1;
@@ -7013,6 +7405,8 @@ AstPolygon *astLoadPolygon_( void *mem, size_t size, AstPolygonVtab *vtab,
       new->ubnd[ 1 ] = AST__BAD;
       new->edges = NULL;
       new->startsat = NULL;
+      new->grid = NULL;
+      new->gridstart = NULL;
       new->totlen = 0.0;
       new->acw = 1;
       new->stale = 1;
@@ -59,6 +59,8 @@
 *  History:
 *     26-OCT-2004 (DSB):
 *        Original version.
+*     16-OCT-2026 (DSB):
+*        Added components describing the edge grid.
 *-
 */
 
@@ -118,6 +120,13 @@ typedef struct AstPolygon {
    int acw;                /* Are vertices stored in anti-clockwise order? */
    int stale;              /* Is cached information stale? */
    int simp_vertices;      /* Simplify by transforming vertices? */
+   int *grid;              /* Indices of the edges touching each grid cell */
+   int *gridstart;         /* Index in "grid" of first edge for each cell */
+   int gridnx;             /* Number of grid columns */
+   int gridny;             /* Number of grid rows */
+   double gridorg[2];      /* Base Frame coords at lower corner of grid */
+   double gridcell[2];     /* Base Frame size of each grid cell */
+   double gridtol;         /* Margin around edges when assigning cells */
 } AstPolygon;
 
 /* Virtual function table. */
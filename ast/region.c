@@ -221,6 +221,23 @@ f     - AST_SHOWMESH: Display a mesh of points on the surface of a Region
 *        Fix bug masking regions that have no overlap with the supplied array.
 *     17-APR-2015 (DSB):
 *        Added Centre.
+*     16-OCT-2026 (DSB):
+*        Retain only the inherited typed attribute access functions for
+*        attributes that are not forwarded to the encapsulated Frame.
+*     16-OCT-2026 (DSB):
+*        Use a lattice of pixel rows and columns to find the uniform
+*        parts of the pixel grid in astMask<X>, so that only pixels close
+*        to the boundary of a 2-dimensional Region need to be tested
+*        individually.
+*     16-OCT-2026 (DSB):
+*        Added astMask8<X>, which accepts 64-bit grid bounds and returns
+*        a 64-bit count, so that grids containing more than INT_MAX
+*        pixels can be masked.
+*     16-OCT-2026 (DSB):
+*        Over-ride the astMapSplit method inherited from the Frame class,
+*        which ignored the Region. This caused astResample<X> to resample
+*        a Region one axis at a time as if it were a UnitMap, so that
+*        astMask<X> failed to mask Regions too thin to use MaskFast.
 *class--
 
 *  Implementation Notes:
@@ -806,6 +823,7 @@ static int Test##attribute( AstFrame *this_frame, int axis, int *status ) { \
 #include "ellipse.h"             /* Elliptical regions */
 #include "pointset.h"            /* Sets of points */
 #include "globals.h"             /* Thread-safe global data access */
+#include "threads.h"             /* Pool of worker threads */
 
 /* Error code definitions. */
 /* ----------------------- */
@@ -822,6 +840,41 @@ static int Test##attribute( AstFrame *this_frame, int axis, int *status ) { \
 #include <stdlib.h>
 #include <math.h>
 
+/* Macros. */
+/* ======= */
+/* The spacing, in pixels, of the lattice of rows and columns used by
+   MaskFast. */
+#define MASK_CELL 32
+
+/* Type Definitions. */
+/* ================= */
+/* The type of a function that assigns a value to selected elements of
+   one row of a data array (see MaskFast). */
+typedef int (MaskFillFun)( void *, size_t, const char *, int, const void * );
+
+/* Structure holding the information shared by the tasks performed by
+   MaskFast. The box of pixels being masked is divided into cells by a
+   lattice of complete pixel rows and columns. */
+typedef struct MaskJob {
+   AstRegion **regs;             /* Region to use within each worker */
+   MaskFillFun *fill;            /* Function that assigns "val" */
+   char *edge;                   /* Does each cell contain a mesh point? */
+   char *hstate;                 /* Pixel states along each lattice row */
+   char *vstate;                 /* Pixel states along each lattice column */
+   const void *val;              /* Pointer to value to assign */
+   int *xl;                      /* X at each lattice column */
+   int *yl;                      /* Y at each lattice row */
+   int lbnd[ 2 ];                /* Lower bounds of data array */
+   int lbndg[ 2 ];               /* Lower bounds of box */
+   int ncx;                      /* Number of cells along X */
+   int ncy;                      /* Number of cells along Y */
+   int nx;                       /* Number of pixels along X in box */
+   int ny;                       /* Number of pixels along Y in box */
+   int xdim;                     /* Number of pixels along X in data array */
+   int64_t *nset;                /* No. of pixels assigned in each band */
+   void *out;                    /* Data array */
+} MaskJob;
+
 /* Module Variables. */
 /* ================= */
 
@@ -872,18 +925,36 @@ static int class_init = 0;       /* Virtual function table initialised? */
 /* Prototypes for Private Member Functions. */
 /* ======================================== */
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
-static int MaskLD( AstRegion *, AstMapping *, int, int, const int[], const int ubnd[], long double [], long double, int * );
+static int64_t Mask8LD( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long double [], long double, int * );
+#endif
+static int64_t Mask8B( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], signed char[], signed char, int * );
+static int64_t Mask8D( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], double[], double, int * );
+static int64_t Mask8F( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], float[], float, int * );
+static int64_t Mask8I( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], int[], int, int * );
+static int64_t Mask8L( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long int[], long int, int * );
+static int64_t Mask8S( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], short int[], short int, int * );
+static int64_t Mask8UB( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned char[], unsigned char, int * );
+static int64_t Mask8UI( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned int[], unsigned int, int * );
+static int64_t Mask8UL( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned long int[], unsigned long int, int * );
+static int64_t Mask8US( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned short int[], unsigned short int, int * );
+
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+static int MaskFillLD( void *, size_t, const char *, int, const void * );
 #endif
-static int MaskB( AstRegion *, AstMapping *, int, int, const int[], const int[], signed char[], signed char, int * );
-static int MaskD( AstRegion *, AstMapping *, int, int, const int[], const int[], double[], double, int * );
-static int MaskF( AstRegion *, AstMapping *, int, int, const int[], const int[], float[], float, int * );
-static int MaskI( AstRegion *, AstMapping *, int, int, const int[], const int[], int[], int, int * );
-static int MaskL( AstRegion *, AstMapping *, int, int, const int[], const int[], long int[], long int, int * );
-static int MaskS( AstRegion *, AstMapping *, int, int, const int[], const int[], short int[], short int, int * );
-static int MaskUB( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned char[], unsigned char, int * );
-static int MaskUI( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned int[], unsigned int, int * );
-static int MaskUL( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned long int[], unsigned long int, int * );
-static int MaskUS( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned short int[], unsigned short int, int * );
+static int MaskFillB( void *, size_t, const char *, int, const void * );
+static int MaskFillD( void *, size_t, const char *, int, const void * );
+static int MaskFillF( void *, size_t, const char *, int, const void * );
+static int MaskFillI( void *, size_t, const char *, int, const void * );
+static int MaskFillL( void *, size_t, const char *, int, const void * );
+static int MaskFillS( void *, size_t, const char *, int, const void * );
+static int MaskFillUB( void *, size_t, const char *, int, const void * );
+static int MaskFillUI( void *, size_t, const char *, int, const void * );
+static int MaskFillUL( void *, size_t, const char *, int, const void * );
+static int MaskFillUS( void *, size_t, const char *, int, const void * );
+static int64_t MaskFast( AstRegion *, const int[], const int[], const int[], const int[], int, void *, MaskFillFun *, const void *, int * );
+static void MaskBandTask( void *, int, int, int * );
+static void MaskLineTask( void *, int, int, int * );
+static void MaskTest( AstRegion *, int, const double *, const double *, char *, int * );
 
 static AstAxis *GetAxis( AstFrame *, int, int * );
 static AstFrame *GetRegionFrame( AstRegion *, int * );
@@ -928,6 +999,7 @@ static double Distance( AstFrame *, const double[], const double[], int * );
 static double Centre( AstFrame *, int, double, double, int * );
 static double Gap( AstFrame *, int, double, int *, int * );
 static double Offset2( AstFrame *, const double[2], double, double, double[2], int * );
+static int *MapSplit( AstMapping *, int, const int *, AstMapping **, int * );
 static int Equal( AstObject *, AstObject *, int * );
 static int GetNaxes( AstFrame *, int * );
 static int GetObjSize( AstObject *, int * );
@@ -4507,18 +4579,18 @@ void astInitRegionVtab_(  AstRegionVtab *vtab, const char *name, int *status ) {
    vtab->BTransform = BTransform;
    vtab->GetRegFS = GetRegFS;
    vtab->SetRegFS = SetRegFS;
-   vtab->MaskB = MaskB;
-   vtab->MaskD = MaskD;
-   vtab->MaskF = MaskF;
-   vtab->MaskI = MaskI;
-   vtab->MaskL = MaskL;
-   vtab->MaskS = MaskS;
-   vtab->MaskUB = MaskUB;
-   vtab->MaskUI = MaskUI;
-   vtab->MaskUL = MaskUL;
-   vtab->MaskUS = MaskUS;
+   vtab->Mask8B = Mask8B;
+   vtab->Mask8D = Mask8D;
+   vtab->Mask8F = Mask8F;
+   vtab->Mask8I = Mask8I;
+   vtab->Mask8L = Mask8L;
+   vtab->Mask8S = Mask8S;
+   vtab->Mask8UB = Mask8UB;
+   vtab->Mask8UI = Mask8UI;
+   vtab->Mask8UL = Mask8UL;
+   vtab->Mask8US = Mask8US;
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
-   vtab->MaskLD = MaskLD;
+   vtab->Mask8LD = Mask8LD;
 #endif
 
 /* Save the inherited pointers to methods that will be extended, and store
@@ -4546,6 +4618,7 @@ void astInitRegionVtab_(  AstRegionVtab *vtab, const char *name, int *status ) {
    object->SetAttrib = SetAttrib;
    object->TestAttrib = TestAttrib;
 
+   mapping->MapSplit = MapSplit;
    mapping->ReportPoints = ReportPoints;
    mapping->RemoveRegions = RemoveRegions;
    mapping->Simplify = Simplify;
@@ -4696,6 +4769,11 @@ void astInitRegionVtab_(  AstRegionVtab *vtab, const char *name, int *status ) {
    astSetDump( vtab, Dump, "Region",
                "An area within a coordinate system" );
 
+/* Most attributes of a Region are obtained from the encapsulated Frame
+   rather than from the Region itself, so only retain the inherited typed
+   access functions for attributes that are handled locally. */
+   astForwardAttribs( vtab, "invert,nin,nobject,nout,refcount,report,tranforward,traninverse" );
+
 /* If we have just initialised the vtab for the current class, indicate
    that the vtab is now initialised, and store a pointer to the class
    identifier in the base "object" level of the vtab. */
@@ -5412,6 +5490,741 @@ static AstRegion *MapRegion( AstRegion *this, AstMapping *map0,
    return result;
 }
 
+static int *MapSplit( AstMapping *this_map, int nin, const int *in,
+                      AstMapping **map, int *status ){
+/*
+*  Name:
+*     MapSplit
+
+*  Purpose:
+*     Create a Mapping representing a subset of the inputs of an existing
+*     Region.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "region.h"
+*     int *MapSplit( AstMapping *this, int nin, const int *in,
+*                    AstMapping **map, int *status )
+
+*  Class Membership:
+*     Region method (over-rides the protected astMapSplit method
+*     inherited from the Frame class).
+
+*  Description:
+*     This function creates a new Mapping by picking specified inputs from
+*     an existing Region. When used as a Mapping, a Region assigns bad
+*     values to all axes of any position that falls outside the Region,
+*     so in general each output depends on all the inputs. The Frame
+*     implementation of this method (which ignores the Region) therefore
+*     cannot be used, and a NULL Mapping is returned unless all the
+*     Region inputs are picked in their original order, in which case
+*     the returned Mapping is a clone of the Region.
+
+*  Parameters:
+*     this
+*        Pointer to the Region to be split (the Region is not actually
+*        modified by this function).
+*     nin
+*        The number of inputs to pick from "this".
+*     in
+*        Pointer to an array of indices (zero based) for the inputs which
+*        are to be picked. This array should have "nin" elements. If "Nin"
+*        is the number of inputs of the supplied Region, then each element
+*        should have a value in the range zero to Nin-1.
+*     map
+*        Address of a location at which to return a pointer to the new
+*        Mapping. A NULL pointer will be returned if the Region cannot
+*        be split.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to a dynamically allocated array of ints. The number of
+*     elements in this array will equal the number of outputs for the
+*     returned Mapping. Each element will hold the index of the
+*     corresponding output in the supplied Region. The array should be
+*     freed using astFree when no longer needed. A NULL pointer will
+*     be returned if no output Mapping can be created.
+
+*  Notes:
+*     - If this function is invoked with the global error status set,
+*     or if it should fail for any reason, then NULL values will be
+*     returned as the function value and for the "map" pointer.
+*/
+
+/* Local Variables: */
+   int *result;         /* Returned pointer */
+   int i;               /* Input index */
+   int ok;              /* Are all inputs picked in order? */
+
+/* Initialise */
+   result = NULL;
+   *map = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* See if all the inputs have been picked in their original order. */
+   ok = ( nin == astGetNin( this_map ) );
+   for( i = 0; i < nin && ok; i++ ) {
+      if( in[ i ] != i ) ok = 0;
+   }
+
+/* If so, return a clone of the Region, and a copy of the supplied axis
+   array. */
+   if( ok ) {
+      *map = astClone( this_map );
+      result = astStore( NULL, in, sizeof( int )*(size_t) nin );
+   }
+
+/* Free returned resources if an error has occurred. */
+   if( !astOK ) {
+      result = astFree( result );
+      if( *map ) *map = astAnnul( *map );
+   }
+
+/* Return the list of output indices. */
+   return result;
+}
+
+static void MaskBandTask( void *data, int itask, int iworker, int *status ){
+/*
+*  Name:
+*     MaskBandTask
+
+*  Purpose:
+*     Mask one band of cells for MaskFast.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "region.h"
+*     void MaskBandTask( void *data, int itask, int iworker, int *status )
+
+*  Class Membership:
+*     Region member function.
+
+*  Description:
+*     This function is invoked by astRunTasks (see MaskFast) to mask the
+*     pixels in a single band of cells described by a MaskJob. The band
+*     includes the lattice row at its lower edge, but not the one at its
+*     upper edge (except for the last band, which includes both).
+*
+*     The states of the pixels on the lattice rows and columns have
+*     already been found by MaskLineTask. If all the lattice pixels
+*     surrounding a cell have the same state, and no point in the mesh
+*     covering the boundary of the Region falls in the cell, then the
+*     pixels inside the cell are given the same state without testing
+*     them. Otherwise, each pixel inside the cell is tested individually.
+*     Finally, the "val" value is assigned to every pixel in the band that
+*     is outside the Region, and the number of such pixels is stored in
+*     the job.
+
+*  Parameters:
+*     data
+*        Pointer to the MaskJob structure.
+*     itask
+*        The index of the band of cells to mask.
+*     iworker
+*        The index of the worker thread performing the task. This
+*        determines which Region is used.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstRegion *reg;               /* Region for this worker */
+   MaskJob *job;                 /* Description of the whole job */
+   char *buf;                    /* States of the pixels in the band */
+   char *cstate;                 /* States of the pixels to be tested */
+   char *hs;                     /* States on lattice row */
+   char *row;                    /* States of the pixels in one row */
+   char *vs;                     /* States on lattice column */
+   char state;                   /* State of pixels on cell boundary */
+   double *x;                    /* X at each pixel to be tested */
+   double *y;                    /* Y at each pixel to be tested */
+   int i;                        /* Pixel index within lattice row or column */
+   int icx;                      /* Cell index on X axis */
+   int ilx;                      /* Lattice column index */
+   int n;                        /* Number of pixels to be tested */
+   int nrow;                     /* Number of pixel rows in band */
+   int r;                        /* Row index within band */
+   int uniform;                  /* Can the cell be filled without tests? */
+   int x0;                       /* Offset to first interior column of cell */
+   int x1;                       /* Offset to last interior column of cell */
+   int xx;                       /* Offset of pixel from start of row */
+   int y0;                       /* Offset of band from start of box */
+   int y1;                       /* Offset of next lattice row from start of box */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get a pointer to the job details. */
+   job = (MaskJob *) data;
+
+/* Get the rows of the box covered by the band. */
+   y0 = job->yl[ itask ] - job->lbndg[ 1 ];
+   y1 = job->yl[ itask + 1 ] - job->lbndg[ 1 ];
+   nrow = ( itask == job->ncy - 1 ) ? y1 - y0 + 1 : y1 - y0;
+
+/* Allocate memory to hold the states of the pixels in the band, and of
+   the pixels inside a single cell. */
+   buf = astMalloc( sizeof( char )*(size_t) nrow*(size_t) job->nx );
+   cstate = astMalloc( sizeof( char )*MASK_CELL*MASK_CELL );
+   x = astMalloc( sizeof( double )*MASK_CELL*MASK_CELL );
+   y = astMalloc( sizeof( double )*MASK_CELL*MASK_CELL );
+   if( astOK ) {
+
+/* Lock this worker's Region for use by the current thread. */
+      reg = job->regs[ iworker ];
+      if( iworker > 0 ) astManageLock( reg, AST__LOCK, 1, NULL );
+
+/* Copy the states of the pixels on the lattice rows and columns into the
+   band. */
+      memcpy( buf, job->hstate + (size_t) itask*job->nx, job->nx );
+      if( itask == job->ncy - 1 ) {
+         memcpy( buf + (size_t)( nrow - 1 )*job->nx,
+                 job->hstate + (size_t)( itask + 1 )*job->nx, job->nx );
+      }
+      for( ilx = 0; ilx <= job->ncx; ilx++ ) {
+         vs = job->vstate + (size_t) ilx*job->ny + y0;
+         xx = job->xl[ ilx ] - job->lbndg[ 0 ];
+         for( r = 0; r < nrow; r++ ) buf[ (size_t) r*job->nx + xx ] = vs[ r ];
+      }
+
+/* Now find the states of the pixels inside each cell. */
+      for( icx = 0; icx < job->ncx && astOK; icx++ ) {
+         x0 = job->xl[ icx ] - job->lbndg[ 0 ] + 1;
+         x1 = job->xl[ icx + 1 ] - job->lbndg[ 0 ] - 1;
+         if( x1 < x0 || y1 - y0 < 2 ) continue;
+
+/* See if the pixels on the lattice rows and columns surrounding the cell
+   all have the same state. */
+         hs = job->hstate + (size_t) itask*job->nx;
+         state = hs[ x0 - 1 ];
+         uniform = !job->edge[ icx + itask*job->ncx ];
+         for( i = x0; i <= x1 + 1 && uniform; i++ ) {
+            if( hs[ i ] != state || hs[ i + job->nx ] != state ) uniform = 0;
+         }
+         vs = job->vstate + (size_t) icx*job->ny;
+         for( i = y0; i <= y1 && uniform; i++ ) {
+            if( vs[ i ] != state || vs[ i + job->ny ] != state ) uniform = 0;
+         }
+
+/* If so, all the pixels inside the cell have the same state. */
+         if( uniform ) {
+            for( r = 1; r < y1 - y0; r++ ) {
+               memset( buf + (size_t) r*job->nx + x0, state, x1 - x0 + 1 );
+            }
+
+/* Otherwise, test each pixel inside the cell. */
+         } else {
+            n = 0;
+            for( r = 1; r < y1 - y0; r++ ) {
+               for( xx = x0; xx <= x1; xx++ ) {
+                  x[ n ] = job->lbndg[ 0 ] + xx;
+                  y[ n++ ] = job->lbndg[ 1 ] + y0 + r;
+               }
+            }
+            MaskTest( reg, n, x, y, cstate, status );
+            n = 0;
+            for( r = 1; r < y1 - y0; r++ ) {
+               memcpy( buf + (size_t) r*job->nx + x0, cstate + n, x1 - x0 + 1 );
+               n += x1 - x0 + 1;
+            }
+         }
+      }
+
+/* Assign "val" to the pixels in the band that are outside the Region. */
+      job->nset[ itask ] = 0;
+      for( r = 0; r < nrow && astOK; r++ ) {
+         row = buf + (size_t) r*job->nx;
+         job->nset[ itask ] += (*job->fill)( job->out,
+                                   (size_t)( job->lbndg[ 0 ] - job->lbnd[ 0 ] ) +
+                                   (size_t)( job->lbndg[ 1 ] + y0 + r - job->lbnd[ 1 ] )*
+                                   (size_t) job->xdim, row, job->nx, job->val );
+      }
+
+/* Unlock the Region so that it can be used by other threads. */
+      if( iworker > 0 ) astManageLock( reg, AST__UNLOCK, 1, NULL );
+   }
+
+/* Free resources. */
+   buf = astFree( buf );
+   cstate = astFree( cstate );
+   x = astFree( x );
+   y = astFree( y );
+}
+
+static int64_t MaskFast( AstRegion *this, const int lbnd[], const int ubnd[],
+                         const int lbndg[], const int ubndg[], int fillout,
+                         void *out, MaskFillFun *fill, const void *val,
+                         int *status ){
+/*
+*  Name:
+*     MaskFast
+
+*  Purpose:
+*     Mask a 2-dimensional data grid without testing every pixel.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "region.h"
+*     int64_t MaskFast( AstRegion *this, const int lbnd[], const int ubnd[],
+*                       const int lbndg[], const int ubndg[], int fillout,
+*                       void *out, MaskFillFun *fill, const void *val,
+*                       int *status )
+
+*  Class Membership:
+*     Region member function.
+
+*  Description:
+*     This function is used by astMask<X> to assign a value to every
+*     pixel in a 2-dimensional grid that is outside a Region defined in
+*     grid coordinates. It produces the same results as using astResample
+*     to transform every pixel centre, but only pixels close to the
+*     boundary of the Region are tested individually.
+*
+*     A box of pixels that encloses the Region is divided into cells by
+*     a lattice of complete pixel rows and columns, MASK_CELL pixels
+*     apart, and every pixel on the lattice is tested. A cell is then
+*     assumed to be entirely inside (or outside) the Region if all the
+*     lattice pixels surrounding it are inside (or outside) the Region,
+*     and no point in a mesh covering the boundary of the Region falls
+*     within the cell. The mesh is used to detect parts of the boundary
+*     that are completely contained within a single cell. The pixels
+*     inside all other cells are tested individually. Each band of cells
+*     is processed by a separate task, using the AST thread pool.
+*
+*     Nothing is done (and -1 is returned) if the box is small, or if the
+*     boundary of the Region cannot be represented by a mesh because it
+*     extends to infinity. The caller should then test every pixel.
+
+*  Parameters:
+*     this
+*        Pointer to the Region. It should be defined in grid coordinates.
+*     lbnd
+*        The grid coordinates at the centre of the first pixel in the
+*        data array.
+*     ubnd
+*        The grid coordinates at the centre of the last pixel in the
+*        data array.
+*     lbndg
+*        The grid coordinates at the centre of the first pixel in the
+*        box enclosing the Region.
+*     ubndg
+*        The grid coordinates at the centre of the last pixel in the
+*        box enclosing the Region.
+*     fillout
+*        If non-zero, "val" is also assigned to every pixel outside the
+*        box.
+*     out
+*        Pointer to the data array.
+*     fill
+*        Pointer to the function that assigns "val" to selected elements
+*        of a row of the data array. The elements to which the value is
+*        assigned are flagged by a zero value in the array of states
+*        passed to the function.
+*     val
+*        Pointer to the value to assign.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The number of pixels to which "val" has been assigned, or -1 if
+*     the pixels have not been masked.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   AstPointSet *mesh;            /* Mesh covering the Region's boundary */
+   AstRegion *reg;               /* Un-negated copy of the Region */
+   MaskJob job;                  /* Information shared by all tasks */
+   char *zero;                   /* Row of zero states */
+   double **ptr;                 /* Pointers to mesh axis values */
+   double gx;                    /* X at mesh point */
+   double gy;                    /* Y at mesh point */
+   double rlbnd[ 2 ];            /* Lower bounds of un-negated Region */
+   double rubnd[ 2 ];            /* Upper bounds of un-negated Region */
+   int icx;                      /* Cell index on X axis */
+   int icy;                      /* Cell index on Y axis */
+   int ip;                       /* Mesh point index */
+   int iworker;                  /* Worker index */
+   int ix;                       /* Cell index on X axis containing point */
+   int iy;                       /* Cell index on Y axis containing point */
+   int meshsize;                 /* Number of points in mesh */
+   int nworker;                  /* Number of worker threads */
+   int x;                        /* Pixel X coordinate */
+   int yy;                       /* Pixel Y coordinate */
+   int64_t result;               /* Returned value */
+
+/* Initialise. */
+   result = -1;
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Check the box is big enough to make the lattice worthwhile. */
+   job.nx = ubndg[ 0 ] - lbndg[ 0 ] + 1;
+   job.ny = ubndg[ 1 ] - lbndg[ 1 ] + 1;
+   if( job.nx < 2*MASK_CELL || job.ny < 2*MASK_CELL ) return result;
+
+/* Get a mesh of points covering the boundary of the Region. This can
+   only be done if the boundary is of finite extent, as indicated by the
+   bounding box of the un-negated Region. The boundary is not changed by
+   negating the Region, so use an un-negated copy. The mesh is only used
+   to detect small closed parts of the boundary, but use enough points to
+   give several per cell along the boundary of the box. */
+   mesh = NULL;
+   reg = astCopy( this );
+   astSetNegated( reg, 0 );
+   rlbnd[ 0 ] = rlbnd[ 1 ] = rubnd[ 0 ] = rubnd[ 1 ] = AST__BAD;
+   astGetRegionBounds( reg, rlbnd, rubnd );
+   if( astOK && rlbnd[ 0 ] != AST__BAD && rlbnd[ 1 ] != AST__BAD &&
+       rubnd[ 0 ] != AST__BAD && rubnd[ 1 ] != AST__BAD &&
+       fabs( rlbnd[ 0 ] ) < DBL_MAX && fabs( rlbnd[ 1 ] ) < DBL_MAX &&
+       fabs( rubnd[ 0 ] ) < DBL_MAX && fabs( rubnd[ 1 ] ) < DBL_MAX ) {
+      meshsize = 4*( job.nx/MASK_CELL + job.ny/MASK_CELL );
+      if( meshsize > astGetMeshSize( reg ) ) astSetMeshSize( reg, meshsize );
+      mesh = astRegMesh( reg );
+   }
+   reg = astAnnul( reg );
+   if( !mesh ) return astOK ? result : 0;
+
+/* Find the pixel coordinates of the lattice rows and columns. These are
+   MASK_CELL pixels apart, starting at the lower edge of the box, and
+   always include the upper edge of the box. */
+   job.xl = astMalloc( sizeof( int )*(size_t)( job.nx/MASK_CELL + 2 ) );
+   job.yl = astMalloc( sizeof( int )*(size_t)( job.ny/MASK_CELL + 2 ) );
+   if( astOK ) {
+      job.ncx = 0;
+      for( x = lbndg[ 0 ]; x < ubndg[ 0 ]; x += MASK_CELL ) job.xl[ job.ncx++ ] = x;
+      job.xl[ job.ncx ] = ubndg[ 0 ];
+      job.ncy = 0;
+      for( yy = lbndg[ 1 ]; yy < ubndg[ 1 ]; yy += MASK_CELL ) job.yl[ job.ncy++ ] = yy;
+      job.yl[ job.ncy ] = ubndg[ 1 ];
+   }
+
+/* Flag the cells that contain (or are within one pixel of) a mesh point. */
+   job.edge = astCalloc( (size_t)( job.ncx*job.ncy ), sizeof( char ) );
+   ptr = astGetPoints( mesh );
+   if( astOK ) {
+      for( ip = 0; ip < astGetNpoint( mesh ); ip++ ) {
+         gx = ptr[ 0 ][ ip ];
+         gy = ptr[ 1 ][ ip ];
+         if( gx == AST__BAD || gy == AST__BAD ||
+             gx < lbndg[ 0 ] - 1.0 || gx > ubndg[ 0 ] + 1.0 ||
+             gy < lbndg[ 1 ] - 1.0 || gy > ubndg[ 1 ] + 1.0 ) continue;
+
+         ix = (int) floor( ( gx - lbndg[ 0 ] )/MASK_CELL );
+         iy = (int) floor( ( gy - lbndg[ 1 ] )/MASK_CELL );
+         for( icy = iy - 1; icy <= iy + 1; icy++ ) {
+            if( icy < 0 || icy >= job.ncy || gy < job.yl[ icy ] - 1.0 ||
+                gy > job.yl[ icy + 1 ] + 1.0 ) continue;
+            for( icx = ix - 1; icx <= ix + 1; icx++ ) {
+               if( icx < 0 || icx >= job.ncx || gx < job.xl[ icx ] - 1.0 ||
+                   gx > job.xl[ icx + 1 ] + 1.0 ) continue;
+               job.edge[ icx + icy*job.ncx ] = 1;
+            }
+         }
+      }
+   }
+   mesh = astAnnul( mesh );
+
+/* Allocate the other arrays used by the tasks, and create a separate
+   Region for each worker, since transforming positions may modify the
+   Region. */
+   nworker = astTaskWorkers( job.ncy );
+   job.hstate = astMalloc( sizeof( char )*(size_t)( job.ncy + 1 )*(size_t) job.nx );
+   job.vstate = astMalloc( sizeof( char )*(size_t)( job.ncx + 1 )*(size_t) job.ny );
+   job.nset = astCalloc( (size_t) job.ncy, sizeof( int64_t ) );
+   job.regs = astCalloc( (size_t) nworker, sizeof( AstRegion * ) );
+   if( astOK ) {
+      job.regs[ 0 ] = astClone( this );
+      for( iworker = 1; iworker < nworker && astOK; iworker++ ) {
+         job.regs[ iworker ] = astCopy( this );
+         if( astOK ) astManageLock( job.regs[ iworker ], AST__UNLOCK, 1, NULL );
+      }
+   }
+
+/* Test the pixels on the lattice rows and columns, and then mask each
+   band of cells. */
+   if( astOK ) {
+      job.fill = fill;
+      job.val = val;
+      job.out = out;
+      job.lbnd[ 0 ] = lbnd[ 0 ];
+      job.lbnd[ 1 ] = lbnd[ 1 ];
+      job.lbndg[ 0 ] = lbndg[ 0 ];
+      job.lbndg[ 1 ] = lbndg[ 1 ];
+      job.xdim = ubnd[ 0 ] - lbnd[ 0 ] + 1;
+      astRunTasks( job.ncx + job.ncy + 2, nworker, MaskLineTask, &job );
+      astRunTasks( job.ncy, nworker, MaskBandTask, &job );
+
+/* Sum the numbers of pixels assigned "val". */
+      result = 0;
+      for( icy = 0; icy < job.ncy; icy++ ) result += job.nset[ icy ];
+
+/* If required, assign "val" to every pixel outside the box. */
+      if( fillout ) {
+         zero = astCalloc( (size_t) job.xdim, sizeof( char ) );
+         for( yy = lbnd[ 1 ]; yy <= ubnd[ 1 ] && astOK; yy++ ) {
+            if( yy < lbndg[ 1 ] || yy > ubndg[ 1 ] ) {
+               result += (*fill)( out, (size_t)( yy - lbnd[ 1 ] )*(size_t) job.xdim,
+                                  zero, job.xdim, val );
+            } else {
+               result += (*fill)( out, (size_t)( yy - lbnd[ 1 ] )*(size_t) job.xdim,
+                                  zero, lbndg[ 0 ] - lbnd[ 0 ], val );
+               result += (*fill)( out, (size_t)( yy - lbnd[ 1 ] )*(size_t) job.xdim +
+                                  (size_t)( ubndg[ 0 ] - lbnd[ 0 ] + 1 ),
+                                  zero, ubnd[ 0 ] - ubndg[ 0 ], val );
+            }
+         }
+         zero = astFree( zero );
+      }
+   }
+
+/* Free resources. The Region copies were left unlocked, so lock them
+   before annulling them. */
+   if( job.regs ) {
+      for( iworker = 0; iworker < nworker; iworker++ ) {
+         if( job.regs[ iworker ] ) {
+            if( iworker > 0 ) astManageLock( job.regs[ iworker ], AST__LOCK,
+                                             1, NULL );
+            job.regs[ iworker ] = astAnnul( job.regs[ iworker ] );
+         }
+      }
+      job.regs = astFree( job.regs );
+   }
+   job.xl = astFree( job.xl );
+   job.yl = astFree( job.yl );
+   job.edge = astFree( job.edge );
+   job.hstate = astFree( job.hstate );
+   job.vstate = astFree( job.vstate );
+   job.nset = astFree( job.nset );
+
+/* If an error occurred, clear the returned value. */
+   if ( !astOK ) result = 0;
+
+/* Return the result. */
+   return result;
+}
+
+/* Define a macro to implement the function that assigns a value to
+   selected elements of a row of a data array, for a specific data type
+   (see MaskFast). */
+#define MAKE_MASKFILL(X,Xtype) \
+static int MaskFill##X( void *out, size_t offset, const char *state, int n, \
+                        const void *val ) { \
+\
+/* Local Variables: */ \
+   Xtype *d;                     /* Pointer to next array element */ \
+   Xtype v;                      /* Value to assign */ \
+   int i;                        /* Element index */ \
+   int result;                   /* Number of elements assigned "v" */ \
+\
+/* Assign the value to each element that has a zero state. */ \
+   result = 0; \
+   d = (Xtype *) out + offset; \
+   v = *( (const Xtype *) val ); \
+   for( i = 0; i < n; i++ ) { \
+      if( !state[ i ] ) { \
+         d[ i ] = v; \
+         result++; \
+      } \
+   } \
+\
+/* Return the number of elements assigned the value. */ \
+   return result; \
+}
+
+/* Expand the above macro to generate a function for each required
+   data type. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_MASKFILL(LD,long double)
+#endif
+MAKE_MASKFILL(D,double)
+MAKE_MASKFILL(L,long int)
+MAKE_MASKFILL(UL,unsigned long int)
+MAKE_MASKFILL(I,int)
+MAKE_MASKFILL(UI,unsigned int)
+MAKE_MASKFILL(S,short int)
+MAKE_MASKFILL(US,unsigned short int)
+MAKE_MASKFILL(B,signed char)
+MAKE_MASKFILL(UB,unsigned char)
+MAKE_MASKFILL(F,float)
+
+/* Undefine the macro. */
+#undef MAKE_MASKFILL
+
+static void MaskLineTask( void *data, int itask, int iworker, int *status ){
+/*
+*  Name:
+*     MaskLineTask
+
+*  Purpose:
+*     Test the pixels on one lattice row or column for MaskFast.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "region.h"
+*     void MaskLineTask( void *data, int itask, int iworker, int *status )
+
+*  Class Membership:
+*     Region member function.
+
+*  Description:
+*     This function is invoked by astRunTasks (see MaskFast) to test
+*     whether each pixel on a single lattice row or column described by a
+*     MaskJob is inside the Region. The results are stored in the job.
+
+*  Parameters:
+*     data
+*        Pointer to the MaskJob structure.
+*     itask
+*        The index of the lattice row to test, or (if greater than the
+*        number of lattice rows) the index of the lattice column plus the
+*        number of lattice rows.
+*     iworker
+*        The index of the worker thread performing the task. This
+*        determines which Region is used.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstRegion *reg;               /* Region for this worker */
+   MaskJob *job;                 /* Description of the whole job */
+   char *state;                  /* Returned pixel states */
+   double *x;                    /* X at each pixel */
+   double *y;                    /* Y at each pixel */
+   int i;                        /* Pixel index */
+   int n;                        /* Number of pixels */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get a pointer to the job details. */
+   job = (MaskJob *) data;
+
+/* Get the coordinates of the pixels on the required lattice row or
+   column, and a pointer to the array in which to store their states. */
+   n = ( itask <= job->ncy ) ? job->nx : job->ny;
+   x = astMalloc( sizeof( double )*(size_t) n );
+   y = astMalloc( sizeof( double )*(size_t) n );
+   if( astOK ) {
+      if( itask <= job->ncy ) {
+         state = job->hstate + (size_t) itask*job->nx;
+         for( i = 0; i < n; i++ ) {
+            x[ i ] = job->lbndg[ 0 ] + i;
+            y[ i ] = job->yl[ itask ];
+         }
+      } else {
+         itask -= job->ncy + 1;
+         state = job->vstate + (size_t) itask*job->ny;
+         for( i = 0; i < n; i++ ) {
+            x[ i ] = job->xl[ itask ];
+            y[ i ] = job->lbndg[ 1 ] + i;
+         }
+      }
+
+/* Test the pixels using this worker's Region. */
+      reg = job->regs[ iworker ];
+      if( iworker > 0 ) astManageLock( reg, AST__LOCK, 1, NULL );
+      MaskTest( reg, n, x, y, state, status );
+      if( iworker > 0 ) astManageLock( reg, AST__UNLOCK, 1, NULL );
+   }
+
+/* Free resources. */
+   x = astFree( x );
+   y = astFree( y );
+}
+
+static void MaskTest( AstRegion *reg, int n, const double *x,
+                      const double *y, char *state, int *status ){
+/*
+*  Name:
+*     MaskTest
+
+*  Purpose:
+*     Test if pixels are inside a 2-dimensional Region.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "region.h"
+*     void MaskTest( AstRegion *reg, int n, const double *x,
+*                    const double *y, char *state, int *status )
+
+*  Class Membership:
+*     Region member function.
+
+*  Description:
+*     This function transforms a set of pixel centres using a Region,
+*     and returns a flag for each pixel indicating if it is inside the
+*     Region (i.e. if both transformed axis values are good).
+
+*  Parameters:
+*     reg
+*        Pointer to the Region.
+*     n
+*        The number of pixels to test.
+*     x
+*        The X coordinate at the centre of each pixel.
+*     y
+*        The Y coordinate at the centre of each pixel.
+*     state
+*        An array in which to return a flag for each pixel. This will be
+*        non-zero if the pixel is inside the Region, and zero otherwise.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstPointSet *ps;              /* Pixel centres */
+   AstPointSet *psout;           /* Transformed pixel centres */
+   double **ptr;                 /* Pointers to pixel centres */
+   double **ptr_out;             /* Pointers to transformed pixel centres */
+   int i;                        /* Pixel index */
+
+/* Check the global error status. */
+   if ( !astOK || n == 0 ) return;
+
+/* Store the pixel centres in a PointSet. */
+   ps = astPointSet( n, 2, "", status );
+   ptr = astGetPoints( ps );
+   if( astOK ) {
+      memcpy( ptr[ 0 ], x, sizeof( double )*(size_t) n );
+      memcpy( ptr[ 1 ], y, sizeof( double )*(size_t) n );
+   }
+
+/* Transform them using the Region and note which are good. */
+   psout = astTransform( reg, ps, 1, NULL );
+   ptr_out = astGetPoints( psout );
+   if( astOK ) {
+      for( i = 0; i < n; i++ ) {
+         state[ i ] = ( ptr_out[ 0 ][ i ] != AST__BAD &&
+                        ptr_out[ 1 ][ i ] != AST__BAD );
+      }
+   }
+
+/* Free resources. */
+   psout = astAnnul( psout );
+   ps = astAnnul( ps );
+}
+
 /*
 *++
 *  Name:
@@ -5578,6 +6391,11 @@ f        BADVAL
 *     reason.
 *     - An error will be reported if the overlap of the Region and
 *     the array cannot be determined.
+c     - If the grid contains more than 2147483647 pixels (the largest
+c     value that can be stored in an "int"), astMask8<X> should be used
+c     instead. This has the same arguments, except that "lbnd" and "ubnd"
+c     are of type "const int64_t[]", and returns an "int64_t". Each
+c     individual bound must still lie within the range of an "int".
 
 *  Data Type Codes:
 *     To select the appropriate masking function, you should
@@ -5619,10 +6437,11 @@ f     only in the Fortran interface to AST).
 */
 /* Define a macro to implement the function for a specific data
    type. */
-#define MAKE_MASK(X,Xtype) \
-static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
-                    const int lbnd[], const int ubnd[], \
-                    Xtype in[], Xtype val, int *status ) { \
+#define MAKE_MASK8(X,Xtype) \
+static int64_t Mask8##X( AstRegion *this, AstMapping *map, int inside, \
+                         int ndim, const int64_t lbnd[], \
+                         const int64_t ubnd[], Xtype in[], Xtype val, \
+                         int *status ) { \
 \
 /* Local Variables: */ \
    AstFrame *grid_frame;         /* Pointer to Frame describing grid coords */ \
@@ -5633,16 +6452,22 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
    Xtype *tmp_out;               /* Pointer to temporary output array */ \
    double *lbndgd;               /* Pointer to array holding lower grid bounds */ \
    double *ubndgd;               /* Pointer to array holding upper grid bounds */ \
-   int *lbndg;                   /* Pointer to array holding lower grid bounds */ \
-   int *ubndg;                   /* Pointer to array holding upper grid bounds */ \
+   int fillout;                  /* Assign "val" outside the bounding box? */ \
    int idim;                     /* Loop counter for coordinate dimensions */ \
-   int ipix;                     /* Loop counter for pixel index */ \
+   int lbnd32[ 2 ];              /* 2-d array lower bounds as int */ \
+   int lbndg32[ 2 ];             /* 2-d box lower bounds as int */ \
    int nax;                      /* Number of Region axes */ \
    int nin;                      /* Number of Mapping input coordinates */ \
    int nout;                     /* Number of Mapping output coordinates */ \
-   int npix;                     /* Number of pixels in supplied array */ \
-   int npixg;                    /* Number of pixels in bounding box */ \
-   int result;                   /* Result value to return */ \
+   int ubnd32[ 2 ];              /* 2-d array upper bounds as int */ \
+   int ubndg32[ 2 ];             /* 2-d box upper bounds as int */ \
+   int64_t *lbndg;               /* Pointer to array holding lower grid bounds */ \
+   int64_t *ubndg;               /* Pointer to array holding upper grid bounds */ \
+   int64_t ipix;                 /* Loop counter for pixel index */ \
+   int64_t npix;                 /* Number of pixels in supplied array */ \
+   int64_t npixg;                /* Number of pixels in bounding box */ \
+   int64_t nset;                 /* Number of pixels masked by MaskFast */ \
+   int64_t result;               /* Result value to return */ \
 \
 /* Initialise. */ \
    result = 0; \
@@ -5708,9 +6533,10 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
       for ( idim = 0; idim < ndim; idim++ ) { \
          if ( lbnd[ idim ] > ubnd[ idim ] ) { \
             astError( AST__GBDIN, "astMask"#X"(%s): Lower bound of " \
-                      "input grid (%d) exceeds corresponding upper bound " \
-                      "(%d).", status, astGetClass( this ), \
-                      lbnd[ idim ], ubnd[ idim ] ); \
+                      "input grid (%lld) exceeds corresponding upper bound " \
+                      "(%lld).", status, astGetClass( this ), \
+                      (long long int) lbnd[ idim ], \
+                      (long long int) ubnd[ idim ] ); \
             astError( AST__GBDIN, "Error in input dimension %d.", status, \
                       idim + 1 ); \
             break; \
@@ -5721,8 +6547,8 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
 /* Allocate memory, and then get the bounding box of this new Region in its \
    current Frame (grid coordinates). This bounding box assumes the region \
    has not been negated. */ \
-   lbndg = astMalloc( sizeof( int )*(size_t) ndim ); \
-   ubndg = astMalloc( sizeof( int )*(size_t) ndim ); \
+   lbndg = astMalloc( sizeof( int64_t )*(size_t) ndim ); \
+   ubndg = astMalloc( sizeof( int64_t )*(size_t) ndim ); \
    lbndgd = astMalloc( sizeof( double )*(size_t) ndim ); \
    ubndgd = astMalloc( sizeof( double )*(size_t) ndim ); \
    if( astOK ) { \
@@ -5738,8 +6564,8 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
       npixg = 1; \
       for ( idim = 0; idim < ndim; idim++ ) { \
          if( lbndgd[ idim ] != AST__BAD && ubndgd[ idim ] != AST__BAD ) { \
-            lbndg[ idim ] = MAX( lbnd[ idim ], (int)( lbndgd[ idim ] + 0.5 ) - 2 ); \
-            ubndg[ idim ] = MIN( ubnd[ idim ], (int)( ubndgd[ idim ] + 0.5 ) + 2 ); \
+            lbndg[ idim ] = MAX( lbnd[ idim ], (int64_t)( lbndgd[ idim ] + 0.5 ) - 2 ); \
+            ubndg[ idim ] = MIN( ubnd[ idim ], (int64_t)( ubndgd[ idim ] + 0.5 ) + 2 ); \
          } else { \
             lbndg[ idim ] = lbnd[ idim ]; \
             ubndg[ idim ] = ubnd[ idim ]; \
@@ -5761,60 +6587,89 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
 /* If the bounding box is null, return without action. */ \
       } else if( npixg > 0 && astOK ) { \
 \
-/* All points outside this box are either all inside, or all outside, the \
+/* For 2-dimensional grids, first try to mask the array without testing \
+   every pixel in the bounding box (see MaskFast). As described below, \
+   all points outside the box are assigned "val" if the outside of the \
+   box is outside the region of interest, and the Region is negated if \
+   the inside is to be assigned "val". MaskFast uses int pixel indices, \
+   so this is only done if the array bounds can be represented as type \
+   int (otherwise astResample8<X> reports an error below). */ \
+         nset = -1; \
+         if( ndim == 2 && lbnd[ 0 ] >= INT_MIN && lbnd[ 1 ] >= INT_MIN && \
+             ubnd[ 0 ] <= INT_MAX && ubnd[ 1 ] <= INT_MAX ) { \
+            for( idim = 0; idim < 2; idim++ ) { \
+               lbnd32[ idim ] = (int) lbnd[ idim ]; \
+               ubnd32[ idim ] = (int) ubnd[ idim ]; \
+               lbndg32[ idim ] = (int) lbndg[ idim ]; \
+               ubndg32[ idim ] = (int) ubndg[ idim ]; \
+            } \
+            fillout = ( ( inside != 0 ) == ( astGetNegated( used_region ) != 0 ) ); \
+            if( inside ) astNegate( used_region ); \
+            nset = MaskFast( used_region, lbnd32, ubnd32, lbndg32, ubndg32, \
+                             fillout, in, MaskFill##X, &val, status ); \
+            if( inside ) astNegate( used_region ); \
+         } \
+         if( nset >= 0 ) { \
+            result = nset; \
+\
+         } else { \
+\
+/* Otherwise, use astResample to test every pixel in the bounding box. \
+   All points outside this box are either all inside, or all outside, the \
    Region. So we can speed up processing by setting all the points which are \
    outside the box to the supplied data value (if required). This is \
    faster than checking each point individually using the Transform method \
    of the Region. We do this by supplying an alternative output array to \
    the resampling function below, which has been pre-filled with "val" at \
    every pixel. */ \
-         if( ( inside != 0 ) == ( astGetNegated( used_region ) != 0 ) ) { \
+            if( ( inside != 0 ) == ( astGetNegated( used_region ) != 0 ) ) { \
 \
 /* Allocate memory for the alternative output array, and fill it with \
    "val". */ \
-            tmp_out = astMalloc( sizeof( Xtype )*(size_t) npix ); \
-            if( tmp_out ) { \
-               c = tmp_out; \
-               for( ipix = 0; ipix < npix; ipix++ ) *(c++) = val; \
-               result = npix - npixg; \
-            } \
+               tmp_out = astMalloc( sizeof( Xtype )*(size_t) npix ); \
+               if( tmp_out ) { \
+                  c = tmp_out; \
+                  for( ipix = 0; ipix < npix; ipix++ ) *(c++) = val; \
+                  result = npix - npixg; \
+               } \
 \
 /* Indicate that we will use this temporary array rather than the \
    supplied array. */ \
-            out = tmp_out; \
+               out = tmp_out; \
 \
 /* If the outside of the grid box is outside the region of interest it \
    will be unchanged in the resturned array. Therefore we can use the \
    supplied array as the output array below. */ \
-         } else { \
-            tmp_out = NULL; \
-            out = in; \
-         } \
+            } else { \
+               tmp_out = NULL; \
+               out = in; \
+            } \
 \
 /* Temporarily invert the Region if required. The Region Transform methods \
    leave interior points unchanged and assign AST__BAD to exterior points. \
    This is the opposite of what we want (which is to leave exterior \
    points unchanged and assign VAL to interior points), so we negate the \
    region if the inside is to be assigned the value VAL.*/ \
-         if( inside ) astNegate( used_region ); \
+            if( inside ) astNegate( used_region ); \
 \
 /* Invoke astResample to mask just the region inside the bounding box found \
    above (specified by lbndg and ubndg), since all the points outside this \
    box will already contain their required value. */ \
-         result += astResample##X( used_region, ndim, lbnd, ubnd, in, NULL, AST__NEAREST, \
-                                   NULL, NULL, 0, 0.0, 100, val, ndim, \
-                                   lbnd, ubnd, lbndg, ubndg, out, NULL ); \
+            result += astResample8##X( used_region, ndim, lbnd, ubnd, in, NULL, AST__NEAREST, \
+                                       NULL, NULL, 0, 0.0, 100, val, ndim, \
+                                       lbnd, ubnd, lbndg, ubndg, out, NULL ); \
 \
 /* Revert to the original setting of the Negated attribute. */ \
-         if( inside ) astNegate( used_region ); \
+            if( inside ) astNegate( used_region ); \
 \
 /* If required, copy the output data from the temporary output array to \
    the supplied array, and then free the temporary output array. */ \
-         if( tmp_out ) { \
-            c = tmp_out; \
-            d = in; \
-            for( ipix = 0; ipix < npix; ipix++ ) *(d++) = *(c++); \
-            tmp_out = astFree( tmp_out ); \
+            if( tmp_out ) { \
+               c = tmp_out; \
+               d = in; \
+               for( ipix = 0; ipix < npix; ipix++ ) *(d++) = *(c++); \
+               tmp_out = astFree( tmp_out ); \
+            }\
          }\
       }\
    } \
@@ -5836,21 +6691,21 @@ static int Mask##X( AstRegion *this, AstMapping *map, int inside, int ndim, \
 /* Expand the above macro to generate a function for each required
    data type. */
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
-MAKE_MASK(LD,long double)
+MAKE_MASK8(LD,long double)
 #endif
-MAKE_MASK(D,double)
-MAKE_MASK(L,long int)
-MAKE_MASK(UL,unsigned long int)
-MAKE_MASK(I,int)
-MAKE_MASK(UI,unsigned int)
-MAKE_MASK(S,short int)
-MAKE_MASK(US,unsigned short int)
-MAKE_MASK(B,signed char)
-MAKE_MASK(UB,unsigned char)
-MAKE_MASK(F,float)
+MAKE_MASK8(D,double)
+MAKE_MASK8(L,long int)
+MAKE_MASK8(UL,unsigned long int)
+MAKE_MASK8(I,int)
+MAKE_MASK8(UI,unsigned int)
+MAKE_MASK8(S,short int)
+MAKE_MASK8(US,unsigned short int)
+MAKE_MASK8(B,signed char)
+MAKE_MASK8(UB,unsigned char)
+MAKE_MASK8(F,float)
 
 /* Undefine the macro. */
-#undef MAKE_MASK
+#undef MAKE_MASK8
 
 
 
@@ -13078,9 +13933,40 @@ AstPointSet *astBndMesh_( AstRegion *this, double *lbnd, double *ubnd, int *stat
 int astMask##X##_( AstRegion *this, AstMapping *map, int inside, int ndim, \
                    const int lbnd[], const int ubnd[], Xtype in[], \
                    Xtype val, int *status ) { \
+   int64_t *lbnd8; \
+   int64_t *ubnd8; \
+   int64_t result; \
+   int idim; \
+   if ( !astOK ) return 0; \
+   result = 0; \
+   lbnd8 = astMalloc( sizeof( int64_t )*(size_t) ndim ); \
+   ubnd8 = astMalloc( sizeof( int64_t )*(size_t) ndim ); \
+   if ( astOK ) { \
+      for ( idim = 0; idim < ndim; idim++ ) { \
+         lbnd8[ idim ] = lbnd[ idim ]; \
+         ubnd8[ idim ] = ubnd[ idim ]; \
+      } \
+      result = (**astMEMBER(this,Region,Mask8##X))( this, map, inside, ndim, \
+                                                     lbnd8, ubnd8, in, val, \
+                                                     status ); \
+   } \
+   lbnd8 = astFree( lbnd8 ); \
+   ubnd8 = astFree( ubnd8 ); \
+   if ( astOK && result > INT_MAX ) { \
+      astError( AST__EXSPIX, "astMask"#X"(%s): The number of masked " \
+                "pixels (%lld) is too large to be returned as an int - " \
+                "use astMask8"#X" instead.", status, astGetClass( this ), \
+                (long long int) result ); \
+   } \
+   return astOK ? (int) result : 0; \
+} \
+int64_t astMask8##X##_( AstRegion *this, AstMapping *map, int inside, \
+                        int ndim, const int64_t lbnd[], \
+                        const int64_t ubnd[], Xtype in[], Xtype val, \
+                        int *status ) { \
    if ( !astOK ) return 0; \
-   return (**astMEMBER(this,Region,Mask##X))( this, map, inside, ndim, lbnd, \
-                                              ubnd, in, val, status ); \
+   return (**astMEMBER(this,Region,Mask8##X))( this, map, inside, ndim, \
+                                               lbnd, ubnd, in, val, status ); \
 }
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
 MAKE_MASK_(LD,long double)
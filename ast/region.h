@@ -58,6 +58,9 @@
 *        Original version.
 *     2-MAR-2006 (DSB):
 *        Changed AST_LONG_DOUBLE to HAVE_LONG_DOUBLE.
+*     16-OCT-2026 (DSB):
+*        Replace the Mask<X> vtab slots with 64-bit Mask8<X> versions,
+*        and add astMask8<X>.
 *-
 */
 
@@ -163,18 +166,18 @@ typedef struct AstRegionVtab {
    double *(* RegCentre)( AstRegion *, double *, double **, int, int, int * );
 
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
-   int (* MaskLD)( AstRegion *, AstMapping *, int, int, const int[], const int ubnd[], long double [], long double, int * );
+   int64_t (* Mask8LD)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long double [], long double, int * );
 #endif
-   int (* MaskB)( AstRegion *, AstMapping *, int, int, const int[], const int[], signed char[], signed char, int * );
-   int (* MaskD)( AstRegion *, AstMapping *, int, int, const int[], const int[], double[], double, int * );
-   int (* MaskF)( AstRegion *, AstMapping *, int, int, const int[], const int[], float[], float, int * );
-   int (* MaskI)( AstRegion *, AstMapping *, int, int, const int[], const int[], int[], int, int * );
-   int (* MaskL)( AstRegion *, AstMapping *, int, int, const int[], const int[], long int[], long int, int * );
-   int (* MaskS)( AstRegion *, AstMapping *, int, int, const int[], const int[], short int[], short int, int * );
-   int (* MaskUB)( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned char[], unsigned char, int * );
-   int (* MaskUI)( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned int[], unsigned int, int * );
-   int (* MaskUL)( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned long int[], unsigned long int, int * );
-   int (* MaskUS)( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned short int[], unsigned short int, int * );
+   int64_t (* Mask8B)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], signed char[], signed char, int * );
+   int64_t (* Mask8D)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], double[], double, int * );
+   int64_t (* Mask8F)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], float[], float, int * );
+   int64_t (* Mask8I)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], int[], int, int * );
+   int64_t (* Mask8L)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long int[], long int, int * );
+   int64_t (* Mask8S)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], short int[], short int, int * );
+   int64_t (* Mask8UB)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned char[], unsigned char, int * );
+   int64_t (* Mask8UI)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned int[], unsigned int, int * );
+   int64_t (* Mask8UL)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned long int[], unsigned long int, int * );
+   int64_t (* Mask8US)( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned short int[], unsigned short int, int * );
 
    int (* GetNegated)( AstRegion *, int * );
    int (* TestNegated)( AstRegion *, int * );
@@ -257,17 +260,28 @@ void astNegate_( AstRegion *, int * );
 
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
 int astMaskLD_( AstRegion *, AstMapping *, int, int, const int[], const int[], long double [], long double, int * );
+int64_t astMask8LD_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long double [], long double, int * );
 #endif
 int astMaskB_( AstRegion *, AstMapping *, int, int, const int[], const int[], signed char[], signed char, int * );
+int64_t astMask8B_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], signed char[], signed char, int * );
 int astMaskD_( AstRegion *, AstMapping *, int, int, const int[], const int[], double[], double, int * );
+int64_t astMask8D_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], double[], double, int * );
 int astMaskF_( AstRegion *, AstMapping *, int, int, const int[], const int[], float[], float, int * );
+int64_t astMask8F_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], float[], float, int * );
 int astMaskI_( AstRegion *, AstMapping *, int, int, const int[], const int[], int[], int, int * );
+int64_t astMask8I_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], int[], int, int * );
 int astMaskL_( AstRegion *, AstMapping *, int, int, const int[], const int[], long int[], long int, int * );
+int64_t astMask8L_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], long int[], long int, int * );
 int astMaskS_( AstRegion *, AstMapping *, int, int, const int[], const int[], short int[], short int, int * );
+int64_t astMask8S_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], short int[], short int, int * );
 int astMaskUB_( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned char[], unsigned char, int * );
+int64_t astMask8UB_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned char[], unsigned char, int * );
 int astMaskUI_( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned int[], unsigned int, int * );
+int64_t astMask8UI_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned int[], unsigned int, int * );
 int astMaskUL_( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned long int[], unsigned long int, int * );
+int64_t astMask8UL_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned long int[], unsigned long int, int * );
 int astMaskUS_( AstRegion *, AstMapping *, int, int, const int[], const int[], unsigned short int[], unsigned short int, int * );
+int64_t astMask8US_( AstRegion *, AstMapping *, int, int, const int64_t[], const int64_t[], unsigned short int[], unsigned short int, int * );
 void astSetUnc_( AstRegion *, AstRegion *, int * );
 AstRegion *astGetNegation_( AstRegion *, int * );
 AstRegion *astGetUnc_( AstRegion *, int, int * );
@@ -395,28 +409,50 @@ astINVOKE(V,astOverlap_(astCheckRegion(this),astCheckRegion(that),STATUS_PTR))
 #if HAVE_LONG_DOUBLE     /* Not normally implemented */
 #define astMaskLD(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskLD_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8LD(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8LD_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #endif
 
 #define astMaskB(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskB_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8B(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8B_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskD(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskD_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8D(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8D_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskF(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskF_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8F(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8F_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskI(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskI_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8I(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8I_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskL(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskL_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8L(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8L_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskS(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskS_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8S(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8S_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskUB(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskUB_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8UB(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8UB_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskUI(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskUI_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8UI(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8UI_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskUL(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskUL_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8UL(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8UL_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astMaskUS(this,map,inside,ndim,lbnd,ubnd,in,val) \
 astINVOKE(V,astMaskUS_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
+#define astMask8US(this,map,inside,ndim,lbnd,ubnd,in,val) \
+astINVOKE(V,astMask8US_(astCheckRegion(this),(map?astCheckMapping(map):NULL),inside,ndim,lbnd,ubnd,in,val,STATUS_PTR))
 #define astSetUnc(this,unc) astINVOKE(V,astSetUnc_(astCheckRegion(this),unc?astCheckRegion(unc):NULL,STATUS_PTR))
 #define astGetUnc(this,def) astINVOKE(O,astGetUnc_(astCheckRegion(this),def,STATUS_PTR))
 #define astGetRegionBounds(this,lbnd,ubnd) astINVOKE(V,astGetRegionBounds_(astCheckRegion(this),lbnd,ubnd,STATUS_PTR))
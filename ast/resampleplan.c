@@ -0,0 +1,2040 @@
+/*
+*class++
+*  Name:
+*     ResamplePlan
+
+*  Purpose:
+*     Stored interpolation weights for resampling a grid of data.
+
+*  Constructor Function:
+c     astResamplePlan
+
+*  Description:
+*     A ResamplePlan records the interpolation weights that
+c     astResample<X>
+*     would use to resample a grid of data values, using a given
+*     Mapping, sub-pixel interpolation scheme and set of grid bounds.
+*     The weights are found once, when the ResamplePlan is created, and
+*     form a sparse matrix which connects each output pixel to the
+*     input pixels that contribute to it. The ResamplePlan may then be
+*     applied to any number of data (and variance) arrays that share
+*     the same geometry, using
+c     astApplyPlan<X>.
+*     No coordinates are transformed, and no interpolation kernels
+*     are evaluated, when a ResamplePlan is applied, so this is much
+*     faster than calling
+c     astResample<X>
+*     repeatedly when many arrays (for instance, many planes of a
+*     cube, or many observations of the same field) are to be resampled
+*     in the same way.
+*
+*     The ResamplePlan does not retain any reference to the Mapping
+*     from which it was created.
+
+*  Inheritance:
+*     The ResamplePlan class inherits from the Object class.
+
+*  Attributes:
+*     The ResamplePlan class does not define any new attributes beyond
+*     those which are applicable to all Objects.
+
+*  Functions:
+c     In addition to those functions applicable to all Objects, the
+c     following functions may also be applied to all ResamplePlans:
+*
+c     - astApplyPlan<X>: Resample a grid of data values using a ResamplePlan
+c     - astPlanBounds: Return the bounds of the grids described by a
+c     ResamplePlan
+
+*  Copyright:
+*     Copyright (C) 2026 Science & Technology Facilities Council.
+
+*  Licence:
+*     This program is free software: you can redistribute it and/or
+*     modify it under the terms of the GNU Lesser General Public
+*     License as published by the Free Software Foundation, either
+*     version 3 of the License, or (at your option) any later
+*     version.
+*
+*     This program is distributed in the hope that it will be useful,
+*     but WITHOUT ANY WARRANTY; without even the implied warranty of
+*     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*     GNU Lesser General Public License for more details.
+*
+*     You should have received a copy of the GNU Lesser General
+*     License along with this program.  If not, see
+*     <http://www.gnu.org/licenses/>.
+
+*  Authors:
+*     DSB: D.S. Berry (Starlink)
+
+*  History:
+*     16-OCT-2026 (DSB):
+*        Original version.
+*class--
+*/
+
+/* Module Macros. */
+/* ============== */
+/* Set the name of the class we are implementing. This indicates to
+   the header files that define class interfaces that they should make
+   "protected" symbols available. */
+#define astCLASS ResamplePlan
+
+/* The number of output pixels in each of the blocks that are resampled
+   in parallel by astApplyPlan<X>. */
+#define MXPIX ( 16*1024 )
+
+/* Include files. */
+/* ============== */
+/* Interface definitions. */
+/* ---------------------- */
+
+#include "globals.h"             /* Thread-safe global data access */
+#include "error.h"               /* Error reporting facilities */
+#include "memory.h"              /* Memory allocation facilities */
+#include "object.h"              /* Base Object class */
+#include "mapping.h"             /* Coordinate Mappings */
+#include "channel.h"             /* I/O channels */
+#include "threads.h"             /* Pool of worker threads */
+#include "resampleplan.h"        /* Interface definition for this class */
+
+/* Error code definitions. */
+/* ----------------------- */
+#include "ast_err.h"             /* AST error codes */
+
+/* C header files. */
+/* --------------- */
+#include <float.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Type Definitions. */
+/* ================= */
+/* Structure holding the information shared by the tasks performed by
+   astApplyPlan<X>. Each task resamples one block of MXPIX output
+   pixels. */
+typedef struct ApplyJob {
+   AstResamplePlan *plan;        /* The ResamplePlan being applied */
+   const void *badval_ptr;       /* Pointer to the bad value */
+   const void *in;               /* Input data array */
+   const void *in_var;           /* Input variance array */
+   int *nbad;                    /* No. of bad output values in each block */
+   int flags;                    /* Flags supplied to astApplyPlan<X> */
+   void *out;                    /* Output data array */
+   void *out_var;                /* Output variance array */
+} ApplyJob;
+
+/* Module Variables. */
+/* ================= */
+
+/* Address of this static variable is used as a unique identifier for
+   member of this class. */
+static int class_check;
+
+/* Pointers to parent class methods which are extended by this class. */
+static int (* parent_getobjsize)( AstObject *, int * );
+
+/* Define macros for accessing each item of thread specific global data. */
+#ifdef THREAD_SAFE
+
+/* Define how to initialise thread-specific globals. */
+#define GLOBAL_inits \
+   globals->Class_Init = 0;
+
+/* Create the function that initialises global data for this module. */
+astMAKE_INITGLOBALS(ResamplePlan)
+
+/* Define macros for accessing each item of thread specific global data. */
+#define class_init astGLOBAL(ResamplePlan,Class_Init)
+#define class_vtab astGLOBAL(ResamplePlan,Class_Vtab)
+
+/* If thread safety is not needed, declare and initialise globals at static
+   variables. */
+#else
+
+/* Define the class virtual function table and its initialisation flag
+   as static variables. */
+static AstResamplePlanVtab class_vtab;   /* Virtual function table */
+static int class_init = 0;       /* Virtual function table initialised? */
+
+#endif
+
+/* External Interface Function Prototypes. */
+/* ======================================= */
+/* The following functions have public prototypes only (i.e. no
+   protected prototypes), so we must provide local prototypes for use
+   within this module. */
+AstResamplePlan *astResamplePlanId_( void *, int, const int [], const int [], int, const double [], double, int, int, const int [], const int [], const int [], const int [], const char *, ... );
+
+/* Prototypes for Private Member Functions. */
+/* ======================================== */
+#define DECLARE_GENERIC(X,Xtype) \
+static int ApplyPlan##X( AstResamplePlan *, const Xtype [], const Xtype [], int, Xtype, Xtype [], Xtype [], int * ); \
+static void ApplyPlanTask##X( void *, int, int, int * );
+
+DECLARE_GENERIC(B,signed char)
+DECLARE_GENERIC(D,double)
+DECLARE_GENERIC(F,float)
+DECLARE_GENERIC(I,int)
+DECLARE_GENERIC(K,INT_BIG)
+DECLARE_GENERIC(L,long int)
+DECLARE_GENERIC(S,short int)
+DECLARE_GENERIC(UB,unsigned char)
+DECLARE_GENERIC(UI,unsigned int)
+DECLARE_GENERIC(UK,UINT_BIG)
+DECLARE_GENERIC(UL,unsigned long int)
+DECLARE_GENERIC(US,unsigned short int)
+
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+DECLARE_GENERIC(LD,long double)
+#endif
+
+#undef DECLARE_GENERIC
+
+static int GetObjSize( AstObject *, int * );
+static int PlanBounds( AstResamplePlan *, int, int [], int [], int * );
+static void Copy( const AstObject *, AstObject *, int * );
+static void Delete( AstObject *, int * );
+static void Dump( AstObject *, AstChannel *, int * );
+
+/* Member functions. */
+/* ================= */
+/*
+*++
+*  Name:
+c     astApplyPlan<X>
+
+*  Purpose:
+*     Resample a grid of data values using a ResamplePlan.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "resampleplan.h"
+c     int astApplyPlan<X>( AstResamplePlan *this, const <Xtype> in[],
+c                          const <Xtype> in_var[], int flags,
+c                          <Xtype> badval, <Xtype> out[],
+c                          <Xtype> out_var[] );
+
+*  Class Membership:
+*     ResamplePlan method.
+
+*  Description:
+*     This is a set of functions for resampling gridded data (e.g. an
+*     image) using the interpolation weights stored in a ResamplePlan.
+*     The result is the same as would be obtained by invoking
+c     astResample<X>
+*     with the same arguments as were used to create the ResamplePlan,
+*     but no coordinates are transformed, and no interpolation kernels
+*     are evaluated. Only the output pixels within the region of the
+*     output grid that was specified when the ResamplePlan was created
+*     are assigned new values.
+*
+*     You should use an ApplyPlan function which matches the numerical
+*     type of the data you are processing by replacing <X> in
+*     the generic function name astApplyPlan<X> by an appropriate 1- or
+*     2-character type code. For example, if you are resampling data
+*     with type "float", you should use the function astApplyPlanF (see
+*     the "Data Type Codes" section below for the codes appropriate to
+*     other numerical types).
+
+*  Parameters:
+c     this
+*        Pointer to a ResamplePlan.
+c     in
+*        Pointer to an array, with one element for each pixel in the
+*        input grid described by the ResamplePlan, containing the input
+*        data to be resampled.  The numerical type of this array
+*        should match the 1- or 2-character type code appended to the
+*        function name (e.g. if you are using astApplyPlanF, the type
+*        of each array element should be "float").
+*
+*        The storage order of data within this array should be such
+*        that the index of the first grid dimension varies most
+*        rapidly and that of the final dimension least rapidly
+*        (i.e. Fortran array indexing is used).
+c     in_var
+*        An optional pointer to a second array with the same size and
+*        type as the
+c        "in"
+*        array. If given, this should contain a set of non-negative values
+*        which represent estimates of the statistical variance associated
+*        with each element of the
+c        "in"
+*        array. If this array is supplied (together with the corresponding
+c        "out_var"
+*        array), then estimates of the variance of the resampled output data
+*        will be calculated.
+*
+c        If no input variance estimates are being provided, a NULL
+c        pointer should be given.
+c     flags
+*        The bitwise OR of a set of flag values which may be used to
+*        provide additional control over the resampling operation. The
+*        AST__USEBAD and AST__NOBAD flags have the same meanings as
+*        for
+c        astResample<X>.
+*        The AST__CONSERVEFLUX flag is not supported (an error will be
+*        reported if it is given), and all other flags are ignored.
+c     badval
+*        This argument should have the same type as the elements of
+c        the "in" array.
+*        It specifies the value used to flag missing data
+*        (bad pixels) in the input and output arrays.
+c     out
+*        Pointer to an array, with one element for each pixel in the
+*        output grid described by the ResamplePlan, into which the
+*        resampled data values will be returned. The numerical type of
+*        this array should match that of the
+c        "in"
+*        array, and the data storage order should be such that the
+*        index of the first grid dimension varies most rapidly and
+*        that of the final dimension least rapidly (i.e. Fortran
+*        array indexing is used).
+c     out_var
+*        An optional pointer to an array with the same type and size
+*        as the
+c        "out"
+*        array. If given, this array will be used to return variance
+*        estimates for the resampled data values. This array will only
+*        be used if the
+c        "in_var"
+*        array has also been supplied.
+*
+c        If no output variance estimates are required, a NULL pointer
+c        should be given.
+
+*  Returned Value:
+c     astApplyPlan<X>()
+*        The number of output pixels for which no valid resampled value
+*        could be obtained. Thus, in the absence of any error, a returned
+*        value of zero indicates that all the required output pixels
+*        received valid resampled data values (and variances).
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the AST error status set, or if it should fail for any
+*     reason.
+*     - This function is not available in the FORTRAN 77 interface to
+*     the AST library.
+
+*  Data Type Codes:
+*     To select the appropriate resampling function, you should
+c     replace <X> in the generic function name astApplyPlan<X> with a
+*     1- or 2-character data type code, so as to match the numerical
+*     type <Xtype> of the data you are processing, as follows:
+c     - D: double
+c     - F: float
+c     - L: long int
+c     - UL: unsigned long int
+c     - K: int64
+c     - UK: uint64
+c     - I: int
+c     - UI: unsigned int
+c     - S: short int
+c     - US: unsigned short int
+c     - B: byte (signed char)
+c     - UB: unsigned byte (unsigned char)
+*
+c     For example, astApplyPlanD would be used to process "double"
+c     data, while astApplyPlanS would be used to process "short int"
+c     data, etc.
+*--
+*/
+/* Define a macro to implement the function for a specific data
+   type. */
+#define MAKE_APPLYPLAN(X,Xtype,Xfloating,Xfloattype,Xsigned) \
+static void ApplyPlanTask##X( void *data, int itask, int iworker, \
+                              int *status ) { \
+\
+/* Local Variables: */ \
+   ApplyJob *job;                /* Description of the whole job */ \
+   AstResamplePlan *this;        /* The ResamplePlan */ \
+   Xfloattype hi_lim;            /* Upper limit on output values */ \
+   Xfloattype lo_lim;            /* Lower limit on output values */ \
+   Xfloattype sum;               /* Weighted sum of pixel data values */ \
+   Xfloattype sum_var;           /* Weighted sum of pixel variance values */ \
+   Xfloattype val;               /* Data value to be assigned to output */ \
+   Xfloattype val_var;           /* Variance to be assigned to output */ \
+   Xfloattype wtsum;             /* Sum of weight values */ \
+   Xfloattype wtsum_sq;          /* Square of sum of weights */ \
+   Xtype *out;                   /* Output data array */ \
+   Xtype *out_var;               /* Output variance array */ \
+   Xtype badval;                 /* Bad value */ \
+   Xtype var;                    /* Variance value */ \
+   const Xtype *in;              /* Input data array */ \
+   const Xtype *in_var;          /* Input variance array */ \
+   double wt;                    /* Weight of current input pixel */ \
+   int bad;                      /* Output pixel bad? */ \
+   int bad_var;                  /* Output variance bad? */ \
+   int hi;                       /* Index of last pixel in block, plus one */ \
+   int hi_wt;                    /* Index of last weight for pixel, plus one */ \
+   int ipix;                     /* Index of current planned pixel */ \
+   int iwt;                      /* Index of current weight */ \
+   int nobad;                    /* Was the AST__NOBAD flag set? */ \
+   int off_in;                   /* Offset to input pixel */ \
+   int off_out;                  /* Offset to output pixel */ \
+   int result;                   /* Number of bad output values */ \
+   int usebad;                   /* Use "bad" input pixel values? */ \
+   int usevar;                   /* Process variance array? */ \
+\
+/* Check the global error status. */ \
+   if ( !astOK ) return; \
+\
+/* Get a pointer to the job details, and the arrays being processed. */ \
+   job = (ApplyJob *) data; \
+   this = job->plan; \
+   in = (const Xtype *) job->in; \
+   in_var = (const Xtype *) job->in_var; \
+   out = (Xtype *) job->out; \
+   out_var = (Xtype *) job->out_var; \
+   badval = *( (const Xtype *) job->badval_ptr ); \
+\
+/* Determine if we are processing bad pixels or variances. */ \
+   nobad = job->flags & AST__NOBAD; \
+   usebad = job->flags & AST__USEBAD; \
+   usevar = in_var && out_var; \
+\
+/* Set up limits for checking output values to ensure that they do not \
+   overflow the range of the data type being used. */ \
+   lo_lim = LO_##X; \
+   hi_lim = HI_##X; \
+\
+/* Further initialisation. */ \
+   result = 0; \
+   val = 0; \
+   val_var = 0; \
+   bad_var = 0; \
+\
+/* Loop round each output pixel in the block. */ \
+   hi = ( itask + 1 )*MXPIX; \
+   if ( hi > this->npix ) hi = this->npix; \
+   for ( ipix = itask*MXPIX; ipix < hi; ipix++ ) { \
+      off_out = this->outpix[ ipix ]; \
+\
+/* The output pixel is bad if the output position does not fall within \
+   the input grid, or (if required) if the input pixel that contains it \
+   is bad. */ \
+      off_in = this->centre[ ipix ]; \
+      bad = ( off_in < 0 ) || ( usebad && ( in[ off_in ] == badval ) ); \
+      if ( usevar ) bad_var = bad; \
+\
+/* If the output pixel is formed from a single input pixel with unit \
+   weight (as is always the case for nearest-neighbour interpolation), \
+   simply copy the input value and variance. */ \
+      if ( !bad ) { \
+         iwt = this->start[ ipix ]; \
+         hi_wt = this->start[ ipix + 1 ]; \
+         if ( hi_wt == iwt + 1 && this->weight[ iwt ] == 1.0 ) { \
+            off_in = this->inpix[ iwt ]; \
+            out[ off_out ] = in[ off_in ]; \
+            if ( usevar ) { \
+               var = in_var[ off_in ]; \
+               if ( usebad ) bad_var = ( var == badval ); \
+               CHECK_FOR_NEGATIVE_VARIANCE(Xtype) \
+               if ( bad_var ) { \
+                  if ( !nobad ) out_var[ off_out ] = badval; \
+                  result++; \
+               } else { \
+                  out_var[ off_out ] = var; \
+               } \
+            } \
+            continue; \
+         } \
+\
+/* Otherwise, form the weighted sums over the good input pixels that \
+   contribute to the output pixel. */ \
+         sum = (Xfloattype) 0.0; \
+         wtsum = (Xfloattype) 0.0; \
+         sum_var = (Xfloattype) 0.0; \
+         for ( ; iwt < hi_wt; iwt++ ) { \
+            off_in = this->inpix[ iwt ]; \
+            if ( !usebad || ( in[ off_in ] != badval ) ) { \
+               wt = this->weight[ iwt ]; \
+               sum += ( (Xfloattype) wt ) * ( (Xfloattype) in[ off_in ] ); \
+               wtsum += (Xfloattype) wt; \
+\
+/* If a variance estimate is required and it still seems possible to \
+   obtain one, include the variance of the current input pixel. */ \
+               if ( usevar && !bad_var ) { \
+                  var = in_var[ off_in ]; \
+                  if ( usebad ) bad_var = ( var == badval ); \
+                  CHECK_FOR_NEGATIVE_VARIANCE(Xtype) \
+                  if ( !bad_var ) { \
+                     sum_var += ( (Xfloattype) ( wt * wt ) ) * \
+                                ( (Xfloattype) var ); \
+                  } \
+               } \
+            } \
+         } \
+\
+/* Check that an interpolated value can be produced, and that it does \
+   not overflow the output data type. */ \
+         bad = ( wtsum == (Xfloattype) 0.0 ); \
+         if ( !bad ) { \
+            val = sum / wtsum; \
+            if ( !( Xfloating ) ) { \
+               bad = ( val <= lo_lim ) || ( val >= hi_lim ); \
+            } \
+         } \
+         if ( usevar && bad ) bad_var = 1; \
+\
+/* Perform similar checks on the output variance value. */ \
+         if ( usevar && !bad_var ) { \
+            wtsum_sq = wtsum * wtsum; \
+            bad_var = ( wtsum_sq == (Xfloattype) 0.0 ); \
+            if ( !bad_var ) { \
+               val_var = sum_var / wtsum_sq; \
+               if ( !( Xfloating ) ) { \
+                  bad_var = ( val_var <= lo_lim ) || ( val_var >= hi_lim ); \
+               } \
+            } \
+         } \
+      } \
+\
+/* Assign a bad output value (and variance) if required and count it. */ \
+      if ( bad ) { \
+         if ( !nobad ) { \
+            out[ off_out ] = badval; \
+            if ( usevar ) out_var[ off_out ] = badval; \
+         } \
+         result++; \
+\
+/* Otherwise, assign the interpolated value, rounding to the nearest \
+   integer if necessary. */ \
+      } else { \
+         if ( Xfloating ) { \
+            out[ off_out ] = (Xtype) val; \
+         } else { \
+            out[ off_out ] = (Xtype) ( val + ( ( val >= (Xfloattype) 0.0 ) ? \
+                                               ( (Xfloattype) 0.5 ) : \
+                                               ( (Xfloattype) -0.5 ) ) ); \
+         } \
+\
+/* Similarly assign the variance, if required. */ \
+         if ( usevar ) { \
+            if ( bad_var ) { \
+               if ( !nobad ) out_var[ off_out ] = badval; \
+               result++; \
+            } else if ( Xfloating ) { \
+               out_var[ off_out ] = (Xtype) val_var; \
+            } else { \
+               out_var[ off_out ] = (Xtype) ( val_var + \
+                                          ( ( val_var >= (Xfloattype) 0.0 ) ? \
+                                            ( (Xfloattype) 0.5 ) : \
+                                            ( (Xfloattype) -0.5 ) ) ); \
+            } \
+         } \
+      } \
+   } \
+\
+/* Store the number of bad output values in the block. */ \
+   job->nbad[ itask ] = result; \
+} \
+\
+static int ApplyPlan##X( AstResamplePlan *this, const Xtype in[], \
+                         const Xtype in_var[], int flags, Xtype badval, \
+                         Xtype out[], Xtype out_var[], int *status ) { \
+\
+/* Local Variables: */ \
+   ApplyJob job;                 /* Information shared by all tasks */ \
+   int iblock;                   /* Block index */ \
+   int nblock;                   /* Number of blocks of output pixels */ \
+   int nworker;                  /* Number of workers to use */ \
+   int result;                   /* Result value to return */ \
+\
+/* Initialise. */ \
+   result = 0; \
+\
+/* Check the global error status. */ \
+   if ( !astOK ) return result; \
+\
+/* The weights stored in a ResamplePlan do not include the change in \
+   pixel size needed to conserve flux, so report an error if flux \
+   conservation is requested. */ \
+   if ( flags & AST__CONSERVEFLUX ) { \
+      astError( AST__CNFLX, "astApplyPlan" #X "(%s): Flux conservation " \
+                "was requested but cannot be performed by a %s.", status, \
+                astGetClass( this ), astGetClass( this ) ); \
+      return result; \
+   } \
+\
+/* Divide the planned output pixels into blocks, and resample the blocks \
+   in parallel. */ \
+   nblock = ( this->npix + MXPIX - 1 )/MXPIX; \
+   nworker = astTaskWorkers( nblock ); \
+   job.nbad = astCalloc( (size_t) nblock, sizeof( int ) ); \
+   if ( astOK && nblock > 0 ) { \
+      job.plan = this; \
+      job.badval_ptr = &badval; \
+      job.in = in; \
+      job.in_var = in_var; \
+      job.flags = flags; \
+      job.out = out; \
+      job.out_var = out_var; \
+      astRunTasks( nblock, nworker, ApplyPlanTask##X, &job ); \
+\
+/* Sum the numbers of bad output values. */ \
+      for ( iblock = 0; iblock < nblock; iblock++ ) { \
+         result += job.nbad[ iblock ]; \
+      } \
+   } \
+   job.nbad = astFree( job.nbad ); \
+\
+/* If an error occurred, clear the returned result. */ \
+   if ( !astOK ) result = 0; \
+\
+/* Return the result. */ \
+   return result; \
+}
+
+/* These subsidiary macros define limits for range checking of results
+   before conversion to the final data type. They are the same as those
+   used by astResample<X> in the Mapping class. For each data type code
+   <X>, HI_<X> gives the least positive floating point value which just
+   overflows that data type towards plus infinity, while LO_<X> gives
+   the least negative floating point value which just overflows that
+   data type towards minus infinity. */
+
+/* If <X> is a floating point type, the limits are not actually used,
+   but must be present to permit error-free compilation. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+#define HI_LD ( 0.0L )
+#define LO_LD ( 0.0L )
+#endif
+#define HI_D ( 0.0 )
+#define LO_D ( 0.0 )
+#define HI_F ( 0.0f )
+#define LO_F ( 0.0f )
+
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+#define HI_K   ( 0.5L + (long double) LONG_MAX )
+#define LO_K  ( -0.5L + (long double) LONG_MIN )
+#define HI_UK  ( 0.5L + (long double) ULONG_MAX )
+#define LO_UK ( -0.5L )
+#define HI_L   ( 0.5L + (long double) LONG_MAX )
+#define LO_L  ( -0.5L + (long double) LONG_MIN )
+#define HI_UL  ( 0.5L + (long double) ULONG_MAX )
+#define LO_UL ( -0.5L )
+#else
+#define HI_K   ( 0.5 + (double) LONG_MAX )
+#define LO_K  ( -0.5 + (double) LONG_MIN )
+#define HI_UK  ( 0.5 + (double) ULONG_MAX )
+#define LO_UK ( -0.5 )
+#define HI_L   ( 0.5 + (double) LONG_MAX )
+#define LO_L  ( -0.5 + (double) LONG_MIN )
+#define HI_UL  ( 0.5 + (double) ULONG_MAX )
+#define LO_UL ( -0.5 )
+#endif
+#define HI_I   ( 0.5 + (double) INT_MAX )
+#define LO_I  ( -0.5 + (double) INT_MIN )
+#define HI_UI  ( 0.5 + (double) UINT_MAX )
+#define LO_UI ( -0.5 )
+#define HI_S   ( 0.5f + (float) SHRT_MAX )
+#define LO_S  ( -0.5f + (float) SHRT_MIN )
+#define HI_US  ( 0.5f + (float) USHRT_MAX )
+#define LO_US ( -0.5f )
+#define HI_B   ( 0.5f + (float) SCHAR_MAX )
+#define LO_B  ( -0.5f + (float) SCHAR_MIN )
+#define HI_UB  ( 0.5f + (float) UCHAR_MAX )
+#define LO_UB ( -0.5f )
+
+/* This subsidiary macro tests for negative variance values. This
+   check is required only for signed data types. */
+#define CHECK_FOR_NEGATIVE_VARIANCE(Xtype) \
+   bad_var = bad_var || ( var < ( (Xtype) 0 ) );
+
+/* Expand the main macro above to generate a function for each
+   required signed data type, using the same floating point types for
+   intermediate results as astResample<X>. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_APPLYPLAN(LD,long double,1,long double,1)
+MAKE_APPLYPLAN(L,long int,0,long double,1)
+MAKE_APPLYPLAN(K,INT_BIG,0,long double,1)
+#else
+MAKE_APPLYPLAN(L,long int,0,double,1)
+MAKE_APPLYPLAN(K,INT_BIG,0,double,1)
+#endif
+MAKE_APPLYPLAN(D,double,1,double,1)
+MAKE_APPLYPLAN(F,float,1,float,1)
+MAKE_APPLYPLAN(I,int,0,double,1)
+MAKE_APPLYPLAN(S,short int,0,float,1)
+MAKE_APPLYPLAN(B,signed char,0,float,1)
+
+/* Re-define the macro for testing for negative variances to do
+   nothing. */
+#undef CHECK_FOR_NEGATIVE_VARIANCE
+#define CHECK_FOR_NEGATIVE_VARIANCE(Xtype)
+
+/* Expand the main macro above to generate a function for each
+   required unsigned data type. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_APPLYPLAN(UL,unsigned long int,0,long double,0)
+MAKE_APPLYPLAN(UK,UINT_BIG,0,long double,0)
+#else
+MAKE_APPLYPLAN(UL,unsigned long int,0,double,0)
+MAKE_APPLYPLAN(UK,UINT_BIG,0,double,0)
+#endif
+MAKE_APPLYPLAN(UI,unsigned int,0,double,0)
+MAKE_APPLYPLAN(US,unsigned short int,0,float,0)
+MAKE_APPLYPLAN(UB,unsigned char,0,float,0)
+
+/* Undefine the macros used above. */
+#undef CHECK_FOR_NEGATIVE_VARIANCE
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+#undef HI_LD
+#undef LO_LD
+#endif
+#undef HI_D
+#undef LO_D
+#undef HI_F
+#undef LO_F
+#undef HI_L
+#undef LO_L
+#undef HI_UL
+#undef LO_UL
+#undef HI_K
+#undef LO_K
+#undef HI_UK
+#undef LO_UK
+#undef HI_I
+#undef LO_I
+#undef HI_UI
+#undef LO_UI
+#undef HI_S
+#undef LO_S
+#undef HI_US
+#undef LO_US
+#undef HI_B
+#undef LO_B
+#undef HI_UB
+#undef LO_UB
+#undef MAKE_APPLYPLAN
+
+static int GetObjSize( AstObject *this_object, int *status ) {
+/*
+*  Name:
+*     GetObjSize
+
+*  Purpose:
+*     Return the in-memory size of an Object.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "resampleplan.h"
+*     int GetObjSize( AstObject *this, int *status )
+
+*  Class Membership:
+*     ResamplePlan member function (over-rides the astGetObjSize protected
+*     method inherited from the Object class).
+
+*  Description:
+*     This function returns the in-memory size of the supplied
+*     ResamplePlan, in bytes.
+
+*  Parameters:
+*     this
+*        Pointer to the ResamplePlan.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The Object size, in bytes.
+
+*  Notes:
+*     - A value of zero will be returned if this function is invoked
+*     with the global status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstResamplePlan *this;     /* Pointer to ResamplePlan structure */
+   int result;                /* Result value to return */
+
+/* Initialise. */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Obtain a pointer to the ResamplePlan structure. */
+   this = (AstResamplePlan *) this_object;
+
+/* Invoke the GetObjSize method inherited from the parent class, and then
+   add on any components of the class structure defined by this class
+   which are stored in dynamically allocated memory. */
+   result = (*parent_getobjsize)( this_object, status );
+
+   result += astTSizeOf( this->centre );
+   result += astTSizeOf( this->inpix );
+   result += astTSizeOf( this->lbnd_in );
+   result += astTSizeOf( this->lbnd_out );
+   result += astTSizeOf( this->outpix );
+   result += astTSizeOf( this->start );
+   result += astTSizeOf( this->ubnd_in );
+   result += astTSizeOf( this->ubnd_out );
+   result += astTSizeOf( this->weight );
+
+/* If an error occurred, clear the result value. */
+   if ( !astOK ) result = 0;
+
+/* Return the result, */
+   return result;
+}
+
+static int PlanBounds( AstResamplePlan *this, int in, int lbnd[],
+                       int ubnd[], int *status ) {
+/*
+*++
+*  Name:
+c     astPlanBounds
+
+*  Purpose:
+*     Return the bounds of the grids described by a ResamplePlan.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "resampleplan.h"
+c     int astPlanBounds( AstResamplePlan *this, int in, int lbnd[],
+c                        int ubnd[] )
+
+*  Class Membership:
+*     ResamplePlan method.
+
+*  Description:
+*     This function returns the number of dimensions, and optionally
+*     the pixel index bounds, of either the input or the output grid
+*     that was specified when the ResamplePlan was created. These
+*     determine the sizes of the arrays that must be supplied to
+c     astApplyPlan<X>.
+
+*  Parameters:
+c     this
+*        Pointer to the ResamplePlan.
+c     in
+*        If non-zero, the bounds of the input grid are returned.
+*        Otherwise, the bounds of the output grid are returned.
+c     lbnd
+c        Pointer to an array in which to return the lower pixel index
+c        bound of the grid on each dimension. It should have at least
+c        as many elements as the number of grid dimensions. A NULL
+c        pointer may be supplied if the bounds are not required.
+c     ubnd
+c        Pointer to an array in which to return the upper pixel index
+c        bound of the grid on each dimension. It should have at least
+c        as many elements as the number of grid dimensions. A NULL
+c        pointer may be supplied if the bounds are not required.
+
+*  Returned Value:
+c     astPlanBounds()
+*        The number of dimensions in the grid.
+
+*  Notes:
+*     - Calling this function first with NULL
+c     "lbnd" and "ubnd"
+*     pointers is a convenient way of finding how large the arrays
+*     must be.
+*     - A value of zero will be returned if this function is invoked
+*     with the AST error status set, or if it should fail for any
+*     reason.
+*     - This function is not available in the FORTRAN 77 interface to
+*     the AST library.
+*--
+*/
+
+/* Local Variables: */
+   const int *lb;                /* Lower bounds to return */
+   const int *ub;                /* Upper bounds to return */
+   int result;                   /* Returned number of dimensions */
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Select the required grid. */
+   if ( in ) {
+      result = this->ndim_in;
+      lb = this->lbnd_in;
+      ub = this->ubnd_in;
+   } else {
+      result = this->ndim_out;
+      lb = this->lbnd_out;
+      ub = this->ubnd_out;
+   }
+
+/* Copy the bounds, if required. */
+   if ( lbnd ) memcpy( lbnd, lb, sizeof( int )*(size_t) result );
+   if ( ubnd ) memcpy( ubnd, ub, sizeof( int )*(size_t) result );
+
+/* Return the result. */
+   return result;
+}
+
+void astInitResamplePlanVtab_(  AstResamplePlanVtab *vtab, const char *name, int *status ) {
+/*
+*+
+*  Name:
+*     astInitResamplePlanVtab
+
+*  Purpose:
+*     Initialise a virtual function table for a ResamplePlan.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "resampleplan.h"
+*     void astInitResamplePlanVtab( AstResamplePlanVtab *vtab, const char *name )
+
+*  Class Membership:
+*     ResamplePlan vtab initialiser.
+
+*  Description:
+*     This function initialises the component of a virtual function
+*     table which is used by the ResamplePlan class.
+
+*  Parameters:
+*     vtab
+*        Pointer to the virtual function table. The components used by
+*        all ancestral classes will be initialised if they have not already
+*        been initialised.
+*     name
+*        Pointer to a constant null-terminated character string which contains
+*        the name of the class to which the virtual function table belongs (it
+*        is this pointer value that will subsequently be returned by the Object
+*        astClass function).
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   AstObjectVtab *object;        /* Pointer to Object component of Vtab */
+
+/* Check the local error status. */
+   if ( !astOK ) return;
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Initialize the component of the virtual function table used by the
+   parent class. */
+   astInitObjectVtab( (AstObjectVtab *) vtab, name );
+
+/* Store a unique "magic" value in the virtual function table. This
+   will be used (by astIsAResamplePlan) to determine if an object belongs
+   to this class.  We can conveniently use the address of the (static)
+   class_check variable to generate this unique value. */
+   vtab->id.check = &class_check;
+   vtab->id.parent = &(((AstObjectVtab *) vtab)->id);
+
+/* Initialise member function pointers. */
+/* ------------------------------------ */
+/* Store pointers to the member functions (implemented here) that
+   provide virtual methods for this class. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+   vtab->ApplyPlanLD = ApplyPlanLD;
+#endif
+   vtab->ApplyPlanB = ApplyPlanB;
+   vtab->ApplyPlanD = ApplyPlanD;
+   vtab->ApplyPlanF = ApplyPlanF;
+   vtab->ApplyPlanI = ApplyPlanI;
+   vtab->ApplyPlanK = ApplyPlanK;
+   vtab->ApplyPlanL = ApplyPlanL;
+   vtab->ApplyPlanS = ApplyPlanS;
+   vtab->ApplyPlanUB = ApplyPlanUB;
+   vtab->ApplyPlanUI = ApplyPlanUI;
+   vtab->ApplyPlanUK = ApplyPlanUK;
+   vtab->ApplyPlanUL = ApplyPlanUL;
+   vtab->ApplyPlanUS = ApplyPlanUS;
+   vtab->PlanBounds = PlanBounds;
+
+/* Save the inherited pointers to methods that will be extended, and
+   replace them with pointers to the new member functions. */
+   object = (AstObjectVtab *) vtab;
+
+   parent_getobjsize = object->GetObjSize;
+   object->GetObjSize = GetObjSize;
+
+/* Declare the copy constructor, destructor and class dump function. */
+   astSetCopy( vtab, Copy );
+   astSetDelete( vtab, Delete );
+   astSetDump( vtab, Dump, "ResamplePlan",
+               "Stored weights for resampling a grid" );
+
+/* If we have just initialised the vtab for the current class, indicate
+   that the vtab is now initialised, and store a pointer to the class
+   identifier in the base "object" level of the vtab. */
+   if( vtab == &class_vtab ) {
+      class_init = 1;
+      astSetVtabClassIdentifier( vtab, &(vtab->id) );
+   }
+}
+
+/* Functions which access class attributes. */
+/* ---------------------------------------- */
+/* None. */
+
+/* Copy constructor. */
+/* ----------------- */
+static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
+/*
+*  Name:
+*     Copy
+
+*  Purpose:
+*     Copy constructor for ResamplePlan objects.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void Copy( const AstObject *objin, AstObject *objout, int *status )
+
+*  Description:
+*     This function implements the copy constructor for ResamplePlan
+*     objects.
+
+*  Parameters:
+*     objin
+*        Pointer to the object to be copied.
+*     objout
+*        Pointer to the object being constructed.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     void
+
+*  Notes:
+*     -  This constructor makes a deep copy, including a copy of the
+*     stored weights.
+*/
+
+/* Local Variables: */
+   AstResamplePlan *in;          /* Pointer to input ResamplePlan */
+   AstResamplePlan *out;         /* Pointer to output ResamplePlan */
+   size_t nwt;                   /* Number of stored weights */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Obtain pointers to the input and output ResamplePlans. */
+   in = (AstResamplePlan *) objin;
+   out = (AstResamplePlan *) objout;
+
+/* For safety, first clear any references to the input arrays from the
+   output ResamplePlan. */
+   out->centre = NULL;
+   out->inpix = NULL;
+   out->lbnd_in = NULL;
+   out->lbnd_out = NULL;
+   out->outpix = NULL;
+   out->start = NULL;
+   out->ubnd_in = NULL;
+   out->ubnd_out = NULL;
+   out->weight = NULL;
+
+/* Copy the grid bounds. */
+   out->lbnd_in = astStore( NULL, in->lbnd_in,
+                            sizeof( int )*(size_t) in->ndim_in );
+   out->ubnd_in = astStore( NULL, in->ubnd_in,
+                            sizeof( int )*(size_t) in->ndim_in );
+   out->lbnd_out = astStore( NULL, in->lbnd_out,
+                             sizeof( int )*(size_t) in->ndim_out );
+   out->ubnd_out = astStore( NULL, in->ubnd_out,
+                             sizeof( int )*(size_t) in->ndim_out );
+
+/* Copy the arrays that describe each planned output pixel. */
+   out->outpix = astStore( NULL, in->outpix,
+                           sizeof( int )*(size_t) in->npix );
+   out->centre = astStore( NULL, in->centre,
+                           sizeof( int )*(size_t) in->npix );
+   out->start = astStore( NULL, in->start,
+                          sizeof( int )*(size_t) ( in->npix + 1 ) );
+
+/* Copy the weights (there may be none if no output position falls
+   within the input grid). */
+   if ( in->weight ) {
+      nwt = (size_t) in->start[ in->npix ];
+      out->inpix = astStore( NULL, in->inpix, sizeof( int )*nwt );
+      out->weight = astStore( NULL, in->weight, sizeof( double )*nwt );
+   }
+}
+
+/* Destructor. */
+/* ----------- */
+static void Delete( AstObject *obj, int *status ) {
+/*
+*  Name:
+*     Delete
+
+*  Purpose:
+*     Destructor for ResamplePlan objects.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void Delete( AstObject *obj, int *status )
+
+*  Description:
+*     This function implements the destructor for ResamplePlan objects.
+
+*  Parameters:
+*     obj
+*        Pointer to the object to be deleted.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     void
+
+*  Notes:
+*     This function attempts to execute even if the global error status is
+*     set.
+*/
+
+/* Local Variables: */
+   AstResamplePlan *this;        /* Pointer to ResamplePlan */
+
+/* Obtain a pointer to the ResamplePlan structure. */
+   this = (AstResamplePlan *) obj;
+
+/* Free the dynamically allocated arrays. */
+   this->centre = astFree( this->centre );
+   this->inpix = astFree( this->inpix );
+   this->lbnd_in = astFree( this->lbnd_in );
+   this->lbnd_out = astFree( this->lbnd_out );
+   this->outpix = astFree( this->outpix );
+   this->start = astFree( this->start );
+   this->ubnd_in = astFree( this->ubnd_in );
+   this->ubnd_out = astFree( this->ubnd_out );
+   this->weight = astFree( this->weight );
+   this->npix = 0;
+}
+
+/* Dump function. */
+/* -------------- */
+static void Dump( AstObject *this_object, AstChannel *channel, int *status ) {
+/*
+*  Name:
+*     Dump
+
+*  Purpose:
+*     Dump function for ResamplePlan objects.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void Dump( AstObject *this, AstChannel *channel, int *status )
+
+*  Description:
+*     This function implements the Dump function which writes out data
+*     for the ResamplePlan class to an output Channel.
+
+*  Parameters:
+*     this
+*        Pointer to the ResamplePlan whose data are being written.
+*     channel
+*        Pointer to the Channel to which the data are being written.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Notes:
+*     - It is not recommended that ResamplePlans describing large
+*     grids be written out, as every weight will be formatted as text
+*     and this will not be very efficient.
+*/
+
+/* Local Constants: */
+#define KEY_LEN 50               /* Maximum length of a keyword */
+
+/* Local Variables: */
+   AstResamplePlan *this;        /* Pointer to the ResamplePlan structure */
+   char key[ KEY_LEN + 1 ];      /* Buffer for keywords */
+   int i;                        /* Loop counter */
+   int nwt;                      /* Number of stored weights */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Obtain a pointer to the ResamplePlan structure. */
+   this = (AstResamplePlan *) this_object;
+   nwt = this->start[ this->npix ];
+
+/* Write out values representing the instance variables for the
+   ResamplePlan class. */
+
+/* Grid dimensions and bounds. */
+/* --------------------------- */
+   astWriteInt( channel, "Ndimin", 1, 1, this->ndim_in,
+                "Number of input grid dimensions" );
+   for ( i = 0; i < this->ndim_in; i++ ) {
+      (void) sprintf( key, "Lbin%d", i + 1 );
+      astWriteInt( channel, key, 1, 1, this->lbnd_in[ i ],
+                   i ? "" : "Input grid bounds..." );
+      (void) sprintf( key, "Ubin%d", i + 1 );
+      astWriteInt( channel, key, 1, 1, this->ubnd_in[ i ], "" );
+   }
+   astWriteInt( channel, "Ndimout", 1, 1, this->ndim_out,
+                "Number of output grid dimensions" );
+   for ( i = 0; i < this->ndim_out; i++ ) {
+      (void) sprintf( key, "Lbout%d", i + 1 );
+      astWriteInt( channel, key, 1, 1, this->lbnd_out[ i ],
+                   i ? "" : "Output grid bounds..." );
+      (void) sprintf( key, "Ubout%d", i + 1 );
+      astWriteInt( channel, key, 1, 1, this->ubnd_out[ i ], "" );
+   }
+
+/* Planned output pixels. */
+/* ---------------------- */
+   astWriteInt( channel, "Npix", 1, 1, this->npix,
+                "Number of planned output pixels" );
+   astWriteInt( channel, "Nwt", 1, 1, nwt, "Number of weights" );
+   for ( i = 0; i < this->npix; i++ ) {
+      (void) sprintf( key, "Op%d", i + 1 );
+      astWriteInt( channel, key, 1, 1, this->outpix[ i ],
+                   i ? "" : "Output pixel offsets..." );
+   }
+   for ( i = 0; i < this->npix; i++ ) {
+      (void) sprintf( key, "Cp%d", i + 1 );
+      astWriteInt( channel, key, 1, 1, this->centre[ i ],
+                   i ? "" : "Offsets of central input pixels..." );
+   }
+   for ( i = 0; i < this->npix; i++ ) {
+      (void) sprintf( key, "St%d", i + 1 );
+      astWriteInt( channel, key, 1, 1, this->start[ i ],
+                   i ? "" : "Index of first weight for each pixel..." );
+   }
+
+/* Weights. */
+/* -------- */
+   for ( i = 0; i < nwt; i++ ) {
+      (void) sprintf( key, "Ip%d", i + 1 );
+      astWriteInt( channel, key, 1, 1, this->inpix[ i ],
+                   i ? "" : "Input pixel offsets..." );
+      (void) sprintf( key, "Wt%d", i + 1 );
+      astWriteDouble( channel, key, 1, 1, this->weight[ i ],
+                      i ? "" : "Weights..." );
+   }
+
+/* Undefine macros local to this function. */
+#undef KEY_LEN
+}
+
+/* Standard class functions. */
+/* ========================= */
+/* Implement the astIsAResamplePlan and astCheckResamplePlan functions
+   using the macros defined for this purpose in the "object.h" header
+   file. */
+astMAKE_ISA(ResamplePlan,Object)
+astMAKE_CHECK(ResamplePlan)
+
+AstResamplePlan *astResamplePlan_( void *map_void, int ndim_in,
+                                   const int lbnd_in[], const int ubnd_in[],
+                                   int interp, const double params[],
+                                   double tol, int maxpix, int ndim_out,
+                                   const int lbnd_out[], const int ubnd_out[],
+                                   const int lbnd[], const int ubnd[],
+                                   const char *options, int *status, ...) {
+/*
+*+
+*  Name:
+*     astResamplePlan
+
+*  Purpose:
+*     Create a ResamplePlan.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "resampleplan.h"
+*     AstResamplePlan *astResamplePlan( AstMapping *map, int ndim_in,
+*                                       const int lbnd_in[],
+*                                       const int ubnd_in[], int interp,
+*                                       const double params[], double tol,
+*                                       int maxpix, int ndim_out,
+*                                       const int lbnd_out[],
+*                                       const int ubnd_out[],
+*                                       const int lbnd[], const int ubnd[],
+*                                       const char *options, ... )
+
+*  Class Membership:
+*     ResamplePlan constructor.
+
+*  Description:
+*     This function creates a new ResamplePlan and optionally initialises
+*     its attributes.
+
+*  Parameters:
+*     map
+*        Pointer to the Mapping that will be used to resample the data.
+*     ndim_in
+*        The number of dimensions in the input grid.
+*     lbnd_in
+*        The lower pixel index bounds of the input grid.
+*     ubnd_in
+*        The upper pixel index bounds of the input grid.
+*     interp
+*        The sub-pixel interpolation scheme.
+*     params
+*        Optional parameters for the interpolation scheme.
+*     tol
+*        The maximum tolerable geometrical distortion (in input grid
+*        pixels) which may be introduced by approximating the Mapping
+*        with piece-wise linear transformations.
+*     maxpix
+*        The initial scale size (in pixels) used when approximating the
+*        Mapping with piece-wise linear transformations.
+*     ndim_out
+*        The number of dimensions in the output grid.
+*     lbnd_out
+*        The lower pixel index bounds of the output grid.
+*     ubnd_out
+*        The upper pixel index bounds of the output grid.
+*     lbnd
+*        The lower pixel index bounds of the section of the output grid
+*        to be resampled.
+*     ubnd
+*        The upper pixel index bounds of the section of the output grid
+*        to be resampled.
+*     options
+*        Pointer to a null terminated string containing an optional
+*        comma-separated list of attribute assignments to be used for
+*        initialising the new ResamplePlan. The syntax used is the same
+*        as for the astSet method and may include "printf" format
+*        specifiers identified by "%" symbols in the normal way.
+*     status
+*        Pointer to the inherited status variable.
+*     ...
+*        If the "options" string contains "%" format specifiers, then
+*        an optional list of arguments may follow it in order to
+*        supply values to be substituted for these specifiers. The
+*        rules for supplying these are identical to those for the
+*        astSet method (and for the C "printf" function).
+
+*  Returned Value:
+*     A pointer to the new ResamplePlan.
+
+*  Notes:
+*     - See astResamplePlanId_ for a full description of the arguments.
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*-
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   AstMapping *map;              /* Pointer to the Mapping structure */
+   AstResamplePlan *new;         /* Pointer to new ResamplePlan */
+   va_list args;                 /* Variable argument list */
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Initialise. */
+   new = NULL;
+
+/* Check the global status. */
+   if ( !astOK ) return new;
+
+/* Obtain and validate a pointer to the Mapping structure provided. */
+   map = astCheckMapping( map_void );
+   if ( astOK ) {
+
+/* Initialise the ResamplePlan, allocating memory and initialising the
+   virtual function table as well if necessary. */
+      new = astInitResamplePlan( NULL, sizeof( AstResamplePlan ),
+                                 !class_init, &class_vtab, "ResamplePlan",
+                                 map, ndim_in, lbnd_in, ubnd_in, interp,
+                                 params, tol, maxpix, ndim_out, lbnd_out,
+                                 ubnd_out, lbnd, ubnd );
+
+/* If successful, note that the virtual function table has been
+   initialised. */
+      if ( astOK ) {
+         class_init = 1;
+
+/* Obtain the variable argument list and pass it along with the
+   options string to the astVSet method to initialise the new
+   ResamplePlan's attributes. */
+         va_start( args, status );
+         astVSet( new, options, NULL, args );
+         va_end( args );
+
+/* If an error occurred, clean up by deleting the new object. */
+         if ( !astOK ) new = astDelete( new );
+      }
+   }
+
+/* Return a pointer to the new ResamplePlan. */
+   return new;
+}
+
+AstResamplePlan *astResamplePlanId_( void *map_void, int ndim_in,
+                                     const int lbnd_in[],
+                                     const int ubnd_in[], int interp,
+                                     const double params[], double tol,
+                                     int maxpix, int ndim_out,
+                                     const int lbnd_out[],
+                                     const int ubnd_out[],
+                                     const int lbnd[], const int ubnd[],
+                                     const char *options, ... ) {
+/*
+c++
+*  Name:
+c     astResamplePlan
+
+*  Purpose:
+*     Create a ResamplePlan.
+
+*  Type:
+*     Public function.
+
+*  Synopsis:
+c     #include "resampleplan.h"
+c     AstResamplePlan *astResamplePlan( AstMapping *map, int ndim_in,
+c                                       const int lbnd_in[],
+c                                       const int ubnd_in[], int interp,
+c                                       const double params[], double tol,
+c                                       int maxpix, int ndim_out,
+c                                       const int lbnd_out[],
+c                                       const int ubnd_out[],
+c                                       const int lbnd[], const int ubnd[],
+c                                       const char *options, ... )
+
+*  Class Membership:
+*     ResamplePlan constructor.
+
+*  Description:
+*     This function creates a new ResamplePlan and optionally initialises
+*     its attributes.
+*
+*     A ResamplePlan records the interpolation weights that
+c     astResample<X>
+*     would use to resample a grid of data values, given the same
+*     Mapping, grid bounds, interpolation scheme and tolerance. The
+*     ResamplePlan may then be applied to any number of data (and
+*     variance) arrays using
+c     astApplyPlan<X>,
+*     without transforming any further coordinates.
+
+*  Parameters:
+c     map
+*        Pointer to a Mapping, whose inverse transformation will be
+*        used to transform the coordinates of pixels in the output
+*        grid into the coordinate system of the input grid. The number
+*        of input coordinates used by this Mapping (as given by its
+*        Nin attribute) should match the number of input grid
+*        dimensions given by the value of
+c        "ndim_in"
+*        below. Similarly, the number of output coordinates (Nout
+*        attribute) should match the number of output grid dimensions
+*        given by
+c        "ndim_out".
+c     ndim_in
+*        The number of dimensions in the input grid. This should be at
+*        least one.
+c     lbnd_in
+*        Pointer to an array of integers, with
+c        "ndim_in"
+*        elements, containing the coordinates of the centre of the
+*        first pixel in the input grid along each dimension.
+c     ubnd_in
+*        Pointer to an array of integers, with
+c        "ndim_in"
+*        elements, containing the coordinates of the centre of the
+*        last pixel in the input grid along each dimension.
+c     interp
+*        This parameter specifies the scheme to be used for
+*        interpolating between pixels in the input grid to find the
+*        data value at the position of each output pixel. Any of the
+*        schemes that
+c        astResample<X>
+*        supports may be used except for AST__UKERN1, AST__UINTERP and
+*        AST__BLOCKAVE (that is, AST__NEAREST, AST__LINEAR, AST__SINC,
+*        AST__SINCSINC, AST__SINCCOS, AST__SINCGAUSS, AST__SOMB,
+*        AST__SOMBCOS and AST__GAUSS are supported).
+c     params
+*        An optional pointer to an array of double which should contain
+*        any parameter values required by the interpolation scheme, as
+*        for
+c        astResample<X>.
+*        If no parameters are required, a NULL pointer may be given.
+c     tol
+*        The maximum tolerable geometrical distortion which may be
+*        introduced as a result of approximating non-linear Mappings
+*        by a set of piece-wise linear transformations. This should be
+*        expressed as a displacement in pixels in the input grid's
+*        coordinate system. A value of zero may be given to ensure that
+*        every output position is transformed exactly.
+c     maxpix
+*        A value which specifies an initial scale size (in pixels) for
+*        the adaptive algorithm which approximates non-linear Mappings
+*        with piece-wise linear transformations, as for
+c        astResample<X>.
+c     ndim_out
+*        The number of dimensions in the output grid. This should be
+*        at least one.
+c     lbnd_out
+*        Pointer to an array of integers, with
+c        "ndim_out"
+*        elements, containing the coordinates of the centre of the
+*        first pixel in the output grid along each dimension.
+c     ubnd_out
+*        Pointer to an array of integers, with
+c        "ndim_out"
+*        elements, containing the coordinates of the centre of the
+*        last pixel in the output grid along each dimension.
+c     lbnd
+*        Pointer to an array of integers, with
+c        "ndim_out"
+*        elements, containing the coordinates of the first pixel in
+*        the region of the output grid that will be assigned values
+*        when the ResamplePlan is applied.
+c     ubnd
+*        Pointer to an array of integers, with
+c        "ndim_out"
+*        elements, containing the coordinates of the last pixel in
+*        the region of the output grid that will be assigned values
+*        when the ResamplePlan is applied.
+c     options
+c        Pointer to a null-terminated string containing an optional
+c        comma-separated list of attribute assignments to be used for
+c        initialising the new ResamplePlan. The syntax used is identical
+c        to that for the astSet function and may include "printf" format
+c        specifiers identified by "%" symbols in the normal way.
+c     ...
+c        If the "options" string contains "%" format specifiers, then
+c        an optional list of additional arguments may follow it in
+c        order to supply values to be substituted for these
+c        specifiers. The rules for supplying these are identical to
+c        those for the astSet function (and for the C "printf"
+c        function).
+
+*  Returned Value:
+c     astResamplePlan()
+*        A pointer to the new ResamplePlan.
+
+*  Notes:
+*     - The ResamplePlan holds one weight for each input pixel that
+*     contributes to each output pixel, so the memory it uses grows
+*     with the size of the interpolation kernel and with the number of
+*     input dimensions. Schemes with wide kernels (such as AST__SINC
+*     with a large value for params[0]) applied to grids with many
+*     dimensions may require a very large amount of memory.
+*     - The ResamplePlan does not retain a reference to the supplied
+*     Mapping, which may be modified or deleted without affecting the
+*     ResamplePlan.
+*     - This function is not available in the FORTRAN 77 interface to
+*     the AST library.
+*     - A null Object pointer (AST__NULL) will be returned if this
+c     function is invoked with the AST error status set, or if it
+*     should fail for any reason.
+c--
+
+*  Implementation Notes:
+*     - This function implements the external (public) interface to
+*     the astResamplePlan constructor function. It returns an ID value
+*     (instead of a true C pointer) to external users, and must be
+*     provided because astResamplePlan_ has a variable argument list
+*     which cannot be encapsulated in a macro (where this conversion
+*     would otherwise occur).
+*     - Because no checking or casting of arguments is performed
+*     before the function is invoked, the "map" parameter is of type
+*     (void *) and is converted from an ID value to a pointer and
+*     validated within the function itself.
+*     - The variable argument list also prevents this function from
+*     invoking astResamplePlan_ directly, so it must be a
+*     re-implementation of it in all respects, except for the
+*     conversions between IDs and pointers on input/output of Objects.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   AstMapping *map;              /* Pointer to the Mapping structure */
+   AstResamplePlan *new;         /* Pointer to new ResamplePlan */
+   va_list args;                 /* Variable argument list */
+
+   int *status;                  /* Pointer to inherited status value */
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Initialise. */
+   new = NULL;
+
+/* Get a pointer to the inherited status value. */
+   status = astGetStatusPtr;
+
+/* Check the global status. */
+   if ( !astOK ) return new;
+
+/* Obtain the Mapping pointer from the ID supplied and validate the
+   pointer to ensure it identifies a valid Mapping. */
+   map = astVerifyMapping( astMakePointer( map_void ) );
+   if ( astOK ) {
+
+/* Initialise the ResamplePlan, allocating memory and initialising the
+   virtual function table as well if necessary. */
+      new = astInitResamplePlan( NULL, sizeof( AstResamplePlan ),
+                                 !class_init, &class_vtab, "ResamplePlan",
+                                 map, ndim_in, lbnd_in, ubnd_in, interp,
+                                 params, tol, maxpix, ndim_out, lbnd_out,
+                                 ubnd_out, lbnd, ubnd );
+
+/* If successful, note that the virtual function table has been
+   initialised. */
+      if ( astOK ) {
+         class_init = 1;
+
+/* Obtain the variable argument list and pass it along with the
+   options string to the astVSet method to initialise the new
+   ResamplePlan's attributes. */
+         va_start( args, options );
+         astVSet( new, options, NULL, args );
+         va_end( args );
+
+/* If an error occurred, clean up by deleting the new object. */
+         if ( !astOK ) new = astDelete( new );
+      }
+   }
+
+/* Return an ID value for the new ResamplePlan. */
+   return astMakeId( new );
+}
+
+AstResamplePlan *astInitResamplePlan_( void *mem, size_t size, int init,
+                                       AstResamplePlanVtab *vtab,
+                                       const char *name, AstMapping *map,
+                                       int ndim_in, const int lbnd_in[],
+                                       const int ubnd_in[], int interp,
+                                       const double params[], double tol,
+                                       int maxpix, int ndim_out,
+                                       const int lbnd_out[],
+                                       const int ubnd_out[],
+                                       const int lbnd[], const int ubnd[],
+                                       int *status ) {
+/*
+*+
+*  Name:
+*     astInitResamplePlan
+
+*  Purpose:
+*     Initialise a ResamplePlan.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "resampleplan.h"
+*     AstResamplePlan *astInitResamplePlan( void *mem, size_t size, int init,
+*                                           AstResamplePlanVtab *vtab,
+*                                           const char *name, AstMapping *map,
+*                                           int ndim_in, const int lbnd_in[],
+*                                           const int ubnd_in[], int interp,
+*                                           const double params[], double tol,
+*                                           int maxpix, int ndim_out,
+*                                           const int lbnd_out[],
+*                                           const int ubnd_out[],
+*                                           const int lbnd[], const int ubnd[] )
+
+*  Class Membership:
+*     ResamplePlan initialiser.
+
+*  Description:
+*     This function is provided for use by class implementations to
+*     initialise a new ResamplePlan object. It allocates memory (if
+*     necessary) to accommodate the ResamplePlan plus any additional
+*     data associated with the derived class.  It then initialises a
+*     ResamplePlan structure at the start of this memory, finding the
+*     interpolation weights using the supplied Mapping. If the "init"
+*     flag is set, it also initialises the contents of a virtual
+*     function table for a ResamplePlan at the start of the memory
+*     passed via the "vtab" parameter.
+
+*  Parameters:
+*     mem
+*        A pointer to the memory in which the ResamplePlan is to be
+*        created. This must be of sufficient size to accommodate the
+*        ResamplePlan data (sizeof(ResamplePlan)) plus any data used by
+*        the derived class. If a value of NULL is given, this function
+*        will allocate the memory itself using the "size" parameter to
+*        determine its size.
+*     size
+*        The amount of memory used by the ResamplePlan (plus derived
+*        class data).  This will be used to allocate memory if a value
+*        of NULL is given for the "mem" parameter. This value is also
+*        stored in the ResamplePlan structure, so a valid value must be
+*        supplied even if not required for allocating memory.
+*     init
+*        A logical flag indicating if the ResamplePlan's virtual
+*        function table is to be initialised. If this value is
+*        non-zero, the virtual function table will be initialised by
+*        this function.
+*     vtab
+*        Pointer to the start of the virtual function table to be
+*        associated with the new ResamplePlan.
+*     name
+*        Pointer to a constant null-terminated character string which
+*        contains the name of the class to which the new object belongs
+*        (it is this pointer value that will subsequently be returned
+*        by the Object astClass function).
+*     map
+*        Pointer to the Mapping that will be used to resample the data.
+*     ndim_in
+*        The number of dimensions in the input grid.
+*     lbnd_in
+*        The lower pixel index bounds of the input grid.
+*     ubnd_in
+*        The upper pixel index bounds of the input grid.
+*     interp
+*        The sub-pixel interpolation scheme.
+*     params
+*        Optional parameters for the interpolation scheme.
+*     tol
+*        The maximum tolerable geometrical distortion (in input grid
+*        pixels).
+*     maxpix
+*        The initial scale size (in pixels) for the piece-wise linear
+*        approximation of the Mapping.
+*     ndim_out
+*        The number of dimensions in the output grid.
+*     lbnd_out
+*        The lower pixel index bounds of the output grid.
+*     ubnd_out
+*        The upper pixel index bounds of the output grid.
+*     lbnd
+*        The lower pixel index bounds of the section of the output grid
+*        to be resampled.
+*     ubnd
+*        The upper pixel index bounds of the section of the output grid
+*        to be resampled.
+
+*  Returned Value:
+*     A pointer to the new ResamplePlan.
+
+*  Notes:
+*     -  A null pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*-
+*/
+
+/* Local Variables: */
+   AstResamplePlan *new;         /* Pointer to new ResamplePlan */
+
+/* Check the global status. */
+   if ( !astOK ) return NULL;
+
+/* If necessary, initialise the virtual function table. */
+   if ( init ) astInitResamplePlanVtab( vtab, name );
+
+/* Initialise an Object structure (the parent class) as the first
+   component within the ResamplePlan structure, allocating memory if
+   necessary. */
+   new = (AstResamplePlan *) astInitObject( mem, size, 0,
+                                            (AstObjectVtab *) vtab, name );
+
+   if ( astOK ) {
+
+/* Initialise the ResamplePlan data. */
+/* --------------------------------- */
+      new->centre = NULL;
+      new->inpix = NULL;
+      new->lbnd_in = NULL;
+      new->lbnd_out = NULL;
+      new->outpix = NULL;
+      new->start = NULL;
+      new->ubnd_in = NULL;
+      new->ubnd_out = NULL;
+      new->weight = NULL;
+      new->ndim_in = ndim_in;
+      new->ndim_out = ndim_out;
+
+/* Find the interpolation weights. This also validates the supplied
+   arguments. */
+      new->npix = astResampleWeights( map, ndim_in, lbnd_in, ubnd_in,
+                                      interp, params, tol, maxpix,
+                                      ndim_out, lbnd_out, ubnd_out,
+                                      lbnd, ubnd, &new->outpix,
+                                      &new->centre, &new->start,
+                                      &new->inpix, &new->weight );
+
+/* Store the grid bounds. */
+      if ( astOK ) {
+         new->lbnd_in = astStore( NULL, lbnd_in,
+                                  sizeof( int )*(size_t) ndim_in );
+         new->ubnd_in = astStore( NULL, ubnd_in,
+                                  sizeof( int )*(size_t) ndim_in );
+         new->lbnd_out = astStore( NULL, lbnd_out,
+                                   sizeof( int )*(size_t) ndim_out );
+         new->ubnd_out = astStore( NULL, ubnd_out,
+                                   sizeof( int )*(size_t) ndim_out );
+      }
+
+/* If an error occurred, clean up by deleting the new object. */
+      if ( !astOK ) new = astDelete( new );
+   }
+
+/* Return a pointer to the new object. */
+   return new;
+}
+
+AstResamplePlan *astLoadResamplePlan_( void *mem, size_t size,
+                                       AstResamplePlanVtab *vtab,
+                                       const char *name, AstChannel *channel,
+                                       int *status ) {
+/*
+*+
+*  Name:
+*     astLoadResamplePlan
+
+*  Purpose:
+*     Load a ResamplePlan.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "resampleplan.h"
+*     AstResamplePlan *astLoadResamplePlan( void *mem, size_t size,
+*                                           AstResamplePlanVtab *vtab,
+*                                           const char *name,
+*                                           AstChannel *channel )
+
+*  Class Membership:
+*     ResamplePlan loader.
+
+*  Description:
+*     This function is provided to load a new ResamplePlan using data
+*     read from a Channel. It first loads the data used by the parent
+*     class (which allocates memory if necessary) and then initialises
+*     a ResamplePlan structure in this memory, using data read from the
+*     input Channel.
+
+*  Parameters:
+*     mem
+*        A pointer to the memory into which the ResamplePlan is to be
+*        loaded.  This must be of sufficient size to accommodate the
+*        ResamplePlan data (sizeof(ResamplePlan)) plus any data used by
+*        derived classes. If a value of NULL is given, this function
+*        will allocate the memory itself using the "size" parameter to
+*        determine its size.
+*     size
+*        The amount of memory used by the ResamplePlan (plus derived
+*        class data).  This will be used to allocate memory if a value
+*        of NULL is given for the "mem" parameter. This value is also
+*        stored in the ResamplePlan structure, so a valid value must be
+*        supplied even if not required for allocating memory.
+*
+*        If the "vtab" parameter is NULL, the "size" value is ignored
+*        and sizeof(AstResamplePlan) is used instead.
+*     vtab
+*        Pointer to the start of the virtual function table to be
+*        associated with the new ResamplePlan. If this is NULL, a
+*        pointer to the (static) virtual function table for the
+*        ResamplePlan class is used instead.
+*     name
+*        Pointer to a constant null-terminated character string which
+*        contains the name of the class to which the new object
+*        belongs (it is this pointer value that will subsequently be
+*        returned by the astGetClass method).
+*
+*        If the "vtab" parameter is NULL, the "name" value is ignored
+*        and a pointer to the string "ResamplePlan" is used instead.
+
+*  Returned Value:
+*     A pointer to the new ResamplePlan.
+
+*  Notes:
+*     - A null pointer will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*-
+*/
+
+/* Local Constants: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+#define KEY_LEN 50               /* Maximum length of a keyword */
+
+/* Local Variables: */
+   AstResamplePlan *new;         /* Pointer to the new ResamplePlan */
+   char key[ KEY_LEN + 1 ];      /* Buffer for keywords */
+   int i;                        /* Loop counter */
+   int nwt;                      /* Number of stored weights */
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(channel);
+
+/* Initialise. */
+   new = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return new;
+
+/* If a NULL virtual function table has been supplied, then this is
+   the first loader to be invoked for this ResamplePlan. In this case
+   the ResamplePlan belongs to this class, so supply appropriate values
+   to be passed to the parent class loader (and its parent, etc.). */
+   if ( !vtab ) {
+      size = sizeof( AstResamplePlan );
+      vtab = &class_vtab;
+      name = "ResamplePlan";
+
+/* If required, initialise the virtual function table for this class. */
+      if ( !class_init ) {
+         astInitResamplePlanVtab( vtab, name );
+         class_init = 1;
+      }
+   }
+
+/* Invoke the parent class loader to load data for all the ancestral
+   classes of the current one, returning a pointer to the resulting
+   partly-built ResamplePlan. */
+   new = astLoadObject( mem, size, (AstObjectVtab *) vtab, name,
+                        channel );
+
+   if ( astOK ) {
+
+/* Initialise the ResamplePlan's data pointers. */
+      new->centre = NULL;
+      new->inpix = NULL;
+      new->lbnd_in = NULL;
+      new->lbnd_out = NULL;
+      new->outpix = NULL;
+      new->start = NULL;
+      new->ubnd_in = NULL;
+      new->ubnd_out = NULL;
+      new->weight = NULL;
+
+/* Read input data. */
+/* ================ */
+/* Request the input Channel to read all the input data appropriate to
+   this class into the internal "values list". */
+      astReadClassData( channel, "ResamplePlan" );
+
+/* Now read each individual data item from this list and use it to
+   initialise the appropriate instance variable(s) for this class. */
+
+/* Grid dimensions and bounds. */
+/* --------------------------- */
+      new->ndim_in = astReadInt( channel, "ndimin", 1 );
+      if ( new->ndim_in < 1 ) new->ndim_in = 1;
+      new->lbnd_in = astMalloc( sizeof( int )*(size_t) new->ndim_in );
+      new->ubnd_in = astMalloc( sizeof( int )*(size_t) new->ndim_in );
+      for ( i = 0; astOK && i < new->ndim_in; i++ ) {
+         (void) sprintf( key, "lbin%d", i + 1 );
+         new->lbnd_in[ i ] = astReadInt( channel, key, 1 );
+         (void) sprintf( key, "ubin%d", i + 1 );
+         new->ubnd_in[ i ] = astReadInt( channel, key, 1 );
+      }
+
+      new->ndim_out = astReadInt( channel, "ndimout", 1 );
+      if ( new->ndim_out < 1 ) new->ndim_out = 1;
+      new->lbnd_out = astMalloc( sizeof( int )*(size_t) new->ndim_out );
+      new->ubnd_out = astMalloc( sizeof( int )*(size_t) new->ndim_out );
+      for ( i = 0; astOK && i < new->ndim_out; i++ ) {
+         (void) sprintf( key, "lbout%d", i + 1 );
+         new->lbnd_out[ i ] = astReadInt( channel, key, 1 );
+         (void) sprintf( key, "ubout%d", i + 1 );
+         new->ubnd_out[ i ] = astReadInt( channel, key, 1 );
+      }
+
+/* Planned output pixels. */
+/* ---------------------- */
+      new->npix = astReadInt( channel, "npix", 0 );
+      if ( new->npix < 0 ) new->npix = 0;
+      nwt = astReadInt( channel, "nwt", 0 );
+      if ( nwt < 0 ) nwt = 0;
+
+      new->outpix = astMalloc( sizeof( int )*(size_t) new->npix );
+      new->centre = astMalloc( sizeof( int )*(size_t) new->npix );
+      new->start = astMalloc( sizeof( int )*(size_t) ( new->npix + 1 ) );
+      for ( i = 0; astOK && i < new->npix; i++ ) {
+         (void) sprintf( key, "op%d", i + 1 );
+         new->outpix[ i ] = astReadInt( channel, key, 0 );
+         (void) sprintf( key, "cp%d", i + 1 );
+         new->centre[ i ] = astReadInt( channel, key, -1 );
+         (void) sprintf( key, "st%d", i + 1 );
+         new->start[ i ] = astReadInt( channel, key, 0 );
+      }
+      if ( astOK ) new->start[ new->npix ] = nwt;
+
+/* Weights. */
+/* -------- */
+      if ( nwt > 0 ) {
+         new->inpix = astMalloc( sizeof( int )*(size_t) nwt );
+         new->weight = astMalloc( sizeof( double )*(size_t) nwt );
+         for ( i = 0; astOK && i < nwt; i++ ) {
+            (void) sprintf( key, "ip%d", i + 1 );
+            new->inpix[ i ] = astReadInt( channel, key, 0 );
+            (void) sprintf( key, "wt%d", i + 1 );
+            new->weight[ i ] = astReadDouble( channel, key, 0.0 );
+         }
+      }
+
+/* If an error occurred, clean up by deleting the new ResamplePlan. */
+      if ( !astOK ) new = astDelete( new );
+   }
+
+/* Return the new ResamplePlan pointer. */
+   return new;
+
+/* Undefine macros local to this function. */
+#undef KEY_LEN
+}
+
+/* Virtual function interfaces. */
+/* ============================ */
+/* These provide the external interface to the virtual functions defined by
+   this class. Each simply checks the global error status and then locates and
+   executes the appropriate member function, using the function pointer stored
+   in the object's virtual function table (this pointer is located using the
+   astMEMBER macro defined in "object.h").
+
+   Note that the member function may not be the one defined here, as it may
+   have been over-ridden by a derived class. However, it should still have the
+   same interface. */
+#define MAKE_APPLYPLAN_(X,Xtype) \
+int astApplyPlan##X##_( AstResamplePlan *this, const Xtype in[], \
+                        const Xtype in_var[], int flags, Xtype badval, \
+                        Xtype out[], Xtype out_var[], int *status ) { \
+   if ( !astOK ) return 0; \
+   return (**astMEMBER(this,ResamplePlan,ApplyPlan##X))( this, in, in_var, \
+                                       flags, badval, out, out_var, status ); \
+}
+
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+MAKE_APPLYPLAN_(LD,long double)
+#endif
+MAKE_APPLYPLAN_(D,double)
+MAKE_APPLYPLAN_(F,float)
+MAKE_APPLYPLAN_(L,long int)
+MAKE_APPLYPLAN_(UL,unsigned long int)
+MAKE_APPLYPLAN_(K,INT_BIG)
+MAKE_APPLYPLAN_(UK,UINT_BIG)
+MAKE_APPLYPLAN_(I,int)
+MAKE_APPLYPLAN_(UI,unsigned int)
+MAKE_APPLYPLAN_(S,short int)
+MAKE_APPLYPLAN_(US,unsigned short int)
+MAKE_APPLYPLAN_(B,signed char)
+MAKE_APPLYPLAN_(UB,unsigned char)
+#undef MAKE_APPLYPLAN_
+
+int astPlanBounds_( AstResamplePlan *this, int in, int lbnd[], int ubnd[],
+                    int *status ) {
+   if ( !astOK ) return 0;
+   return (**astMEMBER(this,ResamplePlan,PlanBounds))( this, in, lbnd, ubnd,
+                                                       status );
+}
@@ -0,0 +1,369 @@
+#if !defined( RESAMPLEPLAN_INCLUDED ) /* Include this file only once */
+#define RESAMPLEPLAN_INCLUDED
+/*
+*+
+*  Name:
+*     resampleplan.h
+
+*  Type:
+*     C include file.
+
+*  Purpose:
+*     Define the interface to the ResamplePlan class.
+
+*  Invocation:
+*     #include "resampleplan.h"
+
+*  Description:
+*     This include file defines the interface to the ResamplePlan class
+*     and provides the type definitions, function prototypes and
+*     macros, etc.  needed to use this class.
+*
+*     A ResamplePlan records the interpolation weights that
+*     astResample<X> would use to resample a grid of data values,
+*     using a given Mapping, interpolation scheme and set of grid
+*     bounds. The weights are found once, when the ResamplePlan is
+*     created, and may then be applied to any number of data (and
+*     variance) arrays using astApplyPlan<X>. No coordinates are
+*     transformed, and no interpolation kernels are evaluated, when a
+*     ResamplePlan is applied.
+
+*  Inheritance:
+*     The ResamplePlan class inherits from the Object class.
+
+*  Attributes Over-Ridden:
+*     None.
+
+*  New Attributes Defined:
+*     None.
+
+*  Methods Over-Ridden:
+*     Public:
+*        None.
+*
+*     Protected:
+*        astGetObjSize
+*           Return the in-memory size of the ResamplePlan.
+
+*  New Methods Defined:
+*     Public:
+*        astApplyPlan<X>
+*           Resample a grid of data values using a ResamplePlan.
+*        astPlanBounds
+*           Return the bounds of the grids described by a ResamplePlan.
+*
+*     Protected:
+*        None.
+
+*  Other Class Functions:
+*     Public:
+*        astIsAResamplePlan
+*           Test class membership.
+*        astResamplePlan
+*           Create a ResamplePlan.
+*
+*     Protected:
+*        astCheckResamplePlan
+*           Validate class membership.
+*        astInitResamplePlan
+*           Initialise a ResamplePlan.
+*        astInitResamplePlanVtab
+*           Initialise the virtual function table for the ResamplePlan class.
+*        astLoadResamplePlan
+*           Load a ResamplePlan.
+
+*  Macros:
+*     None.
+
+*  Type Definitions:
+*     Public:
+*        AstResamplePlan
+*           ResamplePlan object type.
+*
+*     Protected:
+*        AstResamplePlanVtab
+*           ResamplePlan virtual function table type.
+
+*  Feature Test Macros:
+*     astCLASS
+*        If the astCLASS macro is undefined, only public symbols are
+*        made available, otherwise protected symbols (for use in other
+*        class implementations) are defined. This macro also affects
+*        the reporting of error context information, which is only
+*        provided for external calls to the AST library.
+
+*  Copyright:
+*     Copyright (C) 2026 Science & Technology Facilities Council.
+
+*  Licence:
+*     This program is free software: you can redistribute it and/or
+*     modify it under the terms of the GNU Lesser General Public
+*     License as published by the Free Software Foundation, either
+*     version 3 of the License, or (at your option) any later
+*     version.
+*
+*     This program is distributed in the hope that it will be useful,
+*     but WITHOUT ANY WARRANTY; without even the implied warranty of
+*     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*     GNU Lesser General Public License for more details.
+*
+*     You should have received a copy of the GNU Lesser General
+*     License along with this program.  If not, see
+*     <http://www.gnu.org/licenses/>.
+
+*  Authors:
+*     DSB: D.S. Berry (Starlink)
+
+*  History:
+*     16-OCT-2026 (DSB):
+*        Original version.
+*-
+*/
+
+/* Include files. */
+/* ============== */
+/* Interface definitions. */
+/* ---------------------- */
+#include "object.h"              /* Base Object class */
+#include "mapping.h"             /* Coordinate mappings */
+
+#if defined(astCLASS)            /* Protected */
+#include "channel.h"             /* I/O channels */
+#endif
+
+/* C header files. */
+/* --------------- */
+#if defined(astCLASS)            /* Protected */
+#include <stddef.h>
+#endif
+
+/* Macros */
+/* ====== */
+
+/* Define a dummy __attribute__ macro for use on non-GNU compilers. */
+#ifndef __GNUC__
+#  define  __attribute__(x)  /*NOTHING*/
+#endif
+
+/* Type Definitions. */
+/* ================= */
+/* ResamplePlan structure. */
+/* ----------------------- */
+/* This structure contains all information that is unique to each
+   object in the class (e.g. its instance variables). */
+typedef struct AstResamplePlan {
+
+/* Attributes inherited from the parent class. */
+   AstObject object;             /* Parent class structure */
+
+/* Attributes specific to objects in this class. */
+   double *weight;               /* Interpolation weights */
+   int *centre;                  /* Input pixel containing each position */
+   int *inpix;                   /* Input pixel for each weight */
+   int *lbnd_in;                 /* Lower bounds of input grid */
+   int *lbnd_out;                /* Lower bounds of output grid */
+   int *outpix;                  /* Offset of each planned output pixel */
+   int *start;                   /* Index of first weight for each pixel */
+   int *ubnd_in;                 /* Upper bounds of input grid */
+   int *ubnd_out;                /* Upper bounds of output grid */
+   int ndim_in;                  /* Number of input grid dimensions */
+   int ndim_out;                 /* Number of output grid dimensions */
+   int npix;                     /* Number of planned output pixels */
+} AstResamplePlan;
+
+/* Virtual function table. */
+/* ----------------------- */
+/* This table contains all information that is the same for all
+   objects in the class (e.g. pointers to its virtual functions). */
+#if defined(astCLASS)            /* Protected */
+typedef struct AstResamplePlanVtab {
+
+/* Properties (e.g. methods) inherited from the parent class. */
+   AstObjectVtab object_vtab;    /* Parent class virtual function table */
+
+/* A Unique identifier to determine class membership. */
+   AstClassIdentifier id;
+
+/* Properties (e.g. methods) specific to this class. */
+#define DECLARE_GENERIC_ALL(X,Xtype) \
+   int (* ApplyPlan##X)( AstResamplePlan *, const Xtype [], const Xtype [], \
+                         int, Xtype, Xtype [], Xtype [], int * );
+
+DECLARE_GENERIC_ALL(B,signed char)
+DECLARE_GENERIC_ALL(D,double)
+DECLARE_GENERIC_ALL(F,float)
+DECLARE_GENERIC_ALL(I,int)
+DECLARE_GENERIC_ALL(K,INT_BIG)
+DECLARE_GENERIC_ALL(L,long int)
+DECLARE_GENERIC_ALL(S,short int)
+DECLARE_GENERIC_ALL(UB,unsigned char)
+DECLARE_GENERIC_ALL(UI,unsigned int)
+DECLARE_GENERIC_ALL(UK,UINT_BIG)
+DECLARE_GENERIC_ALL(UL,unsigned long int)
+DECLARE_GENERIC_ALL(US,unsigned short int)
+
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+DECLARE_GENERIC_ALL(LD,long double)
+#endif
+
+#undef DECLARE_GENERIC_ALL
+
+   int (* PlanBounds)( AstResamplePlan *, int, int [], int [], int * );
+} AstResamplePlanVtab;
+
+#if defined(THREAD_SAFE)
+
+/* Define a structure holding all data items that are global within the
+   resampleplan.c file. */
+
+typedef struct AstResamplePlanGlobals {
+   AstResamplePlanVtab Class_Vtab;
+   int Class_Init;
+} AstResamplePlanGlobals;
+
+
+/* Thread-safe initialiser for all global data used by this module. */
+void astInitResamplePlanGlobals_( AstResamplePlanGlobals * );
+
+#endif
+
+
+#endif
+
+/* Function prototypes. */
+/* ==================== */
+/* Prototypes for standard class functions. */
+/* ---------------------------------------- */
+astPROTO_CHECK(ResamplePlan)     /* Check class membership */
+astPROTO_ISA(ResamplePlan)       /* Test class membership */
+
+/* Constructor. */
+#if defined(astCLASS)            /* Protected. */
+AstResamplePlan *astResamplePlan_( void *, int, const int [], const int [],
+                                   int, const double [], double, int, int,
+                                   const int [], const int [], const int [],
+                                   const int [], const char *, int *, ...);
+#else
+AstResamplePlan *astResamplePlanId_( void *, int, const int [], const int [],
+                                     int, const double [], double, int, int,
+                                     const int [], const int [],
+                                     const int [], const int [],
+                                     const char *, ... )__attribute__((format(printf,14,15)));
+#endif
+
+#if defined(astCLASS)            /* Protected */
+
+/* Initialiser. */
+AstResamplePlan *astInitResamplePlan_( void *, size_t, int,
+                                       AstResamplePlanVtab *, const char *,
+                                       AstMapping *, int, const int [],
+                                       const int [], int, const double [],
+                                       double, int, int, const int [],
+                                       const int [], const int [],
+                                       const int [], int * );
+
+/* Vtab initialiser. */
+void astInitResamplePlanVtab_( AstResamplePlanVtab *, const char *, int * );
+
+/* Loader. */
+AstResamplePlan *astLoadResamplePlan_( void *, size_t,
+                                       AstResamplePlanVtab *, const char *,
+                                       AstChannel *, int * );
+#endif
+
+/* Prototypes for member functions. */
+/* -------------------------------- */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+int astApplyPlanLD_( AstResamplePlan *, const long double[], const long double[], int, long double, long double[], long double[], int * );
+#endif
+int astApplyPlanB_( AstResamplePlan *, const signed char[], const signed char[], int, signed char, signed char[], signed char[], int * );
+int astApplyPlanD_( AstResamplePlan *, const double[], const double[], int, double, double[], double[], int * );
+int astApplyPlanF_( AstResamplePlan *, const float[], const float[], int, float, float[], float[], int * );
+int astApplyPlanI_( AstResamplePlan *, const int[], const int[], int, int, int[], int[], int * );
+int astApplyPlanK_( AstResamplePlan *, const INT_BIG[], const INT_BIG[], int, INT_BIG, INT_BIG[], INT_BIG[], int * );
+int astApplyPlanL_( AstResamplePlan *, const long int[], const long int[], int, long int, long int[], long int[], int * );
+int astApplyPlanS_( AstResamplePlan *, const short int[], const short int[], int, short int, short int[], short int[], int * );
+int astApplyPlanUB_( AstResamplePlan *, const unsigned char[], const unsigned char[], int, unsigned char, unsigned char[], unsigned char[], int * );
+int astApplyPlanUI_( AstResamplePlan *, const unsigned int[], const unsigned int[], int, unsigned int, unsigned int[], unsigned int[], int * );
+int astApplyPlanUK_( AstResamplePlan *, const UINT_BIG[], const UINT_BIG[], int, UINT_BIG, UINT_BIG[], UINT_BIG[], int * );
+int astApplyPlanUL_( AstResamplePlan *, const unsigned long int[], const unsigned long int[], int, unsigned long int, unsigned long int[], unsigned long int[], int * );
+int astApplyPlanUS_( AstResamplePlan *, const unsigned short int[], const unsigned short int[], int, unsigned short int, unsigned short int[], unsigned short int[], int * );
+
+int astPlanBounds_( AstResamplePlan *, int, int [], int [], int * );
+
+/* Function interfaces. */
+/* ==================== */
+/* These macros are wrap-ups for the functions defined by this class
+   to make them easier to invoke (e.g. to avoid type mis-matches when
+   passing pointers to objects from derived classes). */
+
+/* Interfaces to standard class functions. */
+/* --------------------------------------- */
+/* Some of these functions provide validation, so we cannot use them
+   to validate their own arguments. We must use a cast when passing
+   object pointers (so that they can accept objects from derived
+   classes). */
+
+/* Check class membership. */
+#define astCheckResamplePlan(this) astINVOKE_CHECK(ResamplePlan,this,0)
+#define astVerifyResamplePlan(this) astINVOKE_CHECK(ResamplePlan,this,1)
+
+/* Test class membership. */
+#define astIsAResamplePlan(this) astINVOKE_ISA(ResamplePlan,this)
+
+/* Constructor. */
+#if defined(astCLASS)            /* Protected. */
+#define astResamplePlan astINVOKE(F,astResamplePlan_)
+#else
+#define astResamplePlan astINVOKE(F,astResamplePlanId_)
+#endif
+
+#if defined(astCLASS)            /* Protected */
+
+/* Initialiser. */
+#define astInitResamplePlan(mem,size,init,vtab,name,map,ndim_in,lbnd_in,ubnd_in,interp,params,tol,maxpix,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd) \
+astINVOKE(O,astInitResamplePlan_(mem,size,init,vtab,name,astCheckMapping(map),ndim_in,lbnd_in,ubnd_in,interp,params,tol,maxpix,ndim_out,lbnd_out,ubnd_out,lbnd,ubnd,STATUS_PTR))
+
+/* Vtab Initialiser. */
+#define astInitResamplePlanVtab(vtab,name) astINVOKE(V,astInitResamplePlanVtab_(vtab,name,STATUS_PTR))
+/* Loader. */
+#define astLoadResamplePlan(mem,size,vtab,name,channel) \
+astINVOKE(O,astLoadResamplePlan_(mem,size,vtab,name,astCheckChannel(channel),STATUS_PTR))
+#endif
+
+/* Interfaces to public member functions. */
+/* -------------------------------------- */
+/* Here we make use of astCheckResamplePlan to validate ResamplePlan
+   pointers before use.  This provides a contextual error report if a
+   pointer to the wrong sort of Object is supplied. */
+#if HAVE_LONG_DOUBLE     /* Not normally implemented */
+#define astApplyPlanLD(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanLD_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#endif
+#define astApplyPlanD(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanD_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanF(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanF_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanL(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanL_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUL(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanUL_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanK(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanK_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUK(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanUK_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanI(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanI_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUI(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanUI_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanS(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanS_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUS(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanUS_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanB(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanB_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astApplyPlanUB(this,in,in_var,flags,badval,out,out_var) \
+astINVOKE(V,astApplyPlanUB_(astCheckResamplePlan(this),in,in_var,flags,badval,out,out_var,STATUS_PTR))
+#define astPlanBounds(this,in,lbnd,ubnd) \
+astINVOKE(V,astPlanBounds_(astCheckResamplePlan(this),in,lbnd,ubnd,STATUS_PTR))
+#endif
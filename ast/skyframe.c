@@ -343,6 +343,8 @@ f     - AST_SKYOFFSETMAP: Obtain a Mapping from absolute to offset coordinates
 *        between coincident points being given a non-zero length.
 *     6-JUL-2015 (DSB):
 *        Added SkyTol attribute.
+*     16-OCT-2026 (DSB):
+*        Declare typed access functions for the Equinox attribute.
 *class--
 */
 
@@ -776,6 +778,7 @@ int astTest##attr##_( AstSkyFrame *this, int axis, int *status ) { \
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* Type Definitions. */
@@ -4658,6 +4661,75 @@ static const char *GetUnit( AstFrame *this_frame, int axis, int *status ) {
    return result;
 }
 
+/* Typed access functions for the attributes declared in
+   astInitSkyFrameVtab. */
+astMAKE_ATTRIBTEST(SkyFrame,Equinox)
+astMAKE_ATTRIBCLEAR(SkyFrame,Equinox)
+
+static double GetEquinoxAttrib( AstObject *this_object, int *status ) {
+/*
+*  Name:
+*     GetEquinoxAttrib
+
+*  Purpose:
+*     Get the Equinox attribute of a SkyFrame as a double.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "skyframe.h"
+*     double GetEquinoxAttrib( AstObject *this, int *status )
+
+*  Class Membership:
+*     SkyFrame member function.
+
+*  Description:
+*     This function returns the value that astGetD would obtain by
+*     reading the formatted Equinox value returned by astGetAttrib (i.e.
+*     a Besselian or Julian epoch in decimal years), without formatting
+*     the value as a string first.
+
+*  Parameters:
+*     this
+*        Pointer to the SkyFrame.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     The Equinox value in decimal years.
+
+*  Notes:
+*     - A value of AST__BAD will be returned if this function is invoked
+*     with the global error status set, or if it should fail for any
+*     reason.
+*/
+
+/* Local Variables: */
+   const char *text;             /* Formatted equinox */
+   double equinox;               /* Equinox as a Modified Julian Date */
+   double result;                /* Returned value */
+
+/* Initialise. */
+   result = AST__BAD;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get the Equinox and format it in the same way as astGetAttrib, so
+   that both interfaces return the same rounded value. */
+   equinox = astGetEquinox( (AstSkyFrame *) this_object );
+   if ( astOK ) {
+      text = astFmtDecimalYr( ( equinox < palEpj2d( 1984.0 ) ) ?
+                              palEpb( equinox ) : palEpj( equinox ),
+                              DBL_DIG );
+      if ( astOK && text ) result = strtod( text, NULL );
+   }
+
+/* Return the result. */
+   return result;
+}
+
 void astInitSkyFrameVtab_(  AstSkyFrameVtab *vtab, const char *name, int *status ) {
 /*
 *+
@@ -4888,6 +4960,11 @@ void astInitSkyFrameVtab_(  AstSkyFrameVtab *vtab, const char *name, int *status
    astSetDump( vtab, Dump, "SkyFrame",
                "Description of celestial coordinate system" );
 
+/* Declare typed access functions for attributes that can be used
+   without formatting or parsing a string. */
+   astDeclareAttribD( vtab, "equinox", GetEquinoxAttrib, NULL,
+                      TestEquinoxAttrib, ClearEquinoxAttrib );
+
 /* Initialize constants for converting between hours, degrees and
    radians, etc.. */
    LOCK_MUTEX2
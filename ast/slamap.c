@@ -117,6 +117,12 @@ f     - AST_SLAADD: Add a celestial coordinate conversion to an SlaMap
 *        two conversions are stored in swapped order).
 *     6-JUL-2015 (DSB):
 *        Added method astSlaIsEmpty.
+*     16-OCT-2026 (DSB):
+*        Replace the single-entry palMappa cache with a least-recently-used
+*        cache holding the most recently used epoch-dependent matrices and
+*        parameter vectors (precession, palMappa, ecliptic and heliographic
+*        matrices, and the position of the earth), so that interleaved
+*        conversions for several epochs do not recalculate them.
 
 *class--
 */
@@ -209,6 +215,17 @@ f     - AST_SLAADD: Add a celestial coordinate conversion to an SlaMap
 #include <stdio.h>
 #include <string.h>
 
+/* Codes identifying the epoch-dependent values held in the cache used
+   by GetCached and PutCached. */
+#define CACHE_NONE 0             /* Unused cache entry */
+#define CACHE_PREBN 1            /* palPrebn matrix */
+#define CACHE_PREC 2             /* palPrec matrix */
+#define CACHE_MAPPA 3            /* palMappa parameters */
+#define CACHE_ECLIPTIC 4         /* J2000 equatorial to ecliptic matrix */
+#define CACHE_EARTH 5            /* Earth position (see Earth) */
+#define CACHE_HGC 6              /* Hgc matrix and offset */
+#define CACHE_HPCC 7             /* Hpcc matrix and offset */
+
 /* Module Variables. */
 /* ================= */
 
@@ -227,8 +244,14 @@ static AstPointSet *(* parent_transform)( AstMapping *, AstPointSet *, int, AstP
 /* Define how to initialise thread-specific globals. */
 #define GLOBAL_inits \
    globals->Class_Init = 0; \
-   globals->Eq_Cache = AST__BAD; \
-   globals->Ep_Cache = AST__BAD; \
+   globals->Cache_Clock = 0; \
+   { \
+      int icache; \
+      for( icache = 0; icache < AST__SLACACHE; icache++ ) { \
+         globals->Cache_Kind[ icache ] = CACHE_NONE; \
+         globals->Cache_Used[ icache ] = 0; \
+      } \
+   }
 
 /* Create the function that initialises global data for this module. */
 astMAKE_INITGLOBALS(SlaMap)
@@ -236,9 +259,11 @@ astMAKE_INITGLOBALS(SlaMap)
 /* Define macros for accessing each item of thread specific global data. */
 #define class_init astGLOBAL(SlaMap,Class_Init)
 #define class_vtab astGLOBAL(SlaMap,Class_Vtab)
-#define eq_cache astGLOBAL(SlaMap,Eq_Cache)
-#define ep_cache astGLOBAL(SlaMap,Ep_Cache)
-#define amprms_cache astGLOBAL(SlaMap,Amprms_Cache)
+#define cache_key astGLOBAL(SlaMap,Cache_Key)
+#define cache_value astGLOBAL(SlaMap,Cache_Value)
+#define cache_kind astGLOBAL(SlaMap,Cache_Kind)
+#define cache_used astGLOBAL(SlaMap,Cache_Used)
+#define cache_clock astGLOBAL(SlaMap,Cache_Clock)
 
 
 
@@ -246,11 +271,13 @@ astMAKE_INITGLOBALS(SlaMap)
    variables. */
 #else
 
-/* A cache used to store the most recent results from palMappa in order
-   to avoid continuously recalculating the same values. */
-static double eq_cache = AST__BAD;
-static double ep_cache = AST__BAD;
-static double amprms_cache[ 21 ];
+/* A cache used to store the most recently used epoch-dependent values
+   (see GetCached) in order to avoid continuously recalculating them. */
+static double cache_key[ AST__SLACACHE ][ 4 ];
+static double cache_value[ AST__SLACACHE ][ 21 ];
+static int cache_kind[ AST__SLACACHE ];
+static int64_t cache_used[ AST__SLACACHE ];
+static int64_t cache_clock = 0;
 
 
 /* Define the class virtual function table and its initialisation flag
@@ -273,6 +300,7 @@ static AstPointSet *Transform( AstMapping *, AstPointSet *, int, AstPointSet *,
 static const char *CvtString( int, const char **, int *, const char *[ MAX_SLA_ARGS ], int * );
 static int CvtCode( const char *, int * );
 static int Equal( AstObject *, AstObject *, int * );
+static int GetCached( int, const double[ 4 ], int, double *, int * );
 static int MapMerge( AstMapping *, int, int, int *, AstMapping ***, int **, int * );
 static int SlaIsEmpty( AstSlaMap *, int * );
 static void AddSlaCvt( AstSlaMap *, int, const double *, int * );
@@ -282,6 +310,7 @@ static void Dh2e( double, double, double, double, double *, double *, int * );
 static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
 static void Earth( double, double[3], int * );
+static void PutCached( int, const double[ 4 ], int, const double *, int * );
 static void SlaAdd( AstSlaMap *, const char *, const double[], int * );
 static void SolarPole( double, double[3], int * );
 static void Hpcc( double, double[3], double[3][3], double[3], int * );
@@ -540,6 +569,90 @@ static int Equal( AstObject *this_object, AstObject *that_object, int *status )
 }
 
 
+static int GetCached( int kind, const double key[ 4 ], int nval,
+                      double *value, int *status ) {
+/*
+*  Name:
+*     GetCached
+
+*  Purpose:
+*     Retrieve epoch-dependent values from the cache.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "slamap.h"
+*     int GetCached( int kind, const double key[ 4 ], int nval,
+*                    double *value, int *status )
+
+*  Class Membership:
+*     SlaMap member function.
+
+*  Description:
+*     This function searches the calling thread's cache of epoch-dependent
+*     values (matrices, parameter vectors, etc) for an entry previously
+*     stored by PutCached with the same kind and key. If found, the
+*     values are copied to the supplied array and the entry is marked as
+*     the most recently used.
+
+*  Parameters:
+*     kind
+*        A code identifying the type of values required (one of the
+*        CACHE_... macros).
+*     key
+*        The epochs and other arguments from which the values are
+*        calculated. Unused elements should be zero.
+*     nval
+*        The number of values to return (at most 21).
+*     value
+*        An array in which to return the values.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the values were found in the cache, zero otherwise.
+
+*  Notes:
+*     - Zero is returned if this function is invoked with the global
+*     error status set.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   int icache;                   /* Cache entry index */
+   int result;                   /* Returned flag */
+
+/* Initialise. */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Search the cache for a matching entry. */
+   for( icache = 0; icache < AST__SLACACHE; icache++ ) {
+      if( cache_kind[ icache ] == kind &&
+          cache_key[ icache ][ 0 ] == key[ 0 ] &&
+          cache_key[ icache ][ 1 ] == key[ 1 ] &&
+          cache_key[ icache ][ 2 ] == key[ 2 ] &&
+          cache_key[ icache ][ 3 ] == key[ 3 ] ) {
+
+/* Return a copy of the cached values and record when they were used. */
+         (void) memcpy( value, cache_value[ icache ],
+                        sizeof( double )*(size_t) nval );
+         cache_used[ icache ] = ++cache_clock;
+         result = 1;
+         break;
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static int GetObjSize( AstObject *this_object, int *status ) {
 /*
 *  Name:
@@ -1263,6 +1376,7 @@ static void Earth( double mjd, double earth[3], int *status ) {
    double dvb[3];     /* Earth velocity (barycentric) */
    double dvh[3];     /* Earth velocity (heliocentric, AST__HAQC) */
    double ecmat[3][3];/* Equatorial to ecliptic matrix */
+   double key[4];     /* Cache key */
    int i;             /* Loop count */
 
 /* Initialize. */
@@ -1271,6 +1385,12 @@ static void Earth( double mjd, double earth[3], int *status ) {
 /* Check the global error status. */
    if ( !astOK ) return;
 
+/* Use the cached position if the earth's position at this date has been
+   found previously. */
+   key[ 0 ] = mjd;
+   key[ 1 ] = key[ 2 ] = key[ 3 ] = 0.0;
+   if( GetCached( CACHE_EARTH, key, 3, earth, status ) ) return;
+
 /* Get the position of the earth at the given date in the AST__HAQC coord
    system (dph). */
    palEvp( mjd, 2000.0, dvb, dpb, dvh, dph );
@@ -1284,6 +1404,8 @@ static void Earth( double mjd, double earth[3], int *status ) {
    earth[1] *= AST__AU;
    earth[2] *= AST__AU;
 
+/* Cache the position for re-use. */
+   PutCached( CACHE_EARTH, key, 3, earth, status );
 }
 
 static void Hgc( double mjd, double mat[3][3], double offset[3], int *status ) {
@@ -1325,7 +1447,9 @@ static void Hgc( double mjd, double mat[3][3], double offset[3], int *status ) {
 */
 
 /* Local Variables: */
+   double cached[12]; /* Cached matrix and offset */
    double earth[3];   /* Earth position (heliocentric, AST__HAEC) */
+   double key[4];     /* Cache key */
    double len;        /* Vector length */
    double xhg[3];     /* Unix X vector of AST__HGC system in AST__HAEC */
    double yhg[3];     /* Unix Y vector of AST__HGC system in AST__HAEC */
@@ -1345,6 +1469,15 @@ static void Hgc( double mjd, double mat[3][3], double offset[3], int *status ) {
 /* Check the global error status. */
    if ( !astOK ) return;
 
+/* Use the cached matrix if it has been found previously for this date. */
+   key[ 0 ] = mjd;
+   key[ 1 ] = key[ 2 ] = key[ 3 ] = 0.0;
+   if( GetCached( CACHE_HGC, key, 12, cached, status ) ) {
+      (void) memcpy( mat, cached, sizeof( double )*9 );
+      (void) memcpy( offset, cached + 9, sizeof( double )*3 );
+      return;
+   }
+
 /* Get a unit vector parallel to the solar north pole at the given date.
    This vector is expressed in AST__HAEC coords. This is the Z axis of the
    AST__HGC system. */
@@ -1372,6 +1505,10 @@ static void Hgc( double mjd, double mat[3][3], double offset[3], int *status ) {
       mat[ i ][ 2 ] = zhg[ i ];
    }
 
+/* Cache the matrix and offset for re-use. */
+   (void) memcpy( cached, mat, sizeof( double )*9 );
+   (void) memcpy( cached + 9, offset, sizeof( double )*3 );
+   PutCached( CACHE_HGC, key, 12, cached, status );
 }
 
 static void Gsec( double mjd, double mat[3][3], double offset[3], int *status ) {
@@ -1629,7 +1766,9 @@ static void Hpcc( double mjd, double obs[3], double mat[3][3], double offset[3],
 */
 
 /* Local Variables: */
+   double cached[12]; /* Cached matrix and offset */
    double earth[3];   /* Earth position (heliocentric, AST__HAEC) */
+   double key[4];     /* Cache key */
    double pole[3];    /* Solar pole vector (AST__HAEC) */
    double len;        /* Vector length */
    double xhpc[3];    /* Unix X vector of AST__HPCC system in AST__HAEC */
@@ -1650,6 +1789,16 @@ static void Hpcc( double mjd, double obs[3], double mat[3][3], double offset[3],
 /* Check the global error status. */
    if ( !astOK ) return;
 
+/* Use the cached matrix if it has been found previously for this date
+   and observer. */
+   key[ 0 ] = mjd;
+   for( i = 0; i < 3; i++ ) key[ i + 1 ] = obs ? obs[ i ] : AST__BAD;
+   if( GetCached( CACHE_HPCC, key, 12, cached, status ) ) {
+      (void) memcpy( mat, cached, sizeof( double )*9 );
+      (void) memcpy( offset, cached + 9, sizeof( double )*3 );
+      return;
+   }
+
 /* If no observers position was supplied, use the position of the earth
    at the specified date in AST__HAEC coords. */
    if( !obs ) {
@@ -1691,6 +1840,10 @@ static void Hpcc( double mjd, double obs[3], double mat[3][3], double offset[3],
       offset[i] = obs[ i ];
    }
 
+/* Cache the matrix and offset for re-use. */
+   (void) memcpy( cached, mat, sizeof( double )*9 );
+   (void) memcpy( cached + 9, offset, sizeof( double )*3 );
+   PutCached( CACHE_HPCC, key, 12, cached, status );
 }
 
 static void Hprc( double mjd, double obs[3], double mat[3][3], double offset[3], int *status ) {
@@ -3189,6 +3342,73 @@ static int MapMerge( AstMapping *this, int where, int series, int *nmap,
    return result;
 }
 
+static void PutCached( int kind, const double key[ 4 ], int nval,
+                       const double *value, int *status ) {
+/*
+*  Name:
+*     PutCached
+
+*  Purpose:
+*     Store epoch-dependent values in the cache.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "slamap.h"
+*     void PutCached( int kind, const double key[ 4 ], int nval,
+*                     const double *value, int *status )
+
+*  Class Membership:
+*     SlaMap member function.
+
+*  Description:
+*     This function stores a set of epoch-dependent values in the calling
+*     thread's cache, so that they can later be retrieved using GetCached.
+*     The cache holds AST__SLACACHE entries. When it is full, the least
+*     recently used entry is replaced. Since each thread has its own
+*     cache, no locking is needed.
+
+*  Parameters:
+*     kind
+*        A code identifying the type of values being stored (one of the
+*        CACHE_... macros).
+*     key
+*        The epochs and other arguments from which the values were
+*        calculated. Unused elements should be zero.
+*     nval
+*        The number of values to store (at most 21).
+*     value
+*        The values to store.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS            /* Pointer to thread-specific global data */
+   int icache;                   /* Cache entry index */
+   int ilru;                     /* Index of least recently used entry */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get a pointer to the thread specific global data structure. */
+   astGET_GLOBALS(NULL);
+
+/* Find the least recently used entry. Unused entries have a usage time
+   of zero, and so are chosen first. */
+   ilru = 0;
+   for( icache = 1; icache < AST__SLACACHE; icache++ ) {
+      if( cache_used[ icache ] < cache_used[ ilru ] ) ilru = icache;
+   }
+
+/* Store the values in it. */
+   cache_kind[ ilru ] = kind;
+   (void) memcpy( cache_key[ ilru ], key, sizeof( double )*4 );
+   (void) memcpy( cache_value[ ilru ], value, sizeof( double )*(size_t) nval );
+   cache_used[ ilru ] = ++cache_clock;
+}
+
 static void SlaAdd( AstSlaMap *this, const char *cvt, const double args[], int *status ) {
 /*
 *++
@@ -3687,8 +3907,17 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                   double epoch2 = forward ? args[ 1 ] : args[ 0 ];
                   double precess_matrix[ 3 ][ 3 ];
                   double vec1[ 3 ];
+                  double key[ 4 ];
                   double vec2[ 3 ];
-                  palPrebn( epoch1, epoch2, precess_matrix );
+                  key[ 0 ] = epoch1;
+                  key[ 1 ] = epoch2;
+                  key[ 2 ] = key[ 3 ] = 0.0;
+                  if( !GetCached( CACHE_PREBN, key, 9,
+                                  (double *) precess_matrix, status ) ) {
+                     palPrebn( epoch1, epoch2, precess_matrix );
+                     PutCached( CACHE_PREBN, key, 9,
+                                (double *) precess_matrix, status );
+                  }
 
 /* For each point in the (alpha,delta) arrays, convert to Cartesian
    coordinates, apply the precession matrix, convert back to polar coordinates
@@ -3711,8 +3940,17 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                   double epoch2 = forward ? args[ 1 ] : args[ 0 ];
                   double precess_matrix[ 3 ][ 3 ];
                   double vec1[ 3 ];
+                  double key[ 4 ];
                   double vec2[ 3 ];
-                  palPrec( epoch1, epoch2, precess_matrix );
+                  key[ 0 ] = epoch1;
+                  key[ 1 ] = epoch2;
+                  key[ 2 ] = key[ 3 ] = 0.0;
+                  if( !GetCached( CACHE_PREC, key, 9,
+                                  (double *) precess_matrix, status ) ) {
+                     palPrec( epoch1, epoch2, precess_matrix );
+                     PutCached( CACHE_PREC, key, 9,
+                                (double *) precess_matrix, status );
+                  }
                   TRAN_ARRAY(palDcs2c( alpha[ point ], delta[ point ], vec1 );
                              palDmxv( precess_matrix, vec1, vec2 );
                              palDcc2s( vec2, alpha + point, delta + point );
@@ -3768,16 +4006,18 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                {
 
                   if( !extra ) {
-
-                     if( args[ 1 ] != eq_cache ||
-                         args[ 0 ] != ep_cache ) {
-                        eq_cache = args[ 1 ];
-                        ep_cache = args[ 0 ];
-                        palMappa( eq_cache, ep_cache, amprms_cache );
+                     double amprms[ 21 ];
+                     double key[ 4 ];
+
+                     key[ 0 ] = args[ 1 ];
+                     key[ 1 ] = args[ 0 ];
+                     key[ 2 ] = key[ 3 ] = 0.0;
+                     if( !GetCached( CACHE_MAPPA, key, 21, amprms, status ) ) {
+                        palMappa( args[ 1 ], args[ 0 ], amprms );
+                        PutCached( CACHE_MAPPA, key, 21, amprms, status );
                      }
 
-                     extra = astStore( NULL, amprms_cache,
-                                       sizeof( double )*21 );
+                     extra = astStore( NULL, amprms, sizeof( double )*21 );
                      map->cvtextra[ cvt ] = extra;
                   }
 
@@ -3803,16 +4043,18 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
 	    case AST__SLA_MAP:
                {
                   if( !extra ) {
-
-                     if( args[ 0 ] != eq_cache ||
-                         args[ 1 ] != ep_cache ) {
-                        eq_cache = args[ 0 ];
-                        ep_cache = args[ 1 ];
-                        palMappa( eq_cache, ep_cache, amprms_cache );
+                     double amprms[ 21 ];
+                     double key[ 4 ];
+
+                     key[ 0 ] = args[ 0 ];
+                     key[ 1 ] = args[ 1 ];
+                     key[ 2 ] = key[ 3 ] = 0.0;
+                     if( !GetCached( CACHE_MAPPA, key, 21, amprms, status ) ) {
+                        palMappa( args[ 0 ], args[ 1 ], amprms );
+                        PutCached( CACHE_MAPPA, key, 21, amprms, status );
                      }
 
-                     extra = astStore( NULL, amprms_cache,
-                                       sizeof( double )*21 );
+                     extra = astStore( NULL, amprms, sizeof( double )*21 );
                      map->cvtextra[ cvt ] = extra;
                   }
 
@@ -3835,21 +4077,32 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
 	    case AST__SLA_ECLEQ:
                {
                   double convert_matrix[ 3 ][ 3 ];
+                  double key[ 4 ];
                   double precess_matrix[ 3 ][ 3 ];
                   double rotate_matrix[ 3 ][ 3 ];
                   double vec1[ 3 ];
                   double vec2[ 3 ];
 
-/* Obtain the matrix that precesses equatorial coordinates from J2000.0 to the
-   required date. Also obtain the rotation matrix that converts from
-   equatorial to ecliptic coordinates.  */
-                  palPrec( 2000.0, palEpj( args[ 0 ] ), precess_matrix );
-                  palEcmat( args[ 0 ], rotate_matrix );
+/* Use the cached conversion matrix if it has already been found for
+   the required date. */
+                  key[ 0 ] = args[ 0 ];
+                  key[ 1 ] = key[ 2 ] = key[ 3 ] = 0.0;
+                  if( !GetCached( CACHE_ECLIPTIC, key, 9,
+                                  (double *) convert_matrix, status ) ) {
+
+/* Otherwise, obtain the matrix that precesses equatorial coordinates from
+   J2000.0 to the required date. Also obtain the rotation matrix that
+   converts from equatorial to ecliptic coordinates.  */
+                     palPrec( 2000.0, palEpj( args[ 0 ] ), precess_matrix );
+                     palEcmat( args[ 0 ], rotate_matrix );
 
 /* Multiply these matrices to give the overall matrix that converts from
    equatorial J2000.0 coordinates to ecliptic coordinates for the required
-   date. */
-                  palDmxm( rotate_matrix, precess_matrix, convert_matrix );
+   date, and cache it. */
+                     palDmxm( rotate_matrix, precess_matrix, convert_matrix );
+                     PutCached( CACHE_ECLIPTIC, key, 9,
+                                (double *) convert_matrix, status );
+                  }
 
 /* Apply the conversion by transforming from polar to Cartesian coordinates,
    multiplying by the inverse conversion matrix and converting back to polar
@@ -3881,15 +4134,23 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
 	    case AST__SLA_EQECL:
                {
                   double convert_matrix[ 3 ][ 3 ];
+                  double key[ 4 ];
                   double precess_matrix[ 3 ][ 3 ];
                   double rotate_matrix[ 3 ][ 3 ];
                   double vec1[ 3 ];
                   double vec2[ 3 ];
 
-/* Create the conversion matrix. */
-                  palPrec( 2000.0, palEpj( args[ 0 ] ), precess_matrix );
-                  palEcmat( args[ 0 ], rotate_matrix );
-                  palDmxm( rotate_matrix, precess_matrix, convert_matrix );
+/* Get the conversion matrix from the cache, or create it. */
+                  key[ 0 ] = args[ 0 ];
+                  key[ 1 ] = key[ 2 ] = key[ 3 ] = 0.0;
+                  if( !GetCached( CACHE_ECLIPTIC, key, 9,
+                                  (double *) convert_matrix, status ) ) {
+                     palPrec( 2000.0, palEpj( args[ 0 ] ), precess_matrix );
+                     palEcmat( args[ 0 ], rotate_matrix );
+                     palDmxm( rotate_matrix, precess_matrix, convert_matrix );
+                     PutCached( CACHE_ECLIPTIC, key, 9,
+                                (double *) convert_matrix, status );
+                  }
 
 /* Apply it. */
                   if ( forward ) {
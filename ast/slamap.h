@@ -68,7 +68,10 @@
 *           Load an SlaMap.
 
 *  Macros:
-*     None.
+*     Protected:
+*        AST__SLACACHE
+*           Number of entries in each thread's cache of epoch-dependent
+*           values.
 
 *  Type Definitions:
 *     Public:
@@ -124,6 +127,10 @@
 *        Added protected astInitSlaMapVtab method.
 *     22-FEB-2006 (DSB):
 *        Added cvtextra to the AstSlaMap structure.
+*     16-OCT-2026 (DSB):
+*        Replace the single-entry palMappa cache in the thread-specific
+*        globals with a least-recently-used cache of epoch-dependent
+*        values.
 *-
 */
 
@@ -138,6 +145,15 @@
 #include "channel.h"             /* I/O channels */
 #endif
 
+/* Macros. */
+/* ======= */
+#if defined(astCLASS)            /* Protected */
+
+/* The number of epoch-dependent matrices and parameter vectors held in
+   each thread's cache (see SlaMap Transform). */
+#define AST__SLACACHE 32
+#endif
+
 /* C header files. */
 /* --------------- */
 #if defined(astCLASS)            /* Protected */
@@ -216,9 +232,11 @@ typedef struct AstSlaMapVtab {
 typedef struct AstSlaMapGlobals {
    AstSlaMapVtab Class_Vtab;
    int Class_Init;
-   double Eq_Cache;
-   double Ep_Cache;
-   double Amprms_Cache[ 21 ];
+   double Cache_Key[ AST__SLACACHE ][ 4 ];
+   double Cache_Value[ AST__SLACACHE ][ 21 ];
+   int Cache_Kind[ AST__SLACACHE ];
+   int64_t Cache_Used[ AST__SLACACHE ];
+   int64_t Cache_Clock;
 } AstSlaMapGlobals;
 
 #endif
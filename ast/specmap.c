@@ -105,6 +105,15 @@ f     - AST_SPECADD: Add a spectral coordinate conversion to an SpecMap
 *        classes.
 *     2-OCT-2012 (DSB):
 *        Check for Infs as well as NaNs.
+*     16-OCT-2026 (DSB):
+*        - Retain the epoch-dependent terms used by each change of
+*        rest-frame (earth velocity, mean-to-apparent parameters, sidereal
+*        time) in the new "cvtextra" array, so that they are found only
+*        once rather than on every call to astTransform.
+*        - In 3D SpecMaps, re-use the frequency correction factor for
+*        consecutive points that have the same sky position (e.g. the
+*        channels of a spectrum) instead of re-calculating it for every
+*        point.
 *class--
 */
 
@@ -280,7 +289,7 @@ static double TopoVel( double, double, FrameDef *, int * );
 static double UserVel( double, double, FrameDef *, int * );
 static int CvtCode( const char *, int * );
 static int Equal( AstObject *, AstObject *, int * );
-static int FrameChange( int, int, double *, double *, double *, double *, int, int * );
+static int FrameChange( int, int, double *, double *, double *, double *, void **, int, int * );
 static int MapMerge( AstMapping *, int, int, int *, AstMapping ***, int **, int * );
 static int SystemChange( int, int, double *, double *, int, int * );
 static void AddSpecCvt( AstSpecMap *, int, const double *, int * );
@@ -465,9 +474,11 @@ static int GetObjSize( AstObject *this_object, int *status ) {
 
    for ( cvt = 0; cvt < this->ncvt; cvt++ ) {
       result += astTSizeOf( this->cvtargs[ cvt ] );
+      result += astTSizeOf( this->cvtextra[ cvt ] );
    }
 
    result += astTSizeOf( this->cvtargs );
+   result += astTSizeOf( this->cvtextra );
    result += astTSizeOf( this->cvttype );
 
 /* If an error occurred, clear the result value. */
@@ -678,12 +689,15 @@ static void AddSpecCvt( AstSpecMap *this, int cvttype, const double *args, int *
                                        sizeof( int ) );
       this->cvtargs = (double **) astGrow( this->cvtargs, ncvt + 1,
                                            sizeof( double * ) );
+      this->cvtextra = (void **) astGrow( this->cvtextra, ncvt + 1,
+                                          sizeof( void * ) );
 
 /* If OK, allocate memory and store a copy of the argument list,
    putting a pointer to the copy into the SpecMap. */
       if ( astOK ) {
          this->cvtargs[ ncvt ] = astStore( NULL, args,
                                            sizeof( double ) * (size_t) szargs );
+         this->cvtextra[ ncvt ] = NULL;
       }
 
 /* Store the conversion type and increment the conversion count. Also put
@@ -1366,7 +1380,7 @@ static const char *CvtString( int cvt_code, const char **comment,
 }
 
 static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *freq,
-                        double *args, int forward, int *status ){
+                        double *args, void **extra, int forward, int *status ){
 /*
 *  Name:
 *     FrameChange
@@ -1380,7 +1394,8 @@ static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *f
 *  Synopsis:
 *     #include "specmap.h"
 *     int FrameChange( int cvt_code, int np, double *ra, double *dec,
-*                      double *freq, double *args, int forward, int *status )
+*                      double *freq, double *args, void **extra,
+*                      int forward, int *status )
 
 *  Class Membership:
 *     SpecMap method.
@@ -1415,6 +1430,13 @@ static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *f
 *        Pointer to an array holding the conversion arguments. The number
 *        of arguments expected depends on the particular conversion being
 *        used.
+*     extra
+*        Address of a pointer to a FrameDef structure in which intermediate
+*        values that depend only on the conversion arguments (such as the
+*        velocity of the earth at the epoch of observation) are retained
+*        between invocations of this function. If the pointer is NULL on
+*        entry, a new FrameDef is allocated and a pointer to it returned.
+*        It should be freed using astFree when no longer needed.
 *     forward
 *        Should the conversion be applied in the forward or inverse
 *        direction? Non-zero for forward, zero for inverse.
@@ -1433,10 +1455,15 @@ static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *f
 *     values. In addition they also define the direction of motion of
 *     the "user-defined" rest-frame (see "veluser"). Thus they should still
 *     be supplied even if "ra" is NULL.
+*     - If "ra" is not NULL, the frequency correction factor found for
+*     each point is re-used for following points that have the same RA
+*     and Dec. This avoids re-calculating it for every channel when the
+*     points form a set of whole spectra.
 
 */
 
 /* Local Variables: */
+   FrameDef *pdef;    /* Pointer to retained frame parameters */
    FrameDef def;      /* Structure holding frame parameters */
    double (* cvtFunc)( double, double, FrameDef *, int * ); /* Pointer to conversion function */
    double *fcorr;     /* Pointer to frequency correction factor */
@@ -1444,6 +1471,8 @@ static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *f
    double *pf;        /* Pointer to next frequency value */
    double *pra;       /* Pointer to next RA value */
    double factor;     /* Frequency correction factor */
+   double lastdec;    /* Dec at which "factor" was found */
+   double lastra;     /* RA at which "factor" was found */
    double s;          /* Velocity correction (m/s) */
    int i;             /* Loop index */
    int result;        /* Returned value */
@@ -1631,6 +1660,13 @@ static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *f
 /* Check we have a rest-frame code. */
    if( result ) {
 
+/* If this is the first time this conversion has been applied, retain a
+   copy of the frame parameters. Otherwise, use the retained copy, which
+   will hold any intermediate values found on previous invocations. */
+      if( !*extra ) *extra = astStore( NULL, &def, sizeof( FrameDef ) );
+      pdef = (FrameDef *) *extra;
+      if( !astOK ) return result;
+
 /* First deal with cases where we have a single source position (given by
    refra and refdec). */
       if( !ra ) {
@@ -1640,7 +1676,7 @@ static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *f
 
 /* Get the velocity correction. This is the component of the velocity of the
    output system, away from the source, as measured in the input system. */
-            s = sign*cvtFunc( def.refra, def.refdec, &def, status );
+            s = sign*cvtFunc( pdef->refra, pdef->refdec, pdef, status );
 
 /* Find the factor by which to correct supplied frequencies. If the
    velocity correction is positive, the output frequency wil be lower than
@@ -1672,6 +1708,9 @@ static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *f
          if( !forward ) sign = -sign;
 
 /* Loop round each value. */
+         lastra = AST__BAD;
+         lastdec = AST__BAD;
+         factor = AST__BAD;
          pf = freq;
          pra = ra;
          pdec = dec;
@@ -1684,12 +1723,23 @@ static int FrameChange( int cvt_code, int np, double *ra, double *dec, double *f
 /* Otherwise, produce a corrected frequency. */
             } else {
 
-/* Get the velocity correction. */
-               s = sign*cvtFunc( *pra, *pdec, &def, status );
+/* Unless the position is the same as the previous one, get the velocity
+   correction and the corresponding frequency correction factor (AST__BAD
+   if the velocity correction is un-physical). */
+               if( *pra != lastra || *pdec != lastdec ) {
+                  s = sign*cvtFunc( *pra, *pdec, pdef, status );
+                  if( s < AST__C && s > -AST__C ) {
+                     factor = sqrt( ( AST__C - s )/( AST__C + s ) );
+                  } else {
+                     factor = AST__BAD;
+                  }
+                  lastra = *pra;
+                  lastdec = *pdec;
+               }
 
 /* Correct this frequency, if possible. Otherwise set bad. */
-               if( s < AST__C && s > -AST__C ) {
-                  *pf *= sqrt( ( AST__C - s )/( AST__C + s ) );
+               if( factor != AST__BAD ) {
+                  *pf *= factor;
                } else {
                   *pf = AST__BAD;
                }
@@ -3711,7 +3761,8 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
 
 /* Process conversions which correspond to changes of reference frames. */
          if( !FrameChange( map->cvttype[ cvt ], npoint, alpha, beta, spec,
-                          map->cvtargs[ cvt ], forward, status ) ) {
+                          map->cvtargs[ cvt ], map->cvtextra + cvt,
+                          forward, status ) ) {
 
 /* If this conversion was not a change of reference frame, it must be a
    change of system. */
@@ -3857,11 +3908,15 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
 /* For safety, first clear any references to the input memory from the output
    SpecMap. */
    out->cvtargs = NULL;
+   out->cvtextra = NULL;
    out->cvttype = NULL;
 
 /* Allocate memory for the output array of argument list pointers. */
    out->cvtargs = astMalloc( sizeof( double * ) * (size_t) in->ncvt );
 
+/* Allocate memory for the output array of extra (intermediate) values. */
+   out->cvtextra = astMalloc( sizeof( void * ) * (size_t) in->ncvt );
+
 /* If necessary, allocate memory and make a copy of the input array of
    coordinate conversion codes. */
    if ( in->cvttype ) out->cvttype = astStore( NULL, in->cvttype,
@@ -3875,6 +3930,8 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
       for ( cvt = 0; cvt < in->ncvt; cvt++ ) {
          out->cvtargs[ cvt ] = astStore( NULL, in->cvtargs[ cvt ],
                                          astSizeOf( in->cvtargs[ cvt ] ) );
+         out->cvtextra[ cvt ] = astStore( NULL, in->cvtextra[ cvt ],
+                                          astSizeOf( in->cvtextra[ cvt ] ) );
       }
 
 /* If an error occurred while copying the argument lists, loop through the
@@ -3883,6 +3940,7 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
       if ( !astOK ) {
          for ( cvt = 0; cvt < in->ncvt; cvt++ ) {
             out->cvtargs[ cvt ] = astFree( out->cvtargs[ cvt ] );
+            out->cvtextra[ cvt ] = astFree( out->cvtextra[ cvt ] );
 	 }
       }
    }
@@ -3890,6 +3948,7 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
 /* If an error occurred, free all other memory allocated above. */
    if ( !astOK ) {
       out->cvtargs = astFree( out->cvtargs );
+      out->cvtextra = astFree( out->cvtextra );
       out->cvttype = astFree( out->cvttype );
    }
 }
@@ -3938,11 +3997,13 @@ static void Delete( AstObject *obj, int *status ) {
    conversion. */
    for ( cvt = 0; cvt < this->ncvt; cvt++ ) {
       this->cvtargs[ cvt ] = astFree( this->cvtargs[ cvt ] );
+      this->cvtextra[ cvt ] = astFree( this->cvtextra[ cvt ] );
    }
 
 /* Free the memory holding the array of conversion types and the array of
    argument list pointers. */
    this->cvtargs = astFree( this->cvtargs );
+   this->cvtextra = astFree( this->cvtextra );
    this->cvttype = astFree( this->cvttype );
 }
 
@@ -4417,6 +4478,7 @@ AstSpecMap *astInitSpecMap_( void *mem, size_t size, int init,
    SpecMap simply implements a unit mapping. */
       new->ncvt = 0;
       new->cvtargs = NULL;
+      new->cvtextra = NULL;
       new->cvttype = NULL;
 
 /* If an error occurred, clean up by deleting the new object. */
@@ -4575,16 +4637,19 @@ AstSpecMap *astLoadSpecMap_( void *mem, size_t size,
       if ( new->ncvt < 0 ) new->ncvt = 0;
       new->cvttype = astMalloc( sizeof( int ) * (size_t) new->ncvt );
       new->cvtargs = astMalloc( sizeof( double * ) * (size_t) new->ncvt );
+      new->cvtextra = astMalloc( sizeof( void * ) * (size_t) new->ncvt );
 
 /* If an error occurred, ensure that all allocated memory is freed. */
       if ( !astOK ) {
          new->cvttype = astFree( new->cvttype );
          new->cvtargs = astFree( new->cvtargs );
+         new->cvtextra = astFree( new->cvtextra );
 
 /* Otherwise, initialise the argument pointer array. */
       } else {
          for ( icvt = 0; icvt < new->ncvt; icvt++ ) {
             new->cvtargs[ icvt ] = NULL;
+            new->cvtextra[ icvt ] = NULL;
          }
 
 /* Read in data for each conversion step... */
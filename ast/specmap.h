@@ -111,6 +111,8 @@
 *  History:
 *     8-NOV-2002 (DSB):
 *        Original version.
+*     16-OCT-2026 (DSB):
+*        Added cvtextra to the AstSpecMap structure.
 *-
 */
 
@@ -155,6 +157,7 @@ typedef struct AstSpecMap {
 /* Attributes specific to objects in this class. */
    int *cvttype;                 /* Pointer to array of conversion types */
    double **cvtargs;             /* Pointer to argument list pointer array */
+   void **cvtextra;              /* Pointer to intermediate values pointer array */
    int ncvt;                     /* Number of conversions to perform */
 } AstSpecMap;
 
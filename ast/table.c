@@ -43,9 +43,17 @@ c     astAddParameter
 f     AST_ADDPARAMETER
 *     method before being accessed.
 *
-*     Note - since accessing entries within a KeyMap is a relatively slow
-*     process, it is not recommended to use the Table class to store
-*     very large tables.
+*     Note - the cells of columns holding numerical values are stored
+*     internally in contiguous arrays, making it practical to store large
+*     tables of numerical values. However, if the Table is used in a way
+*     that requires all cells to be treated as individual KeyMap entries
+*     (for instance, if the keys are listed using
+c     astMapKey,
+f     AST_MAPKEY,
+*     a comment is stored with a cell, or the Table is written to a
+*     Channel), the affected columns are converted permanently to separate
+*     KeyMap entries, which are slower to access. Columns holding strings,
+*     Objects or pointers are always stored as separate KeyMap entries.
 
 *  Inheritance:
 *     The Table class inherits from the KeyMap class.
@@ -122,6 +130,10 @@ f     - AST_REMOVEROW: Remove a row from a Table
 *        Added support for table parameters.
 *     16-NOV-2013 (DSB):
 *        Fix bug in forming keys in GetColumnLenC.
+*     16-OCT-2026 (DSB):
+*        Store the cells of numerical columns in contiguous arrays rather
+*        than as separate entries in the parent KeyMap. Added protected
+*        methods astGetColumnValues and astPutColumnValues.
 *class--
 */
 
@@ -171,6 +183,22 @@ f     - AST_REMOVEROW: Remove a row from a Table
 #include <string.h>
 
 
+/* Type Definitions */
+/* ================ */
+/* A structure holding the cell values for a column of numerical values.
+   Such columns are stored in contiguous arrays, rather than as separate
+   entries in the parent KeyMap. */
+typedef struct AstTableColumn {
+   char name[ AST__MXCOLNAMLEN + 1 ]; /* Upper case column name */
+   int type;                     /* Data type code for the column values */
+   int nel;                      /* No. of values in each cell */
+   int vector;                   /* Does the column have a shape? */
+   size_t size;                  /* No. of bytes in each value */
+   int nalloc;                   /* No. of rows allocated */
+   char *data;                   /* Cell values ("nel" values per row) */
+   unsigned char *set;           /* Flags indicating rows with values */
+} AstTableColumn;
+
 /* Module Variables. */
 /* ================= */
 
@@ -235,6 +263,11 @@ static void (* parent_mapputelemp)( AstKeyMap *, const char *, int, void *, int
 static void (* parent_mapputelemb)( AstKeyMap *, const char *, int, unsigned char, int * );
 static void (* parent_mapputelems)( AstKeyMap *, const char *, int, short int, int * );
 static void (* parent_mapremove)( AstKeyMap *, const char *, int * );
+static int (* parent_mapdefined)( AstKeyMap *, const char *, int * );
+static int (* parent_maphaskey)( AstKeyMap *, const char *, int * );
+static int (* parent_maplenc)( AstKeyMap *, const char *, int * );
+static int (* parent_maplength)( AstKeyMap *, const char *, int * );
+static int (* parent_maptype)( AstKeyMap *, const char *, int * );
 static void (* parent_setattrib)( AstObject *, const char *, int * );
 static void (* parent_mapputu)( AstKeyMap *, const char *, const char *, int * );
 
@@ -283,7 +316,12 @@ AstTable *astTableId_( const char *, ... );
 
 /* Prototypes for Private Member Functions. */
 /* ======================================== */
+static AstKeyMap *CellKeyMap( AstTableColumn *, const char *, const char *, int * );
 static AstKeyMap *ColumnProps( AstTable *, int * );
+static AstTableColumn *FindPacked( AstTable *, const char *, int * );
+static AstTableColumn *PackedKey( AstTable *, const char *, int *, int * );
+static char *PackedCell( AstTable *, const char *, int, AstTableColumn **, int * );
+static char *PackedStore( AstTableColumn *, int, int * );
 static AstKeyMap *ParameterProps( AstTable *, int * );
 static const char *ColumnName( AstTable *, int index, int * );
 static const char *ParameterName( AstTable *, int index, int * );
@@ -294,6 +332,7 @@ static int GetColumnLenC( AstTable *, const char *, int * );
 static int GetColumnLength( AstTable *, const char *, int * );
 static int GetColumnNdim( AstTable *, const char *, int * );
 static int GetColumnType( AstTable *, const char *, int * );
+static int GetColumnValues( AstTable *, const char *, int, void *, unsigned char *, int * );
 static int GetNcolumn( AstTable *, int * );
 static int GetNparameter( AstTable *, int * );
 static int GetObjSize( AstObject *, int * );
@@ -323,6 +362,13 @@ static int MapGetElemF( AstKeyMap *, const char *, int, float *, int * );
 static int MapGetElemI( AstKeyMap *, const char *, int, int *, int * );
 static int MapGetElemP( AstKeyMap *, const char *, int, void **, int * );
 static int MapGetElemS( AstKeyMap *, const char *, int, short int *, int * );
+static int MapDefined( AstKeyMap *, const char *, int * );
+static int MapHasKey( AstKeyMap *, const char *, int * );
+static int MapLenC( AstKeyMap *, const char *, int * );
+static int MapLength( AstKeyMap *, const char *, int * );
+static int MapType( AstKeyMap *, const char *, int * );
+static int PackedGrow( AstTableColumn *, int, int * );
+static int PackedPutOK( AstTable *, AstTableColumn *, int, const char *, int * );
 static int ParseKey( AstTable *, const char *, int, char *, int *, AstKeyMap **, const char *, int * );
 static void AddColumn( AstTable *, const char *, int, int, int *, const char *, int * );
 static void AddParameter( AstTable *, const char *, int * );
@@ -355,6 +401,12 @@ static void MapPutElemI( AstKeyMap *, const char *, int, int, int * );
 static void MapPutElemP( AstKeyMap *, const char *, int, void *, int * );
 static void MapPutElemS( AstKeyMap *, const char *, int, short int, int * );
 static void MapPutU( AstKeyMap *, const char *, const char *, int * );
+static void MapRemove( AstKeyMap *, const char *, int * );
+static void MapSync( AstKeyMap *, int * );
+static void PutColumnValues( AstTable *, const char *, int, const void *, const unsigned char *, int * );
+static void StoreCell( AstKeyMap *, AstTableColumn *, const char *, const char *, int * );
+static void UnpackColumn( AstTable *, AstTableColumn *, int * );
+static size_t TypeSize( int );
 static void PurgeRows( AstTable *, int * );
 static void RemoveColumn( AstTable *, const char *, int * );
 static void RemoveParameter( AstTable *, const char *, int * );
@@ -472,6 +524,11 @@ f     routine
 *     returns without action if a column already exists in the Table
 *     with the supplied name and properties. However an error is
 *     reported if any of the properties differ.
+*     - The cells of columns holding int, short int, byte, double or
+*     float values are stored in contiguous arrays, rather than as
+*     separate KeyMap entries. See the description of the Table class
+*     for the circumstances in which they are converted into separate
+*     KeyMap entries.
 
 *--
 */
@@ -479,12 +536,14 @@ f     routine
 /* Local Variables: */
    AstKeyMap *cols;      /* KeyMap holding all column details */
    AstKeyMap *col_km;    /* KeyMap holding new column details */
+   AstTableColumn *col;  /* Structure describing a packed column */
    const char *oldunit;  /* Pointer to the old coumn unit string */
    int *olddims;         /* Shape of pre-existing column */
    int idim;             /* Axis index */
    int namlen;           /* Used length of "name" */
    int nval;             /* Number of values returned */
    int oldtype;          /* Data type of pre-existing column */
+   size_t size;          /* Number of bytes per value */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -576,6 +635,29 @@ f     routine
 /* Put the column KeyMap into the KeyMap holding details of all columns.
    Use the column name as the key. */
          astMapPut0A( cols, name, col_km, NULL );
+
+/* The cells of columns holding numerical values are stored in contiguous
+   arrays rather than as separate entries in the parent KeyMap. Add a
+   structure describing the (initially empty) arrays for the new column
+   to the list of packed columns. */
+         size = TypeSize( type );
+         if( size > 0 ) {
+            this->packed = astGrow( this->packed, this->npacked + 1,
+                                    sizeof( AstTableColumn ) );
+            if( astOK ) {
+               col = this->packed + ( this->npacked++ );
+               astChrCase( name, col->name, 1, namlen + 1 );
+               col->name[ namlen ] = 0;
+               col->type = type;
+               col->size = size;
+               col->vector = ( ndim > 0 );
+               col->nel = 1;
+               for( idim = 0; idim < ndim; idim++ ) col->nel *= dims[ idim ];
+               col->nalloc = 0;
+               col->data = NULL;
+               col->set = NULL;
+            }
+         }
       }
 
 /* Annul the local KeyMap pointers. */
@@ -663,6 +745,70 @@ f        The global status.
    }
 }
 
+static AstKeyMap *CellKeyMap( AstTableColumn *col, const char *key,
+                              const char *cell, int *status ) {
+/*
+*  Name:
+*     CellKeyMap
+
+*  Purpose:
+*     Create a KeyMap holding a copy of a packed cell value.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     AstKeyMap *CellKeyMap( AstTableColumn *col, const char *key,
+*                            const char *cell, int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function returns a new KeyMap holding a single entry that
+*     contains a copy of the value of a cell from a column that is held
+*     in a contiguous array (see AddColumn). It is used to perform any
+*     data type conversion or formatting needed when the cell is read,
+*     so that the same conversions are used as for cells stored as
+*     separate KeyMap entries.
+
+*  Parameters:
+*     col
+*        Pointer to the structure describing the packed column.
+*     key
+*        The key to use for the entry in the returned KeyMap.
+*     cell
+*        Pointer to the first value in the cell.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the new KeyMap. It should be annulled using astAnnul
+*     when no longer needed.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstKeyMap *result;    /* Returned KeyMap */
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Create the KeyMap and store the cell value in it. */
+   result = astKeyMap( " ", status );
+   StoreCell( result, col, key, cell, status );
+
+/* Annul the KeyMap if an error occurred. */
+   if( !astOK ) result = astAnnul( result );
+
+/* Return the result. */
+   return result;
+}
+
 static void ClearAttrib( AstObject *this_object, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -1106,6 +1252,85 @@ static int Equal( AstObject *this_object, AstObject *that_object, int *status )
    return result;
 }
 
+static AstTableColumn *FindPacked( AstTable *this, const char *name,
+                                   int *status ) {
+/*
+*  Name:
+*     FindPacked
+
+*  Purpose:
+*     Find the contiguous arrays holding the values of a column.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     AstTableColumn *FindPacked( AstTable *this, const char *name,
+*                                 int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function returns a pointer to the structure describing the
+*     contiguous arrays used to hold the cell values of a named column.
+*     Only columns holding numerical values are stored in this way, and
+*     only until they are converted into separate KeyMap entries by
+*     UnpackColumn.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     name
+*        The column name. Trailing spaces are ignored and case is
+*        insignificant.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the column structure, or NULL if the column values are
+*     not held in contiguous arrays. The returned pointer should not be
+*     used after any subsequent change in the number of columns held in
+*     contiguous arrays.
+
+*  Notes:
+*     - A NULL pointer will be returned if this function is invoked
+*     with the global status set, or if it should fail for any reason.
+*/
+
+/* Local Variables: */
+   AstTableColumn *result;       /* Returned pointer */
+   char colname[ AST__MXCOLNAMLEN + 1 ]; /* Upper case column name */
+   int icol;                     /* Index of packed column */
+   int namlen;                   /* Used length of column name */
+
+/* Initialise */
+   result = NULL;
+
+/* Check the global error status, and do nothing more if no columns are
+   held in contiguous arrays. */
+   if ( !astOK || this->npacked == 0 ) return result;
+
+/* Get the upper case column name, excluding trailing spaces. */
+   namlen = astChrLen( name );
+   if( namlen <= AST__MXCOLNAMLEN ) {
+      astChrCase( name, colname, 1, namlen + 1 );
+      colname[ namlen ] = 0;
+
+/* Search for a packed column with the same name. */
+      for( icol = 0; icol < this->npacked; icol++ ) {
+         if( !strcmp( this->packed[ icol ].name, colname ) ) {
+            result = this->packed + icol;
+            break;
+         }
+      }
+   }
+
+/* Return the result. */
+   return result;
+}
+
 static const char *GetAttrib( AstObject *this_object, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -1736,6 +1961,166 @@ static const char *GetColumnUnit( AstTable *this, const char *column, int *statu
    return result;
 }
 
+static int GetColumnValues( AstTable *this, const char *column, int nrow,
+                            void *data, unsigned char *defined, int *status ) {
+/*
+*+
+*  Name:
+*     astGetColumnValues
+
+*  Purpose:
+*     Retrieve all the values in a numerical column.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "table.h"
+*     int astGetColumnValues( AstTable *this, const char *column, int nrow,
+*                             void *data, unsigned char *defined )
+
+*  Class Membership:
+*     Table method.
+
+*  Description:
+*     This function copies the values stored in the first "nrow" rows of
+*     a named column into a single supplied array. Only columns holding
+*     int, short int, byte, double or float values are supported. If the
+*     column values are held internally in contiguous arrays (see
+*     astAddColumn), they are copied directly from the arrays. Otherwise,
+*     each cell is read separately.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     column
+*        The name of the column.
+*     nrow
+*        The number of rows to copy, starting at row 1.
+*     data
+*        Pointer to an array in which to return the column values. It
+*        should have room for "nrow" times the column length (see
+*        astGetColumnLength) values of the column data type (see
+*        astGetColumnType). The values for each row are stored
+*        consecutively. The elements corresponding to empty cells are
+*        returned unchanged.
+*     defined
+*        Pointer to an array with "nrow" elements in which to return a
+*        flag for each row indicating if the cell has a value (one) or
+*        is empty (zero). May be NULL.
+
+*  Returned Value:
+*     The number of rows for which values were returned.
+
+*  Notes:
+*     - An error is reported if the column does not hold numerical values.
+*     - A value of zero will be returned if this function is invoked
+*     with the global status set, or if it should fail for any reason.
+*-
+*/
+
+/* Local Variables: */
+   AstTableColumn *col;          /* Packed column structure */
+   char *pout;                   /* Pointer to next output row */
+   char key[ AST__MXCOLKEYLEN + 1 ]; /* Cell key string */
+   int got;                      /* Was a value obtained for the cell? */
+   int irow;                     /* Zero-based row index */
+   int keyerror;                 /* Does the Table report missing keys? */
+   int namlen;                   /* Used length of column name */
+   int nel;                      /* Number of values per cell */
+   int nget;                     /* Number of rows held in packed arrays */
+   int nval;                     /* Number of values read from cell */
+   int result;                   /* Returned value */
+   int type;                     /* Column data type */
+   size_t rowsize;               /* Number of bytes per row */
+   size_t size;                  /* Number of bytes per value */
+
+/* Initialise */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Get the data type and number of values per cell (this reports an
+   error if the column does not exist). */
+   type = astGetColumnType( this, column );
+   nel = astGetColumnLength( this, column );
+   size = TypeSize( type );
+   if( astOK && size == 0 ) {
+      astError( AST__BADTYP, "astGetColumnValues(%s): Cannot get the "
+                "values of column %s as an array: the column holds %s "
+                "values.", status, astGetClass( this ), column,
+                TypeString( type ) );
+   }
+
+/* Do nothing more if an error has occurred or no rows are needed. */
+   if( astOK && nrow > 0 ) {
+      rowsize = nel*size;
+
+/* If the column values are held in contiguous arrays, copy them directly.
+   Use a single copy if every cell has a value. */
+      col = FindPacked( this, column, status );
+      if( col ) {
+         nget = ( nrow < col->nalloc ) ? nrow : col->nalloc;
+         for( irow = 0; irow < nget; irow++ ) {
+            if( col->set[ irow ] ) result++;
+         }
+
+         if( result == nget ) {
+            memcpy( data, col->data, nget*rowsize );
+         } else {
+            pout = data;
+            for( irow = 0; irow < nget; irow++ ) {
+               if( col->set[ irow ] ) {
+                  memcpy( pout, col->data + irow*rowsize, rowsize );
+               }
+               pout += rowsize;
+            }
+         }
+
+         if( defined ) {
+            if( nget > 0 ) memcpy( defined, col->set, (size_t) nget );
+            if( nrow > nget ) memset( defined + nget, 0, nrow - nget );
+         }
+
+/* Otherwise, read each cell separately. Check the cell exists first if
+   the KeyError attribute is set, to avoid an error being reported for
+   empty cells. */
+      } else {
+         namlen = astChrLen( column );
+         keyerror = astGetKeyError( this );
+         pout = data;
+         for( irow = 0; irow < nrow && astOK; irow++ ) {
+            sprintf( key, "%.*s(%d)", namlen, column, irow + 1 );
+
+            if( keyerror && !astMapHasKey( this, key ) ) {
+               got = 0;
+            } else if( type == AST__INTTYPE ) {
+               got = astMapGet1I( this, key, nel, &nval, (int *) pout );
+            } else if( type == AST__SINTTYPE ) {
+               got = astMapGet1S( this, key, nel, &nval, (short int *) pout );
+            } else if( type == AST__BYTETYPE ) {
+               got = astMapGet1B( this, key, nel, &nval, (unsigned char *) pout );
+            } else if( type == AST__DOUBLETYPE ) {
+               got = astMapGet1D( this, key, nel, &nval, (double *) pout );
+            } else {
+               got = astMapGet1F( this, key, nel, &nval, (float *) pout );
+            }
+
+            if( got ) result++;
+            if( defined ) defined[ irow ] = got ? 1 : 0;
+            pout += rowsize;
+         }
+      }
+   }
+
+/* If an error occurred, return zero. */
+   if( !astOK ) result = 0;
+
+/* Return the result. */
+   return result;
+}
+
 static int GetNcolumn( AstTable *this, int *status ) {
 /*
 *+
@@ -1888,6 +2273,7 @@ static int GetObjSize( AstObject *this_object, int *status ) {
 /* Local Variables: */
    AstKeyMap *km;             /* KeyMap holding column/parameter definitions */
    AstTable *this;            /* Pointer to Table structure */
+   int icol;                  /* Index of packed column */
    int result;                /* Result value to return */
 
 /* Initialise. */
@@ -1912,6 +2298,12 @@ static int GetObjSize( AstObject *this_object, int *status ) {
    result += astGetObjSize( km );
    km = astAnnul( km );
 
+   result += astTSizeOf( this->packed );
+   for( icol = 0; icol < this->npacked; icol++ ) {
+      result += astTSizeOf( this->packed[ icol ].data );
+      result += astTSizeOf( this->packed[ icol ].set );
+   }
+
 /* If an error occurred, clear the result value. */
    if ( !astOK ) result = 0;
 
@@ -2149,6 +2541,8 @@ void astInitTableVtab_(  AstTableVtab *vtab, const char *name, int *status ) {
    vtab->RemoveParameter = RemoveParameter;
    vtab->RemoveRow = RemoveRow;
    vtab->SetNrow = SetNrow;
+   vtab->GetColumnValues = GetColumnValues;
+   vtab->PutColumnValues = PutColumnValues;
 
 /* Save the inherited pointers to methods that will be extended, and
    replace them with pointers to the new member functions. */
@@ -2179,6 +2573,24 @@ void astInitTableVtab_(  AstTableVtab *vtab, const char *name, int *status ) {
 #endif
 
    parent_mapremove = keymap->MapRemove;
+   keymap->MapRemove = MapRemove;
+
+   parent_mapdefined = keymap->MapDefined;
+   keymap->MapDefined = MapDefined;
+
+   parent_maphaskey = keymap->MapHasKey;
+   keymap->MapHasKey = MapHasKey;
+
+   parent_maplenc = keymap->MapLenC;
+   keymap->MapLenC = MapLenC;
+
+   parent_maplength = keymap->MapLength;
+   keymap->MapLength = MapLength;
+
+   parent_maptype = keymap->MapType;
+   keymap->MapType = MapType;
+
+   keymap->MapSync = MapSync;
 
 /* Define convenience macros for overriding methods inherited from the
    parent KeyMap class using all data type supported by KeyMap. */
@@ -2404,7 +2816,10 @@ static int MapGet0##X( AstKeyMap *this_keymap, const char *key, Xtype *value, \
                        int *status ) { \
 \
 /* Local Variables: */ \
+   AstKeyMap *km;      /* KeyMap holding a copy of a packed cell */ \
    AstTable *this;     /* Pointer to Table structure */ \
+   AstTableColumn *col; /* Packed column holding the cell */ \
+   char *cell;         /* Pointer to packed cell value */ \
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */ \
    int irow;           /* Row index within key string */ \
    int result;         /* Returned flag */ \
@@ -2433,9 +2848,23 @@ static int MapGet0##X( AstKeyMap *this_keymap, const char *key, Xtype *value, \
    table, do nothing more. */ \
       if( irow <= astGetNrow( this ) ){ \
 \
-/* Use the astMapGet0<X> method in the parent keyMap class to get the \
-   cell contents. */ \
-         result = (*parent_mapget0##Xlc)( this_keymap, key, value, status ); \
+/* If the cell is held in the contiguous array of a numerical column, \
+   copy the value directly if no type conversion is needed. Otherwise, use \
+   a temporary KeyMap holding the cell value to do the conversion. */ \
+         cell = PackedCell( this, colname, irow, &col, status ); \
+         if( cell && col->type == Itype ) { \
+            *value = *( (Xtype *) cell ); \
+            result = 1; \
+         } else if( cell ) { \
+            km = CellKeyMap( col, key, cell, status ); \
+            result = astMapGet0##X( km, key, value ); \
+            km = astAnnul( km ); \
+\
+/* Otherwise, use the astMapGet0<X> method in the parent keyMap class to \
+   get the cell contents. */ \
+         } else { \
+            result = (*parent_mapget0##Xlc)( this_keymap, key, value, status ); \
+         } \
       } \
    } \
 \
@@ -2548,7 +2977,10 @@ static int MapGet1##X( AstKeyMap *this_keymap, const char *key, int mxval, int *
                        Xtype *value, int *status ) { \
 \
 /* Local Variables: */ \
+   AstKeyMap *km;      /* KeyMap holding a copy of a packed cell */ \
    AstTable *this;     /* Pointer to Table structure */ \
+   AstTableColumn *col; /* Packed column holding the cell */ \
+   char *cell;         /* Pointer to packed cell value */ \
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */ \
    int irow;           /* Row index within key string */ \
    int result;         /* Returned flag */ \
@@ -2578,10 +3010,25 @@ static int MapGet1##X( AstKeyMap *this_keymap, const char *key, int mxval, int *
    table, do nothing more. */ \
       if( irow <= astGetNrow( this ) ){ \
 \
-/* Use the astMapGet1<X> method in the parent keyMap class to get the \
-   cell contents. */ \
-         result = (*parent_mapget1##Xlc)( this_keymap, key, mxval, nval, \
-                   value, status ); \
+/* If the cell is held in the contiguous array of a numerical column, \
+   copy the values directly if no type conversion is needed. Otherwise, \
+   use a temporary KeyMap holding the cell value to do the conversion. */ \
+         cell = PackedCell( this, colname, irow, &col, status ); \
+         if( cell && col->type == Itype && mxval >= col->nel ) { \
+            memcpy( value, cell, col->nel*sizeof( Xtype ) ); \
+            *nval = col->nel; \
+            result = 1; \
+         } else if( cell ) { \
+            km = CellKeyMap( col, key, cell, status ); \
+            result = astMapGet1##X( km, key, mxval, nval, value ); \
+            km = astAnnul( km ); \
+\
+/* Otherwise, use the astMapGet1<X> method in the parent keyMap class to \
+   get the cell contents. */ \
+         } else { \
+            result = (*parent_mapget1##Xlc)( this_keymap, key, mxval, nval, \
+                      value, status ); \
+         } \
       } \
    } \
 \
@@ -2638,7 +3085,10 @@ static int MapGet1C( AstKeyMap *this_keymap, const char *key, int l, int mxval,
 */
 
 /* Local Variables: */
+   AstKeyMap *km;      /* KeyMap holding a copy of a packed cell */
    AstTable *this;     /* Pointer to Table structure */
+   AstTableColumn *col; /* Packed column holding the cell */
+   char *cell;         /* Pointer to packed cell value */
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */
    int irow;           /* Row index within key string */
    int result;         /* Returned flag */
@@ -2668,10 +3118,20 @@ static int MapGet1C( AstKeyMap *this_keymap, const char *key, int l, int mxval,
    table, do nothing more. */
       if( irow <= astGetNrow( this ) ){
 
-/* Use the astMapGet1<X> method in the parent keyMap class to get the
-   cell contents. */
-         result = (*parent_mapget1c)( this_keymap, key, l, mxval, nval,
-                   value, status );
+/* If the cell is held in the contiguous array of a numerical column,
+   use a temporary KeyMap holding the cell value to format the values. */
+         cell = PackedCell( this, colname, irow, &col, status );
+         if( cell ) {
+            km = CellKeyMap( col, key, cell, status );
+            result = astMapGet1C( km, key, l, mxval, nval, value );
+            km = astAnnul( km );
+
+/* Otherwise, use the astMapGet1<X> method in the parent keyMap class to
+   get the cell contents. */
+         } else {
+            result = (*parent_mapget1c)( this_keymap, key, l, mxval, nval,
+                      value, status );
+         }
       }
    }
 
@@ -2768,7 +3228,10 @@ static int MapGetElem##X( AstKeyMap *this_keymap, const char *key, int elem, \
                           Xtype *value, int *status ) { \
 \
 /* Local Variables: */ \
+   AstKeyMap *km;      /* KeyMap holding a copy of a packed cell */ \
    AstTable *this;     /* Pointer to Table structure */ \
+   AstTableColumn *col; /* Packed column holding the cell */ \
+   char *cell;         /* Pointer to packed cell value */ \
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */ \
    int irow;           /* Row index within key string */ \
    int result;         /* Returned flag */ \
@@ -2798,10 +3261,26 @@ static int MapGetElem##X( AstKeyMap *this_keymap, const char *key, int elem, \
    table, do nothing more. */ \
       if( irow <= astGetNrow( this ) ){ \
 \
-/* Use the astMapGetElem<X> method in the parent keyMap class to get the \
-   cell contents. */ \
-         result = (*parent_mapgetelem##Xlc)( this_keymap, key, elem, \
-                                             value, status ); \
+/* If the cell is held in the contiguous array of a numerical column, \
+   copy the value directly if no type conversion is needed. Otherwise, use \
+   a temporary KeyMap holding the cell value to do the conversion (this \
+   also reports any error caused by an invalid element index). */ \
+         cell = PackedCell( this, colname, irow, &col, status ); \
+         if( cell && col->type == Itype && col->vector && elem >= 0 && \
+             elem < col->nel ) { \
+            *value = ( (Xtype *) cell )[ elem ]; \
+            result = 1; \
+         } else if( cell ) { \
+            km = CellKeyMap( col, key, cell, status ); \
+            result = astMapGetElem##X( km, key, elem, value ); \
+            km = astAnnul( km ); \
+\
+/* Otherwise, use the astMapGetElem<X> method in the parent keyMap class \
+   to get the cell contents. */ \
+         } else { \
+            result = (*parent_mapgetelem##Xlc)( this_keymap, key, elem, \
+                                                value, status ); \
+         } \
       } \
    } \
 \
@@ -2857,7 +3336,10 @@ static int MapGetElemC( AstKeyMap *this_keymap, const char *key, int l,
 */
 
 /* Local Variables: */
+   AstKeyMap *km;      /* KeyMap holding a copy of a packed cell */
    AstTable *this;     /* Pointer to Table structure */
+   AstTableColumn *col; /* Packed column holding the cell */
+   char *cell;         /* Pointer to packed cell value */
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */
    int irow;           /* Row index within key string */
    int result;         /* Returned flag */
@@ -2887,10 +3369,20 @@ static int MapGetElemC( AstKeyMap *this_keymap, const char *key, int l,
    table, do nothing more. */
       if( irow <= astGetNrow( this ) ){
 
-/* Use the astMapGetElem<X> method in the parent keyMap class to get the
-   cell contents. */
-         result = (*parent_mapgetelemc)( this_keymap, key, l, elem,
-                                         value, status );
+/* If the cell is held in the contiguous array of a numerical column,
+   use a temporary KeyMap holding the cell value to format the value. */
+         cell = PackedCell( this, colname, irow, &col, status );
+         if( cell ) {
+            km = CellKeyMap( col, key, cell, status );
+            result = astMapGetElemC( km, key, l, elem, value );
+            km = astAnnul( km );
+
+/* Otherwise, use the astMapGetElem<X> method in the parent keyMap class
+   to get the cell contents. */
+         } else {
+            result = (*parent_mapgetelemc)( this_keymap, key, l, elem,
+                                            value, status );
+         }
       }
    }
 
@@ -2972,6 +3464,8 @@ static void MapPut0##X( AstKeyMap *this_keymap, const char *key, Xtype value, \
 /* Local Variables: */ \
    AstKeyMap *col_km;  /* KeyMap holding details of the requested column */ \
    AstTable *this;     /* Pointer to Table structure */ \
+   AstTableColumn *col; /* Packed column holding the cell */ \
+   char *cell;         /* Pointer to packed cell value */ \
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */ \
    int irow;           /* Row index within key string */ \
    int type;           /* Data type of the requested column */ \
@@ -3013,9 +3507,20 @@ static void MapPut0##X( AstKeyMap *this_keymap, const char *key, Xtype value, \
    table, update the number of rows in the table. */ \
       if( irow > astGetNrow( this ) ) astSetNrow( this, irow ); \
 \
-/* Use the astMapPut0<X> method in the parent keyMap class to store the \
-   new cell contents. */ \
-      (*parent_mapput0##Xlc)( this_keymap, key, value, comment, status ); \
+/* If the column values are held in a contiguous array, store the new \
+   value directly in the array. */ \
+      col = FindPacked( this, colname, status ); \
+      if( col && PackedPutOK( this, col, irow, comment, status ) ) { \
+         cell = PackedStore( col, irow, status ); \
+         if( cell ) *( (Xtype *) cell ) = value; \
+\
+/* Otherwise, ensure the column is held as separate KeyMap entries and use \
+   the astMapPut0<X> method in the parent keyMap class to store the new \
+   cell contents. */ \
+      } else { \
+         if( col ) UnpackColumn( this, col, status ); \
+         (*parent_mapput0##Xlc)( this_keymap, key, value, comment, status ); \
+      } \
 \
 /* Free resources. */ \
       col_km = astAnnul( col_km ); \
@@ -3104,6 +3609,8 @@ static void MapPut1##X( AstKeyMap *this_keymap, const char *key, int size, \
 \
 /* Local Variables: */ \
    AstTable *this;     /* Pointer to Table structure */ \
+   AstTableColumn *col; /* Packed column holding the cell */ \
+   char *cell;         /* Pointer to packed cell value */ \
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */ \
    int irow;           /* Row index within key string */ \
 \
@@ -3144,11 +3651,21 @@ static void MapPut1##X( AstKeyMap *this_keymap, const char *key, int size, \
       } \
 \
 /* If all is OK, update the number of rows in the table if required, and \
-   store the vector in the parent KeyMap. */ \
+   store the vector. If the column values are held in a contiguous array, \
+   copy the vector directly into the array. Otherwise, ensure the column \
+   is held as separate KeyMap entries and store the vector in the parent \
+   KeyMap. */ \
       if( astOK ) { \
          if( irow > astGetNrow( this ) ) astSetNrow( this, irow ); \
-         (*parent_mapput1##Xlc)( this_keymap, key, size, value, \
-                                 comment, status ); \
+         col = FindPacked( this, colname, status ); \
+         if( col && PackedPutOK( this, col, irow, comment, status ) ) { \
+            cell = PackedStore( col, irow, status ); \
+            if( cell ) memcpy( cell, value, size*sizeof( Xtype ) ); \
+         } else { \
+            if( col ) UnpackColumn( this, col, status ); \
+            (*parent_mapput1##Xlc)( this_keymap, key, size, value, \
+                                    comment, status ); \
+         } \
       } \
 \
    } \
@@ -3240,6 +3757,8 @@ static void MapPutElem##X( AstKeyMap *this_keymap, const char *key, int elem, \
 \
 /* Local Variables: */ \
    AstTable *this;     /* Pointer to Table structure */ \
+   AstTableColumn *col; /* Packed column holding the cell */ \
+   char *cell;         /* Pointer to packed cell value */ \
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */ \
    int irow;           /* Row index within key string */ \
    int type;           /* Data type of the requested column */ \
@@ -3282,11 +3801,20 @@ static void MapPutElem##X( AstKeyMap *this_keymap, const char *key, int elem, \
       } \
 \
 /* If all is OK, update the number of rows in the table if required, and \
-   store the value in the parent KeyMap. */ \
+   store the value. If the cell already has a value held in the contiguous \
+   array of a vector column, modify the array directly. Otherwise, ensure \
+   the column is held as separate KeyMap entries and store the value in the \
+   parent KeyMap. */ \
       if( astOK ) { \
          if( irow > astGetNrow( this ) ) astSetNrow( this, irow ); \
-         (*parent_mapputelem##Xlc)( this_keymap, key, elem, value, \
-                                    status ); \
+         cell = PackedCell( this, colname, irow, &col, status ); \
+         if( cell && col->vector && elem >= 0 ) { \
+            ( (Xtype *) cell )[ elem ] = value; \
+         } else { \
+            if( col ) UnpackColumn( this, col, status ); \
+            (*parent_mapputelem##Xlc)( this_keymap, key, elem, value, \
+                                       status ); \
+         } \
       } \
    } \
 }
@@ -3362,6 +3890,7 @@ static void MapPutU( AstKeyMap *this_keymap, const char *key, const char *commen
 
 /* Local Variables: */
    AstTable *this;     /* Pointer to Table structure */
+   AstTableColumn *col; /* Packed column holding the cell */
    char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from string */
    int irow;           /* Row index within key string */
 
@@ -3386,103 +3915,791 @@ static void MapPutU( AstKeyMap *this_keymap, const char *key, const char *commen
    table, update the number of rows in the table. */
       if( irow > astGetNrow( this ) ) astSetNrow( this, irow );
 
+/* Undefined values cannot be held in the contiguous array used for a
+   numerical column, so ensure the column is held as separate KeyMap
+   entries. */
+      col = FindPacked( this, colname, status );
+      if( col ) UnpackColumn( this, col, status );
+
 /* Use the astMapPutU method in the parent keyMap class to store the
    new cell contents. */
       (*parent_mapputu)( this_keymap, key, comment, status );
    }
 }
 
-static const char *ParameterName( AstTable *this, int index, int *status ) {
+static int MapDefined( AstKeyMap *this_keymap, const char *key, int *status ) {
 /*
-*++
 *  Name:
-c     astParameterName
-f     AST_PARAMETERNAME
+*     MapDefined
 
 *  Purpose:
-*     Get the name of the global parameter at a given index within the Table.
+*     Check if a Table cell has a defined value.
 
 *  Type:
-*     Public virtual function.
+*     Private function.
 
 *  Synopsis:
-c     #include "table.h"
-c     const char *astParameterName( AstTable *this, int index )
-f     RESULT = AST_PARAMETERNAME( THIS, INDEX, STATUS )
+*     #include "table.h"
+*     int MapDefined( AstKeyMap *this, const char *key, int *status )
 
 *  Class Membership:
-*     Table method.
+*     Table member function (over-rides the astMapDefined method inherited
+*     from the KeyMap class).
 
 *  Description:
-*     This function returns a string holding the name of the global parameter with
-*     the given index within the Table.
-*
-*     This function is intended primarily as a means of iterating round all
-*     the parameters in a Table. For this purpose, the number of parameters in
-*     the Table is given by the Nparameter attribute of the Table. This function
-*     could then be called in a loop, with the index value going from
-c     zero to one less than Nparameter.
-f     one to Nparameter.
-*
-*     Note, the index associated with a parameter decreases monotonically with
-*     the age of the parameter: the oldest Parameter in the Table will have index
-*     one, and the Parameter added most recently to the Table will have the
-*     largest index.
+*     This function checks if a cell held in the contiguous array of a
+*     numerical column has a value (such values are always defined).
+*     Other keys are passed on to the parent KeyMap method.
 
 *  Parameters:
-c     this
-f     THIS = INTEGER (Given)
-*        Pointer to the Table.
-c     index
-f     INDEX = INTEGER (Given)
-*        The index into the list of parameters. The first parameter has index
-*        one, and the last has index "Nparameter".
-f     STATUS = INTEGER (Given and Returned)
-f        The global status.
-
-*  Returned Value:
-c     astParameterName()
-c        A pointer to a null-terminated string containing the
-f     AST_PARAMETERNAME = CHARACTER * ( AST__SZCHR )
-f        The
-*        upper case parameter name.
-
-*  Notes:
-c     - The returned pointer is guaranteed to remain valid and the
-c     string to which it points will not be over-written for a total
-c     of 50 successive invocations of this function. After this, the
-c     memory containing the string may be re-used, so a copy of the
-c     string should be made if it is needed for longer than this.
-c     - A NULL pointer will be returned if this function is invoked
-c     with the AST error status set, or if it should fail for any
-c     reason.
-f     - A blank string will be returned if this function is invoked
-f     with STATUS set to an error value, or if it should fail for any
-f     reason.
-*--
+*     (see astMapDefined)
 */
 
 /* Local Variables: */
-   AstKeyMap *pars;        /* KeyMap holding parameter definitions */
-   const char *result;
+   AstTableColumn *col;  /* Packed column holding the cell */
+   int irow;             /* Row index within key string */
+   int result;           /* Returned flag */
 
-/* Check the global error status. */
-   if ( !astOK ) return NULL;
+/* Initialise */
+   result = 0;
 
-/* Get apointer to the KeyMap holding all parameter definitions. */
-   pars = astParameterProps( this );
+/* Check the global error status. */
+   if ( !astOK ) return result;
 
-/* Issue a more useful error message than that issued by astMapKey if the
-   index is invalid. */
-   if( index < 1 || index > astMapSize( pars ) ) {
-      astError( AST__MPIND, "astParameterName(%s): Cannot find parameter "
-                "%d (zero-based) of the %s - invalid index.", status,
-                astGetClass( this ), index, astGetClass( this ) );
+/* Use the parent method unless the key refers to a packed cell that has
+   a value. */
+   col = PackedKey( (AstTable *) this_keymap, key, &irow, status );
+   if( col && irow <= col->nalloc && col->set[ irow - 1 ] ) {
+      result = 1;
+   } else {
+      result = (*parent_mapdefined)( this_keymap, key, status );
    }
 
-/* Get the parameter name. */
-   result = astMapKey( pars, index - 1 );
-
+/* Return the result. */
+   return result;
+}
+
+static int MapHasKey( AstKeyMap *this_keymap, const char *key, int *status ) {
+/*
+*  Name:
+*     MapHasKey
+
+*  Purpose:
+*     Check if a Table cell has a value.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     int MapHasKey( AstKeyMap *this, const char *key, int *status )
+
+*  Class Membership:
+*     Table member function (over-rides the astMapHasKey method inherited
+*     from the KeyMap class).
+
+*  Description:
+*     This function checks if a cell held in the contiguous array of a
+*     numerical column has a value. Other keys are passed on to the
+*     parent KeyMap method.
+
+*  Parameters:
+*     (see astMapHasKey)
+*/
+
+/* Local Variables: */
+   AstTableColumn *col;  /* Packed column holding the cell */
+   int irow;             /* Row index within key string */
+   int result;           /* Returned flag */
+
+/* Initialise */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Check the packed cell if the key refers to a packed column. Otherwise,
+   use the parent method. */
+   col = PackedKey( (AstTable *) this_keymap, key, &irow, status );
+   if( col ) {
+      result = ( irow <= col->nalloc && col->set[ irow - 1 ] );
+   } else {
+      result = (*parent_maphaskey)( this_keymap, key, status );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static int MapLenC( AstKeyMap *this_keymap, const char *key, int *status ) {
+/*
+*  Name:
+*     MapLenC
+
+*  Purpose:
+*     Get the number of characters in the formatted value of a Table cell.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     int MapLenC( AstKeyMap *this, const char *key, int *status )
+
+*  Class Membership:
+*     Table member function (over-rides the astMapLenC method inherited
+*     from the KeyMap class).
+
+*  Description:
+*     This function returns the length of the formatted value of a cell
+*     held in the contiguous array of a numerical column, using the same
+*     formatting as the KeyMap class. Other keys are passed on to the
+*     parent KeyMap method.
+
+*  Parameters:
+*     (see astMapLenC)
+*/
+
+/* Local Variables: */
+   AstKeyMap *km;        /* KeyMap holding a copy of the packed cell */
+   AstTableColumn *col;  /* Packed column holding the cell */
+   int irow;             /* Row index within key string */
+   int result;           /* Returned value */
+
+/* Initialise */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* If the key refers to a packed cell that has a value, use a temporary
+   KeyMap holding a copy of the value to determine the formatted length.
+   Otherwise, use the parent method. */
+   col = PackedKey( (AstTable *) this_keymap, key, &irow, status );
+   if( col && irow <= col->nalloc && col->set[ irow - 1 ] ) {
+      km = CellKeyMap( col, key, col->data +
+                       ( (size_t) ( irow - 1 ) )*col->nel*col->size, status );
+      result = astMapLenC( km, key );
+      km = astAnnul( km );
+   } else {
+      result = (*parent_maplenc)( this_keymap, key, status );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static int MapLength( AstKeyMap *this_keymap, const char *key, int *status ) {
+/*
+*  Name:
+*     MapLength
+
+*  Purpose:
+*     Get the number of values stored in a Table cell.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     int MapLength( AstKeyMap *this, const char *key, int *status )
+
+*  Class Membership:
+*     Table member function (over-rides the astMapLength method inherited
+*     from the KeyMap class).
+
+*  Description:
+*     This function returns the number of values stored in a cell held in
+*     the contiguous array of a numerical column. Other keys are passed on
+*     to the parent KeyMap method.
+
+*  Parameters:
+*     (see astMapLength)
+*/
+
+/* Local Variables: */
+   AstTableColumn *col;  /* Packed column holding the cell */
+   int irow;             /* Row index within key string */
+   int result;           /* Returned value */
+
+/* Initialise */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Use the parent method unless the key refers to a packed cell that has
+   a value. */
+   col = PackedKey( (AstTable *) this_keymap, key, &irow, status );
+   if( col ) {
+      if( irow <= col->nalloc && col->set[ irow - 1 ] ) result = col->nel;
+   } else {
+      result = (*parent_maplength)( this_keymap, key, status );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static void MapRemove( AstKeyMap *this_keymap, const char *key, int *status ) {
+/*
+*  Name:
+*     MapRemove
+
+*  Purpose:
+*     Remove the value from a Table cell.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     void MapRemove( AstKeyMap *this, const char *key, int *status )
+
+*  Class Membership:
+*     Table member function (over-rides the astMapRemove method inherited
+*     from the KeyMap class).
+
+*  Description:
+*     This function empties a cell held in the contiguous array of a
+*     numerical column. Other keys are passed on to the parent KeyMap
+*     method.
+
+*  Parameters:
+*     (see astMapRemove)
+*/
+
+/* Local Variables: */
+   AstTableColumn *col;  /* Packed column holding the cell */
+   int irow;             /* Row index within key string */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* If the key refers to a packed column, clear the flag indicating that
+   the cell has a value. Otherwise, use the parent method. */
+   col = PackedKey( (AstTable *) this_keymap, key, &irow, status );
+   if( col ) {
+      if( irow <= col->nalloc ) col->set[ irow - 1 ] = 0;
+   } else {
+      (*parent_mapremove)( this_keymap, key, status );
+   }
+}
+
+static void MapSync( AstKeyMap *this_keymap, int *status ) {
+/*
+*  Name:
+*     MapSync
+
+*  Purpose:
+*     Ensure all Table cells are held as separate KeyMap entries.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     void MapSync( AstKeyMap *this, int *status )
+
+*  Class Membership:
+*     Table member function (over-rides the astMapSync protected method
+*     inherited from the KeyMap class).
+
+*  Description:
+*     This function is invoked by the KeyMap class before accessing the
+*     KeyMap hash table as a whole. It converts all columns that are
+*     held in contiguous arrays into separate KeyMap entries. This is
+*     permanent - the columns are not subsequently converted back into
+*     contiguous arrays. It does nothing if the "nosync" flag is set in
+*     the Table structure.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstTable *this;       /* Pointer to Table structure */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get a pointer to the Table structure. */
+   this = (AstTable *) this_keymap;
+
+/* Unpack each column in turn, in the order in which they were created. */
+   if( !this->nosync ) {
+      while( this->npacked > 0 && astOK ) {
+         UnpackColumn( this, this->packed, status );
+      }
+   }
+}
+
+static int MapType( AstKeyMap *this_keymap, const char *key, int *status ) {
+/*
+*  Name:
+*     MapType
+
+*  Purpose:
+*     Get the data type of the value in a Table cell.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     int MapType( AstKeyMap *this, const char *key, int *status )
+
+*  Class Membership:
+*     Table member function (over-rides the astMapType method inherited
+*     from the KeyMap class).
+
+*  Description:
+*     This function returns the data type of a cell held in the
+*     contiguous array of a numerical column. Other keys are passed on to
+*     the parent KeyMap method.
+
+*  Parameters:
+*     (see astMapType)
+*/
+
+/* Local Variables: */
+   AstTableColumn *col;  /* Packed column holding the cell */
+   int irow;             /* Row index within key string */
+   int result;           /* Returned value */
+
+/* Initialise */
+   result = AST__BADTYPE;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Use the parent method unless the key refers to a packed column. */
+   col = PackedKey( (AstTable *) this_keymap, key, &irow, status );
+   if( col ) {
+      if( irow <= col->nalloc && col->set[ irow - 1 ] ) result = col->type;
+   } else {
+      result = (*parent_maptype)( this_keymap, key, status );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static char *PackedCell( AstTable *this, const char *colname, int irow,
+                         AstTableColumn **col, int *status ) {
+/*
+*  Name:
+*     PackedCell
+
+*  Purpose:
+*     Get a pointer to the value of a packed Table cell.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     char *PackedCell( AstTable *this, const char *colname, int irow,
+*                       AstTableColumn **col, int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function returns a pointer to the first value stored in a
+*     cell of a column that is held in contiguous arrays.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     colname
+*        The column name.
+*     irow
+*        The one-based row index.
+*     col
+*        Address at which to return a pointer to the structure describing
+*        the packed column. NULL is returned if the column is not held in
+*        contiguous arrays.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the first value in the cell, or NULL if the column is
+*     not held in contiguous arrays or the cell has no value.
+*/
+
+/* Local Variables: */
+   char *result;         /* Returned pointer */
+
+/* Initialise */
+   result = NULL;
+   *col = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Find the packed column, and get a pointer to the cell if it has a
+   value. */
+   *col = FindPacked( this, colname, status );
+   if( *col && irow >= 1 && irow <= (*col)->nalloc &&
+       (*col)->set[ irow - 1 ] ) {
+      result = (*col)->data +
+               ( (size_t) ( irow - 1 ) )*(*col)->nel*(*col)->size;
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static int PackedGrow( AstTableColumn *col, int nrow, int *status ) {
+/*
+*  Name:
+*     PackedGrow
+
+*  Purpose:
+*     Ensure the arrays for a packed column have room for a given number
+*     of rows.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     int PackedGrow( AstTableColumn *col, int nrow, int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function extends the arrays used to store the values of a
+*     packed column if they do not have room for at least "nrow" rows.
+*     Any new rows are flagged as empty.
+
+*  Parameters:
+*     col
+*        Pointer to the structure describing the packed column.
+*     nrow
+*        The required number of rows.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the arrays have room for the required number of rows.
+*/
+
+/* Local Variables: */
+   char *data;           /* Pointer to extended data array */
+   unsigned char *set;   /* Pointer to extended flags array */
+
+/* Check the global error status. */
+   if ( !astOK ) return 0;
+
+/* Extend the arrays if required, flagging the new rows as empty. */
+   if( nrow > col->nalloc ) {
+      data = astRealloc( col->data, ( (size_t) nrow )*col->nel*col->size );
+      set = astRealloc( col->set, (size_t) nrow );
+      if( data ) col->data = data;
+      if( set ) col->set = set;
+      if( astOK ) {
+         memset( col->set + col->nalloc, 0, nrow - col->nalloc );
+         col->nalloc = nrow;
+      }
+   }
+
+/* Return a flag indicating success. */
+   return astOK;
+}
+
+static AstTableColumn *PackedKey( AstTable *this, const char *key, int *irow,
+                                  int *status ) {
+/*
+*  Name:
+*     PackedKey
+
+*  Purpose:
+*     Find the packed column referred to by a Table cell key.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     AstTableColumn *PackedKey( AstTable *this, const char *key, int *irow,
+*                                int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function checks if the supplied key has the form of a Table
+*     cell key ("COLNAME(irow)") for a column that is held in contiguous
+*     arrays. No error is reported if this is not the case.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     key
+*        The key string.
+*     irow
+*        Address of an int in which to return the one-based row index.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the structure describing the packed column, or NULL if
+*     the key does not refer to a cell of a packed column.
+*/
+
+/* Local Variables: */
+   AstTableColumn *result; /* Returned pointer */
+   char colname[ AST__MXCOLNAMLEN + 1 ]; /* Column name read from key */
+   int collen;           /* Length of column name */
+   int nctot;            /* Number of characters read */
+
+/* Initialise */
+   result = NULL;
+
+/* Check the global error status, and do nothing more if no columns are
+   held in contiguous arrays. */
+   if ( !astOK || this->npacked == 0 ) return result;
+
+/* Extract the column name and row number from the key, using the same
+   format as ParseKey, and search for a packed column with that name. */
+   nctot = 0;
+   if( 1 == astSscanf( key, "%*[^(]%n(%d) %n", &collen, irow, &nctot )
+       && ( (size_t) nctot >= strlen( key ) ) && collen <= AST__MXCOLNAMLEN &&
+       *irow >= 1 ) {
+      astChrCase( key, colname, 1, collen + 1 );
+      colname[ collen ] = 0;
+      result = FindPacked( this, colname, status );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static int PackedPutOK( AstTable *this, AstTableColumn *col, int irow,
+                        const char *comment, int *status ) {
+/*
+*  Name:
+*     PackedPutOK
+
+*  Purpose:
+*     Check if a new cell value can be stored in a packed column.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     int PackedPutOK( AstTable *this, AstTableColumn *col, int irow,
+*                      const char *comment, int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function checks if a new value for a cell can be stored in
+*     the contiguous arrays used to hold a packed column. This is not
+*     possible if a comment is to be stored with the value. Also, if the
+*     Table is locked against the addition of new entries (see attribute
+*     MapLocked), only cells that already have a value can be changed.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     col
+*        Pointer to the structure describing the packed column.
+*     irow
+*        The one-based row index.
+*     comment
+*        The comment to store with the new value. May be NULL.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Non-zero if the value can be stored in the packed column. Zero if
+*     the column needs to be converted into separate KeyMap entries first.
+*/
+
+/* Local Variables: */
+   int result;           /* Returned flag */
+
+/* Initialise */
+   result = 0;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Check the conditions. */
+   if( !comment || !comment[ 0 ] ) {
+      result = !astGetMapLocked( this ) ||
+               ( irow <= col->nalloc && col->set[ irow - 1 ] );
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static char *PackedStore( AstTableColumn *col, int irow, int *status ) {
+/*
+*  Name:
+*     PackedStore
+
+*  Purpose:
+*     Prepare a packed Table cell to receive a new value.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     char *PackedStore( AstTableColumn *col, int irow, int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function extends the arrays of a packed column if necessary to
+*     include the specified row, flags the cell as having a value, and
+*     returns a pointer to the cell. The size of the arrays is at least
+*     doubled when they are extended, so that adding rows one at a time
+*     does not require excessive re-allocation.
+
+*  Parameters:
+*     col
+*        Pointer to the structure describing the packed column.
+*     irow
+*        The one-based row index.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     A pointer to the first value in the cell, into which the new cell
+*     value should be copied by the caller.
+*/
+
+/* Local Variables: */
+   char *result;         /* Returned pointer */
+   int nalloc;           /* New number of rows to allocate */
+
+/* Initialise */
+   result = NULL;
+
+/* Check the global error status. */
+   if ( !astOK ) return result;
+
+/* Extend the arrays if required. */
+   nalloc = col->nalloc;
+   if( irow > nalloc ) {
+      nalloc *= 2;
+      if( nalloc < irow ) nalloc = irow;
+   }
+
+/* Flag the cell as having a value and return a pointer to it. */
+   if( PackedGrow( col, nalloc, status ) ) {
+      col->set[ irow - 1 ] = 1;
+      result = col->data + ( (size_t) ( irow - 1 ) )*col->nel*col->size;
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static const char *ParameterName( AstTable *this, int index, int *status ) {
+/*
+*++
+*  Name:
+c     astParameterName
+f     AST_PARAMETERNAME
+
+*  Purpose:
+*     Get the name of the global parameter at a given index within the Table.
+
+*  Type:
+*     Public virtual function.
+
+*  Synopsis:
+c     #include "table.h"
+c     const char *astParameterName( AstTable *this, int index )
+f     RESULT = AST_PARAMETERNAME( THIS, INDEX, STATUS )
+
+*  Class Membership:
+*     Table method.
+
+*  Description:
+*     This function returns a string holding the name of the global parameter with
+*     the given index within the Table.
+*
+*     This function is intended primarily as a means of iterating round all
+*     the parameters in a Table. For this purpose, the number of parameters in
+*     the Table is given by the Nparameter attribute of the Table. This function
+*     could then be called in a loop, with the index value going from
+c     zero to one less than Nparameter.
+f     one to Nparameter.
+*
+*     Note, the index associated with a parameter decreases monotonically with
+*     the age of the parameter: the oldest Parameter in the Table will have index
+*     one, and the Parameter added most recently to the Table will have the
+*     largest index.
+
+*  Parameters:
+c     this
+f     THIS = INTEGER (Given)
+*        Pointer to the Table.
+c     index
+f     INDEX = INTEGER (Given)
+*        The index into the list of parameters. The first parameter has index
+*        one, and the last has index "Nparameter".
+f     STATUS = INTEGER (Given and Returned)
+f        The global status.
+
+*  Returned Value:
+c     astParameterName()
+c        A pointer to a null-terminated string containing the
+f     AST_PARAMETERNAME = CHARACTER * ( AST__SZCHR )
+f        The
+*        upper case parameter name.
+
+*  Notes:
+c     - The returned pointer is guaranteed to remain valid and the
+c     string to which it points will not be over-written for a total
+c     of 50 successive invocations of this function. After this, the
+c     memory containing the string may be re-used, so a copy of the
+c     string should be made if it is needed for longer than this.
+c     - A NULL pointer will be returned if this function is invoked
+c     with the AST error status set, or if it should fail for any
+c     reason.
+f     - A blank string will be returned if this function is invoked
+f     with STATUS set to an error value, or if it should fail for any
+f     reason.
+*--
+*/
+
+/* Local Variables: */
+   AstKeyMap *pars;        /* KeyMap holding parameter definitions */
+   const char *result;
+
+/* Check the global error status. */
+   if ( !astOK ) return NULL;
+
+/* Get apointer to the KeyMap holding all parameter definitions. */
+   pars = astParameterProps( this );
+
+/* Issue a more useful error message than that issued by astMapKey if the
+   index is invalid. */
+   if( index < 1 || index > astMapSize( pars ) ) {
+      astError( AST__MPIND, "astParameterName(%s): Cannot find parameter "
+                "%d (zero-based) of the %s - invalid index.", status,
+                astGetClass( this ), index, astGetClass( this ) );
+   }
+
+/* Get the parameter name. */
+   result = astMapKey( pars, index - 1 );
+
 /* Free resources. */
    pars = astAnnul( pars );
 
@@ -3606,7 +4823,7 @@ static int ParseKey( AstTable *this, const char *key, int report,
    column name and row number. */
    nctot = 0;
    if( 1 == astSscanf( key, "%*[^(]%n(%d) %n", &collen, irow, &nctot )
-       && ( nctot >= strlen( key ) ) ) {
+       && ( (size_t) nctot >= strlen( key ) ) ) {
 
 /* Check the column name is not too long. */
       if( collen > AST__MXCOLNAMLEN ) {
@@ -3697,6 +4914,7 @@ f        The global status.
 */
 
 /* Local Variables: */
+   AstTableColumn *pcol;         /* Structure describing a packed column */
    char newkey[ AST__MXCOLKEYLEN + 1 ]; /* New cell key string */
    char oldkey[ AST__MXCOLKEYLEN + 1 ]; /* Old cell key string */
    const char *col;              /* Column name */
@@ -3709,6 +4927,7 @@ f        The global status.
    int ncol;                     /* Number of columns in table */
    int nrow;                     /* Number of rows in table */
    int reset;                    /* Start a new pass through the KeyMap? */
+   size_t rowsize;               /* Number of bytes per row */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -3721,6 +4940,19 @@ f        The global status.
    w1 = astCalloc( nrow, sizeof( int ) );
    if( astOK ) {
 
+/* Count the cells with values in each column held in contiguous arrays. */
+      for( icol = 0; icol < this->npacked; icol++ ) {
+         pcol = this->packed + icol;
+         for( iold = 0; iold < nrow && iold < pcol->nalloc; iold++ ) {
+            if( pcol->set[ iold ] ) w1[ iold ]++;
+         }
+      }
+
+/* Prevent the packed columns being converted into separate KeyMap
+   entries by the KeyMap methods used below. The packed columns are
+   handled separately. */
+      this->nosync++;
+
 /* Iterate round all keys in the KeyMap. */
       reset = 1;
       while( ( key = astMapIterate( this, reset ) ) && astOK ) {
@@ -3749,21 +4981,48 @@ f        The global status.
 /* Get the column name */
          col = astColumnName( this, icol );
 
-/* Loop round all the old row numbers. Skip empty rows.*/
-         inew = 0;
-         for( iold = 0; iold < nrow; iold++ ) {
-            if( w1[ iold ] > 0 ) {
+/* If the column is held in contiguous arrays, move the values for each
+   non-empty row down to the new row number, and then flag all subsequent
+   rows as empty. */
+         pcol = FindPacked( this, col, status );
+         if( pcol ) {
+            rowsize = pcol->nel*pcol->size;
+            inew = 0;
+            for( iold = 0; iold < nrow; iold++ ) {
+               if( w1[ iold ] > 0 ) {
+                  if( iold != inew ) {
+                     if( iold < pcol->nalloc ) {
+                        pcol->set[ inew ] = pcol->set[ iold ];
+                        memcpy( pcol->data + inew*rowsize,
+                                pcol->data + iold*rowsize, rowsize );
+                     } else if( inew < pcol->nalloc ) {
+                        pcol->set[ inew ] = 0;
+                     }
+                  }
+                  inew++;
+               }
+            }
+            if( inew < pcol->nalloc ) {
+               memset( pcol->set + inew, 0, pcol->nalloc - inew );
+            }
+
+/* Otherwise, loop round all the old row numbers. Skip empty rows.*/
+         } else {
+            inew = 0;
+            for( iold = 0; iold < nrow; iold++ ) {
+               if( w1[ iold ] > 0 ) {
 
 /* Increment the row number to use in place of the old row number. If the
    old and new row numbers are the same, we do not need to rename the cell. */
-               if( iold != inew++ ) {
+                  if( iold != inew++ ) {
 
 /* For the old and new cell names */
-                  sprintf( oldkey, "%s(%d)", col, iold + 1 );
-                  sprintf( newkey, "%s(%d)", col, inew );
+                     sprintf( oldkey, "%s(%d)", col, iold + 1 );
+                     sprintf( newkey, "%s(%d)", col, inew );
 
 /* Rename the KeyMap entry. */
-                  astMapRename( this, oldkey, newkey );
+                     astMapRename( this, oldkey, newkey );
+                  }
                }
             }
          }
@@ -3772,6 +5031,10 @@ f        The global status.
          if( iold == inew ) break;
       }
 
+/* Allow the packed columns to be converted into separate KeyMap entries
+   again. */
+      this->nosync--;
+
 /* Store the new number of rows. */
       astSetNrow( this, inew );
    }
@@ -3781,6 +5044,169 @@ f        The global status.
 
 }
 
+static void PutColumnValues( AstTable *this, const char *column, int nrow,
+                             const void *data, const unsigned char *defined,
+                             int *status ) {
+/*
+*+
+*  Name:
+*     astPutColumnValues
+
+*  Purpose:
+*     Store new values for all the cells in a numerical column.
+
+*  Type:
+*     Protected virtual function.
+
+*  Synopsis:
+*     #include "table.h"
+*     void astPutColumnValues( AstTable *this, const char *column, int nrow,
+*                              const void *data,
+*                              const unsigned char *defined )
+
+*  Class Membership:
+*     Table method.
+
+*  Description:
+*     This function replaces the contents of a named column with values
+*     copied from a single supplied array. Only columns holding int,
+*     short int, byte, double or float values are supported. If the
+*     column values are held internally in contiguous arrays (see
+*     astAddColumn), the supplied values are copied directly into the
+*     arrays. Otherwise, each cell is stored separately.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     column
+*        The name of the column.
+*     nrow
+*        The number of rows to store, starting at row 1. Any cells in
+*        the column at rows beyond "nrow" are emptied. The number of rows
+*        in the Table is increased if necessary.
+*     data
+*        Pointer to an array holding the new column values. It should
+*        have "nrow" times the column length (see astGetColumnLength)
+*        values of the column data type (see astGetColumnType). The
+*        values for each row should be stored consecutively.
+*     defined
+*        Pointer to an array with "nrow" elements holding a flag for each
+*        row indicating if the cell should be given a value (non-zero) or
+*        left empty (zero). If NULL, all rows are given values.
+
+*  Notes:
+*     - An error is reported if the column does not hold numerical values.
+*-
+*/
+
+/* Local Variables: */
+   AstTableColumn *col;          /* Packed column structure */
+   char key[ AST__MXCOLKEYLEN + 1 ]; /* Cell key string */
+   const char *pin;              /* Pointer to next input row */
+   int irow;                     /* Zero-based row index */
+   int namlen;                   /* Used length of column name */
+   int nel;                      /* Number of values per cell */
+   int nold;                     /* Original number of rows in Table */
+   int type;                     /* Column data type */
+   int vector;                   /* Does the column hold vector values? */
+   size_t rowsize;               /* Number of bytes per row */
+   size_t size;                  /* Number of bytes per value */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Get the data type and shape of the column values (this reports an
+   error if the column does not exist). */
+   type = astGetColumnType( this, column );
+   nel = astGetColumnLength( this, column );
+   vector = ( astGetColumnNdim( this, column ) > 0 );
+   size = TypeSize( type );
+   if( astOK && size == 0 ) {
+      astError( AST__BADTYP, "astPutColumnValues(%s): Cannot store the "
+                "values of column %s from an array: the column holds %s "
+                "values.", status, astGetClass( this ), column,
+                TypeString( type ) );
+   }
+   if( nrow < 0 ) nrow = 0;
+   rowsize = nel*size;
+
+/* If the column values are held in contiguous arrays, copy the supplied
+   values directly into the arrays. This is not done if the Table is
+   locked against the addition of new entries, since the cell-by-cell
+   route below reports an error if any empty cells would be filled. */
+   col = FindPacked( this, column, status );
+   if( col && !astGetMapLocked( this ) ) {
+      if( PackedGrow( col, nrow, status ) ) {
+         if( nrow > 0 ) memcpy( col->data, data, nrow*rowsize );
+         for( irow = 0; irow < nrow; irow++ ) {
+            col->set[ irow ] = ( !defined || defined[ irow ] ) ? 1 : 0;
+         }
+         if( col->nalloc > nrow ) {
+            memset( col->set + nrow, 0, col->nalloc - nrow );
+         }
+      }
+
+/* Otherwise, store each cell separately, and then remove any cells at
+   higher rows. */
+   } else if( astOK ) {
+      namlen = astChrLen( column );
+      nold = astGetNrow( this );
+      pin = data;
+      for( irow = 0; irow < nrow && astOK; irow++ ) {
+         sprintf( key, "%.*s(%d)", namlen, column, irow + 1 );
+
+         if( defined && !defined[ irow ] ) {
+            astMapRemove( this, key );
+
+         } else if( type == AST__INTTYPE ) {
+            if( vector ) {
+               astMapPut1I( this, key, nel, (const int *) pin, NULL );
+            } else {
+               astMapPut0I( this, key, *( (const int *) pin ), NULL );
+            }
+
+         } else if( type == AST__SINTTYPE ) {
+            if( vector ) {
+               astMapPut1S( this, key, nel, (const short int *) pin, NULL );
+            } else {
+               astMapPut0S( this, key, *( (const short int *) pin ), NULL );
+            }
+
+         } else if( type == AST__BYTETYPE ) {
+            if( vector ) {
+               astMapPut1B( this, key, nel, (const unsigned char *) pin, NULL );
+            } else {
+               astMapPut0B( this, key, *( (const unsigned char *) pin ), NULL );
+            }
+
+         } else if( type == AST__DOUBLETYPE ) {
+            if( vector ) {
+               astMapPut1D( this, key, nel, (const double *) pin, NULL );
+            } else {
+               astMapPut0D( this, key, *( (const double *) pin ), NULL );
+            }
+
+         } else {
+            if( vector ) {
+               astMapPut1F( this, key, nel, (const float *) pin, NULL );
+            } else {
+               astMapPut0F( this, key, *( (const float *) pin ), NULL );
+            }
+         }
+
+         pin += rowsize;
+      }
+
+      for( irow = nrow + 1; irow <= nold && astOK; irow++ ) {
+         sprintf( key, "%.*s(%d)", namlen, column, irow );
+         astMapRemove( this, key );
+      }
+   }
+
+/* Update the number of rows in the Table if required. */
+   if( astOK && nrow > astGetNrow( this ) ) astSetNrow( this, nrow );
+}
+
 static void RemoveColumn( AstTable *this, const char *name, int *status ) {
 /*
 *++
@@ -3826,7 +5252,9 @@ f        The global status.
 
 /* Local Variables: */
    AstKeyMap *cols;      /* KeyMap holding column definitions */
+   AstTableColumn *col;  /* Structure describing a packed column */
    char key[ AST__MXCOLKEYLEN + 1 ]; /* Cell key string */
+   int icol;             /* Index of packed column */
    int irow;             /* Row index */
    int namlen;           /* Used length of "name" */
    int nrow;             /* Number of rows in table */
@@ -3851,10 +5279,25 @@ f        The global status.
 /* Remove the column description from the columns keymap. */
       astMapRemove( cols, name );
 
-/* Remove any column cells with defined values from the parent KeyMap. */
-      for( irow = 1; irow <= nrow; irow++ ) {
-         sprintf( key, "%.*s(%d)", namlen, name, irow );
-         (*parent_mapremove)( (AstKeyMap *) this, key, status );
+/* If the column is held in contiguous arrays, free the arrays and
+   remove the column from the list of packed columns. */
+      col = FindPacked( this, name, status );
+      if( col ) {
+         col->data = astFree( col->data );
+         col->set = astFree( col->set );
+         icol = col - this->packed;
+         this->npacked--;
+         if( icol < this->npacked ) {
+            memmove( col, col + 1, ( this->npacked - icol )*sizeof( *col ) );
+         }
+
+/* Otherwise, remove any column cells with defined values from the parent
+   KeyMap. */
+      } else {
+         for( irow = 1; irow <= nrow; irow++ ) {
+            sprintf( key, "%.*s(%d)", namlen, name, irow );
+            (*parent_mapremove)( (AstKeyMap *) this, key, status );
+         }
       }
    }
    cols = astAnnul( cols );
@@ -3972,6 +5415,7 @@ f        The global status.
 
 /* Local Variables: */
    AstKeyMap *cols;              /* KeyMap holding column definitions */
+   AstTableColumn *pcol;         /* Structure describing a packed column */
    char key[ AST__MXCOLKEYLEN + 1 ]; /* Cell key string */
    const char *col;              /* Column name */
    int icol;                     /* Column index */
@@ -3993,9 +5437,15 @@ f        The global status.
       for( icol = 0; icol < ncol; icol++ ) {
          col = astMapKey( cols, icol );
 
-/* Remove the cell of the current column at the requested row. */
-         sprintf( key, "%s(%d)", col, index );
-         (*parent_mapremove)( (AstKeyMap *) this, key, status );
+/* Remove the cell of the current column at the requested row. For
+   columns held in contiguous arrays, just flag the cell as empty. */
+         pcol = FindPacked( this, col, status );
+         if( pcol ) {
+            if( index <= pcol->nalloc ) pcol->set[ index - 1 ] = 0;
+         } else {
+            sprintf( key, "%s(%d)", col, index );
+            (*parent_mapremove)( (AstKeyMap *) this, key, status );
+         }
       }
       cols = astAnnul( cols );
 
@@ -4137,6 +5587,97 @@ static void SetKeyCase( AstKeyMap *this, int keycase, int *status ) {
 
 }
 
+static void StoreCell( AstKeyMap *km, AstTableColumn *col, const char *key,
+                       const char *cell, int *status ) {
+/*
+*  Name:
+*     StoreCell
+
+*  Purpose:
+*     Store a packed cell value as a KeyMap entry.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     void StoreCell( AstKeyMap *km, AstTableColumn *col, const char *key,
+*                     const char *cell, int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function stores a copy of a cell value taken from the
+*     contiguous array of a packed column as an entry in a KeyMap, using
+*     the KeyMap class methods (not the Table methods). Cells in columns
+*     with a shape are stored as vector entries, and other cells are
+*     stored as scalar entries.
+
+*  Parameters:
+*     km
+*        Pointer to the KeyMap. This may be a Table, in which case the
+*        entry is added to the parent KeyMap.
+*     col
+*        Pointer to the structure describing the packed column.
+*     key
+*        The key for the new entry.
+*     cell
+*        Pointer to the first value in the cell.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Store the value using the KeyMap method appropriate to the data type. */
+   if( col->type == AST__INTTYPE ) {
+      if( col->vector ) {
+         (*parent_mapput1i)( km, key, col->nel, (const int *) cell, NULL,
+                             status );
+      } else {
+         (*parent_mapput0i)( km, key, *( (const int *) cell ), NULL, status );
+      }
+
+   } else if( col->type == AST__SINTTYPE ) {
+      if( col->vector ) {
+         (*parent_mapput1s)( km, key, col->nel, (const short int *) cell,
+                             NULL, status );
+      } else {
+         (*parent_mapput0s)( km, key, *( (const short int *) cell ), NULL,
+                             status );
+      }
+
+   } else if( col->type == AST__BYTETYPE ) {
+      if( col->vector ) {
+         (*parent_mapput1b)( km, key, col->nel, (const unsigned char *) cell,
+                             NULL, status );
+      } else {
+         (*parent_mapput0b)( km, key, *( (const unsigned char *) cell ), NULL,
+                             status );
+      }
+
+   } else if( col->type == AST__DOUBLETYPE ) {
+      if( col->vector ) {
+         (*parent_mapput1d)( km, key, col->nel, (const double *) cell, NULL,
+                             status );
+      } else {
+         (*parent_mapput0d)( km, key, *( (const double *) cell ), NULL,
+                             status );
+      }
+
+   } else if( col->type == AST__FLOATTYPE ) {
+      if( col->vector ) {
+         (*parent_mapput1f)( km, key, col->nel, (const float *) cell, NULL,
+                             status );
+      } else {
+         (*parent_mapput0f)( km, key, *( (const float *) cell ), NULL,
+                             status );
+      }
+   }
+}
+
 static int TestAttrib( AstObject *this_object, const char *attrib, int *status ) {
 /*
 *  Name:
@@ -4293,6 +5834,142 @@ static const char *TypeString( int type ) {
 }
 
 
+static size_t TypeSize( int type ) {
+/*
+*  Name:
+*     TypeSize
+
+*  Purpose:
+*     Return the size of a numerical data type.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*      size_t TypeSize( int type );
+
+*  Description:
+*     This function returns the number of bytes used to store a single
+*     value of a numerical data type. Columns holding such values are
+*     stored in contiguous arrays (see AddColumn).
+
+*  Parameters:
+*     type
+*        The integer data type code.
+
+*  Returned Value:
+*     The number of bytes in a single value, or zero if the data type is
+*     not numerical.
+
+*/
+
+/* Local Variables: */
+   size_t result;
+
+/* Compare the supplied type code against each supported value. */
+   if( type == AST__INTTYPE ) {
+      result = sizeof( int );
+
+   } else if( type == AST__SINTTYPE ) {
+      result = sizeof( short int );
+
+   } else if( type == AST__BYTETYPE ) {
+      result = sizeof( unsigned char );
+
+   } else if( type == AST__DOUBLETYPE ) {
+      result = sizeof( double );
+
+   } else if( type == AST__FLOATTYPE ) {
+      result = sizeof( float );
+
+   } else {
+      result = 0;
+   }
+
+/* Return the result. */
+   return result;
+}
+
+static void UnpackColumn( AstTable *this, AstTableColumn *col, int *status ) {
+/*
+*  Name:
+*     UnpackColumn
+
+*  Purpose:
+*     Convert a packed column into separate KeyMap entries.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "table.h"
+*     void UnpackColumn( AstTable *this, AstTableColumn *col, int *status )
+
+*  Class Membership:
+*     Table member function
+
+*  Description:
+*     This function stores each cell value held in the contiguous arrays
+*     of a packed column as a separate entry in the parent KeyMap, and
+*     then frees the arrays. It is used when the column is to be accessed
+*     in a way that cannot be supported by the contiguous arrays (e.g.
+*     storing undefined values or comments, or accessing the KeyMap hash
+*     table as a whole). The column remains unpacked thereafter.
+
+*  Parameters:
+*     this
+*        Pointer to the Table.
+*     col
+*        Pointer to the structure describing the packed column. This
+*        pointer should not be used after this function returns.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   AstKeyMap *this_keymap;       /* Pointer to parent KeyMap structure */
+   char key[ AST__MXCOLKEYLEN + 1 ]; /* Cell key string */
+   int icol;                     /* Index of packed column */
+   int irow;                     /* Zero-based row index */
+   int maplocked;                /* Original MapLocked value */
+   size_t rowsize;               /* Number of bytes per row */
+
+/* Check the global error status. */
+   if ( !astOK ) return;
+
+/* Moving existing cells into the parent KeyMap does not add any new
+   values to the Table, so temporarily allow new KeyMap entries even if
+   the MapLocked attribute is set. */
+   this_keymap = (AstKeyMap *) this;
+   maplocked = this_keymap->maplocked;
+   this_keymap->maplocked = 0;
+
+/* Store each cell that has a value in the parent KeyMap. */
+   rowsize = col->nel*col->size;
+   for( irow = 0; irow < col->nalloc && astOK; irow++ ) {
+      if( col->set[ irow ] ) {
+         sprintf( key, "%s(%d)", col->name, irow + 1 );
+         StoreCell( this_keymap, col, key, col->data + irow*rowsize, status );
+      }
+   }
+
+/* Re-instate the original MapLocked value. */
+   this_keymap->maplocked = maplocked;
+
+/* Free the arrays and remove the column structure from the list of
+   packed columns. */
+   if( astOK ) {
+      col->data = astFree( col->data );
+      col->set = astFree( col->set );
+      icol = col - this->packed;
+      this->npacked--;
+      if( icol < this->npacked ) {
+         memmove( col, col + 1, ( this->npacked - icol )*sizeof( *col ) );
+      }
+   }
+}
+
+
 /* Functions which access class attributes. */
 /* ---------------------------------------- */
 /* Implement member functions to access the attributes associated with
@@ -4563,6 +6240,8 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
 /* Local Variables: */
    AstTable *in;                /* Pointer to input Table */
    AstTable *out;               /* Pointer to output Table */
+   AstTableColumn *col;         /* Pointer to output packed column */
+   int icol;                    /* Index of packed column */
 
 /* Check the global error status. */
    if ( !astOK ) return;
@@ -4571,10 +6250,39 @@ static void Copy( const AstObject *objin, AstObject *objout, int *status ) {
    in = (AstTable *) objin;
    out = (AstTable *) objout;
 
+/* For safety, start by clearing any references to the input packed
+   columns from the output Table. */
+   out->packed = NULL;
+   out->npacked = 0;
+   out->nosync = 0;
+
 /* Make copies of the component KeyMaps and store pointers to them in the
    output Table structure. */
    out->columns = in->columns ? astCopy( in->columns ) : NULL;
    out->parameters = in->parameters ? astCopy( in->parameters ) : NULL;
+
+/* Make deep copies of the arrays holding packed columns. */
+   if( in->npacked > 0 ) {
+      out->packed = astStore( NULL, in->packed,
+                              in->npacked*sizeof( AstTableColumn ) );
+      if( astOK ) {
+         out->npacked = in->npacked;
+         for( icol = 0; icol < out->npacked; icol++ ) {
+            col = out->packed + icol;
+            col->data = NULL;
+            col->set = NULL;
+         }
+         for( icol = 0; icol < out->npacked && astOK; icol++ ) {
+            col = out->packed + icol;
+            if( col->nalloc > 0 ) {
+               col->data = astStore( NULL, in->packed[ icol ].data,
+                                     ( (size_t) col->nalloc )*col->nel*col->size );
+               col->set = astStore( NULL, in->packed[ icol ].set,
+                                    (size_t) col->nalloc );
+            }
+         }
+      }
+   }
 }
 
 
@@ -4613,6 +6321,7 @@ static void Delete( AstObject *obj, int *status ) {
 
 /* Local Variables: */
    AstTable *this;              /* Pointer to Table */
+   int icol;                    /* Index of packed column */
 
 /* Obtain a pointer to the Table structure. */
    this = (AstTable *) obj;
@@ -4621,6 +6330,14 @@ static void Delete( AstObject *obj, int *status ) {
    if( this->columns ) this->columns = astAnnul( this->columns );
    if( this->parameters ) this->parameters = astAnnul( this->parameters );
 
+/* Free the arrays holding packed columns. */
+   for( icol = 0; icol < this->npacked; icol++ ) {
+      this->packed[ icol ].data = astFree( this->packed[ icol ].data );
+      this->packed[ icol ].set = astFree( this->packed[ icol ].set );
+   }
+   this->packed = astFree( this->packed );
+   this->npacked = 0;
+
 }
 
 
@@ -4752,9 +6469,17 @@ c     astAddParameter
 f     AST_ADDPARAMETER
 *     method before being accessed.
 *
-*     Note - since accessing entries within a KeyMap is a relatively slow
-*     process, it is not recommended to use the Table class to store
-*     very large tables.
+*     Note - the cells of columns holding numerical values are stored
+*     internally in contiguous arrays, making it practical to store large
+*     tables of numerical values. However, if the Table is used in a way
+*     that requires all cells to be treated as individual KeyMap entries
+*     (for instance, if the keys are listed using
+c     astMapKey,
+f     AST_MAPKEY,
+*     a comment is stored with a cell, or the Table is written to a
+*     Channel), the affected columns are converted permanently to separate
+*     KeyMap entries, which are slower to access. Columns holding strings,
+*     Objects or pointers are always stored as separate KeyMap entries.
 
 *  Parameters:
 c     options
@@ -5000,6 +6725,9 @@ AstTable *astInitTable_( void *mem, size_t size, int init,
       new->nrow = 0;
       new->columns = astKeyMap( "KeyCase=0,Sortby=AgeDown", status );
       new->parameters = astKeyMap( "KeyCase=0,Sortby=AgeDown", status );
+      new->packed = NULL;
+      new->npacked = 0;
+      new->nosync = 0;
 
 /* Tables require the KeyCase attribute to be zero. */
       (*parent_setkeycase)( (AstKeyMap *) new, 0, status );
@@ -5135,6 +6863,11 @@ AstTable *astLoadTable_( void *mem, size_t size, AstTableVtab *vtab,
 /* The number of rows. */
       new->nrow = astReadInt( channel, "nrow", 0 );
 
+/* All cells read from a Channel are stored as separate KeyMap entries. */
+      new->packed = NULL;
+      new->npacked = 0;
+      new->nosync = 0;
+
 /* KeyMap holding columns definitions. */
       new->columns = astReadObject( channel, "columns", NULL );
 
@@ -5222,6 +6955,19 @@ int astGetColumnNdim_( AstTable *this, const char *column, int *status ){
    if ( !astOK ) return 0;
    return (**astMEMBER(this,Table,GetColumnNdim))(this,column,status);
 }
+int astGetColumnValues_( AstTable *this, const char *column, int nrow,
+                         void *data, unsigned char *defined, int *status ){
+   if ( !astOK ) return 0;
+   return (**astMEMBER(this,Table,GetColumnValues))(this,column,nrow,data,
+                                                    defined,status);
+}
+void astPutColumnValues_( AstTable *this, const char *column, int nrow,
+                          const void *data, const unsigned char *defined,
+                          int *status ){
+   if ( !astOK ) return;
+   (**astMEMBER(this,Table,PutColumnValues))(this,column,nrow,data,defined,
+                                             status);
+}
 void astColumnShape_( AstTable *this, const char *column, int mxdim,
                       int *ndim, int *dims, int *status ){
    if ( !astOK ) return;
@@ -48,6 +48,9 @@
 *  History:
 *     22-NOV-2010 (DSB):
 *        Original version.
+*     16-OCT-2026 (DSB):
+*        Store numerical columns in contiguous arrays. Added protected
+*        methods astGetColumnValues and astPutColumnValues.
 *-
 */
 
@@ -101,6 +104,9 @@ typedef struct AstTable {
    int nrow;                     /* Mo. of rows in table */
    AstKeyMap *columns;           /* KeyMap holding column definitions */
    AstKeyMap *parameters;        /* KeyMap holding parameter definitions */
+   struct AstTableColumn *packed;/* Contiguous storage for numerical columns */
+   int npacked;                  /* No. of columns in "packed" */
+   int nosync;                   /* Leave packed columns alone in astMapSync? */
 } AstTable;
 
 /* Virtual function table. */
@@ -126,6 +132,7 @@ typedef struct AstTableVtab {
    int (* GetColumnLength)( AstTable *, const char *, int * );
    int (* GetColumnNdim)( AstTable *, const char *, int * );
    int (* GetColumnType)( AstTable *, const char *, int * );
+   int (* GetColumnValues)( AstTable *, const char *, int, void *, unsigned char *, int * );
    int (* GetNcolumn)( AstTable *, int * );
    int (* GetNparameter)( AstTable *, int * );
    int (* GetNrow)( AstTable *, int * );
@@ -139,6 +146,7 @@ typedef struct AstTableVtab {
    void (* RemoveParameter)( AstTable *, const char *, int * );
    void (* RemoveRow)( AstTable *, int, int * );
    void (* SetNrow)( AstTable *, int, int * );
+   void (* PutColumnValues)( AstTable *, const char *, int, const void *, const unsigned char *, int * );
 } AstTableVtab;
 
 #if defined(THREAD_SAFE)
@@ -211,10 +219,12 @@ int astGetColumnLenC_( AstTable *, const char *, int * );
 int astGetColumnLength_( AstTable *, const char *, int * );
 int astGetColumnNdim_( AstTable *, const char *, int * );
 int astGetColumnType_( AstTable *, const char *, int * );
+int astGetColumnValues_( AstTable *, const char *, int, void *, unsigned char *, int * );
 int astGetNcolumn_( AstTable *, int * );
 int astGetNparameter_( AstTable *, int * );
 int astGetNrow_( AstTable *, int * );
 void astSetNrow_( AstTable *, int, int * );
+void astPutColumnValues_( AstTable *, const char *, int, const void *, const unsigned char *, int * );
 #endif
 
 /* Function interfaces. */
@@ -299,6 +309,10 @@ astINVOKE(V,astGetColumnNdim_(astCheckTable(this),column,STATUS_PTR))
 astINVOKE(V,astGetColumnType_(astCheckTable(this),column,STATUS_PTR))
 #define astGetColumnUnit(this,column) \
 astINVOKE(V,astGetColumnUnit_(astCheckTable(this),column,STATUS_PTR))
+#define astGetColumnValues(this,column,nrow,data,defined) \
+astINVOKE(V,astGetColumnValues_(astCheckTable(this),column,nrow,data,defined,STATUS_PTR))
+#define astPutColumnValues(this,column,nrow,data,defined) \
+astINVOKE(V,astPutColumnValues_(astCheckTable(this),column,nrow,data,defined,STATUS_PTR))
 
 #endif
 #endif
@@ -0,0 +1,576 @@
+/*
+*  Name:
+*     threads.c
+
+*  Purpose:
+*     Implement a simple pool of worker threads.
+
+*  Description:
+*     This file implements the Threads module which is used for
+*     performing independent tasks in parallel within the AST library.
+*     For a description of the module and its interface, see the .h file
+*     of the same name.
+*
+*     The pool threads are created when first needed and then persist
+*     (waiting on a condition variable) for the life of the process. Only
+*     one set of tasks is executed by the pool at any one time. If the
+*     pool is already in use when astRunTasks is called (for instance,
+*     by another application thread, or by a task which itself calls
+*     astRunTasks), then the new tasks are performed serially by the
+*     calling thread.
+
+*  Copyright:
+*     Copyright (C) 2026 Science & Technology Facilities Council.
+
+*  Licence:
+*     This program is free software: you can redistribute it and/or
+*     modify it under the terms of the GNU Lesser General Public
+*     License as published by the Free Software Foundation, either
+*     version 3 of the License, or (at your option) any later
+*     version.
+*
+*     This program is distributed in the hope that it will be useful,
+*     but WITHOUT ANY WARRANTY; without even the implied warranty of
+*     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*     GNU Lesser General Public License for more details.
+*
+*     You should have received a copy of the GNU Lesser General
+*     License along with this program.  If not, see
+*     <http://www.gnu.org/licenses/>.
+
+*  Authors:
+*     DSB: D.S. Berry (Starlink)
+
+*  History:
+*     16-OCT-2026 (DSB):
+*        Original version.
+*/
+
+/* Module Macros. */
+/* ============== */
+/* Define the astCLASS macro (even although this is not a class
+   implementation) to obtain access to the protected error handling
+   functions. */
+#define astCLASS
+
+/* The largest number of threads that may be used. */
+#define MAX_THREADS 256
+
+/* Include files. */
+/* ============== */
+
+/* Configuration results. */
+/* ---------------------- */
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/* Interface definitions. */
+/* ---------------------- */
+#include "error.h"               /* Error reporting facilities */
+#include "globals.h"             /* Thread-specific global data */
+#include "memory.h"              /* Memory management facilities */
+#include "threads.h"             /* Interface to this module */
+
+/* Error code definitions. */
+/* ----------------------- */
+#include "ast_err.h"             /* AST error codes */
+
+/* C header files. */
+/* --------------- */
+#include <stdlib.h>
+
+#if defined(THREAD_SAFE)
+#include <pthread.h>
+#endif
+
+/* Module type definitions. */
+/* ======================== */
+/* A structure describing a set of tasks that are being performed by
+   the thread pool. */
+typedef struct TaskBatch {
+   AstTaskFun *task;             /* Function that performs a single task */
+   void *data;                   /* Data pointer for the task function */
+   int ntask;                    /* Total number of tasks */
+   int next_task;                /* Index of the next task to perform */
+   int nworker;                  /* Number of workers (including caller) */
+   int next_worker;              /* Index of the next worker to join */
+   int nbusy;                    /* No. of pool threads still working */
+   int failed;                   /* Has any task failed? */
+   int wstatus;                  /* First error status from a pool thread */
+} TaskBatch;
+
+/* Module Variables. */
+/* ================= */
+/* The value of the NumThreads tuning parameter. A negative value
+   indicates that the default value has not yet been determined. All
+   threads share the same value. */
+static int num_threads = -1;
+
+#if defined(THREAD_SAFE)
+
+/* A mutex which serialises access to all the static variables in this
+   module, together with the contents of the current TaskBatch. */
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Condition variables used to wake the pool threads when a new batch of
+   tasks is available, and to wake the calling thread when all pool
+   threads have finished with a batch. */
+static pthread_cond_t pool_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+
+/* The batch currently being performed by the pool (if any). */
+static TaskBatch *pool_batch = NULL;
+
+/* Is the pool currently in use? */
+static int pool_busy = 0;
+
+/* The number of threads in the pool (excluding any calling thread). */
+static int pool_size = 0;
+
+#define LOCK_POOL pthread_mutex_lock( &pool_mutex );
+#define UNLOCK_POOL pthread_mutex_unlock( &pool_mutex );
+
+#else
+
+#define LOCK_POOL
+#define UNLOCK_POOL
+
+#endif
+
+/* Prototypes for Private Functions. */
+/* ================================= */
+static int DefaultThreads( void );
+
+#if defined(THREAD_SAFE)
+static void *PoolWorker( void * );
+static void RunBatch( TaskBatch *, int, int * );
+#endif
+
+/* Function implementations. */
+/* ========================= */
+static int DefaultThreads( void ) {
+/*
+*  Name:
+*     DefaultThreads
+
+*  Purpose:
+*     Return the default value for the NumThreads tuning parameter.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     int DefaultThreads( void )
+
+*  Description:
+*     This function returns the integer value of the AST_THREADS
+*     environment variable, limited to the range [1,MAX_THREADS]. A value
+*     of 1 is returned if the variable is not defined or cannot be
+*     interpreted as an integer.
+
+*  Returned Value:
+*     The default number of threads.
+*/
+
+/* Local Variables: */
+   const char *text;
+   char *end;
+   long int value;
+
+   value = 1;
+   text = getenv( "AST_THREADS" );
+   if( text ) {
+      value = strtol( text, &end, 10 );
+      if( end == text ) value = 1;
+   }
+
+   if( value < 1 ) value = 1;
+   if( value > MAX_THREADS ) value = MAX_THREADS;
+   return (int) value;
+}
+
+int astNumThreads_( int newval, int *status ){
+/*
+*+
+*  Name:
+*     astNumThreads
+
+*  Purpose:
+*     Get or set the NumThreads tuning parameter.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "threads.h"
+*     int astNumThreads( int newval )
+
+*  Description:
+*     This function returns the current value of the NumThreads tuning
+*     parameter (see astTune), optionally storing a new value. This is
+*     the largest number of threads (including the calling thread) that
+*     astRunTasks will use to perform a set of tasks.
+*
+*     All threads share the same value.
+
+*  Parameters:
+*     newval
+*        The new value for the NumThreads tuning parameter. If AST__TUNULL
+*        is supplied, the current value is left unchanged. Values less
+*        than one are treated as one.
+
+*  Returned Value:
+*     astNumThreads()
+*        The original value of the NumThreads tuning parameter.
+
+*  Notes:
+*     - The value of this tuning parameter is ignored if AST was built
+*     without thread-safety, in which case all tasks are performed
+*     serially.
+*     - This function attempts to execute even if the AST error status
+*     is set on entry.
+*-
+*/
+
+/* Local Variables: */
+   int result;
+
+   LOCK_POOL
+   if( num_threads < 0 ) num_threads = DefaultThreads();
+
+   result = num_threads;
+   if( newval != AST__TUNULL ) {
+      if( newval < 1 ) {
+         num_threads = 1;
+      } else if( newval > MAX_THREADS ) {
+         num_threads = MAX_THREADS;
+      } else {
+         num_threads = newval;
+      }
+   }
+   UNLOCK_POOL
+
+   return result;
+}
+
+void astRunTasks_( int ntask, int nworker, AstTaskFun *task, void *data,
+                   int *status ){
+/*
+*+
+*  Name:
+*     astRunTasks
+
+*  Purpose:
+*     Perform a set of independent tasks using the thread pool.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "threads.h"
+*     void astRunTasks( int ntask, int nworker, AstTaskFun *task,
+*                       void *data )
+
+*  Description:
+*     This function performs "ntask" tasks by invoking the supplied
+*     "task" function once for each task index in the range [0,ntask-1].
+*     The tasks are shared out dynamically between the calling thread and
+*     up to "nworker-1" threads taken from the thread pool. The order in
+*     which the tasks are performed is therefore undefined, and tasks
+*     must not depend on each other. The function returns when all tasks
+*     have been completed.
+*
+*     Each invocation of "task" is told the index of the worker that is
+*     performing it. This is an integer in the range [0,nworker-1], and
+*     can be used to select data structures that are private to each
+*     worker (for instance, deep copies of any AST Objects that are
+*     modified by the task). Worker zero is always the calling thread.
+
+*  Parameters:
+*     ntask
+*        The number of tasks to perform.
+*     nworker
+*        The maximum number of workers to use, including the calling
+*        thread. This will usually be the value returned by a previous
+*        call to astTaskWorkers.
+*     task
+*        Pointer to the function that performs a single task. See
+*        AstTaskFun in threads.h.
+*     data
+*        A pointer that is passed unchanged to the "task" function.
+
+*  Notes:
+*     - Any AST Objects used by a task must be locked by the worker
+*     thread before use (see astManageLock).
+*     - If any task fails, no further tasks are started, and the error
+*     status of the first failed pool thread is transferred to the
+*     calling thread once all workers have finished.
+*-
+*/
+
+/* Local Variables: */
+#if defined(THREAD_SAFE)
+   TaskBatch batch;
+   pthread_attr_t attr;
+   pthread_t thread;
+#endif
+   int itask;
+
+/* Check the global error status. */
+   if( !astOK || ntask < 1 ) return;
+
+#if defined(THREAD_SAFE)
+
+/* Use the pool only if more than one worker is needed and the pool is
+   not already in use. */
+   if( nworker > ntask ) nworker = ntask;
+   if( nworker > MAX_THREADS ) nworker = MAX_THREADS;
+   if( nworker > 1 ) {
+      LOCK_POOL
+      if( pool_busy ) {
+         nworker = 1;
+
+/* Ensure the pool contains enough threads, creating new detached
+   threads as needed. If a thread cannot be created, use the threads
+   created so far. */
+      } else {
+         pool_busy = 1;
+         if( pool_size < nworker - 1 ) {
+            pthread_attr_init( &attr );
+            pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_DETACHED );
+            while( pool_size < nworker - 1 ) {
+               if( pthread_create( &thread, &attr, PoolWorker, NULL ) ) break;
+               pool_size++;
+            }
+            pthread_attr_destroy( &attr );
+         }
+         if( nworker > pool_size + 1 ) nworker = pool_size + 1;
+
+/* If no pool threads could be created, release the pool again and
+   perform the tasks serially. */
+         if( nworker < 2 ) {
+            pool_busy = 0;
+            nworker = 1;
+
+/* Otherwise, describe the batch of tasks and make it available to the
+   pool threads. */
+         } else {
+            batch.task = task;
+            batch.data = data;
+            batch.ntask = ntask;
+            batch.next_task = 0;
+            batch.nworker = nworker;
+            batch.next_worker = 1;
+            batch.nbusy = 0;
+            batch.failed = 0;
+            batch.wstatus = 0;
+            pool_batch = &batch;
+            pthread_cond_broadcast( &pool_wake );
+         }
+      }
+      UNLOCK_POOL
+   }
+
+/* If the pool is being used, the calling thread acts as worker zero.
+   Once it has run out of tasks, prevent any further pool threads from
+   joining the batch and wait for those already working to finish. */
+   if( nworker > 1 ) {
+      RunBatch( &batch, 0, status );
+
+      LOCK_POOL
+      pool_batch = NULL;
+      while( batch.nbusy > 0 ) pthread_cond_wait( &pool_done, &pool_mutex );
+      pool_busy = 0;
+      UNLOCK_POOL
+
+/* Transfer any error from the pool threads to the calling thread. The
+   original error messages will already have been reported by the pool
+   thread. */
+      if( astOK && batch.wstatus ) {
+         astError( batch.wstatus, "astRunTasks: A task being performed "
+                   "by an AST worker thread failed.", status );
+      }
+      return;
+   }
+#endif
+
+/* Otherwise, perform all tasks serially in the calling thread. */
+   for( itask = 0; itask < ntask && astOK; itask++ ) {
+      (*task)( data, itask, 0, status );
+   }
+}
+
+int astTaskWorkers_( int ntask, int *status ){
+/*
+*+
+*  Name:
+*     astTaskWorkers
+
+*  Purpose:
+*     Find the number of threads to use for a set of tasks.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "threads.h"
+*     int astTaskWorkers( int ntask )
+
+*  Description:
+*     This function returns the number of workers (including the
+*     calling thread) that astRunTasks may use to perform a given number
+*     of tasks. The caller should use this value to decide whether it is
+*     worth setting up the private data structures needed by each
+*     worker, and to determine how many such structures are needed.
+
+*  Parameters:
+*     ntask
+*        The number of tasks to be performed.
+
+*  Returned Value:
+*     astTaskWorkers()
+*        The number of workers. This will be one if AST was built
+*        without thread-safety, if the NumThreads tuning parameter is one,
+*        or if "ntask" is less than two.
+
+*  Notes:
+*     - A value of one will be returned if this function is invoked with
+*     the global error status set, or if it should fail for any reason.
+*-
+*/
+
+/* Local Variables: */
+   int result;
+
+/* Check the global error status. */
+   if( !astOK ) return 1;
+
+#if defined(THREAD_SAFE)
+   result = astNumThreads( AST__TUNULL );
+   if( result > ntask ) result = ntask;
+   if( result < 1 ) result = 1;
+#else
+   result = 1;
+#endif
+
+   return result;
+}
+
+#if defined(THREAD_SAFE)
+static void *PoolWorker( void *arg ) {
+/*
+*  Name:
+*     PoolWorker
+
+*  Purpose:
+*     The function executed by each thread in the pool.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void *PoolWorker( void *arg )
+
+*  Description:
+*     This function waits until a batch of tasks is available that
+*     requires further workers, joins the batch, performs tasks until
+*     none remain, and then waits for the next batch. It never returns.
+
+*  Parameters:
+*     arg
+*        Not used.
+
+*  Returned Value:
+*     NULL (never returned).
+*/
+
+/* Local Variables: */
+   astDECLARE_GLOBALS
+   TaskBatch *batch;
+   int *status;
+   int iworker;
+
+/* Create the thread-specific data for this thread, and get a pointer to
+   its inherited status value. */
+   astGET_GLOBALS(NULL);
+   status = astGetStatusPtr;
+
+   LOCK_POOL
+   while( 1 ) {
+
+/* Wait for a batch that needs more workers. */
+      while( !pool_batch ||
+             pool_batch->next_worker >= pool_batch->nworker ) {
+         pthread_cond_wait( &pool_wake, &pool_mutex );
+      }
+
+/* Join the batch. */
+      batch = pool_batch;
+      iworker = batch->next_worker++;
+      batch->nbusy++;
+      UNLOCK_POOL
+
+/* Perform tasks until none remain. */
+      astClearStatus;
+      RunBatch( batch, iworker, status );
+
+/* Record any error status, and leave the batch, waking the calling
+   thread if this was the last busy pool thread. */
+      LOCK_POOL
+      if( !astOK && !batch->wstatus ) batch->wstatus = astStatus;
+      astClearStatus;
+      if( --batch->nbusy == 0 ) pthread_cond_broadcast( &pool_done );
+   }
+
+   return NULL;
+}
+
+static void RunBatch( TaskBatch *batch, int iworker, int *status ) {
+/*
+*  Name:
+*     RunBatch
+
+*  Purpose:
+*     Perform tasks from a batch until none remain.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     void RunBatch( TaskBatch *batch, int iworker, int *status )
+
+*  Description:
+*     This function repeatedly claims the next unperformed task in the
+*     supplied batch and performs it, returning when all tasks have been
+*     claimed, or when any task has failed.
+
+*  Parameters:
+*     batch
+*        The batch of tasks.
+*     iworker
+*        The index of the worker executing this function.
+*     status
+*        Pointer to the inherited status variable.
+*/
+
+/* Local Variables: */
+   int itask;
+
+/* Loop until all tasks have been claimed. */
+   while( astOK ) {
+      LOCK_POOL
+      itask = batch->failed ? batch->ntask : batch->next_task++;
+      UNLOCK_POOL
+      if( itask >= batch->ntask ) break;
+
+/* Perform the task, noting if it fails. */
+      (*batch->task)( batch->data, itask, iworker, status );
+      if( !astOK ) {
+         LOCK_POOL
+         batch->failed = 1;
+         UNLOCK_POOL
+      }
+   }
+}
+#endif
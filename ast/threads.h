@@ -0,0 +1,95 @@
+#if !defined( THREADS_INCLUDED )  /* Include this file only once */
+#define THREADS_INCLUDED
+/*
+*+
+*  Name:
+*     threads.h
+
+*  Purpose:
+*     Define the interface to the Threads module.
+
+*  Description:
+*     This module provides a simple pool of worker threads which may be
+*     used to perform independent tasks in parallel (for instance, the
+*     blocks of output pixels created by astResample<X>). The pool is
+*     only used if AST has been built with thread-safety enabled (i.e.
+*     with the THREAD_SAFE macro defined). Otherwise, all tasks are
+*     performed serially by the calling thread.
+*
+*     The number of threads used is controlled by the NumThreads tuning
+*     parameter (see astTune). Its default value is taken from the
+*     AST_THREADS environment variable, or is one (no extra threads) if
+*     that variable is not defined.
+*
+*     Note that this module is not a class implementation, although it
+*     resembles one.
+
+*  Functions Defined:
+*     Public:
+*        None.
+*
+*     Protected:
+*        astNumThreads
+*           Get or set the NumThreads tuning parameter.
+*        astRunTasks
+*           Perform a set of independent tasks using the thread pool.
+*        astTaskWorkers
+*           Find the number of threads to use for a set of tasks.
+
+*  Copyright:
+*     Copyright (C) 2026 Science & Technology Facilities Council.
+
+*  Licence:
+*     This program is free software: you can redistribute it and/or
+*     modify it under the terms of the GNU Lesser General Public
+*     License as published by the Free Software Foundation, either
+*     version 3 of the License, or (at your option) any later
+*     version.
+*
+*     This program is distributed in the hope that it will be useful,
+*     but WITHOUT ANY WARRANTY; without even the implied warranty of
+*     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*     GNU Lesser General Public License for more details.
+*
+*     You should have received a copy of the GNU Lesser General
+*     License along with this program.  If not, see
+*     <http://www.gnu.org/licenses/>.
+
+*  Authors:
+*     DSB: D.S. Berry (Starlink)
+
+*  History:
+*     16-OCT-2026 (DSB):
+*        Original version.
+*-
+*/
+
+/* Include files. */
+/* ============== */
+#include "memory.h"
+
+#if defined(astCLASS)            /* Protected */
+
+/* Type definitions. */
+/* ================= */
+/* The type of a function that performs a single task. The arguments
+   are the "data" pointer supplied to astRunTasks, the zero-based index
+   of the task to perform, the zero-based index of the worker thread
+   performing the task (zero is always the thread that called
+   astRunTasks), and the inherited status pointer. */
+typedef void (AstTaskFun)( void *, int, int, int * );
+
+/* Function prototypes. */
+/* ==================== */
+int astNumThreads_( int, int * );
+int astTaskWorkers_( int, int * );
+void astRunTasks_( int, int, AstTaskFun *, void *, int * );
+
+/* Function interfaces. */
+/* ==================== */
+#define astNumThreads(newval) astERROR_INVOKE(astNumThreads_(newval,STATUS_PTR))
+#define astTaskWorkers(ntask) astERROR_INVOKE(astTaskWorkers_(ntask,STATUS_PTR))
+#define astRunTasks(ntask,nworker,task,data) astERROR_INVOKE(astRunTasks_(ntask,nworker,task,data,STATUS_PTR))
+
+#endif
+#endif
@@ -94,6 +94,19 @@ f     - AST_TIMEADD: Add a time coordinate conversion to an TimeMap
 *     18-JUN-2009 (DSB):
 *        Add OBSALT to argument list for TTTOTDB and TDBTOTT. Change
 *        CLOCKLAT/LON to OBSLAT/LON for consistency with other classes.
+*     16-OCT-2026 (DSB):
+*        - Replace the hard-wired chain of tests in astDat with a sorted
+*        table of TAI-UTC expressions searched by bisection. The table
+*        can be replaced at run-time by one read from a standard leap
+*        second file (see astLeapSeconds).
+*        - Apply UTC<->TAI conversions to whole arrays of times using
+*        DatArray, which re-uses the previous table entry for monotonic
+*        time series and folds in any adjacent TAI<->TT conversion.
+*        - Correct the TAI to UTC conversion for 1961 to 1972, which is
+*        now the exact inverse of the UTC to TAI conversion.
+*     16-OCT-2026 (DSB):
+*        Free tables read by astLeapSeconds once they have been replaced
+*        and are no longer in use by any thread.
 *class--
 */
 
@@ -186,14 +199,100 @@ f     - AST_TIMEADD: Add a time coordinate conversion to an TimeMap
 /* C header files. */
 /* --------------- */
 #include <ctype.h>
+#include <errno.h>
+#include <float.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
 
+/* Module Type Definitions. */
+/* ======================== */
+/* A single TAI-UTC expression. It applies to UTC dates on or after "utc"
+   (an MJD), equivalently TAI dates on or after "tai", and gives TAI-UTC in
+   seconds as "off + ( UTC - ref )*rate". */
+typedef struct LeapEntry {
+   double utc;                   /* UTC MJD at which the expression starts */
+   double tai;                   /* TAI MJD at which the expression starts */
+   double off;                   /* Constant term (seconds) */
+   double ref;                   /* Reference UTC MJD for drift term */
+   double rate;                  /* Drift rate (seconds per day) */
+} LeapEntry;
+
+/* A table of TAI-UTC expressions, in order of increasing date. */
+typedef struct LeapTable {
+   int n;                        /* Number of entries */
+   LeapEntry *entry;             /* Array of entries */
+   int nref;                     /* Number of users of the table */
+} LeapTable;
+
 /* Module Variables. */
 /* ================= */
 
+/* Initialiser for a LeapEntry, which derives the TAI start date from the
+   UTC start date. */
+#define LEAP(utc,off,ref,rate) \
+   { utc, (utc) + ( (off) + ( (utc) - (ref) )*(rate) )/SPD, off, ref, rate }
+
+/* The default table of TAI-UTC expressions. For epochs from 1961 January 1
+   onwards, the expressions are those in ftp://maia.usno.navy.mil/ser7/tai-utc.dat.
+   The 5ms time step at 1961 January 1 is taken from 2.58.1 (p87) of the
+   1992 Explanatory Supplement. The first entry covers all earlier epochs.
+   This table must be updated on each occasion that a leap second is
+   announced. Latest leap second: 2015 July 1. */
+static LeapEntry default_leap[] = {
+   { -DBL_MAX, -DBL_MAX, 1.4178180, 37300.0, 0.001296 },
+   LEAP( 37300.0, 1.4228180, 37300.0, 0.001296 ),  /* 1961 January 1 */
+   LEAP( 37512.0, 1.3728180, 37300.0, 0.001296 ),  /* 1961 August 1 */
+   LEAP( 37665.0, 1.8458580, 37665.0, 0.0011232 ), /* 1962 January 1 */
+   LEAP( 38334.0, 1.9458580, 37665.0, 0.0011232 ), /* 1963 November 1 */
+   LEAP( 38395.0, 3.2401300, 38761.0, 0.001296 ),  /* 1964 January 1 */
+   LEAP( 38486.0, 3.3401300, 38761.0, 0.001296 ),  /* 1964 April 1 */
+   LEAP( 38639.0, 3.4401300, 38761.0, 0.001296 ),  /* 1964 September 1 */
+   LEAP( 38761.0, 3.5401300, 38761.0, 0.001296 ),  /* 1965 January 1 */
+   LEAP( 38820.0, 3.6401300, 38761.0, 0.001296 ),  /* 1965 March 1 */
+   LEAP( 38942.0, 3.7401300, 38761.0, 0.001296 ),  /* 1965 July 1 */
+   LEAP( 39004.0, 3.8401300, 38761.0, 0.001296 ),  /* 1965 September 1 */
+   LEAP( 39126.0, 4.3131700, 39126.0, 0.002592 ),  /* 1966 January 1 */
+   LEAP( 39887.0, 4.2131700, 39126.0, 0.002592 ),  /* 1968 February 1 */
+   LEAP( 41317.0, 10.0, 0.0, 0.0 ),                /* 1972 January 1 */
+   LEAP( 41499.0, 11.0, 0.0, 0.0 ),                /* 1972 July 1 */
+   LEAP( 41683.0, 12.0, 0.0, 0.0 ),                /* 1973 January 1 */
+   LEAP( 42048.0, 13.0, 0.0, 0.0 ),                /* 1974 January 1 */
+   LEAP( 42413.0, 14.0, 0.0, 0.0 ),                /* 1975 January 1 */
+   LEAP( 42778.0, 15.0, 0.0, 0.0 ),                /* 1976 January 1 */
+   LEAP( 43144.0, 16.0, 0.0, 0.0 ),                /* 1977 January 1 */
+   LEAP( 43509.0, 17.0, 0.0, 0.0 ),                /* 1978 January 1 */
+   LEAP( 43874.0, 18.0, 0.0, 0.0 ),                /* 1979 January 1 */
+   LEAP( 44239.0, 19.0, 0.0, 0.0 ),                /* 1980 January 1 */
+   LEAP( 44786.0, 20.0, 0.0, 0.0 ),                /* 1981 July 1 */
+   LEAP( 45151.0, 21.0, 0.0, 0.0 ),                /* 1982 July 1 */
+   LEAP( 45516.0, 22.0, 0.0, 0.0 ),                /* 1983 July 1 */
+   LEAP( 46247.0, 23.0, 0.0, 0.0 ),                /* 1985 July 1 */
+   LEAP( 47161.0, 24.0, 0.0, 0.0 ),                /* 1988 January 1 */
+   LEAP( 47892.0, 25.0, 0.0, 0.0 ),                /* 1990 January 1 */
+   LEAP( 48257.0, 26.0, 0.0, 0.0 ),                /* 1991 January 1 */
+   LEAP( 48804.0, 27.0, 0.0, 0.0 ),                /* 1992 July 1 */
+   LEAP( 49169.0, 28.0, 0.0, 0.0 ),                /* 1993 July 1 */
+   LEAP( 49534.0, 29.0, 0.0, 0.0 ),                /* 1994 July 1 */
+   LEAP( 50083.0, 30.0, 0.0, 0.0 ),                /* 1996 January 1 */
+   LEAP( 50630.0, 31.0, 0.0, 0.0 ),                /* 1997 July 1 */
+   LEAP( 51179.0, 32.0, 0.0, 0.0 ),                /* 1999 January 1 */
+   LEAP( 53736.0, 33.0, 0.0, 0.0 ),                /* 2006 January 1 */
+   LEAP( 54832.0, 34.0, 0.0, 0.0 ),                /* 2009 January 1 */
+   LEAP( 56109.0, 35.0, 0.0, 0.0 ),                /* 2012 July 1 */
+   LEAP( 57204.0, 36.0, 0.0, 0.0 )                 /* 2015 July 1 */
+};
+static LeapTable default_table = {
+   sizeof( default_leap )/sizeof( default_leap[ 0 ] ), default_leap, 1
+};
+
+/* The table of TAI-UTC expressions currently in use. This is shared by
+   all threads. A table read by astLeapSeconds is freed when it has been
+   replaced and the last user of it has finished with it (see
+   GetLeapTable and FreeLeapTable). */
+static LeapTable *leap_table = &default_table;
+
 /* Address of this static variable is used as a unique identifier for
    member of this class. */
 static int class_check;
@@ -220,9 +319,18 @@ astMAKE_INITGLOBALS(TimeMap)
 
 #include <pthread.h>
 
+/* mutex1 is used to serialise access to the "leap_table" pointer and
+   the reference counts of the tables. */
+static pthread_mutex_t mutex1 = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_MUTEX1 pthread_mutex_lock( &mutex1 );
+#define UNLOCK_MUTEX1 pthread_mutex_unlock( &mutex1 );
 
 #else
 
+/* Null macros for mutex locking and unlocking */
+#define LOCK_MUTEX1
+#define UNLOCK_MUTEX1
+
 
 /* Define the class virtual function table and its initialisation flag
    as static variables. */
@@ -242,7 +350,10 @@ AstTimeMap *astTimeMapId_( int, const char *, ... );
 /* ======================================== */
 static AstPointSet *Transform( AstMapping *, AstPointSet *, int, AstPointSet *, int * );
 static const char *CvtString( int, const char **, int *, int *, const char *[ MAX_ARGS ], int * );
+static LeapTable *FreeLeapTable( LeapTable *, int * );
+static LeapTable *GetLeapTable( int * );
 static double Gmsta( double, double, int, int * );
+static double LeapDat( const LeapTable *, double, int, int *, int * );
 static double Rate( AstMapping *, double *, int, int, int * );
 static double Rcc( double, double, double, double, double, int * );
 static int Equal( AstObject *, AstObject *, int * );
@@ -250,6 +361,7 @@ static int CvtCode( const char *, int * );
 static int MapMerge( AstMapping *, int, int, int *, AstMapping ***, int **, int * );
 static void AddArgs( int, double *, int * );
 static void AddTimeCvt( AstTimeMap *, int, const double *, int * );
+static void DatArray( const LeapTable *, int, double *, double, int, double, double, int * );
 static void Copy( const AstObject *, AstObject *, int * );
 static void Delete( AstObject *, int * );
 static void Dump( AstObject *, AstChannel *, int * );
@@ -1267,383 +1379,230 @@ double astDat_( double in, int forward, int *status ){
 *     within a leap second.  Though in most cases UTC can include the
 *     fractional part, correct behaviour on the day of a leap second
 *     can only be guaranteed up to the end of the second 23:59:59.
-*     - For epochs from 1961 January 1 onwards, the expressions from the
-*     file ftp://maia.usno.navy.mil/ser7/tai-utc.dat are used.
-*     - The 5ms time step at 1961 January 1 is taken from 2.58.1 (p87) of
-*     the 1992 Explanatory Supplement.
+*     - The TAI-UTC expressions are taken from a table. By default this
+*     is the built-in table described in the "Module Variables" section,
+*     but it may be replaced by a table read from a leap second file
+*     using astLeapSeconds.
 *     - UTC began at 1960 January 1.0 (JD 2436934.5) and it is improper
 *     to call the routine with an earlier epoch.  However, if this
 *     is attempted, the TAI-UTC expression for the year 1960 is used.
+*     - Use DatArray in preference to this function when converting many
+*     values.
 
 *  Implementation Details:
 *     - This function is based on SLA_DAT by P.T.Wallace.
-*     - This routine must be updated on each occasion that a leap second is
-*     announced
-*     - Latest leap second:  2015 July 1
 
 *-
 */
 
 /* Local Variables: */
-   double result;
+   LeapTable *table;             /* Table of TAI-UTC expressions */
+   double result;                /* Returned value */
+   int hint;                     /* Index of table entry to check first */
 
 /* Initialise the returned value. */
    if( in == AST__BAD ) return AST__BAD;
 
-/* First do TAI-UTC at a given UTC
-   ------------------------------- */
-   if( forward ) {
-
-/* 2015 July 1 */
-      if ( in >= 57204.0 ) {
-         result = 36.0;
-
-/* 2012 July 1 */
-      } else if ( in >= 56109.0 ) {
-         result = 35.0;
-
-/* 2009 January 1 */
-      } else if ( in >= 54832.0 ) {
-         result = 34.0;
-
-/* 2006 January 1 */
-      } else if( in >= 53736.0 ) {
-         result = 33.0;
-
-/* 1999 January 1 */
-      } else if( in >= 51179.0 ){
-         result = 32.0;
-
-/* 1997 July 1 */
-      } else if( in >= 50630.0 ){
-         result = 31.0;
-
-/* 1996 January 1 */
-      } else if( in >= 50083.0 ){
-         result = 30.0;
-
-/* 1994 July 1 */
-      } else if( in >= 49534.0 ){
-         result = 29.0;
-
-/* 1993 July 1 */
-      } else if( in >= 49169.0 ){
-         result = 28.0;
-
-/* 1992 July 1 */
-      } else if( in >= 48804.0 ){
-         result = 27.0;
-
-/* 1991 January 1 */
-      } else if( in >= 48257.0 ){
-         result = 26.0;
-
-/* 1990 January 1 */
-      } else if( in >= 47892.0 ){
-         result = 25.0;
+/* Get the table of TAI-UTC expressions currently in use, evaluate the
+   appropriate expression, and then release the table. */
+   table = GetLeapTable( status );
+   hint = -1;
+   result = LeapDat( table, in, forward, &hint, status );
+   table = FreeLeapTable( table, status );
 
-/* 1988 January 1 */
-      } else if( in >= 47161.0 ){
-         result = 24.0;
-
-/* 1985 July 1 */
-      } else if( in >= 46247.0 ){
-         result = 23.0;
-
-/* 1983 July 1 */
-      } else if( in >= 45516.0 ){
-         result = 22.0;
-
-/* 1982 July 1 */
-      } else if( in >= 45151.0 ){
-         result = 21.0;
-
-/* 1981 July 1 */
-      } else if( in >= 44786.0 ){
-         result = 20.0;
-
-/* 1980 January 1 */
-      } else if( in >= 44239.0 ){
-         result = 19.0;
-
-/* 1979 January 1 */
-      } else if( in >= 43874.0 ){
-         result = 18.0;
-
-/* 1978 January 1 */
-      } else if( in >= 43509.0 ){
-         result = 17.0;
-
-/* 1977 January 1 */
-      } else if( in >= 43144.0 ){
-         result = 16.0;
-
-/* 1976 January 1 */
-      } else if( in >= 42778.0 ){
-         result = 15.0;
-
-/* 1975 January 1 */
-      } else if( in >= 42413.0 ){
-         result = 14.0;
+/* Return the result. */
+   return result;
+}
 
-/* 1974 January 1 */
-      } else if( in >= 42048.0 ){
-         result = 13.0;
+static void DatArray( const LeapTable *table, int npoint, double *time,
+                      double off, int forward, double pre, double post,
+                      int *status ){
+/*
+*  Name:
+*     DatArray
 
-/* 1973 January 1 */
-      } else if( in >= 41683.0 ){
-         result = 12.0;
+*  Purpose:
+*     Convert an array of times between UTC and TAI.
 
-/* 1972 July 1 */
-      } else if( in >= 41499.0 ){
-         result = 11.0;
+*  Type:
+*     Private function.
 
-/* 1972 January 1 */
-      } else if( in >= 41317.0 ){
-         result = 10.0;
+*  Synopsis:
+*     #include "timemap.h"
+*     void DatArray( const LeapTable *table, int npoint, double *time,
+*                    double off, int forward, double pre, double post,
+*                    int *status )
 
-/* 1968 February 1 */
-      } else if( in >= 39887.0 ){
-         result = 4.2131700 + ( in - 39126.0 )*0.002592;
+*  Class Membership:
+*     TimeMap member function
 
-/* 1966 January 1 */
-      } else if( in >= 39126.0 ){
-         result = 4.3131700 + ( in - 39126.0 )*0.002592;
+*  Description:
+*     This function converts an array of times between UTC and TAI,
+*     optionally applying a constant shift to each time before and after
+*     the conversion. This allows a TAI<->TT conversion that immediately
+*     precedes or follows the UTC<->TAI conversion to be applied in the
+*     same pass through the array. Each good time is modified as follows:
+*
+*        t = t + pre
+*        t = t + dat( t + off )/SPD
+*        t = t + post
+*
+*     where "dat" is TAI-UTC or UTC-TAI, as returned by astDat.
+*
+*     The table entry used for each point is checked first when finding
+*     the entry to use for the next point, so that time series that
+*     change monotonically (the usual case) do not need a full search of
+*     the table for every point.
 
-/* 1965 September 1 */
-      } else if( in >= 39004.0 ){
-         result = 3.8401300 + ( in - 38761.0 )*0.001296;
+*  Parameters:
+*     table
+*        The table of TAI-UTC expressions to use (see GetLeapTable).
+*     npoint
+*        The number of times to convert.
+*     time
+*        The times to convert. Each is an offset in days from the MJD
+*        given by "off". Modified on exit to hold the converted times.
+*        AST__BAD values are left unchanged.
+*     off
+*        The MJD corresponding to a value of zero in "time".
+*     forward
+*        If non-zero, the times are converted from UTC to TAI. Otherwise
+*        they are converted from TAI to UTC.
+*     pre
+*        A shift, in days, to add to each time before converting it.
+*     post
+*        A shift, in days, to add to each time after converting it.
+*     status
+*        Pointer to the inherited status variable.
+*/
 
-/* 1965 July 1 */
-      } else if( in >= 38942.0 ){
-         result = 3.7401300 + ( in - 38761.0 )*0.001296;
+/* Local Variables: */
+   double t;                     /* Time being converted */
+   int hint;                     /* Index of table entry to check first */
+   int point;                    /* Loop counter for points */
 
-/* 1965 March 1 */
-      } else if( in >= 38820.0 ){
-         result = 3.6401300 + ( in - 38761.0 )*0.001296;
+/* Check the global error status. */
+   if ( !astOK ) return;
 
-/* 1965 January 1 */
-      } else if( in >= 38761.0 ){
-         result = 3.5401300 + ( in - 38761.0 )*0.001296;
+/* Convert each good time, starting the search for the table entry to
+   use for the first time at the start of the table. */
+   hint = -1;
+   for ( point = 0; point < npoint; point++ ) {
+      if ( time[ point ] != AST__BAD ) {
+         t = time[ point ] + pre;
+         t += LeapDat( table, t + off, forward, &hint, status )/SPD;
+         time[ point ] = t + post;
+      }
+   }
+}
 
-/* 1964 September 1 */
-      } else if( in >= 38639.0 ){
-         result = 3.4401300 + ( in - 38761.0 )*0.001296;
+static LeapTable *FreeLeapTable( LeapTable *table, int *status ){
+/*
+*  Name:
+*     FreeLeapTable
 
-/* 1964 April 1 */
-      } else if( in >= 38486.0 ){
-         result = 3.3401300 + ( in - 38761.0 )*0.001296;
+*  Purpose:
+*     Release a table of TAI-UTC expressions.
 
-/* 1964 January 1 */
-      } else if( in >= 38395.0 ){
-         result = 3.2401300 + ( in - 38761.0 )*0.001296;
+*  Type:
+*     Private function.
 
-/* 1963 November 1 */
-      } else if( in >= 38334.0 ){
-         result = 1.9458580 + ( in - 37665.0 )*0.0011232;
+*  Synopsis:
+*     #include "timemap.h"
+*     LeapTable *FreeLeapTable( LeapTable *table, int *status )
 
-/* 1962 January 1 */
-      } else if( in >= 37665.0 ){
-         result = 1.8458580 + ( in - 37665.0 )*0.0011232;
+*  Class Membership:
+*     TimeMap member function
 
-/* 1961 August 1 */
-      } else if( in >= 37512.0 ){
-         result = 1.3728180 + ( in - 37300.0 )*0.001296;
+*  Description:
+*     This function indicates that the caller has finished with a table
+*     of TAI-UTC expressions obtained from GetLeapTable (or stored by
+*     astLeapSeconds). The table is freed when its last user releases it,
+*     which can only happen once it has been replaced by another table.
+*     The built-in table is never freed.
 
-/* 1961 January 1 */
-      } else if( in >= 37300.0 ){
-         result = 1.4228180 + ( in - 37300.0 )*0.001296;
+*  Parameters:
+*     table
+*        Pointer to the table. May be NULL.
+*     status
+*        Pointer to the inherited status variable.
 
-/* Before that */
-      } else {
-         result = 1.4178180 + ( in - 37300.0 )*0.001296;
-      }
+*  Returned Value:
+*     A NULL pointer.
 
-/* Now do UTC-TAI at a given TAI.
-   ------------------------------  */
-   } else {
+*  Notes:
+*     - This function attempts to execute even if an error has already
+*     occurred.
 
+*/
 
-/* 2015 July 1 */
-      if ( in >= 57204.0 + 36.0/SPD ) {
-         result = -36.0;
+/* Local Variables: */
+   int unused;                   /* Is the table no longer in use? */
+
+/* Check a table was supplied. */
+   if( !table ) return NULL;
+
+/* Decrement the reference count, and see if the table is now unused. The
+   table pointer and the reference counts are shared by all threads. */
+   LOCK_MUTEX1;
+   unused = ( --( table->nref ) == 0 && table != &default_table );
+   UNLOCK_MUTEX1;
+
+/* No other thread can now access an unused table, so it can be freed
+   without holding the mutex. */
+   if( unused ) {
+      table->entry = astFree( table->entry );
+      table = astFree( table );
+   }
 
-/* 2012 July 1 */
-      } else if( in >= 56109.0 + 35.0/SPD ) {
-         result = -35.0;
+/* Return a NULL pointer. */
+   return NULL;
+}
 
-/* 2009 January 1 */
-      } else if( in >= 54832.0 + 34.0/SPD ) {
-         result = -34.0;
+static LeapTable *GetLeapTable( int *status ){
+/*
+*  Name:
+*     GetLeapTable
 
-/* 2006 January 1 */
-      } else if( in >= 53736.0 + 33.0/SPD ){
-         result = -33.0;
+*  Purpose:
+*     Get the table of TAI-UTC expressions currently in use.
 
-/* 1999 January 1 */
-      } else if( in >= 51179.0 + 32.0/SPD ){
-         result = -32.0;
+*  Type:
+*     Private function.
 
-/* 1997 July 1 */
-      } else if( in >= 50630.0 + 31.0/SPD ){
-         result = -31.0;
+*  Synopsis:
+*     #include "timemap.h"
+*     LeapTable *GetLeapTable( int *status )
 
-/* 1996 January 1 */
-      } else if( in >= 50083.0 + 30.0/SPD ){
-         result = -30.0;
+*  Class Membership:
+*     TimeMap member function
 
-/* 1994 July 1 */
-      } else if( in >= 49534.0 + 29.0/SPD ){
-         result = -29.0;
+*  Description:
+*     This function returns a pointer to the table of TAI-UTC expressions
+*     currently in use. This will be the default table unless another
+*     table has been read using astLeapSeconds. The returned table remains
+*     valid even if astLeapSeconds is subsequently called to replace it,
+*     until it is released by calling FreeLeapTable.
 
-/* 1993 July 1 */
-      } else if( in >= 49169.0 + 28.0/SPD ){
-         result = -28.0;
+*  Parameters:
+*     status
+*        Pointer to the inherited status variable.
 
-/* 1992 July 1 */
-      } else if( in >= 48804.0 + 27.0/SPD ){
-         result = -27.0;
+*  Returned Value:
+*     Pointer to the table.
 
-/* 1991 January 1 */
-      } else if( in >= 48257.0 + 26.0/SPD ){
-         result = -26.0;
+*/
 
-/* 1990 January 1 */
-      } else if( in >= 47892.0 + 25.0/SPD ){
-         result = -25.0;
+/* Local Variables: */
+   LeapTable *result;
 
-/* 1988 January 1 */
-      } else if( in >= 47161.0 + 24.0/SPD ){
-         result = -24.0;
-
-/* 1985 July 1 */
-      } else if( in >= 46247.0 + 23.0/SPD ){
-         result = -23.0;
-
-/* 1983 July 1 */
-      } else if( in >= 45516.0 + 22.0/SPD ){
-         result = -22.0;
-
-/* 1982 July 1 */
-      } else if( in >= 45151.0 + 21.0/SPD ){
-         result = -21.0;
-
-/* 1981 July 1 */
-      } else if( in >= 44786.0 + 20.0/SPD ){
-         result = -20.0;
-
-/* 1980 January 1 */
-      } else if( in >= 44239.0 + 19.0/SPD ){
-         result = -19.0;
-
-/* 1979 January 1 */
-      } else if( in >= 43874.0 + 18.0/SPD ){
-         result = -18.0;
-
-/* 1978 January 1 */
-      } else if( in >= 43509.0 + 17.0/SPD ){
-         result = -17.0;
-
-/* 1977 January 1 */
-      } else if( in >= 43144.0 + 16.0/SPD ){
-         result = -16.0;
-
-/* 1976 January 1 */
-      } else if( in >= 42778.0 + 15.0/SPD ){
-         result = -15.0;
-
-/* 1975 January 1 */
-      } else if( in >= 42413.0 + 14.0/SPD ){
-         result = -14.0;
-
-/* 1974 January 1 */
-      } else if( in >= 42048.0 + 13.0/SPD ){
-         result = -13.0;
-
-/* 1973 January 1 */
-      } else if( in >= 41683.0 + 12.0/SPD ){
-         result = -12.0;
-
-/* 1972 July 1 */
-      } else if( in >= 41499.0 + 11.0/SPD ){
-         result = -11.0;
-
-/* 1972 January 1 */
-      } else if( in >= 41317.0 + 10.0/SPD ){
-         result = -10.0;
-
-/* 1968 February 1 */
-      } else if( in >= 39887.0 + ( 4.2131700
-                                  + ( 39887.0 - 39126.0 )*0.002592 )/SPD ){
-         result = -( 4.2131700 + ( in - 39126.0 )*0.002592 )/1.02592;
-
-/* 1966 January 1 */
-      } else if( in >= 39126.0 + ( 4.3131700
-                                  + ( 39126.0 - 39126.0 )*0.002592 )/SPD ){
-         result = -( 4.2131700 + ( in - 39126.0 )*0.002592 )/1.02592;
-
-/* 1965 September 1 */
-      } else if( in >= 39004.0 + ( 3.8401300
-                                  + ( 39004.0 - 38761.0 )*0.001296 )/SPD ){
-         result = -( 3.8401300 + ( in - 38761.0 )*0.001296 )/1.001296;
-
-/* 1965 July 1 */
-      } else if( in >= 38942.0 + ( 3.7401300
-                                  + ( 38942.0 - 38761.0 )*0.001296 )/SPD ){
-         result = -( 3.7401300 + ( in - 38761.0 )*0.001296 )/1.01296;
-
-/* 1965 March 1 */
-      } else if( in >= 38820.0 + ( 3.6401300
-                                  + ( 38820.0 - 38761.0 )*0.001296 )/SPD ){
-         result = -( 3.6401300 + ( in - 38761.0 )*0.001296 )/1.001296;
-
-/* 1965 January 1 */
-      } else if( in >= 38761.0 + ( 3.5401300
-                                   + ( 38761.0 - 38761.0 )*0.001296 )/SPD ){
-         result = -( 3.5401300 + ( in - 38761.0 )*0.001296 )/1.001296;
-
-/* 1964 September 1 */
-      } else if( in >= 38639.0 + ( 3.4401300
-                                   + ( 38639.0 - 38761.0 )*0.001296 )/SPD ){
-         result = -( 3.4401300 + ( in - 38761.0 )*0.001296 )/1.001296;
-
-/* 1964 April 1 */
-      } else if( in >= 38486.0 + ( 3.3401300
-                                   + ( 38486.0 - 38761.0 )*0.001296 )/SPD ){
-         result = -( 3.3401300 + ( in - 38761.0 )*0.001296 )/1.001296;
-
-/* 1964 January 1 */
-      } else if( in >= 38395.0 + ( 3.2401300
-                                   + ( 38395.0 - 38761.0 )*0.001296 )/SPD ){
-         result = -( 3.2401300 + ( in - 38761.0 )*0.001296 )/1.001296;
-
-/* 1963 November 1 */
-      } else if( in >= 38334.0 + ( 1.9458580
-                                   + ( 38334.0 - 37665.0 )*0.0011232 )/SPD ){
-         result = -( 1.9458580 + ( in - 37665.0 )*0.0011232 )/1.0011232;
-
-/* 1962 January 1 */
-      } else if( in >= 37665.0 + ( 1.8458580
-                                   + ( 37665.0 - 37665.0 )*0.0011232 )/SPD ){
-         result = -( 1.8458580 + ( in - 37665.0 )*0.0011232 )/1.0011232;
-
-/* 1961 August 1 */
-      } else if( in >= 37512.0 + ( 1.3728180
-                                   + ( 37512.0 - 37300.0 )*0.001296 )/SPD ){
-         result = -( 1.3728180 + ( in - 37300.0 )*0.001296 )/1.001296;
-
-/* 1961 January 1 */
-      } else if( in >= 37300.0 + ( 1.4228180
-                                   + ( 37300.0 - 37300.0 )*0.001296 )/SPD ){
-         result = -( 1.4228180 + ( in - 37300.0 )*0.001296 )/1.001296;
-
-/* Before that */
-      } else {
-         result = -( 1.4178180 + ( in - 37300.0 )*0.001296 )/1.001296;
-      }
-   }
+/* The table pointer is shared by all threads. Record that the table has
+   another user, so that it is not freed if it is replaced while in use. */
+   LOCK_MUTEX1;
+   result = leap_table;
+   result->nref++;
+   UNLOCK_MUTEX1;
 
-/* Return the result */
    return result;
 }
 
@@ -1849,6 +1808,332 @@ void astInitTimeMapVtab_(  AstTimeMapVtab *vtab, const char *name, int *status )
    }
 }
 
+static double LeapDat( const LeapTable *table, double in, int forward,
+                       int *hint, int *status ){
+/*
+*  Name:
+*     LeapDat
+
+*  Purpose:
+*     Evaluate TAI-UTC or UTC-TAI using a table of TAI-UTC expressions.
+
+*  Type:
+*     Private function.
+
+*  Synopsis:
+*     #include "timemap.h"
+*     double LeapDat( const LeapTable *table, double in, int forward,
+*                     int *hint, int *status )
+
+*  Class Membership:
+*     TimeMap member function
+
+*  Description:
+*     This function finds the entry in a table of TAI-UTC expressions
+*     that applies at a given epoch, and returns TAI-UTC or UTC-TAI at
+*     that epoch. The entry indicated by "hint" (and the one following it)
+*     is checked first. If neither applies, the table is searched by
+*     bisection.
+
+*  Parameters:
+*     table
+*        The table of TAI-UTC expressions.
+*     in
+*        UTC date or TAI time (as selected by "forward"), as an absolute
+*        MJD.
+*     forward
+*        If non-zero, "in" should be a UTC value, and the returned value
+*        is TAI-UTC. If zero, "in" should be a TAI value, and the returned
+*        value is UTC-TAI.
+*     hint
+*        Pointer to the index of the table entry to check first. A negative
+*        value causes the whole table to be searched. On exit, the index
+*        of the entry that was used is returned.
+*     status
+*        Pointer to the inherited status variable.
+
+*  Returned Value:
+*     Either UTC-TAI or TAI-UTC (as indicated by "forward") in units of
+*     seconds.
+
+*/
+
+/* Local Variables: */
+   const LeapEntry *entry;       /* Table entry to use */
+   double dat;                   /* TAI-UTC */
+   int hi;                       /* Upper limit of bisection range */
+   int i;                        /* Index of table entry to use */
+   int lo;                       /* Lower limit of bisection range */
+   int mid;                      /* Middle of bisection range */
+
+/* Macro giving the start date of the i'th table entry in the time scale
+   of "in". */
+#define START(i) ( forward ? table->entry[ i ].utc : table->entry[ i ].tai )
+
+/* See if the hinted entry, or the one following it, applies at the
+   given epoch. */
+   i = *hint;
+   if( i >= 0 && i < table->n && START( i ) <= in ) {
+      if( i + 1 < table->n && START( i + 1 ) <= in ) {
+         i++;
+         if( i + 1 < table->n && START( i + 1 ) <= in ) i = -1;
+      }
+   } else {
+      i = -1;
+   }
+
+/* If not, find the last entry that starts on or before the given epoch
+   by bisection. The first entry starts at -DBL_MAX, so such an entry
+   always exists. */
+   if( i < 0 ) {
+      lo = 0;
+      hi = table->n - 1;
+      while( lo < hi ) {
+         mid = ( lo + hi + 1 )/2;
+         if( START( mid ) <= in ) {
+            lo = mid;
+         } else {
+            hi = mid - 1;
+         }
+      }
+      i = lo;
+   }
+#undef START
+
+/* Return the index of the entry used. */
+   *hint = i;
+   entry = table->entry + i;
+
+/* Evaluate TAI-UTC at the given UTC. */
+   if( forward ) {
+      return entry->off + ( in - entry->ref )*entry->rate;
+
+/* Evaluate UTC-TAI at the given TAI. Substituting UTC = TAI - dat/SPD into
+   the expression for TAI-UTC and solving for "dat" gives the following.
+   For leap seconds after 1972 the rate is zero and "dat" is constant. */
+   } else {
+      dat = ( entry->off + ( in - entry->ref )*entry->rate )/
+            ( 1.0 + entry->rate/SPD );
+      return -dat;
+   }
+}
+
+int astLeapSeconds_( const char *file, int *status ){
+/*
+*+
+*  Name:
+*     astLeapSeconds
+
+*  Purpose:
+*     Read a table of leap seconds from a file.
+
+*  Type:
+*     Protected function.
+
+*  Synopsis:
+*     #include "timemap.h"
+*     int astLeapSeconds( const char *file )
+
+*  Class Membership:
+*     TimeMap member function
+
+*  Description:
+*     This function reads the dates of leap seconds, and the value of
+*     TAI-UTC following each one, from a text file, and uses them in place
+*     of the built-in table for all subsequent conversions between UTC and
+*     TAI (in all threads). This allows newly announced leap seconds to be
+*     used without rebuilding AST. It is normally invoked by setting the
+*     "LeapSeconds" tuning parameter (see astTuneC).
+*
+*     Two standard file formats are recognised:
+*
+*     - The "leap-seconds.list" file distributed by the IETF and NIST, in
+*     which each line holds the time of a leap second as a number of
+*     seconds since 1900 January 1, followed by TAI-UTC.
+*     - The "Leap_Second.dat" file distributed by the IERS, in which each
+*     line holds the MJD, day, month and year of a leap second, followed
+*     by TAI-UTC.
+*
+*     Text following a "#" character is ignored in both formats, as are
+*     blank lines.
+
+*  Parameters:
+*     file
+*        The path to the file. If this is NULL or blank, the built-in table
+*        of leap seconds is re-instated.
+
+*  Returned Value:
+*     The number of entries in the table of TAI-UTC expressions now in
+*     use, including entries for the period before 1972 (when UTC
+*     drifted continuously relative to TAI).
+
+*  Notes:
+*     - The built-in TAI-UTC expressions are retained for all epochs
+*     before the first leap second read from the file.
+*     - An error is reported, and the table currently in use is left
+*     unchanged, if the file cannot be read or contains no leap seconds,
+*     or if the leap seconds in the file are not in date order.
+*     - A value of zero will be returned if this function is invoked with
+*     the global error status set, or if it should fail for any reason.
+*-
+*/
+
+/* Local Constants: */
+#define ERRBUF_LEN 80
+#define LINE_LEN 200
+
+/* Local Variables: */
+   FILE *fd;                     /* File descriptor */
+   LeapEntry *entry;             /* Entries in new table */
+   LeapTable *old;               /* Table previously in use */
+   LeapTable *table;             /* New table */
+   char *c;                      /* Pointer to comment character */
+   char *errstat;                /* Pointer for system error message */
+   char errbuf[ ERRBUF_LEN ];    /* Buffer for system error message */
+   char line[ LINE_LEN ];        /* Buffer for a line of text */
+   double utc;                   /* MJD of leap second */
+   double val[ 5 ];              /* Values read from a line */
+   int iline;                    /* Line number */
+   int n;                        /* Number of entries in new table */
+   int nkeep;                    /* Number of default entries retained */
+   int nval;                     /* Number of values read from a line */
+   int result;                   /* Returned value */
+
+/* Check the global error status. */
+   result = 0;
+   if ( !astOK ) return result;
+
+/* If no file was supplied, re-instate the default table, and release
+   the table previously in use. */
+   if( !file || astChrLen( file ) == 0 ) {
+      LOCK_MUTEX1;
+      old = leap_table;
+      leap_table = &default_table;
+      default_table.nref++;
+      UNLOCK_MUTEX1;
+      old = FreeLeapTable( old, status );
+      return default_table.n;
+   }
+
+/* Open the file. */
+   fd = fopen( file, "r" );
+   if( !fd ) {
+      if ( errno ) {
+#if HAVE_STRERROR_R
+         strerror_r( errno, errbuf, ERRBUF_LEN );
+         errstat = errbuf;
+#else
+         errstat = strerror( errno );
+#endif
+         astError( AST__RDERR, "astLeapSeconds: Failed to open leap "
+                   "second file '%s' - %s.", status, file, errstat );
+      } else {
+         astError( AST__RDERR, "astLeapSeconds: Failed to open leap "
+                   "second file '%s'.", status, file );
+      }
+      return result;
+   }
+
+/* Start with room for the default table entries. Entries are appended
+   to the end of this array as leap seconds are read, and the leading
+   default entries that are superseded are removed afterwards. */
+   n = default_table.n;
+   entry = astStore( NULL, default_table.entry, sizeof( LeapEntry )*n );
+   nkeep = n;
+
+/* Read each line of the file. */
+   iline = 0;
+   while( astOK && fgets( line, LINE_LEN, fd ) ) {
+      iline++;
+
+/* Remove any comment, and skip blank lines. */
+      c = strchr( line, '#' );
+      if( c ) *c = 0;
+      if( astChrLen( line ) == 0 ) continue;
+
+/* Read the values on the line, and get the MJD of the leap second. */
+      nval = sscanf( line, "%lf %lf %lf %lf %lf", val, val + 1, val + 2,
+                     val + 3, val + 4 );
+      if( nval == 2 ) {
+         utc = 15020.0 + val[ 0 ]/SPD;
+      } else if( nval == 5 ) {
+         utc = val[ 0 ];
+         val[ 1 ] = val[ 4 ];
+      } else {
+         astError( AST__BADIN, "astLeapSeconds: Line %d of leap second "
+                   "file '%s' is not in a recognised format: '%s'.",
+                   status, iline, file, line );
+         break;
+      }
+
+/* The leap seconds must be in date order. */
+      if( n > default_table.n && utc <= entry[ n - 1 ].utc ) {
+         astError( AST__BADIN, "astLeapSeconds: The leap second on line %d "
+                   "of file '%s' is not later than the previous one.",
+                   status, iline, file );
+         break;
+      }
+
+/* The first leap second determines how many of the default entries are
+   retained. */
+      if( n == default_table.n ) {
+         while( nkeep > 1 && entry[ nkeep - 1 ].utc >= utc ) nkeep--;
+      }
+
+/* Append an entry for the leap second. */
+      entry = astGrow( entry, n + 1, sizeof( LeapEntry ) );
+      if( astOK ) {
+         entry[ n ].utc = utc;
+         entry[ n ].tai = utc + val[ 1 ]/SPD;
+         entry[ n ].off = val[ 1 ];
+         entry[ n ].ref = 0.0;
+         entry[ n ].rate = 0.0;
+         n++;
+      }
+   }
+   fclose( fd );
+
+/* Report an error if no leap seconds were found. */
+   if( astOK && n == default_table.n ) {
+      astError( AST__BADIN, "astLeapSeconds: No leap seconds found in "
+                "file '%s'.", status, file );
+   }
+
+/* Remove the default entries that are superseded by the file, and store
+   the new table for use by all threads. The reference held by "leap_table"
+   is transferred to the new table, and the table previously in use is
+   released (it is freed once any other threads using it have finished
+   with it). */
+   if( astOK ) {
+      (void) memmove( entry + nkeep, entry + default_table.n,
+                      sizeof( LeapEntry )*( n - default_table.n ) );
+      n -= default_table.n - nkeep;
+
+      table = astMalloc( sizeof( LeapTable ) );
+      if( astOK ) {
+         table->n = n;
+         table->entry = entry;
+         table->nref = 1;
+         LOCK_MUTEX1;
+         old = leap_table;
+         leap_table = table;
+         UNLOCK_MUTEX1;
+         old = FreeLeapTable( old, status );
+         result = n;
+      }
+   }
+
+/* Free the entries if anything went wrong. */
+   if( !astOK ) entry = astFree( entry );
+
+/* Return the result. */
+   return result;
+
+/* Undefine local macros. */
+#undef ERRBUF_LEN
+#undef LINE_LEN
+}
+
 static int MapMerge( AstMapping *this, int where, int series, int *nmap,
                      AstMapping ***map_list, int **invert_list, int *status ) {
 /*
@@ -3739,11 +4024,13 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
 /* Local Variables: */
    AstPointSet *result;          /* Pointer to output PointSet */
    AstTimeMap *map;              /* Pointer to TimeMap to be applied */
+   LeapTable *leaps;             /* Table of TAI-UTC expressions */
    double **ptr_in;              /* Pointer to input coordinate data */
    double **ptr_out;             /* Pointer to output coordinate data */
    double *args;                 /* Pointer to argument list for conversion */
    double *time;                 /* Pointer to output time axis value array */
    double gmstx;                 /* GMST offset (in days) */
+   double shift;                 /* TT-TAI or TAI-TT (in days) */
    double tai;                   /* Absolute TAI value (in days) */
    double tdb;                   /* Absolute TDB value (in days) */
    double tt;                    /* Absolute TT value (in days) */
@@ -3751,8 +4038,10 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
    int ct;                       /* Conversion type */
    int cvt;                      /* Loop counter for conversions */
    int end;                      /* Termination index for conversion loop */
+   int hint;                     /* Index of last TAI-UTC table entry used */
    int inc;                      /* Increment for conversion loop */
    int ncoord_in;                /* Number of coordinates per input point */
+   int next;                     /* Type of next conversion */
    int npoint;                   /* Number of points */
    int point;                    /* Loop counter for points */
    int start;                    /* Starting index for conversion loop */
@@ -3796,6 +4085,10 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
          (void) memcpy( time, ptr_in[ 0 ], sizeof( double ) * (size_t) npoint );
       }
 
+/* Get the table of TAI-UTC expressions to use for all conversions. */
+      leaps = GetLeapTable( status );
+      hint = -1;
+
 /* We will loop to apply each time coordinate conversion in turn to the
    (time) array. However, if the inverse transformation was requested,
    we must loop through these transformations in reverse order, so set up
@@ -3939,77 +4232,44 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                }
                break;
 
-/* TAI to UTC. */
-/* ----------- */
+/* TAI to UTC, and UTC to TAI. */
+/* --------------------------- */
+/* If the next conversion to be applied is between TAI and TT, it is
+   applied in the same pass through the array. */
             case AST__TAITOUTC:
-               if ( forward ) {
-                  for ( point = 0; point < npoint; point++ ) {
-                     if ( time[ point ] != AST__BAD ) {
-                        time[ point ] += astDat( time[ point ] +
-                                              args[ 0 ], 0 )/SPD;
-                     }
-                  }
-               } else {
-                  for ( point = 0; point < npoint; point++ ) {
-                     if ( time[ point ] != AST__BAD ) {
-                        time[ point ] += astDat( time[ point ] +
-                                              args[ 0 ], 1 )/SPD;
-                     }
-                  }
-               }
-               break;
-
-/* UTC to TAI. */
-/* ----------- */
             case AST__UTCTOTAI:
-               if ( forward ) {
-                  for ( point = 0; point < npoint; point++ ) {
-                     if ( time[ point ] != AST__BAD ) {
-                        time[ point ] += astDat( time[ point ] +
-                                              args[ 0 ], 1 )/SPD;
-                     }
-                  }
-               } else {
-                  for ( point = 0; point < npoint; point++ ) {
-                     if ( time[ point ] != AST__BAD ) {
-                        time[ point ] += astDat( time[ point ] +
-                                              args[ 0 ], 0 )/SPD;
-                     }
-                  }
+               next = ( cvt + inc != end ) ? map->cvttype[ cvt + inc ] :
+                                             AST__TIME_NULL;
+               shift = 0.0;
+               if( next == AST__TAITOTT || next == AST__TTTOTAI ) {
+                  shift = ( ( next == AST__TAITOTT ) == ( forward != 0 ) ) ?
+                          (TTOFF/SPD) : -(TTOFF/SPD);
+                  cvt += inc;
                }
+               DatArray( leaps, npoint, time, args[ 0 ],
+                         ( ct == AST__UTCTOTAI ) == ( forward != 0 ),
+                         0.0, shift, status );
                break;
 
-/* TAI to TT. */
-/* ---------- */
+/* TAI to TT, and TT to TAI. */
+/* ------------------------- */
+/* If the next conversion to be applied is between UTC and TAI, it is
+   applied in the same pass through the array. */
             case AST__TAITOTT:
-               if ( forward ) {
-                  for ( point = 0; point < npoint; point++ ) {
-                     if ( time[ point ] != AST__BAD ) {
-                        time[ point ] += (TTOFF/SPD);
-                     }
-                  }
-               } else {
-                  for ( point = 0; point < npoint; point++ ) {
-                     if ( time[ point ] != AST__BAD ) {
-                        time[ point ] -= (TTOFF/SPD);
-                     }
-                  }
-               }
-               break;
-
-/* TT to TAI. */
-/* ---------- */
             case AST__TTTOTAI:
-               if ( forward ) {
-                  for ( point = 0; point < npoint; point++ ) {
-                     if ( time[ point ] != AST__BAD ) {
-                        time[ point ] -= (TTOFF/SPD);
-                     }
-                  }
+               shift = ( ( ct == AST__TAITOTT ) == ( forward != 0 ) ) ?
+                       (TTOFF/SPD) : -(TTOFF/SPD);
+               next = ( cvt + inc != end ) ? map->cvttype[ cvt + inc ] :
+                                             AST__TIME_NULL;
+               if( next == AST__TAITOUTC || next == AST__UTCTOTAI ) {
+                  cvt += inc;
+                  DatArray( leaps, npoint, time, map->cvtargs[ cvt ][ 0 ],
+                            ( next == AST__UTCTOTAI ) == ( forward != 0 ),
+                            shift, 0.0, status );
                } else {
                   for ( point = 0; point < npoint; point++ ) {
                      if ( time[ point ] != AST__BAD ) {
-                        time[ point ] += (TTOFF/SPD);
+                        time[ point ] += shift;
                      }
                   }
                }
@@ -4025,7 +4285,7 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                      if ( time[ point ] != AST__BAD ) {
                         tt = time[ point ] + args[ 0 ];
                         tai = tt - (TTOFF/SPD);
-                        utc = tai + astDat( tai, 0 )/SPD;
+                        utc = tai + LeapDat( leaps, tai, 0, &hint, status )/SPD;
                         time[ point ] += Rcc( tt, utc, args[ 1 ], args[ 4 ],
                                               args[ 5 ], status )/SPD;
                      }
@@ -4035,7 +4295,7 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                      if ( time[ point ] != AST__BAD ) {
                         tdb = time[ point ] + args[ 0 ];
                         tai = tdb - (TTOFF/SPD);
-                        utc = tai + astDat( tai, 0 )/SPD;
+                        utc = tai + LeapDat( leaps, tai, 0, &hint, status )/SPD;
                         time[ point ] -= Rcc( tdb, utc, args[ 1 ], args[ 4 ],
                                                 args[ 5 ], status )/SPD;
                      }
@@ -4053,7 +4313,7 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                      if ( time[ point ] != AST__BAD ) {
                         tdb = time[ point ] + args[ 0 ];
                         tai = tdb - (TTOFF/SPD);
-                        utc = tai + astDat( tai, 0 )/SPD;
+                        utc = tai + LeapDat( leaps, tai, 0, &hint, status )/SPD;
                         time[ point ] -= Rcc( tdb, utc, args[ 1 ], args[ 4 ],
                                                 args[ 5 ], status )/SPD;
                      }
@@ -4063,7 +4323,7 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
                      if ( time[ point ] != AST__BAD ) {
                         tt = time[ point ] + args[ 0 ];
                         tai = tt - (TTOFF/SPD);
-                        utc = tai + astDat( tai, 0 )/SPD;
+                        utc = tai + LeapDat( leaps, tai, 0, &hint, status )/SPD;
                         time[ point ] += Rcc( tt, utc, args[ 1 ], args[ 4 ],
                                               args[ 5 ], status )/SPD;
                      }
@@ -4356,6 +4616,9 @@ static AstPointSet *Transform( AstMapping *this, AstPointSet *in,
 
          }
       }
+
+/* Release the table of TAI-UTC expressions. */
+      leaps = FreeLeapTable( leaps, status );
    }
 
 /* If an error has occurred and a new PointSet may have been created, then
@@ -62,6 +62,10 @@
 *           Validate class membership.
 *        astInitTimeMap
 *           Initialise an TimeMap.
+*        astDat
+*           Return TAI-UTC or UTC-TAI at a given epoch.
+*        astLeapSeconds
+*           Read a table of leap seconds from a file.
 *        astLoadTimeMap
 *           Load an TimeMap.
 
@@ -111,6 +115,8 @@
 *  History:
 *     24-MAY-2005 (DSB):
 *        Original version.
+*     16-OCT-2026 (DSB):
+*        Added protected function astLeapSeconds.
 *-
 */
 
@@ -224,6 +230,7 @@ void astTimeAdd_( AstTimeMap *, const char *, const double[], int * );
 
 #if defined(astCLASS)            /* Protected. */
 double astDat_( double, int, int * );
+int astLeapSeconds_( const char *, int * );
 #endif
 
 /* Function interfaces. */
@@ -276,6 +283,7 @@ astINVOKE(V,astTimeAdd_(astCheckTimeMap(this),cvt,args,STATUS_PTR))
 
 #if defined(astCLASS)            /* Protected */
 #define astDat(in,forward) astDat_(in,forward,STATUS_PTR)
+#define astLeapSeconds(file) astLeapSeconds_(file,STATUS_PTR)
 #endif
 #endif
 
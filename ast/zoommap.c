@@ -70,6 +70,8 @@ f     The ZoomMap class does not define any new routines beyond those
 *        method.
 *     10-MAY-2006 (DSB):
 *        Override astEqual.
+*     16-OCT-2026 (DSB):
+*        Declare typed access functions for the Zoom attribute.
 *class--
 */
 
@@ -451,6 +453,13 @@ static int GetIsLinear( AstMapping *this_mapping, int *status ){
    return 1;
 }
 
+/* Typed access functions for the attributes declared in
+   astInitZoomMapVtab. */
+astMAKE_ATTRIBGET(ZoomMap,Zoom,double)
+astMAKE_ATTRIBSET(ZoomMap,Zoom,double)
+astMAKE_ATTRIBTEST(ZoomMap,Zoom)
+astMAKE_ATTRIBCLEAR(ZoomMap,Zoom)
+
 void astInitZoomMapVtab_(  AstZoomMapVtab *vtab, const char *name, int *status ) {
 /*
 *+
@@ -547,6 +556,10 @@ void astInitZoomMapVtab_(  AstZoomMapVtab *vtab, const char *name, int *status )
    destructor. */
    astSetDump( vtab, Dump, "ZoomMap", "Zoom about the origin" );
 
+/* Declare typed access functions for the Zoom attribute. */
+   astDeclareAttribD( vtab, "zoom", GetZoomAttrib, SetZoomAttrib,
+                      TestZoomAttrib, ClearZoomAttrib );
+
 /* If we have just initialised the vtab for the current class, indicate
    that the vtab is now initialised, and store a pointer to the class
    identifier in the base "object" level of the vtab. */
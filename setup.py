@@ -43,10 +43,12 @@ ast_c = ('axis.c', 'box.c', 'channel.c', 'circle.c', 'cmpframe.c',
          'matrixmap.c', 'memory.c', 'normmap.c', 'nullregion.c',
          'object.c', 'palwrap.c', 'pcdmap.c', 'permmap.c', 'plot.c',
          'pointlist.c', 'pointset.c', 'polygon.c', 'polymap.c',
-         'prism.c', 'proj.c', 'ratemap.c', 'region.c', 'shiftmap.c',
+         'prism.c', 'proj.c', 'ratemap.c', 'region.c', 'resampleplan.c',
+         'shiftmap.c',
          'skyaxis.c', 'skyframe.c', 'specfluxframe.c', 'specframe.c',
-         'sphmap.c', 'stcschan.c', 'timeframe.c', 'timemap.c', 'tpn.c',
-         'tranmap.c', 'unit.c', 'unitmap.c', 'wcsmap.c', 'wcstrig.c',
+         'sphmap.c', 'stcschan.c', 'threads.c', 'timeframe.c',
+         'timemap.c', 'tpn.c', 'tranmap.c', 'unit.c', 'unitmap.c',
+         'wcsmap.c', 'wcstrig.c',
          'winmap.c', 'xml.c', 'zoommap.c')
 
 #  List the erfa source files required by AST.
@@ -135,10 +137,19 @@ define_macros.append(('SIZEOF_LONG_LONG', ctypes.sizeof(ctypes.c_longlong)))
 # configure would test for these but we no longer run configure
 define_macros.append(('HAVE_DECL_ISNAN', '1'))
 
+# Build a thread-safe AST so that the GIL can be released while
+# expensive AST functions are running. This requires pthreads, so is
+# not done on Windows.
+libraries = []
+if not sys.platform.startswith("win"):
+    define_macros.append(('THREAD_SAFE', '1'))
+    libraries.append('pthread')
+
 #  Create the description of the starlink.Ast module.
 Ast = Extension('starlink.Ast',
                 include_dirs=include_dirs,
                 define_macros=define_macros,
+                libraries=libraries,
                 sources=sources)
 
 # OSX needs to hide all the normal AST symbols to prevent
@@ -4,6 +4,11 @@
 #include "ast.h"
 #include "grf.h"
 
+#if defined(THREAD_SAFE)
+#include <pthread.h>
+#include <stdlib.h>
+#endif
+
 /* Define macros for things that changed between Python V2.7 and V3.2 */
 #if PY_MAJOR_VERSION >= 3
 #define PYTYPEOBJECT_HEAD PyVarObject_HEAD_INIT(NULL,0)
@@ -38,6 +43,11 @@ static PyObject *pyast_module = NULL;
 static PyArrayObject *GetArray( PyObject *object, int type, int append, int ndim, int *dims, const char *arg, const char *fun );
 static PyArrayObject *GetArray1D( PyObject *object, int *dim, const char *arg, const char *fun );
 static PyArrayObject *GetArray1I( PyObject *object, int *dim, const char *arg, const char *fun );
+static PyArrayObject *GetArray1K( PyObject *object, int *dim, const char *arg, const char *fun );
+static PyArrayObject *GetCoordArray( PyObject *object, int writeable, int *dims, npy_intp *cstride, npy_intp *pstride, const char *arg, const char *fun );
+static int CheckArrayDims( PyArrayObject *array, int append, int ndim, int *dims, const char *arg, const char *fun );
+static void CopyCoords( int npoint, int ncoord, const char *in, int in_type, npy_intp in_cstride, npy_intp in_pstride, char *out, int out_type, npy_intp out_cstride, npy_intp out_pstride );
+static void TranCoords( AstMapping *this, int npoint, int ncoord_in, const char *in, int in_type, npy_intp in_cstride, npy_intp in_pstride, int forward, int ncoord_out, char *out, int out_type, npy_intp out_cstride, npy_intp out_pstride );
 static PyObject *PyAst_FromString( const char *string );
 static char *DumpToString( AstObject *object, const char *options );
 static char *GetString( void *mem, PyObject *value );
@@ -140,6 +150,35 @@ static PyTypeObject *GetType( AstObject *this );
 static int SetProxy( AstObject *this, Object *self );
 static void Object_dealloc( Object *self );
 
+#if defined(THREAD_SAFE)
+
+/* Each Python thread has a list of the AST Objects that it has locked
+   on behalf of the method it is currently executing. The AST macro locks
+   an Object (waiting for any other thread to unlock it first) and adds
+   it to the list, and TIDY unlocks all the Objects in the list before
+   the method returns. So an AST Object is only locked by a thread while
+   a method is using it, and can be used by any Python thread. */
+typedef struct LockList {
+   AstObject **objects;     /* Identifiers for the locked AST Objects */
+   int nobject;             /* Number of AST Objects in the list */
+   int mxobject;            /* Size of the "objects" array */
+   int hold;                /* Number of active Python callbacks */
+} LockList;
+
+static pthread_key_t lock_list_key;
+static pthread_once_t lock_list_once = PTHREAD_ONCE_INIT;
+static int lock_list_ok = 0;
+
+static AstObject *LockObject( Object *self );
+static LockList *GetLockList( int create );
+static int ListObject( AstObject *this );
+static void CreateLockListKey( void );
+static void ForgetObject( AstObject *this );
+static void FreeLockList( void *data );
+static void HoldLocks( int delta );
+static void UnlockObjects( void );
+#endif
+
 /* Class membership functions (probably not needed, but just in case).
 These are functions of the base Object class since it should be possible
 to test an object of any sub-class for membership of any other sub-class. */
@@ -175,6 +214,7 @@ MAKE_ISA(PolyMap)
 MAKE_ISA(Prism)
 MAKE_ISA(RateMap)
 MAKE_ISA(Region)
+MAKE_ISA(ResamplePlan)
 MAKE_ISA(ShiftMap)
 MAKE_ISA(SkyFrame)
 MAKE_ISA(SpecFluxFrame)
@@ -224,6 +264,7 @@ static PyMethodDef Object_methods[] = {
    DEF_ISA(Prism,prism),
    DEF_ISA(RateMap,ratemap),
    DEF_ISA(Region,region),
+   DEF_ISA(ResamplePlan,resampleplan),
    DEF_ISA(ShiftMap,shiftmap),
    DEF_ISA(SkyFrame,skyframe),
    DEF_ISA(SpecFluxFrame,specfluxframe),
@@ -337,10 +378,11 @@ static PyObject *Object_copy( Object *self ) {
          module can also be used to create a deep copy of a PyAST object. */
 
    PyObject *result = NULL;
-   AstObject *new = astCopy( THIS );
+   AstObject *new;
 
    if( PyErr_Occurred() ) return NULL;
 
+   new = astCopy( THIS );
    if( astOK ) {
       result = NewObject( new );
       new = astAnnul( new );
@@ -350,12 +392,31 @@ static PyObject *Object_copy( Object *self ) {
 }
 
 static void Object_dealloc( Object *self ) {
-   if( THIS ) {
-      astSetProxy( THIS, NULL );
-      LTHIS = astAnnul( THIS );
+
+/* The Python Object may be deleted while a method is running (e.g. by
+   the garbage collector), so do not use TIDY here since that would
+   unlock the AST Objects still in use by the method. Clear any error
+   status first so that the proxy pointer is always cleared. */
+   astClearStatus;
+   if( LTHIS ) {
+
+/* The AST Object may be in use by another thread, so lock it (waiting
+   with the GIL released if necessary) before clearing its proxy
+   pointer. Then unlock it again before annulling the identifier, so
+   that anything else that refers to the AST Object can still be used
+   by other threads. */
+#if defined(THREAD_SAFE)
+      LockObject( self );
+      ForgetObject( LTHIS );
+#endif
+      astSetProxy( LTHIS, NULL );
+#if defined(THREAD_SAFE)
+      astUnlock( LTHIS, 0 );
+#endif
+      LTHIS = astAnnul( LTHIS );
    }
    Py_TYPE(self)->tp_free((PyObject*)self);
-   TIDY;
+   astClearStatus;
 }
 
 static PyObject *Object_repr( PyObject *self ) {
@@ -448,11 +509,24 @@ static PyObject *Object_lock( Object *self, PyObject *args ) {
 
 /* args: :wait=True */
 
+   AstObject *this;
    PyObject *result = NULL;
    int wait = 1;
    if( PyErr_Occurred() ) return NULL;
    if( PyArg_ParseTuple( args, "|i:" NAME, &wait ) ) {
-      astLock( THIS, wait );
+
+/* Release the GIL while waiting, since the thread that has the Object
+   locked may itself need the GIL before it can unlock the Object. Use
+   the identifier directly, rather than THIS, and ensure the Object is
+   not in the list of Objects that TIDY will unlock, so that it remains
+   locked until Object.unlock is called. */
+      this = LTHIS;
+      BEGIN_THREADS
+      astLock( this, wait );
+      END_THREADS
+#if defined(THREAD_SAFE)
+      ForgetObject( this );
+#endif
       if( astOK ) {
          Py_INCREF(Py_None);
          result = Py_None;
@@ -545,7 +619,10 @@ static PyObject *Object_unlock( Object *self, PyObject *args ) {
    int report = 1;
    if( PyErr_Occurred() ) return NULL;
    if( PyArg_ParseTuple( args, "|i:" NAME, &report ) ) {
-      astUnlock( THIS, report );
+#if defined(THREAD_SAFE)
+      ForgetObject( LTHIS );
+#endif
+      astUnlock( LTHIS, report );
       if( astOK ) {
          Py_INCREF(Py_None);
          result = Py_None;
@@ -580,6 +657,7 @@ static PyObject *Mapping_rate( Mapping *self, PyObject *args );
 static PyObject *Mapping_rebin( Mapping *self, PyObject *args );
 static PyObject *Mapping_rebinseq( Mapping *self, PyObject *args );
 static PyObject *Mapping_resample( Mapping *self, PyObject *args );
+static PyObject *Mapping_resampletiled( Mapping *self, PyObject *args );
 static PyObject *Mapping_removeregions( Mapping *self );
 static PyObject *Mapping_simplify( Mapping *self );
 static PyObject *Mapping_trangrid( Mapping *self, PyObject *args );
@@ -597,6 +675,7 @@ static PyMethodDef Mapping_methods[] = {
    {"rebin", (PyCFunction)Mapping_rebin, METH_VARARGS, "Rebin a region of a data grid"},
    {"rebinseq", (PyCFunction)Mapping_rebinseq, METH_VARARGS, "Rebin a region of a sequence of data grids"},
    {"resample", (PyCFunction)Mapping_resample, METH_VARARGS, "Resample a region of a data grid"},
+   {"resampletiled", (PyCFunction)Mapping_resampletiled, METH_VARARGS, "Resample a region of a data grid obtained one tile at a time"},
    {"removeregions", (PyCFunction)Mapping_removeregions, METH_NOARGS, "Remove any Regions from a Mapping"},
    {"simplify", (PyCFunction)Mapping_simplify, METH_NOARGS, "Simplify a Mapping"},
    {"tran", (PyCFunction)Mapping_tran, METH_VARARGS, "Transform 1, 2, or N-dimensional coordinates"},
@@ -939,6 +1018,7 @@ static PyObject *Mapping_rebin( Mapping *self, PyObject *args ) {
 
 /* args: out,out_var:wlim,lbnd_in,ubnd_in,in,in_var,spread,params,flags,tol,maxpix,badval_d,lbnd_out,ubnd_out,lbnd,ubnd */
 
+   AstObject *this = NULL;
    PyArrayObject *in = NULL;
    PyArrayObject *in_var = NULL;
    PyArrayObject *lbnd = NULL;
@@ -1048,8 +1128,8 @@ static PyObject *Mapping_rebin( Mapping *self, PyObject *args ) {
                          pbadval, &lbnd_out_object, &ubnd_out_object,
                          &lbnd_object, &ubnd_object ) && pbadval ) {
 
-      lbnd_in = GetArray1I( lbnd_in_object, &ncoord_in, "lbnd_in", NAME );
-      ubnd_in = GetArray1I( ubnd_in_object, &ncoord_in, "ubnd_in", NAME );
+      lbnd_in = GetArray1K( lbnd_in_object, &ncoord_in, "lbnd_in", NAME );
+      ubnd_in = GetArray1K( ubnd_in_object, &ncoord_in, "ubnd_in", NAME );
 
       in = GetArray( in_object, type, 1, ndim, dims, "in", NAME );
       if( in_var_object != Py_None ) {
@@ -1061,17 +1141,17 @@ static PyObject *Mapping_rebin( Mapping *self, PyObject *args ) {
          params = GetArray1D( params_object, &nparam, "params", NAME );
       }
 
-      lbnd_out = GetArray1I( lbnd_out_object, &ncoord_out, "lbnd_out", NAME );
-      ubnd_out = GetArray1I( ubnd_out_object, &ncoord_out, "ubnd_out", NAME );
+      lbnd_out = GetArray1K( lbnd_out_object, &ncoord_out, "lbnd_out", NAME );
+      ubnd_out = GetArray1K( ubnd_out_object, &ncoord_out, "ubnd_out", NAME );
 
-      lbnd = GetArray1I( lbnd_object, &ncoord_in, "lbnd", NAME );
-      ubnd = GetArray1I( ubnd_object, &ncoord_in, "ubnd", NAME );
+      lbnd = GetArray1K( lbnd_object, &ncoord_in, "lbnd", NAME );
+      ubnd = GetArray1K( ubnd_object, &ncoord_in, "ubnd", NAME );
 
       if( lbnd_in && ubnd_in && lbnd_out && ubnd_out && lbnd && ubnd && in ) {
 
          j = ncoord_out - 1;
          for( i = 0; i < ncoord_out; i++,j-- ) {
-            pdims_out[ j ] = ((const int *)ubnd_out->data)[ i ] - ((const int *)lbnd_out->data)[ i ] + 1;
+            pdims_out[ j ] = ((const int64_t *)ubnd_out->data)[ i ] - ((const int64_t *)lbnd_out->data)[ i ] + 1;
          }
 
          out = (PyArrayObject *) PyArray_SimpleNew( ncoord_out, pdims_out, type );
@@ -1080,37 +1160,40 @@ static PyObject *Mapping_rebin( Mapping *self, PyObject *args ) {
 
          if( out && ( ( in_var && out_var ) || !in_var ) ) {
 
+            this = THIS;
+            BEGIN_THREADS
             if( type == PyArray_DOUBLE ) {
-               astRebinD( THIS, wlim, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const double *)in->data,
-                          (in_var ? (const double *)in_var->data : NULL),
-                          spread, (params ? (const double *)params->data : NULL),
-                          flags, tol, maxpix, badval_d, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
-                          (double *)out->data,
-                          (out_var ? (double *)out_var->data : NULL ) );
+               astRebin8D( this, wlim, ncoord_in, (const int64_t *)lbnd_in->data,
+                           (const int64_t *)ubnd_in->data, (const double *)in->data,
+                           (in_var ? (const double *)in_var->data : NULL),
+                           spread, (params ? (const double *)params->data : NULL),
+                           flags, tol, maxpix, badval_d, ncoord_out,
+                           (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                           (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
+                           (double *)out->data,
+                           (out_var ? (double *)out_var->data : NULL ) );
             } else if( type == PyArray_FLOAT ) {
-               astRebinF( THIS, wlim, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const float *)in->data,
-                          (in_var ? (const float *)in_var->data : NULL),
-                          spread, (params ? (const double *)params->data : NULL),
-                          flags, tol, maxpix, badval_f, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
-                          (float *)out->data,
-                          (out_var ? (float *)out_var->data : NULL ) );
+               astRebin8F( this, wlim, ncoord_in, (const int64_t *)lbnd_in->data,
+                           (const int64_t *)ubnd_in->data, (const float *)in->data,
+                           (in_var ? (const float *)in_var->data : NULL),
+                           spread, (params ? (const double *)params->data : NULL),
+                           flags, tol, maxpix, badval_f, ncoord_out,
+                           (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                           (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
+                           (float *)out->data,
+                           (out_var ? (float *)out_var->data : NULL ) );
             } else {
-               astRebinI( THIS, wlim, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const int *)in->data,
-                          (in_var ? (const int *)in_var->data : NULL),
-                          spread, (params ? (const double *)params->data : NULL),
-                          flags, tol, maxpix, badval_i, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
-                          (int *)out->data,
-                          (out_var ? (int *)out_var->data : NULL ) );
+               astRebin8I( this, wlim, ncoord_in, (const int64_t *)lbnd_in->data,
+                           (const int64_t *)ubnd_in->data, (const int *)in->data,
+                           (in_var ? (const int *)in_var->data : NULL),
+                           spread, (params ? (const double *)params->data : NULL),
+                           flags, tol, maxpix, badval_i, ncoord_out,
+                           (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                           (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
+                           (int *)out->data,
+                           (out_var ? (int *)out_var->data : NULL ) );
             }
+            END_THREADS
 
             if( astOK ) {
                if( !out_var ) out_var = (PyArrayObject *) Py_None;
@@ -1142,6 +1225,7 @@ static PyObject *Mapping_rebinseq( Mapping *self, PyObject *args ) {
 
 /* args: nused:wlim,lbnd_in,ubnd_in,in,in_var,spread,params,flags,tol,maxpix,badval_d,lbnd_out,ubnd_out,lbnd,ubnd,out,out_var,weights,nused */
 
+   AstObject *this = NULL;
    PyArrayObject *in = NULL;
    PyArrayObject *in_var = NULL;
    PyArrayObject *lbnd = NULL;
@@ -1318,8 +1402,10 @@ static PyObject *Mapping_rebinseq( Mapping *self, PyObject *args ) {
           in && out && weights ) {
          nused = lnused;
 
+         this = THIS;
+         BEGIN_THREADS
          if( type == PyArray_DOUBLE ) {
-            astRebinSeqD( THIS, wlim, ncoord_in, (const int *)lbnd_in->data,
+            astRebinSeqD( this, wlim, ncoord_in, (const int *)lbnd_in->data,
                        (const int *)ubnd_in->data, (const double *)in->data,
                        (in_var ? (const double *)in_var->data : NULL),
                        spread, (params ? (const double *)params->data : NULL),
@@ -1331,7 +1417,7 @@ static PyObject *Mapping_rebinseq( Mapping *self, PyObject *args ) {
                        (double *)weights->data, &nused );
 
          } else if( type == PyArray_FLOAT ) {
-            astRebinSeqF( THIS, wlim, ncoord_in, (const int *)lbnd_in->data,
+            astRebinSeqF( this, wlim, ncoord_in, (const int *)lbnd_in->data,
                        (const int *)ubnd_in->data, (const float *)in->data,
                        (in_var ? (const float *)in_var->data : NULL),
                        spread, (params ? (const double *)params->data : NULL),
@@ -1342,7 +1428,7 @@ static PyObject *Mapping_rebinseq( Mapping *self, PyObject *args ) {
                        (out_var ? (float *)out_var->data : NULL ),
                        (double *)weights->data, &nused );
          } else {
-            astRebinSeqI( THIS, wlim, ncoord_in, (const int *)lbnd_in->data,
+            astRebinSeqI( this, wlim, ncoord_in, (const int *)lbnd_in->data,
                        (const int *)ubnd_in->data, (const int *)in->data,
                        (in_var ? (const int *)in_var->data : NULL),
                        spread, (params ? (const double *)params->data : NULL),
@@ -1353,6 +1439,7 @@ static PyObject *Mapping_rebinseq( Mapping *self, PyObject *args ) {
                        (out_var ? (int *)out_var->data : NULL ),
                        (double *)weights->data, &nused );
          }
+         END_THREADS
 
          if( astOK ) {
             if( !out_var ) out_var = (PyArrayObject *) Py_None;
@@ -1386,6 +1473,7 @@ static PyObject *Mapping_resample( Mapping *self, PyObject *args ) {
 /* Note: There is no "finterp" argument, and the AST__UKERN1 and AST__UINTERP
          interpolation schemes are not supported in PyAST. */
 
+   AstObject *this = NULL;
    PyArrayObject *in = NULL;
    PyArrayObject *in_var = NULL;
    PyArrayObject *lbnd = NULL;
@@ -1413,6 +1501,7 @@ static PyObject *Mapping_resample( Mapping *self, PyObject *args ) {
    double badval_d;
    double tol;
    float badval_f;
+   int badtype = 0;
    int badval_i;
    long badval_l;
    int dims[ MXDIM ];
@@ -1424,9 +1513,9 @@ static PyObject *Mapping_resample( Mapping *self, PyObject *args ) {
    int ncoord_in;
    int ncoord_out;
    int ndim = 0;
-   int noutpix = 0;
    int nparam;
    int type = 0;
+   int64_t noutpix = 0;
    npy_intp pdims_out[MXDIM];
    npy_intp *pdims = NULL;
    short int badval_h;
@@ -1516,8 +1605,8 @@ static PyObject *Mapping_resample( Mapping *self, PyObject *args ) {
                          pbadval, &lbnd_out_object, &ubnd_out_object,
                          &lbnd_object, &ubnd_object ) && pbadval ) {
 
-      lbnd_in = GetArray1I( lbnd_in_object, &ncoord_in, "lbnd_in", NAME );
-      ubnd_in = GetArray1I( ubnd_in_object, &ncoord_in, "ubnd_in", NAME );
+      lbnd_in = GetArray1K( lbnd_in_object, &ncoord_in, "lbnd_in", NAME );
+      ubnd_in = GetArray1K( ubnd_in_object, &ncoord_in, "ubnd_in", NAME );
 
       in = GetArray( in_object, type, 1, ndim, dims, "in", NAME );
       if( in_var_object != Py_None ) {
@@ -1529,17 +1618,17 @@ static PyObject *Mapping_resample( Mapping *self, PyObject *args ) {
          params = GetArray1D( params_object, &nparam, "params", NAME );
       }
 
-      lbnd_out = GetArray1I( lbnd_out_object, &ncoord_out, "lbnd_out", NAME );
-      ubnd_out = GetArray1I( ubnd_out_object, &ncoord_out, "ubnd_out", NAME );
+      lbnd_out = GetArray1K( lbnd_out_object, &ncoord_out, "lbnd_out", NAME );
+      ubnd_out = GetArray1K( ubnd_out_object, &ncoord_out, "ubnd_out", NAME );
 
-      lbnd = GetArray1I( lbnd_object, &ncoord_in, "lbnd", NAME );
-      ubnd = GetArray1I( ubnd_object, &ncoord_in, "ubnd", NAME );
+      lbnd = GetArray1K( lbnd_object, &ncoord_in, "lbnd", NAME );
+      ubnd = GetArray1K( ubnd_object, &ncoord_in, "ubnd", NAME );
 
       if( lbnd_in && ubnd_in && lbnd_out && ubnd_out && lbnd && ubnd && in ) {
 
          j = ncoord_out - 1;
          for( i = 0; i < ncoord_out; i++,j-- ) {
-            pdims_out[ j ] = ((const int *)ubnd_out->data)[ i ] - ((const int *)lbnd_out->data)[ i ] + 1;
+            pdims_out[ j ] = ((const int64_t *)ubnd_out->data)[ i ] - ((const int64_t *)lbnd_out->data)[ i ] + 1;
          }
 
          out = (PyArrayObject *) PyArray_SimpleNew( ncoord_out, pdims_out, type );
@@ -1547,105 +1636,110 @@ static PyObject *Mapping_resample( Mapping *self, PyObject *args ) {
                                                                  pdims_out, type );
          if( out && ( ( in_var && out_var ) || !in_var ) ) {
 
+            this = THIS;
+            BEGIN_THREADS
             if( type == PyArray_DOUBLE ) {
-               noutpix = astResampleD( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const double *)in->data,
+               noutpix = astResample8D( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const double *)in->data,
                           (in_var ? (const double *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_d, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (double *)out->data,
                           (out_var ? (double *)out_var->data : NULL ) );
             } else if( type == PyArray_FLOAT ) {
-               noutpix = astResampleF( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const float *)in->data,
+               noutpix = astResample8F( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const float *)in->data,
                           (in_var ? (const float *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_f, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (float *)out->data,
                           (out_var ? (float *)out_var->data : NULL ) );
             } else if( type == PyArray_LONG ) {
-               noutpix = astResampleL( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const long *)in->data,
+               noutpix = astResample8L( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const long *)in->data,
                           (in_var ? (const long *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_f, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (long *)out->data,
                           (out_var ? (long *)out_var->data : NULL ) );
             } else if( type == PyArray_INT ) {
-               noutpix = astResampleI( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const int *)in->data,
+               noutpix = astResample8I( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const int *)in->data,
                           (in_var ? (const int *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_i, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (int *)out->data,
                           (out_var ? (int *)out_var->data : NULL ) );
             } else if( type == PyArray_SHORT ) {
-               noutpix = astResampleS( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const short int *)in->data,
+               noutpix = astResample8S( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const short int *)in->data,
                           (in_var ? (const short int *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_f, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (short int *)out->data,
                           (out_var ? (short int *)out_var->data : NULL ) );
             } else if( type == PyArray_BYTE ) {
-               noutpix = astResampleB( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const signed char *)in->data,
+               noutpix = astResample8B( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const signed char *)in->data,
                           (in_var ? (const signed char *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_f, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (signed char *)out->data,
                           (out_var ? (signed char *)out_var->data : NULL ) );
             } else if( type == PyArray_UINT ) {
-               noutpix = astResampleUI( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const unsigned int *)in->data,
+               noutpix = astResample8UI( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const unsigned int *)in->data,
                           (in_var ? (const unsigned int *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_i, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (unsigned int *)out->data,
                           (out_var ? (unsigned int *)out_var->data : NULL ) );
             } else if( type == PyArray_USHORT ) {
-               noutpix = astResampleUS( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const unsigned short int *)in->data,
+               noutpix = astResample8US( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const unsigned short int *)in->data,
                           (in_var ? (const unsigned short int *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_f, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (unsigned short int *)out->data,
                           (out_var ? (unsigned short int *)out_var->data : NULL ) );
             } else if( type == PyArray_UBYTE ) {
-               noutpix = astResampleUB( THIS, ncoord_in, (const int *)lbnd_in->data,
-                          (const int *)ubnd_in->data, (const unsigned char *)in->data,
+               noutpix = astResample8UB( this, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const unsigned char *)in->data,
                           (in_var ? (const unsigned char *)in_var->data : NULL),
                           interp, NULL, (params ? (const double *)params->data : NULL),
                           flags, tol, maxpix, badval_f, ncoord_out,
-                          (const int *)lbnd_out->data, (const int *)ubnd_out->data,
-                          (const int *)lbnd->data, (const int *)ubnd->data,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
                           (unsigned char *)out->data,
                           (out_var ? (unsigned char *)out_var->data : NULL ) );
             } else {
+               badtype = 1;
+            }
+            END_THREADS
+
+            if( badtype ) {
                PyErr_SetString( PyExc_ValueError, "The 'in' array supplied "
                                 "to " NAME " has a data type that is not "
                                 "supported by " NAME "." );
-            }
-
-            if( astOK ) {
+            } else if( astOK ) {
                if( !out_var ) out_var = (PyArrayObject *) Py_None;
-               result = Py_BuildValue( "iOO", noutpix, out, out_var );
+               result = Py_BuildValue( "LOO", (long long) noutpix, out, out_var );
             }
          }
 
@@ -1667,6 +1761,246 @@ static PyObject *Mapping_resample( Mapping *self, PyObject *args ) {
    return result;
 }
 
+#undef NAME
+#define NAME CLASS ".resampletiled"
+
+/* Data passed to the tile-fetching function used by resampletiled. */
+typedef struct {
+   PyObject *fetch;
+   int type;
+   int usevar;
+} TileFetchData;
+
+/* Tile-fetching function called by astResampleTiled<X>. It invokes the
+   Python callable supplied to resampletiled, passing it the bounds of
+   the tile, and copies the returned array (or the arrays in the returned
+   (data,variance) tuple if variances are being used) into the supplied
+   buffers. Note, the GIL is held throughout since resampletiled does
+   not release it. */
+static void tilefetch_wrapper( void *data, int ndim, const int64_t tlbnd[],
+                               const int64_t tubnd[], void *buf,
+                               void *buf_var, int *status ) {
+   PyArrayObject *array;
+   PyObject *item;
+   PyObject *lbnd;
+   PyObject *pyresult;
+   PyObject *ubnd;
+   TileFetchData *fdata = (TileFetchData *) data;
+   int i;
+   int nitem;
+   npy_intp npix;
+   void *dest;
+
+   if( !astOK ) return;
+
+/* Store the tile bounds in two tuples, and call the Python function. */
+   npix = 1;
+   lbnd = PyTuple_New( ndim );
+   ubnd = PyTuple_New( ndim );
+   for( i = 0; i < ndim && lbnd && ubnd; i++ ) {
+      PyTuple_SET_ITEM( lbnd, i, PyLong_FromLongLong( (long long) tlbnd[ i ] ) );
+      PyTuple_SET_ITEM( ubnd, i, PyLong_FromLongLong( (long long) tubnd[ i ] ) );
+      npix *= tubnd[ i ] - tlbnd[ i ] + 1;
+   }
+   BEGIN_CALLBACK
+   pyresult = ( lbnd && ubnd ) ? PyObject_CallFunctionObjArgs( fdata->fetch,
+                                                   lbnd, ubnd, NULL ) : NULL;
+   END_CALLBACK
+   Py_XDECREF( lbnd );
+   Py_XDECREF( ubnd );
+
+/* If variances are being used, the function should return a (data,
+   variance) tuple. Otherwise it should return a single array. */
+   nitem = fdata->usevar ? 2 : 1;
+   if( pyresult && fdata->usevar && ( !PyTuple_Check( pyresult ) ||
+                                      PyTuple_Size( pyresult ) != 2 ) ) {
+      PyErr_SetString( PyExc_TypeError, "The tile fetching function "
+                       "supplied to " NAME " must return a (data,variance) "
+                       "tuple when the AST__USEVAR flag is set." );
+   }
+
+/* Copy each returned array into the corresponding buffer, checking it
+   holds the right number of values. */
+   for( i = 0; i < nitem && pyresult && !PyErr_Occurred(); i++ ) {
+      item = fdata->usevar ? PyTuple_GET_ITEM( pyresult, i ) : pyresult;
+      dest = i ? buf_var : buf;
+      array = (PyArrayObject *) PyArray_ContiguousFromAny( item, fdata->type,
+                                                           0, 100 );
+      if( array && PyArray_SIZE( array ) != npix ) {
+         PyErr_Format( PyExc_ValueError, "The tile fetching function "
+                       "supplied to " NAME " returned %ld values for a "
+                       "tile containing %ld pixels.",
+                       (long) PyArray_SIZE( array ), (long) npix );
+      } else if( array ) {
+         memcpy( dest, array->data, npix*PyArray_ITEMSIZE( array ) );
+      }
+      Py_XDECREF( array );
+   }
+   Py_XDECREF( pyresult );
+
+/* If a Python exception has been raised, set the AST status so that
+   no further tiles are requested. The Python exception is left in place
+   to be raised by resampletiled. */
+   if( PyErr_Occurred() ) *status = AST__RDERR;
+}
+
+static PyObject *Mapping_resampletiled( Mapping *self, PyObject *args ) {
+
+/* args: result,out,out_var:lbnd_in,ubnd_in,tile,fetch,ncache,interp,params,flags,tol,maxpix,badval_d,lbnd_out,ubnd_out,lbnd,ubnd[,dtype] */
+/* Note: There is no "finterp" argument, and the AST__UKERN1 and AST__UINTERP
+         interpolation schemes are not supported in PyAST. Only double,
+         float and int data are supported. */
+
+   PyArray_Descr *dtype = NULL;
+   PyArrayObject *lbnd = NULL;
+   PyArrayObject *lbnd_in = NULL;
+   PyArrayObject *lbnd_out = NULL;
+   PyArrayObject *out = NULL;
+   PyArrayObject *out_var = NULL;
+   PyArrayObject *params = NULL;
+   PyArrayObject *tile = NULL;
+   PyArrayObject *ubnd = NULL;
+   PyArrayObject *ubnd_in = NULL;
+   PyArrayObject *ubnd_out = NULL;
+   PyObject *fetch_object = NULL;
+   PyObject *lbnd_in_object = NULL;
+   PyObject *lbnd_object = NULL;
+   PyObject *lbnd_out_object = NULL;
+   PyObject *params_object = NULL;
+   PyObject *result = NULL;
+   PyObject *tile_object = NULL;
+   PyObject *ubnd_in_object = NULL;
+   PyObject *ubnd_object = NULL;
+   PyObject *ubnd_out_object = NULL;
+   TileFetchData fdata;
+   double badval_d;
+   double tol;
+   int flags;
+   int i;
+   int interp;
+   int j;
+   int maxpix;
+   int ncache;
+   int ncoord_in;
+   int ncoord_out;
+   int nparam;
+   int64_t noutpix = 0;
+   npy_intp pdims_out[MXDIM];
+
+   if( PyErr_Occurred() ) return NULL;
+
+/* Get the number of inputs and outputs for the Mapping */
+   ncoord_in = astGetI( THIS, "Nin" );
+   ncoord_out = astGetI( THIS, "Nout" );
+
+   if( PyArg_ParseTuple( args, "OOOOiiOididOOOO|O&:" NAME, &lbnd_in_object,
+                         &ubnd_in_object, &tile_object, &fetch_object,
+                         &ncache, &interp, &params_object, &flags, &tol,
+                         &maxpix, &badval_d, &lbnd_out_object,
+                         &ubnd_out_object, &lbnd_object, &ubnd_object,
+                         PyArray_DescrConverter, &dtype ) && astOK ) {
+
+      fdata.fetch = fetch_object;
+      fdata.type = dtype ? dtype->type_num : PyArray_DOUBLE;
+      fdata.usevar = ( flags & AST__USEVAR ) != 0;
+
+      if( !PyCallable_Check( fetch_object ) ) {
+         PyErr_SetString( PyExc_TypeError, "The 'fetch' argument for " NAME
+                          " must be callable" );
+      } else if( fdata.type != PyArray_DOUBLE &&
+                 fdata.type != PyArray_FLOAT &&
+                 fdata.type != PyArray_INT ) {
+         PyErr_SetString( PyExc_ValueError, "The 'dtype' value supplied "
+                          "to " NAME " is not supported by " NAME "." );
+      } else {
+
+         lbnd_in = GetArray1K( lbnd_in_object, &ncoord_in, "lbnd_in", NAME );
+         ubnd_in = GetArray1K( ubnd_in_object, &ncoord_in, "ubnd_in", NAME );
+         tile = GetArray1I( tile_object, &ncoord_in, "tile", NAME );
+
+         if( params_object != Py_None ) {
+            nparam = 0;
+            params = GetArray1D( params_object, &nparam, "params", NAME );
+         }
+
+         lbnd_out = GetArray1K( lbnd_out_object, &ncoord_out, "lbnd_out", NAME );
+         ubnd_out = GetArray1K( ubnd_out_object, &ncoord_out, "ubnd_out", NAME );
+
+         lbnd = GetArray1K( lbnd_object, &ncoord_out, "lbnd", NAME );
+         ubnd = GetArray1K( ubnd_object, &ncoord_out, "ubnd", NAME );
+      }
+
+      if( lbnd_in && ubnd_in && tile && lbnd_out && ubnd_out && lbnd &&
+          ubnd ) {
+
+         j = ncoord_out - 1;
+         for( i = 0; i < ncoord_out; i++,j-- ) {
+            pdims_out[ j ] = ((const int64_t *)ubnd_out->data)[ i ] - ((const int64_t *)lbnd_out->data)[ i ] + 1;
+         }
+
+         out = (PyArrayObject *) PyArray_SimpleNew( ncoord_out, pdims_out,
+                                                    fdata.type );
+         if( fdata.usevar ) out_var = (PyArrayObject *) PyArray_SimpleNew( ncoord_out,
+                                                    pdims_out, fdata.type );
+         if( out && ( out_var || !fdata.usevar ) ) {
+
+            if( fdata.type == PyArray_DOUBLE ) {
+               noutpix = astResampleTiledD( THIS, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const int *)tile->data,
+                          tilefetch_wrapper, &fdata, ncache,
+                          interp, NULL, (params ? (const double *)params->data : NULL),
+                          flags, tol, maxpix, badval_d, ncoord_out,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
+                          (double *)out->data,
+                          (out_var ? (double *)out_var->data : NULL ) );
+            } else if( fdata.type == PyArray_FLOAT ) {
+               noutpix = astResampleTiledF( THIS, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const int *)tile->data,
+                          tilefetch_wrapper, &fdata, ncache,
+                          interp, NULL, (params ? (const double *)params->data : NULL),
+                          flags, tol, maxpix, (float) badval_d, ncoord_out,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
+                          (float *)out->data,
+                          (out_var ? (float *)out_var->data : NULL ) );
+            } else {
+               noutpix = astResampleTiledI( THIS, ncoord_in, (const int64_t *)lbnd_in->data,
+                          (const int64_t *)ubnd_in->data, (const int *)tile->data,
+                          tilefetch_wrapper, &fdata, ncache,
+                          interp, NULL, (params ? (const double *)params->data : NULL),
+                          flags, tol, maxpix, (int) badval_d, ncoord_out,
+                          (const int64_t *)lbnd_out->data, (const int64_t *)ubnd_out->data,
+                          (const int64_t *)lbnd->data, (const int64_t *)ubnd->data,
+                          (int *)out->data,
+                          (out_var ? (int *)out_var->data : NULL ) );
+            }
+
+            if( astOK && !PyErr_Occurred() ) {
+               if( !out_var ) out_var = (PyArrayObject *) Py_None;
+               result = Py_BuildValue( "LOO", (long long) noutpix, out, out_var );
+            }
+         }
+
+         Py_XDECREF( out );
+         if( out_var != (PyArrayObject *) Py_None ) Py_XDECREF( out_var );
+      }
+
+      Py_XDECREF( dtype );
+      Py_XDECREF( lbnd );
+      Py_XDECREF( ubnd );
+      Py_XDECREF( lbnd_in );
+      Py_XDECREF( ubnd_in );
+      Py_XDECREF( lbnd_out );
+      Py_XDECREF( ubnd_out );
+      Py_XDECREF( params );
+      Py_XDECREF( tile );
+   }
+
+   TIDY;
+   return result;
+}
+
 static PyObject *Mapping_removeregions( Mapping *self ) {
 
 /* args: result: */
@@ -1719,35 +2053,49 @@ static PyObject *Mapping_simplify( Mapping *self ) {
 #define NAME CLASS ".trangrid"
 static PyObject *Mapping_trangrid( Mapping *self, PyObject *args ) {
 
-/* args: out:lbnd,ubnd,tol=0,maxpix=50,forward=True */
+/* args: out:lbnd,ubnd,tol=0,maxpix=50,forward=True,out=None */
 /* Note: The "lbnd" and "ubnd" arguments are 1-dimensional numpy arrays of
          integers, or any sequence (lists, tuples, etc.) that can be
 	 converted to a numpy array. The length of these arrays must
 	 equal the number of inputs for the Mapping. The returned value
 	 (out) is a 2-dimensional numpy array holding the mapping output
 	 values at the grid points. */
-
+/* Note: If the "out" argument is supplied, it should be an existing
+         2-dimensional numpy array with shape (nout,npoint), where "npoint"
+         is the number of grid points. The transformed positions are
+         stored in it and a new reference to it is returned. A float64
+         or float32 array is written in place, and need not be contiguous
+         (for instance, it may be the transpose of an (npoint,nout) array). */
+
+   AstObject *this = NULL;
    PyArrayObject *lbnd = NULL;
    PyArrayObject *pout = NULL;
    PyArrayObject *ubnd = NULL;
    PyObject *lbnd_object = NULL;
+   PyObject *out_object = NULL;
    PyObject *result = NULL;
    PyObject *ubnd_object = NULL;
    const int *lb;
    const int *ub;
+   double *work;
    double tol = 0.0;
+   int direct;
+   int dims[ 2 ];
    int forward = 1;
    int i;
    int maxpix = 50;
    int ncoord_in;
    int ncoord_out;
    int outdim;
-   npy_intp dims[2];
+   int type;
+   npy_intp cstride;
+   npy_intp pdims[2];
+   npy_intp pstride;
 
    if( PyErr_Occurred() ) return NULL;
 
-   if( PyArg_ParseTuple( args, "OO|dii:" NAME, &lbnd_object, &ubnd_object,
-                         &tol, &maxpix, &forward ) && astOK ) {
+   if( PyArg_ParseTuple( args, "OO|diiO:" NAME, &lbnd_object, &ubnd_object,
+                         &tol, &maxpix, &forward, &out_object ) && astOK ) {
 
       if( forward ) {
          ncoord_in = astGetI( THIS, "Nin" );
@@ -1768,15 +2116,52 @@ static PyObject *Mapping_trangrid( Mapping *self, PyObject *args ) {
             outdim *= *(ub++) - *(lb++) + 1;
          }
 
-         dims[ 0 ] = ncoord_out;
-         dims[ 1 ] = outdim;
+         if( out_object && out_object != Py_None ) {
+            dims[ 0 ] = ncoord_out;
+            dims[ 1 ] = outdim;
+            pout = GetCoordArray( out_object, 1, dims, &cstride, &pstride,
+                                  "out", NAME );
+         } else {
+            pdims[ 0 ] = ncoord_out;
+            pdims[ 1 ] = outdim;
+            pout = (PyArrayObject *) PyArray_SimpleNew( 2, pdims,
+                                                        PyArray_DOUBLE );
+            cstride = sizeof( double )*outdim;
+            pstride = sizeof( double );
+         }
 
-         pout = (PyArrayObject *) PyArray_SimpleNew( 2, dims, PyArray_DOUBLE );
          if( pout ) {
 
-            astTranGrid( THIS, ncoord_in, (const int *)lbnd->data,
-                         (const int *)ubnd->data, tol, maxpix, forward,
-                         ncoord_out, outdim, (double *) pout->data );
+/* astTranGrid can write straight into a float64 array with adjacent
+   points in adjacent elements. Otherwise, use a work array and then
+   copy the results into the output array. */
+            type = pout->descr->type_num;
+            direct = ( type == PyArray_DOUBLE && pstride == (npy_intp) sizeof( double ) &&
+                       ( ncoord_out == 1 || ( cstride > 0 &&
+                         cstride % (npy_intp) sizeof( double ) == 0 &&
+                         cstride/(npy_intp) sizeof( double ) >= outdim ) ) );
+
+            this = THIS;
+            BEGIN_THREADS
+            if( direct ) {
+               astTranGrid( this, ncoord_in, (const int *)lbnd->data,
+                            (const int *)ubnd->data, tol, maxpix, forward,
+                            ncoord_out, ( ncoord_out == 1 ) ? outdim :
+                            cstride/(npy_intp) sizeof( double ), (double *) pout->data );
+            } else {
+               work = astMalloc( sizeof( double )*ncoord_out*outdim );
+               astTranGrid( this, ncoord_in, (const int *)lbnd->data,
+                            (const int *)ubnd->data, tol, maxpix, forward,
+                            ncoord_out, outdim, work );
+               if( astOK ) {
+                  CopyCoords( outdim, ncoord_out, (const char *) work,
+                              PyArray_DOUBLE, sizeof( double )*outdim,
+                              sizeof( double ), (char *) pout->data, type,
+                              cstride, pstride );
+               }
+               work = astFree( work );
+            }
+            END_THREADS
             if( astOK ) {
                result = (PyObject *) pout;
             } else {
@@ -1813,6 +2198,14 @@ static PyObject *Mapping_tran( Mapping *self, PyObject *args ) {
          a new array with suitable shape is created to store the transformed
 	 positions. In either case, the value returned by the method is a
 	 new reference to the array storing the transformed values. */
+/* Note: Float64 and float32 arrays are used in place for both "in" and
+         "out", without being copied, and need not be contiguous. For
+         instance, the transpose of an (npoint,nin) row-major array, or a
+         slice of a larger array, may be supplied. Float32 values are
+         converted to float64 in blocks of points as they are transformed,
+         and bad values are represented by NaN. Arrays of any other type
+         are copied to a new float64 array. An "out" array that is created
+         by the method is always float64. */
 /* Note: The order of the axes in the returned array is determined by the
          order of the axes in the Mapping. If this Mapping was generated
          by the Ast.Convert method, then the axis order will depend on
@@ -1822,6 +2215,7 @@ static PyObject *Mapping_tran( Mapping *self, PyObject *args ) {
          required for some reason, the Ast.findframe method can be used to
          produce a new FrameSet with the axes in the required order. */
 
+   AstObject *this = NULL;
    PyArrayObject *in = NULL;
    PyArrayObject *out = NULL;
    PyObject *result = NULL;
@@ -1831,6 +2225,10 @@ static PyObject *Mapping_tran( Mapping *self, PyObject *args ) {
    int npoint;
    int ncoord_in;
    int ncoord_out;
+   npy_intp in_cstride;
+   npy_intp in_pstride;
+   npy_intp out_cstride;
+   npy_intp out_pstride;
    npy_intp pdims[2];
    int dims[ 2 ];
    int ndim;
@@ -1848,16 +2246,20 @@ static PyObject *Mapping_tran( Mapping *self, PyObject *args ) {
          ncoord_out = astGetI( THIS, "Nin" );
       }
 
+/* Float64 and float32 arrays are used in place, whatever their strides.
+   Anything else is copied to a contiguous float64 array. */
       dims[ 0 ] = ncoord_in;
       dims[ 1 ] = 0;
-      in = GetArray( in_object, PyArray_DOUBLE, 0, 2, dims, "in", NAME );
+      in = GetCoordArray( in_object, 0, dims, &in_cstride, &in_pstride,
+                          "in", NAME );
 
       if( in ) {
          dims[ 0 ] = ncoord_out;
-         if( out_object ) {
-            out = GetArray( out_object, PyArray_DOUBLE, 0, 2, dims, "out", NAME );
+         if( out_object && out_object != Py_None ) {
+            out = GetCoordArray( out_object, 1, dims, &out_cstride,
+                                 &out_pstride, "out", NAME );
          } else {
-            if( in->nd == 1 ){
+            if( in->nd == 1 && ncoord_out == 1 ){
                ndim = 1;
                pdims[ 0 ] = dims[ 1 ];
             } else {
@@ -1867,14 +2269,27 @@ static PyObject *Mapping_tran( Mapping *self, PyObject *args ) {
             }
             out = (PyArrayObject *) PyArray_SimpleNew( ndim, pdims,
                                                        PyArray_DOUBLE );
+            if( out ) {
+               out_pstride = sizeof( double );
+               out_cstride = ( ndim == 1 ) ? 0 : sizeof( double )*dims[ 1 ];
+            }
          }
       }
 
       if( out ) {
          npoint = dims[ 1 ];
-         astTranN( THIS, npoint, ncoord_in, npoint, (const double *) in->data,
-                   forward, ncoord_out, npoint, (double *) out->data );
-         if( astOK ) result = (PyObject *) out;
+         this = THIS;
+         BEGIN_THREADS
+         TranCoords( (AstMapping *) this, npoint, ncoord_in, (const char *) in->data,
+                     in->descr->type_num, in_cstride, in_pstride, forward,
+                     ncoord_out, (char *) out->data, out->descr->type_num,
+                     out_cstride, out_pstride );
+         END_THREADS
+         if( astOK ) {
+            result = (PyObject *) out;
+         } else {
+            Py_DECREF( out );
+         }
       }
 
       Py_XDECREF( in );
@@ -5525,6 +5940,7 @@ static PyObject *Region_overlap( Region *self, PyObject *args );
 static PyObject *Region_mapregion( Region *self, PyObject *args );
 static PyObject *Region_getregionpoints( Region *self, PyObject *args );
 static PyObject *Region_getregionmesh( Region *self, PyObject *args );
+static PyObject *Region_mask( Region *self, PyObject *args );
 
 /* Define the AST attributes of the class */
 MAKE_GETSETL(Region,Adaptive)
@@ -5553,6 +5969,7 @@ static PyMethodDef Region_methods[] = {
   {"overlap", (PyCFunction)Region_overlap, METH_VARARGS, "Test if two Regions overlap each other"},
   {"getregionpoints", (PyCFunction)Region_getregionpoints, METH_VARARGS, "Get the positions that define a Region"},
   {"getregionmesh", (PyCFunction)Region_getregionmesh, METH_VARARGS, "Get a mesh of points covering a Region"},
+  {"mask", (PyCFunction)Region_mask, METH_VARARGS, "Mask a region of a data grid"},
   {NULL, NULL, 0, NULL}  /* Sentinel */
 };
 
@@ -5806,6 +6223,147 @@ static PyObject *Region_getregionmesh( Region *self, PyObject *args ) {
    return result;
 }
 
+#undef NAME
+#define NAME CLASS ".mask"
+static PyObject *Region_mask( Region *self, PyObject *args ) {
+
+/* args: result,out:map,inside,lbnd,ubnd,in,val */
+/* Note: The supplied "in" array is not modified. Instead, a masked copy
+         of it is returned as "out". Only double, float and int arrays
+         are supported. */
+
+   AstObject *map = NULL;
+   AstObject *this = NULL;
+   Object *other = NULL;
+   PyArrayObject *in = NULL;
+   PyArrayObject *lbnd = NULL;
+   PyArrayObject *out = NULL;
+   PyArrayObject *ubnd = NULL;
+   PyObject *in_object = NULL;
+   PyObject *lbnd_object = NULL;
+   PyObject *map_object = NULL;
+   PyObject *result = NULL;
+   PyObject *ubnd_object = NULL;
+   char buf[200];
+   double val;
+   int dims[ MXDIM ];
+   int i;
+   int inside;
+   int j;
+   int ndim = 0;
+   int type = 0;
+   int64_t extent;
+   int64_t nmasked = 0;
+
+   if( PyErr_Occurred() ) return NULL;
+
+   if( PyArg_ParseTuple( args, "OiOOOd:" NAME, &map_object, &inside,
+                         &lbnd_object, &ubnd_object, &in_object, &val )
+       && astOK ) {
+
+/* The Mapping may be None. */
+      if( map_object != Py_None ) {
+         if( !PyObject_TypeCheck( map_object, &MappingType ) ) {
+            PyErr_SetString( PyExc_TypeError, "The 'map' argument for "
+                             NAME " must be a Mapping or None" );
+         } else {
+            other = (Object *) map_object;
+         }
+      }
+
+/* Get the data type of the input array. */
+      if( !PyErr_Occurred() && !PyArray_Check( in_object ) ) {
+         PyErr_SetString( PyExc_TypeError, "The 'in' argument for " NAME
+                          " must be an array object" );
+      } else if( !PyErr_Occurred() ) {
+         type = ((PyArrayObject*) in_object)->descr->type_num;
+         if( type != PyArray_DOUBLE && type != PyArray_FLOAT &&
+             type != PyArray_INT ) {
+            PyErr_SetString( PyExc_ValueError, "The 'in' array supplied "
+                             "to " NAME " has a data type that is not "
+                             "supported by " NAME "." );
+         }
+      }
+
+/* Get the pixel bounds. The number of pixel axes is given by the length
+   of the "lbnd" array. */
+      if( !PyErr_Occurred() ) {
+         lbnd = GetArray1K( lbnd_object, &ndim, "lbnd", NAME );
+         ubnd = GetArray1K( ubnd_object, &ndim, "ubnd", NAME );
+         if( lbnd && ubnd && ndim > MXDIM ) {
+            sprintf( buf, "The 'lbnd' array supplied to " NAME " has too "
+                     "many (%d) elements (must be no more than %d).",
+                     ndim, MXDIM );
+            PyErr_SetString( PyExc_ValueError, buf );
+         }
+      }
+
+/* Get the array dimensions implied by the pixel bounds. The first
+   pixel axis varies fastest, and so is the last numpy axis. */
+      if( lbnd && ubnd && !PyErr_Occurred() ) {
+         j = ndim - 1;
+         for( i = 0; i < ndim; i++,j-- ) {
+            extent = ((const int64_t *)ubnd->data)[ i ] -
+                     ((const int64_t *)lbnd->data)[ i ] + 1;
+            if( extent < 1 || extent > INT_MAX ) {
+               sprintf( buf, "The 'lbnd' and 'ubnd' arrays supplied to "
+                        NAME " give an invalid extent (%lld) for pixel "
+                        "axis %d (one-based).", (long long) extent, i + 1 );
+               PyErr_SetString( PyExc_ValueError, buf );
+               break;
+            }
+            dims[ j ] = (int) extent;
+         }
+      }
+
+/* Get the input array, checking it has the dimensions implied by the
+   pixel bounds, and a masked copy of it. */
+      if( lbnd && ubnd && !PyErr_Occurred() ) {
+         in = GetArray( in_object, type, 1, ndim, dims, "in", NAME );
+         if( in ) {
+            out = (PyArrayObject *) PyArray_SimpleNew( in->nd,
+                                                       in->dimensions, type );
+         }
+      }
+
+      if( out ) {
+         memcpy( out->data, in->data, PyArray_NBYTES( out ) );
+
+         this = THIS;
+         map = other ? THAT : NULL;
+         BEGIN_THREADS
+         if( type == PyArray_DOUBLE ) {
+            nmasked = astMask8D( this, map, inside, ndim,
+                                 (const int64_t *)lbnd->data,
+                                 (const int64_t *)ubnd->data,
+                                 (double *)out->data, val );
+         } else if( type == PyArray_FLOAT ) {
+            nmasked = astMask8F( this, map, inside, ndim,
+                                 (const int64_t *)lbnd->data,
+                                 (const int64_t *)ubnd->data,
+                                 (float *)out->data, (float) val );
+         } else {
+            nmasked = astMask8I( this, map, inside, ndim,
+                                 (const int64_t *)lbnd->data,
+                                 (const int64_t *)ubnd->data,
+                                 (int *)out->data, (int) val );
+         }
+         END_THREADS
+
+         if( astOK ) result = Py_BuildValue( "LO", (long long) nmasked,
+                                             PyArray_Return( out ) );
+      }
+   }
+
+   Py_XDECREF( lbnd );
+   Py_XDECREF( ubnd );
+   Py_XDECREF( in );
+   Py_XDECREF( out );
+
+   TIDY;
+   return result;
+}
+
 
 /* Box */
 /* === */
@@ -7010,7 +7568,9 @@ static int ChannelFuncs( Channel *self, PyObject *source, PyObject *sink,
 
 const char *source_wrapper( void ){
    Channel *channel = astChannelData;
-   PyObject *pytext = PyObject_CallMethod( channel->source, "astsource", NULL );
+   PyObject *pytext;
+   BEGIN_CALLBACK
+   pytext = PyObject_CallMethod( channel->source, "astsource", NULL );
    if( pytext && pytext != Py_None ) {
       channel->source_line = GetString( channel->source_line, pytext );
       if( !channel->source_line ) {
@@ -7021,13 +7581,17 @@ const char *source_wrapper( void ){
       channel->source_line = astFree( channel->source_line );
    }
    Py_XDECREF(pytext);
+   END_CALLBACK
    return channel->source_line;
 }
 
 void sink_wrapper( const char *text ){
    Channel *channel = astChannelData;
-   PyObject *result = PyObject_CallMethod( channel->sink, "astsink", "s", text );
+   PyObject *result;
+   BEGIN_CALLBACK
+   result = PyObject_CallMethod( channel->sink, "astsink", "s", text );
    Py_XDECREF(result);
+   END_CALLBACK
 }
 
 
@@ -7040,6 +7604,7 @@ void sink_wrapper( const char *text ){
 
 const char *srcseq_wrapper( void ){
    Channel *channel = astChannelData;
+   BEGIN_CALLBACK
    if( channel->src_count < PySequence_Length( channel->source ) ) {
       PyObject *pyitem = PySequence_GetItem( channel->source,
                                           (Py_ssize_t) channel->src_count++ );
@@ -7070,6 +7635,7 @@ const char *srcseq_wrapper( void ){
    } else {
       channel->source_line = astFree( channel->source_line );
    }
+   END_CALLBACK
 
    return channel->source_line;
 }
@@ -7731,7 +8297,7 @@ static PyObject *FitsChan_findfits( FitsChan *self, PyObject *args ) {
    if( PyErr_Occurred() ) return NULL;
 
    if ( PyArg_ParseTuple( args, "s|i:" NAME, &name, &inc ) && astOK ) {
-      char card[ 81 ];
+      char card[ 81 ] = "";
       int found = astFindFits( THIS, name, card, inc );
       if( astOK ) {
          result = Py_BuildValue( "Os", (found ? Py_True : Py_False), card );
@@ -8083,6 +8649,7 @@ static int StcsChan_init( StcsChan *self, PyObject *args, PyObject *kwds ){
 typedef struct {
    Object parent;
    int current_key;
+   AstKeyMapShare *share;
 } KeyMap;
 
 /* Prototypes for class functions */
@@ -8094,10 +8661,16 @@ static PyObject *KeyMap_getiter( PyObject *self );
 static PyObject *KeyMap_next( PyObject *self );
 static PyObject *KeyMap_keys( PyObject *self );
 static int KeyMap_contains( PyObject *self, PyObject *key );
+static PyObject *KeyMap_mapshare( KeyMap *self );
+static PyObject *KeyMap_mapshareget( KeyMap *self, PyObject *args );
+static PyObject *KeyMap_mapsharehaskey( KeyMap *self, PyObject *args );
 
 /* Describe the methods of the class */
 static PyMethodDef KeyMap_methods[] = {
    {"keys", (PyCFunction)KeyMap_keys, METH_NOARGS, "Return all keys in a KeyMap."},
+   {"mapshare", (PyCFunction)KeyMap_mapshare, METH_NOARGS, "Publish a snapshot of a KeyMap for lock-free concurrent reading."},
+   {"mapshareget", (PyCFunction)KeyMap_mapshareget, METH_VARARGS, "Get a floating point value from the published snapshot of a KeyMap."},
+   {"mapsharehaskey", (PyCFunction)KeyMap_mapsharehaskey, METH_VARARGS, "Check if a key is present in the published snapshot of a KeyMap."},
    {NULL, NULL, 0, NULL}  /* Sentinel */
 };
 
@@ -8188,6 +8761,7 @@ static int KeyMap_init( KeyMap *self, PyObject *args, PyObject *kwds ){
 
    if( PyArg_ParseTuple(args, "|s:" CLASS, &options ) ) {
       self->current_key = 0;
+      self->share = NULL;
       AstKeyMap *this = astKeyMap( "%s", options );
       result = SetProxy( (AstObject *) this, (Object *) self );
       this = astAnnul( this );
@@ -8245,6 +8819,78 @@ static PyObject *KeyMap_keys( PyObject *self ) {
    return result;
 }
 
+/* Publish a snapshot of the KeyMap. The AstKeyMapShare is the same for
+   every call, and remains valid for as long as the KeyMap exists. */
+#undef NAME
+#define NAME CLASS ".mapshare"
+static PyObject *KeyMap_mapshare( KeyMap *self ) {
+   PyObject *result = NULL;
+   if( PyErr_Occurred() ) return NULL;
+   self->share = astMapShare( THIS );
+   if( astOK ) {
+      Py_INCREF(Py_None);
+      result = Py_None;
+   }
+   TIDY;
+   return result;
+}
+
+/* Return the value of a key in the published snapshot as a float, or
+   None if the key is not present. The KeyMap need not be locked by the
+   calling thread, and the GIL is released while the snapshot is read. */
+#undef NAME
+#define NAME CLASS ".mapshareget"
+static PyObject *KeyMap_mapshareget( KeyMap *self, PyObject *args ) {
+
+/* args: result:key */
+
+   AstKeyMapShare *share;
+   PyObject *result = NULL;
+   const char *key;
+   double value;
+   int found;
+   if( PyErr_Occurred() ) return NULL;
+   if( PyArg_ParseTuple( args, "s:" NAME, &key ) ) {
+      share = self->share;
+      BEGIN_THREADS
+      found = astMapShareGet0D( share, key, &value );
+      END_THREADS
+      if( astOK ) {
+         if( found ) {
+            result = Py_BuildValue( "d", value );
+         } else {
+            Py_INCREF(Py_None);
+            result = Py_None;
+         }
+      }
+   }
+   TIDY;
+   return result;
+}
+
+/* Return True if a key is present in the published snapshot. */
+#undef NAME
+#define NAME CLASS ".mapsharehaskey"
+static PyObject *KeyMap_mapsharehaskey( KeyMap *self, PyObject *args ) {
+
+/* args: result:key */
+
+   AstKeyMapShare *share;
+   PyObject *result = NULL;
+   const char *key;
+   int found;
+   if( PyErr_Occurred() ) return NULL;
+   if( PyArg_ParseTuple( args, "s:" NAME, &key ) ) {
+      share = self->share;
+      BEGIN_THREADS
+      found = astMapShareHasKey( share, key );
+      END_THREADS
+      if( astOK ) result = Py_BuildValue( "O", (found ? Py_True : Py_False) );
+   }
+   TIDY;
+   return result;
+}
+
 
 /* Methods needed to make a KeyMap behave as a python sequence */
 
@@ -8562,7 +9208,7 @@ static int KeyMap_setitem( PyObject *self, PyObject *index, PyObject *value ){
             AstObject **buf = astCalloc( nval, sizeof( *buf ) );
             if( astOK ) {
                for( ival = 0; ival < nval; ival++ ) {
-                  buf[ ival ] = ((Object *)vals[ ival ])->ast_object;
+                  buf[ ival ] = AST( vals[ ival ] );
                }
                astMapPut1A( THIS, key, nval, buf, NULL );
             }
@@ -9270,6 +9916,7 @@ static PyObject *Plot_text( Plot *self, PyObject *args ) {
 static int ColourToInt( Plot *self, const char *colour ){
    int ret = -1;
 
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       if( PyObject_HasAttrString(self->grf, "ColToInt") ){
          PyObject *result = PyObject_CallMethod( self->grf, "ColToInt", "s", colour );
@@ -9298,6 +9945,7 @@ static int ColourToInt( Plot *self, const char *colour ){
                        "Plot or has no Grf object." );
    }
 
+   END_CALLBACK
    if( PyErr_Occurred() ) ret = -1;
    return ret;
 }
@@ -9311,6 +9959,7 @@ static const char *IntToColour( Plot *self, int colour ){
    static char buf[MAXLENCOL + 1];
    buf[0] = 0;
 
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       if( PyObject_HasAttrString(self->grf, "IntToCol") ){
          PyObject *result = PyObject_CallMethod( self->grf, "IntToCol", "i", colour );
@@ -9340,6 +9989,7 @@ static const char *IntToColour( Plot *self, int colour ){
                        "a colour name since the supplied object is not a "
                        "Plot or has no Grf object." );
    }
+   END_CALLBACK
 
    return ret;
 }
@@ -9428,6 +10078,7 @@ static int Attr_wrapper( AstObject *grfcon, int attr, double value,
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "Attr", "idi",
                                               attr, value, prim );
@@ -9437,6 +10088,7 @@ static int Attr_wrapper( AstObject *grfcon, int attr, double value,
          if( !PyErr_Occurred() ) ret = 1;
       }
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9444,6 +10096,7 @@ static int Cap_wrapper( AstObject *grfcon, int cap, int value ){
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "Cap", "ii", cap, value );
       if( result ) {
@@ -9452,6 +10105,7 @@ static int Cap_wrapper( AstObject *grfcon, int cap, int value ){
          if( PyErr_Occurred() ) ret = 0;
       }
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9459,11 +10113,13 @@ static int BBuf_wrapper( AstObject *grfcon ){
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "BBuf", NULL );
       Py_XDECREF( result );
       if( !PyErr_Occurred() ) ret = 1;
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9471,11 +10127,13 @@ static int EBuf_wrapper( AstObject *grfcon ){
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "EBuf", NULL );
       Py_XDECREF( result );
       if( !PyErr_Occurred() ) ret = 1;
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9483,11 +10141,13 @@ static int Flush_wrapper( AstObject *grfcon ){
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "Flush", NULL );
       Py_XDECREF( result );
       if( !PyErr_Occurred() ) ret = 1;
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9497,6 +10157,7 @@ static int Line_wrapper( AstObject *grfcon, int n, const float *x, const float *
 
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
 
    if( self && self->grf ) {
       dims[ 0 ] = n;
@@ -9520,6 +10181,7 @@ static int Line_wrapper( AstObject *grfcon, int n, const float *x, const float *
          if( !PyErr_Occurred() ) ret = 1;
       }
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9530,6 +10192,7 @@ static int Mark_wrapper( AstObject *grfcon, int n, const float *x, const float *
 
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
 
    if( self && self->grf ) {
       dims[ 0 ] = n;
@@ -9553,6 +10216,7 @@ static int Mark_wrapper( AstObject *grfcon, int n, const float *x, const float *
          if( !PyErr_Occurred() ) ret = 1;
       }
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9560,6 +10224,7 @@ static int Qch_wrapper( AstObject *grfcon, float *chv, float *chh ){
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "Qch", NULL );
       if( result ) {
@@ -9586,6 +10251,7 @@ static int Qch_wrapper( AstObject *grfcon, float *chv, float *chh ){
          if( !PyErr_Occurred() ) ret = 1;
       }
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9593,6 +10259,7 @@ static int Scales_wrapper( AstObject *grfcon, float *alpha, float *beta ){
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "Scales", NULL );
       if( result ) {
@@ -9619,6 +10286,7 @@ static int Scales_wrapper( AstObject *grfcon, float *alpha, float *beta ){
          if( !PyErr_Occurred() ) ret = 1;
       }
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9627,6 +10295,7 @@ static int Text_wrapper( AstObject *grfcon, const char *text, float x, float y,
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
 
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "Text", "sddsdd",
@@ -9635,6 +10304,7 @@ static int Text_wrapper( AstObject *grfcon, const char *text, float x, float y,
       Py_XDECREF( result );
       if( !PyErr_Occurred() ) ret = 1;
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -9643,6 +10313,7 @@ static int TxExt_wrapper( AstObject *grfcon, const char *text, float x, float y,
    int ret = 0;
    Plot *self = NULL;
    astMapGet0P( (AstKeyMap *) grfcon, "SELF", (void **) &self );
+   BEGIN_CALLBACK
 
    if( self && self->grf ) {
       PyObject *result = PyObject_CallMethod( self->grf, "TxExt", "sddsdd",
@@ -9677,6 +10348,7 @@ static int TxExt_wrapper( AstObject *grfcon, const char *text, float x, float y,
          if( !PyErr_Occurred() ) ret = 1;
       }
    }
+   END_CALLBACK
    return ret;
 }
 
@@ -10257,7 +10929,7 @@ static int FitsTable_init( FitsTable *self, PyObject *args, PyObject *kwds ){
    int result = -1;
 
    if( PyArg_ParseTuple(args, "|O!s:" CLASS, &FitsChanType, &header, &options ) ) {
-      AstFitsTable *this = astFitsTable( (header != Py_None) ? LAST(header) : NULL,
+      AstFitsTable *this = astFitsTable( AST(header),
                                          "%s", options );
       result = SetProxy( (AstObject *) this, (Object *) self );
       this = astAnnul( this );
@@ -10350,7 +11022,7 @@ static PyObject *FitsTable_puttableheader( FitsTable *self, PyObject *args ) {
    PyObject *result = NULL;
    if( PyErr_Occurred() ) return NULL;
    if( PyArg_ParseTuple(args, "O!:" NAME, &FitsChanType, &header ) && astOK ) {
-      astPutTableHeader( THIS, LAST(header) );
+      astPutTableHeader( THIS, AST(header) );
       if( astOK ) {
          Py_INCREF(Py_None);
          result = Py_None;
@@ -10360,19 +11032,377 @@ static PyObject *FitsTable_puttableheader( FitsTable *self, PyObject *args ) {
    return result;
 }
 
-/* The following FitsChan wrappers must be here since they refer to
-   FitsTableType which has only just been declared. */
+/* ResamplePlan */
+/* ============ */
 
+/* Define a string holding the fully qualified Python class name. */
 #undef CLASS
-#define CLASS MODULE ".FitsChan"
+#define CLASS MODULE ".ResamplePlan"
 
-#undef NAME
-#define NAME CLASS ".gettables"
-static PyObject *FitsChan_gettables( FitsChan *self ) {
+/* Define the class structure */
+typedef struct {
+   Object parent;
+} ResamplePlan;
 
-/* args: result: */
+/* Prototypes for class functions */
+static int ResamplePlan_init( ResamplePlan *self, PyObject *args, PyObject *kwds );
+static PyObject *ResamplePlan_apply( ResamplePlan *self, PyObject *args );
 
-   PyObject *result = NULL;
+/* Describe the methods of the class */
+static PyMethodDef ResamplePlan_methods[] = {
+   {"apply", (PyCFunction)ResamplePlan_apply, METH_VARARGS, "Resample a grid of data values using a ResamplePlan"},
+   {NULL, NULL, 0, NULL}  /* Sentinel */
+};
+
+/* Define the class Python type structure */
+static PyTypeObject ResamplePlanType = {
+   PYTYPEOBJECT_HEAD
+   CLASS,                     /* tp_name */
+   sizeof(ResamplePlan),      /* tp_basicsize */
+   0,                         /* tp_itemsize */
+   0,                         /* tp_dealloc */
+   0,                         /* tp_print */
+   0,                         /* tp_getattr */
+   0,                         /* tp_setattr */
+   0,                         /* tp_reserved */
+   0,                         /* tp_repr */
+   0,                         /* tp_as_number */
+   0,                         /* tp_as_sequence */
+   0,                         /* tp_as_mapping */
+   0,                         /* tp_hash  */
+   0,                         /* tp_call */
+   0,                         /* tp_str */
+   0,                         /* tp_getattro */
+   0,                         /* tp_setattro */
+   0,                         /* tp_as_buffer */
+   Py_TPFLAGS_DEFAULT|Py_TPFLAGS_BASETYPE, /* tp_flags */
+   "AST ResamplePlan",        /* tp_doc */
+   0,		              /* tp_traverse */
+   0,		              /* tp_clear */
+   0,		              /* tp_richcompare */
+   0,		              /* tp_weaklistoffset */
+   0,		              /* tp_iter */
+   0,		              /* tp_iternext */
+   ResamplePlan_methods,      /* tp_methods */
+   0,                         /* tp_members */
+   0,                         /* tp_getset */
+   0,                         /* tp_base */
+   0,                         /* tp_dict */
+   0,                         /* tp_descr_get */
+   0,                         /* tp_descr_set */
+   0,                         /* tp_dictoffset */
+   (initproc)ResamplePlan_init, /* tp_init */
+   0,                         /* tp_alloc */
+   0,                         /* tp_new */
+};
+
+
+/* Define the class methods */
+static int ResamplePlan_init( ResamplePlan *self, PyObject *args, PyObject *kwds ){
+
+/* args: :map,lbnd_in,ubnd_in,interp,params,tol,maxpix,lbnd_out,ubnd_out,lbnd,ubnd,options=None */
+/* Note: The AST__UKERN1, AST__UINTERP and AST__BLOCKAVE interpolation
+         schemes are not supported. */
+
+   Mapping *other;
+   PyArrayObject *lbnd = NULL;
+   PyArrayObject *lbnd_in = NULL;
+   PyArrayObject *lbnd_out = NULL;
+   PyArrayObject *params = NULL;
+   PyArrayObject *ubnd = NULL;
+   PyArrayObject *ubnd_in = NULL;
+   PyArrayObject *ubnd_out = NULL;
+   PyObject *lbnd_in_object = NULL;
+   PyObject *lbnd_object = NULL;
+   PyObject *lbnd_out_object = NULL;
+   PyObject *params_object = NULL;
+   PyObject *ubnd_in_object = NULL;
+   PyObject *ubnd_object = NULL;
+   PyObject *ubnd_out_object = NULL;
+   const char *options = " ";
+   double tol;
+   int interp;
+   int maxpix;
+   int ncoord_in;
+   int ncoord_out;
+   int nparam;
+   int result = -1;
+
+   if( PyArg_ParseTuple(args, "O!OOiOdiOOOO|s:" CLASS, &MappingType,
+                        (PyObject**)&other, &lbnd_in_object,
+                        &ubnd_in_object, &interp, &params_object, &tol,
+                        &maxpix, &lbnd_out_object, &ubnd_out_object,
+                        &lbnd_object, &ubnd_object, &options ) ) {
+
+      ncoord_in = astGetI( THAT, "Nin" );
+      ncoord_out = astGetI( THAT, "Nout" );
+
+      lbnd_in = GetArray1I( lbnd_in_object, &ncoord_in, "lbnd_in", CLASS );
+      ubnd_in = GetArray1I( ubnd_in_object, &ncoord_in, "ubnd_in", CLASS );
+
+      if( params_object != Py_None ) {
+         nparam = 0;
+         params = GetArray1D( params_object, &nparam, "params", CLASS );
+      }
+
+      lbnd_out = GetArray1I( lbnd_out_object, &ncoord_out, "lbnd_out", CLASS );
+      ubnd_out = GetArray1I( ubnd_out_object, &ncoord_out, "ubnd_out", CLASS );
+
+      lbnd = GetArray1I( lbnd_object, &ncoord_out, "lbnd", CLASS );
+      ubnd = GetArray1I( ubnd_object, &ncoord_out, "ubnd", CLASS );
+
+      if( lbnd_in && ubnd_in && lbnd_out && ubnd_out && lbnd && ubnd ) {
+         AstObject *map = THAT;
+         AstResamplePlan *this = NULL;
+
+         BEGIN_THREADS
+         this = astResamplePlan( map, ncoord_in, (const int *)lbnd_in->data,
+                                 (const int *)ubnd_in->data, interp,
+                                 (params ? (const double *)params->data : NULL),
+                                 tol, maxpix, ncoord_out,
+                                 (const int *)lbnd_out->data,
+                                 (const int *)ubnd_out->data,
+                                 (const int *)lbnd->data,
+                                 (const int *)ubnd->data, "%s", options );
+         END_THREADS
+
+         result = SetProxy( (AstObject *) this, (Object *) self );
+         this = astAnnul( this );
+      }
+
+      Py_XDECREF( lbnd );
+      Py_XDECREF( ubnd );
+      Py_XDECREF( lbnd_in );
+      Py_XDECREF( ubnd_in );
+      Py_XDECREF( lbnd_out );
+      Py_XDECREF( ubnd_out );
+      Py_XDECREF( params );
+   }
+
+   TIDY;
+   return result;
+}
+
+#undef NAME
+#define NAME CLASS ".apply"
+static PyObject *ResamplePlan_apply( ResamplePlan *self, PyObject *args ) {
+
+/* args: result,out,out_var:in,in_var=None,flags=0,badval=0 */
+
+   AstObject *this = NULL;
+   PyArrayObject *in = NULL;
+   PyArrayObject *in_var = NULL;
+   PyArrayObject *out = NULL;
+   PyArrayObject *out_var = NULL;
+   PyObject *in_object = NULL;
+   PyObject *in_var_object = Py_None;
+   PyObject *result = NULL;
+   char badval_b = 0;
+   char buf[200];
+   char format[] = "O|Oid:" NAME;
+   double badval_d = 0.0;
+   float badval_f = 0.0;
+   int badtype = 0;
+   int badval_i = 0;
+   int dims[ MXDIM ];
+   int flags = 0;
+   int i;
+   int j;
+   int lbnd_in[ MXDIM ];
+   int lbnd_out[ MXDIM ];
+   int ndim_in;
+   int ndim_out;
+   int noutpix = 0;
+   int type = 0;
+   int ubnd_in[ MXDIM ];
+   int ubnd_out[ MXDIM ];
+   long badval_l = 0;
+   npy_intp pdims_out[ MXDIM ];
+   short int badval_h = 0;
+   unsigned char badval_B = 0;
+   unsigned int badval_I = 0;
+   unsigned short int badval_H = 0;
+   void *pbadval = NULL;
+
+   if( PyErr_Occurred() ) return NULL;
+
+/* Get the dimensions of the input and output grids. */
+   ndim_in = astPlanBounds( THIS, 1, NULL, NULL );
+   ndim_out = astPlanBounds( THIS, 0, NULL, NULL );
+   if( ndim_in > MXDIM || ndim_out > MXDIM ) {
+      sprintf( buf, "The ResamplePlan supplied to " NAME " has too "
+               "many dimensions (must be no more than %d).", MXDIM );
+      PyErr_SetString( PyExc_ValueError, buf );
+      TIDY;
+      return NULL;
+   }
+   astPlanBounds( THIS, 1, lbnd_in, ubnd_in );
+   astPlanBounds( THIS, 0, lbnd_out, ubnd_out );
+
+/* We do not know yet what format code to use for badval. We need to parse
+   the arguments twice. The first time, we determine the data type from
+   the "in" array. This allows us to choose the correct format code for
+   badval, so we then parse the arguments a second time, using the
+   correct code. */
+   if( PyArg_ParseTuple( args, format, &in_object, &in_var_object, &flags,
+                         &badval_d ) && astOK ) {
+
+      if( !PyArray_Check(  in_object ) ) {
+         PyErr_SetString( PyExc_TypeError, "The 'in' argument for " NAME " must be "
+                          "an array object" );
+      } else {
+
+         type = ((PyArrayObject*) in_object)->descr->type_num;
+         if( type == PyArray_DOUBLE ) {
+            format[ 4 ] = 'd';
+            pbadval = &badval_d;
+         } else if( type == PyArray_FLOAT ) {
+            format[ 4 ] = 'f';
+            pbadval = &badval_f;
+         } else if( type == PyArray_INT ) {
+            format[ 4 ] = 'i';
+            pbadval = &badval_i;
+         } else if( type == PyArray_LONG ) {
+            format[ 4 ] = 'l';
+            pbadval = &badval_l;
+         } else if( type == PyArray_SHORT ) {
+            format[ 4 ] = 'h';
+            pbadval = &badval_h;
+         } else if( type == PyArray_BYTE ) {
+            format[ 4 ] = 'b';
+            pbadval = &badval_b;
+         } else if( type == PyArray_UINT ) {
+            format[ 4 ] = 'I';
+            pbadval = &badval_I;
+         } else if( type == PyArray_USHORT ) {
+            format[ 4 ] = 'H';
+            pbadval = &badval_H;
+         } else if( type == PyArray_UBYTE ) {
+            format[ 4 ] = 'B';
+            pbadval = &badval_B;
+         } else {
+            PyErr_SetString( PyExc_ValueError, "The 'in' array supplied "
+                             "to " NAME " has a data type that is not "
+                             "supported by " NAME "." );
+         }
+      }
+   }
+
+/* Parse the arguments again, this time with the correct code for
+   badval. */
+   if( pbadval && PyArg_ParseTuple( args, format, &in_object,
+                                    &in_var_object, &flags, pbadval ) ) {
+
+/* The input arrays must match the input grid described by the plan.
+   Numpy axes are in the reverse order to AST axes. */
+      j = ndim_in - 1;
+      for( i = 0; i < ndim_in; i++,j-- ) {
+         dims[ j ] = ubnd_in[ i ] - lbnd_in[ i ] + 1;
+      }
+      in = GetArray( in_object, type, 1, ndim_in, dims, "in", NAME );
+      if( in && in_var_object != Py_None ) {
+         in_var = GetArray( in_var_object, type, 1, ndim_in, dims, "in_var", NAME );
+      }
+
+      if( in && ( in_var || in_var_object == Py_None ) ) {
+
+         j = ndim_out - 1;
+         for( i = 0; i < ndim_out; i++,j-- ) {
+            pdims_out[ j ] = ubnd_out[ i ] - lbnd_out[ i ] + 1;
+         }
+
+         out = (PyArrayObject *) PyArray_SimpleNew( ndim_out, pdims_out, type );
+         if( in_var ) out_var = (PyArrayObject *) PyArray_SimpleNew( ndim_out,
+                                                                 pdims_out, type );
+         if( out && ( ( in_var && out_var ) || !in_var ) ) {
+
+            this = THIS;
+            BEGIN_THREADS
+            if( type == PyArray_DOUBLE ) {
+               noutpix = astApplyPlanD( this, (const double *)in->data,
+                          (in_var ? (const double *)in_var->data : NULL),
+                          flags, badval_d, (double *)out->data,
+                          (out_var ? (double *)out_var->data : NULL ) );
+            } else if( type == PyArray_FLOAT ) {
+               noutpix = astApplyPlanF( this, (const float *)in->data,
+                          (in_var ? (const float *)in_var->data : NULL),
+                          flags, badval_f, (float *)out->data,
+                          (out_var ? (float *)out_var->data : NULL ) );
+            } else if( type == PyArray_LONG ) {
+               noutpix = astApplyPlanL( this, (const long *)in->data,
+                          (in_var ? (const long *)in_var->data : NULL),
+                          flags, badval_l, (long *)out->data,
+                          (out_var ? (long *)out_var->data : NULL ) );
+            } else if( type == PyArray_INT ) {
+               noutpix = astApplyPlanI( this, (const int *)in->data,
+                          (in_var ? (const int *)in_var->data : NULL),
+                          flags, badval_i, (int *)out->data,
+                          (out_var ? (int *)out_var->data : NULL ) );
+            } else if( type == PyArray_SHORT ) {
+               noutpix = astApplyPlanS( this, (const short int *)in->data,
+                          (in_var ? (const short int *)in_var->data : NULL),
+                          flags, badval_h, (short int *)out->data,
+                          (out_var ? (short int *)out_var->data : NULL ) );
+            } else if( type == PyArray_BYTE ) {
+               noutpix = astApplyPlanB( this, (const signed char *)in->data,
+                          (in_var ? (const signed char *)in_var->data : NULL),
+                          flags, badval_b, (signed char *)out->data,
+                          (out_var ? (signed char *)out_var->data : NULL ) );
+            } else if( type == PyArray_UINT ) {
+               noutpix = astApplyPlanUI( this, (const unsigned int *)in->data,
+                          (in_var ? (const unsigned int *)in_var->data : NULL),
+                          flags, badval_I, (unsigned int *)out->data,
+                          (out_var ? (unsigned int *)out_var->data : NULL ) );
+            } else if( type == PyArray_USHORT ) {
+               noutpix = astApplyPlanUS( this, (const unsigned short int *)in->data,
+                          (in_var ? (const unsigned short int *)in_var->data : NULL),
+                          flags, badval_H, (unsigned short int *)out->data,
+                          (out_var ? (unsigned short int *)out_var->data : NULL ) );
+            } else if( type == PyArray_UBYTE ) {
+               noutpix = astApplyPlanUB( this, (const unsigned char *)in->data,
+                          (in_var ? (const unsigned char *)in_var->data : NULL),
+                          flags, badval_B, (unsigned char *)out->data,
+                          (out_var ? (unsigned char *)out_var->data : NULL ) );
+            } else {
+               badtype = 1;
+            }
+            END_THREADS
+
+            if( badtype ) {
+               PyErr_SetString( PyExc_ValueError, "The 'in' array supplied "
+                                "to " NAME " has a data type that is not "
+                                "supported by " NAME "." );
+            } else if( astOK ) {
+               if( !out_var ) out_var = (PyArrayObject *) Py_None;
+               result = Py_BuildValue( "iOO", noutpix, out, out_var );
+            }
+         }
+
+         Py_XDECREF( out );
+         if( out_var != (PyArrayObject *) Py_None ) Py_XDECREF( out_var );
+      }
+
+      Py_XDECREF( in );
+      Py_XDECREF( in_var );
+   }
+
+   TIDY;
+   return result;
+}
+
+/* The following FitsChan wrappers must be here since they refer to
+   FitsTableType which has only just been declared. */
+
+#undef CLASS
+#define CLASS MODULE ".FitsChan"
+
+#undef NAME
+#define NAME CLASS ".gettables"
+static PyObject *FitsChan_gettables( FitsChan *self ) {
+
+/* args: result: */
+
+   PyObject *result = NULL;
 
    if( PyErr_Occurred() ) return NULL;
 
@@ -10398,7 +11428,7 @@ static PyObject *FitsChan_puttable( FitsChan  *self, PyObject *args ) {
    if( PyErr_Occurred() ) return NULL;
 
    if( PyArg_ParseTuple(args, "O!s:" NAME, &FitsTableType, &table, &extnam ) && astOK ) {
-      astPutTable( THIS, LAST(table), extnam );
+      astPutTable( THIS, AST(table), extnam );
       if( astOK ) {
          Py_INCREF(Py_None);
          result = Py_None;
@@ -10421,7 +11451,7 @@ static PyObject *FitsChan_puttables( FitsChan  *self, PyObject *args ) {
    if( PyErr_Occurred() ) return NULL;
 
    if( PyArg_ParseTuple(args, "O!:" NAME, &KeyMapType, &tables ) && astOK ) {
-      astPutTables( THIS, LAST(tables) );
+      astPutTables( THIS, AST(tables) );
       if( astOK ) {
          Py_INCREF(Py_None);
          result = Py_None;
@@ -10511,8 +11541,10 @@ static PyObject *FitsChan_tablesource( FitsChan  *self, PyObject *args ) {
 void tabsource_wrapper( AstFitsChan *this, const char *extname,
                         int extver, int extlevel, int *status ) {
    FitsChan *self = astGetProxy( this );
+   BEGIN_CALLBACK
    PyObject_CallMethod( self->tabsource, "asttablesource", "Osii",
                         self, extname, extver, extlevel );
+   END_CALLBACK
    if( PyErr_Occurred() ) *status = AST__NOTAB;
 }
 
@@ -11202,6 +12234,12 @@ MOD_INIT(Ast) {
    Py_INCREF(&FitsTableType);
    PyModule_AddObject( m, "FitsTable", (PyObject *)&FitsTableType);
 
+   ResamplePlanType.tp_new = PyType_GenericNew;
+   ResamplePlanType.tp_base = &ObjectType;
+   if( PyType_Ready(&ResamplePlanType) < 0) RETURN( NULL );
+   Py_INCREF(&ResamplePlanType);
+   PyModule_AddObject( m, "ResamplePlan", (PyObject *)&ResamplePlanType);
+
 /* The constants provided by this module. */
 #define ICONST(Name) \
    PyModule_AddIntConstant( m, #Name, AST__##Name )
@@ -11626,9 +12664,251 @@ static int SetProxy( AstObject *this, Object *self ) {
    if( !astOK ) return -1;
    LTHIS = astClone( this );
    astSetProxy( this, self );
+
+/* The new identifier is owned by the calling thread, so ensure it is
+   unlocked by TIDY. */
+#if defined(THREAD_SAFE)
+   if( astOK ) ListObject( LTHIS );
+#endif
    return astOK ? 0 : -1;
 }
 
+#if defined(THREAD_SAFE)
+static AstObject *LockObject( Object *self ) {
+/*
+*  Name:
+*     LockObject
+
+*  Purpose:
+*     Ensure the AST Object encapsulated by a starlink.Ast.Object is
+*     locked by the calling thread.
+
+*  Description:
+*     If the AST Object is not currently locked by the calling thread, it
+*     is locked and added to the list of AST Objects that will be unlocked
+*     by TIDY when the current method returns. If another thread has the
+*     AST Object locked, the GIL is released while waiting for the other
+*     thread to unlock it.
+
+*  Arguments:
+*     self
+*        Pointer to the starlink.Ast.Object.
+
+*  Returned Value:
+*     The AST Object identifier stored in the starlink.Ast.Object.
+
+*/
+   AstObject *this = LAST( self );
+   int locked;
+
+   if( this && astOK && astThread( this, 0 ) != AST__RUNNING ) {
+
+/* Try to lock the Object without waiting first, so that the GIL need
+   not be released in the usual case where no other thread is using the
+   Object. The error reported if this fails is discarded, so do not do
+   this if a Python exception has already been raised. */
+      locked = 0;
+      if( !PyErr_Occurred() ) {
+         astLock( this, 0 );
+         if( astOK ) {
+            locked = 1;
+         } else {
+            astClearStatus;
+            PyErr_Clear();
+         }
+      }
+
+/* Otherwise, release the GIL while waiting, since the thread that has
+   the Object locked may need the GIL before it can unlock it. */
+      if( !locked ) {
+         Py_BEGIN_ALLOW_THREADS
+         astLock( this, 1 );
+         Py_END_ALLOW_THREADS
+      }
+
+      if( astOK ) ListObject( this );
+   }
+
+   return this;
+}
+
+static int ListObject( AstObject *this ) {
+/*
+*  Name:
+*     ListObject
+
+*  Purpose:
+*     Add an AST Object to the list of Objects to be unlocked by TIDY.
+
+*  Arguments:
+*     this
+*        An AST Object identifier owned by the calling thread.
+
+*  Returned Value:
+*     Zero if successful, -1 (with a Python exception raised) otherwise.
+
+*/
+   AstObject **objects;
+   LockList *list = GetLockList( 1 );
+
+   if( list && list->nobject == list->mxobject ) {
+      objects = realloc( list->objects,
+                         ( list->mxobject + 10 )*sizeof( *objects ) );
+      if( objects ) {
+         list->objects = objects;
+         list->mxobject += 10;
+      }
+   }
+
+   if( !list || list->nobject == list->mxobject ) {
+      PyErr_NoMemory();
+      return -1;
+   }
+
+   list->objects[ list->nobject++ ] = this;
+   return 0;
+}
+
+static void ForgetObject( AstObject *this ) {
+/*
+*  Name:
+*     ForgetObject
+
+*  Purpose:
+*     Remove an AST Object from the list of Objects to be unlocked by TIDY.
+
+*  Arguments:
+*     this
+*        An AST Object identifier.
+
+*/
+   LockList *list = GetLockList( 0 );
+   int i;
+   int j;
+
+   if( list && this ) {
+      for( i = j = 0; i < list->nobject; i++ ) {
+         if( list->objects[ i ] != this ) list->objects[ j++ ] = list->objects[ i ];
+      }
+      list->nobject = j;
+   }
+}
+
+static void UnlockObjects( void ) {
+/*
+*  Name:
+*     UnlockObjects
+
+*  Purpose:
+*     Unlock the AST Objects locked by the current method (see TIDY).
+
+*  Description:
+*     The AST error status is cleared and the AST Objects in the calling
+*     thread's list are unlocked, most recently locked first, unless a
+*     Python callback is active (see BEGIN_CALLBACK). Each Object is
+*     unlocked even if it appears to be unlocked already, since it may
+*     have been unlocked as part of another Object that contains it (e.g.
+*     a Frame within a FrameSet), which leaves the identifier still
+*     assigned to the calling thread.
+
+*/
+   AstObject *this;
+   LockList *list;
+
+   astClearStatus;
+   list = GetLockList( 0 );
+   if( list && !list->hold && list->nobject > 0 ) {
+      while( list->nobject > 0 ) {
+         this = list->objects[ --list->nobject ];
+         astUnlock( this, 0 );
+      }
+      astClearStatus;
+   }
+}
+
+static void HoldLocks( int delta ) {
+/*
+*  Name:
+*     HoldLocks
+
+*  Purpose:
+*     Start or end a Python callback (see BEGIN_CALLBACK).
+
+*  Arguments:
+*     delta
+*        +1 at the start of the callback, -1 at the end.
+
+*/
+   LockList *list = GetLockList( 1 );
+   if( list ) list->hold += delta;
+}
+
+static LockList *GetLockList( int create ) {
+/*
+*  Name:
+*     GetLockList
+
+*  Purpose:
+*     Get the list of AST Objects locked by the calling thread.
+
+*  Arguments:
+*     create
+*        If non-zero, a new empty list is created if the calling thread
+*        does not yet have one. Otherwise, NULL is returned.
+
+*  Returned Value:
+*     Pointer to the list, or NULL.
+
+*/
+   LockList *list = NULL;
+
+   pthread_once( &lock_list_once, CreateLockListKey );
+   if( lock_list_ok ) {
+      list = pthread_getspecific( lock_list_key );
+      if( !list && create ) {
+         list = calloc( 1, sizeof( *list ) );
+         if( list && pthread_setspecific( lock_list_key, list ) ) {
+            free( list );
+            list = NULL;
+         }
+      }
+   }
+   return list;
+}
+
+static void CreateLockListKey( void ) {
+/*
+*  Name:
+*     CreateLockListKey
+
+*  Purpose:
+*     Create the pthreads key used to store each thread's LockList.
+
+*/
+   lock_list_ok = !pthread_key_create( &lock_list_key, FreeLockList );
+}
+
+static void FreeLockList( void *data ) {
+/*
+*  Name:
+*     FreeLockList
+
+*  Purpose:
+*     Free the LockList of a thread that is exiting.
+
+*  Description:
+*     The list will be empty since TIDY is used before every method
+*     returns, so no AST Objects need to be unlocked.
+
+*/
+   LockList *list = (LockList *) data;
+   if( list ) {
+      free( list->objects );
+      free( list );
+   }
+}
+#endif
+
 
 
 static PyTypeObject *GetType( AstObject *this ) {
@@ -11736,6 +13016,8 @@ static PyTypeObject *GetType( AstObject *this ) {
          result = (PyTypeObject *) &TableType;
       } else if( !strcmp( class, "FitsTable" ) ) {
          result = (PyTypeObject *) &FitsTableType;
+      } else if( !strcmp( class, "ResamplePlan" ) ) {
+         result = (PyTypeObject *) &ResamplePlanType;
       } else {
          char buff[ 200 ];
          sprintf( buff, "Python AST function GetType does not yet "
@@ -11759,11 +13041,7 @@ static PyArrayObject *GetArray( PyObject *object, int type, int append,
 *     error messages, and checks the ArrayObject has specified dimensions.
 
 */
-   char buf[400];
    PyArrayObject *result = NULL;
-   int error = 0;
-   int i;
-   int j;
 
 /* Check a PyObject was supplied. */
    if( object ) {
@@ -11774,115 +13052,138 @@ static PyArrayObject *GetArray( PyObject *object, int type, int append,
       result = (PyArrayObject *) PyArray_ContiguousFromAny( object, type, 0,
                                                             100 );
 
-/* Check the array was created succesfully. */
-      if( result ) {
+/* Check the array was created succesfully, and has the required
+   dimensions. */
+      if( result && !CheckArrayDims( result, append, ndim, dims, arg, fun ) ) {
+         Py_DECREF(result);
+         result = NULL;
+      }
+   }
+
+   return result;
+}
+
+static int CheckArrayDims( PyArrayObject *array, int append, int ndim,
+                           int *dims, const char *arg, const char *fun ){
+/*
+*  Name:
+*     CheckArrayDims
+
+*  Purpose:
+*     Check an ArrayObject has the specified dimensions, raising a
+*     ValueError exception and returning zero if not. The "dims" array is
+*     updated to hold the actual dimensions, padded with degenerate axes
+*     as described by "append".
+
+*/
+   char buf[400];
+   int error = 0;
+   int i;
+   int j;
+
+/* Check an array was supplied. */
+   if( array ) {
 
 /* If the ArrayObject has more axes than requested, check that the first
    ndim axes have the correct length, and that all the extra trailing
    axes are degenerate (i.e. have a length of one). */
-         if( result->nd > ndim ) {
-
-            for( i = 0; i < ndim && !error; i++ ) {
-               if( dims[ i ] > 0 && result->dimensions[ i ] != dims[ i ] ) {
-                  sprintf( buf, "The '%s' array supplied to %s has a length "
-                           "of %d for dimension %d (one-based) - should "
-                           "be %d.", arg, fun, (int) result->dimensions[ i ],
-                           i+1, dims[ i ] );
-                  error = 1;
-               }
-               dims[ i ] = result->dimensions[ i ];
+      if( array->nd > ndim ) {
+
+         for( i = 0; i < ndim && !error; i++ ) {
+            if( dims[ i ] > 0 && array->dimensions[ i ] != dims[ i ] ) {
+               sprintf( buf, "The '%s' array supplied to %s has a length "
+                        "of %d for dimension %d (one-based) - should "
+                        "be %d.", arg, fun, (int) array->dimensions[ i ],
+                        i+1, dims[ i ] );
+               error = 1;
             }
+            dims[ i ] = array->dimensions[ i ];
+         }
 
-            for( ; i < result->nd && !error; i++ ) {
-               if( result->dimensions[ i ] > 1 ) {
-                  sprintf( buf, "The '%s' array supplied to %s has too many "
-                          "significant %s, but no more than %d %s allowed.",
-                          arg, fun, (ndim==1?"dimension":"dimensions"),
-                          ndim, (ndim==1?"is":"are") );
-                  error = 1;
-               }
+         for( ; i < array->nd && !error; i++ ) {
+            if( array->dimensions[ i ] > 1 ) {
+               sprintf( buf, "The '%s' array supplied to %s has too many "
+                       "significant %s, but no more than %d %s allowed.",
+                       arg, fun, (ndim==1?"dimension":"dimensions"),
+                       ndim, (ndim==1?"is":"are") );
+               error = 1;
             }
+         }
 
 /* If the ArrayObject has exactly the right number of axes, check that
    they have the correct lengths. */
-         } else if( result->nd == ndim ) {
-            for( i = 0; i < ndim && !error; i++ ) {
-               if( dims[ i ] > 0 && result->dimensions[ i ] != dims[ i ] ) {
-                  sprintf( buf, "The '%s' array supplied to %s has a length "
-                           "of %d for dimension %d (one-based) - should "
-                           "be %d.", arg, fun, (int) result->dimensions[ i ],
-                           i+1, dims[ i ] );
-                  error = 1;
-               }
-               dims[ i ] = result->dimensions[ i ];
+      } else if( array->nd == ndim ) {
+         for( i = 0; i < ndim && !error; i++ ) {
+            if( dims[ i ] > 0 && array->dimensions[ i ] != dims[ i ] ) {
+               sprintf( buf, "The '%s' array supplied to %s has a length "
+                        "of %d for dimension %d (one-based) - should "
+                        "be %d.", arg, fun, (int) array->dimensions[ i ],
+                        i+1, dims[ i ] );
+               error = 1;
             }
+            dims[ i ] = array->dimensions[ i ];
+         }
 
 /* If the ArrayObject has too few axes, and we are using the available
    ArrayObject axes as the leading axes (and therefore padding with
    trailing degenerate axes), check the available axes. */
-         } else if( append ){
-
-            for( i = 0; i < result->nd && !error; i++ ) {
-               if( dims[ i ] > 0 && result->dimensions[ i ] != dims[ i ] ) {
-                  sprintf( buf, "The '%s' array supplied to %s has a length "
-                           "of %d for dimension %d (one-based) - should "
-                           "be %d.", arg, fun, (int) result->dimensions[ i ],
-                           i+1, dims[ i ] );
-                  error = 1;
-               }
-               dims[ i ] = result->dimensions[ i ];
+      } else if( append ){
+
+         for( i = 0; i < array->nd && !error; i++ ) {
+            if( dims[ i ] > 0 && array->dimensions[ i ] != dims[ i ] ) {
+               sprintf( buf, "The '%s' array supplied to %s has a length "
+                        "of %d for dimension %d (one-based) - should "
+                        "be %d.", arg, fun, (int) array->dimensions[ i ],
+                        i+1, dims[ i ] );
+               error = 1;
             }
+            dims[ i ] = array->dimensions[ i ];
+         }
 
-            for( ; i < ndim && !error; i++ ) {
-               if( dims[ i ] > 1 ) {
-                  sprintf( buf, "The '%s' array supplied to %s has %d "
-                          "%s, but %d %s required.", arg, fun, result->nd,
-                          (ndim==1?"dimension":"dimensions"), ndim,
-                          (ndim==1?"is":"are") );
-                  error = 1;
-               }
-               dims[ i ] = 1;
+         for( ; i < ndim && !error; i++ ) {
+            if( dims[ i ] > 1 ) {
+               sprintf( buf, "The '%s' array supplied to %s has %d "
+                       "%s, but %d %s required.", arg, fun, array->nd,
+                       (ndim==1?"dimension":"dimensions"), ndim,
+                       (ndim==1?"is":"are") );
+               error = 1;
             }
+            dims[ i ] = 1;
+         }
 
 /* If the ArrayObject has too few axes, and we are using the available
    ArrayObject axes as the trailing axes (and therefore padding with
    leading degenerate axes), check the available axes. */
-         } else {
+      } else {
 
-            for( i = 0; i < ndim - result->nd && !error; i++ ) {
-               if( dims[ i ] > 1 ) {
-                  sprintf( buf, "The '%s' array supplied to %s has %d "
-                          "%s, but %d %s required.", arg, fun, result->nd,
-                          (ndim==1?"dimension":"dimensions"), ndim,
-                          (ndim==1?"is":"are") );
-                  error = 1;
-               }
-               dims[ i ] = 1;
+         for( i = 0; i < ndim - array->nd && !error; i++ ) {
+            if( dims[ i ] > 1 ) {
+               sprintf( buf, "The '%s' array supplied to %s has %d "
+                       "%s, but %d %s required.", arg, fun, array->nd,
+                       (ndim==1?"dimension":"dimensions"), ndim,
+                       (ndim==1?"is":"are") );
+               error = 1;
             }
+            dims[ i ] = 1;
+         }
 
-            for( j = 0; i < ndim && !error; i++,j++ ) {
-               if( dims[ i ] > 0 && result->dimensions[ j ] != dims[ i ] ) {
-                  sprintf( buf, "The '%s' array supplied to %s has a length "
-                           "of %d for dimension %d (one-based) - should "
-                           "be %d.", arg, fun, (int) result->dimensions[ j ],
-                           j+1, dims[ i ] );
-                  error = 1;
-               }
-               dims[ i ] = result->dimensions[ j ];
+         for( j = 0; i < ndim && !error; i++,j++ ) {
+            if( dims[ i ] > 0 && array->dimensions[ j ] != dims[ i ] ) {
+               sprintf( buf, "The '%s' array supplied to %s has a length "
+                        "of %d for dimension %d (one-based) - should "
+                        "be %d.", arg, fun, (int) array->dimensions[ j ],
+                        j+1, dims[ i ] );
+               error = 1;
             }
+            dims[ i ] = array->dimensions[ j ];
          }
       }
    }
 
-/* If an error was flagged, raise a ValueError exception, release the
-   refererence to the ArrayObject, and nullify the returned pointer. */
-   if( result && error ) {
-      PyErr_SetString( PyExc_ValueError, buf );
-      Py_DECREF(result);
-      result = NULL;
-   }
+/* If an error was flagged, raise a ValueError exception. */
+   if( error ) PyErr_SetString( PyExc_ValueError, buf );
 
-   return result;
+   return !error;
 }
 
 static PyArrayObject *GetArray1D( PyObject *object, int *dim, const char *arg,
@@ -11915,6 +13216,256 @@ static PyArrayObject *GetArray1I( PyObject *object, int *dim, const char *arg,
    return GetArray( object, PyArray_INT, 1, 1, dim, arg, fun );
 }
 
+static PyArrayObject *GetArray1K( PyObject *object, int *dim, const char *arg,
+                                  const char *fun ){
+/*
+*  Name:
+*     GetArray1K
+
+*  Purpose:
+*     A wrapper for PyArray_ContiguousFromAny that issues better
+*     error messages, and checks the ArrayObject is 1-D with 64-bit
+*     integer values.
+
+*/
+   return GetArray( object, PyArray_INT64, 1, 1, dim, arg, fun );
+}
+
+static PyArrayObject *GetCoordArray( PyObject *object, int writeable,
+                                     int *dims, npy_intp *cstride,
+                                     npy_intp *pstride, const char *arg,
+                                     const char *fun ){
+/*
+*  Name:
+*     GetCoordArray
+
+*  Purpose:
+*     Returns an ArrayObject holding (ncoord,npoint) coordinate values,
+*     avoiding a copy if possible.
+
+*  Description:
+*     If the supplied object is already a float64 or float32 numpy array
+*     (aligned, in native byte order, and writeable if "writeable" is
+*     non-zero), a new reference to it is returned and its own memory is
+*     used, whatever its strides. Otherwise, the object is converted to a
+*     contiguous float64 array using GetArray. On exit, "dims" holds the
+*     number of coordinates and points, and "cstride" and "pstride" hold
+*     the number of bytes between adjacent coordinates and adjacent points
+*     in the returned array's data.
+
+*/
+   PyArrayObject *result = NULL;
+   int type;
+
+/* Check a PyObject was supplied. */
+   if( !object ) return NULL;
+
+/* Use the supplied array directly if it is of a suitable type and
+   layout. */
+   if( PyArray_Check( object ) ) {
+      result = (PyArrayObject *) object;
+      type = result->descr->type_num;
+      if( ( type == PyArray_DOUBLE || type == PyArray_FLOAT ) &&
+          PyArray_ISALIGNED( result ) && PyArray_ISNOTSWAPPED( result ) &&
+          ( !writeable || PyArray_ISWRITEABLE( result ) ) ) {
+         Py_INCREF( result );
+         if( !CheckArrayDims( result, 0, 2, dims, arg, fun ) ) {
+            Py_DECREF( result );
+            return NULL;
+         }
+      } else {
+         result = NULL;
+      }
+   }
+
+/* Otherwise, take a contiguous float64 copy of it. */
+   if( !result ) {
+      result = GetArray( object, PyArray_DOUBLE, 0, 2, dims, arg, fun );
+      if( !result ) return NULL;
+   }
+
+/* Get the strides. A 1-dimensional array is used as a single coordinate,
+   and a scalar as a single point. Any extra trailing axes are
+   degenerate and so can be ignored. */
+   if( result->nd >= 2 ) {
+      *cstride = result->strides[ 0 ];
+      *pstride = result->strides[ 1 ];
+   } else if( result->nd == 1 ) {
+      *cstride = 0;
+      *pstride = result->strides[ 0 ];
+   } else {
+      *cstride = 0;
+      *pstride = 0;
+   }
+
+   return result;
+}
+
+static void CopyCoords( int npoint, int ncoord, const char *in, int in_type,
+                        npy_intp in_cstride, npy_intp in_pstride, char *out,
+                        int out_type, npy_intp out_cstride,
+                        npy_intp out_pstride ){
+/*
+*  Name:
+*     CopyCoords
+
+*  Purpose:
+*     Copy (ncoord,npoint) coordinate values between two strided float64
+*     or float32 arrays, converting the data type if necessary. AST__BAD
+*     values are converted to NaN when stored in a float32 array, and NaN
+*     values are converted to AST__BAD when stored in a float64 array.
+*     Strides are in bytes.
+
+*/
+   const char *pin;
+   char *pout;
+   double value;
+   int coord;
+   int point;
+
+   for( coord = 0; coord < ncoord; coord++ ) {
+      pin = in + coord*in_cstride;
+      pout = out + coord*out_cstride;
+
+      if( in_type == PyArray_DOUBLE && out_type == PyArray_DOUBLE ) {
+         for( point = 0; point < npoint; point++ ) {
+            *((double *) pout) = *((const double *) pin);
+            pin += in_pstride;
+            pout += out_pstride;
+         }
+
+      } else if( in_type == PyArray_DOUBLE ) {
+         for( point = 0; point < npoint; point++ ) {
+            value = *((const double *) pin);
+            *((float *) pout) = ( value != AST__BAD ) ? (float) value : NAN;
+            pin += in_pstride;
+            pout += out_pstride;
+         }
+
+      } else if( out_type == PyArray_DOUBLE ) {
+         for( point = 0; point < npoint; point++ ) {
+            value = *((const float *) pin);
+            *((double *) pout) = isnan( value ) ? AST__BAD : value;
+            pin += in_pstride;
+            pout += out_pstride;
+         }
+
+      } else {
+         for( point = 0; point < npoint; point++ ) {
+            *((float *) pout) = *((const float *) pin);
+            pin += in_pstride;
+            pout += out_pstride;
+         }
+      }
+   }
+}
+
+static void TranCoords( AstMapping *this, int npoint, int ncoord_in,
+                        const char *in, int in_type, npy_intp in_cstride,
+                        npy_intp in_pstride, int forward, int ncoord_out,
+                        char *out, int out_type, npy_intp out_cstride,
+                        npy_intp out_pstride ){
+/*
+*  Name:
+*     TranCoords
+
+*  Purpose:
+*     Transform positions held in strided float64 or float32 arrays
+*     (as returned by GetCoordArray), using astTranN.
+
+*  Description:
+*     An array can be passed directly to astTranN if it is float64 with
+*     adjacent points in adjacent elements, and the coordinate stride is a
+*     whole number of elements (it then becomes the "indim" or "outdim"
+*     value). Any other array is transferred through a work array in
+*     blocks of TRAN_BLOCK points, so that the extra memory used does not
+*     depend on the number of points. This function does not use the
+*     Python API and so can be called with the GIL released.
+
+*/
+
+#define TRAN_BLOCK 4096
+
+   const double *pin;
+   double *pout;
+   double *work;
+   int block;
+   int direct_in;
+   int direct_out;
+   int first;
+   int indim;
+   int nb;
+   int outdim;
+
+   if( !astOK || npoint <= 0 ) return;
+
+/* See if each array can be used directly. */
+   direct_in = ( in_type == PyArray_DOUBLE &&
+                 in_pstride == (npy_intp) sizeof( double ) &&
+                 ( ncoord_in == 1 || ( in_cstride > 0 &&
+                   in_cstride % (npy_intp) sizeof( double ) == 0 &&
+                   in_cstride/(npy_intp) sizeof( double ) >= npoint ) ) );
+   direct_out = ( out_type == PyArray_DOUBLE &&
+                  out_pstride == (npy_intp) sizeof( double ) &&
+                  ( ncoord_out == 1 || ( out_cstride > 0 &&
+                    out_cstride % (npy_intp) sizeof( double ) == 0 &&
+                    out_cstride/(npy_intp) sizeof( double ) >= npoint ) ) );
+
+/* If so, transform all points with a single call. */
+   if( direct_in && direct_out ) {
+      astTranN( this, npoint, ncoord_in,
+                ( ncoord_in == 1 ) ? npoint : in_cstride/(npy_intp) sizeof( double ),
+                (const double *) in, forward, ncoord_out,
+                ( ncoord_out == 1 ) ? npoint : out_cstride/(npy_intp) sizeof( double ),
+                (double *) out );
+      return;
+   }
+
+/* Otherwise, allocate a work array large enough for one block of input
+   and output positions, and transform the points a block at a time. */
+   block = ( npoint < TRAN_BLOCK ) ? npoint : TRAN_BLOCK;
+   work = astMalloc( sizeof( double )*( ncoord_in + ncoord_out )*block );
+
+   for( first = 0; first < npoint && astOK; first += block ) {
+      nb = ( npoint - first < block ) ? npoint - first : block;
+
+/* Locate or gather the input positions. */
+      if( direct_in ) {
+         pin = (const double *) ( in + first*in_pstride );
+         indim = ( ncoord_in == 1 ) ? nb : in_cstride/(npy_intp) sizeof( double );
+      } else {
+         CopyCoords( nb, ncoord_in, in + first*in_pstride, in_type,
+                     in_cstride, in_pstride, (char *) work, PyArray_DOUBLE,
+                     nb*sizeof( double ), sizeof( double ) );
+         pin = work;
+         indim = nb;
+      }
+
+/* Locate the output positions, or use the work array. */
+      if( direct_out ) {
+         pout = (double *) ( out + first*out_pstride );
+         outdim = ( ncoord_out == 1 ) ? nb : out_cstride/(npy_intp) sizeof( double );
+      } else {
+         pout = work + ncoord_in*nb;
+         outdim = nb;
+      }
+
+/* Transform the block, and scatter the results if required. */
+      astTranN( this, nb, ncoord_in, indim, pin, forward, ncoord_out,
+                outdim, pout );
+      if( !direct_out && astOK ) {
+         CopyCoords( nb, ncoord_out, (const char *) pout, PyArray_DOUBLE,
+                     nb*sizeof( double ), sizeof( double ),
+                     out + first*out_pstride, out_type, out_cstride,
+                     out_pstride );
+      }
+   }
+
+   work = astFree( work );
+
+#undef TRAN_BLOCK
+}
+
 static char *DumpToString( AstObject *this, const char *options ){
 /*
 *  Name:
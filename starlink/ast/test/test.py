@@ -8,6 +8,8 @@ import string
 import sys
 import os.path
 import os
+import threading
+import queue
 
 #  A class that defines Channel source and sink functions that store text
 #  in an internal list.
@@ -163,6 +165,250 @@ class TestAst(unittest.TestCase):
         self.assertGreaterEqual(starlink.Ast.version(), 5007002)
         self.assertTrue(os.path.isfile(os.path.join(starlink.Ast.get_include(), 'star', 'pyast.h')))
 
+    def test_NumThreads(self):
+        oldval = starlink.Ast.tune("NumThreads", starlink.Ast.TUNULL)
+        self.assertGreaterEqual(oldval, 1)
+
+#  Resampling and rebinning should give the same results whatever
+#  the number of threads (rebinned values may differ by rounding).
+        matrixmap = starlink.Ast.MatrixMap([[0.4, -0.3], [0.3, 0.4]])
+        data_in = numpy.arange(300 * 200, dtype=numpy.double).reshape(300, 200)
+
+        def run():
+            npix, rout, routv = matrixmap.resample(
+                [1, 1], [200, 300], data_in, None, starlink.Ast.LINEAR, None,
+                starlink.Ast.USEBAD, 0.0, 100, starlink.Ast.BAD,
+                [-90, 0], [80, 180], [-90, 0], [80, 180])
+            bout, boutv = matrixmap.rebin(
+                0.5, [1, 1], [200, 300], data_in, None, starlink.Ast.LINEAR,
+                None, starlink.Ast.USEBAD, 0.0, 100, starlink.Ast.BAD,
+                [-90, 0], [80, 180], [1, 1], [200, 300])
+            return npix, rout, bout
+
+        try:
+            starlink.Ast.tune("NumThreads", 1)
+            serial = run()
+            self.assertEqual(starlink.Ast.tune("NumThreads", 4), 1)
+            parallel = run()
+        finally:
+            starlink.Ast.tune("NumThreads", oldval)
+
+        self.assertEqual(serial[0], parallel[0])
+        self.assertTrue(numpy.array_equal(serial[1], parallel[1]))
+        self.assertTrue(numpy.allclose(serial[2], parallel[2],
+                                       rtol=1.0e-12, atol=0.0))
+
+    def test_MemoryCaching(self):
+        self.assertEqual(starlink.Ast.tune("MemoryCaching",
+                                           starlink.Ast.TUNULL), 1)
+
+#  Results should not depend on whether memory blocks are re-used.
+        def run():
+            mapping = starlink.Ast.ZoomMap(2, 2.0)
+            for i in range(30):
+                mapping = starlink.Ast.CmpMap(
+                    mapping, starlink.Ast.ShiftMap([1.0, 0.5 * i]), True)
+            simple = mapping.simplify()
+            frameset = starlink.Ast.FrameSet(starlink.Ast.SkyFrame(), "")
+            frameset.addframe(1, simple, starlink.Ast.Frame(2))
+            return (simple.Class, frameset.copy().getmapping().tran(
+                [[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]]))
+
+        try:
+            self.assertEqual(starlink.Ast.tune("MemoryCaching", 0), 1)
+            uncached = run()
+            self.assertEqual(starlink.Ast.tune("MemoryCaching", 1), 0)
+            cached = run()
+        finally:
+            starlink.Ast.tune("MemoryCaching", 1)
+
+        self.assertEqual(uncached[0], cached[0])
+        self.assertTrue(numpy.array_equal(uncached[1], cached[1]))
+
+    def test_KernelTable(self):
+        oldval = starlink.Ast.tune("KernelTable", starlink.Ast.TUNULL)
+        self.assertEqual(oldval, 7)
+
+#  Tabulated kernels should reproduce the results of evaluating the
+#  kernel functions directly, to within the requested accuracy.
+        matrixmap = starlink.Ast.MatrixMap([[0.4, -0.3], [0.3, 0.4]])
+        data_in = numpy.arange(300 * 200, dtype=numpy.double).reshape(300, 200)
+
+        def run():
+            results = []
+            for interp, params in ((starlink.Ast.SINCSINC, [2, 2]),
+                                   (starlink.Ast.GAUSS, [3, 1.5]),
+                                   (starlink.Ast.SOMB, [2])):
+                npix, rout, routv = matrixmap.resample(
+                    [1, 1], [200, 300], data_in, None, interp, params,
+                    starlink.Ast.USEBAD, 0.0, 100, starlink.Ast.BAD,
+                    [-90, 0], [80, 180], [-90, 0], [80, 180])
+                bout, boutv = matrixmap.rebin(
+                    0.5, [1, 1], [200, 300], data_in, None, interp, params,
+                    starlink.Ast.USEBAD, 0.0, 100, starlink.Ast.BAD,
+                    [-90, 0], [80, 180], [1, 1], [200, 300])
+                results.append((npix, rout, bout))
+            return results
+
+        try:
+            tabulated = run()
+            self.assertEqual(starlink.Ast.tune("KernelTable", 0), 7)
+            direct = run()
+        finally:
+            starlink.Ast.tune("KernelTable", oldval)
+
+        for t, d in zip(tabulated, direct):
+            self.assertEqual(t[0], d[0])
+            for i in (1, 2):
+                good = d[i] != starlink.Ast.BAD
+                self.assertTrue(numpy.array_equal(good, t[i] != starlink.Ast.BAD))
+                self.assertTrue(numpy.allclose(t[i][good], d[i][good],
+                                               rtol=1.0e-5, atol=1.0e-3))
+
+    def test_Threads(self):
+
+#  Mappings created by separate Python threads can be used concurrently.
+        data_in = numpy.arange(100 * 80, dtype=numpy.double).reshape(100, 80)
+        pos = numpy.arange(2000, dtype=numpy.double).reshape(2, 1000)
+
+        def run(results, i):
+            zoommap = starlink.Ast.ZoomMap(2, 0.5 * (i + 1))
+            npix, out, outv = zoommap.resample(
+                [1, 1], [80, 100], data_in, None, starlink.Ast.LINEAR, None,
+                starlink.Ast.USEBAD, 0.0, 100, starlink.Ast.BAD,
+                [1, 1], [40, 50], [1, 1], [40, 50])
+            results[i] = (npix, out, zoommap.tran(pos))
+
+        results = [None] * 4
+        threads = [threading.Thread(target=run, args=(results, i))
+                   for i in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        for i in range(4):
+            expected = [None] * 4
+            run(expected, i)
+            self.assertEqual(results[i][0], expected[i][0])
+            self.assertTrue(numpy.array_equal(results[i][1], expected[i][1]))
+            self.assertTrue(numpy.array_equal(results[i][2], expected[i][2]))
+
+#  An Object can be passed to another thread by unlocking it first.
+        zoommap = starlink.Ast.ZoomMap(2, 3.0)
+        zoommap.unlock()
+        out = []
+
+        def use():
+            zoommap.lock()
+            out.append(zoommap.tran([[1.0], [2.0]]))
+            zoommap.unlock()
+
+        thread = threading.Thread(target=use)
+        thread.start()
+        thread.join()
+        zoommap.lock()
+        self.assertTrue(numpy.array_equal(out[0], [[3.0], [6.0]]))
+
+#  An Object can also be used by another thread without being unlocked
+#  first, and the last reference to it can be dropped in that thread.
+        zoommap = starlink.Ast.ZoomMap(2, 3.0)
+        frame = starlink.Ast.Frame(2)
+        out = []
+
+        def share():
+            out.append(zoommap.tran([[1.0], [2.0]]))
+            out.append(starlink.Ast.FrameSet(frame, "").Naxes)
+
+        thread = threading.Thread(target=share)
+        thread.start()
+        thread.join()
+        self.assertTrue(numpy.array_equal(out[0], [[3.0], [6.0]]))
+        self.assertEqual(out[1], 2)
+        self.assertEqual(zoommap.Zoom, 3.0)
+
+        out = [starlink.Ast.ZoomMap(2, 4.0)]
+        self.assertEqual(zoommap.Nobject, 2)
+        thread = threading.Thread(target=out.clear)
+        thread.start()
+        thread.join()
+        self.assertEqual(out, [])
+        self.assertEqual(zoommap.Nobject, 1)
+        self.assertEqual(frame.Naxes, 2)
+
+#  A thread waiting to lock an Object does not stop the thread that has
+#  it locked from completing a call that releases the GIL.
+        mathmap = starlink.Ast.MathMap(1, 1, ["y=2*x+sqrt(x)"], ["x"])
+        xin = numpy.arange(3000000, dtype=numpy.double).reshape(1, 3000000)
+        mathmap.unlock()
+        locked = threading.Event()
+        out = []
+
+        def owner():
+            mathmap.lock()
+            locked.set()
+            out.append(mathmap.tran(xin))
+            mathmap.unlock()
+
+        def waiter():
+            locked.wait()
+            mathmap.lock()
+            out.append(mathmap.tran([[4.0]]))
+            mathmap.unlock()
+
+        threads = [threading.Thread(target=owner, daemon=True),
+                   threading.Thread(target=waiter, daemon=True)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join(60)
+            self.assertFalse(thread.is_alive())
+        mathmap.lock()
+        self.assertEqual(len(out), 2)
+        self.assertEqual(out[0][0][4], 10.0)
+        self.assertEqual(out[1][0][0], 10.0)
+
+#  Identifiers issued in one thread can be annulled in another while
+#  both threads are issuing and annulling identifiers of their own.
+        passed = queue.Queue()
+        errors = []
+
+        def churn(i):
+            try:
+                for j in range(3000):
+                    zoommap = starlink.Ast.ZoomMap(1, float(j + 1))
+                    if j % 2:
+                        zoommap.unlock()
+                        passed.put((zoommap, j + 1))
+                    del zoommap
+                    try:
+                        zoommap, zoom = passed.get_nowait()
+                    except queue.Empty:
+                        continue
+                    zoommap.lock()
+                    if zoommap.Zoom != zoom:
+                        errors.append((zoommap.Zoom, zoom))
+                    del zoommap
+            except Exception as exc:
+                errors.append(exc)
+
+        threads = [threading.Thread(target=churn, args=(i,))
+                   for i in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        while not passed.empty():
+            zoommap, zoom = passed.get()
+            zoommap.lock()
+            self.assertEqual(zoommap.Zoom, zoom)
+        self.assertEqual(errors, [])
+
+#  Errors reported while the GIL is released are raised as exceptions.
+        mathmap = starlink.Ast.MathMap(1, 1, ["y=2*x"], ["x"])
+        with self.assertRaises(starlink.Ast.AstError):
+            mathmap.tran([1.0, 2.0], False)
+
     def test_Object(self):
         with self.assertRaises(TypeError):
             obj = starlink.Ast.Object()
@@ -571,6 +817,83 @@ class TestAst(unittest.TestCase):
         with self.assertRaises(starlink.Ast.TIMIN):
             timemap.timeadd("UNRECOGNIZED", [1])
 
+    def test_TimeMapLeapSeconds(self):
+        # UTC dates (MJD) either side of the 2015 July 1 leap second, and
+        # either side of a hypothetical leap second on 2030 January 1.
+        utc = numpy.array([[57203.5, 57204.5, 62501.5, 62502.5]])
+        utctotai = starlink.Ast.TimeMap()
+        utctotai.timeadd("UTCTOTAI", [0.0])
+        utctott = starlink.Ast.TimeMap()
+        utctott.timeadd("UTCTOTAI", [0.0])
+        utctott.timeadd("TAITOTT", [0.0])
+
+        dat = (utctotai.tran(utc) - utc) * 86400.0
+        self.assertTrue(numpy.allclose(dat, [[35, 36, 36, 36]], atol=1.0e-5))
+        dtt = (utctott.tran(utc) - utc) * 86400.0
+        self.assertTrue(numpy.allclose(dtt, dat + 32.184, atol=1.0e-5))
+        back = utctott.tran(utctott.tran(utc), False)
+        self.assertTrue(numpy.allclose(back, utc, rtol=0.0, atol=1.0e-9))
+
+        # IETF/NIST format: seconds since 1900 January 1 and TAI-UTC.
+        with open("leap.txt", "w") as fd:
+            fd.write("# Leap seconds\n")
+            fd.write("2272060800  10  # 1 Jan 1972\n")
+            fd.write("3644697600  36  # 1 Jul 2015\n")
+            fd.write("4102444800  37  # 1 Jan 2030\n")
+        starlink.Ast.tunec("LeapSeconds", "leap.txt")
+        self.assertEqual(starlink.Ast.tunec("LeapSeconds"), "leap.txt")
+        dat = (utctotai.tran(utc) - utc) * 86400.0
+        self.assertTrue(numpy.allclose(dat, [[10, 36, 36, 37]], atol=1.0e-5))
+
+        # IERS format: MJD, day, month, year and TAI-UTC.
+        with open("leap.txt", "w") as fd:
+            fd.write("#  MJD        Date        TAI-UTC (s)\n")
+            fd.write("41317.0    1  1 1972       10\n")
+            fd.write("57204.0    1  7 2015       36\n")
+            fd.write("62502.0    1  1 2030       37\n")
+        starlink.Ast.tunec("LeapSeconds", "leap.txt")
+        back = utctott.tran(utctott.tran(utc), False)
+        self.assertTrue(numpy.allclose(back, utc, rtol=0.0, atol=1.0e-9))
+        dat = (utctotai.tran(utc) - utc) * 86400.0
+        self.assertTrue(numpy.allclose(dat, [[10, 36, 36, 37]], atol=1.0e-5))
+
+        # The table can be replaced while another thread is using it, and
+        # each transformation uses the same table throughout.
+        utcs = numpy.tile(utc, 20000)
+        results = []
+
+        def run():
+            timemap = starlink.Ast.TimeMap()
+            timemap.timeadd("UTCTOTAI", [0.0])
+            for i in range(20):
+                results.append(timemap.tran(utcs))
+
+        thread = threading.Thread(target=run)
+        thread.start()
+        for i in range(50):
+            starlink.Ast.tunec("LeapSeconds", "leap.txt" if i % 2 else "")
+        thread.join()
+        self.assertEqual(len(results), 20)
+        for res in results:
+            dat = ((res - utcs) * 86400.0).reshape(-1, 4)
+            self.assertTrue(numpy.allclose(dat, [35, 36, 36, 36], atol=1.0e-5) or
+                            numpy.allclose(dat, [10, 36, 36, 37], atol=1.0e-5))
+
+        # A bad file is rejected and leaves the current table in use.
+        with open("leap.txt", "w") as fd:
+            fd.write("57204.0 36 1\n")
+        with self.assertRaises(starlink.Ast.BADIN):
+            starlink.Ast.tunec("LeapSeconds", "leap.txt")
+        self.assertEqual(starlink.Ast.tunec("LeapSeconds"), "leap.txt")
+        os.remove("leap.txt")
+        with self.assertRaises(starlink.Ast.RDERR):
+            starlink.Ast.tunec("LeapSeconds", "leap.txt")
+
+        # A blank value re-instates the built-in table.
+        starlink.Ast.tunec("LeapSeconds", "")
+        dat = (utctotai.tran(utc) - utc) * 86400.0
+        self.assertTrue(numpy.allclose(dat, [[35, 36, 36, 36]], atol=1.0e-5))
+
     def test_CmpFrame(self):
         cmpframe = starlink.Ast.CmpFrame(starlink.Ast.Frame(2), starlink.Ast.Frame(2))
         self.assertIsInstance(cmpframe, starlink.Ast.CmpFrame)
@@ -592,6 +915,342 @@ class TestAst(unittest.TestCase):
         self.assertEqual(out[1], 0)
         self.assertEqual(out[2], 0)
 
+    def test_CmpMapTran(self):
+#  Repeated transformations of varying numbers of points re-use the same
+#  temporary PointSets, including more points than fit in a single batch
+#  of a series CmpMap.
+        parallel = starlink.Ast.CmpMap(starlink.Ast.ZoomMap(2, 2.0),
+                                       starlink.Ast.ShiftMap([3.0]), False)
+        cmpmap = starlink.Ast.CmpMap(starlink.Ast.ShiftMap([1.0, 2.0, 3.0]),
+                                     parallel, True)
+        for npoint in (1, 3, 2, 5000, 4):
+            pin = numpy.arange(3.0 * npoint).reshape(3, npoint)
+            pout = cmpmap.tran(pin)
+            self.assertTrue(numpy.array_equal(pout[0], 2 * (pin[0] + 1)))
+            self.assertTrue(numpy.array_equal(pout[1], 2 * (pin[1] + 2)))
+            self.assertTrue(numpy.array_equal(pout[2], pin[2] + 6))
+            self.assertTrue(numpy.allclose(cmpmap.tran(pout, False), pin))
+
+    def test_TypedAttributes(self):
+#  Attributes with typed access functions give the same values as the
+#  string interface.
+        zoommap = starlink.Ast.ZoomMap(3, 2.5)
+        self.assertEqual(zoommap.Nin, 3)
+        self.assertEqual(zoommap.get("Nin"), "3")
+        self.assertEqual(zoommap.Zoom, 2.5)
+        self.assertFalse(zoommap.test("Invert"))
+        zoommap.Invert = True
+        self.assertTrue(zoommap.test("Invert"))
+        self.assertEqual(zoommap.get("Invert"), "1")
+        zoommap.clear("Invert")
+        self.assertFalse(zoommap.Invert)
+        zoommap.Zoom = 4.0
+        self.assertEqual(zoommap.get("Zoom"), "4")
+        zoommap.clear("Zoom")
+        self.assertEqual(zoommap.Zoom, 1.0)
+
+        skyframe = starlink.Ast.SkyFrame("System=FK5,Equinox=1950")
+        self.assertEqual(skyframe.System, "FK5")
+        self.assertEqual(skyframe.Naxes, 2)
+        self.assertEqual(skyframe.Equinox, 1950.0)
+        self.assertEqual(skyframe.Equinox, float(skyframe.get("Equinox")))
+        skyframe.set("Epoch=J2010.5")
+        self.assertEqual(skyframe.Epoch, 2010.5)
+        self.assertTrue(skyframe.test("Epoch"))
+        skyframe.clear("Epoch")
+        self.assertFalse(skyframe.test("Epoch"))
+        skyframe.ObsAlt = 1200.0
+        self.assertEqual(skyframe.ObsAlt, 1200.0)
+
+#  FrameSets and Regions obtain Frame attributes from their Frame.
+        frameset = starlink.Ast.FrameSet(starlink.Ast.Frame(2))
+        frameset.addframe(starlink.Ast.BASE, starlink.Ast.UnitMap(2),
+                          skyframe)
+        self.assertEqual(frameset.System, "FK5")
+        self.assertEqual(frameset.get("Equinox"), "1950.0")
+        frameset.Current = starlink.Ast.BASE
+        self.assertEqual(frameset.System, "Cartesian")
+        frameset.ObsAlt = 10.0
+        self.assertEqual(frameset.ObsAlt, 10.0)
+        self.assertEqual(skyframe.ObsAlt, 1200.0)
+        frameset.Current = 2
+        frameset.Invert = True
+        self.assertEqual(frameset.Current, 1)
+        self.assertEqual(frameset.System, "Cartesian")
+
+        box = starlink.Ast.Box(skyframe, 1, [0.0, 0.0], [0.1, 0.1])
+        self.assertEqual(box.get("Equinox"), "1950.0")
+        self.assertEqual(box.Nin, 2)
+        self.assertEqual(box.System, "FK5")
+
+    def test_MappingStrided(self):
+#  Float64 and float32 arrays are transformed in place, whatever their
+#  strides, including more points than fit in a single block.
+        shiftmap = starlink.Ast.ShiftMap([1.0, 2.0])
+        rows = numpy.arange(10000.0).reshape(5000, 2)
+        out = numpy.zeros((5000, 3))
+        result = shiftmap.tran(rows.T, True, out[:, 1:].T)
+        self.assertIs(result.base, out)
+        self.assertTrue(numpy.array_equal(out[:, 1], rows[:, 0] + 1.0))
+        self.assertTrue(numpy.array_equal(out[:, 2], rows[:, 1] + 2.0))
+        self.assertFalse(out[:, 0].any())
+
+        wide = numpy.arange(30.0).reshape(2, 15)
+        out = numpy.zeros((2, 20))
+        shiftmap.tran(wide[:, 5:], False, out[:, :10])
+        self.assertTrue(numpy.array_equal(out[0, :10], wide[0, 5:] - 1.0))
+        self.assertTrue(numpy.array_equal(out[1, :10], wide[1, 5:] - 2.0))
+        self.assertFalse(out[:, 10:].any())
+
+        pin = numpy.array([[1.0, 2.0, numpy.nan], [3.0, 4.0, 5.0]],
+                          dtype=numpy.float32)
+        pout = shiftmap.tran(pin)
+        self.assertEqual(pout.dtype, numpy.float64)
+        self.assertTrue(numpy.array_equal(pout[:, :2], [[2.0, 3.0], [5.0, 6.0]]))
+        self.assertEqual(pout[0][2], starlink.Ast.BAD)
+        out = numpy.zeros((3, 2), dtype=numpy.float32)
+        shiftmap.tran(pin, True, out.T)
+        self.assertTrue(numpy.array_equal(out[:2], [[2.0, 5.0], [3.0, 6.0]]))
+        self.assertTrue(numpy.isnan(out[2][0]))
+        self.assertEqual(out[2][1], 7.0)
+
+        zoommap = starlink.Ast.ZoomMap(2, 2.0)
+        out = numpy.zeros((9, 2), dtype=numpy.float32)
+        zoommap.trangrid([1, 0], [3, 2], 0.001, 100, True, out.T)
+        answer = numpy.array([[2., 4., 6., 2., 4., 6., 2., 4., 6.],
+                              [0., 0., 0., 2., 2., 2., 4., 4., 4.]])
+        self.assertTrue(numpy.array_equal(out.T, answer))
+
+    def test_CmpMapBlock(self):
+        oldval = starlink.Ast.tune("CmpMapBlock", starlink.Ast.TUNULL)
+        self.assertEqual(oldval, 512)
+
+#  A compiled pipeline (with merged linear components) should agree with
+#  applying each component separately, to within rounding error, in both
+#  directions and with bad values in the same places.
+        fc = starlink.Ast.FitsChan()
+        for card in ["NAXIS   = 2", "NAXIS1  = 100", "NAXIS2  = 100",
+                     "CTYPE1  = 'RA---TAN'", "CTYPE2  = 'DEC--TAN'",
+                     "CRPIX1  = 50.5", "CRPIX2  = 50.5",
+                     "CRVAL1  = 202.4842", "CRVAL2  = 47.2306",
+                     "CD1_1   = -2.7777E-4", "CD1_2   = 1.2E-6",
+                     "CD2_1   = 1.1E-6", "CD2_2   = 2.7777E-4"]:
+            fc.putfits(card, False)
+        fc.clear("Card")
+        mapping = fc.read().getmapping().simplify()
+        self.assertIsInstance(mapping, starlink.Ast.CmpMap)
+        pin = numpy.array([[1.0, 50.5, 100.0, starlink.Ast.BAD] * 300,
+                           [1.0, 50.5, 37.0, 20.0] * 300])
+        try:
+            starlink.Ast.tune("CmpMapBlock", 0)
+            separate = mapping.tran(pin)
+            self.assertEqual(starlink.Ast.tune("CmpMapBlock", 7), 0)
+            pipeline = mapping.tran(pin)
+            back = mapping.tran(pipeline, False)
+        finally:
+            starlink.Ast.tune("CmpMapBlock", oldval)
+
+        self.assertTrue(numpy.allclose(separate, pipeline, rtol=0,
+                                       atol=1.0E-12))
+        self.assertEqual(pipeline[0][3], starlink.Ast.BAD)
+        self.assertEqual(pipeline[1][3], starlink.Ast.BAD)
+        self.assertTrue(numpy.allclose(back[:, :3], pin[:, :3]))
+
+    def test_ResamplePlan(self):
+#  Applying a ResamplePlan should give the same results as resampling
+#  with the Mapping from which it was created.
+        matrixmap = starlink.Ast.MatrixMap([[0.4, -0.3], [0.3, 0.4]])
+        data_in = numpy.arange(60 * 40, dtype=numpy.double).reshape(60, 40)
+        var_in = data_in + 1.0
+        data_in[10, 10] = starlink.Ast.BAD
+        var_in[20, 5] = starlink.Ast.BAD
+
+        for interp, params in ((starlink.Ast.NEAREST, None),
+                               (starlink.Ast.LINEAR, None),
+                               (starlink.Ast.SINCSINC, [2, 2])):
+            plan = starlink.Ast.ResamplePlan(
+                matrixmap, [1, 1], [40, 60], interp, params, 0.0, 100,
+                [-20, 0], [20, 40], [-20, 0], [20, 40])
+            self.assertIsInstance(plan, starlink.Ast.ResamplePlan)
+            self.assertTrue(plan.isaresampleplan())
+            self.assertFalse(plan.isamapping())
+
+            npix, out, outv = matrixmap.resample(
+                [1, 1], [40, 60], data_in, var_in, interp, params,
+                starlink.Ast.USEBAD, 0.0, 100, starlink.Ast.BAD,
+                [-20, 0], [20, 40], [-20, 0], [20, 40])
+            for p in (plan, plan.copy()):
+                pnpix, pout, poutv = p.apply(data_in, var_in,
+                                             starlink.Ast.USEBAD,
+                                             starlink.Ast.BAD)
+                self.assertEqual(pnpix, npix)
+                self.assertTrue(numpy.allclose(pout, out, rtol=1.0e-12,
+                                               atol=1.0e-9))
+                self.assertTrue(numpy.allclose(poutv, outv, rtol=1.0e-12,
+                                               atol=1.0e-9))
+
+#  The plan can be written out and read back.
+        ss = TextStream()
+        channel = starlink.Ast.Channel(ss, ss)
+        self.assertEqual(channel.write(plan), 1)
+        plan2 = channel.read()
+        self.assertIsInstance(plan2, starlink.Ast.ResamplePlan)
+        self.assertTrue(numpy.allclose(
+            plan2.apply(data_in, var_in, starlink.Ast.USEBAD,
+                        starlink.Ast.BAD)[1], pout, rtol=1.0e-12, atol=1.0e-9))
+
+#  Other data types are resampled using the same weights.
+        data_in = numpy.arange(60 * 40, dtype=numpy.float32).reshape(60, 40)
+        npix, out, outv = plan.apply(data_in.astype(numpy.double))
+        pnpix, pout, poutv = plan.apply(data_in)
+        self.assertIsNone(poutv)
+        self.assertEqual(pout.dtype, numpy.float32)
+        self.assertEqual(pnpix, npix)
+        self.assertTrue(numpy.allclose(pout, out, rtol=1.0e-5))
+
+#  Arrays that do not match the input grid are rejected.
+        with self.assertRaises(ValueError):
+            plan.apply(data_in[:-1])
+
+    def test_ResampleSeparable(self):
+#  A cube resampled using a Mapping that can be split into spatial and
+#  spectral parts should give the same results as when using an
+#  equivalent Mapping that cannot be split.
+        c = math.cos(0.3)
+        s = math.sin(0.3)
+        spatial = starlink.Ast.CmpMap(
+            starlink.Ast.MatrixMap([[c, -s], [s, c]]),
+            starlink.Ast.ShiftMap([3.0, -2.0]))
+        spectral = starlink.Ast.WinMap([1], [40], [0.5], [20.5])
+        cmpmap = starlink.Ast.CmpMap(spatial, spectral, False)
+        k = 20.0 / 39.0
+        mathmap = starlink.Ast.MathMap(
+            3, 3, ["x=%r*a-%r*b+3" % (c, s), "y=%r*a+%r*b-2" % (s, c),
+                   "z=(c-1)*%r+0.5" % k],
+            ["a=%r*(x-3)+%r*(y+2)" % (c, s), "b=%r*(x-3)+%r*(y+2)" % (-s, c),
+             "c=(z-0.5)/%r+1" % k])
+
+        data_in = numpy.arange(40 * 25 * 30,
+                               dtype=numpy.double).reshape(40, 25, 30)
+        var_in = data_in + 1.0
+        for interp, params in ((starlink.Ast.NEAREST, None),
+                               (starlink.Ast.LINEAR, None),
+                               (starlink.Ast.SINCSINC, [2, 2])):
+            for bad in (False, True):
+                if bad:
+                    data_in[10, 10, 10] = starlink.Ast.BAD
+                results = [m.resample([1, 1, 1], [30, 25, 40], data_in,
+                                      var_in, interp, params,
+                                      starlink.Ast.USEBAD, 0.0, 100,
+                                      starlink.Ast.BAD, [-5, -5, 1],
+                                      [32, 30, 21], [-5, -5, 1],
+                                      [32, 30, 21])
+                           for m in (cmpmap, mathmap)]
+                self.assertEqual(results[0][0], results[1][0])
+                for i in (1, 2):
+                    self.assertTrue(numpy.allclose(results[0][i],
+                                                   results[1][i],
+                                                   rtol=1.0e-12))
+            data_in[10, 10, 10] = 0.0
+
+#  Integer data are rounded in the same way.
+        data_in = numpy.arange(40 * 25 * 30,
+                               dtype=numpy.int32).reshape(40, 25, 30)
+        results = [m.resample([1, 1, 1], [30, 25, 40], data_in, None,
+                              starlink.Ast.LINEAR, None, 0, 0.0, 100, -1,
+                              [-5, -5, 1], [32, 30, 21], [-5, -5, 1],
+                              [32, 30, 21])
+                   for m in (cmpmap, mathmap)]
+        self.assertEqual(results[0][0], results[1][0])
+        self.assertTrue(numpy.array_equal(results[0][1], results[1][1]))
+
+    def test_ResampleBounds(self):
+#  Bounds and pixel counts are passed to AST as 64-bit integers, but
+#  each individual bound must still lie within the range of an int.
+        shiftmap = starlink.Ast.ShiftMap([2.0])
+        data_in = numpy.array([1., 2., 3., 4.])
+        npix, out, outv = shiftmap.resample(
+            [1], [4], data_in, None, starlink.Ast.NEAREST, None, 0, 0.0,
+            100, starlink.Ast.BAD, numpy.array([1], dtype=numpy.int64),
+            numpy.array([6], dtype=numpy.int64), [1], [6])
+        self.assertEqual(npix, 2)
+        self.assertIsInstance(npix, int)
+        self.assertTrue(numpy.array_equal(
+            out, [starlink.Ast.BAD, starlink.Ast.BAD, 1., 2., 3., 4.]))
+
+        out, outv = shiftmap.rebin(
+            0.5, [1], [4], data_in, None, starlink.Ast.NEAREST, None, 0,
+            0.0, 100, starlink.Ast.BAD, [1], [6], [1], [4])
+        self.assertTrue(numpy.array_equal(
+            out, [starlink.Ast.BAD, starlink.Ast.BAD, 1., 2., 3., 4.]))
+
+        big = 2**31 + 10
+        with self.assertRaises(starlink.Ast.EXSPIX):
+            shiftmap.resample([big], [big + 3], data_in, None,
+                              starlink.Ast.NEAREST, None, 0, 0.0, 100,
+                              starlink.Ast.BAD, [1], [6], [1], [6])
+        with self.assertRaises(starlink.Ast.EXSPIX):
+            shiftmap.rebin(0.5, [1], [4], data_in, None,
+                           starlink.Ast.NEAREST, None, 0, 0.0, 100,
+                           starlink.Ast.BAD, [big], [big + 5], [1], [4])
+
+    def test_ResampleTiled(self):
+#  Resampling an input grid supplied one tile at a time should give the
+#  same result as resampling the whole array, whatever the cache size.
+        data_in = numpy.arange(60.0 * 50.0).reshape(50, 60)
+        data_in = numpy.sin(data_in * 0.01) * 100.0
+        map = starlink.Ast.MatrixMap([[0.8, 0.3], [-0.2, 1.1]])
+        map = starlink.Ast.CmpMap(map, starlink.Ast.ShiftMap([-5.5, 7.25]))
+        params = [2.0]
+        npix, out, outv = map.resample(
+            [1, 1], [60, 50], data_in, None, starlink.Ast.SINC, params, 0,
+            0.0, 100, starlink.Ast.BAD, [1, 1], [70, 65], [1, 1], [70, 65])
+
+        calls = []
+        def fetch(lbnd, ubnd):
+            calls.append((lbnd, ubnd))
+            return data_in[lbnd[1] - 1:ubnd[1], lbnd[0] - 1:ubnd[0]]
+
+        for ncache in (1, 4, 100):
+            calls = []
+            npix2, out2, outv2 = map.resampletiled(
+                [1, 1], [60, 50], [16, 16], fetch, ncache, starlink.Ast.SINC,
+                params, 0, 0.0, 100, starlink.Ast.BAD, [1, 1], [70, 65],
+                [1, 1], [70, 65])
+            self.assertEqual(npix2, npix)
+            self.assertIsNone(outv2)
+            self.assertTrue(numpy.array_equal(out2, out))
+            if ncache == 100:
+                self.assertEqual(len(calls), 16)
+
+        data_f = data_in.astype(numpy.float32)
+        var_f = numpy.abs(data_f) + 1.0
+        npix, out, outv = map.resample(
+            [1, 1], [60, 50], data_f, var_f, starlink.Ast.LINEAR, None,
+            starlink.Ast.USEVAR, 0.0, 100, starlink.Ast.BAD, [1, 1],
+            [70, 65], [1, 1], [70, 65])
+
+        def fetchvar(lbnd, ubnd):
+            box = (slice(lbnd[1] - 1, ubnd[1]), slice(lbnd[0] - 1, ubnd[0]))
+            return data_f[box], var_f[box]
+
+        npix2, out2, outv2 = map.resampletiled(
+            [1, 1], [60, 50], [16, 16], fetchvar, 4, starlink.Ast.LINEAR,
+            None, starlink.Ast.USEVAR, 0.0, 100, starlink.Ast.BAD, [1, 1],
+            [70, 65], [1, 1], [70, 65], numpy.float32)
+        self.assertEqual(npix2, npix)
+        self.assertEqual(out2.dtype, numpy.float32)
+        self.assertTrue(numpy.array_equal(out2, out))
+        self.assertTrue(numpy.array_equal(outv2, outv))
+
+        def badfetch(lbnd, ubnd):
+            raise RuntimeError("cannot read tile")
+        with self.assertRaises(RuntimeError):
+            map.resampletiled([1, 1], [60, 50], [16, 16], badfetch, 4,
+                              starlink.Ast.LINEAR, None, 0, 0.0, 100,
+                              starlink.Ast.BAD, [1, 1], [70, 65], [1, 1],
+                              [70, 65])
+
     def test_TranMap(self):
         tranmap = starlink.Ast.TranMap(starlink.Ast.UnitMap(2), starlink.Ast.UnitMap(2))
         self.assertIsInstance(tranmap, starlink.Ast.TranMap)
@@ -610,6 +1269,25 @@ class TestAst(unittest.TestCase):
         self.assertAlmostEqual(refpos[1], 1)
         self.assertEqual(specframe.InternalUnit_1, specframe.Unit_1, )
 
+    def test_SpecFrameStdOfRest(self):
+        # The velocity terms used by the SpecMap are retained between
+        # transformations and copied with the Mapping, so repeated and
+        # copied transformations must give identical results.
+        sf1 = starlink.Ast.SpecFrame("System=FREQ,Unit=GHz,"
+                                     "StdOfRest=Topocentric,Epoch=2010.0,"
+                                     "ObsLon=-155.5,ObsLat=19.8,"
+                                     "RefRA=12:00:00,RefDec=-30:00:00")
+        sf2 = sf1.copy()
+        sf2.StdOfRest = "LSRK"
+        mapping = sf1.convert(sf2).getmapping()
+        freq = numpy.linspace(100.0, 110.0, 11)
+        lsrk = mapping.tran(freq)
+        self.assertFalse(numpy.allclose(lsrk, freq, rtol=1.0e-7, atol=0.0))
+        self.assertTrue(numpy.array_equal(mapping.tran(freq), lsrk))
+        self.assertTrue(numpy.array_equal(mapping.copy().tran(freq), lsrk))
+        topo = mapping.tran(lsrk, False)
+        self.assertTrue(numpy.allclose(topo, freq, rtol=1.0e-12, atol=0.0))
+
     def test_DSBSpecFrame(self):
         dsbspecframe = starlink.Ast.DSBSpecFrame("IF=4.0,AlignSideBand=1")
         self.assertIsInstance(dsbspecframe, starlink.Ast.Frame)
@@ -627,6 +1305,25 @@ class TestAst(unittest.TestCase):
         self.assertEqual(skyframe.InternalUnit_1, "rad")
         self.assertEqual(skyframe.InternalUnit_2, "rad")
 
+    def test_SkyFrameConvertCache(self):
+        # Conversions re-use cached epoch-dependent matrices, so results
+        # must not depend on the order in which epochs are visited.
+        pos = numpy.array([[0.1, 1.2, 2.3, 4.0], [-0.5, 0.2, 0.7, 1.1]])
+        results = {}
+        for epoch in ("1990.0", "2005.0", "2020.0"):
+            sf1 = starlink.Ast.SkyFrame("System=FK4,Equinox=1950,Epoch=" +
+                                        epoch)
+            sf2 = starlink.Ast.SkyFrame("System=Ecliptic,Equinox=" + epoch)
+            results[epoch] = sf1.convert(sf2).tran(pos)
+        self.assertFalse(numpy.array_equal(results["1990.0"],
+                                           results["2020.0"]))
+        for epoch in ("2020.0", "1990.0", "2005.0", "1990.0"):
+            sf1 = starlink.Ast.SkyFrame("System=FK4,Equinox=1950,Epoch=" +
+                                        epoch)
+            sf2 = starlink.Ast.SkyFrame("System=Ecliptic,Equinox=" + epoch)
+            self.assertTrue(numpy.array_equal(sf1.convert(sf2).tran(pos),
+                                              results[epoch]))
+
     def test_TimeFrame(self):
         tframe = starlink.Ast.TimeFrame("TimeScale=TAI")
         self.assertIsInstance(tframe, starlink.Ast.Frame)
@@ -712,6 +1409,68 @@ class TestAst(unittest.TestCase):
         self.assertIsInstance(cmp, starlink.Ast.CmpRegion)
         self.assertIsInstance(cmp, starlink.Ast.Region)
 
+    def test_CmpRegionNested(self):
+#  Nested CmpRegions should give the same results as combining the
+#  results of their component Regions, including when parts of the
+#  tree are negated.
+        frame = starlink.Ast.Frame(2)
+        boxes = [starlink.Ast.Box(frame, 1, [i, 0], [i + 0.9, 1])
+                 for i in range(4)]
+        circle = starlink.Ast.Circle(frame, 1, [2, 0.5], [1.5])
+        numpy.random.seed(3)
+        points = numpy.random.uniform(-1, 5, (2, 5000))
+
+        def inside(region):
+            return region.tran(points)[0] != starlink.Ast.BAD
+
+        row = starlink.Ast.CmpRegion(
+            starlink.Ast.CmpRegion(boxes[0], boxes[1], starlink.Ast.OR),
+            starlink.Ast.CmpRegion(boxes[2], boxes[3], starlink.Ast.OR),
+            starlink.Ast.OR)
+        inrow = inside(boxes[0])
+        for box in boxes[1:]:
+            inrow |= inside(box)
+        incircle = inside(circle)
+        self.assertTrue(numpy.array_equal(inside(row), inrow))
+
+        for oper, expected in ((starlink.Ast.AND, inrow & incircle),
+                               (starlink.Ast.OR, inrow | incircle),
+                               (starlink.Ast.XOR, inrow ^ incircle)):
+            cmp = starlink.Ast.CmpRegion(circle, row, oper)
+            self.assertTrue(numpy.array_equal(inside(cmp), expected))
+            cmp.Negated = True
+            self.assertTrue(numpy.array_equal(inside(cmp), ~expected))
+            cmp.Negated = False
+            self.assertTrue(numpy.array_equal(inside(cmp), expected))
+
+        row.Negated = True
+        cmp = starlink.Ast.CmpRegion(row, circle, starlink.Ast.AND)
+        self.assertTrue(numpy.array_equal(inside(cmp), ~inrow & incircle))
+
+#  A self-intersecting Polygon, and an Interval that excludes a range of
+#  values, include points outside the box spanned by their vertices or
+#  limits.
+        polygon = starlink.Ast.Polygon(frame,
+                                       [[87.3, 128.8, 118.1, 177.7, 170.5,
+                                         133.0],
+                                        [10.3, 122.3, 35.9, 142.9, 128.4,
+                                         45.3]])
+        interval = starlink.Ast.Interval(frame, [3, 0.2], [1, 0.8])
+        points = numpy.array([[250, 240, -40, 150, 0, 5, 2],
+                              [250, -40, 240, 80, 0.5, 0.5, 0.5]])
+        self.assertTrue(inside(polygon)[1:3].all())
+        self.assertTrue(inside(interval)[4:6].all())
+        circle = starlink.Ast.Circle(frame, 1, [250, 250], [10])
+        for region in (polygon, interval):
+            inregion = inside(region)
+            for oper, expected in ((starlink.Ast.AND, inside(circle) & inregion),
+                                   (starlink.Ast.OR, inside(circle) | inregion),
+                                   (starlink.Ast.XOR, inside(circle) ^ inregion)):
+                cmp = starlink.Ast.CmpRegion(circle, region, oper)
+                self.assertTrue(numpy.array_equal(inside(cmp), expected))
+                cmp = starlink.Ast.CmpRegion(region, circle, oper)
+                self.assertTrue(numpy.array_equal(inside(cmp), expected))
+
     def test_Prism(self):
         circle = starlink.Ast.Circle(starlink.Ast.Frame(2), 0,
                                      [0, 0], [3, 4])
@@ -925,6 +1684,40 @@ class TestAst(unittest.TestCase):
         b = ss.get()
         self.assertEqual(a, b)
 
+    def test_FitsChan_Search(self):
+        fc = starlink.Ast.FitsChan()
+        for i in range(1, 201):
+            fc.putfits("KEY{0:<5d}= {0}".format(i), False)
+        fc.putfits("PV1_1   = 1", False)
+        fc.putfits("PV2_3   = 2", False)
+        fc.putfits("KEY5    = 5", False)
+        fc.Card = 100
+        fc.putfits("PV1_2   = 3", False)
+        self.assertEqual(fc.Card, 101)
+        fc.Card = None
+        there, card = fc.findfits("KEY5", False)
+        self.assertTrue(there)
+        self.assertEqual(fc.Card, 5)
+        fc.Card = 6
+        there, card = fc.findfits("key5", False)
+        self.assertTrue(there)
+        self.assertEqual(fc.Card, 204)
+        fc.Card = None
+        found = []
+        while fc.findfits("PV%d_%d", True)[0]:
+            found.append(fc.Card - 1)
+        self.assertEqual(found, [100, 202, 203])
+        fc.Card = 202
+        fc.delfits()
+        fc.Card = None
+        there, card = fc.findfits("PV1_1", False)
+        self.assertFalse(there)
+        self.assertEqual(fc.Card, fc.Ncard + 1)
+        fc.Card = None
+        there, card = fc.findfits("PV2%0f", False)
+        self.assertTrue(there)
+        self.assertEqual(card.rstrip(), "PV2_3   =                    2")
+
     def test_FitsChan_AsMapping(self):
         fc = starlink.Ast.FitsChan()
         fc["NAXIS1"] = 200
@@ -1041,6 +1834,111 @@ class TestAst(unittest.TestCase):
         with self.assertRaises(starlink.Ast.MPIND):
             km[1] = 'Nooooooo'
 
+    def test_KeyMapOrder(self):
+
+#  With SortBy=None, keys are returned in the order they were first
+#  stored, including after entries are removed. Storing a new value for
+#  an existing key leaves the key where it is.
+        km = starlink.Ast.KeyMap()
+        keys = []
+        for i in range(2000):
+            km["K%d" % i] = i
+            keys.append("K%d" % i)
+        for i in range(0, 2000, 3):
+            km["K%d" % i] = None
+            keys.remove("K%d" % i)
+        self.assertEqual([km[i][0] for i in range(len(km))], keys)
+        km["K1"] = -1
+        self.assertEqual(len(km), len(keys))
+        self.assertEqual([km[i][0] for i in range(len(km))], keys)
+        km["K2"] = None
+        keys.remove("K2")
+        self.assertEqual([km[i][0] for i in range(len(km))], keys)
+        km["K2"] = 2
+        keys.append("K2")
+        self.assertEqual([entry[0] for entry in km], keys)
+        self.assertEqual(km["K1"], -1)
+        self.assertFalse("K0" in km)
+        self.assertTrue("K2" in km)
+
+#  Sorted orders are created when needed, and follow later changes.
+        km.SortBy = "KeyUp"
+        self.assertEqual([km[i][0] for i in range(len(km))], sorted(keys))
+        km["A"] = 0
+        self.assertEqual(km[0][0], "A")
+        km.SortBy = "AgeUp"
+        self.assertEqual(km[0][0], "A")
+        self.assertEqual(km[1][0], "K2")
+        self.assertEqual(km[2][0], "K1")
+        km.SortBy = "KeyAgeDown"
+        self.assertEqual(km[len(km) - 1][0], "A")
+        keys.append("A")
+
+#  Copies and dumps retain the order of the entries.
+        km.clear("SortBy")
+        cp = km.copy()
+        self.assertEqual([cp[i][0] for i in range(len(cp))], keys)
+        ss = TextStream()
+        channel = starlink.Ast.Channel(ss, ss)
+        self.assertEqual(channel.write(km), 1)
+        km2 = channel.read()
+        self.assertEqual([km2[i][0] for i in range(len(km2))], keys)
+        self.assertEqual(km2["K1"], -1)
+
+
+    def test_KeyMapShare(self):
+
+#  A published snapshot is not changed by later changes to the KeyMap,
+#  including the removal of keys, until the next snapshot is published.
+        km = starlink.Ast.KeyMap()
+        km["A"] = 1.5
+        km["B"] = 2
+        km["S"] = "3.25"
+        km.mapshare()
+        self.assertEqual(km.mapshareget("A"), 1.5)
+        self.assertEqual(km.mapshareget("B"), 2.0)
+        self.assertEqual(km.mapshareget("S"), 3.25)
+        self.assertIsNone(km.mapshareget("C"))
+        km["A"] = 4.0
+        km["B"] = None
+        km["C"] = 5.0
+        self.assertEqual(km.mapshareget("A"), 1.5)
+        self.assertTrue(km.mapsharehaskey("B"))
+        self.assertEqual(km.mapshareget("B"), 2.0)
+        self.assertFalse(km.mapsharehaskey("C"))
+        km.mapshare()
+        self.assertEqual(km.mapshareget("A"), 4.0)
+        self.assertFalse(km.mapsharehaskey("B"))
+        self.assertIsNone(km.mapshareget("B"))
+        self.assertEqual(km.mapshareget("C"), 5.0)
+
+#  Threads that have not locked the KeyMap can read the snapshots while
+#  new ones are published and the old ones are freed. The values read
+#  never go backwards.
+        km["N"] = 0.0
+        km.mapshare()
+        errors = []
+
+        def reader():
+            last = 0.0
+            for i in range(5000):
+                value = km.mapshareget("N")
+                if value < last:
+                    errors.append("N went from %g to %g" % (last, value))
+                last = value
+                if not km.mapsharehaskey("A"):
+                    errors.append("A not found")
+
+        threads = [threading.Thread(target=reader) for i in range(4)]
+        for thread in threads:
+            thread.start()
+        for i in range(1, 500):
+            km["N"] = float(i)
+            km.mapshare()
+        for thread in threads:
+            thread.join()
+        self.assertEqual(errors, [])
+        self.assertEqual(km.mapshareget("N"), 499.0)
     def test_Plot(self):
         with self.assertRaises(TypeError):
             plot = starlink.Ast.Plot(None, [0.0, 0.0, 1.0, 1.0], [0.0, 0.0, 1.0, 1.0],
@@ -1303,6 +2201,35 @@ class TestAst(unittest.TestCase):
             self.assertAlmostEqual(x, r)
             self.assertAlmostEqual(y, r)
 
+    def test_MathMapBlock(self):
+        oldval = starlink.Ast.tune("MathMapBlock", starlink.Ast.TUNULL)
+        self.assertEqual(oldval, 256)
+
+#  The block evaluator and the original interpreter should give identical
+#  results, including bad values, for expressions that use intermediate
+#  functions, constants, variable-length argument lists and conditionals.
+        mathmap = starlink.Ast.MathMap(
+            2, 3,
+            ["r = sqrt( x * x + y * y )", "t = atan2( y, x ) * 180 / <pi>",
+             "p = log( r ) + sin( 2 * <pi> / 3 ) * t",
+             "q = max( x, y, 1.5, r ) - min( y, 2 * 3 )",
+             "s = qif( x > 0 && y > 0, 1 / x, ( x - 1 ) ** 0.5 )"],
+            ["x", "y"])
+        pin = numpy.array([[1.0, -2.0, 0.0, 3.5, starlink.Ast.BAD, 7.0] * 50,
+                           [0.5, 4.0, 0.0, -1.0, 2.0, starlink.Ast.BAD] * 50])
+        try:
+            starlink.Ast.tune("MathMapBlock", 0)
+            serial = mathmap.tran(pin)
+            self.assertEqual(starlink.Ast.tune("MathMapBlock", 7), 0)
+            blocked = mathmap.tran(pin)
+        finally:
+            starlink.Ast.tune("MathMapBlock", oldval)
+
+        self.assertTrue(numpy.array_equal(serial, blocked))
+        self.assertEqual(blocked[0][4], starlink.Ast.BAD)
+        self.assertEqual(blocked[1][5], starlink.Ast.BAD)
+        self.assertAlmostEqual(blocked[2][0], 1.0)
+
     def test_Polygon(self):
         polygon = starlink.Ast.Polygon(starlink.Ast.Frame(2),
                                        [[0, 1, 0], [0, 1, 2]])
@@ -1342,6 +2269,89 @@ class TestAst(unittest.TestCase):
         new2 = new.downsize(0, 3)
         self.assertTrue(new2.isapolygon())
 
+    def test_PolygonGrid(self):
+#  Polygons with many vertices in a simple Frame use a grid of edges.
+#  They should give the same results as the same Polygon in a CmpFrame,
+#  for which every edge is checked.
+        angle = numpy.linspace(0.0, 2*numpy.pi, 200, endpoint=False)
+        radius = numpy.where(numpy.arange(200) % 2, 1.0, 0.5)
+        vertices = numpy.array([radius*numpy.cos(angle),
+                                radius*numpy.sin(angle)])
+        polygon = starlink.Ast.Polygon(starlink.Ast.Frame(2), vertices)
+        cmpframe = starlink.Ast.CmpFrame(starlink.Ast.Frame(1),
+                                         starlink.Ast.Frame(1))
+        cpolygon = starlink.Ast.Polygon(cmpframe, vertices)
+
+        numpy.random.seed(7)
+        points = numpy.concatenate((numpy.random.uniform(-1.2, 1.2, (2, 2000)),
+                                    vertices,
+                                    0.5*(vertices + numpy.roll(vertices, 1, 1)),
+                                    [[0.0, 2.0, 1.0], [0.0, 0.0, 1.0]]), axis=1)
+        for closed in (True, False):
+            polygon.Closed = closed
+            cpolygon.Closed = closed
+            result = polygon.tran(points)
+            expected = cpolygon.tran(points)
+            self.assertTrue(numpy.array_equal(result, expected))
+            self.assertEqual(result[0][2000], starlink.Ast.BAD if not closed
+                             else vertices[0][0])
+        self.assertEqual(result[0][-3], 0.0)
+        self.assertEqual(result[0][-2], starlink.Ast.BAD)
+        self.assertEqual(result[0][-1], starlink.Ast.BAD)
+
+    def test_RegionMask(self):
+#  Masking a 2-dimensional grid should give the same result as testing
+#  the centre of every pixel individually, including for Regions that
+#  are too thin for whole cells of the grid to lie inside them. No pixel
+#  centre lies exactly on the boundary of any of these Regions.
+        frame = starlink.Ast.Frame(2)
+        lbnd = [1, 1]
+        ubnd = [400, 300]
+        x, y = numpy.meshgrid(numpy.arange(1.0, 401.0),
+                              numpy.arange(1.0, 301.0))
+        centres = numpy.array([x.ravel(), y.ravel()])
+
+        slivers = [
+            starlink.Ast.Polygon(frame, [[20.13, 380.37, 380.37, 20.13],
+                                         [30.41, 270.29, 271.11, 31.23]]),
+            starlink.Ast.Polygon(frame, [[10.5, 390.5, 390.5, 10.5],
+                                         [99.83, 100.61, 101.13, 100.27]])]
+        rings = [
+            starlink.Ast.CmpRegion(
+                starlink.Ast.Circle(frame, 1, [200.27, 150.61], [120.13]),
+                starlink.Ast.Circle(frame, 1, [200.27, 150.61], [118.09]),
+                starlink.Ast.XOR),
+            starlink.Ast.CmpRegion(
+                starlink.Ast.Circle(frame, 1, [180.5, 140.5], [100.0]),
+                starlink.Ast.Circle(frame, 1, [180.5, 140.5], [99.3]),
+                starlink.Ast.XOR)]
+
+        data = numpy.ones((300, 400))
+        for region in slivers + rings:
+            inregion = (region.tran(centres)[0] !=
+                        starlink.Ast.BAD).reshape(300, 400)
+            self.assertTrue(0 < numpy.count_nonzero(inregion) < 20000)
+            for inside in (1, 0):
+                masked = inregion if inside else ~inregion
+                nmasked, out = region.mask(None, inside, lbnd, ubnd, data,
+                                           0.0)
+                self.assertEqual(nmasked, numpy.count_nonzero(masked))
+                self.assertTrue(numpy.array_equal(out, numpy.where(masked,
+                                                                   0.0, 1.0)))
+        self.assertTrue(numpy.array_equal(data, numpy.ones((300, 400))))
+
+#  The shape of the array must match the pixel bounds.
+        box = starlink.Ast.Box(frame, 1, [0.5, 0.5], [200.5, 200.5])
+        with self.assertRaises(ValueError):
+            box.mask(None, True, [1, 1], [200, 200], numpy.zeros((4, 4)), 5.0)
+        with self.assertRaises(ValueError):
+            box.mask(None, True, [1, 1], [400, 300], numpy.zeros((400, 300)),
+                     5.0)
+        with self.assertRaises(ValueError):
+            box.mask(None, True, [1, 1], [0, 300], data, 5.0)
+        nmasked, out = box.mask(None, True, [1, 1], [400, 300], data, 5.0)
+        self.assertEqual(nmasked, 200 * 200)
+
     def test_PointList(self):
         pointlist = starlink.Ast.PointList(starlink.Ast.Frame(2),
                                            [[0, 1, 0], [0, 1, 2]])
@@ -1377,6 +2387,34 @@ class TestAst(unittest.TestCase):
         self.assertEqual(table.columnndim('Fred'), 2)
         self.assertEqual(table.columnunit('Fred'), '')
 
+    def test_TableColumns(self):
+        table = starlink.Ast.Table()
+        table.addcolumn('Ra', starlink.Ast.DOUBLETYPE, [])
+        table.addcolumn('Flag', starlink.Ast.INTTYPE, [])
+        for irow in range(1, 6):
+            table['Ra({0})'.format(irow)] = 0.5 * irow
+        table['Flag(2)'] = 7
+        self.assertEqual(table.Nrow, 5)
+        self.assertEqual(table['Ra(3)'], 1.5)
+        self.assertEqual(table['Flag(2)'], 7)
+        self.assertFalse('Flag(1)' in table)
+        table.removerow(3)
+        self.assertFalse('Ra(3)' in table)
+        table.removerow(4)
+        table.removerow(5)
+        table.purgerows()
+        self.assertEqual(table.Nrow, 2)
+        self.assertEqual(table['Ra(2)'], 1.0)
+        self.assertEqual(table['Flag(2)'], 7)
+        table2 = table.copy()
+        table2['Ra(1)'] = -1.0
+        self.assertEqual(table['Ra(1)'], 0.5)
+        self.assertEqual(len(table), 3)
+        self.assertEqual(table['Ra(2)'], 1.0)
+        table['Ra(2)'] = 3.0
+        self.assertEqual(table['Ra(2)'], 3.0)
+        self.assertEqual(table2['Ra(2)'], 1.0)
+
     def test_FitsTable(self):
         table = starlink.Ast.FitsTable()
         self.assertIsInstance(table, starlink.Ast.FitsTable)
@@ -25,7 +25,13 @@ extern "C" {
 #define LAST(pyobj) ((Object*)pyobj)->ast_object
 #define LTHIS LAST(self)
 
+/* If AST is thread-safe, the AST macro also locks the AST Object for use
+   by the calling thread (see LockObject in Ast.c). */
+#if defined(THREAD_SAFE)
+#define AST(pyobj) (pyobj&&((PyObject*)pyobj!=Py_None)?LockObject((Object*)pyobj):NULL)
+#else
 #define AST(pyobj) (pyobj&&((PyObject*)pyobj!=Py_None)?LAST(pyobj):NULL)
+#endif
 #define THIS AST(self)
 #define THAT AST(other)
 #define ANOTHER AST(another)
@@ -57,10 +63,84 @@ extern "C" {
 *     nice to clear the AST status at the same time that the exception is
 *     cleared, but I can;'t find out how to do this. So instead, clear
 *     the AST error status before returning from every AST method.
+*
+*     If AST has been built with thread-safety enabled, this macro also
+*     unlocks the AST Objects that were locked by the AST macro while
+*     the method was running, so that they can be used by any other
+*     Python thread once the method has returned.
 
 */
 
+#if defined(THREAD_SAFE)
+#define TIDY UnlockObjects()
+#else
 #define TIDY astClearStatus
+#endif
+
+/*
+*  Name:
+*     BEGIN_THREADS/END_THREADS
+
+*  Purpose:
+*     Release the Python GIL around an expensive call to the AST library.
+
+*  Synopsis:
+*     BEGIN_THREADS
+*     ...
+*     END_THREADS
+
+*  Description:
+*     These macros bracket a section of code that calls the AST library
+*     but does not use the Python API. If AST has been built with
+*     thread-safety enabled, the GIL is released within the section so
+*     that other Python threads can run. The AST Objects used within the
+*     section must have been obtained using the AST macro (or THIS, etc)
+*     before the section starts, so that they are locked by the calling
+*     thread and no other thread can modify them in the meantime.
+*     Otherwise, the GIL is retained and the macros do nothing.
+
+*/
+
+#if defined(THREAD_SAFE)
+#define BEGIN_THREADS Py_BEGIN_ALLOW_THREADS
+#define END_THREADS Py_END_ALLOW_THREADS
+#else
+#define BEGIN_THREADS {
+#define END_THREADS }
+#endif
+
+/*
+*  Name:
+*     BEGIN_CALLBACK/END_CALLBACK
+
+*  Purpose:
+*     Bracket a call from AST to a Python callback function.
+
+*  Synopsis:
+*     BEGIN_CALLBACK
+*     ...
+*     END_CALLBACK
+
+*  Description:
+*     These macros bracket a section of code in which Python code is
+*     called back from within an AST function (e.g. a Channel source
+*     function or a Grf drawing method). Any AST methods invoked by the
+*     Python code would normally unlock all the AST Objects locked by
+*     the calling thread when they return (see TIDY). This would include
+*     the Objects that are still being used by the AST function that
+*     invoked the callback, so TIDY leaves all Objects locked while
+*     within the section. The macros do nothing if AST has not been
+*     built with thread-safety enabled.
+
+*/
+
+#if defined(THREAD_SAFE)
+#define BEGIN_CALLBACK HoldLocks( 1 );
+#define END_CALLBACK HoldLocks( -1 );
+#else
+#define BEGIN_CALLBACK
+#define END_CALLBACK
+#endif
 
 
 /*
@@ -87,7 +167,7 @@ extern "C" {
 \
 static PyObject *isa_##class( Object *self ); \
 static PyObject *isa_##class( Object *self ){ \
-   PyObject *result = astIsA##class( self->ast_object ) ?  Py_True : Py_False; \
+   PyObject *result = astIsA##class( THIS ) ?  Py_True : Py_False; \
    TIDY; \
    Py_INCREF(result); \
    return result; \
@@ -191,7 +271,7 @@ static int set##attrib( class *self, PyObject *value, void *closure ){ \
    char att_buf[ MXATTR_LEN ]; \
    int result = -1; \
    if (value == NULL || value == Py_None ) { \
-      astClear( ((Object*)self)->ast_object, ATTNORM(#attrib) ); \
+      astClear( THIS, ATTNORM(#attrib) ); \
       if( astOK ) result = 0; \
    } else { \
       setcode \
@@ -262,7 +342,7 @@ static int set##attrib( class *self, PyObject *value, void *closure ){ \
 
 #define MAKE_GETC(class,attrib) \
 MAKE_GET(class,attrib, \
-   Py_BuildValue( "s", astGetC( ((Object*)self)->ast_object, ATTNORM(#attrib) ) ));
+   Py_BuildValue( "s", astGetC( THIS, ATTNORM(#attrib) ) ));
 
 
 /*
@@ -289,7 +369,7 @@ static PyObject *get##attrib( class *self, void *closure ); \
 static PyObject *get##attrib( class *self, void *closure ){ \
    PyObject *result; \
    char att_buf[ MXATTR_LEN ]; \
-   int icol = astGetI( ((Object*)self)->ast_object, ATTNORM(#attrib)); \
+   int icol = astGetI( THIS, ATTNORM(#attrib)); \
    const char *text = IntToColour( self, icol ); \
    if( text ) { \
       result = Py_BuildValue( "s", text ); \
@@ -321,7 +401,7 @@ static PyObject *get##attrib( class *self, void *closure ){ \
 
 #define MAKE_GETL(class,attrib) \
 MAKE_GET(class,attrib, \
-   astGetI( ((Object*)self)->ast_object, ATTNORM(#attrib) ) ? Py_True : Py_False);
+   astGetI( THIS, ATTNORM(#attrib) ) ? Py_True : Py_False);
 
 
 /*
@@ -344,7 +424,7 @@ MAKE_GET(class,attrib, \
 
 #define MAKE_GETI(class,attrib) \
 MAKE_GET(class,attrib, \
-   PyLong_FromLong((long int) astGetI( ((Object*)self)->ast_object, ATTNORM(#attrib) )));
+   PyLong_FromLong((long int) astGetI( THIS, ATTNORM(#attrib) )));
 
 /*
 *  Name:
@@ -366,7 +446,7 @@ MAKE_GET(class,attrib, \
 
 #define MAKE_GETD(class,attrib) \
 MAKE_GET(class,attrib, \
-   PyFloat_FromDouble(astGetD( ((Object*)self)->ast_object, ATTNORM(#attrib) )));
+   PyFloat_FromDouble(astGetD( THIS, ATTNORM(#attrib) )));
 
 
 /*
@@ -391,7 +471,7 @@ MAKE_GET(class,attrib, \
 #define SETCODEC(attrib) \
    char *cval = GetString(NULL,value); \
    if( cval ) { \
-      astSetC( ((Object*)self)->ast_object, ATTNORM(#attrib), cval ); \
+      astSetC( THIS, ATTNORM(#attrib), cval ); \
       if( astOK ) result = 0; \
       cval = astFree( cval ); \
    }
@@ -423,7 +503,7 @@ MAKE_GET(class,attrib, \
 
 #define SETCODEL(attrib) \
    if( PyBool_Check( value ) ) { \
-      astSetI( ((Object*)self)->ast_object, ATTNORM(#attrib), ( value == Py_True ) ); \
+      astSetI( THIS, ATTNORM(#attrib), ( value == Py_True ) ); \
       if( astOK ) result = 0; \
    }
 
@@ -455,7 +535,7 @@ MAKE_GET(class,attrib, \
 #define SETCODEI(attrib) \
    int ival = PyLong_AsLong( value ); \
    if( !PyErr_Occurred() ) { \
-      astSetI( ((Object*)self)->ast_object, ATTNORM(#attrib), ival ); \
+      astSetI( THIS, ATTNORM(#attrib), ival ); \
       if( astOK ) result = 0; \
    }
 
@@ -486,7 +566,7 @@ MAKE_GET(class,attrib, \
 #define SETCODED(attrib) \
    double dval = PyFloat_AsDouble( value ); \
    if( !PyErr_Occurred() ) { \
-      astSetD( ((Object*)self)->ast_object, ATTNORM(#attrib), dval ); \
+      astSetD( THIS, ATTNORM(#attrib), dval ); \
       if( astOK ) result = 0; \
    }
 
@@ -517,7 +597,7 @@ MAKE_GET(class,attrib, \
 
 #define MAKE_GETROC(class,attrib) \
    MAKE_GET(class,attrib, \
-      Py_BuildValue( "s", astGetC( ((Object*)self)->ast_object, ATTNORM(#attrib) ) )); \
+      Py_BuildValue( "s", astGetC( THIS, ATTNORM(#attrib) ) )); \
    MAKE_SETRO(class,attrib)
 
 
@@ -542,7 +622,7 @@ MAKE_GET(class,attrib, \
 
 #define MAKE_GETROL(class,attrib) \
    MAKE_GET(class,attrib, \
-      astGetI( ((Object*)self)->ast_object, ATTNORM(#attrib) ) ? Py_True : Py_False); \
+      astGetI( THIS, ATTNORM(#attrib) ) ? Py_True : Py_False); \
    MAKE_SETRO(class,attrib)
 
 
@@ -567,7 +647,7 @@ MAKE_GET(class,attrib, \
 
 #define MAKE_GETROI(class,attrib) \
    MAKE_GET(class,attrib, \
-      PyLong_FromLong((long int) astGetI( ((Object*)self)->ast_object, ATTNORM(#attrib) ))); \
+      PyLong_FromLong((long int) astGetI( THIS, ATTNORM(#attrib) ))); \
    MAKE_SETRO(class,attrib)
 
 /*
@@ -591,7 +671,7 @@ MAKE_GET(class,attrib, \
 
 #define MAKE_GETROD(class,attrib) \
    MAKE_GET(class,attrib, \
-      PyFloat_FromDouble(astGetD( ((Object*)self)->ast_object, ATTNORM(#attrib) ))); \
+      PyFloat_FromDouble(astGetD( THIS, ATTNORM(#attrib) ))); \
    MAKE_SETRO(class,attrib)
 
 
@@ -620,12 +700,12 @@ MAKE_GET(class,attrib, \
    if( cval ) { \
       icol = ColourToInt( self, cval ); \
       if( icol >= 0 ) { \
-         astSetI(  ((Object*)self)->ast_object, ATTNORM(#attrib), icol ); \
+         astSetI(  THIS, ATTNORM(#attrib), icol ); \
       } \
       cval = astFree( cval ); \
    } else if( LONG_CHECK(value) ) { \
       icol = PyLong_AsLong( value ); \
-      astSetI(  ((Object*)self)->ast_object, ATTNORM(#attrib), icol ); \
+      astSetI(  THIS, ATTNORM(#attrib), icol ); \
    } else if( ! PyErr_Occurred() ) { \
       PyErr_Format( PyExc_TypeError, "Cannot set attribute '" \
                     #attrib "' - value (%s) is not a known colour " \
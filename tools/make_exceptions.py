@@ -110,9 +110,21 @@ static int RegisterErrors( PyObject *m ){
 
 
 /* The AST library calls this function to deliver an error message
-   in the form of a Python Exception. For each AST error code, raise
-   the corresponding Python Exception. */
+   in the form of a Python Exception. It may be called by a thread that
+   does not hold the GIL (for instance, within a BEGIN_THREADS section or
+   from an AST worker thread), so acquire the GIL before raising the
+   exception. */
+static void PutErr( int, const char * );
+
 void astPutErr_( int status_value, const char *message ) {
+   PyGILState_STATE gstate;
+   gstate = PyGILState_Ensure();
+   PutErr( status_value, message );
+   PyGILState_Release( gstate );
+}
+
+/* For each AST error code, raise the corresponding Python Exception. */
+static void PutErr( int status_value, const char *message ) {
 
 /* Local Variables: */
    PyObject *ex;